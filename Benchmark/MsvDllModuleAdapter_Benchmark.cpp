@@ -0,0 +1,240 @@
+
+
+#include "pch.h"
+
+#include "MsvSyntheticDllModule.h"
+
+#include "mmodule/MsvDllModuleAdapter.h"
+
+#if !defined(_WIN32)
+#include "mmodule/MsvPosixDllFactory.h"
+#endif
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <cstdlib>
+#include <new>
+#include <string>
+
+MSV_ENABLE_WARNINGS
+
+
+/*-----------------------------------------------------------------------------------------------------
+**											Helpers
+**---------------------------------------------------------------------------------------------------*/
+
+
+//how module is accessed
+enum class MsvModuleAccess: int32_t
+{
+	MSV_MODULE_ACCESS_DIRECT = 0,				///< Module derived from MsvModuleBase (no adapter).
+	MSV_MODULE_ACCESS_ADAPTER_IN_PROCESS,		///< Adapter over DLL module created in-process (no shared library).
+	MSV_MODULE_ACCESS_ADAPTER_SHARED_LIBRARY	///< Adapter over DLL module loaded from shared library.
+};
+
+//DLL factory which creates synthetic DLL modules in-process
+class MsvInProcessDllFactory:
+	public IMsvDllFactory
+{
+public:
+	using IMsvDllFactory::GetDllObject;
+
+	virtual MsvErrorCode GetDllObject(const char* dllObjectId, std::shared_ptr<IMsvDllObject>& spDllObject) override
+	{
+		if (!dllObjectId || std::string(dllObjectId) != MSV_SYNTHETIC_DLL_MODULE_ID)
+		{
+			return MSV_NOT_FOUND_ERROR;
+		}
+
+		spDllObject.reset(new (std::nothrow) MsvSyntheticDllModule());
+		return spDllObject ? MSV_SUCCESS : MSV_ALLOCATION_ERROR;
+	}
+};
+
+//shared library path can be changed by MSV_SYNTHETIC_DLL_PATH environment variable
+static std::shared_ptr<IMsvDllFactory> GetSharedLibraryDllFactory()
+{
+#if defined(_WIN32)
+	//Windows DLL factory is not part of this library -> shared library variant is skipped
+	return nullptr;
+#else
+	//created (and shared library loaded) only once for all benchmarks and threads
+	static std::shared_ptr<IMsvDllFactory> spDllFactory = []() -> std::shared_ptr<IMsvDllFactory>
+	{
+		const char* dllPath = std::getenv("MSV_SYNTHETIC_DLL_PATH");
+		std::shared_ptr<MsvPosixDllFactory> spPosixDllFactory(new (std::nothrow) MsvPosixDllFactory(nullptr, MsvDllBinding::MSV_DLL_BINDING_NOW));
+		if (!spPosixDllFactory || MSV_FAILED(spPosixDllFactory->AddDllObject(MSV_SYNTHETIC_DLL_MODULE_ID, dllPath ? dllPath : "./libMsvSyntheticDllModule.so")))
+		{
+			return nullptr;
+		}
+
+		//check that shared library can be loaded
+		std::shared_ptr<IMsvDllObject> spDllObject;
+		if (MSV_FAILED(spPosixDllFactory->GetDllObject(MSV_SYNTHETIC_DLL_MODULE_ID, spDllObject)))
+		{
+			return nullptr;
+		}
+
+		return spPosixDllFactory;
+	}();
+
+	return spDllFactory;
+#endif
+}
+
+class MsvDllModuleAdapter_Benchmark
+{
+public:
+	MsvDllModuleAdapter_Benchmark():
+		m_spLoggerProvider(new MsvNullLoggerProvider()),
+		m_spInProcessDllFactory(new MsvInProcessDllFactory())
+	{
+		m_spLogger = m_spLoggerProvider->GetLogger();
+	}
+
+	std::shared_ptr<IMsvModule> CreateModule(MsvModuleAccess moduleAccess)
+	{
+		switch (moduleAccess)
+		{
+		case MsvModuleAccess::MSV_MODULE_ACCESS_DIRECT:
+			return std::make_shared<MsvSyntheticModule>(m_spLoggerProvider);
+		case MsvModuleAccess::MSV_MODULE_ACCESS_ADAPTER_IN_PROCESS:
+			return std::make_shared<MsvDllModuleAdapter>(MSV_SYNTHETIC_DLL_MODULE_ID, m_spInProcessDllFactory, m_spLogger);
+		case MsvModuleAccess::MSV_MODULE_ACCESS_ADAPTER_SHARED_LIBRARY:
+		{
+			std::shared_ptr<IMsvDllFactory> spDllFactory = GetSharedLibraryDllFactory();
+			if (!spDllFactory)
+			{
+				return nullptr;
+			}
+			return std::make_shared<MsvDllModuleAdapter>(MSV_SYNTHETIC_DLL_MODULE_ID, spDllFactory, m_spLogger);
+		}
+		default:
+			return nullptr;
+		}
+	}
+
+	std::shared_ptr<IMsvLoggerProvider> m_spLoggerProvider;
+	std::shared_ptr<MsvLogger> m_spLogger;
+	std::shared_ptr<IMsvDllFactory> m_spInProcessDllFactory;
+};
+
+static void MsvModuleAccesses(benchmark::internal::Benchmark* pBenchmark)
+{
+	pBenchmark->ArgName("access");
+	pBenchmark->Arg(static_cast<int64_t>(MsvModuleAccess::MSV_MODULE_ACCESS_DIRECT));
+	pBenchmark->Arg(static_cast<int64_t>(MsvModuleAccess::MSV_MODULE_ACCESS_ADAPTER_IN_PROCESS));
+	pBenchmark->Arg(static_cast<int64_t>(MsvModuleAccess::MSV_MODULE_ACCESS_ADAPTER_SHARED_LIBRARY));
+}
+
+//skips benchmark in all threads when shared library is not available
+static bool ModuleAccessAvailable(benchmark::State& state)
+{
+	if (static_cast<MsvModuleAccess>(state.range(0)) == MsvModuleAccess::MSV_MODULE_ACCESS_ADAPTER_SHARED_LIBRARY && !GetSharedLibraryDllFactory())
+	{
+		state.SkipWithError("Shared library with synthetic DLL module is not available (set MSV_SYNTHETIC_DLL_PATH).");
+		return false;
+	}
+
+	return true;
+}
+
+
+/*-----------------------------------------------------------------------------------------------------
+**											Concurrent Query Benchmarks
+**---------------------------------------------------------------------------------------------------*/
+
+
+//shared by all benchmark threads (created and destroyed by thread 0)
+static std::shared_ptr<IMsvModule> g_spQueriedModule;
+
+static void BM_Module_Initialized(benchmark::State& state)
+{
+	if (!ModuleAccessAvailable(state))
+	{
+		return;
+	}
+
+	if (state.thread_index() == 0)
+	{
+		MsvDllModuleAdapter_Benchmark moduleBenchmark;
+		g_spQueriedModule = moduleBenchmark.CreateModule(static_cast<MsvModuleAccess>(state.range(0)));
+		g_spQueriedModule->Initialize();
+	}
+
+	//all threads start loop together (after thread 0 prepared module)
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(g_spQueriedModule->Initialized());
+	}
+
+	state.SetItemsProcessed(state.iterations());
+
+	if (state.thread_index() == 0)
+	{
+		g_spQueriedModule->Uninitialize();
+		g_spQueriedModule.reset();
+	}
+}
+BENCHMARK(BM_Module_Initialized)->Apply(MsvModuleAccesses)->ThreadRange(1, 64)->UseRealTime();
+
+static void BM_Module_Running(benchmark::State& state)
+{
+	if (!ModuleAccessAvailable(state))
+	{
+		return;
+	}
+
+	if (state.thread_index() == 0)
+	{
+		MsvDllModuleAdapter_Benchmark moduleBenchmark;
+		g_spQueriedModule = moduleBenchmark.CreateModule(static_cast<MsvModuleAccess>(state.range(0)));
+		g_spQueriedModule->Initialize();
+		g_spQueriedModule->Start();
+	}
+
+	//all threads start loop together (after thread 0 prepared module)
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(g_spQueriedModule->Running());
+	}
+
+	state.SetItemsProcessed(state.iterations());
+
+	if (state.thread_index() == 0)
+	{
+		g_spQueriedModule->Stop();
+		g_spQueriedModule->Uninitialize();
+		g_spQueriedModule.reset();
+	}
+}
+BENCHMARK(BM_Module_Running)->Apply(MsvModuleAccesses)->ThreadRange(1, 64)->UseRealTime();
+
+
+/*-----------------------------------------------------------------------------------------------------
+**											Lifecycle Benchmarks
+**---------------------------------------------------------------------------------------------------*/
+
+
+//each thread cycles its own module (shared library adapters of all threads share one DLL factory)
+static void BM_Module_Lifecycle(benchmark::State& state)
+{
+	if (!ModuleAccessAvailable(state))
+	{
+		return;
+	}
+
+	MsvDllModuleAdapter_Benchmark moduleBenchmark;
+	std::shared_ptr<IMsvModule> spModule = moduleBenchmark.CreateModule(static_cast<MsvModuleAccess>(state.range(0)));
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(spModule->Initialize());
+		benchmark::DoNotOptimize(spModule->Start());
+		benchmark::DoNotOptimize(spModule->Stop());
+		benchmark::DoNotOptimize(spModule->Uninitialize());
+	}
+
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Module_Lifecycle)->Apply(MsvModuleAccesses)->ThreadRange(1, 64)->UseRealTime();
@@ -0,0 +1,123 @@
+
+
+#include "pch.h"
+
+#include "mmodule/MsvModuleLifecycle.h"
+
+
+/*-----------------------------------------------------------------------------------------------------
+**											Helpers
+**---------------------------------------------------------------------------------------------------*/
+
+
+//module with empty hooks (measures lock policy and lifecycle only)
+template<class LockPolicy>
+class MsvPolicyModule final:
+	public MsvModuleLifecycle<MsvPolicyModule<LockPolicy>, MsvModuleBaseT<LockPolicy>>
+{
+public:
+	MsvPolicyModule(std::shared_ptr<IMsvLoggerProvider> spLoggerProvider):
+		MsvModuleLifecycle<MsvPolicyModule<LockPolicy>, MsvModuleBaseT<LockPolicy>>(spLoggerProvider, "MsvPolicyModule")
+	{
+
+	}
+};
+
+template<class LockPolicy>
+static std::shared_ptr<MsvPolicyModule<LockPolicy>> CreatePolicyModule()
+{
+	return std::make_shared<MsvPolicyModule<LockPolicy>>(std::make_shared<MsvNullLoggerProvider>());
+}
+
+
+/*-----------------------------------------------------------------------------------------------------
+**											Lifecycle Benchmarks
+**---------------------------------------------------------------------------------------------------*/
+
+
+//concrete (final) type is known -> lifecycle calls are devirtualized and hooks inlined
+template<class LockPolicy>
+static void BM_LockPolicy_Lifecycle_Direct(benchmark::State& state)
+{
+	std::shared_ptr<MsvPolicyModule<LockPolicy>> spModule = CreatePolicyModule<LockPolicy>();
+	MsvPolicyModule<LockPolicy>& module = *spModule;
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(module.Initialize());
+		benchmark::DoNotOptimize(module.Start());
+		benchmark::DoNotOptimize(module.Stop());
+		benchmark::DoNotOptimize(module.Uninitialize());
+	}
+
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_LockPolicy_Lifecycle_Direct, MsvNoLockPolicy);
+BENCHMARK_TEMPLATE(BM_LockPolicy_Lifecycle_Direct, MsvSpinLockPolicy);
+BENCHMARK_TEMPLATE(BM_LockPolicy_Lifecycle_Direct, MsvMutexLockPolicy);
+BENCHMARK_TEMPLATE(BM_LockPolicy_Lifecycle_Direct, MsvSharedLockPolicy);
+BENCHMARK_TEMPLATE(BM_LockPolicy_Lifecycle_Direct, MsvRecursiveLockPolicy);
+
+//module is called through IMsvModule (as module manager calls it)
+template<class LockPolicy>
+static void BM_LockPolicy_Lifecycle_Interface(benchmark::State& state)
+{
+	std::shared_ptr<IMsvModule> spModule = CreatePolicyModule<LockPolicy>();
+	benchmark::DoNotOptimize(spModule.get());
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(spModule->Initialize());
+		benchmark::DoNotOptimize(spModule->Start());
+		benchmark::DoNotOptimize(spModule->Stop());
+		benchmark::DoNotOptimize(spModule->Uninitialize());
+	}
+
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_LockPolicy_Lifecycle_Interface, MsvNoLockPolicy);
+BENCHMARK_TEMPLATE(BM_LockPolicy_Lifecycle_Interface, MsvSpinLockPolicy);
+BENCHMARK_TEMPLATE(BM_LockPolicy_Lifecycle_Interface, MsvMutexLockPolicy);
+BENCHMARK_TEMPLATE(BM_LockPolicy_Lifecycle_Interface, MsvSharedLockPolicy);
+BENCHMARK_TEMPLATE(BM_LockPolicy_Lifecycle_Interface, MsvRecursiveLockPolicy);
+
+
+/*-----------------------------------------------------------------------------------------------------
+**											Concurrent Query Benchmarks
+**---------------------------------------------------------------------------------------------------*/
+
+
+//shared by all benchmark threads (created and destroyed by thread 0)
+template<class LockPolicy>
+static std::shared_ptr<MsvPolicyModule<LockPolicy>> g_spPolicyModule;
+
+//no lock policy is not benchmarked (it is not thread safe)
+template<class LockPolicy>
+static void BM_LockPolicy_Running(benchmark::State& state)
+{
+	if (state.thread_index() == 0)
+	{
+		g_spPolicyModule<LockPolicy> = CreatePolicyModule<LockPolicy>();
+		g_spPolicyModule<LockPolicy>->Initialize();
+		g_spPolicyModule<LockPolicy>->Start();
+	}
+
+	//all threads start loop together (after thread 0 prepared module)
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(g_spPolicyModule<LockPolicy>->Running());
+	}
+
+	state.SetItemsProcessed(state.iterations());
+
+	if (state.thread_index() == 0)
+	{
+		g_spPolicyModule<LockPolicy>->Stop();
+		g_spPolicyModule<LockPolicy>->Uninitialize();
+		g_spPolicyModule<LockPolicy>.reset();
+	}
+}
+BENCHMARK_TEMPLATE(BM_LockPolicy_Running, MsvSpinLockPolicy)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_LockPolicy_Running, MsvMutexLockPolicy)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_LockPolicy_Running, MsvSharedLockPolicy)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_LockPolicy_Running, MsvRecursiveLockPolicy)->ThreadRange(1, 64)->UseRealTime();
@@ -0,0 +1,205 @@
+
+
+#include "pch.h"
+
+#include "mmodule/MsvModuleManager.h"
+
+
+/*-----------------------------------------------------------------------------------------------------
+**											Helpers
+**---------------------------------------------------------------------------------------------------*/
+
+
+class MsvModuleManager_Benchmark
+{
+public:
+	MsvModuleManager_Benchmark(int64_t moduleCount, MsvSyntheticLatency latencyType):
+		m_spLoggerProvider(new MsvNullLoggerProvider())
+	{
+		m_spLogger = m_spLoggerProvider->GetLogger();
+
+		m_modules.reserve(static_cast<size_t>(moduleCount));
+		m_configurators.reserve(static_cast<size_t>(moduleCount));
+		for (int64_t i = 0; i < moduleCount; ++i)
+		{
+			m_modules.push_back(std::make_shared<MsvSyntheticModule>(m_spLoggerProvider, latencyType));
+			m_configurators.push_back(std::make_shared<MsvSyntheticModuleConfigurator>());
+		}
+
+		ResetModuleManager();
+	}
+
+	void ResetModuleManager()
+	{
+		m_spModuleManager.reset(new MsvModuleManager(m_spLogger));
+	}
+
+	void AddModules()
+	{
+		for (size_t i = 0; i < m_modules.size(); ++i)
+		{
+			m_spModuleManager->AddModule(static_cast<int32_t>(i), m_modules[i], m_configurators[i]);
+		}
+	}
+
+	std::shared_ptr<IMsvLoggerProvider> m_spLoggerProvider;
+	std::shared_ptr<MsvLogger> m_spLogger;
+	std::vector<std::shared_ptr<MsvSyntheticModule>> m_modules;
+	std::vector<std::shared_ptr<MsvSyntheticModuleConfigurator>> m_configurators;
+	std::shared_ptr<MsvModuleManager> m_spModuleManager;
+};
+
+//zero-cost modules from 10 to 100k, modules with latency from 10 to 1k (one transition is ~10 us)
+static void MsvModuleCounts(benchmark::internal::Benchmark* pBenchmark)
+{
+	for (int64_t moduleCount = 10; moduleCount <= 100000; moduleCount *= 10)
+	{
+		pBenchmark->Args({ moduleCount, static_cast<int64_t>(MsvSyntheticLatency::MSV_SYNTHETIC_LATENCY_ZERO) });
+	}
+
+	for (int64_t moduleCount = 10; moduleCount <= 1000; moduleCount *= 10)
+	{
+		pBenchmark->Args({ moduleCount, static_cast<int64_t>(MsvSyntheticLatency::MSV_SYNTHETIC_LATENCY_FIXED) });
+		pBenchmark->Args({ moduleCount, static_cast<int64_t>(MsvSyntheticLatency::MSV_SYNTHETIC_LATENCY_JITTER) });
+	}
+}
+
+static void SetModuleCounters(benchmark::State& state)
+{
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+	state.counters["modules"] = static_cast<double>(state.range(0));
+	state.counters["latency"] = static_cast<double>(state.range(1));
+}
+
+
+/*-----------------------------------------------------------------------------------------------------
+**											Lifecycle Benchmarks
+**---------------------------------------------------------------------------------------------------*/
+
+
+static void BM_ModuleManager_AddModule(benchmark::State& state)
+{
+	MsvModuleManager_Benchmark moduleManagerBenchmark(state.range(0), static_cast<MsvSyntheticLatency>(state.range(1)));
+
+	for (auto _ : state)
+	{
+		state.PauseTiming();
+		moduleManagerBenchmark.ResetModuleManager();
+		state.ResumeTiming();
+
+		moduleManagerBenchmark.AddModules();
+	}
+
+	SetModuleCounters(state);
+}
+BENCHMARK(BM_ModuleManager_AddModule)->Apply(MsvModuleCounts)->Unit(benchmark::kMicrosecond);
+
+static void BM_ModuleManager_Initialize(benchmark::State& state)
+{
+	MsvModuleManager_Benchmark moduleManagerBenchmark(state.range(0), static_cast<MsvSyntheticLatency>(state.range(1)));
+	moduleManagerBenchmark.AddModules();
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(moduleManagerBenchmark.m_spModuleManager->Initialize());
+
+		state.PauseTiming();
+		moduleManagerBenchmark.m_spModuleManager->Uninitialize();
+		state.ResumeTiming();
+	}
+
+	SetModuleCounters(state);
+}
+BENCHMARK(BM_ModuleManager_Initialize)->Apply(MsvModuleCounts)->Unit(benchmark::kMicrosecond);
+
+static void BM_ModuleManager_Start(benchmark::State& state)
+{
+	MsvModuleManager_Benchmark moduleManagerBenchmark(state.range(0), static_cast<MsvSyntheticLatency>(state.range(1)));
+	moduleManagerBenchmark.AddModules();
+	moduleManagerBenchmark.m_spModuleManager->Initialize();
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(moduleManagerBenchmark.m_spModuleManager->Start());
+
+		state.PauseTiming();
+		moduleManagerBenchmark.m_spModuleManager->Stop();
+		state.ResumeTiming();
+	}
+
+	SetModuleCounters(state);
+}
+BENCHMARK(BM_ModuleManager_Start)->Apply(MsvModuleCounts)->Unit(benchmark::kMicrosecond);
+
+static void BM_ModuleManager_Stop(benchmark::State& state)
+{
+	MsvModuleManager_Benchmark moduleManagerBenchmark(state.range(0), static_cast<MsvSyntheticLatency>(state.range(1)));
+	moduleManagerBenchmark.AddModules();
+	moduleManagerBenchmark.m_spModuleManager->Initialize();
+
+	for (auto _ : state)
+	{
+		state.PauseTiming();
+		moduleManagerBenchmark.m_spModuleManager->Start();
+		state.ResumeTiming();
+
+		benchmark::DoNotOptimize(moduleManagerBenchmark.m_spModuleManager->Stop());
+	}
+
+	SetModuleCounters(state);
+}
+BENCHMARK(BM_ModuleManager_Stop)->Apply(MsvModuleCounts)->Unit(benchmark::kMicrosecond);
+
+static void BM_ModuleManager_Uninitialize(benchmark::State& state)
+{
+	MsvModuleManager_Benchmark moduleManagerBenchmark(state.range(0), static_cast<MsvSyntheticLatency>(state.range(1)));
+	moduleManagerBenchmark.AddModules();
+
+	for (auto _ : state)
+	{
+		state.PauseTiming();
+		moduleManagerBenchmark.m_spModuleManager->Initialize();
+		state.ResumeTiming();
+
+		benchmark::DoNotOptimize(moduleManagerBenchmark.m_spModuleManager->Uninitialize());
+	}
+
+	SetModuleCounters(state);
+}
+BENCHMARK(BM_ModuleManager_Uninitialize)->Apply(MsvModuleCounts)->Unit(benchmark::kMicrosecond);
+
+
+/*-----------------------------------------------------------------------------------------------------
+**											Concurrent Query Benchmarks
+**---------------------------------------------------------------------------------------------------*/
+
+
+//shared by all benchmark threads (created and destroyed by thread 0)
+static std::shared_ptr<MsvModuleManager_Benchmark> g_spRunningModuleManager;
+
+static void BM_ModuleManager_Running(benchmark::State& state)
+{
+	if (state.thread_index() == 0)
+	{
+		g_spRunningModuleManager.reset(new MsvModuleManager_Benchmark(state.range(0), MsvSyntheticLatency::MSV_SYNTHETIC_LATENCY_ZERO));
+		g_spRunningModuleManager->AddModules();
+		g_spRunningModuleManager->m_spModuleManager->Initialize();
+		g_spRunningModuleManager->m_spModuleManager->Start();
+	}
+
+	//all threads start loop together (after thread 0 prepared module manager)
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(g_spRunningModuleManager->m_spModuleManager->Running());
+	}
+
+	state.SetItemsProcessed(state.iterations());
+
+	if (state.thread_index() == 0)
+	{
+		g_spRunningModuleManager->m_spModuleManager->Stop();
+		g_spRunningModuleManager->m_spModuleManager->Uninitialize();
+		g_spRunningModuleManager.reset();
+	}
+}
+BENCHMARK(BM_ModuleManager_Running)->Arg(1000)->ThreadRange(1, 64)->UseRealTime();
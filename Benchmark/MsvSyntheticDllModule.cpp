@@ -0,0 +1,41 @@
+//
+// MsvSyntheticDllModule.cpp
+// Shared library with synthetic DLL module (it is not part of benchmark executable).
+//
+// Build on Linux (next to mmoduleBenchmark executable):
+//   g++ -std=c++17 -O2 -shared -fPIC -I<include dirs> MsvSyntheticDllModule.cpp -o libMsvSyntheticDllModule.so
+//
+
+
+#include "MsvSyntheticDllModule.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <cstring>
+#include <new>
+
+MSV_ENABLE_WARNINGS
+
+
+#if defined(_WIN32)
+#define MSV_SYNTHETIC_DLL_EXPORT extern "C" __declspec(dllexport)
+#else
+#define MSV_SYNTHETIC_DLL_EXPORT extern "C" __attribute__((visibility("default")))
+#endif
+
+
+MSV_SYNTHETIC_DLL_EXPORT MsvErrorCode GetDllObject(const char* dllObjectId, std::shared_ptr<IMsvDllObject>& spDllObject)
+{
+	if (!dllObjectId || std::strcmp(dllObjectId, MSV_SYNTHETIC_DLL_MODULE_ID) != 0)
+	{
+		return MSV_NOT_FOUND_ERROR;
+	}
+
+	spDllObject.reset(new (std::nothrow) MsvSyntheticDllModule());
+	if (!spDllObject)
+	{
+		return MSV_ALLOCATION_ERROR;
+	}
+
+	return MSV_SUCCESS;
+}
@@ -0,0 +1,59 @@
+//
+// MsvSyntheticDllModule.h
+// Synthetic DLL module used by adapter benchmarks (in-process and from shared library).
+//
+
+#pragma once
+
+
+#include "merror/MsvErrorCodes.h"
+
+#include "mmodule/MsvDllModuleBase.h"
+
+
+/**************************************************************************************************//**
+* @brief		Synthetic DLL module ID.
+******************************************************************************************************/
+#define MSV_SYNTHETIC_DLL_MODULE_ID "MsvSyntheticDllModule"
+
+
+/**************************************************************************************************//**
+* @brief		Synthetic DLL module.
+* @details	Zero-cost DLL module (transitions only change state) - it measures pure adapter overhead.
+******************************************************************************************************/
+class MsvSyntheticDllModule:
+	public MsvDllModuleBase
+{
+public:
+	virtual MsvErrorCode Initialize() override
+	{
+		std::lock_guard<std::recursive_mutex> lock(m_lock);
+		m_initialized = true;
+		NotifyStateChanged();
+		return MSV_SUCCESS;
+	}
+
+	virtual MsvErrorCode Uninitialize() override
+	{
+		std::lock_guard<std::recursive_mutex> lock(m_lock);
+		m_initialized = false;
+		NotifyStateChanged();
+		return MSV_SUCCESS;
+	}
+
+	virtual MsvErrorCode Start() override
+	{
+		std::lock_guard<std::recursive_mutex> lock(m_lock);
+		m_running = true;
+		NotifyStateChanged();
+		return MSV_SUCCESS;
+	}
+
+	virtual MsvErrorCode Stop() override
+	{
+		std::lock_guard<std::recursive_mutex> lock(m_lock);
+		m_running = false;
+		NotifyStateChanged();
+		return MSV_SUCCESS;
+	}
+};
@@ -0,0 +1,162 @@
+//
+// MsvSyntheticModule.h
+// Synthetic modules used by benchmarks and stress harness.
+//
+
+#pragma once
+
+
+#include "merror/MsvErrorCodes.h"
+#include "mlogging/MsvSpdLogLoggerProvider.h"
+
+#include "mmodule/IMsvModuleConfigurator.h"
+#include "mmodule/MsvModuleBase.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <atomic>
+#include <chrono>
+#include <random>
+
+MSV_ENABLE_WARNINGS
+
+
+/**************************************************************************************************//**
+* @brief		Synthetic module latency.
+* @details	How long each transition of synthetic module takes.
+******************************************************************************************************/
+enum class MsvSyntheticLatency: int32_t
+{
+	MSV_SYNTHETIC_LATENCY_ZERO = 0,			///< Transition returns immediately.
+	MSV_SYNTHETIC_LATENCY_FIXED,				///< Transition busy-waits fixed time.
+	MSV_SYNTHETIC_LATENCY_JITTER				///< Transition busy-waits random time from 0 to twice fixed time.
+};
+
+
+/**************************************************************************************************//**
+* @brief		Synthetic module.
+* @details	Module with configurable latency and failure rate of transitions (busy-wait is used because sleep
+*				granularity is too coarse for microsecond latencies).
+******************************************************************************************************/
+class MsvSyntheticModule:
+	public MsvModuleBase
+{
+public:
+	MsvSyntheticModule(std::shared_ptr<IMsvLoggerProvider> spLoggerProvider, MsvSyntheticLatency latencyType = MsvSyntheticLatency::MSV_SYNTHETIC_LATENCY_ZERO,
+		std::chrono::nanoseconds latency = std::chrono::microseconds(10), uint32_t failurePermille = 0):
+		MsvModuleBase(spLoggerProvider, "MsvSyntheticModule"),
+		m_latencyType(latencyType),
+		m_latency(latency),
+		m_failurePermille(failurePermille)
+	{
+
+	}
+
+	virtual MsvErrorCode Initialize() override
+	{
+		std::lock_guard<std::recursive_mutex> lock(m_lock);
+		MSV_RETURN_FAILED(Transition());
+		m_initialized = true;
+		NotifyStateChanged();
+		return MSV_SUCCESS;
+	}
+
+	virtual MsvErrorCode Uninitialize() override
+	{
+		std::lock_guard<std::recursive_mutex> lock(m_lock);
+		Wait();
+		m_initialized = false;
+		NotifyStateChanged();
+		return MSV_SUCCESS;
+	}
+
+	virtual MsvErrorCode Start() override
+	{
+		std::lock_guard<std::recursive_mutex> lock(m_lock);
+		MSV_RETURN_FAILED(Transition());
+		m_running = true;
+		NotifyStateChanged();
+		return MSV_SUCCESS;
+	}
+
+	virtual MsvErrorCode Stop() override
+	{
+		std::lock_guard<std::recursive_mutex> lock(m_lock);
+		Wait();
+		m_running = false;
+		NotifyStateChanged();
+		return MSV_SUCCESS;
+	}
+
+protected:
+	//waits module latency and returns injected failure (initialize and start only)
+	MsvErrorCode Transition()
+	{
+		Wait();
+
+		if (m_failurePermille && GetRandom() % 1000 < m_failurePermille)
+		{
+			return MSV_INVALID_DATA_ERROR;
+		}
+
+		return MSV_SUCCESS;
+	}
+
+	void Wait()
+	{
+		std::chrono::nanoseconds latency = std::chrono::nanoseconds::zero();
+		switch (m_latencyType)
+		{
+		case MsvSyntheticLatency::MSV_SYNTHETIC_LATENCY_FIXED:
+			latency = m_latency;
+			break;
+		case MsvSyntheticLatency::MSV_SYNTHETIC_LATENCY_JITTER:
+			latency = std::chrono::nanoseconds(GetRandom() % (2 * static_cast<uint64_t>(m_latency.count()) + 1));
+			break;
+		default:
+			return;
+		}
+
+		std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + latency;
+		while (std::chrono::steady_clock::now() < deadline)
+		{
+			//busy-wait
+		}
+	}
+
+	static uint64_t GetRandom()
+	{
+		thread_local std::mt19937_64 generator(std::random_device{}());
+		return generator();
+	}
+
+	MsvSyntheticLatency m_latencyType;
+	std::chrono::nanoseconds m_latency;
+	uint32_t m_failurePermille;
+};
+
+
+/**************************************************************************************************//**
+* @brief		Synthetic module configurator.
+* @details	Configurator without configuration (module is always installed and enabled by default).
+******************************************************************************************************/
+class MsvSyntheticModuleConfigurator:
+	public IMsvModuleConfigurator
+{
+public:
+	MsvSyntheticModuleConfigurator():
+		m_enabled(true),
+		m_installed(true)
+	{
+
+	}
+
+	virtual MsvErrorCode Enabled(bool enabled) override { m_enabled = enabled; return MSV_SUCCESS; }
+	virtual MsvErrorCode IsEnabled(bool& enabled) const override { enabled = m_enabled; return MSV_SUCCESS; }
+	virtual MsvErrorCode Installed(bool installed) override { m_installed = installed; return MSV_SUCCESS; }
+	virtual MsvErrorCode IsInstalled(bool& installed) const override { installed = m_installed; return MSV_SUCCESS; }
+
+protected:
+	std::atomic<bool> m_enabled;
+	std::atomic<bool> m_installed;
+};
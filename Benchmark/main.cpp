@@ -0,0 +1,47 @@
+//
+// main.cpp
+// Runs all benchmarks. Results are written to console and to JSON file (mmoduleBenchmark.json by default,
+// it can be changed by --benchmark_out=<file>) to track regressions.
+//
+
+#include "pch.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <cstring>
+#include <vector>
+
+MSV_ENABLE_WARNINGS
+
+
+int main(int argc, char** argv)
+{
+	std::vector<char*> arguments(argv, argv + argc);
+
+	//write JSON results when output file is not set
+	bool outputSet = false;
+	for (int i = 1; i < argc; ++i)
+	{
+		outputSet |= std::strncmp(argv[i], "--benchmark_out=", std::strlen("--benchmark_out=")) == 0;
+	}
+
+	static char defaultOutput[] = "--benchmark_out=mmoduleBenchmark.json";
+	static char defaultOutputFormat[] = "--benchmark_out_format=json";
+	if (!outputSet)
+	{
+		arguments.push_back(defaultOutput);
+		arguments.push_back(defaultOutputFormat);
+	}
+
+	int argumentCount = static_cast<int>(arguments.size());
+	benchmark::Initialize(&argumentCount, arguments.data());
+	if (benchmark::ReportUnrecognizedArguments(argumentCount, arguments.data()))
+	{
+		return 1;
+	}
+
+	benchmark::RunSpecifiedBenchmarks();
+	benchmark::Shutdown();
+
+	return 0;
+}
@@ -0,0 +1,15 @@
+//
+// pch.h
+// Header for standard system include files used by benchmarks.
+//
+
+#pragma once
+
+
+#include "MsvSyntheticModule.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include "benchmark/benchmark.h"
+
+MSV_ENABLE_WARNINGS
@@ -0,0 +1,68 @@
+/**************************************************************************************************//**
+* @addtogroup	MMODULE
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Arena Consumer Interface
+* @details		Contains definition of @ref IMsvArenaConsumer interface (module which accepts its own memory arena).
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Module Library.
+
+MarsTech Dependency Injection is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef MARSTECH_IARENACONSUMER_H
+#define MARSTECH_IARENACONSUMER_H
+
+
+#include "MsvArena.h"
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Arena Consumer Interface.
+* @details	Module which accepts its own memory arena. Module manager sets new arena before module is initialized and
+*				resets it after module is uninitialized (@ref MsvModuleBaseT, @ref MsvDllModuleBaseT and
+*				@ref MsvDllModuleAdapter implement it). Memory allocated by module from its arena is accounted to module.
+*				Deallocated memory is reused by arena (see @ref MsvArena), so module can use it for allocations of
+*				running module too.
+******************************************************************************************************/
+class IMsvArenaConsumer
+{
+public:
+	/**************************************************************************************************//**
+	* @brief		Virtual destructor.
+	******************************************************************************************************/
+	virtual ~IMsvArenaConsumer() {}
+
+	/**************************************************************************************************//**
+	* @brief			Set arena.
+	* @details		Sets memory arena of module to module.
+	* @param[in]	spArena			Shared pointer to arena (empty when module has been uninitialized).
+	******************************************************************************************************/
+	virtual void SetArena(std::shared_ptr<MsvArena> spArena) = 0;
+};
+
+
+#endif // !MARSTECH_IARENACONSUMER_H
+
+/** @} */	//End of group MMODULE.
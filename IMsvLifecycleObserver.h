@@ -0,0 +1,104 @@
+/**************************************************************************************************//**
+* @addtogroup	MMODULE
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Lifecycle Observer Interface
+* @details		Contains definition of @ref MsvModuleState, @ref MsvLifecycleEvent and @ref IMsvLifecycleObserver
+*					interface (subscriber of lifecycle events of modules).
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Module Library.
+
+MarsTech Dependency Injection is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef MARSTECH_ILIFECYCLEOBSERVER_H
+#define MARSTECH_ILIFECYCLEOBSERVER_H
+
+
+#include "MsvModuleTimings.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+MSV_ENABLE_WARNINGS
+
+
+/**************************************************************************************************//**
+* @brief		Module state.
+* @details	Lifecycle states of module.
+******************************************************************************************************/
+enum class MsvModuleState: int32_t
+{
+	MSV_MODULE_STATE_UNINITIALIZED = 0,			///< Module is not initialized.
+	MSV_MODULE_STATE_INITIALIZED,					///< Module is initialized and it is not running.
+	MSV_MODULE_STATE_RUNNING						///< Module is running.
+};
+
+
+/**************************************************************************************************//**
+* @brief		Lifecycle event.
+* @details	Lifecycle transition of module done by module manager (successful or failed).
+******************************************************************************************************/
+struct MsvLifecycleEvent
+{
+	int32_t moduleId;										///< Module ID.
+	MsvModuleTransition transition;					///< Transition.
+	MsvModuleState oldState;							///< State before transition.
+	MsvModuleState newState;							///< State after transition (the same as old state when transition failed).
+	MsvErrorCode errorCode;								///< Result of transition.
+	std::chrono::nanoseconds duration;				///< Duration of transition.
+};
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Lifecycle Observer Interface.
+* @details	Subscriber of lifecycle events of modules (@ref MsvLifecycleNotifier). Events are delivered in batches on
+*				notifier thread (in order they happened).
+******************************************************************************************************/
+class IMsvLifecycleObserver
+{
+public:
+	/**************************************************************************************************//**
+	* @brief		Virtual destructor.
+	******************************************************************************************************/
+	virtual ~IMsvLifecycleObserver() {}
+
+	/**************************************************************************************************//**
+	* @brief			Lifecycle events.
+	* @details		Called on notifier thread with batch of events. Slow observer delays other observers only (it does
+	*					not block module manager).
+	* @param[in]	pEvents				Events.
+	* @param[in]	count					Number of events.
+	* @note			It must not throw.
+	******************************************************************************************************/
+	virtual void OnLifecycleEvents(const MsvLifecycleEvent* pEvents, size_t count) = 0;
+};
+
+
+#endif // !MARSTECH_ILIFECYCLEOBSERVER_H
+
+/** @} */	//End of group MMODULE.
@@ -0,0 +1,66 @@
+/**************************************************************************************************//**
+* @addtogroup	MMODULE
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Message Bus Consumer Interface
+* @details		Contains definition of @ref IMsvMessageBusConsumer interface (module which accepts message bus of
+*					module manager).
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Module Library.
+
+MarsTech Dependency Injection is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef MARSTECH_IMESSAGEBUSCONSUMER_H
+#define MARSTECH_IMESSAGEBUSCONSUMER_H
+
+
+#include "MsvMessageBus.h"
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Message Bus Consumer Interface.
+* @details	Module which accepts message bus of module manager. Module manager sets message bus before module is
+*				initialized (@ref MsvModuleBaseT, @ref MsvDllModuleBaseT and @ref MsvDllModuleAdapter implement it).
+******************************************************************************************************/
+class IMsvMessageBusConsumer
+{
+public:
+	/**************************************************************************************************//**
+	* @brief		Virtual destructor.
+	******************************************************************************************************/
+	virtual ~IMsvMessageBusConsumer() {}
+
+	/**************************************************************************************************//**
+	* @brief			Set message bus.
+	* @details		Sets message bus of module manager to module.
+	* @param[in]	spMessageBus		Shared pointer to message bus.
+	******************************************************************************************************/
+	virtual void SetMessageBus(std::shared_ptr<MsvMessageBus> spMessageBus) = 0;
+};
+
+
+#endif // !MARSTECH_IMESSAGEBUSCONSUMER_H
+
+/** @} */	//End of group MMODULE.
@@ -0,0 +1,72 @@
+/**************************************************************************************************//**
+* @addtogroup	MMODULE
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Module Heartbeat Interface
+* @details		Contains definition of @ref IMsvModuleHeartbeat interface (module which reports liveness to watchdog).
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Module Library.
+
+MarsTech Dependency Injection is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef MARSTECH_IMODULEHEARTBEAT_H
+#define MARSTECH_IMODULEHEARTBEAT_H
+
+
+#include "merror/MsvError.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <cstdint>
+
+MSV_ENABLE_WARNINGS
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Module Heartbeat Interface.
+* @details	Module which reports liveness by heartbeat counter. Watchdog of module manager (@ref MsvWatchdog) reads
+*				counter of running modules - module which does not increase it in heartbeat timeout is stalled.
+******************************************************************************************************/
+class IMsvModuleHeartbeat
+{
+public:
+	/**************************************************************************************************//**
+	* @brief		Virtual destructor.
+	******************************************************************************************************/
+	virtual ~IMsvModuleHeartbeat() {}
+
+	/**************************************************************************************************//**
+	* @brief		Get heartbeat.
+	* @details	Returns heartbeat counter. It must not lock (it is read by watchdog thread even when module is
+	*				deadlocked).
+	* @returns	uint64_t
+	******************************************************************************************************/
+	virtual uint64_t GetHeartbeat() const = 0;
+};
+
+
+#endif // !MARSTECH_IMODULEHEARTBEAT_H
+
+/** @} */	//End of group MMODULE.
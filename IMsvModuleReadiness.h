@@ -0,0 +1,102 @@
+/**************************************************************************************************//**
+* @addtogroup	MMODULE
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Module Readiness Interface
+* @details		Contains definition of @ref IMsvModuleReadiness interface (module which reports readiness separately from
+*					start).
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Module Library.
+
+MarsTech Dependency Injection is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef MARSTECH_IMODULEREADINESS_H
+#define MARSTECH_IMODULEREADINESS_H
+
+
+#include "merror/MsvError.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <chrono>
+#include <cstdint>
+
+MSV_ENABLE_WARNINGS
+
+
+/**************************************************************************************************//**
+* @brief		Default readiness timeout.
+* @details	How long module manager waits for dependencies to become ready before it starts their dependents.
+******************************************************************************************************/
+static const std::chrono::milliseconds MSV_READINESS_DEFAULT_TIMEOUT(30000);
+
+/**************************************************************************************************//**
+* @brief		Module state mask.
+* @details	Bits of state word of module bases which hold @ref MsvModuleState.
+******************************************************************************************************/
+static const int32_t MSV_MODULE_STATE_MASK = 0xFF;
+
+/**************************************************************************************************//**
+* @brief		Module ready flag.
+* @details	Bit of state word of module bases which is set when running module is ready.
+******************************************************************************************************/
+static const int32_t MSV_MODULE_READY_FLAG = 0x100;
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Module Readiness Interface.
+* @details	Module which reports readiness separately from start - start returns quickly and module becomes ready
+*				asynchronously (e.g. when its caches are warm). Module manager starts dependents of module only when it is
+*				ready. Modules which do not implement it are ready when they are running.
+******************************************************************************************************/
+class IMsvModuleReadiness
+{
+public:
+	/**************************************************************************************************//**
+	* @brief		Virtual destructor.
+	******************************************************************************************************/
+	virtual ~IMsvModuleReadiness() {}
+
+	/**************************************************************************************************//**
+	* @brief		Get ready flag.
+	* @retval	true		When module is running and ready.
+	* @retval	false		When module is not running or it is not ready yet.
+	******************************************************************************************************/
+	virtual bool Ready() const = 0;
+
+	/**************************************************************************************************//**
+	* @brief			Wait for ready.
+	* @details		Blocks until module is ready or timeout expires.
+	* @param[in]	timeout				Timeout.
+	* @retval		true					When module is running and ready.
+	* @retval		false					When timeout expired.
+	******************************************************************************************************/
+	virtual bool WaitForReady(std::chrono::milliseconds timeout) const = 0;
+};
+
+
+#endif // !MARSTECH_IMODULEREADINESS_H
+
+/** @} */	//End of group MMODULE.
@@ -0,0 +1,67 @@
+/**************************************************************************************************//**
+* @addtogroup	MMODULE
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Service Registry Consumer Interface
+* @details		Contains definition of @ref IMsvServiceRegistryConsumer interface (module which accepts service
+*					registry of module manager).
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Module Library.
+
+MarsTech Dependency Injection is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef MARSTECH_ISERVICEREGISTRYCONSUMER_H
+#define MARSTECH_ISERVICEREGISTRYCONSUMER_H
+
+
+#include "MsvServiceRegistry.h"
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Service Registry Consumer Interface.
+* @details	Module which accepts service registry of module manager. Module manager sets service registry before module
+*				is initialized (@ref MsvModuleBaseT, @ref MsvDllModuleBaseT and @ref MsvDllModuleAdapter implement it).
+******************************************************************************************************/
+class IMsvServiceRegistryConsumer
+{
+public:
+	/**************************************************************************************************//**
+	* @brief		Virtual destructor.
+	******************************************************************************************************/
+	virtual ~IMsvServiceRegistryConsumer() {}
+
+	/**************************************************************************************************//**
+	* @brief			Set service registry.
+	* @details		Sets service registry of module manager and module ID (module publishes its services with it).
+	* @param[in]	spServiceRegistry		Shared pointer to service registry.
+	* @param[in]	moduleId					Module ID.
+	******************************************************************************************************/
+	virtual void SetServiceRegistry(std::shared_ptr<MsvServiceRegistry> spServiceRegistry, int32_t moduleId) = 0;
+};
+
+
+#endif // !MARSTECH_ISERVICEREGISTRYCONSUMER_H
+
+/** @} */	//End of group MMODULE.
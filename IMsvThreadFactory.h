@@ -0,0 +1,101 @@
+/**************************************************************************************************//**
+* @addtogroup	MMODULE
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Thread Factory Interface
+* @details		Contains definition of @ref IMsvThreadFactory interface (creates module threads with module
+*					placement) and @ref IMsvThreadFactoryConsumer interface (module which accepts it).
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Module Library.
+
+MarsTech Dependency Injection is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef MARSTECH_ITHREADFACTORY_H
+#define MARSTECH_ITHREADFACTORY_H
+
+
+#include "merror/MsvError.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <functional>
+#include <memory>
+#include <thread>
+
+MSV_ENABLE_WARNINGS
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Thread Factory Interface.
+* @details	Creates threads of one module. Created threads run on CPUs of module placement and allocate memory
+*				from its NUMA node.
+******************************************************************************************************/
+class IMsvThreadFactory
+{
+public:
+	/**************************************************************************************************//**
+	* @brief		Virtual destructor.
+	******************************************************************************************************/
+	virtual ~IMsvThreadFactory() {}
+
+	/**************************************************************************************************//**
+	* @brief			Create thread.
+	* @details		Creates thread which applies module placement and runs function.
+	* @param[in]	function								Thread function.
+	* @param[out]	thread								Created thread (caller joins it).
+	* @retval		MSV_INVALID_DATA_ERROR			When function is empty or thread is joinable.
+	* @retval		MSV_ALLOCATION_ERROR				When thread could not be created.
+	* @retval		MSV_SUCCESS							On success.
+	******************************************************************************************************/
+	virtual MsvErrorCode CreateThread(std::function<void()> function, std::thread& thread) = 0;
+};
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Thread Factory Consumer Interface.
+* @details	Module which accepts thread factory. Module manager sets thread factory with module placement before
+*				module is initialized (@ref MsvModuleBaseT, @ref MsvDllModuleBaseT and @ref MsvDllModuleAdapter implement
+*				it).
+******************************************************************************************************/
+class IMsvThreadFactoryConsumer
+{
+public:
+	/**************************************************************************************************//**
+	* @brief		Virtual destructor.
+	******************************************************************************************************/
+	virtual ~IMsvThreadFactoryConsumer() {}
+
+	/**************************************************************************************************//**
+	* @brief			Set thread factory.
+	* @details		Sets thread factory of module to module.
+	* @param[in]	spThreadFactory		Shared pointer to thread factory.
+	******************************************************************************************************/
+	virtual void SetThreadFactory(std::shared_ptr<IMsvThreadFactory> spThreadFactory) = 0;
+};
+
+
+#endif // !MARSTECH_ITHREADFACTORY_H
+
+/** @} */	//End of group MMODULE.
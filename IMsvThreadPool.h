@@ -0,0 +1,109 @@
+/**************************************************************************************************//**
+* @addtogroup	MMODULE
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Thread Pool Interface
+* @details		Contains definition of @ref IMsvThreadPool interface (shared worker threads provided by module
+*					manager) and @ref IMsvThreadPoolConsumer interface (module which accepts it).
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Module Library.
+
+MarsTech Dependency Injection is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef MARSTECH_ITHREADPOOL_H
+#define MARSTECH_ITHREADPOOL_H
+
+
+#include "merror/MsvError.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+MSV_ENABLE_WARNINGS
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Thread Pool Interface.
+* @details	Worker threads shared by all modules of module manager. Modules submit tasks instead of creating
+*				their own threads.
+******************************************************************************************************/
+class IMsvThreadPool
+{
+public:
+	/**************************************************************************************************//**
+	* @brief		Virtual destructor.
+	******************************************************************************************************/
+	virtual ~IMsvThreadPool() {}
+
+	/**************************************************************************************************//**
+	* @brief			Submit task.
+	* @details		Queues task to be run by worker thread. Tasks submitted from worker thread are queued to its own
+	*					queue (idle workers steal them). Worker threads of lazily started thread pool are started by the
+	*					first task.
+	* @param[in]	task									Task (it should not block for long time, exceptions are caught and logged).
+	* @retval		MSV_INVALID_DATA_ERROR			When task is empty.
+	* @retval		MSV_ALLOCATION_ERROR				When worker threads can not be started.
+	* @retval		MSV_NOT_INITIALIZED_ERROR		When thread pool is not running (and task is not submitted from worker thread
+	*														of stopping thread pool).
+	* @retval		MSV_SUCCESS							On success.
+	******************************************************************************************************/
+	virtual MsvErrorCode Submit(std::function<void()> task) = 0;
+
+	/**************************************************************************************************//**
+	* @brief		Get thread count.
+	* @returns	size_t
+	******************************************************************************************************/
+	virtual size_t GetThreadCount() const = 0;
+};
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Thread Pool Consumer Interface.
+* @details	Module which accepts thread pool of module manager. Module manager sets thread pool before module is
+*				initialized (@ref MsvModuleBaseT, @ref MsvDllModuleBaseT and @ref MsvDllModuleAdapter implement it).
+******************************************************************************************************/
+class IMsvThreadPoolConsumer
+{
+public:
+	/**************************************************************************************************//**
+	* @brief		Virtual destructor.
+	******************************************************************************************************/
+	virtual ~IMsvThreadPoolConsumer() {}
+
+	/**************************************************************************************************//**
+	* @brief			Set thread pool.
+	* @details		Sets thread pool of module manager to module.
+	* @param[in]	spThreadPool		Shared pointer to thread pool.
+	******************************************************************************************************/
+	virtual void SetThreadPool(std::shared_ptr<IMsvThreadPool> spThreadPool) = 0;
+};
+
+
+#endif // !MARSTECH_ITHREADPOOL_H
+
+/** @} */	//End of group MMODULE.
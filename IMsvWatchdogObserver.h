@@ -0,0 +1,100 @@
+/**************************************************************************************************//**
+* @addtogroup	MMODULE
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Watchdog Observer Interface
+* @details		Contains definition of @ref IMsvWatchdogObserver interface (subscriber of stalled modules) and
+*					@ref MsvModuleStall.
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Module Library.
+
+MarsTech Dependency Injection is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef MARSTECH_IWATCHDOGOBSERVER_H
+#define MARSTECH_IWATCHDOGOBSERVER_H
+
+
+#include "MsvModuleTimings.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+MSV_ENABLE_WARNINGS
+
+
+/**************************************************************************************************//**
+* @brief		Module stall type.
+******************************************************************************************************/
+enum class MsvModuleStallType
+{
+	MSV_MODULE_STALL_TRANSITION = 0,				///< Transition of module takes longer than transition timeout.
+	MSV_MODULE_STALL_HEARTBEAT						///< Running module has not reported heartbeat in heartbeat timeout.
+};
+
+
+/**************************************************************************************************//**
+* @brief		Module stall.
+* @details	Stalled module detected by watchdog (it is reported once per stall).
+******************************************************************************************************/
+struct MsvModuleStall
+{
+	int32_t moduleId;										///< Module ID.
+	MsvModuleStallType type;							///< Stall type.
+	MsvModuleTransition transition;					///< Stalled transition (transition stall only).
+	std::chrono::milliseconds duration;				///< How long module has been stalled.
+	std::vector<std::string> stack;					///< Stack of thread which runs stalled transition (empty when it is not
+																///< captured).
+};
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Watchdog Observer Interface.
+* @details	Subscriber of stalled modules (@ref MsvWatchdog). It is called on watchdog thread.
+******************************************************************************************************/
+class IMsvWatchdogObserver
+{
+public:
+	/**************************************************************************************************//**
+	* @brief		Virtual destructor.
+	******************************************************************************************************/
+	virtual ~IMsvWatchdogObserver() {}
+
+	/**************************************************************************************************//**
+	* @brief			On module stalled.
+	* @details		Called when watchdog detects stalled module. It should return quickly (watchdog does not check
+	*					modules meanwhile).
+	* @param[in]	stall					Module stall.
+	******************************************************************************************************/
+	virtual void OnModuleStalled(const MsvModuleStall& stall) = 0;
+};
+
+
+#endif // !MARSTECH_IWATCHDOGOBSERVER_H
+
+/** @} */	//End of group MMODULE.
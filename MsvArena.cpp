@@ -0,0 +1,361 @@
+/**************************************************************************************************//**
+* @addtogroup	MMODULE
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Arena
+* @details		Contains implementation of @ref MsvArena.
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Module Library.
+
+MarsTech Dependency Injection is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "MsvArena.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+MSV_ENABLE_WARNINGS
+
+
+/********************************************************************************************************************************
+*															Constructors and destructors
+********************************************************************************************************************************/
+
+
+MsvArena::MsvArena(size_t chunkSize, bool hugePages):
+	m_chunkSize(chunkSize),
+	m_pChunks(nullptr),
+	m_pCurrentChunk(nullptr),
+	m_maxClassSize(0),
+	m_offset(0),
+	m_liveSize(0),
+	m_reservedSize(0),
+	m_peakSize(0),
+	m_hugePages(hugePages)
+{
+	for (size_t i = 0; i < MSV_ARENA_SIZE_CLASS_COUNT; ++i)
+	{
+		m_freeLists[i] = nullptr;
+	}
+
+	//size classes must fit to chunk (larger allocations get their own chunk)
+	for (size_t classSize = MSV_ARENA_MIN_CLASS_SIZE; classSize <= (MSV_ARENA_MIN_CLASS_SIZE << (MSV_ARENA_SIZE_CLASS_COUNT - 1)); classSize <<= 1)
+	{
+		if (sizeof(MsvArenaChunk) + alignof(std::max_align_t) - 1 + classSize > m_chunkSize / 4)
+		{
+			break;
+		}
+
+		m_maxClassSize = classSize;
+	}
+}
+
+MsvArena::~MsvArena()
+{
+	//bulk release (objects are not destroyed - all users of arena must be destroyed before)
+	while (m_pChunks)
+	{
+		MsvArenaChunk* pChunk = m_pChunks;
+		m_pChunks = pChunk->pNext;
+		ReleaseChunk(pChunk);
+	}
+}
+
+
+/********************************************************************************************************************************
+*															MsvArena public methods
+********************************************************************************************************************************/
+
+
+void* MsvArena::Allocate(size_t size, size_t alignment)
+{
+	if (alignment == 0 || (alignment & (alignment - 1)) != 0 || size > SIZE_MAX / 2)
+	{
+		//invalid alignment or size
+		return nullptr;
+	}
+
+	if (size == 0)
+	{
+		//every allocation has unique address
+		size = 1;
+	}
+
+	std::lock_guard<std::mutex> lock(m_lock);
+
+	void* pMemory = nullptr;
+	size_t sizeClass = GetSizeClass(size);
+	if (sizeClass < MSV_ARENA_SIZE_CLASS_COUNT)
+	{
+		if (alignment <= alignof(std::max_align_t) && m_freeLists[sizeClass])
+		{
+			//reuse deallocated memory of the same size class
+			pMemory = m_freeLists[sizeClass];
+			m_freeLists[sizeClass] = *static_cast<void**>(pMemory);
+		}
+		else
+		{
+			//memory of size class can be reused by any allocation of its size class -> it is aligned for any fundamental type
+			pMemory = AllocateFromChunk(MSV_ARENA_MIN_CLASS_SIZE << sizeClass, alignment > alignof(std::max_align_t) ? alignment : alignof(std::max_align_t), false);
+		}
+	}
+	else
+	{
+		//large allocation gets its own chunk (it is released when allocation is deallocated)
+		pMemory = AllocateFromChunk(size, alignment, true);
+	}
+
+	if (!pMemory)
+	{
+		return nullptr;
+	}
+
+	m_liveSize += size;
+	m_peakSize = m_liveSize > m_peakSize ? m_liveSize : m_peakSize;
+	return pMemory;
+}
+
+void MsvArena::Deallocate(void* pMemory, size_t size)
+{
+	if (!pMemory)
+	{
+		return;
+	}
+
+	if (size == 0)
+	{
+		//zero size allocation has been allocated as one byte
+		size = 1;
+	}
+
+	std::lock_guard<std::mutex> lock(m_lock);
+
+	m_liveSize -= size;
+
+	size_t sizeClass = GetSizeClass(size);
+	if (sizeClass < MSV_ARENA_SIZE_CLASS_COUNT)
+	{
+		//memory is reused by next allocation of the same size class
+		*static_cast<void**>(pMemory) = m_freeLists[sizeClass];
+		m_freeLists[sizeClass] = pMemory;
+		return;
+	}
+
+	ReleaseDedicatedChunk(pMemory);
+}
+
+size_t MsvArena::GetLiveSize() const
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+
+	return m_liveSize;
+}
+
+size_t MsvArena::GetReservedSize() const
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+
+	return m_reservedSize;
+}
+
+size_t MsvArena::GetPeakSize() const
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+
+	return m_peakSize;
+}
+
+void MsvArena::GetUsage(MsvArenaUsage& usage) const
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+
+	usage.liveSize = m_liveSize;
+	usage.peakSize = m_peakSize;
+	usage.reservedSize = m_reservedSize;
+}
+
+bool MsvArena::HugePages() const
+{
+	//flag is not changed after construction (no need to lock arena)
+	return m_hugePages;
+}
+
+
+/********************************************************************************************************************************
+*															MsvArena protected methods
+********************************************************************************************************************************/
+
+
+size_t MsvArena::GetSizeClass(size_t size) const
+{
+	size_t sizeClass = 0;
+	size_t classSize = MSV_ARENA_MIN_CLASS_SIZE;
+	while (classSize < size && classSize < m_maxClassSize)
+	{
+		classSize <<= 1;
+		++sizeClass;
+	}
+
+	return size <= classSize && classSize <= m_maxClassSize ? sizeClass : MSV_ARENA_SIZE_CLASS_COUNT;
+}
+
+void* MsvArena::AllocateFromChunk(size_t size, size_t alignment, bool dedicated)
+{
+	//allocate from current chunk when it fits
+	if (m_pCurrentChunk && !dedicated)
+	{
+		uintptr_t chunkAddress = reinterpret_cast<uintptr_t>(m_pCurrentChunk);
+		uintptr_t address = (chunkAddress + m_offset + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1);
+		if (address + size <= chunkAddress + m_pCurrentChunk->size)
+		{
+			m_offset = static_cast<size_t>(address + size - chunkAddress);
+			return reinterpret_cast<void*>(address);
+		}
+	}
+
+	//reserve new chunk (large allocations get their own chunk and current chunk is kept)
+	size_t requiredSize = sizeof(MsvArenaChunk) + alignment - 1 + size;
+	bool dedicatedChunk = dedicated || requiredSize > m_chunkSize / 4;
+	MsvArenaChunk* pChunk = ReserveChunk(dedicatedChunk ? requiredSize : m_chunkSize);
+	if (!pChunk)
+	{
+		return nullptr;
+	}
+
+	uintptr_t chunkAddress = reinterpret_cast<uintptr_t>(pChunk);
+	uintptr_t address = (chunkAddress + sizeof(MsvArenaChunk) + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1);
+	if (!dedicatedChunk)
+	{
+		m_pCurrentChunk = pChunk;
+		m_offset = static_cast<size_t>(address + size - chunkAddress);
+	}
+
+	return reinterpret_cast<void*>(address);
+}
+
+void MsvArena::ReleaseDedicatedChunk(void* pMemory)
+{
+	uintptr_t address = reinterpret_cast<uintptr_t>(pMemory);
+	MsvArenaChunk** ppChunk = &m_pChunks;
+	while (*ppChunk)
+	{
+		MsvArenaChunk* pChunk = *ppChunk;
+		uintptr_t chunkAddress = reinterpret_cast<uintptr_t>(pChunk);
+		if (address > chunkAddress && address < chunkAddress + pChunk->size && pChunk != m_pCurrentChunk)
+		{
+			*ppChunk = pChunk->pNext;
+			m_reservedSize -= pChunk->size;
+			ReleaseChunk(pChunk);
+			return;
+		}
+
+		ppChunk = &pChunk->pNext;
+	}
+}
+
+MsvArena::MsvArenaChunk* MsvArena::ReserveChunk(size_t size)
+{
+	MsvArenaChunk* pChunk = nullptr;
+	bool mapped = false;
+
+	//smaller chunks would waste most of huge page -> they are allocated from heap
+	if (m_hugePages && size >= MSV_ARENA_HUGE_PAGE_SIZE)
+	{
+		if (size > SIZE_MAX - MSV_ARENA_HUGE_PAGE_SIZE)
+		{
+			return nullptr;
+		}
+
+		//huge pages are mapped in whole pages
+		size = (size + MSV_ARENA_HUGE_PAGE_SIZE - 1) & ~(MSV_ARENA_HUGE_PAGE_SIZE - 1);
+
+#if defined(_WIN32)
+		//large pages require SeLockMemoryPrivilege -> heap is used when they are not available
+		SIZE_T largePageSize = GetLargePageMinimum();
+		if (largePageSize != 0 && size % largePageSize == 0)
+		{
+			pChunk = static_cast<MsvArenaChunk*>(VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE));
+		}
+#else
+		//reserved huge pages first, transparent huge pages when pool of huge pages is empty
+		void* pMemory = MAP_FAILED;
+#if defined(MAP_HUGETLB)
+		pMemory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+#endif
+		if (pMemory == MAP_FAILED)
+		{
+			pMemory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+#if defined(MADV_HUGEPAGE)
+			if (pMemory != MAP_FAILED)
+			{
+				madvise(pMemory, size, MADV_HUGEPAGE);
+			}
+#endif
+		}
+		pChunk = pMemory == MAP_FAILED ? nullptr : static_cast<MsvArenaChunk*>(pMemory);
+#endif
+		mapped = pChunk != nullptr;
+	}
+
+	if (!pChunk)
+	{
+		pChunk = static_cast<MsvArenaChunk*>(::operator new(size, std::nothrow));
+		if (!pChunk)
+		{
+			return nullptr;
+		}
+	}
+
+	pChunk->pNext = m_pChunks;
+	pChunk->size = size;
+	pChunk->mapped = mapped;
+	m_pChunks = pChunk;
+	m_reservedSize += size;
+
+	return pChunk;
+}
+
+void MsvArena::ReleaseChunk(MsvArenaChunk* pChunk)
+{
+	if (!pChunk->mapped)
+	{
+		::operator delete(pChunk);
+		return;
+	}
+
+#if defined(_WIN32)
+	VirtualFree(pChunk, 0, MEM_RELEASE);
+#else
+	munmap(pChunk, pChunk->size);
+#endif
+}
+
+
+/** @} */	//End of group MMODULE.
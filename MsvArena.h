@@ -0,0 +1,393 @@
+/**************************************************************************************************//**
+* @addtogroup	MMODULE
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Arena
+* @details		Contains definition of @ref MsvArena (monotonic memory arena) and @ref MsvArenaAllocator
+*					(standard allocator which allocates from arena).
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Module Library.
+
+MarsTech Dependency Injection is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef MARSTECH_ARENA_H
+#define MARSTECH_ARENA_H
+
+
+#include "merror/MsvError.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+
+MSV_ENABLE_WARNINGS
+
+
+/**************************************************************************************************//**
+* @brief		Default arena chunk size.
+* @details	Size of memory chunks reserved by arena (larger allocations get their own chunk).
+******************************************************************************************************/
+static const size_t MSV_ARENA_DEFAULT_CHUNK_SIZE = 64 * 1024;
+
+/**************************************************************************************************//**
+* @brief		Huge page size.
+* @details	Chunks of arena backed by huge pages are rounded up to this size (smaller chunks are allocated from
+*				heap).
+******************************************************************************************************/
+static const size_t MSV_ARENA_HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+/**************************************************************************************************//**
+* @brief		Minimal size class.
+* @details	Size of the smallest size class of arena (size classes are powers of two).
+******************************************************************************************************/
+static const size_t MSV_ARENA_MIN_CLASS_SIZE = 16;
+
+/**************************************************************************************************//**
+* @brief		Size class count.
+* @details	Maximal number of size classes of arena (only size classes which fit to chunk are used).
+******************************************************************************************************/
+static const size_t MSV_ARENA_SIZE_CLASS_COUNT = 24;
+
+
+/**************************************************************************************************//**
+* @brief		Arena usage.
+* @details	Memory usage of arena (snapshot).
+******************************************************************************************************/
+struct MsvArenaUsage
+{
+	size_t liveSize;										///< Size of allocated and not deallocated memory.
+	size_t peakSize;										///< Maximal live size.
+	size_t reservedSize;									///< Size of all reserved chunks.
+};
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Arena.
+* @details	Thread safe memory arena. Memory is allocated from large chunks (objects allocated together are
+*				co-located). Small allocations are rounded up to size classes (powers of two) and deallocated memory
+*				is reused by next allocations of the same size class, so allocation churn of long running module does
+*				not grow the arena. Large allocations get their own chunk which is released when they are deallocated.
+*				All chunks are released at once when arena is destroyed.
+******************************************************************************************************/
+class MsvArena
+{
+public:
+	/**************************************************************************************************//**
+	* @brief			Constructor.
+	* @param[in]	chunkSize			Size of memory chunks.
+	* @param[in]	hugePages			Flag if chunks should be backed by huge pages (true) or not (false). Only chunks of
+	*										at least @ref MSV_ARENA_HUGE_PAGE_SIZE are backed by huge pages (they are rounded
+	*										up to whole huge pages) - use chunk size of at least one huge page.
+	******************************************************************************************************/
+	MsvArena(size_t chunkSize = MSV_ARENA_DEFAULT_CHUNK_SIZE, bool hugePages = false);
+
+	/**************************************************************************************************//**
+	* @brief		Virtual destructor.
+	* @details	Releases all chunks.
+	******************************************************************************************************/
+	virtual ~MsvArena();
+
+	MsvArena(const MsvArena&) = delete;
+	MsvArena& operator=(const MsvArena&) = delete;
+
+	/**************************************************************************************************//**
+	* @brief			Allocate.
+	* @details		Allocates memory of size class from its free list or from current chunk (new chunk is reserved when
+	*					it does not fit). Large allocation gets its own chunk.
+	* @param[in]	size					Size of memory.
+	* @param[in]	alignment			Alignment of memory (power of two).
+	* @returns		void* (nullptr when allocation failed)
+	******************************************************************************************************/
+	virtual void* Allocate(size_t size, size_t alignment);
+
+	/**************************************************************************************************//**
+	* @brief			Deallocate.
+	* @details		Marks memory as not used. Memory of size class is reused by next allocation of the same size class,
+	*					chunk of large allocation is released.
+	* @param[in]	pMemory				Memory allocated by @ref Allocate.
+	* @param[in]	size					Size of memory (the same as allocated size).
+	******************************************************************************************************/
+	virtual void Deallocate(void* pMemory, size_t size);
+
+	/**************************************************************************************************//**
+	* @brief		Get live size.
+	* @details	Returns size of allocated and not deallocated memory.
+	* @returns	size_t
+	******************************************************************************************************/
+	virtual size_t GetLiveSize() const;
+
+	/**************************************************************************************************//**
+	* @brief		Get reserved size.
+	* @details	Returns size of all reserved chunks.
+	* @returns	size_t
+	******************************************************************************************************/
+	virtual size_t GetReservedSize() const;
+
+	/**************************************************************************************************//**
+	* @brief		Get peak size.
+	* @details	Returns maximal live size since arena has been created.
+	* @returns	size_t
+	******************************************************************************************************/
+	virtual size_t GetPeakSize() const;
+
+	/**************************************************************************************************//**
+	* @brief			Get usage.
+	* @details		Returns live, peak and reserved size at once.
+	* @param[out]	usage					Arena usage.
+	******************************************************************************************************/
+	virtual void GetUsage(MsvArenaUsage& usage) const;
+
+	/**************************************************************************************************//**
+	* @brief		Get huge pages flag.
+	* @retval	true		When chunks are backed by huge pages (when operating system provides them).
+	* @retval	false		When chunks are allocated from heap.
+	******************************************************************************************************/
+	virtual bool HugePages() const;
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Chunk header.
+	* @details	Header at the beginning of every chunk (chunks are linked).
+	******************************************************************************************************/
+	struct MsvArenaChunk
+	{
+		MsvArenaChunk* pNext;						///< Next chunk.
+		size_t size;									///< Chunk size (with header).
+		bool mapped;									///< Flag if chunk is mapped from operating system (true) or allocated from heap (false).
+	};
+
+	/**************************************************************************************************//**
+	* @brief			Get size class.
+	* @param[in]	size					Size of memory.
+	* @returns		size_t (index of size class or @ref MSV_ARENA_SIZE_CLASS_COUNT when size is large)
+	******************************************************************************************************/
+	virtual size_t GetSizeClass(size_t size) const;
+
+	/**************************************************************************************************//**
+	* @brief			Allocate from chunk.
+	* @details		Allocates memory from current chunk (new chunk is reserved when it does not fit). Large memory gets
+	*					its own chunk and current chunk is kept (arena must be locked).
+	* @param[in]	size					Size of memory.
+	* @param[in]	alignment			Alignment of memory (power of two).
+	* @param[in]	dedicated			Flag if memory gets its own chunk (true) or not (false - it is decided by size).
+	* @returns		void* (nullptr when allocation failed)
+	******************************************************************************************************/
+	virtual void* AllocateFromChunk(size_t size, size_t alignment, bool dedicated);
+
+	/**************************************************************************************************//**
+	* @brief			Release dedicated chunk.
+	* @details		Unlinks and releases chunk which contains memory of large allocation (arena must be locked).
+	* @param[in]	pMemory				Memory allocated from dedicated chunk.
+	******************************************************************************************************/
+	virtual void ReleaseDedicatedChunk(void* pMemory);
+
+	/**************************************************************************************************//**
+	* @brief			Reserve chunk.
+	* @details		Reserves new chunk and links it to chunk list.
+	* @param[in]	size					Chunk size (with header).
+	* @returns		MsvArenaChunk* (nullptr when allocation failed)
+	******************************************************************************************************/
+	virtual MsvArenaChunk* ReserveChunk(size_t size);
+
+	/**************************************************************************************************//**
+	* @brief			Release chunk.
+	* @details		Returns chunk memory to operating system or heap.
+	* @param[in]	pChunk				Chunk reserved by @ref ReserveChunk.
+	******************************************************************************************************/
+	virtual void ReleaseChunk(MsvArenaChunk* pChunk);
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Arena mutex.
+	* @details	Locks this object for thread safety access.
+	******************************************************************************************************/
+	mutable std::mutex m_lock;
+
+	/**************************************************************************************************//**
+	* @brief		Chunk size.
+	******************************************************************************************************/
+	size_t m_chunkSize;
+
+	/**************************************************************************************************//**
+	* @brief		Chunks.
+	* @details	Linked list of all chunks (the last reserved first).
+	******************************************************************************************************/
+	MsvArenaChunk* m_pChunks;
+
+	/**************************************************************************************************//**
+	* @brief		Current chunk.
+	* @details	Chunk small allocations are allocated from.
+	******************************************************************************************************/
+	MsvArenaChunk* m_pCurrentChunk;
+
+	/**************************************************************************************************//**
+	* @brief		Free lists.
+	* @details	Deallocated memory by size class (first bytes of every free memory point to next free memory).
+	******************************************************************************************************/
+	void* m_freeLists[MSV_ARENA_SIZE_CLASS_COUNT];
+
+	/**************************************************************************************************//**
+	* @brief		Maximal class size.
+	* @details	Size of the largest size class which fits to chunk (larger allocations get their own chunk).
+	******************************************************************************************************/
+	size_t m_maxClassSize;
+
+	/**************************************************************************************************//**
+	* @brief		Offset in current chunk.
+	* @details	Offset of first free byte in current chunk.
+	******************************************************************************************************/
+	size_t m_offset;
+
+	/**************************************************************************************************//**
+	* @brief		Live size.
+	******************************************************************************************************/
+	size_t m_liveSize;
+
+	/**************************************************************************************************//**
+	* @brief		Reserved size.
+	******************************************************************************************************/
+	size_t m_reservedSize;
+
+	/**************************************************************************************************//**
+	* @brief		Peak size.
+	* @details	Maximal live size.
+	******************************************************************************************************/
+	size_t m_peakSize;
+
+	/**************************************************************************************************//**
+	* @brief		Huge pages flag.
+	* @details	Flag if chunks should be backed by huge pages (true) or not (false).
+	******************************************************************************************************/
+	bool m_hugePages;
+};
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Arena Allocator.
+* @details	Standard allocator which allocates from @ref MsvArena. It holds shared pointer to arena - arena lives as
+*				long as any container or shared object (e.g. created by std::allocate_shared) which uses it.
+* @tparam		T						Allocated type.
+* @note		Allocator throws std::bad_alloc when arena allocation failed (it is required by standard containers).
+******************************************************************************************************/
+template<class T>
+class MsvArenaAllocator
+{
+public:
+	typedef T value_type;							///< Allocated type.
+
+	/**************************************************************************************************//**
+	* @brief			Constructor.
+	* @param[in]	spArena				Shared pointer to arena.
+	******************************************************************************************************/
+	MsvArenaAllocator(std::shared_ptr<MsvArena> spArena) noexcept:
+		m_spArena(spArena)
+	{
+
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Converting constructor.
+	* @param[in]	other					Allocator of other type.
+	******************************************************************************************************/
+	template<class U>
+	MsvArenaAllocator(const MsvArenaAllocator<U>& other) noexcept:
+		m_spArena(other.GetArena())
+	{
+
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Allocate.
+	* @param[in]	count					Number of objects.
+	* @returns		T*
+	******************************************************************************************************/
+	T* allocate(size_t count)
+	{
+		if (count > SIZE_MAX / sizeof(T))
+		{
+			throw std::bad_alloc();
+		}
+
+		void* pMemory = m_spArena->Allocate(count * sizeof(T), alignof(T));
+		if (!pMemory)
+		{
+			throw std::bad_alloc();
+		}
+
+		return static_cast<T*>(pMemory);
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Deallocate.
+	* @param[in]	pMemory				Memory allocated by @ref allocate.
+	* @param[in]	count					Number of objects.
+	******************************************************************************************************/
+	void deallocate(T* pMemory, size_t count) noexcept
+	{
+		m_spArena->Deallocate(pMemory, count * sizeof(T));
+	}
+
+	/**************************************************************************************************//**
+	* @brief		Get arena.
+	* @returns	const std::shared_ptr<MsvArena>&
+	******************************************************************************************************/
+	const std::shared_ptr<MsvArena>& GetArena() const noexcept
+	{
+		return m_spArena;
+	}
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Arena.
+	******************************************************************************************************/
+	std::shared_ptr<MsvArena> m_spArena;
+};
+
+/**************************************************************************************************//**
+* @brief		Allocators are equal when they use the same arena.
+******************************************************************************************************/
+template<class T, class U>
+bool operator==(const MsvArenaAllocator<T>& left, const MsvArenaAllocator<U>& right) noexcept
+{
+	return left.GetArena() == right.GetArena();
+}
+
+/**************************************************************************************************//**
+* @brief		Allocators are not equal when they use different arenas.
+******************************************************************************************************/
+template<class T, class U>
+bool operator!=(const MsvArenaAllocator<T>& left, const MsvArenaAllocator<U>& right) noexcept
+{
+	return !(left == right);
+}
+
+
+#endif // !MARSTECH_ARENA_H
+
+/** @} */	//End of group MMODULE.
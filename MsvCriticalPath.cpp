@@ -0,0 +1,196 @@
+/**************************************************************************************************//**
+* @addtogroup	MMODULE
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Critical Path
+* @details		Contains implementation of @ref MsvCriticalPathAnalyzer.
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Module Library.
+
+MarsTech Dependency Injection is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "MsvCriticalPath.h"
+
+#include "merror/MsvErrorCodes.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <algorithm>
+
+MSV_ENABLE_WARNINGS
+
+
+/********************************************************************************************************************************
+*															Public methods
+********************************************************************************************************************************/
+
+
+MsvErrorCode MsvCriticalPathAnalyzer::Analyze(const std::vector<int32_t>& startupOrder, const std::map<int32_t, std::vector<int32_t>>& dependencies,
+	const std::unordered_map<int32_t, std::chrono::nanoseconds>& durations, MsvCriticalPath& criticalPath)
+{
+	criticalPath.totalDuration = std::chrono::nanoseconds::zero();
+	criticalPath.sequentialDuration = std::chrono::nanoseconds::zero();
+	criticalPath.path.clear();
+	criticalPath.modules.clear();
+	criticalPath.modules.reserve(startupOrder.size());
+
+	//position of modules in startup order
+	std::unordered_map<int32_t, size_t> positions;
+	for (size_t index = 0; index < startupOrder.size(); ++index)
+	{
+		positions[startupOrder[index]] = index;
+	}
+
+	//dependencies (positions) of modules and their dependents
+	std::vector<std::vector<size_t>> moduleDependencies(startupOrder.size());
+	std::vector<std::vector<size_t>> moduleDependents(startupOrder.size());
+	for (std::map<int32_t, std::vector<int32_t>>::const_iterator it = dependencies.begin(); it != dependencies.end(); ++it)
+	{
+		std::unordered_map<int32_t, size_t>::const_iterator moduleIt = positions.find(it->first);
+		if (moduleIt == positions.end())
+		{
+			continue;
+		}
+
+		for (std::vector<int32_t>::const_iterator dependencyIt = it->second.begin(); dependencyIt != it->second.end(); ++dependencyIt)
+		{
+			std::unordered_map<int32_t, size_t>::const_iterator dependencyPositionIt = positions.find(*dependencyIt);
+			if (dependencyPositionIt == positions.end())
+			{
+				continue;
+			}
+
+			if (dependencyPositionIt->second >= moduleIt->second)
+			{
+				//dependency is started after its dependent -> it is not startup order
+				criticalPath.modules.clear();
+				return MSV_INVALID_DATA_ERROR;
+			}
+
+			moduleDependencies[moduleIt->second].push_back(dependencyPositionIt->second);
+			moduleDependents[dependencyPositionIt->second].push_back(moduleIt->second);
+		}
+	}
+
+	//forward pass (earliest start and finish)
+	for (size_t index = 0; index < startupOrder.size(); ++index)
+	{
+		MsvCriticalPathModule module = {};
+		module.moduleId = startupOrder[index];
+
+		std::unordered_map<int32_t, std::chrono::nanoseconds>::const_iterator durationIt = durations.find(module.moduleId);
+		module.duration = durationIt != durations.end() ? durationIt->second : std::chrono::nanoseconds::zero();
+
+		for (std::vector<size_t>::const_iterator it = moduleDependencies[index].begin(); it != moduleDependencies[index].end(); ++it)
+		{
+			module.earliestStart = std::max(module.earliestStart, criticalPath.modules[*it].earliestFinish);
+		}
+		module.earliestFinish = module.earliestStart + module.duration;
+
+		criticalPath.totalDuration = std::max(criticalPath.totalDuration, module.earliestFinish);
+		criticalPath.sequentialDuration += module.duration;
+		criticalPath.modules.push_back(module);
+	}
+
+	//backward pass (latest start and finish, slack)
+	for (size_t index = startupOrder.size(); index-- > 0;)
+	{
+		MsvCriticalPathModule& module = criticalPath.modules[index];
+
+		module.latestFinish = criticalPath.totalDuration;
+		for (std::vector<size_t>::const_iterator it = moduleDependents[index].begin(); it != moduleDependents[index].end(); ++it)
+		{
+			module.latestFinish = std::min(module.latestFinish, criticalPath.modules[*it].latestStart);
+		}
+		module.latestStart = module.latestFinish - module.duration;
+		module.slack = module.latestStart - module.earliestStart;
+		module.critical = module.slack == std::chrono::nanoseconds::zero();
+	}
+
+	if (criticalPath.modules.empty())
+	{
+		return MSV_SUCCESS;
+	}
+
+	//walk critical path back from last module (in startup order) which finishes last
+	size_t current = criticalPath.modules.size() - 1;
+	while (criticalPath.modules[current].earliestFinish != criticalPath.totalDuration)
+	{
+		--current;
+	}
+
+	for (;;)
+	{
+		criticalPath.path.push_back(criticalPath.modules[current].moduleId);
+
+		//critical dependency ends exactly when current module begins
+		bool found = false;
+		for (std::vector<size_t>::const_iterator it = moduleDependencies[current].begin(); it != moduleDependencies[current].end(); ++it)
+		{
+			if (criticalPath.modules[*it].critical && criticalPath.modules[*it].earliestFinish == criticalPath.modules[current].earliestStart)
+			{
+				current = *it;
+				found = true;
+				break;
+			}
+		}
+
+		if (!found)
+		{
+			break;
+		}
+	}
+
+	std::reverse(criticalPath.path.begin(), criticalPath.path.end());
+
+	return MSV_SUCCESS;
+}
+
+std::string MsvCriticalPathAnalyzer::GetSummary(const MsvCriticalPath& criticalPath)
+{
+	std::unordered_map<int32_t, std::chrono::nanoseconds> durations;
+	for (std::vector<MsvCriticalPathModule>::const_iterator it = criticalPath.modules.begin(); it != criticalPath.modules.end(); ++it)
+	{
+		durations[it->moduleId] = it->duration;
+	}
+
+	std::string summary = "critical path " + std::to_string(std::chrono::duration_cast<std::chrono::microseconds>(criticalPath.totalDuration).count())
+		+ " us (sequential " + std::to_string(std::chrono::duration_cast<std::chrono::microseconds>(criticalPath.sequentialDuration).count()) + " us):";
+
+	for (std::vector<int32_t>::const_iterator it = criticalPath.path.begin(); it != criticalPath.path.end(); ++it)
+	{
+		if (it != criticalPath.path.begin())
+		{
+			summary += " ->";
+		}
+
+		summary += " " + std::to_string(*it) + " (" + std::to_string(std::chrono::duration_cast<std::chrono::microseconds>(durations[*it]).count()) + " us)";
+	}
+
+	return summary;
+}
+
+
+/** @} */	//End of group MMODULE.
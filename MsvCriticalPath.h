@@ -0,0 +1,116 @@
+/**************************************************************************************************//**
+* @addtogroup	MMODULE
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Critical Path
+* @details		Contains definition of @ref MsvCriticalPathAnalyzer (startup critical path of modules).
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Module Library.
+
+MarsTech Dependency Injection is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef MARSTECH_CRITICALPATH_H
+#define MARSTECH_CRITICALPATH_H
+
+
+#include "merror/MsvError.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+MSV_ENABLE_WARNINGS
+
+
+/**************************************************************************************************//**
+* @brief		Critical path module.
+* @details	Schedule of one module when every module starts as soon as all its dependencies are started.
+******************************************************************************************************/
+struct MsvCriticalPathModule
+{
+	int32_t moduleId;									///< Module ID.
+	std::chrono::nanoseconds duration;			///< Duration of module bring-up (initialize + start).
+	std::chrono::nanoseconds earliestStart;	///< Earliest time when module bring-up can begin.
+	std::chrono::nanoseconds earliestFinish;	///< Earliest time when module bring-up can end.
+	std::chrono::nanoseconds latestStart;		///< Latest time when module bring-up can begin without delaying total time.
+	std::chrono::nanoseconds latestFinish;		///< Latest time when module bring-up can end without delaying total time.
+	std::chrono::nanoseconds slack;				///< How much module can be delayed without delaying total time.
+	bool critical;										///< Flag if module is on critical path (true) or not (false).
+};
+
+
+/**************************************************************************************************//**
+* @brief		Critical path.
+* @details	Result of critical path analysis.
+******************************************************************************************************/
+struct MsvCriticalPath
+{
+	std::chrono::nanoseconds totalDuration;			///< Total bring-up time (length of critical path).
+	std::chrono::nanoseconds sequentialDuration;		///< Sum of durations of all modules (bring-up time of serial sweep).
+	std::vector<int32_t> path;								///< Module IDs on critical path in startup order.
+	std::vector<MsvCriticalPathModule> modules;		///< Schedule of all modules in startup order.
+};
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Critical Path Analyzer.
+* @details	Computes critical path of module bring-up (chain of modules whose latencies determine total
+*				bring-up time) and slack of each module from module durations and dependencies.
+******************************************************************************************************/
+class MsvCriticalPathAnalyzer
+{
+public:
+	/**************************************************************************************************//**
+	* @brief			Analyze critical path.
+	* @details		Computes critical path of modules.
+	* @param[in]	startupOrder						Module IDs in startup order (dependencies before dependents).
+	* @param[in]	dependencies						Dependencies of modules (module ID -> IDs of modules it depends on).
+	*														Dependencies on modules not in startup order are ignored.
+	* @param[in]	durations							Durations of modules (missing module = zero duration).
+	* @param[out]	criticalPath						Critical path.
+	* @retval		MSV_INVALID_DATA_ERROR			When startup order is not topological order of dependencies.
+	* @retval		MSV_SUCCESS							On success.
+	******************************************************************************************************/
+	static MsvErrorCode Analyze(const std::vector<int32_t>& startupOrder, const std::map<int32_t, std::vector<int32_t>>& dependencies,
+		const std::unordered_map<int32_t, std::chrono::nanoseconds>& durations, MsvCriticalPath& criticalPath);
+
+	/**************************************************************************************************//**
+	* @brief			Get summary.
+	* @details		Returns one line summary of critical path (for logging).
+	* @param[in]	criticalPath						Critical path.
+	* @returns		std::string
+	******************************************************************************************************/
+	static std::string GetSummary(const MsvCriticalPath& criticalPath);
+};
+
+
+#endif // !MARSTECH_CRITICALPATH_H
+
+/** @} */	//End of group MMODULE.
@@ -32,6 +32,7 @@ along with Foobar. If not, see <https://www.gnu.org/licenses/>.
 
 
 #include "MsvDllModuleAdapter.h"
+#include "MsvPosixDllFactory.h"
 
 
 /********************************************************************************************************************************
@@ -39,10 +40,12 @@ along with Foobar. If not, see <https://www.gnu.org/licenses/>.
 ********************************************************************************************************************************/
 
 
-MsvDllModuleAdapter::MsvDllModuleAdapter(const char* moduleId, std::shared_ptr<IMsvDllFactory> spDllFactory, std::shared_ptr<MsvLogger> spLogger):
+MsvDllModuleAdapter::MsvDllModuleAdapter(const char* moduleId, std::shared_ptr<IMsvDllFactory> spDllFactory, std::shared_ptr<MsvLogger> spLogger, std::shared_ptr<MsvDllObjectCache> spDllObjectCache):
 	m_moduleId(moduleId),
 	m_spDllFactory(spDllFactory),
-	m_spLogger(spLogger)
+	m_spDllObjectCache(spDllObjectCache),
+	m_spLogger(spLogger),
+	m_serviceProviderId(0)
 {
 
 }
@@ -52,6 +55,12 @@ MsvDllModuleAdapter::~MsvDllModuleAdapter()
 {
 	Stop();
 	Uninitialize();
+
+	if (m_spDllObjectCache)
+	{
+		//other adapter can get module with the same ID
+		m_spDllObjectCache->ReleaseDllObject(m_spDllFactory, m_moduleId.c_str(), this);
+	}
 }
 
 
@@ -62,7 +71,7 @@ MsvDllModuleAdapter::~MsvDllModuleAdapter()
 
 MsvErrorCode MsvDllModuleAdapter::Initialize()
 {
-	std::lock_guard<std::recursive_mutex> lock(m_lock);
+	MsvLockGuard lock(m_lock, MSV_LOCK_CALL_SITE);
 
 	MSV_LOG_INFO(m_spLogger, "Initializing DLL module {}.", m_moduleId);
 
@@ -72,7 +81,21 @@ MsvErrorCode MsvDllModuleAdapter::Initialize()
 		return MSV_ALREADY_INITIALIZED_INFO;
 	}
 
-	MsvErrorCode errorCode = m_spDllFactory->GetDllObject<IMsvDllModule>(m_moduleId.c_str(), m_spModule);
+	MsvErrorCode errorCode = MSV_SUCCESS;
+	{
+		MsvTraceScope loadTraceScope(m_spTraceRecorder, "Load DLL module ", m_moduleId, "dll");
+		if (m_spDllObjectCache)
+		{
+			//shared cache -> DLL is loaded only once (module is owned by this adapter)
+			errorCode = m_spDllObjectCache->GetDllObject<IMsvDllModule>(m_spDllFactory, m_moduleId.c_str(), this, m_spModule);
+		}
+		else
+		{
+			errorCode = m_spDllFactory->GetDllObject<IMsvDllModule>(m_moduleId.c_str(), m_spModule);
+		}
+		loadTraceScope.SetErrorCode(errorCode);
+	}
+
 	if (MSV_FAILED(errorCode))
 	{
 		MSV_LOG_ERROR(m_spLogger, "Get DLL module {} failed with error: {0:x}", m_moduleId, errorCode);
@@ -86,11 +109,53 @@ MsvErrorCode MsvDllModuleAdapter::Initialize()
 	}
 
 	m_spModule->SetDllFactory(m_spDllFactory);
+
+	std::shared_ptr<IMsvThreadPoolConsumer> spThreadPoolConsumer = std::dynamic_pointer_cast<IMsvThreadPoolConsumer>(m_spModule);
+	if (spThreadPoolConsumer)
+	{
+		spThreadPoolConsumer->SetThreadPool(m_spThreadPool);
+	}
+
+	std::shared_ptr<IMsvThreadFactoryConsumer> spThreadFactoryConsumer = std::dynamic_pointer_cast<IMsvThreadFactoryConsumer>(m_spModule);
+	if (spThreadFactoryConsumer)
+	{
+		spThreadFactoryConsumer->SetThreadFactory(m_spThreadFactory);
+	}
+
+	std::shared_ptr<IMsvArenaConsumer> spArenaConsumer = std::dynamic_pointer_cast<IMsvArenaConsumer>(m_spModule);
+	if (spArenaConsumer)
+	{
+		spArenaConsumer->SetArena(m_spArena);
+	}
+
+	std::shared_ptr<IMsvMessageBusConsumer> spMessageBusConsumer = std::dynamic_pointer_cast<IMsvMessageBusConsumer>(m_spModule);
+	if (spMessageBusConsumer)
+	{
+		spMessageBusConsumer->SetMessageBus(m_spMessageBus);
+	}
+
+	std::shared_ptr<IMsvServiceRegistryConsumer> spServiceRegistryConsumer = std::dynamic_pointer_cast<IMsvServiceRegistryConsumer>(m_spModule);
+	if (spServiceRegistryConsumer)
+	{
+		spServiceRegistryConsumer->SetServiceRegistry(m_spServiceRegistry, m_serviceProviderId);
+	}
 	
-	if (MSV_FAILED(errorCode = m_spModule->Initialize()))
+	{
+		MsvTraceScope initializeTraceScope(m_spTraceRecorder, "Initialize DLL module ", m_moduleId, "dll");
+		errorCode = m_spModule->Initialize();
+		initializeTraceScope.SetErrorCode(errorCode);
+	}
+
+	if (MSV_FAILED(errorCode))
 	{
 		MSV_LOG_ERROR(m_spLogger, "Initialize DLL module {} failed with error: {0:x}", m_moduleId, errorCode);
 		m_spModule.reset();
+
+		if (m_spDllObjectCache)
+		{
+			//state of failed module is unknown -> next initialize gets new module from DLL factory
+			m_spDllObjectCache->ReleaseDllObject(m_spDllFactory, m_moduleId.c_str(), this);
+		}
 	}
 
 	return errorCode;
@@ -98,7 +163,7 @@ MsvErrorCode MsvDllModuleAdapter::Initialize()
 
 MsvErrorCode MsvDllModuleAdapter::Uninitialize()
 {
-	std::lock_guard<std::recursive_mutex> lock(m_lock);
+	MsvLockGuard lock(m_lock, MSV_LOCK_CALL_SITE);
 
 	MSV_LOG_INFO(m_spLogger, "Uninitializing DLL module {}.", m_moduleId);
 
@@ -122,14 +187,14 @@ MsvErrorCode MsvDllModuleAdapter::Uninitialize()
 
 bool MsvDllModuleAdapter::Initialized() const
 {
-	std::lock_guard<std::recursive_mutex> lock(m_lock);
+	MsvLockGuard lock(m_lock, MSV_LOCK_CALL_SITE);
 
 	return m_spModule && m_spModule->Initialized();
 }
 
 MsvErrorCode MsvDllModuleAdapter::Start()
 {
-	std::lock_guard<std::recursive_mutex> lock(m_lock);
+	MsvLockGuard lock(m_lock, MSV_LOCK_CALL_SITE);
 
 	MSV_LOG_INFO(m_spLogger, "Starting DLL module {}.", m_moduleId);
 
@@ -151,7 +216,7 @@ MsvErrorCode MsvDllModuleAdapter::Start()
 
 MsvErrorCode MsvDllModuleAdapter::Stop()
 {
-	std::lock_guard<std::recursive_mutex> lock(m_lock);
+	MsvLockGuard lock(m_lock, MSV_LOCK_CALL_SITE);
 
 	MSV_LOG_INFO(m_spLogger, "Stopping DLL module {}.", m_moduleId);
 
@@ -173,10 +238,166 @@ MsvErrorCode MsvDllModuleAdapter::Stop()
 
 bool MsvDllModuleAdapter::Running() const
 {
-	std::lock_guard<std::recursive_mutex> lock(m_lock);
+	MsvLockGuard lock(m_lock, MSV_LOCK_CALL_SITE);
 
 	return m_spModule && m_spModule->Running();
 }
 
 
+/********************************************************************************************************************************
+*															IMsvThreadPoolConsumer public methods
+********************************************************************************************************************************/
+
+
+void MsvDllModuleAdapter::SetThreadPool(std::shared_ptr<IMsvThreadPool> spThreadPool)
+{
+	MsvLockGuard lock(m_lock, MSV_LOCK_CALL_SITE);
+
+	m_spThreadPool = spThreadPool;
+}
+
+
+/********************************************************************************************************************************
+*															IMsvThreadFactoryConsumer public methods
+********************************************************************************************************************************/
+
+
+void MsvDllModuleAdapter::SetThreadFactory(std::shared_ptr<IMsvThreadFactory> spThreadFactory)
+{
+	MsvLockGuard lock(m_lock, MSV_LOCK_CALL_SITE);
+
+	m_spThreadFactory = spThreadFactory;
+}
+
+
+/********************************************************************************************************************************
+*															IMsvArenaConsumer public methods
+********************************************************************************************************************************/
+
+
+void MsvDllModuleAdapter::SetArena(std::shared_ptr<MsvArena> spArena)
+{
+	MsvLockGuard lock(m_lock, MSV_LOCK_CALL_SITE);
+
+	m_spArena = spArena;
+}
+
+
+/********************************************************************************************************************************
+*															IMsvMessageBusConsumer public methods
+********************************************************************************************************************************/
+
+
+void MsvDllModuleAdapter::SetMessageBus(std::shared_ptr<MsvMessageBus> spMessageBus)
+{
+	MsvLockGuard lock(m_lock, MSV_LOCK_CALL_SITE);
+
+	m_spMessageBus = spMessageBus;
+}
+
+
+/********************************************************************************************************************************
+*															IMsvServiceRegistryConsumer public methods
+********************************************************************************************************************************/
+
+
+void MsvDllModuleAdapter::SetServiceRegistry(std::shared_ptr<MsvServiceRegistry> spServiceRegistry, int32_t moduleId)
+{
+	MsvLockGuard lock(m_lock, MSV_LOCK_CALL_SITE);
+
+	m_spServiceRegistry = spServiceRegistry;
+	m_serviceProviderId = moduleId;
+}
+
+
+/********************************************************************************************************************************
+*															IMsvModuleReadiness public methods
+********************************************************************************************************************************/
+
+
+bool MsvDllModuleAdapter::Ready() const
+{
+	MsvLockGuard lock(m_lock, MSV_LOCK_CALL_SITE);
+
+	if (!m_spModule || !m_spModule->Running())
+	{
+		return false;
+	}
+
+	std::shared_ptr<IMsvModuleReadiness> spReadiness = std::dynamic_pointer_cast<IMsvModuleReadiness>(m_spModule);
+	return !spReadiness || spReadiness->Ready();
+}
+
+bool MsvDllModuleAdapter::WaitForReady(std::chrono::milliseconds timeout) const
+{
+	std::shared_ptr<IMsvModuleReadiness> spReadiness;
+
+	{
+		MsvLockGuard lock(m_lock, MSV_LOCK_CALL_SITE);
+
+		if (!m_spModule)
+		{
+			return false;
+		}
+
+		spReadiness = std::dynamic_pointer_cast<IMsvModuleReadiness>(m_spModule);
+		if (!spReadiness)
+		{
+			return m_spModule->Running();
+		}
+	}
+
+	//wait without lock - module can be stopped meanwhile
+	return spReadiness->WaitForReady(timeout);
+}
+
+
+/********************************************************************************************************************************
+*															MsvDllModuleAdapter public methods
+********************************************************************************************************************************/
+
+
+void MsvDllModuleAdapter::SetDllPath(const char* dllPath)
+{
+	MsvLockGuard lock(m_lock, MSV_LOCK_CALL_SITE);
+
+	m_dllPath = dllPath ? dllPath : "";
+}
+
+MsvErrorCode MsvDllModuleAdapter::GetDllPath(std::string& dllPath) const
+{
+	MsvLockGuard lock(m_lock, MSV_LOCK_CALL_SITE);
+
+	if (!m_dllPath.empty())
+	{
+		dllPath = m_dllPath;
+		return MSV_SUCCESS;
+	}
+
+#if !defined(_WIN32)
+	std::shared_ptr<MsvPosixDllFactory> spPosixDllFactory = std::dynamic_pointer_cast<MsvPosixDllFactory>(m_spDllFactory);
+	if (spPosixDllFactory)
+	{
+		return spPosixDllFactory->GetDllPath(m_moduleId.c_str(), dllPath);
+	}
+#endif
+
+	return MSV_NOT_FOUND_ERROR;
+}
+
+void MsvDllModuleAdapter::SetTraceRecorder(std::shared_ptr<MsvTraceRecorder> spTraceRecorder)
+{
+	MsvLockGuard lock(m_lock, MSV_LOCK_CALL_SITE);
+
+	m_spTraceRecorder = spTraceRecorder;
+}
+
+std::shared_ptr<IMsvModuleHeartbeat> MsvDllModuleAdapter::GetModuleHeartbeat() const
+{
+	MsvLockGuard lock(m_lock, MSV_LOCK_CALL_SITE);
+
+	return std::dynamic_pointer_cast<IMsvModuleHeartbeat>(m_spModule);
+}
+
+
 /** @} */	//End of group MMODULE.
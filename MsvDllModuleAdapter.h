@@ -35,7 +35,17 @@ along with Foobar. If not, see <https://www.gnu.org/licenses/>.
 #define MARSTECH_DLLMODULEADAPTER_H
 
 
+#include "IMsvArenaConsumer.h"
 #include "IMsvDllModule.h"
+#include "IMsvMessageBusConsumer.h"
+#include "IMsvModuleHeartbeat.h"
+#include "IMsvModuleReadiness.h"
+#include "IMsvServiceRegistryConsumer.h"
+#include "IMsvThreadFactory.h"
+#include "IMsvThreadPool.h"
+#include "MsvDllObjectCache.h"
+#include "MsvLock.h"
+#include "MsvTraceRecorder.h"
 
 #include "mlogging/mlogging.h"
 
@@ -47,7 +57,13 @@ along with Foobar. If not, see <https://www.gnu.org/licenses/>.
 * @note		This class is usefull for modules stored in dynamic/shared libraries.
 ******************************************************************************************************/
 class MsvDllModuleAdapter:
-	public IMsvModule
+	public IMsvModule,
+	public IMsvThreadPoolConsumer,
+	public IMsvThreadFactoryConsumer,
+	public IMsvArenaConsumer,
+	public IMsvMessageBusConsumer,
+	public IMsvServiceRegistryConsumer,
+	public IMsvModuleReadiness
 {
 public:
 	/**************************************************************************************************//**
@@ -55,8 +71,9 @@ public:
 	* @param[in]	moduleId				DLL module ID (ID to get module from DLL factory).
 	* @param[in]	spDllFactory		Shared pointer to DLL factory.
 	* @param[in]	spLogger				Shared pointer to logger for logging.
+	* @param[in]	spDllObjectCache	Shared pointer to DLL object cache shared by adapters (DLL factory is used directly when empty).
 	******************************************************************************************************/
-	MsvDllModuleAdapter(const char* moduleId, std::shared_ptr<IMsvDllFactory> spDllFactory, std::shared_ptr<MsvLogger> spLogger = nullptr);
+	MsvDllModuleAdapter(const char* moduleId, std::shared_ptr<IMsvDllFactory> spDllFactory, std::shared_ptr<MsvLogger> spLogger = nullptr, std::shared_ptr<MsvDllObjectCache> spDllObjectCache = nullptr);
 
 	/**************************************************************************************************//**
 	* @brief		Virtual destructor.
@@ -97,12 +114,120 @@ public:
 	******************************************************************************************************/
 	virtual bool Running() const override;
 
+	/*-----------------------------------------------------------------------------------------------------
+	**											IMsvThreadPoolConsumer public methods
+	**---------------------------------------------------------------------------------------------------*/
+public:
+	/**************************************************************************************************//**
+	* @copydoc IMsvThreadPoolConsumer::SetThreadPool(std::shared_ptr<IMsvThreadPool> spThreadPool)
+	* @note		Thread pool is set to DLL module when it implements @ref IMsvThreadPoolConsumer (before it is initialized).
+	******************************************************************************************************/
+	virtual void SetThreadPool(std::shared_ptr<IMsvThreadPool> spThreadPool) override;
+
+	/*-----------------------------------------------------------------------------------------------------
+	**											IMsvThreadFactoryConsumer public methods
+	**---------------------------------------------------------------------------------------------------*/
+public:
+	/**************************************************************************************************//**
+	* @copydoc IMsvThreadFactoryConsumer::SetThreadFactory(std::shared_ptr<IMsvThreadFactory> spThreadFactory)
+	* @note		Thread factory is set to DLL module when it implements @ref IMsvThreadFactoryConsumer (before it is
+	*				initialized).
+	******************************************************************************************************/
+	virtual void SetThreadFactory(std::shared_ptr<IMsvThreadFactory> spThreadFactory) override;
+
+	/*-----------------------------------------------------------------------------------------------------
+	**											IMsvArenaConsumer public methods
+	**---------------------------------------------------------------------------------------------------*/
+public:
+	/**************************************************************************************************//**
+	* @copydoc IMsvArenaConsumer::SetArena(std::shared_ptr<MsvArena> spArena)
+	* @note		Arena is set to DLL module when it implements @ref IMsvArenaConsumer (before it is initialized).
+	******************************************************************************************************/
+	virtual void SetArena(std::shared_ptr<MsvArena> spArena) override;
+
+	/*-----------------------------------------------------------------------------------------------------
+	**											IMsvMessageBusConsumer public methods
+	**---------------------------------------------------------------------------------------------------*/
+public:
+	/**************************************************************************************************//**
+	* @copydoc IMsvMessageBusConsumer::SetMessageBus(std::shared_ptr<MsvMessageBus> spMessageBus)
+	* @note		Message bus is set to DLL module when it implements @ref IMsvMessageBusConsumer (before it is
+	*				initialized).
+	******************************************************************************************************/
+	virtual void SetMessageBus(std::shared_ptr<MsvMessageBus> spMessageBus) override;
+
+	/*-----------------------------------------------------------------------------------------------------
+	**											IMsvServiceRegistryConsumer public methods
+	**---------------------------------------------------------------------------------------------------*/
+public:
+	/**************************************************************************************************//**
+	* @copydoc IMsvServiceRegistryConsumer::SetServiceRegistry(std::shared_ptr<MsvServiceRegistry> spServiceRegistry, int32_t moduleId)
+	* @note		Service registry is set to DLL module when it implements @ref IMsvServiceRegistryConsumer (before it is
+	*				initialized).
+	******************************************************************************************************/
+	virtual void SetServiceRegistry(std::shared_ptr<MsvServiceRegistry> spServiceRegistry, int32_t moduleId) override;
+
+	/*-----------------------------------------------------------------------------------------------------
+	**											IMsvModuleReadiness public methods
+	**---------------------------------------------------------------------------------------------------*/
+public:
+	/**************************************************************************************************//**
+	* @copydoc IMsvModuleReadiness::Ready() const
+	* @note		Readiness is forwarded to DLL module when it implements @ref IMsvModuleReadiness (otherwise running DLL
+	*				module is ready).
+	******************************************************************************************************/
+	virtual bool Ready() const override;
+
+	/**************************************************************************************************//**
+	* @copydoc IMsvModuleReadiness::WaitForReady(std::chrono::milliseconds timeout) const
+	* @note		Adapter is not locked while it waits for DLL module.
+	******************************************************************************************************/
+	virtual bool WaitForReady(std::chrono::milliseconds timeout) const override;
+
+	/*-----------------------------------------------------------------------------------------------------
+	**											MsvDllModuleAdapter public methods
+	**---------------------------------------------------------------------------------------------------*/
+public:
+	/**************************************************************************************************//**
+	* @brief			Set DLL path.
+	* @details		Sets path of DLL file which contains DLL module (used to prefetch DLL before it is loaded).
+	* @param[in]	dllPath				Path of DLL file.
+	******************************************************************************************************/
+	virtual void SetDllPath(const char* dllPath);
+
+	/**************************************************************************************************//**
+	* @brief			Get DLL path.
+	* @details		Returns path of DLL file which contains DLL module. It is path set by @ref SetDllPath or
+	*					path registered in DLL factory (when it is @ref MsvPosixDllFactory).
+	* @param[out]	dllPath						Path of DLL file.
+	* @retval		MSV_NOT_FOUND_ERROR		When DLL path is not known.
+	* @retval		MSV_SUCCESS					On success.
+	******************************************************************************************************/
+	virtual MsvErrorCode GetDllPath(std::string& dllPath) const;
+
+	/**************************************************************************************************//**
+	* @brief			Set trace recorder.
+	* @details		Sets trace recorder which records load of DLL module and its initialize (nested in module
+	*					transition events of module manager). It is set by module manager (@ref MsvModuleManager::SetTraceRecorder).
+	* @param[in]	spTraceRecorder	Shared pointer to trace recorder (empty = no tracing).
+	******************************************************************************************************/
+	virtual void SetTraceRecorder(std::shared_ptr<MsvTraceRecorder> spTraceRecorder);
+
+	/**************************************************************************************************//**
+	* @brief		Get module heartbeat.
+	* @details	Returns heartbeat of loaded DLL module (it is watched by watchdog of module manager directly - adapter is
+	*				not locked when heartbeat is read). It must be released before DLL module is uninitialized.
+	* @returns	std::shared_ptr<IMsvModuleHeartbeat> (empty when DLL module is not loaded or it does not implement
+	*				@ref IMsvModuleHeartbeat)
+	******************************************************************************************************/
+	virtual std::shared_ptr<IMsvModuleHeartbeat> GetModuleHeartbeat() const;
+
 protected:
 	/**************************************************************************************************//**
 	* @brief		Module manager mutex.
-	* @details	Locks this object for thread safety access.
+	* @details	Locks this object for thread safety access (instrumented when MSV_LOCK_INSTRUMENTATION is enabled).
 	******************************************************************************************************/
-	mutable std::recursive_mutex m_lock;
+	mutable MsvRecursiveMutex m_lock;
 
 	/**************************************************************************************************//**
 	* @brief			Module ID.
@@ -110,12 +235,24 @@ protected:
 	******************************************************************************************************/
 	std::string m_moduleId;
 
+	/**************************************************************************************************//**
+	* @brief			DLL path.
+	* @details		Path of DLL file which contains DLL module (empty when not set).
+	******************************************************************************************************/
+	std::string m_dllPath;
+
 	/**************************************************************************************************//**
 	* @brief			DLL factory.
 	* @details		DLL factory used for loading DLLs and theirs objects. Used to get DLL module.
 	******************************************************************************************************/
 	std::shared_ptr<IMsvDllFactory> m_spDllFactory;
 
+	/**************************************************************************************************//**
+	* @brief			DLL object cache.
+	* @details		DLL object cache shared by adapters. Used to get DLL module when it is set.
+	******************************************************************************************************/
+	std::shared_ptr<MsvDllObjectCache> m_spDllObjectCache;
+
 	/**************************************************************************************************//**
 	* @brief			DLL module.
 	* @details		Real DLL module loaded from DLL.
@@ -127,6 +264,48 @@ protected:
 	* @details	Shared pointer to logger for logging.
 	******************************************************************************************************/
 	std::shared_ptr<MsvLogger> m_spLogger;
+
+	/**************************************************************************************************//**
+	* @brief			Trace recorder.
+	* @details		Records DLL load events (empty = no tracing).
+	******************************************************************************************************/
+	std::shared_ptr<MsvTraceRecorder> m_spTraceRecorder;
+
+	/**************************************************************************************************//**
+	* @brief			Thread pool.
+	* @details		Thread pool of module manager (set to DLL module before it is initialized).
+	******************************************************************************************************/
+	std::shared_ptr<IMsvThreadPool> m_spThreadPool;
+
+	/**************************************************************************************************//**
+	* @brief			Thread factory.
+	* @details		Thread factory with module placement (set to DLL module before it is initialized).
+	******************************************************************************************************/
+	std::shared_ptr<IMsvThreadFactory> m_spThreadFactory;
+
+	/**************************************************************************************************//**
+	* @brief			Arena.
+	* @details		Memory arena of module (set to DLL module before it is initialized).
+	******************************************************************************************************/
+	std::shared_ptr<MsvArena> m_spArena;
+
+	/**************************************************************************************************//**
+	* @brief			Message bus.
+	* @details		Message bus of module manager (set to DLL module before it is initialized).
+	******************************************************************************************************/
+	std::shared_ptr<MsvMessageBus> m_spMessageBus;
+
+	/**************************************************************************************************//**
+	* @brief			Service registry.
+	* @details		Service registry of module manager (set to DLL module before it is initialized).
+	******************************************************************************************************/
+	std::shared_ptr<MsvServiceRegistry> m_spServiceRegistry;
+
+	/**************************************************************************************************//**
+	* @brief			Service provider ID.
+	* @details		ID of module in module manager (set to DLL module with service registry).
+	******************************************************************************************************/
+	int32_t m_serviceProviderId;
 };
 
 
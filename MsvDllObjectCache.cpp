@@ -0,0 +1,147 @@
+/**************************************************************************************************//**
+* @addtogroup	MMODULE
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech DLL Object Cache
+* @details		Contains implementation of @ref MsvDllObjectCache.
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Module Library.
+
+MarsTech Dependency Injection is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "MsvDllObjectCache.h"
+
+
+/********************************************************************************************************************************
+*															Constructors and destructors
+********************************************************************************************************************************/
+
+
+MsvDllObjectCache::MsvDllObjectCache()
+{
+
+}
+
+
+MsvDllObjectCache::~MsvDllObjectCache()
+{
+
+}
+
+
+/********************************************************************************************************************************
+*															Public methods
+********************************************************************************************************************************/
+
+
+MsvErrorCode MsvDllObjectCache::GetDllObject(std::shared_ptr<IMsvDllFactory> spDllFactory, const char* dllObjectId, const void* pOwner, std::shared_ptr<IMsvDllObject>& spDllObject)
+{
+	if (!spDllFactory || !dllObjectId || !pOwner)
+	{
+		return MSV_INVALID_DATA_ERROR;
+	}
+
+	std::lock_guard<std::recursive_mutex> lock(m_lock);
+
+	MsvFactoryObjects& factoryObjects = m_cache[spDllFactory.get()];
+	if (!factoryObjects.spDllFactory)
+	{
+		//first lookup of this factory -> hold it alive (its address is used as key)
+		factoryObjects.spDllFactory = spDllFactory;
+	}
+
+	std::unordered_map<std::string, MsvCachedObject>::iterator it = factoryObjects.objects.find(dllObjectId);
+	if (it != factoryObjects.objects.end())
+	{
+		if (it->second.pOwner != pOwner)
+		{
+			//duplicate DLL object ID -> object would be shared (its initialize and uninitialize would affect both owners)
+			return MSV_ALREADY_EXISTS_ERROR;
+		}
+
+		//cache hit -> DLL is already loaded and initialized
+		spDllObject = it->second.spDllObject;
+		return MSV_SUCCESS;
+	}
+
+	//cache miss -> get object from DLL factory (full load path)
+	std::shared_ptr<IMsvDllObject> spObject;
+	MsvErrorCode errorCode = spDllFactory->GetDllObject(dllObjectId, spObject);
+	if (MSV_FAILED(errorCode))
+	{
+		return errorCode;
+	}
+
+	if (spObject)
+	{
+		//do not cache empty objects (caller will handle them)
+		MsvCachedObject& cachedObject = factoryObjects.objects[dllObjectId];
+		cachedObject.spDllObject = spObject;
+		cachedObject.pOwner = pOwner;
+	}
+
+	spDllObject = spObject;
+	return errorCode;
+}
+
+void MsvDllObjectCache::ReleaseDllObject(std::shared_ptr<IMsvDllFactory> spDllFactory, const char* dllObjectId, const void* pOwner)
+{
+	if (!spDllFactory || !dllObjectId || !pOwner)
+	{
+		return;
+	}
+
+	std::lock_guard<std::recursive_mutex> lock(m_lock);
+
+	std::unordered_map<const IMsvDllFactory*, MsvFactoryObjects>::iterator it = m_cache.find(spDllFactory.get());
+	if (it == m_cache.end())
+	{
+		return;
+	}
+
+	std::unordered_map<std::string, MsvCachedObject>::iterator objectIt = it->second.objects.find(dllObjectId);
+	if (objectIt == it->second.objects.end() || objectIt->second.pOwner != pOwner)
+	{
+		//DLL object is not cached or it is owned by other owner
+		return;
+	}
+
+	it->second.objects.erase(objectIt);
+	if (it->second.objects.empty())
+	{
+		//no more objects of this factory -> release factory too
+		m_cache.erase(it);
+	}
+}
+
+void MsvDllObjectCache::Clear()
+{
+	std::lock_guard<std::recursive_mutex> lock(m_lock);
+
+	m_cache.clear();
+}
+
+
+/** @} */	//End of group MMODULE.
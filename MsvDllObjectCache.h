@@ -0,0 +1,165 @@
+/**************************************************************************************************//**
+* @addtogroup	MMODULE
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech DLL Object Cache
+* @details		Contains definition of @ref MsvDllObjectCache.
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Module Library.
+
+MarsTech Dependency Injection is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef MARSTECH_DLLOBJECTCACHE_H
+#define MARSTECH_DLLOBJECTCACHE_H
+
+
+#include "mdllfactory/IMsvDllFactory.h"
+#include "merror/MsvErrorCodes.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+MSV_ENABLE_WARNINGS
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech DLL Object Cache.
+* @details	Cache of DLL objects shared by all DLL module adapters (create one instance and pass it to
+*				all adapters). Objects are cached by DLL factory and DLL object ID. The first lookup goes
+*				through DLL factory (DLL is loaded and initialized), all next lookups are just hash probes.
+*				Cached objects keep theirs DLLs loaded until they are released from the cache.
+* @note		DLL object IDs must be unique per DLL factory. Cached object is owned by the first owner
+*				(adapter) which gets it - other owners are rejected until it is released, so two adapters never
+*				share one module. Cached object is reused when adapter is initialized again after uninitialize
+*				(DLL modules must support initialize after uninitialize). Adapter releases object from the
+*				cache when its initialize fails and when it is destroyed.
+******************************************************************************************************/
+class MsvDllObjectCache
+{
+public:
+	/**************************************************************************************************//**
+	* @brief		Constructor.
+	******************************************************************************************************/
+	MsvDllObjectCache();
+
+	/**************************************************************************************************//**
+	* @brief		Virtual destructor.
+	******************************************************************************************************/
+	virtual ~MsvDllObjectCache();
+
+	/**************************************************************************************************//**
+	* @brief			Get DLL object.
+	* @details		Returns cached DLL object or gets it from DLL factory and caches it for its owner.
+	* @param[in]	spDllFactory				DLL factory used for loading DLLs and theirs objects.
+	* @param[in]	dllObjectId					DLL object ID.
+	* @param[in]	pOwner						Owner of DLL object (e.g. adapter).
+	* @param[out]	spDllObject					Shared pointer to DLL object.
+	* @retval		MSV_INVALID_DATA_ERROR	When DLL factory, DLL object ID or owner is empty.
+	* @retval		MSV_ALREADY_EXISTS_ERROR	When DLL object is cached for other owner (duplicate DLL object ID).
+	* @retval		other_error_code			When failed (error code of DLL factory).
+	* @retval		MSV_SUCCESS					On success.
+	******************************************************************************************************/
+	virtual MsvErrorCode GetDllObject(std::shared_ptr<IMsvDllFactory> spDllFactory, const char* dllObjectId, const void* pOwner, std::shared_ptr<IMsvDllObject>& spDllObject);
+
+	/**************************************************************************************************//**
+	* @brief			Get DLL object.
+	* @details		Returns cached DLL object (or gets it from DLL factory and caches it for its owner) and casts it to
+	*					requested type.
+	* @param[in]	spDllFactory				DLL factory used for loading DLLs and theirs objects.
+	* @param[in]	dllObjectId					DLL object ID.
+	* @param[in]	pOwner						Owner of DLL object (e.g. adapter).
+	* @param[out]	spDllObject					Shared pointer to DLL object (empty when it is not requested type).
+	* @retval		MSV_INVALID_DATA_ERROR	When DLL factory, DLL object ID or owner is empty.
+	* @retval		MSV_ALREADY_EXISTS_ERROR	When DLL object is cached for other owner (duplicate DLL object ID).
+	* @retval		other_error_code			When failed (error code of DLL factory).
+	* @retval		MSV_SUCCESS					On success.
+	******************************************************************************************************/
+	template<class T>
+	MsvErrorCode GetDllObject(std::shared_ptr<IMsvDllFactory> spDllFactory, const char* dllObjectId, const void* pOwner, std::shared_ptr<T>& spDllObject)
+	{
+		std::shared_ptr<IMsvDllObject> spObject;
+		MSV_RETURN_FAILED(GetDllObject(spDllFactory, dllObjectId, pOwner, spObject));
+
+		spDllObject = std::dynamic_pointer_cast<T>(spObject);
+		return MSV_SUCCESS;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Release DLL object.
+	* @details		Removes DLL object of owner from cache (DLL object of other owner is kept). It's DLL can be unloaded
+	*					when it is not used anymore.
+	* @param[in]	spDllFactory				DLL factory used for loading DLLs and theirs objects.
+	* @param[in]	dllObjectId					DLL object ID.
+	* @param[in]	pOwner						Owner of DLL object (e.g. adapter).
+	******************************************************************************************************/
+	virtual void ReleaseDllObject(std::shared_ptr<IMsvDllFactory> spDllFactory, const char* dllObjectId, const void* pOwner);
+
+	/**************************************************************************************************//**
+	* @brief			Clear cache.
+	* @details		Removes all DLL objects from cache.
+	******************************************************************************************************/
+	virtual void Clear();
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Cached DLL object.
+	* @details	DLL object and its owner (only owner gets and releases it).
+	******************************************************************************************************/
+	struct MsvCachedObject
+	{
+		std::shared_ptr<IMsvDllObject> spDllObject;
+		const void* pOwner;
+	};
+
+	/**************************************************************************************************//**
+	* @brief		Cached DLL objects of one DLL factory.
+	* @details	DLL factory (holds it alive - its address is used as key) and its DLL objects by DLL object ID.
+	******************************************************************************************************/
+	struct MsvFactoryObjects
+	{
+		std::shared_ptr<IMsvDllFactory> spDllFactory;
+		std::unordered_map<std::string, MsvCachedObject> objects;
+	};
+
+	/**************************************************************************************************//**
+	* @brief		DLL object cache mutex.
+	* @details	Locks this object for thread safety access.
+	******************************************************************************************************/
+	mutable std::recursive_mutex m_lock;
+
+	/**************************************************************************************************//**
+	* @brief		Cached DLL objects.
+	* @details	Cached DLL objects by DLL factory.
+	******************************************************************************************************/
+	std::unordered_map<const IMsvDllFactory*, MsvFactoryObjects> m_cache;
+};
+
+
+#endif // !MARSTECH_DLLOBJECTCACHE_H
+
+/** @} */	//End of group MMODULE.
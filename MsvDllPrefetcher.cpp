@@ -0,0 +1,270 @@
+/**************************************************************************************************//**
+* @addtogroup	MMODULE
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech DLL Prefetcher
+* @details		Contains implementation of @ref MsvDllPrefetcher.
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Module Library.
+
+MarsTech Dependency Injection is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "MsvDllPrefetcher.h"
+
+#include "merror/MsvErrorCodes.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <algorithm>
+#include <atomic>
+#include <system_error>
+#include <thread>
+
+#if defined(_WIN32)
+#include <fstream>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MSV_ENABLE_WARNINGS
+
+
+/********************************************************************************************************************************
+*															Constructors and destructors
+********************************************************************************************************************************/
+
+
+MsvDllPrefetcher::MsvDllPrefetcher(MsvDllPrefetchMode mode, uint32_t maxThreads, std::shared_ptr<MsvLogger> spLogger):
+	m_mode(mode),
+	m_maxThreads(maxThreads),
+	m_spLogger(spLogger)
+{
+
+}
+
+
+MsvDllPrefetcher::~MsvDllPrefetcher()
+{
+	Unlock();
+}
+
+
+/********************************************************************************************************************************
+*															Public methods
+********************************************************************************************************************************/
+
+
+MsvErrorCode MsvDllPrefetcher::Prefetch(const std::vector<std::string>& dllPaths)
+{
+	if (dllPaths.empty())
+	{
+		return MSV_SUCCESS;
+	}
+
+	uint32_t threadCount = m_maxThreads ? m_maxThreads : std::max(std::thread::hardware_concurrency(), 1u);
+	threadCount = std::min(threadCount, static_cast<uint32_t>(dllPaths.size()));
+
+	std::atomic<size_t> nextPath(0);
+	std::atomic<MsvErrorCode> lastErrorCode(MSV_SUCCESS);
+
+	auto prefetchWorker = [&]()
+	{
+		for (size_t index = nextPath++; index < dllPaths.size(); index = nextPath++)
+		{
+			MsvErrorCode errorCode = PrefetchFile(dllPaths[index]);
+			if (MSV_FAILED(errorCode))
+			{
+				lastErrorCode = errorCode;
+			}
+		}
+	};
+
+	//prefetch in this thread too (one thread less to create)
+	std::vector<std::thread> threads;
+	try
+	{
+		for (uint32_t i = 1; i < threadCount; ++i)
+		{
+			threads.emplace_back(prefetchWorker);
+		}
+	}
+	catch (const std::system_error&)
+	{
+		//stop already started workers (they do not take next paths)
+		nextPath = dllPaths.size();
+		for (std::vector<std::thread>::iterator it = threads.begin(); it != threads.end(); ++it)
+		{
+			it->join();
+		}
+
+		MSV_LOG_ERROR(m_spLogger, "Create prefetch thread failed with error: {0:x}", MSV_ALLOCATION_ERROR);
+		return MSV_ALLOCATION_ERROR;
+	}
+
+	prefetchWorker();
+
+	for (std::thread& thread : threads)
+	{
+		thread.join();
+	}
+
+	return lastErrorCode;
+}
+
+void MsvDllPrefetcher::Unlock()
+{
+	std::lock_guard<std::recursive_mutex> lock(m_lock);
+
+#if !defined(_WIN32)
+	for (const MsvLockedFile& lockedFile : m_lockedFiles)
+	{
+		munlock(lockedFile.address, lockedFile.size);
+		munmap(lockedFile.address, lockedFile.size);
+	}
+#endif
+
+	m_lockedFiles.clear();
+}
+
+
+/********************************************************************************************************************************
+*															Protected methods
+********************************************************************************************************************************/
+
+
+#if defined(_WIN32)
+
+MsvErrorCode MsvDllPrefetcher::PrefetchFile(const std::string& dllPath)
+{
+	//there is no readahead -> read whole file sequentially to page cache
+	std::ifstream file(dllPath, std::ios::in | std::ios::binary);
+	if (!file)
+	{
+		MSV_LOG_ERROR(m_spLogger, "Open DLL {} to prefetch failed with error: {0:x}", dllPath, MSV_NOT_FOUND_ERROR);
+		return MSV_NOT_FOUND_ERROR;
+	}
+
+	std::vector<char> buffer(1024 * 1024);
+	while (file.read(buffer.data(), buffer.size()) || file.gcount() > 0)
+	{
+		//just read
+	}
+
+	return MSV_SUCCESS;
+}
+
+#else
+
+MsvErrorCode MsvDllPrefetcher::PrefetchFile(const std::string& dllPath)
+{
+	if (m_mode == MsvDllPrefetchMode::MSV_DLL_PREFETCH_LOCK)
+	{
+		std::lock_guard<std::recursive_mutex> lock(m_lock);
+		for (const MsvLockedFile& lockedFile : m_lockedFiles)
+		{
+			if (lockedFile.path == dllPath)
+			{
+				//file has been locked by previous prefetch (its pages are resident)
+				return MSV_SUCCESS;
+			}
+		}
+	}
+
+	int fd = open(dllPath.c_str(), O_RDONLY | O_CLOEXEC);
+	if (fd < 0)
+	{
+		MSV_LOG_ERROR(m_spLogger, "Open DLL {} to prefetch failed with error: {0:x}", dllPath, MSV_NOT_FOUND_ERROR);
+		return MSV_NOT_FOUND_ERROR;
+	}
+
+	struct stat fileStat;
+	if (fstat(fd, &fileStat) != 0 || fileStat.st_size <= 0)
+	{
+		close(fd);
+		MSV_LOG_ERROR(m_spLogger, "Stat DLL {} to prefetch failed with error: {0:x}", dllPath, MSV_NOT_FOUND_ERROR);
+		return MSV_NOT_FOUND_ERROR;
+	}
+
+	size_t size = static_cast<size_t>(fileStat.st_size);
+
+	//readahead (asynchronous - it is just hint for kernel)
+	posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+
+	if (m_mode == MsvDllPrefetchMode::MSV_DLL_PREFETCH_READAHEAD)
+	{
+		close(fd);
+		return MSV_SUCCESS;
+	}
+
+	int mapFlags = MAP_PRIVATE;
+#if defined(MAP_POPULATE)
+	mapFlags |= MAP_POPULATE;
+#endif
+
+	void* address = mmap(nullptr, size, PROT_READ, mapFlags, fd, 0);
+	close(fd);
+
+	if (address == MAP_FAILED)
+	{
+		MSV_LOG_ERROR(m_spLogger, "Map DLL {} to prefetch failed with error: {0:x}", dllPath, MSV_NOT_FOUND_ERROR);
+		return MSV_NOT_FOUND_ERROR;
+	}
+
+#if !defined(MAP_POPULATE)
+	//no populate flag -> touch each page to fault it in
+	long pageSize = sysconf(_SC_PAGESIZE);
+	volatile const char* bytes = static_cast<const char*>(address);
+	for (size_t offset = 0; offset < size; offset += static_cast<size_t>(pageSize))
+	{
+		(void)bytes[offset];
+	}
+#endif
+
+	if (m_mode == MsvDllPrefetchMode::MSV_DLL_PREFETCH_LOCK)
+	{
+		if (mlock(address, size) == 0)
+		{
+			//keep mapping (pages stay locked in page cache until unlocked)
+			std::lock_guard<std::recursive_mutex> lock(m_lock);
+			m_lockedFiles.push_back({ dllPath, address, size });
+			return MSV_SUCCESS;
+		}
+
+		//lock failed (probably RLIMIT_MEMLOCK) -> file is prefaulted at least
+		MSV_LOG_INFO(m_spLogger, "Lock DLL {} failed - it is only prefaulted.", dllPath);
+	}
+
+	munmap(address, size);
+
+	return MSV_SUCCESS;
+}
+
+#endif
+
+
+/** @} */	//End of group MMODULE.
@@ -0,0 +1,161 @@
+/**************************************************************************************************//**
+* @addtogroup	MMODULE
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech DLL Prefetcher
+* @details		Contains definition of @ref MsvDllPrefetcher.
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Module Library.
+
+MarsTech Dependency Injection is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef MARSTECH_DLLPREFETCHER_H
+#define MARSTECH_DLLPREFETCHER_H
+
+
+#include "merror/MsvError.h"
+
+#include "mlogging/mlogging.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <mutex>
+#include <string>
+#include <vector>
+
+MSV_ENABLE_WARNINGS
+
+
+/**************************************************************************************************//**
+* @brief		DLL prefetch mode.
+* @details	How deep DLL files are warmed up. Each mode includes all previous modes.
+******************************************************************************************************/
+enum class MsvDllPrefetchMode: int32_t
+{
+	MSV_DLL_PREFETCH_READAHEAD = 0,		///< Issue readahead of whole file to page cache (asynchronous in kernel).
+	MSV_DLL_PREFETCH_PREFAULT,				///< Map file and fault all its pages in (synchronous).
+	MSV_DLL_PREFETCH_LOCK					///< Map file, fault all its pages in and lock them in memory until @ref MsvDllPrefetcher::Unlock.
+};
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech DLL Prefetcher.
+* @details	Warms up DLL files before they are loaded. Files are prefetched in parallel so loading
+*				DLLs does not page-fault theirs sections in piecemeal from disk.
+* @note		Locked files (@ref MsvDllPrefetchMode::MSV_DLL_PREFETCH_LOCK) are not supported on Windows - files
+*				are only prefaulted there.
+******************************************************************************************************/
+class MsvDllPrefetcher
+{
+public:
+	/**************************************************************************************************//**
+	* @brief			Constructor.
+	* @param[in]	mode					Prefetch mode.
+	* @param[in]	maxThreads			Maximal number of threads used to prefetch files (0 = number of CPUs).
+	* @param[in]	spLogger				Shared pointer to logger for logging.
+	******************************************************************************************************/
+	MsvDllPrefetcher(MsvDllPrefetchMode mode = MsvDllPrefetchMode::MSV_DLL_PREFETCH_READAHEAD, uint32_t maxThreads = 0, std::shared_ptr<MsvLogger> spLogger = nullptr);
+
+	/**************************************************************************************************//**
+	* @brief		Virtual destructor.
+	* @details	Unlocks all locked files.
+	******************************************************************************************************/
+	virtual ~MsvDllPrefetcher();
+
+	/**************************************************************************************************//**
+	* @brief			Prefetch DLL files.
+	* @details		Prefetches all DLL files in parallel and waits until all are prefetched.
+	* @param[in]	dllPaths						Paths of DLL files.
+	* @retval		MSV_ALLOCATION_ERROR		When prefetch thread can not be created (already started threads are joined).
+	* @retval		other_error_code			When at least one file failed (error code of last failed file).
+	* @retval		MSV_SUCCESS					On success.
+	* @note			Failures are not fatal - DLLs are just loaded slower.
+	******************************************************************************************************/
+	virtual MsvErrorCode Prefetch(const std::vector<std::string>& dllPaths);
+
+	/**************************************************************************************************//**
+	* @brief			Unlock DLL files.
+	* @details		Unlocks and unmaps all files locked by @ref Prefetch.
+	******************************************************************************************************/
+	virtual void Unlock();
+
+protected:
+	/**************************************************************************************************//**
+	* @brief			Prefetch DLL file.
+	* @details		Prefetches one DLL file (called from prefetch threads). File which is already locked is not
+	*					mapped and locked again.
+	* @param[in]	dllPath						Path of DLL file.
+	* @retval		MSV_NOT_FOUND_ERROR		When file can not be opened or mapped.
+	* @retval		MSV_SUCCESS					On success.
+	******************************************************************************************************/
+	virtual MsvErrorCode PrefetchFile(const std::string& dllPath);
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Locked file.
+	* @details	Memory mapping of locked file.
+	******************************************************************************************************/
+	struct MsvLockedFile
+	{
+		std::string path;					///< Path of file.
+		void* address;						///< Address of mapping.
+		size_t size;						///< Size of mapping.
+	};
+
+	/**************************************************************************************************//**
+	* @brief		DLL prefetcher mutex.
+	* @details	Locks this object for thread safety access.
+	******************************************************************************************************/
+	mutable std::recursive_mutex m_lock;
+
+	/**************************************************************************************************//**
+	* @brief		Prefetch mode.
+	* @details	How deep DLL files are warmed up.
+	******************************************************************************************************/
+	MsvDllPrefetchMode m_mode;
+
+	/**************************************************************************************************//**
+	* @brief		Maximal number of threads.
+	* @details	Maximal number of threads used to prefetch files.
+	******************************************************************************************************/
+	uint32_t m_maxThreads;
+
+	/**************************************************************************************************//**
+	* @brief		Locked files.
+	* @details	Files locked in memory (unlocked by @ref Unlock). Each file is locked once.
+	******************************************************************************************************/
+	std::vector<MsvLockedFile> m_lockedFiles;
+
+	/**************************************************************************************************//**
+	* @brief		Logger.
+	* @details	Shared pointer to logger for logging.
+	******************************************************************************************************/
+	std::shared_ptr<MsvLogger> m_spLogger;
+};
+
+
+#endif // !MARSTECH_DLLPREFETCHER_H
+
+/** @} */	//End of group MMODULE.
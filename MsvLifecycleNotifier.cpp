@@ -0,0 +1,222 @@
+/**************************************************************************************************//**
+* @addtogroup	MMODULE
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Lifecycle Notifier
+* @details		Contains implementation of @ref MsvLifecycleNotifier.
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Module Library.
+
+MarsTech Dependency Injection is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "MsvLifecycleNotifier.h"
+
+#include "merror/MsvErrorCodes.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <algorithm>
+#include <system_error>
+
+MSV_ENABLE_WARNINGS
+
+
+/********************************************************************************************************************************
+*															Constructors and destructors
+********************************************************************************************************************************/
+
+
+MsvLifecycleNotifier::MsvLifecycleNotifier(size_t capacity):
+	m_events(capacity),
+	m_spObservers(std::make_shared<const std::vector<std::shared_ptr<IMsvLifecycleObserver>>>()),
+	m_stopping(false),
+	m_observed(false),
+	m_waiting(false),
+	m_droppedCount(0)
+{
+
+}
+
+MsvLifecycleNotifier::~MsvLifecycleNotifier()
+{
+	Stop();
+}
+
+
+/********************************************************************************************************************************
+*															MsvLifecycleNotifier public methods
+********************************************************************************************************************************/
+
+
+MsvErrorCode MsvLifecycleNotifier::Subscribe(std::shared_ptr<IMsvLifecycleObserver> spObserver)
+{
+	if (!spObserver)
+	{
+		return MSV_INVALID_DATA_ERROR;
+	}
+
+	std::lock_guard<std::mutex> lock(m_lock);
+
+	if (std::find(m_spObservers->begin(), m_spObservers->end(), spObserver) != m_spObservers->end())
+	{
+		return MSV_ALREADY_EXISTS_ERROR;
+	}
+
+	if (!m_thread.joinable())
+	{
+		try
+		{
+			m_thread = std::thread(&MsvLifecycleNotifier::Dispatch, this);
+		}
+		catch (const std::system_error&)
+		{
+			return MSV_ALLOCATION_ERROR;
+		}
+	}
+
+	std::shared_ptr<std::vector<std::shared_ptr<IMsvLifecycleObserver>>> spObservers = std::make_shared<std::vector<std::shared_ptr<IMsvLifecycleObserver>>>(*m_spObservers);
+	spObservers->push_back(spObserver);
+	m_spObservers = spObservers;
+	m_observed.store(true);
+
+	return MSV_SUCCESS;
+}
+
+MsvErrorCode MsvLifecycleNotifier::Unsubscribe(std::shared_ptr<IMsvLifecycleObserver> spObserver)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+
+	std::vector<std::shared_ptr<IMsvLifecycleObserver>>::const_iterator it = std::find(m_spObservers->begin(), m_spObservers->end(), spObserver);
+	if (it == m_spObservers->end())
+	{
+		return MSV_NOT_FOUND_ERROR;
+	}
+
+	std::shared_ptr<std::vector<std::shared_ptr<IMsvLifecycleObserver>>> spObservers = std::make_shared<std::vector<std::shared_ptr<IMsvLifecycleObserver>>>(*m_spObservers);
+	spObservers->erase(spObservers->begin() + (it - m_spObservers->begin()));
+	m_observed.store(!spObservers->empty());
+	m_spObservers = spObservers;
+
+	return MSV_SUCCESS;
+}
+
+void MsvLifecycleNotifier::Publish(const MsvLifecycleEvent& event)
+{
+	if (!m_observed.load(std::memory_order_relaxed))
+	{
+		return;
+	}
+
+	if (!m_events.Push(event))
+	{
+		m_droppedCount.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+
+	//pairs with fence of waiting notifier thread (it sees event or publisher sees waiting flag)
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (m_waiting.load(std::memory_order_relaxed))
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+		m_condition.notify_one();
+	}
+}
+
+uint64_t MsvLifecycleNotifier::GetDroppedCount() const
+{
+	return m_droppedCount.load(std::memory_order_relaxed);
+}
+
+
+/********************************************************************************************************************************
+*															MsvLifecycleNotifier protected methods
+********************************************************************************************************************************/
+
+
+void MsvLifecycleNotifier::Dispatch()
+{
+	std::vector<MsvLifecycleEvent> events(MSV_LIFECYCLE_EVENT_BATCH_SIZE);
+
+	for (;;)
+	{
+		size_t count = m_events.PopBatch(events.data(), events.size());
+		if (count != 0)
+		{
+			//observers are called out of lock (they can subscribe and unsubscribe)
+			std::shared_ptr<const std::vector<std::shared_ptr<IMsvLifecycleObserver>>> spObservers;
+
+			{
+				std::lock_guard<std::mutex> lock(m_lock);
+				spObservers = m_spObservers;
+			}
+
+			for (std::vector<std::shared_ptr<IMsvLifecycleObserver>>::const_iterator it = spObservers->begin(); it != spObservers->end(); ++it)
+			{
+				(*it)->OnLifecycleEvents(events.data(), count);
+			}
+
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(m_lock);
+
+		//publisher which does not see waiting flag has queued event before the next pop
+		m_waiting.store(true);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+
+		if (m_events.Empty())
+		{
+			if (m_stopping)
+			{
+				m_waiting.store(false);
+				return;
+			}
+
+			m_condition.wait(lock);
+		}
+
+		m_waiting.store(false);
+	}
+}
+
+void MsvLifecycleNotifier::Stop()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+
+		if (!m_thread.joinable())
+		{
+			return;
+		}
+
+		m_stopping = true;
+		m_condition.notify_all();
+	}
+
+	m_thread.join();
+}
+
+
+/** @} */	//End of group MMODULE.
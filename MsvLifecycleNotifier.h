@@ -0,0 +1,195 @@
+/**************************************************************************************************//**
+* @addtogroup	MMODULE
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Lifecycle Notifier
+* @details		Contains definition of @ref MsvLifecycleNotifier (asynchronous dispatcher of lifecycle events).
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Module Library.
+
+MarsTech Dependency Injection is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef MARSTECH_LIFECYCLENOTIFIER_H
+#define MARSTECH_LIFECYCLENOTIFIER_H
+
+
+#include "IMsvLifecycleObserver.h"
+#include "MsvRingBuffer.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+MSV_ENABLE_WARNINGS
+
+
+/**************************************************************************************************//**
+* @brief		Default lifecycle event queue capacity.
+******************************************************************************************************/
+static const size_t MSV_LIFECYCLE_EVENT_QUEUE_CAPACITY = 1024;
+
+/**************************************************************************************************//**
+* @brief		Lifecycle event batch size.
+* @details	Maximal number of events delivered to observer at once.
+******************************************************************************************************/
+static const size_t MSV_LIFECYCLE_EVENT_BATCH_SIZE = 64;
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Lifecycle Notifier.
+* @details	Delivers lifecycle events of modules to subscribed observers. Events are queued to lock-free ring buffer
+*				(publisher does not lock unless notifier thread waits) and dispatched in batches on notifier thread - slow
+*				observer never blocks module manager. Notifier thread is created by the first subscription, events are
+*				not queued until someone subscribes.
+* @note		Events are dropped (and counted) when queue is full.
+******************************************************************************************************/
+class MsvLifecycleNotifier
+{
+public:
+	/**************************************************************************************************//**
+	* @brief			Constructor.
+	* @param[in]	capacity				Event queue capacity (rounded up to power of two).
+	******************************************************************************************************/
+	MsvLifecycleNotifier(size_t capacity = MSV_LIFECYCLE_EVENT_QUEUE_CAPACITY);
+
+	/**************************************************************************************************//**
+	* @brief		Virtual destructor.
+	* @details	Dispatches queued events and stops notifier thread.
+	******************************************************************************************************/
+	virtual ~MsvLifecycleNotifier();
+
+	MsvLifecycleNotifier(const MsvLifecycleNotifier&) = delete;
+	MsvLifecycleNotifier& operator=(const MsvLifecycleNotifier&) = delete;
+
+	/**************************************************************************************************//**
+	* @brief			Subscribe observer.
+	* @details		Observer gets events which happen since now. Notifier thread is started when it is not running.
+	* @param[in]	spObserver							Shared pointer to observer.
+	* @retval		MSV_INVALID_DATA_ERROR			When observer is empty.
+	* @retval		MSV_ALREADY_EXISTS_ERROR		When observer has been subscribed.
+	* @retval		MSV_ALLOCATION_ERROR				When notifier thread can not be created.
+	* @retval		MSV_SUCCESS							On success.
+	******************************************************************************************************/
+	virtual MsvErrorCode Subscribe(std::shared_ptr<IMsvLifecycleObserver> spObserver);
+
+	/**************************************************************************************************//**
+	* @brief			Unsubscribe observer.
+	* @details		Observer does not get events any more (batch which is being dispatched can still reach it).
+	* @param[in]	spObserver							Shared pointer to observer.
+	* @retval		MSV_NOT_FOUND_ERROR				When observer has not been subscribed.
+	* @retval		MSV_SUCCESS							On success.
+	******************************************************************************************************/
+	virtual MsvErrorCode Unsubscribe(std::shared_ptr<IMsvLifecycleObserver> spObserver);
+
+	/**************************************************************************************************//**
+	* @brief			Publish event.
+	* @details		Queues event without blocking (it does nothing when there is no observer).
+	* @param[in]	event									Lifecycle event.
+	******************************************************************************************************/
+	virtual void Publish(const MsvLifecycleEvent& event);
+
+	/**************************************************************************************************//**
+	* @brief		Get dropped count.
+	* @details	Returns number of events dropped because queue was full.
+	* @returns	uint64_t
+	******************************************************************************************************/
+	virtual uint64_t GetDroppedCount() const;
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Notifier thread.
+	* @details	Dispatches queued events to observers until notifier is stopped (queued events are dispatched before
+	*				it exits).
+	******************************************************************************************************/
+	void Dispatch();
+
+	/**************************************************************************************************//**
+	* @brief		Stop notifier thread.
+	******************************************************************************************************/
+	void Stop();
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Notifier mutex.
+	* @details	Locks observers, notifier thread and stopping flag (publishers do not lock it).
+	******************************************************************************************************/
+	std::mutex m_lock;
+
+	/**************************************************************************************************//**
+	* @brief		Notifier condition variable.
+	* @details	Wakes notifier thread.
+	******************************************************************************************************/
+	std::condition_variable m_condition;
+
+	/**************************************************************************************************//**
+	* @brief		Events.
+	* @details	Queued events (published by more threads, popped by notifier thread).
+	******************************************************************************************************/
+	MsvMpscRingBuffer<MsvLifecycleEvent> m_events;
+
+	/**************************************************************************************************//**
+	* @brief		Observers.
+	* @details	Subscribed observers. List is replaced when it changes - notifier thread dispatches to snapshot out of lock.
+	******************************************************************************************************/
+	std::shared_ptr<const std::vector<std::shared_ptr<IMsvLifecycleObserver>>> m_spObservers;
+
+	/**************************************************************************************************//**
+	* @brief		Notifier thread.
+	******************************************************************************************************/
+	std::thread m_thread;
+
+	/**************************************************************************************************//**
+	* @brief		Stopping flag.
+	* @details	Flag if notifier thread should exit (after queued events are dispatched).
+	******************************************************************************************************/
+	bool m_stopping;
+
+	/**************************************************************************************************//**
+	* @brief		Observed flag.
+	* @details	Flag if any observer has been subscribed (events are not queued otherwise).
+	******************************************************************************************************/
+	std::atomic<bool> m_observed;
+
+	/**************************************************************************************************//**
+	* @brief		Waiting flag.
+	* @details	Flag if notifier thread waits for events.
+	******************************************************************************************************/
+	std::atomic<bool> m_waiting;
+
+	/**************************************************************************************************//**
+	* @brief		Dropped count.
+	******************************************************************************************************/
+	std::atomic<uint64_t> m_droppedCount;
+};
+
+
+#endif // !MARSTECH_LIFECYCLENOTIFIER_H
+
+/** @} */	//End of group MMODULE.
@@ -0,0 +1,366 @@
+/**************************************************************************************************//**
+* @addtogroup	MMODULE
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Lock
+* @details		Contains implementation of @ref MsvInstrumentedRecursiveMutex, @ref MsvRecursiveMutex and @ref MsvLockStatistics.
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Module Library.
+
+MarsTech Dependency Injection is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "MsvLock.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+MSV_ENABLE_WARNINGS
+
+
+/********************************************************************************************************************************
+*															Per-thread statistics
+********************************************************************************************************************************/
+
+
+namespace
+{
+	//call site used by lock methods without call site
+	const char* const MSV_LOCK_UNKNOWN_CALL_SITE = "(unknown)";
+
+	//statistics of one thread (its lock is contended only when statistics are aggregated)
+	struct MsvLockThreadStatistics
+	{
+		std::mutex lock;
+		std::unordered_map<const char*, MsvLockSiteStatistics> sites;
+	};
+
+	//statistics of all threads
+	struct MsvLockRegistry
+	{
+		std::mutex lock;
+		std::vector<std::shared_ptr<MsvLockThreadStatistics>> threads;
+		std::unordered_map<const char*, MsvLockSiteStatistics> exitedThreads;
+	};
+
+	MsvLockRegistry& GetRegistry()
+	{
+		static MsvLockRegistry registry;
+		return registry;
+	}
+
+	void Add(MsvLockSiteStatistics& target, const MsvLockSiteStatistics& source)
+	{
+		target.acquisitions += source.acquisitions;
+		target.recursions += source.recursions;
+		target.contentions += source.contentions;
+		target.totalWait += source.totalWait;
+		target.maxWait = std::max(target.maxWait, source.maxWait);
+		target.totalHold += source.totalHold;
+		target.maxHold = std::max(target.maxHold, source.maxHold);
+	}
+
+	void Merge(std::unordered_map<const char*, MsvLockSiteStatistics>& target, const MsvLockSiteStatistics& site)
+	{
+		std::unordered_map<const char*, MsvLockSiteStatistics>::iterator it = target.find(site.callSite);
+		if (it == target.end())
+		{
+			target.emplace(site.callSite, site);
+			return;
+		}
+
+		Add(it->second, site);
+	}
+
+	//registers statistics of thread and moves them to exited threads when thread exits
+	class MsvLockThreadRegistration
+	{
+	public:
+		MsvLockThreadRegistration():
+			m_spStatistics(std::make_shared<MsvLockThreadStatistics>())
+		{
+			MsvLockRegistry& registry = GetRegistry();
+			std::lock_guard<std::mutex> lock(registry.lock);
+			registry.threads.push_back(m_spStatistics);
+		}
+
+		~MsvLockThreadRegistration()
+		{
+			MsvLockRegistry& registry = GetRegistry();
+			std::lock_guard<std::mutex> lock(registry.lock);
+			std::lock_guard<std::mutex> threadLock(m_spStatistics->lock);
+
+			for (std::unordered_map<const char*, MsvLockSiteStatistics>::const_iterator it = m_spStatistics->sites.begin(); it != m_spStatistics->sites.end(); ++it)
+			{
+				Merge(registry.exitedThreads, it->second);
+			}
+
+			registry.threads.erase(std::remove(registry.threads.begin(), registry.threads.end(), m_spStatistics), registry.threads.end());
+		}
+
+		std::shared_ptr<MsvLockThreadStatistics> m_spStatistics;
+	};
+
+	MsvLockThreadStatistics& GetThreadStatistics()
+	{
+		thread_local MsvLockThreadRegistration registration;
+		return *registration.m_spStatistics;
+	}
+
+	MsvLockSiteStatistics& GetSiteStatistics(MsvLockThreadStatistics& threadStatistics, const char* callSite)
+	{
+		std::unordered_map<const char*, MsvLockSiteStatistics>::iterator it = threadStatistics.sites.find(callSite);
+		if (it == threadStatistics.sites.end())
+		{
+			MsvLockSiteStatistics site = {};
+			site.callSite = callSite;
+			it = threadStatistics.sites.emplace(callSite, site).first;
+		}
+
+		return it->second;
+	}
+}
+
+
+/********************************************************************************************************************************
+*															MsvLockStatistics
+********************************************************************************************************************************/
+
+
+void MsvLockStatistics::GetStatistics(std::vector<MsvLockSiteStatistics>& statistics)
+{
+	std::unordered_map<const char*, MsvLockSiteStatistics> sites;
+	{
+		MsvLockRegistry& registry = GetRegistry();
+		std::lock_guard<std::mutex> lock(registry.lock);
+
+		sites = registry.exitedThreads;
+		for (std::vector<std::shared_ptr<MsvLockThreadStatistics>>::const_iterator threadIt = registry.threads.begin(); threadIt != registry.threads.end(); ++threadIt)
+		{
+			std::lock_guard<std::mutex> threadLock((*threadIt)->lock);
+			for (std::unordered_map<const char*, MsvLockSiteStatistics>::const_iterator it = (*threadIt)->sites.begin(); it != (*threadIt)->sites.end(); ++it)
+			{
+				Merge(sites, it->second);
+			}
+		}
+	}
+
+	//the same call site can have more addresses (e.g. inline methods in more translation units)
+	std::map<std::string, MsvLockSiteStatistics> namedSites;
+	for (std::unordered_map<const char*, MsvLockSiteStatistics>::const_iterator it = sites.begin(); it != sites.end(); ++it)
+	{
+		std::map<std::string, MsvLockSiteStatistics>::iterator namedIt = namedSites.find(it->first);
+		if (namedIt == namedSites.end())
+		{
+			namedSites.emplace(it->first, it->second);
+		}
+		else
+		{
+			Add(namedIt->second, it->second);
+		}
+	}
+
+	statistics.clear();
+	statistics.reserve(namedSites.size());
+	for (std::map<std::string, MsvLockSiteStatistics>::const_iterator it = namedSites.begin(); it != namedSites.end(); ++it)
+	{
+		statistics.push_back(it->second);
+	}
+
+	std::stable_sort(statistics.begin(), statistics.end(), [](const MsvLockSiteStatistics& left, const MsvLockSiteStatistics& right)
+	{
+		return left.totalWait > right.totalWait;
+	});
+}
+
+void MsvLockStatistics::Reset()
+{
+	MsvLockRegistry& registry = GetRegistry();
+	std::lock_guard<std::mutex> lock(registry.lock);
+
+	registry.exitedThreads.clear();
+	for (std::vector<std::shared_ptr<MsvLockThreadStatistics>>::const_iterator it = registry.threads.begin(); it != registry.threads.end(); ++it)
+	{
+		std::lock_guard<std::mutex> threadLock((*it)->lock);
+		(*it)->sites.clear();
+	}
+}
+
+void MsvLockStatistics::RecordAcquisition(const char* callSite, bool contended, std::chrono::nanoseconds wait, std::chrono::nanoseconds hold)
+{
+	MsvLockThreadStatistics& threadStatistics = GetThreadStatistics();
+	std::lock_guard<std::mutex> lock(threadStatistics.lock);
+
+	MsvLockSiteStatistics& site = GetSiteStatistics(threadStatistics, callSite);
+	++site.acquisitions;
+	if (contended)
+	{
+		++site.contentions;
+	}
+	site.totalWait += wait;
+	site.maxWait = std::max(site.maxWait, wait);
+	site.totalHold += hold;
+	site.maxHold = std::max(site.maxHold, hold);
+}
+
+void MsvLockStatistics::RecordRecursion(const char* callSite)
+{
+	MsvLockThreadStatistics& threadStatistics = GetThreadStatistics();
+	std::lock_guard<std::mutex> lock(threadStatistics.lock);
+
+	++GetSiteStatistics(threadStatistics, callSite).recursions;
+}
+
+
+/********************************************************************************************************************************
+*															MsvInstrumentedRecursiveMutex
+********************************************************************************************************************************/
+
+
+MsvInstrumentedRecursiveMutex::MsvInstrumentedRecursiveMutex():
+	m_instrumented(true),
+	m_depth(0),
+	m_callSite(nullptr),
+	m_contended(false),
+	m_wait(std::chrono::nanoseconds::zero())
+{
+
+}
+
+MsvInstrumentedRecursiveMutex::MsvInstrumentedRecursiveMutex(bool instrumented):
+	m_instrumented(instrumented),
+	m_depth(0),
+	m_callSite(nullptr),
+	m_contended(false),
+	m_wait(std::chrono::nanoseconds::zero())
+{
+
+}
+
+void MsvInstrumentedRecursiveMutex::lock(const char* callSite)
+{
+	if (!m_instrumented)
+	{
+		m_mutex.lock();
+		++m_depth;
+		return;
+	}
+
+	if (m_mutex.try_lock())
+	{
+		//not owned by other thread -> no wait (and no clock read)
+		Acquired(callSite, false, std::chrono::nanoseconds::zero());
+		return;
+	}
+
+	std::chrono::steady_clock::time_point waitStart = std::chrono::steady_clock::now();
+	m_mutex.lock();
+	Acquired(callSite, true, std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - waitStart));
+}
+
+void MsvInstrumentedRecursiveMutex::lock()
+{
+	lock(MSV_LOCK_UNKNOWN_CALL_SITE);
+}
+
+bool MsvInstrumentedRecursiveMutex::try_lock(const char* callSite)
+{
+	if (!m_mutex.try_lock())
+	{
+		return false;
+	}
+
+	if (!m_instrumented)
+	{
+		++m_depth;
+		return true;
+	}
+
+	Acquired(callSite, false, std::chrono::nanoseconds::zero());
+	return true;
+}
+
+bool MsvInstrumentedRecursiveMutex::try_lock()
+{
+	return try_lock(MSV_LOCK_UNKNOWN_CALL_SITE);
+}
+
+void MsvInstrumentedRecursiveMutex::unlock()
+{
+	if (--m_depth > 0 || !m_instrumented)
+	{
+		m_mutex.unlock();
+		return;
+	}
+
+	const char* callSite = m_callSite;
+	bool contended = m_contended;
+	std::chrono::nanoseconds wait = m_wait;
+	std::chrono::nanoseconds hold = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_holdStart);
+	m_mutex.unlock();
+
+	//record after unlock (recording is not part of hold time)
+	MsvLockStatistics::RecordAcquisition(callSite, contended, wait, hold);
+}
+
+
+/********************************************************************************************************************************
+*															Protected methods
+********************************************************************************************************************************/
+
+
+void MsvInstrumentedRecursiveMutex::Acquired(const char* callSite, bool contended, std::chrono::nanoseconds wait)
+{
+	if (++m_depth > 1)
+	{
+		//recursive acquisition -> outermost one is measured
+		MsvLockStatistics::RecordRecursion(callSite ? callSite : MSV_LOCK_UNKNOWN_CALL_SITE);
+		return;
+	}
+
+	m_callSite = callSite ? callSite : MSV_LOCK_UNKNOWN_CALL_SITE;
+	m_contended = contended;
+	m_wait = wait;
+	m_holdStart = std::chrono::steady_clock::now();
+}
+
+
+/********************************************************************************************************************************
+*															MsvRecursiveMutex
+********************************************************************************************************************************/
+
+
+MsvRecursiveMutex::MsvRecursiveMutex():
+	MsvInstrumentedRecursiveMutex(MSV_LOCK_INSTRUMENTATION != 0)
+{
+
+}
+
+
+/** @} */	//End of group MMODULE.
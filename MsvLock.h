@@ -0,0 +1,296 @@
+/**************************************************************************************************//**
+* @addtogroup	MMODULE
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Lock
+* @details		Contains definition of @ref MsvRecursiveMutex (optionally instrumented recursive mutex),
+*					@ref MsvLockGuard and @ref MsvLockStatistics.
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Module Library.
+
+MarsTech Dependency Injection is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef MARSTECH_LOCK_H
+#define MARSTECH_LOCK_H
+
+
+#include "merror/MsvError.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+MSV_ENABLE_WARNINGS
+
+
+/**************************************************************************************************//**
+* @brief		Lock instrumentation.
+* @details	When it is not zero, @ref MsvRecursiveMutex records lock wait and hold times. When it is zero (default),
+*				@ref MsvRecursiveMutex only locks. It is used only when library is built (@ref MsvRecursiveMutex has
+*				the same layout with any value, so library and its clients can be built with different values).
+******************************************************************************************************/
+#ifndef MSV_LOCK_INSTRUMENTATION
+#define MSV_LOCK_INSTRUMENTATION 0
+#endif
+
+
+/**************************************************************************************************//**
+* @brief		Lock call site.
+* @details	Name of current method (static string) passed to @ref MsvLockGuard.
+******************************************************************************************************/
+#if defined(_MSC_VER)
+#define MSV_LOCK_CALL_SITE __FUNCTION__
+#else
+#define MSV_LOCK_CALL_SITE __PRETTY_FUNCTION__
+#endif
+
+
+/**************************************************************************************************//**
+* @brief		Lock call site statistics.
+* @details	Lock statistics of one call site aggregated from all threads.
+******************************************************************************************************/
+struct MsvLockSiteStatistics
+{
+	const char* callSite;								///< Call site (method name).
+	uint64_t acquisitions;								///< Number of outermost acquisitions.
+	uint64_t recursions;									///< Number of recursive acquisitions (lock already owned by thread).
+	uint64_t contentions;								///< Number of acquisitions which had to wait (lock owned by other thread).
+	std::chrono::nanoseconds totalWait;				///< Total time spent waiting for lock.
+	std::chrono::nanoseconds maxWait;				///< Longest wait for lock.
+	std::chrono::nanoseconds totalHold;				///< Total time lock was held (from outermost lock to its unlock).
+	std::chrono::nanoseconds maxHold;				///< Longest time lock was held.
+};
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Lock Statistics.
+* @details	Lock statistics are recorded to per-thread counters (no shared cache line on hot path) and aggregated
+*				on demand. Counters of exited threads are kept.
+******************************************************************************************************/
+class MsvLockStatistics
+{
+public:
+	/**************************************************************************************************//**
+	* @brief			Get statistics.
+	* @details		Aggregates statistics of all threads. Call sites are sorted by total wait (longest first).
+	* @param[out]	statistics			Statistics of all call sites (empty when nothing has been recorded).
+	******************************************************************************************************/
+	static void GetStatistics(std::vector<MsvLockSiteStatistics>& statistics);
+
+	/**************************************************************************************************//**
+	* @brief		Reset statistics.
+	* @details	Clears statistics of all threads.
+	******************************************************************************************************/
+	static void Reset();
+
+	/**************************************************************************************************//**
+	* @brief			Record acquisition.
+	* @details		Records outermost acquisition of lock (it is called after lock is released).
+	* @param[in]	callSite				Call site (static string).
+	* @param[in]	contended			Flag if lock was owned by other thread (true) or not (false).
+	* @param[in]	wait					Time spent waiting for lock.
+	* @param[in]	hold					Time lock was held.
+	******************************************************************************************************/
+	static void RecordAcquisition(const char* callSite, bool contended, std::chrono::nanoseconds wait, std::chrono::nanoseconds hold);
+
+	/**************************************************************************************************//**
+	* @brief			Record recursion.
+	* @details		Records recursive acquisition of lock.
+	* @param[in]	callSite				Call site (static string).
+	******************************************************************************************************/
+	static void RecordRecursion(const char* callSite);
+};
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Instrumented Recursive Mutex.
+* @details	Recursive mutex which measures wait time (only when lock is owned by other thread) and hold time of
+*				outermost acquisitions and records them to @ref MsvLockStatistics by call site.
+******************************************************************************************************/
+class MsvInstrumentedRecursiveMutex
+{
+public:
+	/**************************************************************************************************//**
+	* @brief		Constructor.
+	******************************************************************************************************/
+	MsvInstrumentedRecursiveMutex();
+
+	/**************************************************************************************************//**
+	* @brief			Constructor.
+	* @param[in]	instrumented		Flag if statistics are recorded (true) or mutex only locks (false).
+	******************************************************************************************************/
+	explicit MsvInstrumentedRecursiveMutex(bool instrumented);
+
+	MsvInstrumentedRecursiveMutex(const MsvInstrumentedRecursiveMutex&) = delete;
+	MsvInstrumentedRecursiveMutex& operator=(const MsvInstrumentedRecursiveMutex&) = delete;
+
+	/**************************************************************************************************//**
+	* @brief			Lock.
+	* @details		Locks mutex and records call site.
+	* @param[in]	callSite				Call site (static string).
+	******************************************************************************************************/
+	void lock(const char* callSite);
+
+	/**************************************************************************************************//**
+	* @brief		Lock.
+	* @details	Locks mutex with unknown call site (std::lock_guard compatibility).
+	******************************************************************************************************/
+	void lock();
+
+	/**************************************************************************************************//**
+	* @brief			Try lock.
+	* @details		Locks mutex when it is not owned by other thread.
+	* @param[in]	callSite				Call site (static string).
+	* @returns		bool
+	* @retval		true					When mutex has been locked.
+	* @retval		false					When mutex is owned by other thread.
+	******************************************************************************************************/
+	bool try_lock(const char* callSite);
+
+	/**************************************************************************************************//**
+	* @brief		Try lock.
+	* @details	Locks mutex with unknown call site when it is not owned by other thread.
+	* @returns	bool
+	******************************************************************************************************/
+	bool try_lock();
+
+	/**************************************************************************************************//**
+	* @brief		Unlock.
+	* @details	Unlocks mutex and records hold time when it is outermost unlock.
+	******************************************************************************************************/
+	void unlock();
+
+protected:
+	/**************************************************************************************************//**
+	* @brief			Acquired.
+	* @details		Updates owner state after mutex has been locked.
+	* @param[in]	callSite				Call site.
+	* @param[in]	contended			Flag if lock was owned by other thread.
+	* @param[in]	wait					Time spent waiting for lock.
+	******************************************************************************************************/
+	void Acquired(const char* callSite, bool contended, std::chrono::nanoseconds wait);
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Mutex.
+	******************************************************************************************************/
+	std::recursive_mutex m_mutex;
+
+	/**************************************************************************************************//**
+	* @brief		Instrumented flag.
+	* @details	Flag if statistics are recorded (true) or mutex only locks (false).
+	******************************************************************************************************/
+	bool m_instrumented;
+
+	/**************************************************************************************************//**
+	* @brief		Recursion depth.
+	* @details	Number of locks of owner thread (it is accessed only by owner thread).
+	******************************************************************************************************/
+	uint32_t m_depth;
+
+	/**************************************************************************************************//**
+	* @brief		Call site of outermost acquisition.
+	******************************************************************************************************/
+	const char* m_callSite;
+
+	/**************************************************************************************************//**
+	* @brief		Flag if outermost acquisition was contended.
+	******************************************************************************************************/
+	bool m_contended;
+
+	/**************************************************************************************************//**
+	* @brief		Wait time of outermost acquisition.
+	******************************************************************************************************/
+	std::chrono::nanoseconds m_wait;
+
+	/**************************************************************************************************//**
+	* @brief		Time of outermost acquisition.
+	******************************************************************************************************/
+	std::chrono::steady_clock::time_point m_holdStart;
+};
+
+
+/**************************************************************************************************//**
+* @brief		Recursive mutex.
+* @details	Recursive mutex of module manager and DLL module adapter. It records statistics only when library is
+*				built with @ref MSV_LOCK_INSTRUMENTATION (it is one type - class layout does not depend on it).
+******************************************************************************************************/
+class MsvRecursiveMutex:
+	public MsvInstrumentedRecursiveMutex
+{
+public:
+	/**************************************************************************************************//**
+	* @brief		Constructor.
+	* @details	Statistics are recorded when library is built with @ref MSV_LOCK_INSTRUMENTATION.
+	******************************************************************************************************/
+	MsvRecursiveMutex();
+};
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Lock Guard.
+* @details	Locks @ref MsvRecursiveMutex in constructor and unlocks it in destructor. Call site is recorded only when
+*				lock instrumentation is enabled.
+******************************************************************************************************/
+class MsvLockGuard
+{
+public:
+	/**************************************************************************************************//**
+	* @brief			Constructor.
+	* @param[in]	mutex					Mutex to lock.
+	* @param[in]	callSite				Call site (use @ref MSV_LOCK_CALL_SITE).
+	******************************************************************************************************/
+	MsvLockGuard(MsvRecursiveMutex& mutex, const char* callSite):
+		m_mutex(mutex)
+	{
+		m_mutex.lock(callSite);
+	}
+
+	/**************************************************************************************************//**
+	* @brief		Destructor.
+	* @details	Unlocks mutex.
+	******************************************************************************************************/
+	~MsvLockGuard()
+	{
+		m_mutex.unlock();
+	}
+
+	MsvLockGuard(const MsvLockGuard&) = delete;
+	MsvLockGuard& operator=(const MsvLockGuard&) = delete;
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Locked mutex.
+	******************************************************************************************************/
+	MsvRecursiveMutex& m_mutex;
+};
+
+
+#endif // !MARSTECH_LOCK_H
+
+/** @} */	//End of group MMODULE.
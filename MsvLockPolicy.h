@@ -0,0 +1,181 @@
+/**************************************************************************************************//**
+* @addtogroup	MMODULE
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Lock Policies
+* @details		Contains definition of lock policies of module bases (@ref MsvModuleBaseT and
+*					@ref MsvDllModuleBaseT).
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+* @note			This iplementation is in header file only -> it should be possible to include this header
+*					file to your project without linking this library.
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Module Library.
+
+MarsTech Dependency Injection is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef MARSTECH_LOCKPOLICY_H
+#define MARSTECH_LOCKPOLICY_H
+
+
+#include "merror/MsvError.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+
+MSV_ENABLE_WARNINGS
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Null Mutex.
+* @details	Mutex which does nothing (for objects used only from one thread).
+******************************************************************************************************/
+class MsvNullMutex
+{
+public:
+	void lock() {}
+	bool try_lock() { return true; }
+	void unlock() {}
+	void lock_shared() {}
+	bool try_lock_shared() { return true; }
+	void unlock_shared() {}
+};
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Spin Lock.
+* @details	Busy-waiting lock for very short critical sections (it yields after some unsuccessful spins).
+******************************************************************************************************/
+class MsvSpinLock
+{
+public:
+	MsvSpinLock()
+	{
+		m_flag.clear();
+	}
+
+	MsvSpinLock(const MsvSpinLock&) = delete;
+	MsvSpinLock& operator=(const MsvSpinLock&) = delete;
+
+	void lock()
+	{
+		for (uint32_t spins = 0; m_flag.test_and_set(std::memory_order_acquire); ++spins)
+		{
+			if (spins >= 64)
+			{
+				std::this_thread::yield();
+			}
+		}
+	}
+
+	bool try_lock()
+	{
+		return !m_flag.test_and_set(std::memory_order_acquire);
+	}
+
+	void unlock()
+	{
+		m_flag.clear(std::memory_order_release);
+	}
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Lock flag.
+	* @details	Flag if lock is owned (set) or not (clear).
+	******************************************************************************************************/
+	std::atomic_flag m_flag;
+};
+
+
+/**************************************************************************************************//**
+* @brief		No lock policy.
+* @details	Module state is not locked at all (module is used only from one thread, e.g. startup thread).
+******************************************************************************************************/
+struct MsvNoLockPolicy
+{
+	typedef MsvNullMutex Mutex;								///< Mutex type.
+	typedef std::lock_guard<Mutex> WriteLock;				///< Lock of state changes.
+	typedef std::lock_guard<Mutex> ReadLock;				///< Lock of state queries.
+};
+
+
+/**************************************************************************************************//**
+* @brief		Spin lock policy.
+* @details	Module state is locked by spin lock (not recursive).
+******************************************************************************************************/
+struct MsvSpinLockPolicy
+{
+	typedef MsvSpinLock Mutex;									///< Mutex type.
+	typedef std::lock_guard<Mutex> WriteLock;				///< Lock of state changes.
+	typedef std::lock_guard<Mutex> ReadLock;				///< Lock of state queries.
+};
+
+
+/**************************************************************************************************//**
+* @brief		Mutex lock policy.
+* @details	Module state is locked by std::mutex (not recursive).
+******************************************************************************************************/
+struct MsvMutexLockPolicy
+{
+	typedef std::mutex Mutex;									///< Mutex type.
+	typedef std::lock_guard<Mutex> WriteLock;				///< Lock of state changes.
+	typedef std::lock_guard<Mutex> ReadLock;				///< Lock of state queries.
+};
+
+
+/**************************************************************************************************//**
+* @brief		Shared lock policy.
+* @details	Module state is locked by shared mutex (not recursive) - state queries do not block each other.
+******************************************************************************************************/
+struct MsvSharedLockPolicy
+{
+#if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+	typedef std::shared_mutex Mutex;							///< Mutex type.
+#else
+	typedef std::shared_timed_mutex Mutex;					///< Mutex type (std::shared_mutex is C++17).
+#endif
+	typedef std::lock_guard<Mutex> WriteLock;				///< Lock of state changes.
+	typedef std::shared_lock<Mutex> ReadLock;				///< Lock of state queries.
+};
+
+
+/**************************************************************************************************//**
+* @brief		Recursive lock policy.
+* @details	Module state is locked by std::recursive_mutex (default - module methods can call each other).
+******************************************************************************************************/
+struct MsvRecursiveLockPolicy
+{
+	typedef std::recursive_mutex Mutex;						///< Mutex type.
+	typedef std::lock_guard<Mutex> WriteLock;				///< Lock of state changes.
+	typedef std::lock_guard<Mutex> ReadLock;				///< Lock of state queries.
+};
+
+
+#endif // !MARSTECH_LOCKPOLICY_H
+
+/** @} */	//End of group MMODULE.
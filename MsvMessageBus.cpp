@@ -0,0 +1,342 @@
+/**************************************************************************************************//**
+* @addtogroup	MMODULE
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Message Bus
+* @details		Contains implementation of @ref MsvMessageQueue and @ref MsvMessageBus.
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Module Library.
+
+MarsTech Dependency Injection is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "MsvMessageBus.h"
+#include "MsvWaitableState.h"
+
+#include "merror/MsvErrorCodes.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <thread>
+#include <vector>
+
+MSV_ENABLE_WARNINGS
+
+
+/********************************************************************************************************************************
+*															MsvMessageQueue constructors and destructors
+********************************************************************************************************************************/
+
+
+MsvMessageQueue::MsvMessageQueue(size_t capacity, bool singleProducer):
+	m_spMpscRingBuffer(singleProducer ? nullptr : new MsvMpscRingBuffer<MsvMessage>(capacity)),
+	m_spSpscRingBuffer(singleProducer ? new MsvSpscRingBuffer<MsvMessage>(capacity) : nullptr),
+	m_closed(false),
+	m_waiting(false),
+	m_receiving(false)
+{
+
+}
+
+MsvMessageQueue::~MsvMessageQueue()
+{
+
+}
+
+
+/********************************************************************************************************************************
+*															MsvMessageQueue public methods
+********************************************************************************************************************************/
+
+
+MsvErrorCode MsvMessageQueue::Send(const MsvMessage& message)
+{
+	size_t sentCount = 0;
+	return SendBatch(&message, 1, sentCount);
+}
+
+MsvErrorCode MsvMessageQueue::SendBatch(const MsvMessage* pMessages, size_t count, size_t& sentCount)
+{
+	sentCount = 0;
+
+	if (m_closed.load(std::memory_order_acquire))
+	{
+		return MSV_NOT_INITIALIZED_ERROR;
+	}
+
+	if (count == 0)
+	{
+		return MSV_SUCCESS;
+	}
+
+	sentCount = m_spMpscRingBuffer ? m_spMpscRingBuffer->PushBatch(pMessages, count) : m_spSpscRingBuffer->PushBatch(pMessages, count);
+	if (sentCount == 0)
+	{
+		return MSV_ALLOCATION_ERROR;
+	}
+
+	WakeConsumer();
+
+	return MSV_SUCCESS;
+}
+
+size_t MsvMessageQueue::Receive(MsvMessage* pMessages, size_t maxCount)
+{
+	//ring buffer has single consumer -> do not pop while queue is being closed
+	if (m_receiving.exchange(true, std::memory_order_acquire))
+	{
+		return 0;
+	}
+
+	size_t count = m_spMpscRingBuffer ? m_spMpscRingBuffer->PopBatch(pMessages, maxCount) : m_spSpscRingBuffer->PopBatch(pMessages, maxCount);
+	m_receiving.store(false, std::memory_order_release);
+
+	return count;
+}
+
+size_t MsvMessageQueue::WaitReceive(MsvMessage* pMessages, size_t maxCount, std::chrono::milliseconds timeout)
+{
+	size_t count = Receive(pMessages, maxCount);
+	if (count != 0 || maxCount == 0)
+	{
+		return count;
+	}
+
+	std::chrono::steady_clock::time_point deadline = MsvWaitableState::GetDeadline(timeout);
+	std::unique_lock<std::mutex> lock(m_waitLock);
+
+	for (;;)
+	{
+		//producer which does not see waiting flag has published message before the next receive
+		m_waiting.store(true);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+
+		count = Receive(pMessages, maxCount);
+		if (count != 0 || m_closed.load() || m_waitCondition.wait_until(lock, deadline) == std::cv_status::timeout)
+		{
+			break;
+		}
+	}
+
+	m_waiting.store(false);
+
+	//the last chance after timeout
+	return count != 0 ? count : Receive(pMessages, maxCount);
+}
+
+void MsvMessageQueue::Close()
+{
+	m_closed.store(true);
+
+	{
+		std::lock_guard<std::mutex> lock(m_waitLock);
+		m_waitCondition.notify_all();
+	}
+
+	//wait until consumer finishes current receive
+	while (m_receiving.exchange(true, std::memory_order_acquire))
+	{
+		std::this_thread::yield();
+	}
+
+	//release queued messages (consumer does not receive them any more)
+	std::vector<MsvMessage> messages(64);
+	while ((m_spMpscRingBuffer ? m_spMpscRingBuffer->PopBatch(messages.data(), messages.size()) : m_spSpscRingBuffer->PopBatch(messages.data(), messages.size())) != 0)
+	{
+	}
+
+	m_receiving.store(false, std::memory_order_release);
+}
+
+void MsvMessageQueue::Open()
+{
+	m_closed.store(false);
+}
+
+bool MsvMessageQueue::Closed() const
+{
+	return m_closed.load();
+}
+
+size_t MsvMessageQueue::GetCapacity() const
+{
+	return m_spMpscRingBuffer ? m_spMpscRingBuffer->GetCapacity() : m_spSpscRingBuffer->GetCapacity();
+}
+
+
+/********************************************************************************************************************************
+*															MsvMessageQueue protected methods
+********************************************************************************************************************************/
+
+
+void MsvMessageQueue::WakeConsumer()
+{
+	//pairs with fence of waiting consumer (it sees message or producer sees waiting flag)
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (m_waiting.load(std::memory_order_relaxed))
+	{
+		std::lock_guard<std::mutex> lock(m_waitLock);
+		m_waitCondition.notify_one();
+	}
+}
+
+
+/********************************************************************************************************************************
+*															MsvMessageBus constructors and destructors
+********************************************************************************************************************************/
+
+
+MsvMessageBus::MsvMessageBus()
+{
+
+}
+
+MsvMessageBus::~MsvMessageBus()
+{
+	for (std::unordered_map<int32_t, std::shared_ptr<MsvMessageQueue>>::iterator it = m_queues.begin(); it != m_queues.end(); ++it)
+	{
+		it->second->Close();
+	}
+}
+
+
+/********************************************************************************************************************************
+*															MsvMessageBus public methods
+********************************************************************************************************************************/
+
+
+MsvErrorCode MsvMessageBus::SetQueueOptions(int32_t moduleId, size_t capacity, bool singleProducer)
+{
+	if (capacity == 0)
+	{
+		return MSV_INVALID_DATA_ERROR;
+	}
+
+	std::lock_guard<MsvSharedLockPolicy::Mutex> lock(m_lock);
+
+	m_queueOptions[moduleId] = std::make_pair(capacity, singleProducer);
+
+	return MSV_SUCCESS;
+}
+
+MsvErrorCode MsvMessageBus::CreateQueue(int32_t moduleId)
+{
+	std::lock_guard<MsvSharedLockPolicy::Mutex> lock(m_lock);
+
+	std::unordered_map<int32_t, std::shared_ptr<MsvMessageQueue>>::const_iterator it = m_queues.find(moduleId);
+	if (it != m_queues.end())
+	{
+		return MSV_ALREADY_EXISTS_ERROR;
+	}
+
+	std::unordered_map<int32_t, std::pair<size_t, bool>>::const_iterator optionsIt = m_queueOptions.find(moduleId);
+	if (optionsIt != m_queueOptions.end())
+	{
+		m_queues[moduleId] = std::make_shared<MsvMessageQueue>(optionsIt->second.first, optionsIt->second.second);
+	}
+	else
+	{
+		m_queues[moduleId] = std::make_shared<MsvMessageQueue>(MSV_MESSAGE_QUEUE_DEFAULT_CAPACITY, false);
+	}
+
+	return MSV_SUCCESS;
+}
+
+MsvErrorCode MsvMessageBus::RemoveQueue(int32_t moduleId)
+{
+	std::shared_ptr<MsvMessageQueue> spQueue;
+
+	{
+		std::lock_guard<MsvSharedLockPolicy::Mutex> lock(m_lock);
+
+		std::unordered_map<int32_t, std::shared_ptr<MsvMessageQueue>>::iterator it = m_queues.find(moduleId);
+		if (it == m_queues.end())
+		{
+			return MSV_NOT_FOUND_ERROR;
+		}
+
+		spQueue = it->second;
+		m_queues.erase(it);
+	}
+
+	//queued messages are released out of bus lock
+	spQueue->Close();
+
+	return MSV_SUCCESS;
+}
+
+MsvErrorCode MsvMessageBus::CloseQueue(int32_t moduleId)
+{
+	std::shared_ptr<MsvMessageQueue> spQueue;
+	MSV_RETURN_FAILED(GetQueue(moduleId, spQueue));
+
+	//queued messages are released out of bus lock
+	spQueue->Close();
+
+	return MSV_SUCCESS;
+}
+
+MsvErrorCode MsvMessageBus::OpenQueue(int32_t moduleId)
+{
+	std::shared_ptr<MsvMessageQueue> spQueue;
+	MSV_RETURN_FAILED(GetQueue(moduleId, spQueue));
+
+	spQueue->Open();
+
+	return MSV_SUCCESS;
+}
+
+MsvErrorCode MsvMessageBus::GetQueue(int32_t moduleId, std::shared_ptr<MsvMessageQueue>& spQueue) const
+{
+	MsvSharedLockPolicy::ReadLock lock(m_lock);
+
+	std::unordered_map<int32_t, std::shared_ptr<MsvMessageQueue>>::const_iterator it = m_queues.find(moduleId);
+	if (it == m_queues.end())
+	{
+		return MSV_NOT_FOUND_ERROR;
+	}
+
+	spQueue = it->second;
+
+	return MSV_SUCCESS;
+}
+
+MsvErrorCode MsvMessageBus::Send(int32_t moduleId, const MsvMessage& message)
+{
+	size_t sentCount = 0;
+	return SendBatch(moduleId, &message, 1, sentCount);
+}
+
+MsvErrorCode MsvMessageBus::SendBatch(int32_t moduleId, const MsvMessage* pMessages, size_t count, size_t& sentCount)
+{
+	sentCount = 0;
+
+	std::shared_ptr<MsvMessageQueue> spQueue;
+	MSV_RETURN_FAILED(GetQueue(moduleId, spQueue));
+
+	return spQueue->SendBatch(pMessages, count, sentCount);
+}
+
+
+/** @} */	//End of group MMODULE.
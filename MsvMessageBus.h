@@ -0,0 +1,366 @@
+/**************************************************************************************************//**
+* @addtogroup	MMODULE
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Message Bus
+* @details		Contains definition of @ref MsvMessage, @ref MsvMessageQueue (message queue of one module) and
+*					@ref MsvMessageBus (message queues addressed by module ID).
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Module Library.
+
+MarsTech Dependency Injection is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef MARSTECH_MESSAGEBUS_H
+#define MARSTECH_MESSAGEBUS_H
+
+
+#include "MsvLockPolicy.h"
+#include "MsvRingBuffer.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+MSV_ENABLE_WARNINGS
+
+
+/**************************************************************************************************//**
+* @brief		Default message queue capacity.
+******************************************************************************************************/
+static const size_t MSV_MESSAGE_QUEUE_DEFAULT_CAPACITY = 1024;
+
+
+/**************************************************************************************************//**
+* @brief		Message.
+* @details	Message sent between modules. Payload is shared (it is released when message is received and destroyed).
+******************************************************************************************************/
+struct MsvMessage
+{
+	/**************************************************************************************************//**
+	* @brief		Constructor.
+	******************************************************************************************************/
+	MsvMessage():
+		senderId(0),
+		messageType(0)
+	{
+
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Constructor.
+	* @param[in]	senderIdValue			Sender module ID.
+	* @param[in]	messageTypeValue		Message type (defined by modules).
+	* @param[in]	spPayloadValue			Payload.
+	******************************************************************************************************/
+	MsvMessage(int32_t senderIdValue, int32_t messageTypeValue, std::shared_ptr<void> spPayloadValue = nullptr):
+		senderId(senderIdValue),
+		messageType(messageTypeValue),
+		spPayload(std::move(spPayloadValue))
+	{
+
+	}
+
+	int32_t senderId;										///< Sender module ID.
+	int32_t messageType;									///< Message type (defined by modules).
+	std::shared_ptr<void> spPayload;					///< Payload (empty when message has no payload).
+};
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Message Queue.
+* @details	Bounded lock-free message queue of one module (MPSC ring buffer, or SPSC ring buffer when queue has single
+*				producer). Consumer polls it or blocks until messages arrive - producers lock and notify only when consumer
+*				waits.
+* @note		Only one thread receives messages (owner module).
+******************************************************************************************************/
+class MsvMessageQueue
+{
+public:
+	/**************************************************************************************************//**
+	* @brief			Constructor.
+	* @param[in]	capacity				Capacity (rounded up to power of two).
+	* @param[in]	singleProducer		Flag if only one thread sends messages (true) or more threads (false).
+	******************************************************************************************************/
+	MsvMessageQueue(size_t capacity, bool singleProducer);
+
+	/**************************************************************************************************//**
+	* @brief		Virtual destructor.
+	******************************************************************************************************/
+	virtual ~MsvMessageQueue();
+
+	MsvMessageQueue(const MsvMessageQueue&) = delete;
+	MsvMessageQueue& operator=(const MsvMessageQueue&) = delete;
+
+	/**************************************************************************************************//**
+	* @brief			Send message.
+	* @param[in]	message								Message.
+	* @retval		MSV_NOT_INITIALIZED_ERROR		When queue has been closed.
+	* @retval		MSV_ALLOCATION_ERROR				When queue is full.
+	* @retval		MSV_SUCCESS							On success.
+	******************************************************************************************************/
+	virtual MsvErrorCode Send(const MsvMessage& message);
+
+	/**************************************************************************************************//**
+	* @brief			Send messages.
+	* @details		Sends as many messages as fit (they are published at once).
+	* @param[in]	pMessages							Messages.
+	* @param[in]	count									Number of messages.
+	* @param[out]	sentCount							Number of sent messages.
+	* @retval		MSV_NOT_INITIALIZED_ERROR		When queue has been closed.
+	* @retval		MSV_ALLOCATION_ERROR				When queue is full (no message has been sent).
+	* @retval		MSV_SUCCESS							On success (at least one message has been sent).
+	******************************************************************************************************/
+	virtual MsvErrorCode SendBatch(const MsvMessage* pMessages, size_t count, size_t& sentCount);
+
+	/**************************************************************************************************//**
+	* @brief			Receive messages.
+	* @details		Receives up to maxCount messages without blocking (polling consumer). Nothing is received while
+	*					queue is being closed.
+	* @param[out]	pMessages							Received messages.
+	* @param[in]	maxCount								Maximal number of messages.
+	* @returns		size_t (number of received messages)
+	******************************************************************************************************/
+	virtual size_t Receive(MsvMessage* pMessages, size_t maxCount);
+
+	/**************************************************************************************************//**
+	* @brief			Wait for messages.
+	* @details		Receives up to maxCount messages, blocks until at least one message arrives, queue is closed or
+	*					timeout expires (blocking consumer).
+	* @param[out]	pMessages							Received messages.
+	* @param[in]	maxCount								Maximal number of messages.
+	* @param[in]	timeout								Timeout (milliseconds::max() waits without timeout).
+	* @returns		size_t (number of received messages, 0 when timeout expired or queue has been closed)
+	******************************************************************************************************/
+	virtual size_t WaitReceive(MsvMessage* pMessages, size_t maxCount, std::chrono::milliseconds timeout);
+
+	/**************************************************************************************************//**
+	* @brief		Close queue.
+	* @details	Rejects new messages, releases queued messages and wakes waiting consumer. It waits until consumer finishes
+	*				current receive (queue has single consumer).
+	******************************************************************************************************/
+	virtual void Close();
+
+	/**************************************************************************************************//**
+	* @brief		Open queue.
+	* @details	Accepts messages again after queue has been closed (senders holding queue can send to it again).
+	******************************************************************************************************/
+	virtual void Open();
+
+	/**************************************************************************************************//**
+	* @brief		Get closed flag.
+	* @retval	true		When queue has been closed.
+	* @retval	false		When queue is open.
+	******************************************************************************************************/
+	virtual bool Closed() const;
+
+	/**************************************************************************************************//**
+	* @brief		Get capacity.
+	* @returns	size_t
+	******************************************************************************************************/
+	virtual size_t GetCapacity() const;
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Wake consumer.
+	* @details	Notifies consumer when it waits (producers do not lock otherwise).
+	******************************************************************************************************/
+	void WakeConsumer();
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		MPSC ring buffer (nullptr when queue has single producer).
+	******************************************************************************************************/
+	std::unique_ptr<MsvMpscRingBuffer<MsvMessage>> m_spMpscRingBuffer;
+
+	/**************************************************************************************************//**
+	* @brief		SPSC ring buffer (nullptr when queue has more producers).
+	******************************************************************************************************/
+	std::unique_ptr<MsvSpscRingBuffer<MsvMessage>> m_spSpscRingBuffer;
+
+	/**************************************************************************************************//**
+	* @brief		Closed flag.
+	******************************************************************************************************/
+	std::atomic<bool> m_closed;
+
+	/**************************************************************************************************//**
+	* @brief		Waiting flag.
+	* @details	Flag if consumer waits for messages.
+	******************************************************************************************************/
+	std::atomic<bool> m_waiting;
+
+	/**************************************************************************************************//**
+	* @brief		Receiving flag.
+	* @details	Flag if ring buffer is being popped (owner module receives messages or queue is being closed).
+	******************************************************************************************************/
+	std::atomic<bool> m_receiving;
+
+	/**************************************************************************************************//**
+	* @brief		Wait mutex.
+	* @details	Used only when consumer waits.
+	******************************************************************************************************/
+	std::mutex m_waitLock;
+
+	/**************************************************************************************************//**
+	* @brief		Wait condition variable.
+	******************************************************************************************************/
+	std::condition_variable m_waitCondition;
+};
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Message Bus.
+* @details	Message queues addressed by module ID. Module manager creates queue when module is registered, closes it
+*				when module stops and opens the same queue again when module starts. Senders on hot paths should get queue
+*				once (@ref GetQueue) and send to it directly - sending by module ID looks queue up under shared lock.
+******************************************************************************************************/
+class MsvMessageBus
+{
+public:
+	/**************************************************************************************************//**
+	* @brief		Constructor.
+	******************************************************************************************************/
+	MsvMessageBus();
+
+	/**************************************************************************************************//**
+	* @brief		Virtual destructor.
+	******************************************************************************************************/
+	virtual ~MsvMessageBus();
+
+	MsvMessageBus(const MsvMessageBus&) = delete;
+	MsvMessageBus& operator=(const MsvMessageBus&) = delete;
+
+	/**************************************************************************************************//**
+	* @brief			Set queue options.
+	* @details		Sets options of queue of module (used when queue is created - set them before module is registered).
+	* @param[in]	moduleId								Module ID.
+	* @param[in]	capacity								Queue capacity (rounded up to power of two).
+	* @param[in]	singleProducer						Flag if only one thread sends messages to module.
+	* @retval		MSV_INVALID_DATA_ERROR			When capacity is zero.
+	* @retval		MSV_SUCCESS							On success.
+	******************************************************************************************************/
+	virtual MsvErrorCode SetQueueOptions(int32_t moduleId, size_t capacity, bool singleProducer);
+
+	/**************************************************************************************************//**
+	* @brief			Create queue.
+	* @details		Creates queue of module (by its queue options).
+	* @param[in]	moduleId								Module ID.
+	* @retval		MSV_ALREADY_EXISTS_ERROR		When module has open queue.
+	* @retval		MSV_SUCCESS							On success.
+	******************************************************************************************************/
+	virtual MsvErrorCode CreateQueue(int32_t moduleId);
+
+	/**************************************************************************************************//**
+	* @brief			Remove queue.
+	* @details		Closes queue of module (queued messages are released, senders holding queue get error) and removes
+	*					it from bus.
+	* @param[in]	moduleId								Module ID.
+	* @retval		MSV_NOT_FOUND_ERROR				When module does not have queue.
+	* @retval		MSV_SUCCESS							On success.
+	******************************************************************************************************/
+	virtual MsvErrorCode RemoveQueue(int32_t moduleId);
+
+	/**************************************************************************************************//**
+	* @brief			Close queue.
+	* @details		Closes queue of module (queued messages are released, senders get error) and keeps it in bus.
+	* @param[in]	moduleId								Module ID.
+	* @retval		MSV_NOT_FOUND_ERROR				When module does not have queue.
+	* @retval		MSV_SUCCESS							On success.
+	* @see			OpenQueue
+	******************************************************************************************************/
+	virtual MsvErrorCode CloseQueue(int32_t moduleId);
+
+	/**************************************************************************************************//**
+	* @brief			Open queue.
+	* @details		Opens closed queue of module again (senders holding queue can send to it again).
+	* @param[in]	moduleId								Module ID.
+	* @retval		MSV_NOT_FOUND_ERROR				When module does not have queue.
+	* @retval		MSV_SUCCESS							On success.
+	* @see			CloseQueue
+	******************************************************************************************************/
+	virtual MsvErrorCode OpenQueue(int32_t moduleId);
+
+	/**************************************************************************************************//**
+	* @brief			Get queue.
+	* @details		Returns queue of module (keep it and send to it directly on hot paths).
+	* @param[in]	moduleId								Module ID.
+	* @param[out]	spQueue								Shared pointer to queue.
+	* @retval		MSV_NOT_FOUND_ERROR				When module does not have queue.
+	* @retval		MSV_SUCCESS							On success.
+	******************************************************************************************************/
+	virtual MsvErrorCode GetQueue(int32_t moduleId, std::shared_ptr<MsvMessageQueue>& spQueue) const;
+
+	/**************************************************************************************************//**
+	* @brief			Send message.
+	* @param[in]	moduleId								Receiver module ID.
+	* @param[in]	message								Message.
+	* @retval		MSV_NOT_FOUND_ERROR				When module does not have queue.
+	* @retval		other_error_code					When @ref MsvMessageQueue::Send failed.
+	* @retval		MSV_SUCCESS							On success.
+	******************************************************************************************************/
+	virtual MsvErrorCode Send(int32_t moduleId, const MsvMessage& message);
+
+	/**************************************************************************************************//**
+	* @brief			Send messages.
+	* @param[in]	moduleId								Receiver module ID.
+	* @param[in]	pMessages							Messages.
+	* @param[in]	count									Number of messages.
+	* @param[out]	sentCount							Number of sent messages.
+	* @retval		MSV_NOT_FOUND_ERROR				When module does not have queue.
+	* @retval		other_error_code					When @ref MsvMessageQueue::SendBatch failed.
+	* @retval		MSV_SUCCESS							On success.
+	******************************************************************************************************/
+	virtual MsvErrorCode SendBatch(int32_t moduleId, const MsvMessage* pMessages, size_t count, size_t& sentCount);
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Message bus mutex.
+	* @details	Locks queue map (shared for lookups).
+	******************************************************************************************************/
+	mutable MsvSharedLockPolicy::Mutex m_lock;
+
+	/**************************************************************************************************//**
+	* @brief		Queues.
+	* @details	Queues of modules (module ID -> queue).
+	******************************************************************************************************/
+	std::unordered_map<int32_t, std::shared_ptr<MsvMessageQueue>> m_queues;
+
+	/**************************************************************************************************//**
+	* @brief		Queue options.
+	* @details	Capacity and single producer flag of queues (module ID -> options).
+	******************************************************************************************************/
+	std::unordered_map<int32_t, std::pair<size_t, bool>> m_queueOptions;
+};
+
+
+#endif // !MARSTECH_MESSAGEBUS_H
+
+/** @} */	//End of group MMODULE.
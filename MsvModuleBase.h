@@ -36,33 +36,56 @@ along with Foobar. If not, see <https://www.gnu.org/licenses/>.
 
 
 #include "IMsvModule.h"
+#include "IMsvArenaConsumer.h"
+#include "IMsvLifecycleObserver.h"
+#include "IMsvMessageBusConsumer.h"
+#include "IMsvModuleHeartbeat.h"
+#include "IMsvModuleReadiness.h"
+#include "IMsvServiceRegistryConsumer.h"
+#include "IMsvThreadFactory.h"
+#include "IMsvThreadPool.h"
+#include "MsvLockPolicy.h"
+#include "MsvWaitableState.h"
 #include "mlogging/mlogging.h"
 
-MSV_DISABLE_ALL_WARNINGS
-
-#include <mutex>
-
-MSV_ENABLE_WARNINGS
-
 
 /**************************************************************************************************//**
 * @brief		MarsTech Module Base.
-* @details	Dll module base which implements  @ref Initialized and @ref Running.
+* @details	Dll module base which implements  @ref SetThreadPool, @ref SetThreadFactory, @ref SetArena, @ref SetMessageBus, @ref SetServiceRegistry, @ref Initialized, @ref Running, @ref WaitForState, @ref Ready and @ref WaitForReady.
 *				You can inherit from it or implement your own methods in your IMsvModule implementation.
+*				Module state is locked by lock policy (see MsvLockPolicy.h), @ref MsvModuleBase uses recursive mutex.
+* @tparam		LockPolicy		Lock policy (type of @ref m_lock and its read and write locks).
 * @note		This iplementation is in header file only -> it should be possible to include this header
 *				file to your project without linking this library.
 ******************************************************************************************************/
-class MsvModuleBase:
-	public IMsvModule
+template<class LockPolicy>
+class MsvModuleBaseT:
+	public IMsvModule,
+	public IMsvThreadPoolConsumer,
+	public IMsvThreadFactoryConsumer,
+	public IMsvArenaConsumer,
+	public IMsvMessageBusConsumer,
+	public IMsvServiceRegistryConsumer,
+	public IMsvModuleReadiness,
+	public IMsvModuleHeartbeat
 {
 public:
+	/**************************************************************************************************//**
+	* @brief		Lock policy type.
+	******************************************************************************************************/
+	typedef LockPolicy LockPolicyType;
+
 	/**************************************************************************************************//**
 	* @brief		Constructor.
 	******************************************************************************************************/
-	MsvModuleBase(std::shared_ptr<IMsvLoggerProvider> spLoggerProvider, const char* loggerName):
+	MsvModuleBaseT(std::shared_ptr<IMsvLoggerProvider> spLoggerProvider, const char* loggerName):
 		m_initialized(false),
 		m_running(false),
-		m_spLogger(spLoggerProvider->GetLogger(loggerName))
+		m_asyncReadiness(false),
+		m_readyRequested(false),
+		m_heartbeat(0),
+		m_spLogger(spLoggerProvider->GetLogger(loggerName)),
+		m_moduleId(0)
 	{
 		
 	}
@@ -70,7 +93,7 @@ public:
 	/**************************************************************************************************//**
 	* @brief		Virtual destructor.
 	******************************************************************************************************/
-	virtual ~MsvModuleBase() {}
+	virtual ~MsvModuleBaseT() {}
 
 	/*-----------------------------------------------------------------------------------------------------
 	**											IMsvModule public methods
@@ -81,7 +104,7 @@ public:
 	******************************************************************************************************/
 	virtual bool Initialized() const override
 	{
-		std::lock_guard<std::recursive_mutex> lock(m_lock);
+		typename LockPolicy::ReadLock lock(m_lock);
 
 		return m_initialized;
 	}
@@ -91,17 +114,205 @@ public:
 	******************************************************************************************************/
 	virtual bool Running() const override
 	{
-		std::lock_guard<std::recursive_mutex> lock(m_lock);
+		typename LockPolicy::ReadLock lock(m_lock);
 
 		return m_running;
 	}
 
+	/*-----------------------------------------------------------------------------------------------------
+	**											MsvModuleBaseT public methods
+	**---------------------------------------------------------------------------------------------------*/
+public:
+	/**************************************************************************************************//**
+	* @brief			Wait for state.
+	* @details		Blocks until module is in requested state or timeout expires. Waiter does not lock module and it
+	*					does not poll - it is woken when module state changes.
+	* @param[in]	state					Requested state.
+	* @param[in]	timeout				Timeout.
+	* @retval		true					When module is in requested state.
+	* @retval		false					When timeout expired.
+	******************************************************************************************************/
+	virtual bool WaitForState(MsvModuleState state, std::chrono::milliseconds timeout) const
+	{
+		return m_state.WaitFor(static_cast<int32_t>(state), MSV_MODULE_STATE_MASK, timeout);
+	}
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Notify state changed.
+	* @details	Publishes state given by @ref m_initialized and @ref m_running to @ref WaitForState waiters. It must be
+	*				called (with module locked) whenever the flags are changed. Running module is ready immediately unless
+	*				@ref m_asyncReadiness is set (then it is ready since @ref SetReady is called).
+	******************************************************************************************************/
+	void NotifyStateChanged()
+	{
+		if (m_running)
+		{
+			const int32_t running = static_cast<int32_t>(MsvModuleState::MSV_MODULE_STATE_RUNNING);
+			m_state.Store(m_asyncReadiness ? running : (running | MSV_MODULE_READY_FLAG));
+
+			//module could signal readiness before it has been marked as running
+			if (m_asyncReadiness && m_readyRequested.load(std::memory_order_seq_cst))
+			{
+				m_state.CompareExchange(running, running | MSV_MODULE_READY_FLAG);
+			}
+
+			return;
+		}
+
+		m_readyRequested.store(false, std::memory_order_seq_cst);
+		MsvModuleState state = m_initialized ? MsvModuleState::MSV_MODULE_STATE_INITIALIZED : MsvModuleState::MSV_MODULE_STATE_UNINITIALIZED;
+		m_state.Store(static_cast<int32_t>(state));
+	}
+
+	/**************************************************************************************************//**
+	* @brief		Set ready.
+	* @details	Marks running module with @ref m_asyncReadiness set as ready and wakes @ref WaitForReady waiters. It does
+	*				not lock module - it can be called from any module thread (even during start). It must not be called
+	*				after module has been stopped.
+	******************************************************************************************************/
+	void SetReady()
+	{
+		const int32_t running = static_cast<int32_t>(MsvModuleState::MSV_MODULE_STATE_RUNNING);
+
+		m_readyRequested.store(true, std::memory_order_seq_cst);
+		m_state.CompareExchange(running, running | MSV_MODULE_READY_FLAG);
+	}
+
+	/**************************************************************************************************//**
+	* @brief		Heartbeat.
+	* @details	Reports that running module makes progress (increases @ref m_heartbeat). It does not lock module - call
+	*				it from module threads (e.g. every processed item) when module is supervised by watchdog with heartbeat
+	*				timeout.
+	******************************************************************************************************/
+	void Heartbeat()
+	{
+		m_heartbeat.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	/*-----------------------------------------------------------------------------------------------------
+	**											IMsvModuleReadiness public methods
+	**---------------------------------------------------------------------------------------------------*/
+public:
+	/**************************************************************************************************//**
+	* @copydoc IMsvModuleReadiness::Ready() const
+	* @note		Module without @ref m_asyncReadiness is ready when it is running (also module which sets
+	*				@ref m_running without @ref NotifyStateChanged).
+	******************************************************************************************************/
+	virtual bool Ready() const override
+	{
+		if ((m_state.Load() & MSV_MODULE_READY_FLAG) != 0)
+		{
+			return true;
+		}
+
+		return !m_asyncReadiness && Running();
+	}
+
+	/**************************************************************************************************//**
+	* @copydoc IMsvModuleReadiness::WaitForReady(std::chrono::milliseconds timeout) const
+	* @note		Module without @ref m_asyncReadiness which is running is ready immediately (also module which sets
+	*				@ref m_running without @ref NotifyStateChanged).
+	******************************************************************************************************/
+	virtual bool WaitForReady(std::chrono::milliseconds timeout) const override
+	{
+		if (!m_asyncReadiness && Running())
+		{
+			return true;
+		}
+
+		return m_state.WaitFor(static_cast<int32_t>(MsvModuleState::MSV_MODULE_STATE_RUNNING) | MSV_MODULE_READY_FLAG, timeout);
+	}
+
+	/*-----------------------------------------------------------------------------------------------------
+	**											IMsvModuleHeartbeat public methods
+	**---------------------------------------------------------------------------------------------------*/
+public:
+	/**************************************************************************************************//**
+	* @copydoc IMsvModuleHeartbeat::GetHeartbeat() const
+	******************************************************************************************************/
+	virtual uint64_t GetHeartbeat() const override
+	{
+		return m_heartbeat.load(std::memory_order_relaxed);
+	}
+
+	/*-----------------------------------------------------------------------------------------------------
+	**											IMsvThreadPoolConsumer public methods
+	**---------------------------------------------------------------------------------------------------*/
+public:
+	/**************************************************************************************************//**
+	* @copydoc IMsvThreadPoolConsumer::SetThreadPool(std::shared_ptr<IMsvThreadPool> spThreadPool)
+	******************************************************************************************************/
+	virtual void SetThreadPool(std::shared_ptr<IMsvThreadPool> spThreadPool) override
+	{
+		typename LockPolicy::WriteLock lock(m_lock);
+
+		m_spThreadPool = spThreadPool;
+	}
+
+	/*-----------------------------------------------------------------------------------------------------
+	**											IMsvThreadFactoryConsumer public methods
+	**---------------------------------------------------------------------------------------------------*/
+public:
+	/**************************************************************************************************//**
+	* @copydoc IMsvThreadFactoryConsumer::SetThreadFactory(std::shared_ptr<IMsvThreadFactory> spThreadFactory)
+	******************************************************************************************************/
+	virtual void SetThreadFactory(std::shared_ptr<IMsvThreadFactory> spThreadFactory) override
+	{
+		typename LockPolicy::WriteLock lock(m_lock);
+
+		m_spThreadFactory = spThreadFactory;
+	}
+
+	/*-----------------------------------------------------------------------------------------------------
+	**											IMsvArenaConsumer public methods
+	**---------------------------------------------------------------------------------------------------*/
+public:
+	/**************************************************************************************************//**
+	* @copydoc IMsvArenaConsumer::SetArena(std::shared_ptr<MsvArena> spArena)
+	******************************************************************************************************/
+	virtual void SetArena(std::shared_ptr<MsvArena> spArena) override
+	{
+		typename LockPolicy::WriteLock lock(m_lock);
+
+		m_spArena = spArena;
+	}
+
+	/*-----------------------------------------------------------------------------------------------------
+	**											IMsvMessageBusConsumer public methods
+	**---------------------------------------------------------------------------------------------------*/
+public:
+	/**************************************************************************************************//**
+	* @copydoc IMsvMessageBusConsumer::SetMessageBus(std::shared_ptr<MsvMessageBus> spMessageBus)
+	******************************************************************************************************/
+	virtual void SetMessageBus(std::shared_ptr<MsvMessageBus> spMessageBus) override
+	{
+		typename LockPolicy::WriteLock lock(m_lock);
+
+		m_spMessageBus = spMessageBus;
+	}
+
+	/*-----------------------------------------------------------------------------------------------------
+	**											IMsvServiceRegistryConsumer public methods
+	**---------------------------------------------------------------------------------------------------*/
+public:
+	/**************************************************************************************************//**
+	* @copydoc IMsvServiceRegistryConsumer::SetServiceRegistry(std::shared_ptr<MsvServiceRegistry> spServiceRegistry, int32_t moduleId)
+	******************************************************************************************************/
+	virtual void SetServiceRegistry(std::shared_ptr<MsvServiceRegistry> spServiceRegistry, int32_t moduleId) override
+	{
+		typename LockPolicy::WriteLock lock(m_lock);
+
+		m_spServiceRegistry = spServiceRegistry;
+		m_moduleId = moduleId;
+	}
+
 protected:
 	/**************************************************************************************************//**
 	* @brief		Module mutex.
 	* @details	Locks this object for thread safety access.
 	******************************************************************************************************/
-	mutable std::recursive_mutex m_lock;
+	mutable typename LockPolicy::Mutex m_lock;
 
 	/**************************************************************************************************//**
 	* @brief		Initialize flag.
@@ -121,14 +332,92 @@ protected:
 	******************************************************************************************************/
 	bool m_running;
 
+	/**************************************************************************************************//**
+	* @brief		Module state.
+	* @details	State given by @ref m_initialized and @ref m_running (@ref MsvModuleState, masked by
+	*				@ref MSV_MODULE_STATE_MASK) and @ref MSV_MODULE_READY_FLAG - waiters wait on it.
+	* @see		WaitForState
+	* @see		WaitForReady
+	* @see		NotifyStateChanged
+	******************************************************************************************************/
+	MsvWaitableState m_state;
+
+	/**************************************************************************************************//**
+	* @brief		Asynchronous readiness flag.
+	* @details	Flag if module signals readiness by @ref SetReady (true) or it is ready when it is running (false).
+	*				Set it in constructor of module which warms up after start.
+	******************************************************************************************************/
+	bool m_asyncReadiness;
+
+	/**************************************************************************************************//**
+	* @brief		Ready requested flag.
+	* @details	Flag if @ref SetReady has been called since module has been stopped (true) or not (false).
+	******************************************************************************************************/
+	std::atomic<bool> m_readyRequested;
+
+	/**************************************************************************************************//**
+	* @brief		Heartbeat counter.
+	* @see		Heartbeat
+	******************************************************************************************************/
+	std::atomic<uint64_t> m_heartbeat;
+
 	/**************************************************************************************************//**
 	* @brief		Logger.
 	* @details	Shared pointer to logger for logging.
 	******************************************************************************************************/
 	std::shared_ptr<MsvLogger> m_spLogger;
+
+	/**************************************************************************************************//**
+	* @brief		Thread pool.
+	* @details	Thread pool of module manager (set before module is initialized, empty when module is not
+	*				managed by module manager). Use it instead of own threads.
+	******************************************************************************************************/
+	std::shared_ptr<IMsvThreadPool> m_spThreadPool;
+
+	/**************************************************************************************************//**
+	* @brief		Thread factory.
+	* @details	Creates module threads with module placement (set before module is initialized, empty when module is
+	*				not managed by module manager).
+	******************************************************************************************************/
+	std::shared_ptr<IMsvThreadFactory> m_spThreadFactory;
+
+	/**************************************************************************************************//**
+	* @brief		Arena.
+	* @details	Memory arena of module (set before module is initialized, empty when module is not managed by module
+	*				manager). Allocate module memory from it (e.g. by @ref MsvArenaAllocator) so it is accounted to module.
+	*				Release all objects allocated from it in Uninitialize.
+	******************************************************************************************************/
+	std::shared_ptr<MsvArena> m_spArena;
+
+	/**************************************************************************************************//**
+	* @brief		Message bus.
+	* @details	Message bus of module manager (set before module is initialized, empty when module is not managed by
+	*				module manager). Queue of module is available since it is registered until it stops.
+	******************************************************************************************************/
+	std::shared_ptr<MsvMessageBus> m_spMessageBus;
+
+	/**************************************************************************************************//**
+	* @brief		Service registry.
+	* @details	Service registry of module manager (set before module is initialized, empty when module is not managed by
+	*				module manager). Module publishes its services as @ref m_moduleId during initialize or start.
+	******************************************************************************************************/
+	std::shared_ptr<MsvServiceRegistry> m_spServiceRegistry;
+
+	/**************************************************************************************************//**
+	* @brief		Module ID.
+	* @details	ID of module in module manager (set with service registry).
+	******************************************************************************************************/
+	int32_t m_moduleId;
 };
 
 
+/**************************************************************************************************//**
+* @brief		MarsTech Module Base.
+* @details	Module base with recursive mutex (module methods can call each other).
+******************************************************************************************************/
+typedef MsvModuleBaseT<MsvRecursiveLockPolicy> MsvModuleBase;
+
+
 #endif // !MARSTECH_MODULEBASE_H
 
 /** @} */	//End of group MMODULE.
@@ -0,0 +1,227 @@
+/**************************************************************************************************//**
+* @addtogroup	MMODULE
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Module Lifecycle
+* @details		Contains definition of @ref MsvModuleLifecycle (CRTP implementation of module lifecycle).
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+* @note			This iplementation is in header file only -> it should be possible to include this header
+*					file to your project without linking this library.
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Module Library.
+
+MarsTech Dependency Injection is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef MARSTECH_MODULELIFECYCLE_H
+#define MARSTECH_MODULELIFECYCLE_H
+
+
+#include "MsvDllModuleBase.h"
+#include "MsvModuleBase.h"
+
+#include "merror/MsvErrorCodes.h"
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Module Lifecycle.
+* @details	Implements Initialize, Uninitialize, Start and Stop (state checks, locking and state flags) and calls
+*				non-virtual hooks OnInitialize, OnUninitialize, OnStart and OnStop of derived class (hooks are
+*				inlined). Derived class hides hooks it needs (default hooks just succeed).
+* @tparam		Derived		Derived module class (CRTP).
+* @tparam		Base			Module base (@ref MsvModuleBaseT or @ref MsvDllModuleBaseT with any lock policy).
+* @note		Hooks are called with module lock owned. With non-recursive lock policies hooks must not call
+*				Initialized or Running (they can read m_initialized and m_running directly). When hooks are not
+*				public, derived class has to be friend of MsvModuleLifecycle.
+*
+* @code
+* class MyModule:
+*	public MsvModuleLifecycle<MyModule, MsvModuleBaseT<MsvSpinLockPolicy>>
+* {
+* public:
+*	MyModule(std::shared_ptr<IMsvLoggerProvider> spLoggerProvider):
+*		MsvModuleLifecycle(spLoggerProvider, "MyModule") {}
+*
+*	MsvErrorCode OnStart() { return StartWorker(); }
+* };
+* @endcode
+******************************************************************************************************/
+template<class Derived, class Base>
+class MsvModuleLifecycle:
+	public Base
+{
+public:
+	/**************************************************************************************************//**
+	* @brief		Constructors.
+	* @details	Constructors of module base.
+	******************************************************************************************************/
+	using Base::Base;
+
+	/**************************************************************************************************//**
+	* @brief		Virtual destructor.
+	******************************************************************************************************/
+	virtual ~MsvModuleLifecycle() {}
+
+	/*-----------------------------------------------------------------------------------------------------
+	**											IMsvModule public methods
+	**---------------------------------------------------------------------------------------------------*/
+public:
+	/**************************************************************************************************//**
+	* @brief			Initialize module.
+	* @details		Calls OnInitialize of derived class when module is not initialized.
+	* @retval		MSV_ALREADY_INITIALIZED_INFO		When module has been already initialized.
+	* @retval		other_error_code						When OnInitialize failed.
+	* @retval		MSV_SUCCESS								On success.
+	******************************************************************************************************/
+	virtual MsvErrorCode Initialize() override final
+	{
+		typename Base::LockPolicyType::WriteLock lock(this->m_lock);
+
+		if (this->m_initialized)
+		{
+			return MSV_ALREADY_INITIALIZED_INFO;
+		}
+
+		MSV_RETURN_FAILED(static_cast<Derived*>(this)->OnInitialize());
+		this->m_initialized = true;
+		this->NotifyStateChanged();
+
+		return MSV_SUCCESS;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Uninitialize module.
+	* @details		Calls OnUninitialize of derived class when module is initialized and it is not running.
+	*					Module is uninitialized even when OnUninitialize failed.
+	* @retval		MSV_NOT_INITIALIZED_INFO			When module has not been initialized.
+	* @retval		MSV_STILL_RUNNING_ERROR				When module is running.
+	* @retval		other_error_code						When OnUninitialize failed.
+	* @retval		MSV_SUCCESS								On success.
+	******************************************************************************************************/
+	virtual MsvErrorCode Uninitialize() override final
+	{
+		typename Base::LockPolicyType::WriteLock lock(this->m_lock);
+
+		if (!this->m_initialized)
+		{
+			return MSV_NOT_INITIALIZED_INFO;
+		}
+
+		if (this->m_running)
+		{
+			return MSV_STILL_RUNNING_ERROR;
+		}
+
+		MsvErrorCode errorCode = static_cast<Derived*>(this)->OnUninitialize();
+		this->m_initialized = false;
+		this->NotifyStateChanged();
+
+		return errorCode;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Start module.
+	* @details		Calls OnStart of derived class when module is initialized and it is not running.
+	* @retval		MSV_NOT_INITIALIZED_ERROR			When module has not been initialized.
+	* @retval		MSV_ALREADY_RUNNING_INFO			When module is already running.
+	* @retval		other_error_code						When OnStart failed.
+	* @retval		MSV_SUCCESS								On success.
+	******************************************************************************************************/
+	virtual MsvErrorCode Start() override final
+	{
+		typename Base::LockPolicyType::WriteLock lock(this->m_lock);
+
+		if (!this->m_initialized)
+		{
+			return MSV_NOT_INITIALIZED_ERROR;
+		}
+
+		if (this->m_running)
+		{
+			return MSV_ALREADY_RUNNING_INFO;
+		}
+
+		MSV_RETURN_FAILED(static_cast<Derived*>(this)->OnStart());
+		this->m_running = true;
+		this->NotifyStateChanged();
+
+		return MSV_SUCCESS;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Stop module.
+	* @details		Calls OnStop of derived class when module is running. Module is stopped even when OnStop failed.
+	* @retval		MSV_NOT_RUNNING_INFO					When module is not running.
+	* @retval		other_error_code						When OnStop failed.
+	* @retval		MSV_SUCCESS								On success.
+	******************************************************************************************************/
+	virtual MsvErrorCode Stop() override final
+	{
+		typename Base::LockPolicyType::WriteLock lock(this->m_lock);
+
+		if (!this->m_running)
+		{
+			return MSV_NOT_RUNNING_INFO;
+		}
+
+		MsvErrorCode errorCode = static_cast<Derived*>(this)->OnStop();
+		this->m_running = false;
+		this->NotifyStateChanged();
+
+		return errorCode;
+	}
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Initialize hook.
+	* @details	Default hook (derived class hides it when it needs it).
+	* @retval	MSV_SUCCESS		Always.
+	******************************************************************************************************/
+	MsvErrorCode OnInitialize() { return MSV_SUCCESS; }
+
+	/**************************************************************************************************//**
+	* @brief		Uninitialize hook.
+	* @details	Default hook (derived class hides it when it needs it).
+	* @retval	MSV_SUCCESS		Always.
+	******************************************************************************************************/
+	MsvErrorCode OnUninitialize() { return MSV_SUCCESS; }
+
+	/**************************************************************************************************//**
+	* @brief		Start hook.
+	* @details	Default hook (derived class hides it when it needs it).
+	* @retval	MSV_SUCCESS		Always.
+	******************************************************************************************************/
+	MsvErrorCode OnStart() { return MSV_SUCCESS; }
+
+	/**************************************************************************************************//**
+	* @brief		Stop hook.
+	* @details	Default hook (derived class hides it when it needs it).
+	* @retval	MSV_SUCCESS		Always.
+	******************************************************************************************************/
+	MsvErrorCode OnStop() { return MSV_SUCCESS; }
+};
+
+
+#endif // !MARSTECH_MODULELIFECYCLE_H
+
+/** @} */	//End of group MMODULE.
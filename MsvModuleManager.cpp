@@ -32,10 +32,22 @@ along with Foobar. If not, see <https://www.gnu.org/licenses/>.
 
 
 #include "MsvModuleManager.h"
+#include "MsvDllModuleAdapter.h"
 
 #include "mlogging/mlogging.h"
 #include "merror/MsvErrorCodes.h"
 
+MSV_DISABLE_ALL_WARNINGS
+
+#include <algorithm>
+#include <chrono>
+#include <future>
+#include <set>
+#include <system_error>
+#include <thread>
+
+MSV_ENABLE_WARNINGS
+
 
 /********************************************************************************************************************************
 *															Constructors and destructors
@@ -44,8 +56,22 @@ along with Foobar. If not, see <https://www.gnu.org/licenses/>.
 
 MsvModuleManager::MsvModuleManager(std::shared_ptr<MsvLogger> spLogger):
 	m_initialized(false),
+	m_spArena(new MsvArena()),
+	m_modules(std::less<int32_t>(), MsvModuleMap::allocator_type(m_spArena)),
 	m_spLogger(spLogger),
-	m_running(false)
+	m_running(false),
+	m_startupPlanConfigVersion(0),
+	m_startPolicy(MsvStartPolicy::MSV_START_POLICY_ALL_OR_NOTHING),
+	m_spModuleTimings(new MsvModuleTimings()),
+	m_spThreadPool(new MsvThreadPool(0, spLogger)),
+	m_readinessTimeout(MSV_READINESS_DEFAULT_TIMEOUT),
+	m_waitingForDependencies(false),
+	m_stoppingThreadPool(false),
+	m_spMessageBus(new MsvMessageBus()),
+	m_spServiceRegistry(new MsvServiceRegistry()),
+	m_spModuleRetry(new MsvModuleRetry([this](int32_t moduleId) { return RetryModule(moduleId); }, spLogger)),
+	m_spWatchdog(new MsvWatchdog([this](int32_t moduleId) { RequestRestart(moduleId); }, spLogger)),
+	m_spLifecycleNotifier(new MsvLifecycleNotifier())
 {
 
 }
@@ -53,7 +79,24 @@ MsvModuleManager::MsvModuleManager(std::shared_ptr<MsvLogger> spLogger):
 
 MsvModuleManager::~MsvModuleManager()
 {
+	//watchdog schedules retries and retry thread locks module manager (they must not run during destruction)
+	m_spWatchdog->Stop();
+	m_spModuleRetry->Stop();
+
 	Stop();
+
+	//stalled modules must finish their stop before they are uninitialized (theirs code can be unloaded)
+	std::map<int32_t, std::pair<std::thread, std::future<MsvErrorCode>>> stalledStops;
+	{
+		MsvLockGuard lock(m_lock, MSV_LOCK_CALL_SITE);
+		stalledStops.swap(m_stalledStops);
+	}
+
+	for (std::map<int32_t, std::pair<std::thread, std::future<MsvErrorCode>>>::iterator it = stalledStops.begin(); it != stalledStops.end(); ++it)
+	{
+		it->second.first.join();
+	}
+
 	Uninitialize();
 }
 
@@ -65,9 +108,11 @@ MsvModuleManager::~MsvModuleManager()
 
 MsvErrorCode MsvModuleManager::Initialize()
 {
-	std::lock_guard<std::recursive_mutex> lock(m_lock);
+	MsvLockGuard lock(m_lock, MSV_LOCK_CALL_SITE);
+	WaitForLifecycle();
 
 	MSV_LOG_INFO(m_spLogger, "Initializing module manager.");
+	MsvTraceScope traceScope(m_spTraceRecorder, "Module manager initialize", "manager");
 
 	if (Initialized())
 	{
@@ -75,12 +120,28 @@ MsvErrorCode MsvModuleManager::Initialize()
 		return MSV_ALREADY_INITIALIZED_INFO;
 	}
 
-	MsvErrorCode errorCode = MSV_SUCCESS;
+	//warm up DLL files (when DLL prefetcher is set)
+	PrefetchDllModules();
+
+	//get startup plan (cached plan of previous run or plan in startup order - it contains exactly registered modules)
+	std::vector<MsvStartupPlanModule> startupPlan;
+	bool cachedPlan = LoadStartupPlan(startupPlan);
+
+	//modules can submit tasks since they are initialized (worker threads are started by the first task)
+	MsvErrorCode errorCode = m_spThreadPool->Start(true);
+	if (MSV_FAILED(errorCode))
+	{
+		MSV_LOG_ERROR(m_spLogger, "Start thread pool failed with error: {0:x}", errorCode);
+		traceScope.SetErrorCode(errorCode);
+		return errorCode;
+	}
 
 	//initialize all modules
-	std::map<int32_t, std::pair<std::shared_ptr<IMsvModuleConfigurator>, std::shared_ptr<IMsvModule>>>::iterator endIt = m_modules.end();
-	for (std::map<int32_t, std::pair<std::shared_ptr<IMsvModuleConfigurator>, std::shared_ptr<IMsvModule>>>::iterator it = m_modules.begin(); it != endIt; ++it)
+	for (std::vector<MsvStartupPlanModule>::iterator planIt = startupPlan.begin(); planIt != startupPlan.end(); ++planIt)
 	{
+		MsvModuleMap::iterator it = m_modules.find(planIt->moduleId);
+
+		//resolve installed and enabled flags (they are always read - cached plan gives only order and durations)
 		bool installed = false;
 		bool enabled = false;
 		if (MSV_FAILED(errorCode = it->second.first->IsInstalled(installed)) || MSV_FAILED(errorCode = it->second.first->IsEnabled(enabled)))
@@ -89,15 +150,57 @@ MsvErrorCode MsvModuleManager::Initialize()
 			MSV_LOG_ERROR(m_spLogger, "Get installed or enabled flag of module {} failed with error: {0:x}", it->first, errorCode);
 			break;
 		}
-		else if (!installed || !enabled)
+
+		if (cachedPlan && (planIt->installed != (installed ? 1 : 0) || planIt->enabled != (enabled ? 1 : 0)))
+		{
+			//flags changed without config version -> cache miss (durations of previous run are dropped)
+			MSV_LOG_INFO(m_spLogger, "Startup plan {} does not match flags of module {} - it is not used.", m_startupPlanPath, it->first);
+			ResetStartupPlanDurations(startupPlan);
+			cachedPlan = false;
+		}
+
+		planIt->installed = installed ? 1 : 0;
+		planIt->enabled = enabled ? 1 : 0;
+		
+		if (!planIt->installed || !planIt->enabled)
 		{
 			//module is not installed or enabled -> do not initialize it -> continue
-			MSV_LOG_INFO(m_spLogger, "Module {} is not installed or enabled (installed: {}, enabled: {}).", it->first, installed, enabled);
+			MSV_LOG_INFO(m_spLogger, "Module {} is not installed or enabled (installed: {}, enabled: {}).", it->first, planIt->installed != 0, planIt->enabled != 0);
+			continue;
+		}
+
+		//dependent of failed module which is retried waits for its recovery (it is brought up by retry)
+		int32_t causeId = 0;
+		if (GetPendingDependency(it->first, causeId))
+		{
+			if (IsModuleCritical(it->first))
+			{
+				//critical module can not run without its dependency -> initialize fails
+				errorCode = MSV_NOT_INITIALIZED_ERROR;
+				MSV_LOG_ERROR(m_spLogger, "Critical module {} can not be initialized without failed module {} - failed with error: {0:x}", it->first, causeId, errorCode);
+				break;
+			}
+
+			MSV_LOG_INFO(m_spLogger, "Module {} waits for recovery of module {}.", it->first, causeId);
+			m_pendingModules[it->first] = causeId;
 			continue;
 		}
 
-		if (MSV_FAILED(errorCode = it->second.second->Initialize()))
+		errorCode = ModuleTransition(it->first, it->second.second, MsvModuleTransition::MSV_MODULE_TRANSITION_INITIALIZE);
+		planIt->initializeDuration = static_cast<uint64_t>(m_spModuleTimings->GetLastDuration(it->first, MsvModuleTransition::MSV_MODULE_TRANSITION_INITIALIZE).count());
+
+		if (MSV_FAILED(errorCode))
 		{
+			if (!IsModuleCritical(it->first))
+			{
+				//non-critical module does not stop others -> retry it in background
+				MSV_LOG_ERROR(m_spLogger, "Initialize non-critical module {} failed with error: {0:x} - it will be retried.", it->first, errorCode);
+				m_pendingModules[it->first] = it->first;
+				m_spModuleRetry->Schedule(it->first);
+				errorCode = MSV_SUCCESS;
+				continue;
+			}
+
 			//initialize module failed
 			MSV_LOG_ERROR(m_spLogger, "Initialize module {} failed with error: {0:x}", it->first, errorCode);
 			break;
@@ -107,13 +210,18 @@ MsvErrorCode MsvModuleManager::Initialize()
 	//check if initialize modules succeeded
 	if (MSV_FAILED(errorCode))
 	{
-		//initialize failed (uninitialize all initialized modules)
-		for (std::map<int32_t, std::pair<std::shared_ptr<IMsvModuleConfigurator>, std::shared_ptr<IMsvModule>>>::iterator it = m_modules.begin(); it != endIt; ++it)
+		//initialize failed (uninitialize all initialized modules in shutdown order)
+		m_spModuleRetry->CancelAll();
+		m_pendingModules.clear();
+		std::vector<int32_t> shutdownOrder;
+		GetShutdownOrder(shutdownOrder);
+		for (std::vector<int32_t>::const_iterator orderIt = shutdownOrder.begin(); orderIt != shutdownOrder.end(); ++orderIt)
 		{
+			MsvModuleMap::iterator it = m_modules.find(*orderIt);
 			if (it->second.second->Initialized())
 			{
 				//module is initialized -> uninitialize it
-				MsvErrorCode uninitializeErrorCode = it->second.second->Uninitialize();
+				MsvErrorCode uninitializeErrorCode = ModuleTransition(it->first, it->second.second, MsvModuleTransition::MSV_MODULE_TRANSITION_UNINITIALIZE);
 				if (MSV_FAILED(uninitializeErrorCode))
 				{
 					//uninitialize module failed -> just log and continue
@@ -122,21 +230,35 @@ MsvErrorCode MsvModuleManager::Initialize()
 			}
 		}
 
+		StopThreadPool();
+
 		//return error code received from initialize method
+		traceScope.SetErrorCode(errorCode);
 		return errorCode;
 	}
 
 	//all modules has been successfully initialized -> set initialized flag
 	m_initialized = true;
 
+	//remember resolved startup plan (durations of start are added in start)
+	m_startupPlan.swap(startupPlan);
+	m_startupPlanIndex.clear();
+	for (size_t index = 0; index < m_startupPlan.size(); ++index)
+	{
+		m_startupPlanIndex[m_startupPlan[index].moduleId] = index;
+	}
+	SaveStartupPlan();
+
 	return errorCode;
 }
 
 MsvErrorCode MsvModuleManager::Uninitialize()
 {
-	std::lock_guard<std::recursive_mutex> lock(m_lock);
+	MsvLockGuard lock(m_lock, MSV_LOCK_CALL_SITE);
+	WaitForLifecycle();
 
 	MSV_LOG_INFO(m_spLogger, "Uninitializing module manager.");
+	MsvTraceScope traceScope(m_spTraceRecorder, "Module manager uninitialize", "manager");
 
 	if (Running())
 	{
@@ -150,15 +272,25 @@ MsvErrorCode MsvModuleManager::Uninitialize()
 		return MSV_NOT_INITIALIZED_INFO;
 	}
 
+	//failed and stalled modules are not retried any more
+	m_spModuleRetry->CancelAll();
+	m_pendingModules.clear();
+	{
+		std::lock_guard<std::mutex> restartLock(m_restartLock);
+		m_restartRequests.clear();
+	}
+
 	MsvErrorCode errorCode = MSV_SUCCESS;
 
-	//initialize all modules
-	std::map<int32_t, std::pair<std::shared_ptr<IMsvModuleConfigurator>, std::shared_ptr<IMsvModule>>>::iterator endIt = m_modules.end();
-	for (std::map<int32_t, std::pair<std::shared_ptr<IMsvModuleConfigurator>, std::shared_ptr<IMsvModule>>>::iterator it = m_modules.begin(); it != endIt; ++it)
+	//uninitialize all modules (dependents before their dependencies)
+	std::vector<int32_t> shutdownOrder;
+	GetShutdownOrder(shutdownOrder);
+	for (std::vector<int32_t>::const_iterator orderIt = shutdownOrder.begin(); orderIt != shutdownOrder.end(); ++orderIt)
 	{
+		MsvModuleMap::iterator it = m_modules.find(*orderIt);
 		if (it->second.second->Initialized())
 		{
-			MsvErrorCode unitializeErrorCode = it->second.second->Uninitialize();
+			MsvErrorCode unitializeErrorCode = ModuleTransition(it->first, it->second.second, MsvModuleTransition::MSV_MODULE_TRANSITION_UNINITIALIZE);
 			if (MSV_FAILED(unitializeErrorCode))
 			{
 				//initialize module failed
@@ -171,27 +303,33 @@ MsvErrorCode MsvModuleManager::Uninitialize()
 	if (MSV_FAILED(errorCode))
 	{
 		//at least one module unitialize failed (it is error code of last failed module)
+		traceScope.SetErrorCode(errorCode);
 		return errorCode;
 	}
 	
 	//all modules has been successfully uninitialized -> set initialized flag
 	m_initialized = false;
 
+	//no module can submit tasks (thread pool is still running when module manager has not been started)
+	StopThreadPool();
+
 	return errorCode;
 }
 
 bool MsvModuleManager::Initialized() const
 {
-	std::lock_guard<std::recursive_mutex> lock(m_lock);
+	MsvLockGuard lock(m_lock, MSV_LOCK_CALL_SITE);
 
 	return m_initialized;
 }
 
 MsvErrorCode MsvModuleManager::Start()
 {
-	std::lock_guard<std::recursive_mutex> lock(m_lock);
+	MsvLockGuard lock(m_lock, MSV_LOCK_CALL_SITE);
+	WaitForLifecycle();
 
 	MSV_LOG_INFO(m_spLogger, "Starting module manager.");
+	MsvTraceScope traceScope(m_spTraceRecorder, "Module manager start", "manager");
 
 	if (!Initialized())
 	{
@@ -205,37 +343,127 @@ MsvErrorCode MsvModuleManager::Start()
 		return MSV_ALREADY_RUNNING_INFO;
 	}
 
-	MsvErrorCode errorCode = MSV_SUCCESS;
+	//thread pool has been stopped by previous stop (worker threads are started by the first task)
+	MsvErrorCode errorCode = m_spThreadPool->Start(true);
+	if (MSV_FAILED(errorCode))
+	{
+		MSV_LOG_ERROR(m_spLogger, "Start thread pool failed with error: {0:x}", errorCode);
+		traceScope.SetErrorCode(errorCode);
+		return errorCode;
+	}
 
-	//start all modules
-	std::map<int32_t, std::pair<std::shared_ptr<IMsvModuleConfigurator>, std::shared_ptr<IMsvModule>>>::iterator endIt = m_modules.end();
-	for (std::map<int32_t, std::pair<std::shared_ptr<IMsvModuleConfigurator>, std::shared_ptr<IMsvModule>>>::iterator it = m_modules.begin(); it != endIt; ++it)
+	//start all modules (dependencies before their dependents)
+	bool degraded = m_startPolicy == MsvStartPolicy::MSV_START_POLICY_DEGRADED;
+	std::unordered_map<int32_t, int32_t> failedModules;
+	m_startResults.clear();
+	std::vector<int32_t> startupOrder;
+	GetStartupOrder(startupOrder);
+	for (std::vector<int32_t>::const_iterator orderIt = startupOrder.begin(); orderIt != startupOrder.end(); ++orderIt)
 	{
+		MsvModuleMap::iterator it = m_modules.find(*orderIt);
+		MsvModuleStartResult result = { it->first, MsvModuleStartStatus::MSV_MODULE_START_STARTED, MSV_SUCCESS, it->first };
+
 		if (!it->second.second->Initialized())
 		{
 			//module is not initialized (probably not installed or not enabled, or failed to intialize) -> can not be started -> continue
 			MSV_LOG_INFO(m_spLogger, "Module {} is not initialized - skipping.", it->first);
+			result.status = MsvModuleStartStatus::MSV_MODULE_START_NOT_INITIALIZED;
+			m_startResults.push_back(result);
+
+			//module which failed to initialize is being retried (or waits for it) -> its dependents can not use it
+			std::map<int32_t, int32_t>::const_iterator pendingIt = m_pendingModules.find(it->first);
+			if (pendingIt != m_pendingModules.end())
+			{
+				m_startResults.back().causeId = pendingIt->second;
+				if (degraded)
+				{
+					failedModules[it->first] = pendingIt->second;
+				}
+			}
+
+			continue;
+		}
+
+		//dependents of failed modules are skipped (failure is passed to transitive dependents)
+		std::map<int32_t, std::vector<int32_t>>::const_iterator dependenciesIt = m_dependencies.find(it->first);
+		if (degraded && dependenciesIt != m_dependencies.end())
+		{
+			for (std::vector<int32_t>::const_iterator dependencyIt = dependenciesIt->second.begin(); dependencyIt != dependenciesIt->second.end(); ++dependencyIt)
+			{
+				std::unordered_map<int32_t, int32_t>::const_iterator failedIt = failedModules.find(*dependencyIt);
+				if (failedIt != failedModules.end())
+				{
+					result.status = MsvModuleStartStatus::MSV_MODULE_START_DEPENDENCY_FAILED;
+					result.causeId = failedIt->second;
+					break;
+				}
+			}
+		}
+
+		if (result.status == MsvModuleStartStatus::MSV_MODULE_START_DEPENDENCY_FAILED)
+		{
+			m_startResults.push_back(result);
+			failedModules[it->first] = result.causeId;
+
+			if (IsModuleCritical(it->first))
+			{
+				//critical module can not run without its dependency -> start fails
+				errorCode = MSV_NOT_INITIALIZED_ERROR;
+				MSV_LOG_ERROR(m_spLogger, "Critical module {} can not be started without failed module {} - failed with error: {0:x}", it->first, result.causeId, errorCode);
+				break;
+			}
+
+			MSV_LOG_INFO(m_spLogger, "Module {} is skipped - module {} failed.", it->first, result.causeId);
 			continue;
 		}
 
-		if (MSV_FAILED(errorCode = it->second.second->Start()))
+		//dependencies have been started -> module can use them when they are ready
+		if (!MSV_FAILED(errorCode = WaitForDependencies(it->first)))
 		{
+			errorCode = ModuleTransition(it->first, it->second.second, MsvModuleTransition::MSV_MODULE_TRANSITION_START);
+			std::unordered_map<int32_t, size_t>::iterator planIt = m_startupPlanIndex.find(it->first);
+			if (planIt != m_startupPlanIndex.end())
+			{
+				m_startupPlan[planIt->second].startDuration = static_cast<uint64_t>(m_spModuleTimings->GetLastDuration(it->first, MsvModuleTransition::MSV_MODULE_TRANSITION_START).count());
+			}
+		}
+
+		if (MSV_FAILED(errorCode))
+		{
+			result.status = MsvModuleStartStatus::MSV_MODULE_START_FAILED;
+			result.errorCode = errorCode;
+			m_startResults.push_back(result);
+
+			if (degraded && !IsModuleCritical(it->first))
+			{
+				//non-critical module does not stop others -> continue without it (and its dependents)
+				MSV_LOG_ERROR(m_spLogger, "Start non-critical module {} failed with error: {0:x} - continuing without it.", it->first, errorCode);
+				failedModules[it->first] = it->first;
+				errorCode = MSV_SUCCESS;
+				continue;
+			}
+
 			//start module failed
 			MSV_LOG_ERROR(m_spLogger, "Start module {} failed with error: {0:x}", it->first, errorCode);
 			break;
 		}
+
+		m_startResults.push_back(result);
 	}
 
 	//check if start modules succeeded
 	if (MSV_FAILED(errorCode))
 	{
-		//start failed (stop all started modules)
-		for (std::map<int32_t, std::pair<std::shared_ptr<IMsvModuleConfigurator>, std::shared_ptr<IMsvModule>>>::iterator it = m_modules.begin(); it != endIt; ++it)
+		//start failed (stop all started modules in shutdown order)
+		std::vector<int32_t> shutdownOrder;
+		GetShutdownOrder(shutdownOrder);
+		for (std::vector<int32_t>::const_iterator orderIt = shutdownOrder.begin(); orderIt != shutdownOrder.end(); ++orderIt)
 		{
+			MsvModuleMap::iterator it = m_modules.find(*orderIt);
 			if (it->second.second->Running())
 			{
 				//module is running -> stop it
-				MsvErrorCode stopErrorCode = it->second.second->Stop();
+				MsvErrorCode stopErrorCode = ModuleTransition(it->first, it->second.second, MsvModuleTransition::MSV_MODULE_TRANSITION_STOP);
 				if (MSV_FAILED(stopErrorCode))
 				{
 					//stop module failed -> just log and continue
@@ -244,21 +472,38 @@ MsvErrorCode MsvModuleManager::Start()
 			}
 		}
 
+		//no module is running -> run queued tasks and stop worker threads
+		StopThreadPool();
+
 		//return error code received from start method
+		traceScope.SetErrorCode(errorCode);
 		return errorCode;
 	}
 
 	//all modules has been successfully started -> set running flag
 	m_running = true;
 
-	return errorCode;
+	if (!failedModules.empty())
+	{
+		MSV_LOG_ERROR(m_spLogger, "Module manager is running degraded - {} modules are not available.", failedModules.size());
+	}
+
+	//update startup plan with start durations
+	SaveStartupPlan();
+
+	//report which modules determine startup time
+	LogCriticalPath();
+
+	return MSV_SUCCESS;
 }
 
 MsvErrorCode MsvModuleManager::Stop()
 {
-	std::lock_guard<std::recursive_mutex> lock(m_lock);
+	MsvLockGuard lock(m_lock, MSV_LOCK_CALL_SITE);
+	WaitForLifecycle();
 
 	MSV_LOG_INFO(m_spLogger, "Stopping module manager.");
+	MsvTraceScope traceScope(m_spTraceRecorder, "Module manager stop", "manager");
 
 	if (!Running())
 	{
@@ -268,13 +513,15 @@ MsvErrorCode MsvModuleManager::Stop()
 
 	MsvErrorCode errorCode = MSV_SUCCESS;
 
-	//stop all modules
-	std::map<int32_t, std::pair<std::shared_ptr<IMsvModuleConfigurator>, std::shared_ptr<IMsvModule>>>::iterator endIt = m_modules.end();
-	for (std::map<int32_t, std::pair<std::shared_ptr<IMsvModuleConfigurator>, std::shared_ptr<IMsvModule>>>::iterator it = m_modules.begin(); it != endIt; ++it)
+	//stop all modules (dependents before their dependencies)
+	std::vector<int32_t> shutdownOrder;
+	GetShutdownOrder(shutdownOrder);
+	for (std::vector<int32_t>::const_iterator orderIt = shutdownOrder.begin(); orderIt != shutdownOrder.end(); ++orderIt)
 	{
+		MsvModuleMap::iterator it = m_modules.find(*orderIt);
 		if (it->second.second->Running())
 		{
-			MsvErrorCode stopErrorCode = it->second.second->Stop();
+			MsvErrorCode stopErrorCode = ModuleTransition(it->first, it->second.second, MsvModuleTransition::MSV_MODULE_TRANSITION_STOP);
 			if (MSV_FAILED(stopErrorCode))
 			{
 				//stop module failed
@@ -287,18 +534,22 @@ MsvErrorCode MsvModuleManager::Stop()
 	if (MSV_FAILED(errorCode))
 	{
 		//at least one module stop failed (it is error code of last failed module)
+		traceScope.SetErrorCode(errorCode);
 		return errorCode;
 	}
 
 	//all modules has been successfully stopped -> set running flag
 	m_running = false;
 
+	//the last module has stopped -> run queued tasks and stop worker threads
+	StopThreadPool();
+
 	return errorCode;
 }
 
 bool MsvModuleManager::Running() const
 {
-	std::lock_guard<std::recursive_mutex> lock(m_lock);
+	MsvLockGuard lock(m_lock, MSV_LOCK_CALL_SITE);
 
 	return m_running;
 }
@@ -311,7 +562,8 @@ bool MsvModuleManager::Running() const
 
 MsvErrorCode MsvModuleManager::AddModule(int32_t moduleId, std::shared_ptr<IMsvModule> spModule, std::shared_ptr<IMsvModuleConfigurator> spModuleConfigurator)
 {
-	std::lock_guard<std::recursive_mutex> lock(m_lock);
+	MsvLockGuard lock(m_lock, MSV_LOCK_CALL_SITE);
+	WaitForLifecycle();
 
 	//check if module and its configurator are valid
 	if (!spModule || !spModuleConfigurator)
@@ -329,7 +581,10 @@ MsvErrorCode MsvModuleManager::AddModule(int32_t moduleId, std::shared_ptr<IMsvM
 		return MSV_ALREADY_EXISTS_ERROR;
 	}
 
-	//moduleId is not in the map -> set module to right state
+	//moduleId is not in the map -> create its message queue (module can use it since initialize)
+	m_spMessageBus->CreateQueue(moduleId);
+
+	//set module to right state
 	MsvErrorCode errorCode = MSV_SUCCESS;
 
 	bool installed = false;
@@ -338,6 +593,7 @@ MsvErrorCode MsvModuleManager::AddModule(int32_t moduleId, std::shared_ptr<IMsvM
 	{
 		//get installed or enabled flag failed -> error
 		MSV_LOG_ERROR(m_spLogger, "Get installed or enabled flag of module {} failed with error: {0:x}", moduleId, errorCode);
+		m_spMessageBus->RemoveQueue(moduleId);
 		return errorCode;
 	}
 	else if (!installed || !enabled)
@@ -353,9 +609,10 @@ MsvErrorCode MsvModuleManager::AddModule(int32_t moduleId, std::shared_ptr<IMsvM
 			//module manager is initialized -> initialize module
 			if (!spModule->Initialized())
 			{				
-				if (MSV_FAILED(errorCode = spModule->Initialize()))
+				if (MSV_FAILED(errorCode = ModuleTransition(moduleId, spModule, MsvModuleTransition::MSV_MODULE_TRANSITION_INITIALIZE)))
 				{
 					MSV_LOG_ERROR(m_spLogger, "Initialize module {} failed with error: {0:x}", moduleId, errorCode);
+					m_spMessageBus->RemoveQueue(moduleId);
 					return errorCode;
 				}
 			}
@@ -370,28 +627,37 @@ MsvErrorCode MsvModuleManager::AddModule(int32_t moduleId, std::shared_ptr<IMsvM
 				//module is not initialized -> can not be started -> error
 				errorCode = MSV_NOT_INITIALIZED_ERROR;
 				MSV_LOG_ERROR(m_spLogger, "Module {} is not initialized - start failed with error: {0:x}", moduleId, errorCode);
+				m_spMessageBus->RemoveQueue(moduleId);
 				return errorCode;
 			}
 
 			if (!spModule->Running())
 			{
-				if (MSV_FAILED(errorCode = spModule->Start()))
+				if (MSV_FAILED(errorCode = WaitForDependencies(moduleId)) || MSV_FAILED(errorCode = ModuleTransition(moduleId, spModule, MsvModuleTransition::MSV_MODULE_TRANSITION_START)))
 				{
 					MSV_LOG_ERROR(m_spLogger, "Start module {} failed with error: {0:x}", moduleId, errorCode);
 
-					MsvErrorCode unitializeErrorCode = spModule->Uninitialize();
+					MsvErrorCode unitializeErrorCode = ModuleTransition(moduleId, spModule, MsvModuleTransition::MSV_MODULE_TRANSITION_UNINITIALIZE);
 					if (MSV_FAILED(unitializeErrorCode))
 					{
 						//initialize module failed
 						MSV_LOG_ERROR(m_spLogger, "Uninitialize module {} failed with error: {0:x}", moduleId, unitializeErrorCode);
 					}
 
+					m_spMessageBus->RemoveQueue(moduleId);
 					return errorCode;
 				}
 			}			
 		}
 	}
 	
+	//DLL modules record nested DLL load events
+	std::shared_ptr<MsvDllModuleAdapter> spDllModuleAdapter = std::dynamic_pointer_cast<MsvDllModuleAdapter>(spModule);
+	if (spDllModuleAdapter && m_spTraceRecorder)
+	{
+		spDllModuleAdapter->SetTraceRecorder(m_spTraceRecorder);
+	}
+
 	//insert module to the mape
 	m_modules[moduleId] = std::pair<std::shared_ptr<IMsvModuleConfigurator>, std::shared_ptr<IMsvModule>>(spModuleConfigurator, spModule);
 	
@@ -399,4 +665,1191 @@ MsvErrorCode MsvModuleManager::AddModule(int32_t moduleId, std::shared_ptr<IMsvM
 }
 
 
+/********************************************************************************************************************************
+*															IMsvModuleReadiness public methods
+********************************************************************************************************************************/
+
+
+bool MsvModuleManager::Ready() const
+{
+	MsvLockGuard lock(m_lock, MSV_LOCK_CALL_SITE);
+
+	if (!m_running)
+	{
+		return false;
+	}
+
+	std::vector<std::shared_ptr<IMsvModuleReadiness>> readiness;
+	GetRunningReadiness(readiness);
+	for (std::vector<std::shared_ptr<IMsvModuleReadiness>>::const_iterator it = readiness.begin(); it != readiness.end(); ++it)
+	{
+		if (!(*it)->Ready())
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool MsvModuleManager::WaitForReady(std::chrono::milliseconds timeout) const
+{
+	std::vector<std::shared_ptr<IMsvModuleReadiness>> readiness;
+
+	{
+		MsvLockGuard lock(m_lock, MSV_LOCK_CALL_SITE);
+
+		if (!m_running)
+		{
+			return false;
+		}
+
+		GetRunningReadiness(readiness);
+	}
+
+	//wait out of lock (every module gets the rest of timeout)
+	std::chrono::steady_clock::time_point deadline = MsvWaitableState::GetDeadline(timeout);
+	for (std::vector<std::shared_ptr<IMsvModuleReadiness>>::const_iterator it = readiness.begin(); it != readiness.end(); ++it)
+	{
+		std::chrono::milliseconds remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+		if (!(*it)->WaitForReady(remaining > std::chrono::milliseconds::zero() ? remaining : std::chrono::milliseconds::zero()))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+
+/********************************************************************************************************************************
+*															MsvModuleManager public methods
+********************************************************************************************************************************/
+
+
+void MsvModuleManager::SetDllPrefetcher(std::shared_ptr<MsvDllPrefetcher> spDllPrefetcher)
+{
+	MsvLockGuard lock(m_lock, MSV_LOCK_CALL_SITE);
+
+	m_spDllPrefetcher = spDllPrefetcher;
+}
+
+
+void MsvModuleManager::SetStartupPlanFile(const char* path, uint64_t configVersion)
+{
+	MsvLockGuard lock(m_lock, MSV_LOCK_CALL_SITE);
+
+	m_startupPlanPath = path ? path : "";
+	m_startupPlanConfigVersion = configVersion;
+}
+
+void MsvModuleManager::GetStartupPlan(std::vector<MsvStartupPlanModule>& startupPlan) const
+{
+	MsvLockGuard lock(m_lock, MSV_LOCK_CALL_SITE);
+
+	startupPlan = m_startupPlan;
+}
+
+std::shared_ptr<const MsvModuleTimings> MsvModuleManager::GetModuleTimings() const
+{
+	//timings has its own lock (no need to lock module manager)
+	return m_spModuleTimings;
+}
+
+MsvErrorCode MsvModuleManager::AddModuleDependency(int32_t moduleId, int32_t dependencyId)
+{
+	MsvLockGuard lock(m_lock, MSV_LOCK_CALL_SITE);
+	WaitForLifecycle();
+
+	if (moduleId == dependencyId)
+	{
+		MSV_LOG_ERROR(m_spLogger, "Module {} can not depend on itself - failed with error: {0:x}", moduleId, MSV_INVALID_DATA_ERROR);
+		return MSV_INVALID_DATA_ERROR;
+	}
+
+	std::vector<int32_t>& dependencies = m_dependencies[moduleId];
+	if (std::find(dependencies.begin(), dependencies.end(), dependencyId) != dependencies.end())
+	{
+		MSV_LOG_ERROR(m_spLogger, "Module {} already depends on module {} - failed with error: {0:x}", moduleId, dependencyId, MSV_ALREADY_EXISTS_ERROR);
+		return MSV_ALREADY_EXISTS_ERROR;
+	}
+
+	//check that dependency does not depend (transitively) on module
+	std::vector<int32_t> pending(1, dependencyId);
+	std::unordered_map<int32_t, bool> visited;
+	while (!pending.empty())
+	{
+		int32_t current = pending.back();
+		pending.pop_back();
+
+		if (current == moduleId)
+		{
+			MSV_LOG_ERROR(m_spLogger, "Dependency of module {} on module {} creates cycle - failed with error: {0:x}", moduleId, dependencyId, MSV_INVALID_DATA_ERROR);
+			return MSV_INVALID_DATA_ERROR;
+		}
+
+		if (visited[current])
+		{
+			continue;
+		}
+		visited[current] = true;
+
+		std::map<int32_t, std::vector<int32_t>>::const_iterator it = m_dependencies.find(current);
+		if (it != m_dependencies.end())
+		{
+			pending.insert(pending.end(), it->second.begin(), it->second.end());
+		}
+	}
+
+	dependencies.push_back(dependencyId);
+
+	return MSV_SUCCESS;
+}
+
+void MsvModuleManager::GetStartupOrder(std::vector<int32_t>& startupOrder) const
+{
+	MsvLockGuard lock(m_lock, MSV_LOCK_CALL_SITE);
+
+	//Kahn's algorithm - module is ready when all its dependencies are ordered (lowest module ID first)
+	std::unordered_map<int32_t, size_t> pendingDependencies;
+	std::unordered_map<int32_t, std::vector<int32_t>> dependents;
+	for (MsvModuleMap::const_iterator it = m_modules.begin(); it != m_modules.end(); ++it)
+	{
+		pendingDependencies[it->first] = 0;
+	}
+	for (std::map<int32_t, std::vector<int32_t>>::const_iterator it = m_dependencies.begin(); it != m_dependencies.end(); ++it)
+	{
+		if (m_modules.find(it->first) == m_modules.end())
+		{
+			continue;
+		}
+
+		for (std::vector<int32_t>::const_iterator dependencyIt = it->second.begin(); dependencyIt != it->second.end(); ++dependencyIt)
+		{
+			if (m_modules.find(*dependencyIt) != m_modules.end())
+			{
+				//dependencies on not registered modules are ignored
+				++pendingDependencies[it->first];
+				dependents[*dependencyIt].push_back(it->first);
+			}
+		}
+	}
+
+	GetTopologicalOrder(pendingDependencies, dependents, startupOrder);
+}
+
+void MsvModuleManager::GetShutdownOrder(std::vector<int32_t>& shutdownOrder) const
+{
+	MsvLockGuard lock(m_lock, MSV_LOCK_CALL_SITE);
+
+	//Kahn's algorithm on reversed dependencies - module is ready when all its dependents are ordered (lowest module ID first)
+	std::unordered_map<int32_t, size_t> pendingDependents;
+	std::unordered_map<int32_t, std::vector<int32_t>> dependencies;
+	for (MsvModuleMap::const_iterator it = m_modules.begin(); it != m_modules.end(); ++it)
+	{
+		pendingDependents[it->first] = 0;
+	}
+	for (std::map<int32_t, std::vector<int32_t>>::const_iterator it = m_dependencies.begin(); it != m_dependencies.end(); ++it)
+	{
+		if (m_modules.find(it->first) == m_modules.end())
+		{
+			continue;
+		}
+
+		for (std::vector<int32_t>::const_iterator dependencyIt = it->second.begin(); dependencyIt != it->second.end(); ++dependencyIt)
+		{
+			if (m_modules.find(*dependencyIt) != m_modules.end())
+			{
+				++pendingDependents[*dependencyIt];
+				dependencies[it->first].push_back(*dependencyIt);
+			}
+		}
+	}
+
+	GetTopologicalOrder(pendingDependents, dependencies, shutdownOrder);
+}
+
+void MsvModuleManager::GetCriticalPath(MsvCriticalPath& criticalPath) const
+{
+	MsvLockGuard lock(m_lock, MSV_LOCK_CALL_SITE);
+
+	//bring-up duration of module is its last initialize and start
+	std::unordered_map<int32_t, std::chrono::nanoseconds> durations;
+	for (MsvModuleMap::const_iterator it = m_modules.begin(); it != m_modules.end(); ++it)
+	{
+		durations[it->first] = m_spModuleTimings->GetLastDuration(it->first, MsvModuleTransition::MSV_MODULE_TRANSITION_INITIALIZE)
+			+ m_spModuleTimings->GetLastDuration(it->first, MsvModuleTransition::MSV_MODULE_TRANSITION_START);
+	}
+
+	std::vector<int32_t> startupOrder;
+	GetStartupOrder(startupOrder);
+
+	//startup order is always valid (dependencies are acyclic)
+	MsvCriticalPathAnalyzer::Analyze(startupOrder, m_dependencies, durations, criticalPath);
+}
+
+std::shared_ptr<MsvArena> MsvModuleManager::GetArena() const
+{
+	//arena has its own lock (no need to lock module manager)
+	return m_spArena;
+}
+
+std::shared_ptr<MsvMessageBus> MsvModuleManager::GetMessageBus() const
+{
+	//message bus has its own lock (no need to lock module manager)
+	return m_spMessageBus;
+}
+
+std::shared_ptr<MsvLifecycleNotifier> MsvModuleManager::GetLifecycleNotifier() const
+{
+	//lifecycle notifier has its own lock (no need to lock module manager)
+	return m_spLifecycleNotifier;
+}
+
+std::shared_ptr<MsvModuleRetry> MsvModuleManager::GetModuleRetry() const
+{
+	//module retry has its own lock (no need to lock module manager)
+	return m_spModuleRetry;
+}
+
+std::shared_ptr<MsvWatchdog> MsvModuleManager::GetWatchdog() const
+{
+	//watchdog has its own lock (no need to lock module manager)
+	return m_spWatchdog;
+}
+
+std::shared_ptr<MsvServiceRegistry> MsvModuleManager::GetServiceRegistry() const
+{
+	//service registry has its own lock (no need to lock module manager)
+	return m_spServiceRegistry;
+}
+
+std::shared_ptr<MsvThreadPool> MsvModuleManager::GetThreadPool() const
+{
+	//thread pool has its own lock (no need to lock module manager)
+	return m_spThreadPool;
+}
+
+MsvErrorCode MsvModuleManager::SetModulePlacement(int32_t moduleId, const MsvModulePlacement& placement)
+{
+	MsvLockGuard lock(m_lock, MSV_LOCK_CALL_SITE);
+
+	if (placement.numaNode < MSV_NUMA_NODE_ANY)
+	{
+		MSV_LOG_ERROR(m_spLogger, "NUMA node {} of module {} is invalid - failed with error: {0:x}", placement.numaNode, moduleId, MSV_INVALID_DATA_ERROR);
+		return MSV_INVALID_DATA_ERROR;
+	}
+
+	m_modulePlacements[moduleId] = placement;
+
+	return MSV_SUCCESS;
+}
+
+MsvErrorCode MsvModuleManager::GetModulePlacement(int32_t moduleId, MsvModulePlacement& placement) const
+{
+	MsvLockGuard lock(m_lock, MSV_LOCK_CALL_SITE);
+
+	std::unordered_map<int32_t, MsvModulePlacement>::const_iterator it = m_modulePlacements.find(moduleId);
+	if (it == m_modulePlacements.end())
+	{
+		return MSV_NOT_FOUND_ERROR;
+	}
+
+	placement = it->second;
+
+	return MSV_SUCCESS;
+}
+
+MsvErrorCode MsvModuleManager::SetModuleArenaOptions(int32_t moduleId, size_t chunkSize, bool hugePages)
+{
+	MsvLockGuard lock(m_lock, MSV_LOCK_CALL_SITE);
+
+	if (chunkSize == 0)
+	{
+		MSV_LOG_ERROR(m_spLogger, "Arena chunk size of module {} is zero - failed with error: {0:x}", moduleId, MSV_INVALID_DATA_ERROR);
+		return MSV_INVALID_DATA_ERROR;
+	}
+
+	m_moduleArenaOptions[moduleId] = std::make_pair(chunkSize, hugePages);
+
+	return MSV_SUCCESS;
+}
+
+void MsvModuleManager::SetModuleCritical(int32_t moduleId, bool critical)
+{
+	MsvLockGuard lock(m_lock, MSV_LOCK_CALL_SITE);
+
+	m_moduleCriticality[moduleId] = critical;
+}
+
+void MsvModuleManager::SetStartPolicy(MsvStartPolicy startPolicy)
+{
+	MsvLockGuard lock(m_lock, MSV_LOCK_CALL_SITE);
+
+	m_startPolicy = startPolicy;
+}
+
+void MsvModuleManager::GetStartResults(std::vector<MsvModuleStartResult>& startResults) const
+{
+	MsvLockGuard lock(m_lock, MSV_LOCK_CALL_SITE);
+
+	startResults = m_startResults;
+}
+
+MsvErrorCode MsvModuleManager::GetModuleMemoryUsage(int32_t moduleId, MsvArenaUsage& usage) const
+{
+	MsvLockGuard lock(m_lock, MSV_LOCK_CALL_SITE);
+
+	std::unordered_map<int32_t, std::shared_ptr<MsvArena>>::const_iterator it = m_moduleArenas.find(moduleId);
+	if (it == m_moduleArenas.end())
+	{
+		return MSV_NOT_FOUND_ERROR;
+	}
+
+	it->second->GetUsage(usage);
+
+	return MSV_SUCCESS;
+}
+
+MsvErrorCode MsvModuleManager::WaitForState(int32_t moduleId, MsvModuleState state, std::chrono::milliseconds timeout, bool& reached)
+{
+	std::shared_ptr<MsvWaitableState> spState;
+
+	{
+		MsvLockGuard lock(m_lock, MSV_LOCK_CALL_SITE);
+
+		if (m_modules.find(moduleId) == m_modules.end())
+		{
+			return MSV_NOT_FOUND_ERROR;
+		}
+
+		std::shared_ptr<MsvWaitableState>& spModuleState = m_moduleStates[moduleId];
+		if (!spModuleState)
+		{
+			spModuleState = std::make_shared<MsvWaitableState>(static_cast<int32_t>(MsvModuleState::MSV_MODULE_STATE_UNINITIALIZED));
+		}
+
+		spState = spModuleState;
+	}
+
+	//wait out of lock (transitions change the state)
+	reached = spState->WaitFor(static_cast<int32_t>(state), timeout);
+
+	return MSV_SUCCESS;
+}
+
+void MsvModuleManager::SetReadinessTimeout(std::chrono::milliseconds timeout)
+{
+	MsvLockGuard lock(m_lock, MSV_LOCK_CALL_SITE);
+
+	m_readinessTimeout = timeout;
+}
+
+void MsvModuleManager::SetTraceRecorder(std::shared_ptr<MsvTraceRecorder> spTraceRecorder)
+{
+	MsvLockGuard lock(m_lock, MSV_LOCK_CALL_SITE);
+
+	m_spTraceRecorder = spTraceRecorder;
+
+	//pass it to already registered DLL modules
+	for (MsvModuleMap::iterator it = m_modules.begin(); it != m_modules.end(); ++it)
+	{
+		std::shared_ptr<MsvDllModuleAdapter> spDllModuleAdapter = std::dynamic_pointer_cast<MsvDllModuleAdapter>(it->second.second);
+		if (spDllModuleAdapter)
+		{
+			spDllModuleAdapter->SetTraceRecorder(spTraceRecorder);
+		}
+	}
+}
+
+
+/********************************************************************************************************************************
+*															MsvModuleManager protected methods
+********************************************************************************************************************************/
+
+
+MsvErrorCode MsvModuleManager::ModuleTransition(int32_t moduleId, const std::shared_ptr<IMsvModule>& spModule, MsvModuleTransition transition)
+{
+	static const char* const transitionNames[] = { "Initialize", "Start", "Stop", "Uninitialize" };
+
+	MsvErrorCode errorCode = MSV_INVALID_DATA_ERROR;
+	if (static_cast<size_t>(transition) >= static_cast<size_t>(MsvModuleTransition::MSV_MODULE_TRANSITION_COUNT))
+	{
+		return errorCode;
+	}
+
+	//stalled module can not be uninitialized while its stop runs (its code would be unloaded under it)
+	if (transition == MsvModuleTransition::MSV_MODULE_TRANSITION_UNINITIALIZE && MSV_FAILED(errorCode = JoinStalledStop(moduleId)))
+	{
+		return errorCode;
+	}
+
+	//event name is created only when tracing is enabled
+	std::string traceName;
+	if (m_spTraceRecorder)
+	{
+		traceName = std::string(transitionNames[static_cast<size_t>(transition)]) + " module " + std::to_string(moduleId);
+		m_spTraceRecorder->Begin(traceName, "module");
+	}
+
+	//initialize and start run on module CPUs (previous placement is restored at the end of transition)
+	std::unordered_map<int32_t, MsvModulePlacement>::const_iterator placementIt = m_modulePlacements.find(moduleId);
+	const MsvModulePlacement* pPlacement = nullptr;
+	if (placementIt != m_modulePlacements.end() && (transition == MsvModuleTransition::MSV_MODULE_TRANSITION_INITIALIZE || transition == MsvModuleTransition::MSV_MODULE_TRANSITION_START))
+	{
+		pPlacement = &placementIt->second;
+	}
+
+	MsvPlacementScope placementScope(pPlacement);
+	if (MSV_FAILED(placementScope.GetErrorCode()))
+	{
+		//placement is a hint -> just log and continue
+		MSV_LOG_ERROR(m_spLogger, "Apply placement of module {} failed with error: {0:x}", moduleId, placementScope.GetErrorCode());
+	}
+
+	//stopped module does not report heartbeat any more (DLL module heartbeat must be released before uninitialize)
+	if (transition == MsvModuleTransition::MSV_MODULE_TRANSITION_STOP || transition == MsvModuleTransition::MSV_MODULE_TRANSITION_UNINITIALIZE)
+	{
+		m_spWatchdog->Unwatch(moduleId);
+	}
+
+	m_spWatchdog->BeginTransition(moduleId, transition);
+	std::chrono::steady_clock::time_point transitionStart = std::chrono::steady_clock::now();
+	switch (transition)
+	{
+	case MsvModuleTransition::MSV_MODULE_TRANSITION_INITIALIZE:
+		{
+			//hand thread pool and thread factory to module (as DLL factory is set to DLL module)
+			std::shared_ptr<IMsvThreadPoolConsumer> spThreadPoolConsumer = std::dynamic_pointer_cast<IMsvThreadPoolConsumer>(spModule);
+			if (spThreadPoolConsumer)
+			{
+				spThreadPoolConsumer->SetThreadPool(m_spThreadPool);
+			}
+
+			std::shared_ptr<IMsvThreadFactoryConsumer> spThreadFactoryConsumer = std::dynamic_pointer_cast<IMsvThreadFactoryConsumer>(spModule);
+			if (spThreadFactoryConsumer)
+			{
+				spThreadFactoryConsumer->SetThreadFactory(std::make_shared<MsvThreadFactory>(placementIt != m_modulePlacements.end() ? placementIt->second : MsvModulePlacement()));
+			}
+
+			std::shared_ptr<IMsvMessageBusConsumer> spMessageBusConsumer = std::dynamic_pointer_cast<IMsvMessageBusConsumer>(spModule);
+			if (spMessageBusConsumer)
+			{
+				spMessageBusConsumer->SetMessageBus(m_spMessageBus);
+			}
+
+			std::shared_ptr<IMsvServiceRegistryConsumer> spServiceRegistryConsumer = std::dynamic_pointer_cast<IMsvServiceRegistryConsumer>(spModule);
+			if (spServiceRegistryConsumer)
+			{
+				spServiceRegistryConsumer->SetServiceRegistry(m_spServiceRegistry, moduleId);
+			}
+
+			//new arena for every initialize (memory of previous initialize has been released)
+			std::shared_ptr<IMsvArenaConsumer> spArenaConsumer = std::dynamic_pointer_cast<IMsvArenaConsumer>(spModule);
+			if (spArenaConsumer)
+			{
+				std::unordered_map<int32_t, std::pair<size_t, bool>>::const_iterator optionsIt = m_moduleArenaOptions.find(moduleId);
+				std::shared_ptr<MsvArena> spArena(optionsIt != m_moduleArenaOptions.end() ? new MsvArena(optionsIt->second.first, optionsIt->second.second) : new MsvArena());
+				spArenaConsumer->SetArena(spArena);
+				m_moduleArenas[moduleId] = spArena;
+			}
+		}
+		errorCode = spModule->Initialize();
+		if (MSV_FAILED(errorCode))
+		{
+			m_spServiceRegistry->RetractAll(moduleId);
+			ReleaseModuleArena(moduleId, spModule);
+		}
+		break;
+	case MsvModuleTransition::MSV_MODULE_TRANSITION_START:
+		//queue has been closed when module stopped (senders holding it can send again)
+		m_spMessageBus->OpenQueue(moduleId);
+		errorCode = spModule->Start();
+		if (MSV_FAILED(errorCode))
+		{
+			m_spServiceRegistry->RetractAll(moduleId);
+		}
+		else
+		{
+			//DLL module reports heartbeat itself (adapter would lock it)
+			std::shared_ptr<IMsvModuleHeartbeat> spHeartbeat = std::dynamic_pointer_cast<IMsvModuleHeartbeat>(spModule);
+			std::shared_ptr<MsvDllModuleAdapter> spDllModuleAdapter = std::dynamic_pointer_cast<MsvDllModuleAdapter>(spModule);
+			if (spDllModuleAdapter)
+			{
+				spHeartbeat = spDllModuleAdapter->GetModuleHeartbeat();
+			}
+
+			if (spHeartbeat)
+			{
+				m_spWatchdog->Watch(moduleId, spHeartbeat);
+			}
+		}
+		break;
+	case MsvModuleTransition::MSV_MODULE_TRANSITION_STOP:
+		errorCode = spModule->Stop();
+		if (!MSV_FAILED(errorCode))
+		{
+			//module does not provide services and receive messages any more -> release queued messages
+			m_spServiceRegistry->RetractAll(moduleId);
+			m_spMessageBus->CloseQueue(moduleId);
+		}
+		break;
+	case MsvModuleTransition::MSV_MODULE_TRANSITION_UNINITIALIZE:
+		errorCode = spModule->Uninitialize();
+		if (!MSV_FAILED(errorCode))
+		{
+			//module which failed to uninitialize can still use its arena
+			m_spServiceRegistry->RetractAll(moduleId);
+			ReleaseModuleArena(moduleId, spModule);
+		}
+		break;
+	default:
+		break;
+	}
+
+	std::chrono::nanoseconds duration = std::chrono::steady_clock::now() - transitionStart;
+	m_spWatchdog->EndTransition(moduleId);
+	m_spModuleTimings->Record(moduleId, transition, duration, errorCode);
+
+	//state of module is given by transition (module is not asked - it could be locked)
+	static const MsvModuleState transitionStates[][2] =
+	{
+		{ MsvModuleState::MSV_MODULE_STATE_UNINITIALIZED, MsvModuleState::MSV_MODULE_STATE_INITIALIZED },
+		{ MsvModuleState::MSV_MODULE_STATE_INITIALIZED, MsvModuleState::MSV_MODULE_STATE_RUNNING },
+		{ MsvModuleState::MSV_MODULE_STATE_RUNNING, MsvModuleState::MSV_MODULE_STATE_INITIALIZED },
+		{ MsvModuleState::MSV_MODULE_STATE_INITIALIZED, MsvModuleState::MSV_MODULE_STATE_UNINITIALIZED }
+	};
+
+	MsvLifecycleEvent event;
+	event.moduleId = moduleId;
+	event.transition = transition;
+	event.oldState = transitionStates[static_cast<size_t>(transition)][0];
+	event.newState = transitionStates[static_cast<size_t>(transition)][MSV_FAILED(errorCode) ? 0 : 1];
+	event.errorCode = errorCode;
+	event.duration = duration;
+	m_spLifecycleNotifier->Publish(event);
+
+	if (!MSV_FAILED(errorCode))
+	{
+		//wake module state waiters
+		std::shared_ptr<MsvWaitableState>& spState = m_moduleStates[moduleId];
+		if (!spState)
+		{
+			spState = std::make_shared<MsvWaitableState>(static_cast<int32_t>(event.newState));
+		}
+		else
+		{
+			spState->Store(static_cast<int32_t>(event.newState));
+		}
+	}
+
+	if (m_spTraceRecorder)
+	{
+		m_spTraceRecorder->End(traceName, "module", errorCode);
+	}
+
+	return errorCode;
+}
+
+void MsvModuleManager::ReleaseModuleArena(int32_t moduleId, const std::shared_ptr<IMsvModule>& spModule)
+{
+	std::unordered_map<int32_t, std::shared_ptr<MsvArena>>::iterator it = m_moduleArenas.find(moduleId);
+	if (it == m_moduleArenas.end())
+	{
+		return;
+	}
+
+	std::shared_ptr<IMsvArenaConsumer> spArenaConsumer = std::dynamic_pointer_cast<IMsvArenaConsumer>(spModule);
+	if (spArenaConsumer)
+	{
+		spArenaConsumer->SetArena(nullptr);
+	}
+
+	//arena is freed now or when the last object allocated from it is destroyed
+	MSV_LOG_INFO(m_spLogger, "Releasing arena of module {} (live size: {}, peak size: {}).", moduleId, it->second->GetLiveSize(), it->second->GetPeakSize());
+	m_moduleArenas.erase(it);
+}
+
+MsvErrorCode MsvModuleManager::RetryModule(int32_t moduleId)
+{
+	bool restart = false;
+	{
+		std::lock_guard<std::mutex> restartLock(m_restartLock);
+		restart = m_restartRequests.erase(moduleId) != 0;
+	}
+
+	if (restart)
+	{
+		//stalled module is stopped out of module manager lock
+		return RestartModule(moduleId);
+	}
+
+	MsvLockGuard lock(m_lock, MSV_LOCK_CALL_SITE);
+	WaitForLifecycle();
+
+	MsvModuleMap::iterator it = m_modules.find(moduleId);
+	if (!m_initialized || it == m_modules.end())
+	{
+		//module manager has been uninitialized or module has been removed meanwhile -> nothing to retry
+		return MSV_SUCCESS;
+	}
+
+	//module could be initialized meanwhile (then there is nothing to retry)
+	MsvErrorCode errorCode = MSV_SUCCESS;
+	if (!it->second.second->Initialized() && MSV_FAILED(errorCode = BringUpModule(moduleId, it->second.second)))
+	{
+		return errorCode;
+	}
+
+	MSV_LOG_INFO(m_spLogger, "Module {} has been recovered.", moduleId);
+
+	//dependents which waited for recovered module are brought up now
+	m_pendingModules.erase(moduleId);
+	BringUpPendingModules();
+
+	return MSV_SUCCESS;
+}
+
+MsvErrorCode MsvModuleManager::RestartModule(int32_t moduleId)
+{
+	std::shared_ptr<IMsvModule> spModule;
+	{
+		MsvLockGuard lock(m_lock, MSV_LOCK_CALL_SITE);
+		WaitForLifecycle();
+
+		MsvModuleMap::iterator it = m_modules.find(moduleId);
+		if (!m_running || it == m_modules.end())
+		{
+			//module manager has been stopped meanwhile -> nothing to restart
+			return MSV_SUCCESS;
+		}
+
+		if (MSV_FAILED(JoinStalledStop(moduleId)))
+		{
+			//previous restart has not stopped module yet -> it is still stalled
+			MSV_LOG_ERROR(m_spLogger, "Stalled module {} is still stopping - it is not restarted.", moduleId);
+			return MSV_SUCCESS;
+		}
+
+		if (ModuleStateIs(moduleId, MsvModuleState::MSV_MODULE_STATE_RUNNING))
+		{
+			spModule = it->second.second;
+		}
+	}
+
+	MSV_LOG_INFO(m_spLogger, "Restarting stalled module {}.", moduleId);
+
+	MsvErrorCode errorCode = MSV_SUCCESS;
+	if (spModule)
+	{
+		//module is stopped on its own thread with bounded wait (deadlocked module must not block module manager and other retries)
+		MsvWatchdogOptions options = m_spWatchdog->GetModuleOptions(moduleId);
+		std::packaged_task<MsvErrorCode()> stopTask([spModule]() { return spModule->Stop(); });
+		std::future<MsvErrorCode> stopResult = stopTask.get_future();
+		std::thread stopThread;
+		try
+		{
+			stopThread = std::thread(std::move(stopTask));
+		}
+		catch (const std::system_error&)
+		{
+			RequestRestartRetry(moduleId);
+			return MSV_ALLOCATION_ERROR;
+		}
+
+		if (stopResult.wait_for(options.restartTimeout) != std::future_status::ready)
+		{
+			//stop thread is tracked (module can not be uninitialized until it finishes) -> stalled module is left to watchdog observers
+			{
+				MsvLockGuard lock(m_lock, MSV_LOCK_CALL_SITE);
+				m_stalledStops.emplace(moduleId, std::make_pair(std::move(stopThread), std::move(stopResult)));
+			}
+			MSV_LOG_ERROR(m_spLogger, "Stalled module {} has not stopped in {} ms - it is not restarted.", moduleId, options.restartTimeout.count());
+			return MSV_SUCCESS;
+		}
+
+		stopThread.join();
+		if (MSV_FAILED(errorCode = stopResult.get()))
+		{
+			MSV_LOG_ERROR(m_spLogger, "Stop stalled module {} failed with error: {0:x}", moduleId, errorCode);
+			RequestRestartRetry(moduleId);
+			return errorCode;
+		}
+	}
+
+	MsvLockGuard lock(m_lock, MSV_LOCK_CALL_SITE);
+	WaitForLifecycle();
+
+	MsvModuleMap::iterator it = m_modules.find(moduleId);
+	if (!m_running || it == m_modules.end())
+	{
+		//module manager has been stopped meanwhile -> nothing to restart
+		return MSV_SUCCESS;
+	}
+
+	//stopped module returns from stop immediately -> transition records stop (services, queue and state)
+	if ((ModuleStateIs(moduleId, MsvModuleState::MSV_MODULE_STATE_RUNNING) && MSV_FAILED(errorCode = ModuleTransition(moduleId, it->second.second, MsvModuleTransition::MSV_MODULE_TRANSITION_STOP))) ||
+		(ModuleStateIs(moduleId, MsvModuleState::MSV_MODULE_STATE_INITIALIZED) && MSV_FAILED(errorCode = ModuleTransition(moduleId, it->second.second, MsvModuleTransition::MSV_MODULE_TRANSITION_UNINITIALIZE))))
+	{
+		RequestRestartRetry(moduleId);
+		return errorCode;
+	}
+
+	//module which fails to come up is retried as failed module
+	if (MSV_FAILED(errorCode = BringUpModule(moduleId, it->second.second)))
+	{
+		MSV_LOG_ERROR(m_spLogger, "Bring up stalled module {} failed with error: {0:x} - it will be retried.", moduleId, errorCode);
+		return errorCode;
+	}
+
+	MSV_LOG_INFO(m_spLogger, "Stalled module {} has been restarted.", moduleId);
+
+	return MSV_SUCCESS;
+}
+
+void MsvModuleManager::RequestRestartRetry(int32_t moduleId)
+{
+	//the next retry of module restarts it again
+	std::lock_guard<std::mutex> restartLock(m_restartLock);
+	m_restartRequests.insert(moduleId);
+}
+
+bool MsvModuleManager::ModuleStateIs(int32_t moduleId, MsvModuleState state) const
+{
+	//state is given by transitions (module is not asked - it could be locked)
+	std::unordered_map<int32_t, std::shared_ptr<MsvWaitableState>>::const_iterator stateIt = m_moduleStates.find(moduleId);
+	int32_t currentState = stateIt != m_moduleStates.end() ? stateIt->second->Load() : static_cast<int32_t>(MsvModuleState::MSV_MODULE_STATE_UNINITIALIZED);
+
+	return currentState == static_cast<int32_t>(state);
+}
+
+MsvErrorCode MsvModuleManager::BringUpModule(int32_t moduleId, const std::shared_ptr<IMsvModule>& spModule)
+{
+	MsvErrorCode errorCode = ModuleTransition(moduleId, spModule, MsvModuleTransition::MSV_MODULE_TRANSITION_INITIALIZE);
+	if (MSV_FAILED(errorCode) || !m_running)
+	{
+		return errorCode;
+	}
+
+	//module manager is serving -> module joins it
+	if (MSV_FAILED(errorCode = WaitForDependencies(moduleId)) || MSV_FAILED(errorCode = ModuleTransition(moduleId, spModule, MsvModuleTransition::MSV_MODULE_TRANSITION_START)))
+	{
+		MsvErrorCode uninitializeErrorCode = ModuleTransition(moduleId, spModule, MsvModuleTransition::MSV_MODULE_TRANSITION_UNINITIALIZE);
+		if (MSV_FAILED(uninitializeErrorCode))
+		{
+			MSV_LOG_ERROR(m_spLogger, "Uninitialize module {} failed with error: {0:x}", moduleId, uninitializeErrorCode);
+		}
+	}
+
+	return errorCode;
+}
+
+void MsvModuleManager::BringUpPendingModules()
+{
+	//startup order -> dependencies are brought up before their dependents
+	std::vector<int32_t> startupOrder;
+	GetStartupOrder(startupOrder);
+	for (std::vector<int32_t>::const_iterator orderIt = startupOrder.begin(); orderIt != startupOrder.end(); ++orderIt)
+	{
+		//failed module is brought up by its retry, dependent waits until all its dependencies are available
+		std::map<int32_t, int32_t>::iterator pendingIt = m_pendingModules.find(*orderIt);
+		int32_t causeId = 0;
+		if (pendingIt == m_pendingModules.end() || pendingIt->second == pendingIt->first || GetPendingDependency(*orderIt, causeId))
+		{
+			continue;
+		}
+
+		m_pendingModules.erase(pendingIt);
+
+		MsvModuleMap::iterator it = m_modules.find(*orderIt);
+		MsvErrorCode errorCode = BringUpModule(it->first, it->second.second);
+		if (MSV_FAILED(errorCode))
+		{
+			//dependent failed itself -> it is retried (and its dependents keep waiting)
+			MSV_LOG_ERROR(m_spLogger, "Bring up module {} failed with error: {0:x} - it will be retried.", it->first, errorCode);
+			m_pendingModules[it->first] = it->first;
+			m_spModuleRetry->Schedule(it->first);
+			continue;
+		}
+
+		MSV_LOG_INFO(m_spLogger, "Module {} has been brought up after its dependencies recovered.", it->first);
+	}
+}
+
+bool MsvModuleManager::GetPendingDependency(int32_t moduleId, int32_t& causeId) const
+{
+	std::map<int32_t, std::vector<int32_t>>::const_iterator dependenciesIt = m_dependencies.find(moduleId);
+	if (dependenciesIt == m_dependencies.end())
+	{
+		return false;
+	}
+
+	for (std::vector<int32_t>::const_iterator dependencyIt = dependenciesIt->second.begin(); dependencyIt != dependenciesIt->second.end(); ++dependencyIt)
+	{
+		std::map<int32_t, int32_t>::const_iterator pendingIt = m_pendingModules.find(*dependencyIt);
+		if (pendingIt != m_pendingModules.end())
+		{
+			causeId = pendingIt->second;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void MsvModuleManager::RequestRestart(int32_t moduleId)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_restartLock);
+		m_restartRequests.insert(moduleId);
+	}
+
+	//module which is already scheduled is restarted by its next retry
+	m_spModuleRetry->Schedule(moduleId);
+}
+
+bool MsvModuleManager::IsModuleCritical(int32_t moduleId) const
+{
+	std::unordered_map<int32_t, bool>::const_iterator it = m_moduleCriticality.find(moduleId);
+
+	return it == m_moduleCriticality.end() || it->second;
+}
+
+MsvErrorCode MsvModuleManager::WaitForDependencies(int32_t moduleId)
+{
+	std::map<int32_t, std::vector<int32_t>>::const_iterator dependenciesIt = m_dependencies.find(moduleId);
+	if (dependenciesIt == m_dependencies.end())
+	{
+		return MSV_SUCCESS;
+	}
+
+	std::vector<std::pair<int32_t, std::shared_ptr<IMsvModuleReadiness>>> readiness;
+	for (std::vector<int32_t>::const_iterator it = dependenciesIt->second.begin(); it != dependenciesIt->second.end(); ++it)
+	{
+		//only running dependencies can become ready (state is given by transitions - module is not asked)
+		std::unordered_map<int32_t, std::shared_ptr<MsvWaitableState>>::const_iterator stateIt = m_moduleStates.find(*it);
+		MsvModuleMap::const_iterator moduleIt = m_modules.find(*it);
+		if (stateIt == m_moduleStates.end() || moduleIt == m_modules.end() || stateIt->second->Load() != static_cast<int32_t>(MsvModuleState::MSV_MODULE_STATE_RUNNING))
+		{
+			continue;
+		}
+
+		std::shared_ptr<IMsvModuleReadiness> spReadiness = std::dynamic_pointer_cast<IMsvModuleReadiness>(moduleIt->second.second);
+		if (spReadiness && !spReadiness->Ready())
+		{
+			readiness.push_back(std::pair<int32_t, std::shared_ptr<IMsvModuleReadiness>>(*it, spReadiness));
+		}
+	}
+
+	if (readiness.empty())
+	{
+		return MSV_SUCCESS;
+	}
+
+	//wait out of lock (queries are served and dependencies can call module manager, lifecycle calls wait until it finishes)
+	std::chrono::steady_clock::time_point deadline = MsvWaitableState::GetDeadline(m_readinessTimeout);
+	m_waitingForDependencies = true;
+	m_lock.unlock();
+
+	std::vector<std::pair<int32_t, std::shared_ptr<IMsvModuleReadiness>>>::const_iterator it = readiness.begin();
+	for (; it != readiness.end(); ++it)
+	{
+		std::chrono::milliseconds remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+		if (!it->second->WaitForReady(remaining > std::chrono::milliseconds::zero() ? remaining : std::chrono::milliseconds::zero()))
+		{
+			break;
+		}
+	}
+
+	m_lock.lock(MSV_LOCK_CALL_SITE);
+	m_waitingForDependencies = false;
+	m_lifecycleCondition.notify_all();
+
+	if (it != readiness.end())
+	{
+		MSV_LOG_ERROR(m_spLogger, "Dependency {} of module {} is not ready in time - failed with error: {0:x}", it->first, moduleId, MSV_NOT_INITIALIZED_ERROR);
+		return MSV_NOT_INITIALIZED_ERROR;
+	}
+
+	return MSV_SUCCESS;
+}
+
+void MsvModuleManager::WaitForLifecycle()
+{
+	//other thread waits for dependencies or thread pool out of lock -> lifecycle changes wait until it finishes (state it has checked stays valid)
+	while (m_waitingForDependencies || m_stoppingThreadPool)
+	{
+		m_lifecycleCondition.wait(m_lock);
+	}
+}
+
+MsvErrorCode MsvModuleManager::JoinStalledStop(int32_t moduleId)
+{
+	std::map<int32_t, std::pair<std::thread, std::future<MsvErrorCode>>>::iterator it = m_stalledStops.find(moduleId);
+	if (it == m_stalledStops.end())
+	{
+		return MSV_SUCCESS;
+	}
+
+	if (it->second.second.wait_for(std::chrono::milliseconds::zero()) != std::future_status::ready)
+	{
+		MSV_LOG_ERROR(m_spLogger, "Stop of stalled module {} is still running - failed with error: {0:x}", moduleId, MSV_STILL_RUNNING_ERROR);
+		return MSV_STILL_RUNNING_ERROR;
+	}
+
+	//stop has finished -> thread exits immediately
+	it->second.first.join();
+	m_stalledStops.erase(it);
+
+	return MSV_SUCCESS;
+}
+
+void MsvModuleManager::StopThreadPool()
+{
+	//tasks can query module manager -> stop thread pool out of lock (lifecycle calls wait until it finishes)
+	m_stoppingThreadPool = true;
+	m_lock.unlock();
+
+	m_spThreadPool->Stop();
+
+	m_lock.lock(MSV_LOCK_CALL_SITE);
+	m_stoppingThreadPool = false;
+	m_lifecycleCondition.notify_all();
+}
+
+void MsvModuleManager::GetRunningReadiness(std::vector<std::shared_ptr<IMsvModuleReadiness>>& readiness) const
+{
+	for (MsvModuleMap::const_iterator it = m_modules.begin(); it != m_modules.end(); ++it)
+	{
+		std::unordered_map<int32_t, std::shared_ptr<MsvWaitableState>>::const_iterator stateIt = m_moduleStates.find(it->first);
+		if (stateIt == m_moduleStates.end() || stateIt->second->Load() != static_cast<int32_t>(MsvModuleState::MSV_MODULE_STATE_RUNNING))
+		{
+			continue;
+		}
+
+		std::shared_ptr<IMsvModuleReadiness> spReadiness = std::dynamic_pointer_cast<IMsvModuleReadiness>(it->second.second);
+		if (spReadiness)
+		{
+			readiness.push_back(spReadiness);
+		}
+	}
+}
+
+void MsvModuleManager::GetTopologicalOrder(std::unordered_map<int32_t, size_t>& pendingCounts, const std::unordered_map<int32_t, std::vector<int32_t>>& edges, std::vector<int32_t>& order) const
+{
+	order.clear();
+	order.reserve(pendingCounts.size());
+
+	std::set<int32_t> ready;
+	for (std::unordered_map<int32_t, size_t>::const_iterator it = pendingCounts.begin(); it != pendingCounts.end(); ++it)
+	{
+		if (it->second == 0)
+		{
+			ready.insert(it->first);
+		}
+	}
+
+	while (!ready.empty())
+	{
+		int32_t moduleId = *ready.begin();
+		ready.erase(ready.begin());
+		order.push_back(moduleId);
+
+		std::unordered_map<int32_t, std::vector<int32_t>>::const_iterator edgeIt = edges.find(moduleId);
+		if (edgeIt == edges.end())
+		{
+			continue;
+		}
+
+		for (std::vector<int32_t>::const_iterator it = edgeIt->second.begin(); it != edgeIt->second.end(); ++it)
+		{
+			if (--pendingCounts[*it] == 0)
+			{
+				ready.insert(*it);
+			}
+		}
+	}
+}
+
+uint64_t MsvModuleManager::GetModuleSetHash() const
+{
+	MsvLockGuard lock(m_lock, MSV_LOCK_CALL_SITE);
+
+	//sum of module hashes and dependency hashes (it does not depend on order)
+	uint64_t moduleSetHash = 0;
+	for (MsvModuleMap::const_iterator it = m_modules.begin(); it != m_modules.end(); ++it)
+	{
+		moduleSetHash += MsvStartupPlan::GetModuleIdHash(it->first);
+
+		std::map<int32_t, std::vector<int32_t>>::const_iterator dependencyIt = m_dependencies.find(it->first);
+		if (dependencyIt == m_dependencies.end())
+		{
+			continue;
+		}
+
+		for (std::vector<int32_t>::const_iterator idIt = dependencyIt->second.begin(); idIt != dependencyIt->second.end(); ++idIt)
+		{
+			moduleSetHash += MsvStartupPlan::GetModuleIdHash(it->first) ^ (MsvStartupPlan::GetModuleIdHash(*idIt) << 1);
+		}
+	}
+
+	return moduleSetHash;
+}
+
+void MsvModuleManager::LogCriticalPath() const
+{
+	MsvLockGuard lock(m_lock, MSV_LOCK_CALL_SITE);
+
+	MsvCriticalPath criticalPath;
+	GetCriticalPath(criticalPath);
+
+	MSV_LOG_INFO(m_spLogger, "Module manager started - {}", MsvCriticalPathAnalyzer::GetSummary(criticalPath));
+}
+
+void MsvModuleManager::PrefetchDllModules()
+{
+	MsvLockGuard lock(m_lock, MSV_LOCK_CALL_SITE);
+
+	if (!m_spDllPrefetcher)
+	{
+		return;
+	}
+
+	//get DLL paths from all DLL module adapters
+	std::vector<std::string> dllPaths;
+	for (MsvModuleMap::iterator it = m_modules.begin(); it != m_modules.end(); ++it)
+	{
+		std::shared_ptr<MsvDllModuleAdapter> spDllModuleAdapter = std::dynamic_pointer_cast<MsvDllModuleAdapter>(it->second.second);
+		if (!spDllModuleAdapter)
+		{
+			//it is not DLL module -> nothing to prefetch
+			continue;
+		}
+
+		std::string dllPath;
+		if (!MSV_FAILED(spDllModuleAdapter->GetDllPath(dllPath)) && std::find(dllPaths.begin(), dllPaths.end(), dllPath) == dllPaths.end())
+		{
+			dllPaths.push_back(dllPath);
+		}
+	}
+
+	MSV_LOG_INFO(m_spLogger, "Prefetching {} DLL files of modules.", dllPaths.size());
+
+	MsvErrorCode errorCode = m_spDllPrefetcher->Prefetch(dllPaths);
+	if (MSV_FAILED(errorCode))
+	{
+		//it is not fatal (DLLs are just loaded slower)
+		MSV_LOG_ERROR(m_spLogger, "Prefetch DLL files of modules failed with error: {0:x}", errorCode);
+	}
+}
+
+bool MsvModuleManager::LoadStartupPlan(std::vector<MsvStartupPlanModule>& startupPlan)
+{
+	MsvLockGuard lock(m_lock, MSV_LOCK_CALL_SITE);
+
+	startupPlan.clear();
+
+	if (!m_startupPlanPath.empty())
+	{
+		uint64_t moduleSetHash = GetModuleSetHash();
+
+		MsvStartupPlan cachedPlan;
+		if (MSV_FAILED(cachedPlan.Open(m_startupPlanPath.c_str())))
+		{
+			MSV_LOG_INFO(m_spLogger, "Startup plan {} does not exist or it is not valid.", m_startupPlanPath);
+		}
+		else if (!cachedPlan.Matches(m_startupPlanConfigVersion, moduleSetHash) || !MatchesStartupPlan(cachedPlan.GetModules(), cachedPlan.GetModuleCount()))
+		{
+			MSV_LOG_INFO(m_spLogger, "Startup plan {} does not match current configuration.", m_startupPlanPath);
+		}
+		else
+		{
+			//plan matches -> use its order and durations (it is copied because flags and durations of this run will be written to it)
+			startupPlan.assign(cachedPlan.GetModules(), cachedPlan.GetModules() + cachedPlan.GetModuleCount());
+			MSV_LOG_INFO(m_spLogger, "Using startup plan {} with {} modules.", m_startupPlanPath, startupPlan.size());
+			return true;
+		}
+	}
+
+	//no cached plan -> modules in startup order (flags are resolved in initialize)
+	std::vector<int32_t> startupOrder;
+	GetStartupOrder(startupOrder);
+
+	startupPlan.reserve(startupOrder.size());
+	for (std::vector<int32_t>::const_iterator it = startupOrder.begin(); it != startupOrder.end(); ++it)
+	{
+		MsvStartupPlanModule planModule = {};
+		planModule.moduleId = *it;
+		startupPlan.push_back(planModule);
+	}
+
+	return false;
+}
+
+bool MsvModuleManager::MatchesStartupPlan(const MsvStartupPlanModule* pModules, size_t count) const
+{
+	if (count != m_modules.size())
+	{
+		return false;
+	}
+
+	//every registered module is exactly once in plan
+	std::unordered_map<int32_t, size_t> planIndex;
+	for (size_t index = 0; index < count; ++index)
+	{
+		if (m_modules.find(pModules[index].moduleId) == m_modules.end() || !planIndex.insert(std::pair<int32_t, size_t>(pModules[index].moduleId, index)).second)
+		{
+			return false;
+		}
+	}
+
+	//every module is after its dependencies
+	for (std::map<int32_t, std::vector<int32_t>>::const_iterator it = m_dependencies.begin(); it != m_dependencies.end(); ++it)
+	{
+		std::unordered_map<int32_t, size_t>::const_iterator moduleIt = planIndex.find(it->first);
+		if (moduleIt == planIndex.end())
+		{
+			continue;
+		}
+
+		for (std::vector<int32_t>::const_iterator dependencyIt = it->second.begin(); dependencyIt != it->second.end(); ++dependencyIt)
+		{
+			std::unordered_map<int32_t, size_t>::const_iterator indexIt = planIndex.find(*dependencyIt);
+			if (indexIt != planIndex.end() && indexIt->second > moduleIt->second)
+			{
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+void MsvModuleManager::ResetStartupPlanDurations(std::vector<MsvStartupPlanModule>& startupPlan) const
+{
+	for (std::vector<MsvStartupPlanModule>::iterator it = startupPlan.begin(); it != startupPlan.end(); ++it)
+	{
+		it->initializeDuration = 0;
+		it->startDuration = 0;
+	}
+}
+
+void MsvModuleManager::SaveStartupPlan()
+{
+	MsvLockGuard lock(m_lock, MSV_LOCK_CALL_SITE);
+
+	if (m_startupPlanPath.empty())
+	{
+		return;
+	}
+
+	MsvErrorCode errorCode = MsvStartupPlan::Save(m_startupPlanPath.c_str(), m_startupPlanConfigVersion, GetModuleSetHash(), m_startupPlan);
+	if (MSV_FAILED(errorCode))
+	{
+		//it is not fatal (plan will be resolved again in next run)
+		MSV_LOG_ERROR(m_spLogger, "Save startup plan {} failed with error: {0:x}", m_startupPlanPath, errorCode);
+	}
+}
+
+
 /** @} */	//End of group MMODULE.
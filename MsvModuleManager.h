@@ -35,15 +35,43 @@ along with Foobar. If not, see <https://www.gnu.org/licenses/>.
 #define MARSTECH_MODULEMANAGER_H
 
 
+#include "IMsvArenaConsumer.h"
+#include "IMsvMessageBusConsumer.h"
+#include "IMsvModuleReadiness.h"
+#include "IMsvServiceRegistryConsumer.h"
+#include "MsvLifecycleNotifier.h"
+#include "MsvWaitableState.h"
 #include "IMsvModuleManager.h"
 #include "IMsvModuleConfigurator.h"
+#include "MsvArena.h"
+#include "MsvCriticalPath.h"
+#include "MsvDllPrefetcher.h"
+#include "MsvLock.h"
+#include "MsvModulePlacement.h"
+#include "MsvModuleRetry.h"
+#include "MsvModuleTimings.h"
+#include "MsvStartResult.h"
+#include "MsvStartupPlan.h"
+#include "MsvThreadPool.h"
+#include "MsvTraceRecorder.h"
+#include "MsvWatchdog.h"
 
 #include "mlogging/mlogging.h"
+#include "merror/MsvErrorCodes.h"
 
 MSV_DISABLE_ALL_WARNINGS
 
+#include <condition_variable>
+#include <future>
 #include <map>
 #include <mutex>
+#include <new>
+#include <set>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 MSV_ENABLE_WARNINGS
 
@@ -53,9 +81,17 @@ MSV_ENABLE_WARNINGS
 * @details	Module manager implementation which can manage all modules.
 ******************************************************************************************************/
 class MsvModuleManager:
-	public IMsvModuleManager
+	public IMsvModuleManager,
+	public IMsvModuleReadiness
 {
 public:
+	/**************************************************************************************************//**
+	* @brief		Registered modules.
+	* @details	Configurator and module by module ID (map nodes are allocated from module manager arena).
+	******************************************************************************************************/
+	typedef std::map<int32_t, std::pair<std::shared_ptr<IMsvModuleConfigurator>, std::shared_ptr<IMsvModule>>, std::less<int32_t>,
+		MsvArenaAllocator<std::pair<const int32_t, std::pair<std::shared_ptr<IMsvModuleConfigurator>, std::shared_ptr<IMsvModule>>>>> MsvModuleMap;
+
 	/**************************************************************************************************//**
 	* @brief			Constructor.
 	* @param[in]	spLogger						Shared pointer to logger for logging.
@@ -74,6 +110,9 @@ public:
 	/**************************************************************************************************//**
 	* @copydoc	IMsvModule::Initialize()
 	* @retval	MSV_ALREADY_INITIALIZED_INFO	When module manager has been already initialized (this is info, not error).
+	* @note		Failed initialize of non-critical module (@ref SetModuleCritical) does not fail module manager - module
+	*				is retried in background (@ref GetModuleRetry). Its dependents are not initialized until it recovers
+	*				(then they are brought up in startup order) - critical dependent fails module manager.
 	******************************************************************************************************/
 	virtual MsvErrorCode Initialize() override;
 
@@ -93,6 +132,8 @@ public:
 	* @copydoc	IMsvModule::Start()
 	* @retval	MSV_NOT_INITIALIZED_ERROR		When module manager has not been initialized before. Must be initialized before.
 	* @retval	MSV_ALREADY_RUNNING_INFO		When module manager is already running (this is info, not error).
+	* @note		With @ref MsvStartPolicy::MSV_START_POLICY_DEGRADED only failed critical modules fail start. Result of
+	*				every module is available by @ref GetStartResults.
 	******************************************************************************************************/
 	virtual MsvErrorCode Start() override;
 
@@ -116,12 +157,530 @@ public:
 	******************************************************************************************************/
 	virtual MsvErrorCode AddModule(int32_t moduleId, std::shared_ptr<IMsvModule> spModule, std::shared_ptr<IMsvModuleConfigurator> spModuleConfigurator) override;
 
+	/*-----------------------------------------------------------------------------------------------------
+	**											IMsvModuleReadiness public methods
+	**---------------------------------------------------------------------------------------------------*/
+public:
+	/**************************************************************************************************//**
+	* @copydoc IMsvModuleReadiness::Ready() const
+	* @note		Module manager is ready (serving) when it is running and all running modules which implement
+	*				@ref IMsvModuleReadiness are ready.
+	******************************************************************************************************/
+	virtual bool Ready() const override;
+
+	/**************************************************************************************************//**
+	* @copydoc IMsvModuleReadiness::WaitForReady(std::chrono::milliseconds timeout) const
+	* @note		It returns false immediately when module manager is not running. Module manager is not locked while
+	*				it waits for modules.
+	******************************************************************************************************/
+	virtual bool WaitForReady(std::chrono::milliseconds timeout) const override;
+
+	/*-----------------------------------------------------------------------------------------------------
+	**											MsvModuleManager public methods
+	**---------------------------------------------------------------------------------------------------*/
+public:
+	/**************************************************************************************************//**
+	* @brief			Set DLL prefetcher.
+	* @details		Sets DLL prefetcher which warms up DLL files of all DLL module adapters (@ref MsvDllModuleAdapter)
+	*					before modules are initialized. DLL paths are taken from adapters (@ref MsvDllModuleAdapter::GetDllPath).
+	* @param[in]	spDllPrefetcher		Shared pointer to DLL prefetcher (empty = no prefetch).
+	******************************************************************************************************/
+	virtual void SetDllPrefetcher(std::shared_ptr<MsvDllPrefetcher> spDllPrefetcher);
+
+	/**************************************************************************************************//**
+	* @brief			Set startup plan file.
+	* @details		Sets file where resolved startup plan (module order, installed and enabled flags and durations)
+	*					is persisted. When the file matches current configuration (config version, registered module IDs
+	*					and their dependencies) in next run, initialize uses its module order and durations. Module
+	*					configurators are always read - plan which does not match their flags is not used.
+	* @param[in]	path					Path of startup plan file (empty = no startup plan).
+	* @param[in]	configVersion		Version of current configuration (cached plan of other version is not used).
+	******************************************************************************************************/
+	virtual void SetStartupPlanFile(const char* path, uint64_t configVersion);
+
+	/**************************************************************************************************//**
+	* @brief			Get startup plan.
+	* @details		Returns startup plan resolved by last successful initialize (with durations of this run).
+	* @param[out]	startupPlan			Modules in startup order.
+	******************************************************************************************************/
+	virtual void GetStartupPlan(std::vector<MsvStartupPlanModule>& startupPlan) const;
+
+	/**************************************************************************************************//**
+	* @brief			Get module timings.
+	* @details		Returns durations of lifecycle transitions (initialize, start, stop, uninitialize) of all modules
+	*					done by this module manager (last, min, max, total and histogram per module and transition).
+	*					Timings are kept across restarts of module manager.
+	* @returns		std::shared_ptr<const MsvModuleTimings>
+	* @note			Timings have own lock - reading them does not block module manager.
+	******************************************************************************************************/
+	virtual std::shared_ptr<const MsvModuleTimings> GetModuleTimings() const;
+
+	/**************************************************************************************************//**
+	* @brief			Set trace recorder.
+	* @details		Sets trace recorder which records begin and end events of module manager and of every module
+	*					transition (with thread IDs). It is passed to all DLL module adapters too (they record nested
+	*					DLL load events). Recorded events can be exported in Chrome trace-event format
+	*					(@ref MsvTraceRecorder::Export).
+	* @param[in]	spTraceRecorder	Shared pointer to trace recorder (empty = no tracing).
+	******************************************************************************************************/
+	virtual void SetTraceRecorder(std::shared_ptr<MsvTraceRecorder> spTraceRecorder);
+
+	/**************************************************************************************************//**
+	* @brief			Add module dependency.
+	* @details		Declares that module depends on other module. Dependency is initialized and started before
+	*					module and it is stopped and uninitialized after module. Modules without dependencies between
+	*					them are processed in module ID order. Dependencies on not registered modules are ignored.
+	* @param[in]	moduleId							ID of dependent module.
+	* @param[in]	dependencyId					ID of module it depends on.
+	* @retval		MSV_INVALID_DATA_ERROR		When module depends on itself or when dependency creates cycle.
+	* @retval		MSV_ALREADY_EXISTS_ERROR	When dependency has been already added.
+	* @retval		MSV_SUCCESS						On success.
+	******************************************************************************************************/
+	virtual MsvErrorCode AddModuleDependency(int32_t moduleId, int32_t dependencyId);
+
+	/**************************************************************************************************//**
+	* @brief			Get startup order.
+	* @details		Returns IDs of registered modules in order they are initialized and started.
+	* @param[out]	startupOrder		Module IDs (dependencies before their dependents).
+	******************************************************************************************************/
+	virtual void GetStartupOrder(std::vector<int32_t>& startupOrder) const;
+
+	/**************************************************************************************************//**
+	* @brief			Get shutdown order.
+	* @details		Returns IDs of registered modules in order they are stopped and uninitialized.
+	* @param[out]	shutdownOrder		Module IDs (dependents before their dependencies).
+	******************************************************************************************************/
+	virtual void GetShutdownOrder(std::vector<int32_t>& shutdownOrder) const;
+
+	/**************************************************************************************************//**
+	* @brief			Get critical path.
+	* @details		Computes startup critical path from last initialize and start durations of modules
+	*					(@ref GetModuleTimings) and module dependencies. It is chain of modules whose durations
+	*					determine total bring-up time when modules are brought up as soon as their dependencies are
+	*					ready, together with slack of each module. Summary is logged after each successful start.
+	* @param[out]	criticalPath		Critical path.
+	******************************************************************************************************/
+	virtual void GetCriticalPath(MsvCriticalPath& criticalPath) const;
+
+	/**************************************************************************************************//**
+	* @brief			Get arena.
+	* @details		Returns arena of module manager. Registered modules (map nodes) and objects created by
+	*					@ref CreateObject are allocated from it, so they are co-located. Arena is released at once when
+	*					module manager and all objects allocated from it are destroyed.
+	* @returns		std::shared_ptr<MsvArena>
+	******************************************************************************************************/
+	virtual std::shared_ptr<MsvArena> GetArena() const;
+
+	/**************************************************************************************************//**
+	* @brief			Create object.
+	* @details		Creates shared object (module, DLL module adapter, module configurator, ...) in arena of module
+	*					manager. Object and its shared pointer control block are one arena allocation.
+	* @tparam		T							Object type.
+	* @param[out]	spObject					Shared pointer to created object.
+	* @param[in]	args						Constructor arguments.
+	* @retval		MSV_ALLOCATION_ERROR	When arena allocation failed.
+	* @retval		MSV_SUCCESS				On success.
+	******************************************************************************************************/
+	template<class T, class... Args>
+	MsvErrorCode CreateObject(std::shared_ptr<T>& spObject, Args&&... args)
+	{
+		try
+		{
+			spObject = std::allocate_shared<T>(MsvArenaAllocator<T>(m_spArena), std::forward<Args>(args)...);
+		}
+		catch (const std::bad_alloc&)
+		{
+			MSV_LOG_ERROR(m_spLogger, "Create object in arena failed with error: {0:x}", MSV_ALLOCATION_ERROR);
+			return MSV_ALLOCATION_ERROR;
+		}
+
+		return MSV_SUCCESS;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Get thread pool.
+	* @details		Returns work stealing thread pool shared by all modules (sized to number of hardware threads).
+	*					It is set to modules which implement @ref IMsvThreadPoolConsumer before they are initialized. Thread
+	*					pool accepts tasks from module manager initialize until all modules are stopped (or uninitialized),
+	*					its worker threads are started by the first task.
+	* @returns		std::shared_ptr<MsvThreadPool>
+	* @warning		Tasks can query module manager, but they must not change its state or state of its modules (it
+	*					waits for them when it stops thread pool).
+	******************************************************************************************************/
+	virtual std::shared_ptr<MsvThreadPool> GetThreadPool() const;
+
+	/**************************************************************************************************//**
+	* @brief			Set module placement.
+	* @details		Sets CPU set and NUMA node of module (module does not have to be registered yet). Placement is
+	*					applied to thread which runs Initialize and Start of module (and restored after them) and to threads
+	*					created by thread factory set to module (@ref IMsvThreadFactoryConsumer) on initialize.
+	* @param[in]	moduleId							Module ID.
+	* @param[in]	placement						Module placement.
+	* @retval		MSV_INVALID_DATA_ERROR		When NUMA node is invalid.
+	* @retval		MSV_SUCCESS						On success.
+	* @note			Placement is a hint - module transition does not fail when placement could not be applied (e.g.
+	*					CPU or NUMA node does not exist on this host).
+	******************************************************************************************************/
+	virtual MsvErrorCode SetModulePlacement(int32_t moduleId, const MsvModulePlacement& placement);
+
+	/**************************************************************************************************//**
+	* @brief			Get module placement.
+	* @param[in]	moduleId							Module ID.
+	* @param[out]	placement						Module placement.
+	* @retval		MSV_NOT_FOUND_ERROR			When placement of module has not been set.
+	* @retval		MSV_SUCCESS						On success.
+	******************************************************************************************************/
+	virtual MsvErrorCode GetModulePlacement(int32_t moduleId, MsvModulePlacement& placement) const;
+
+	/**************************************************************************************************//**
+	* @brief			Set module arena options.
+	* @details		Sets options of arena created for module (module does not have to be registered yet). Options are
+	*					used when module is initialized next time.
+	* @param[in]	moduleId							Module ID.
+	* @param[in]	chunkSize						Size of arena chunks.
+	* @param[in]	hugePages						Flag if arena chunks should be backed by huge pages (only chunks of at least
+	*														@ref MSV_ARENA_HUGE_PAGE_SIZE use them).
+	* @retval		MSV_INVALID_DATA_ERROR		When chunk size is zero.
+	* @retval		MSV_SUCCESS						On success.
+	******************************************************************************************************/
+	virtual MsvErrorCode SetModuleArenaOptions(int32_t moduleId, size_t chunkSize, bool hugePages);
+
+	/**************************************************************************************************//**
+	* @brief			Set module critical.
+	* @details		Sets if module is critical (module does not have to be registered yet). Modules are critical by
+	*					default - their failed initialize fails module manager (all modules are uninitialized). Failed
+	*					initialize of non-critical module is just logged and module is retried in background with
+	*					exponential backoff (it is started when it recovers while module manager is running).
+	* @param[in]	moduleId							Module ID.
+	* @param[in]	critical							Flag if module is critical (true) or not (false).
+	******************************************************************************************************/
+	virtual void SetModuleCritical(int32_t moduleId, bool critical);
+
+	/**************************************************************************************************//**
+	* @brief			Set start policy.
+	* @details		Sets what start does when module fails (default is @ref MsvStartPolicy::MSV_START_POLICY_ALL_OR_NOTHING).
+	*					With @ref MsvStartPolicy::MSV_START_POLICY_DEGRADED failed non-critical modules (@ref SetModuleCritical)
+	*					and their dependents are skipped and the other modules are started. Critical module which depends on
+	*					failed module fails start.
+	* @param[in]	startPolicy						Start policy.
+	******************************************************************************************************/
+	virtual void SetStartPolicy(MsvStartPolicy startPolicy);
+
+	/**************************************************************************************************//**
+	* @brief			Get start results.
+	* @details		Returns result of every module in the last start (in startup order, modules after failed critical
+	*					module are not there). Skipped dependents are started by the next start.
+	* @param[out]	startResults					Module start results.
+	******************************************************************************************************/
+	virtual void GetStartResults(std::vector<MsvModuleStartResult>& startResults) const;
+
+	/**************************************************************************************************//**
+	* @brief			Get module memory usage.
+	* @details		Returns usage of arena of module. Module which implements @ref IMsvArenaConsumer gets its own arena
+	*					when it is initialized and module manager releases it after module is uninitialized (arena is freed
+	*					when the last object allocated from it is destroyed).
+	* @param[in]	moduleId							Module ID.
+	* @param[out]	usage								Arena usage (live, peak and reserved size).
+	* @retval		MSV_NOT_FOUND_ERROR			When module does not have arena (it is not initialized or it is not arena
+	*														consumer).
+	* @retval		MSV_SUCCESS						On success.
+	******************************************************************************************************/
+	virtual MsvErrorCode GetModuleMemoryUsage(int32_t moduleId, MsvArenaUsage& usage) const;
+
+	/**************************************************************************************************//**
+	* @brief			Wait for module state.
+	* @details		Blocks until module is in requested state or timeout expires. State is changed by successful
+	*					transitions done by module manager - waiter is woken exactly when it changes (no polling) and it
+	*					does not hold module manager lock while it waits.
+	* @param[in]	moduleId							Module ID.
+	* @param[in]	state								Requested state.
+	* @param[in]	timeout							Timeout.
+	* @param[out]	reached							Flag if module is in requested state (true) or timeout expired (false).
+	* @retval		MSV_NOT_FOUND_ERROR			When module is not registered.
+	* @retval		MSV_SUCCESS						On success.
+	******************************************************************************************************/
+	virtual MsvErrorCode WaitForState(int32_t moduleId, MsvModuleState state, std::chrono::milliseconds timeout, bool& reached);
+
+	/**************************************************************************************************//**
+	* @brief			Set readiness timeout.
+	* @details		Sets how long module manager waits for running dependencies of module to become ready before it
+	*					starts module (default is @ref MSV_READINESS_DEFAULT_TIMEOUT). Start of module fails with
+	*					MSV_NOT_INITIALIZED_ERROR when its dependencies are not ready in time.
+	* @param[in]	timeout							Readiness timeout.
+	******************************************************************************************************/
+	virtual void SetReadinessTimeout(std::chrono::milliseconds timeout);
+
+	/**************************************************************************************************//**
+	* @brief			Get message bus.
+	* @details		Returns message bus addressed by module ID. It is set to modules which implement
+	*					@ref IMsvMessageBusConsumer before they are initialized. Queue of module is created when module is
+	*					registered, it is closed when module stops (queued messages are released) and the same queue is
+	*					opened again when module starts.
+	* @returns		std::shared_ptr<MsvMessageBus>
+	******************************************************************************************************/
+	virtual std::shared_ptr<MsvMessageBus> GetMessageBus() const;
+
+	/**************************************************************************************************//**
+	* @brief			Get service registry.
+	* @details		Returns registry of services published by modules. It is set to modules which implement
+	*					@ref IMsvServiceRegistryConsumer before they are initialized. Services of module are retracted when
+	*					module stops (or its initialize or start fails) and when it is uninitialized.
+	* @returns		std::shared_ptr<MsvServiceRegistry>
+	******************************************************************************************************/
+	virtual std::shared_ptr<MsvServiceRegistry> GetServiceRegistry() const;
+
+	/**************************************************************************************************//**
+	* @brief			Get lifecycle notifier.
+	* @details		Returns notifier of lifecycle events of modules. Every transition done by module manager (successful
+	*					or failed) is published to it - observers subscribed to it get events in batches on notifier thread.
+	* @returns		std::shared_ptr<MsvLifecycleNotifier>
+	******************************************************************************************************/
+	virtual std::shared_ptr<MsvLifecycleNotifier> GetLifecycleNotifier() const;
+
+	/**************************************************************************************************//**
+	* @brief			Get module retry.
+	* @details		Returns background retry of failed non-critical modules (set its policy or get retry state of
+	*					module). Retries are canceled when module manager is uninitialized.
+	* @returns		std::shared_ptr<MsvModuleRetry>
+	******************************************************************************************************/
+	virtual std::shared_ptr<MsvModuleRetry> GetModuleRetry() const;
+
+	/**************************************************************************************************//**
+	* @brief			Get watchdog.
+	* @details		Returns watchdog of module transitions and running modules (start it and set options of modules).
+	*					Module manager reports all transitions to it and watches running modules which implement
+	*					@ref IMsvModuleHeartbeat. Stalled module with @ref MSV_WATCHDOG_ACTION_RESTART is restarted by
+	*					module retry (@ref GetModuleRetry) - its backoff and circuit breaker stop restart storms.
+	* @returns		std::shared_ptr<MsvWatchdog>
+	* @note		Restart stops stalled module out of module manager lock - module which does not stop in restart timeout
+	*				(e.g. deadlock) is not restarted.
+	******************************************************************************************************/
+	virtual std::shared_ptr<MsvWatchdog> GetWatchdog() const;
+
+protected:
+	/**************************************************************************************************//**
+	* @brief			Module transition.
+	* @details		Calls transition method of module and records its duration to module timings.
+	* @param[in]	moduleId							Module ID.
+	* @param[in]	spModule							Shared pointer to module.
+	* @param[in]	transition						Module transition.
+	* @retval		MSV_INVALID_DATA_ERROR		When transition is not valid.
+	* @retval		other_error_code				Error code returned by module.
+	******************************************************************************************************/
+	virtual MsvErrorCode ModuleTransition(int32_t moduleId, const std::shared_ptr<IMsvModule>& spModule, MsvModuleTransition transition);
+
+	/**************************************************************************************************//**
+	* @brief			Release module arena.
+	* @details		Resets arena of module and removes it from module arenas (after module has been uninitialized or
+	*					its initialize failed).
+	* @param[in]	moduleId							Module ID.
+	* @param[in]	spModule							Shared pointer to module.
+	******************************************************************************************************/
+	virtual void ReleaseModuleArena(int32_t moduleId, const std::shared_ptr<IMsvModule>& spModule);
+
+	/**************************************************************************************************//**
+	* @brief			Retry module.
+	* @details		Initializes failed non-critical module (and starts it when module manager is running). It is called
+	*					by module retry on retry thread.
+	* @param[in]	moduleId							Module ID.
+	* @retval		other_error_code				When initialize or start failed (module is retried again).
+	* @retval		MSV_SUCCESS						On success or when there is nothing to retry.
+	******************************************************************************************************/
+	virtual MsvErrorCode RetryModule(int32_t moduleId);
+
+	/**************************************************************************************************//**
+	* @brief			Request restart.
+	* @details		Marks stalled module to be restarted and schedules its retry (@ref RetryModule stops and
+	*					uninitializes it first). It is called by watchdog on watchdog thread - it does not lock module
+	*					manager.
+	* @param[in]	moduleId							Module ID.
+	******************************************************************************************************/
+	virtual void RequestRestart(int32_t moduleId);
+
+	/**************************************************************************************************//**
+	* @brief			Restart module.
+	* @details		Restarts stalled module (called by @ref RetryModule on retry thread). Module is stopped out of
+	*					module manager lock on its own thread - module which does not stop in restart timeout
+	*					(@ref MsvWatchdogOptions) is not restarted (its stop thread is tracked, stall is left to watchdog
+	*					observers and module can not be uninitialized until the stop finishes - destructor waits for it).
+	*					Stopped module is uninitialized and brought up again.
+	* @param[in]	moduleId							Module ID.
+	* @retval		other_error_code				When stop, uninitialize or bring up failed (module is retried).
+	* @retval		MSV_SUCCESS						On success or when there is nothing to restart.
+	******************************************************************************************************/
+	virtual MsvErrorCode RestartModule(int32_t moduleId);
+
+	/**************************************************************************************************//**
+	* @brief			Join stalled stop.
+	* @details		Joins stop thread of stalled module when its stop has finished (see @ref RestartModule).
+	* @param[in]	moduleId							Module ID.
+	* @retval		MSV_STILL_RUNNING_ERROR		When stop of stalled module is still running.
+	* @retval		MSV_SUCCESS						On success or when module has no stalled stop.
+	* @note			Module manager must be locked.
+	******************************************************************************************************/
+	virtual MsvErrorCode JoinStalledStop(int32_t moduleId);
+
+	/**************************************************************************************************//**
+	* @brief			Request restart retry.
+	* @details		Marks module to be restarted again by its next retry (restart failed before module has been
+	*					uninitialized).
+	* @param[in]	moduleId							Module ID.
+	******************************************************************************************************/
+	virtual void RequestRestartRetry(int32_t moduleId);
+
+	/**************************************************************************************************//**
+	* @brief			Check module state.
+	* @details		Compares state of module given by transitions (module is not asked - it could be locked).
+	* @param[in]	moduleId							Module ID.
+	* @param[in]	state								Module state.
+	* @retval		true								When module is in state.
+	* @retval		false								When module is in other state.
+	******************************************************************************************************/
+	virtual bool ModuleStateIs(int32_t moduleId, MsvModuleState state) const;
+
+	/**************************************************************************************************//**
+	* @brief			Bring up module.
+	* @details		Initializes module and starts it when module manager is running (module is uninitialized when
+	*					start failed).
+	* @param[in]	moduleId							Module ID.
+	* @param[in]	spModule							Shared pointer to module.
+	* @retval		other_error_code				When initialize or start failed.
+	* @retval		MSV_SUCCESS						On success.
+	******************************************************************************************************/
+	virtual MsvErrorCode BringUpModule(int32_t moduleId, const std::shared_ptr<IMsvModule>& spModule);
+
+	/**************************************************************************************************//**
+	* @brief		Bring up pending modules.
+	* @details	Brings up (in startup order) pending dependents whose dependencies are available. Dependent which fails
+	*				is retried.
+	* @see		m_pendingModules
+	******************************************************************************************************/
+	virtual void BringUpPendingModules();
+
+	/**************************************************************************************************//**
+	* @brief			Get pending dependency.
+	* @param[in]	moduleId							Module ID.
+	* @param[out]	causeId							ID of failed module the pending dependency waits for.
+	* @retval		true								When any dependency of module is pending.
+	* @retval		false								When no dependency of module is pending.
+	******************************************************************************************************/
+	virtual bool GetPendingDependency(int32_t moduleId, int32_t& causeId) const;
+
+	/**************************************************************************************************//**
+	* @brief			Get critical flag of module.
+	* @param[in]	moduleId							Module ID.
+	* @retval		true								When module is critical.
+	* @retval		false								When module is not critical.
+	******************************************************************************************************/
+	virtual bool IsModuleCritical(int32_t moduleId) const;
+
+	/**************************************************************************************************//**
+	* @brief			Wait for dependencies.
+	* @details		Waits until running dependencies of module which implement @ref IMsvModuleReadiness are ready
+	*					(at most @ref m_readinessTimeout for all of them). It is called before module is started.
+	* @param[in]	moduleId							Module ID.
+	* @retval		MSV_NOT_INITIALIZED_ERROR	When dependency is not ready in time.
+	* @retval		MSV_SUCCESS						On success.
+	* @note			Module manager must be locked once. It is unlocked while it waits (queries like @ref Ready are
+	*					served), lifecycle changes wait until it finishes (see @ref WaitForLifecycle).
+	******************************************************************************************************/
+	virtual MsvErrorCode WaitForDependencies(int32_t moduleId);
+
+	/**************************************************************************************************//**
+	* @brief			Wait for lifecycle.
+	* @details		Waits until other thread finishes waiting for dependencies or stopping thread pool (module manager
+	*					must be locked once). It is called by methods which change state of module manager or its modules.
+	* @see			WaitForDependencies
+	* @see			StopThreadPool
+	******************************************************************************************************/
+	virtual void WaitForLifecycle();
+
+	/**************************************************************************************************//**
+	* @brief			Stop thread pool.
+	* @details		Runs queued tasks and stops worker threads.
+	* @note			Module manager must be locked once. It is unlocked while thread pool stops (tasks can query module
+	*					manager), lifecycle changes wait until it finishes (see @ref WaitForLifecycle).
+	******************************************************************************************************/
+	virtual void StopThreadPool();
+
+	/**************************************************************************************************//**
+	* @brief			Get running readiness.
+	* @details		Returns running modules which implement @ref IMsvModuleReadiness (module manager must be locked).
+	* @param[out]	readiness						Readiness of running modules.
+	******************************************************************************************************/
+	virtual void GetRunningReadiness(std::vector<std::shared_ptr<IMsvModuleReadiness>>& readiness) const;
+
+	/**************************************************************************************************//**
+	* @brief				Get topological order.
+	* @details			Orders modules by Kahn's algorithm (lowest module ID first when more modules are ready).
+	* @param[in,out]	pendingCounts		Number of unordered predecessors by module ID (it is consumed).
+	* @param[in]		edges					Successors by module ID.
+	* @param[out]		order					Ordered module IDs.
+	******************************************************************************************************/
+	virtual void GetTopologicalOrder(std::unordered_map<int32_t, size_t>& pendingCounts, const std::unordered_map<int32_t, std::vector<int32_t>>& edges, std::vector<int32_t>& order) const;
+
+	/**************************************************************************************************//**
+	* @brief			Get module set hash.
+	* @details		Returns hash of registered module IDs and their dependencies (used to validate startup plan).
+	* @returns		uint64_t
+	******************************************************************************************************/
+	virtual uint64_t GetModuleSetHash() const;
+
+	/**************************************************************************************************//**
+	* @brief		Log critical path.
+	* @details	Logs summary of startup critical path (@ref GetCriticalPath).
+	******************************************************************************************************/
+	virtual void LogCriticalPath() const;
+
+	/**************************************************************************************************//**
+	* @brief		Prefetch DLL modules.
+	* @details	Prefetches DLL files of all registered DLL module adapters (when DLL prefetcher is set).
+	* @note		Prefetch failures are not fatal - they are just logged.
+	******************************************************************************************************/
+	virtual void PrefetchDllModules();
+
+	/**************************************************************************************************//**
+	* @brief			Load startup plan.
+	* @details		Loads cached startup plan when it is set and it matches current configuration (see
+	*					@ref MatchesStartupPlan). Otherwise returns modules in startup order. Flags are resolved by
+	*					initialize in both cases (cached flags are only compared with them).
+	* @param[out]	startupPlan			Modules in startup order.
+	* @retval		true					When cached plan is used (order and durations of previous run).
+	* @retval		false					When plan is not cached.
+	******************************************************************************************************/
+	virtual bool LoadStartupPlan(std::vector<MsvStartupPlanModule>& startupPlan);
+
+	/**************************************************************************************************//**
+	* @brief			Check if startup plan matches registered modules.
+	* @details		Plan matches when it contains every registered module exactly once and every module is after
+	*					its dependencies (module set hash of plan could match by chance).
+	* @param[in]	pModules				Modules of plan.
+	* @param[in]	count					Number of modules of plan.
+	* @retval		true					When plan matches.
+	* @retval		false					When plan does not match (it is not used).
+	******************************************************************************************************/
+	virtual bool MatchesStartupPlan(const MsvStartupPlanModule* pModules, size_t count) const;
+
+	/**************************************************************************************************//**
+	* @brief			Reset startup plan durations.
+	* @details		Drops durations of previous run (cached plan does not match flags of modules).
+	* @param[in,out]	startupPlan		Startup plan.
+	******************************************************************************************************/
+	virtual void ResetStartupPlanDurations(std::vector<MsvStartupPlanModule>& startupPlan) const;
+
+	/**************************************************************************************************//**
+	* @brief		Save startup plan.
+	* @details	Saves current startup plan to startup plan file (when it is set).
+	* @note		Save failures are not fatal - they are just logged.
+	******************************************************************************************************/
+	virtual void SaveStartupPlan();
+
 protected:
 	/**************************************************************************************************//**
 	* @brief		Module manager mutex.
-	* @details	Locks this object for thread safety access.
+	* @details	Locks this object for thread safety access (instrumented when MSV_LOCK_INSTRUMENTATION is enabled).
 	******************************************************************************************************/
-	mutable std::recursive_mutex m_lock;
+	mutable MsvRecursiveMutex m_lock;
 
 	/**************************************************************************************************//**
 	* @brief		Initialize flag.
@@ -132,12 +691,28 @@ protected:
 	******************************************************************************************************/
 	bool m_initialized;
 
+	/**************************************************************************************************//**
+	* @brief		Arena.
+	* @details	Arena of registered modules and objects created by module manager (it must be declared before
+	*				@ref m_modules).
+	* @see		GetArena
+	* @see		CreateObject
+	******************************************************************************************************/
+	std::shared_ptr<MsvArena> m_spArena;
+
 	/**************************************************************************************************//**
 	* @brief		Registered modules.
 	* @details	Map of registered modules to module manager. These modules are managed by module manager.
 	* @see		AddModule
 	******************************************************************************************************/
-	std::map<int32_t, std::pair<std::shared_ptr<IMsvModuleConfigurator>, std::shared_ptr<IMsvModule>>> m_modules;
+	MsvModuleMap m_modules;
+
+	/**************************************************************************************************//**
+	* @brief		Module dependencies.
+	* @details	IDs of modules which module depends on by module ID (it is acyclic).
+	* @see		AddModuleDependency
+	******************************************************************************************************/
+	std::map<int32_t, std::vector<int32_t>> m_dependencies;
 
 	/**************************************************************************************************//**
 	* @brief		Logger.
@@ -153,6 +728,209 @@ protected:
 	* @see		Running
 	******************************************************************************************************/
 	bool m_running;
+
+	/**************************************************************************************************//**
+	* @brief		DLL prefetcher.
+	* @details	Warms up DLL files of DLL modules before they are initialized (empty = no prefetch).
+	* @see		SetDllPrefetcher
+	******************************************************************************************************/
+	std::shared_ptr<MsvDllPrefetcher> m_spDllPrefetcher;
+
+	/**************************************************************************************************//**
+	* @brief		Startup plan file.
+	* @details	Path of startup plan file (empty = no startup plan).
+	* @see		SetStartupPlanFile
+	******************************************************************************************************/
+	std::string m_startupPlanPath;
+
+	/**************************************************************************************************//**
+	* @brief		Config version.
+	* @details	Version of current configuration used to validate startup plan.
+	* @see		SetStartupPlanFile
+	******************************************************************************************************/
+	uint64_t m_startupPlanConfigVersion;
+
+	/**************************************************************************************************//**
+	* @brief		Startup plan.
+	* @details	Startup plan resolved by last successful initialize (modules in startup order).
+	******************************************************************************************************/
+	std::vector<MsvStartupPlanModule> m_startupPlan;
+
+	/**************************************************************************************************//**
+	* @brief		Startup plan index.
+	* @details	Index of module in @ref m_startupPlan by module ID.
+	******************************************************************************************************/
+	std::unordered_map<int32_t, size_t> m_startupPlanIndex;
+
+	/**************************************************************************************************//**
+	* @brief		Start policy.
+	* @see		SetStartPolicy
+	******************************************************************************************************/
+	MsvStartPolicy m_startPolicy;
+
+	/**************************************************************************************************//**
+	* @brief		Start results.
+	* @details	Results of modules in the last start.
+	* @see		GetStartResults
+	******************************************************************************************************/
+	std::vector<MsvModuleStartResult> m_startResults;
+
+	/**************************************************************************************************//**
+	* @brief		Module timings.
+	* @details	Durations of lifecycle transitions of all modules.
+	* @see		GetModuleTimings
+	******************************************************************************************************/
+	std::shared_ptr<MsvModuleTimings> m_spModuleTimings;
+
+	/**************************************************************************************************//**
+	* @brief		Trace recorder.
+	* @details	Records module transition events (empty = no tracing).
+	* @see		SetTraceRecorder
+	******************************************************************************************************/
+	std::shared_ptr<MsvTraceRecorder> m_spTraceRecorder;
+
+	/**************************************************************************************************//**
+	* @brief		Thread pool.
+	* @details	Worker threads shared by all modules.
+	* @see		GetThreadPool
+	******************************************************************************************************/
+	std::shared_ptr<MsvThreadPool> m_spThreadPool;
+
+	/**************************************************************************************************//**
+	* @brief		Module placements.
+	* @details	CPU sets and NUMA nodes of modules (module ID -> placement).
+	* @see		SetModulePlacement
+	******************************************************************************************************/
+	std::unordered_map<int32_t, MsvModulePlacement> m_modulePlacements;
+
+	/**************************************************************************************************//**
+	* @brief		Module arena options.
+	* @details	Chunk size and huge pages flag of module arenas (module ID -> options).
+	* @see		SetModuleArenaOptions
+	******************************************************************************************************/
+	std::unordered_map<int32_t, std::pair<size_t, bool>> m_moduleArenaOptions;
+
+	/**************************************************************************************************//**
+	* @brief		Module critical flags.
+	* @details	Critical flags of modules (module ID -> flag, modules which are not there are critical).
+	* @see		SetModuleCritical
+	******************************************************************************************************/
+	std::unordered_map<int32_t, bool> m_moduleCriticality;
+
+	/**************************************************************************************************//**
+	* @brief		Pending modules.
+	* @details	Modules which are not available until failed module recovers (module ID -> ID of failed module): failed
+	*				non-critical modules which are retried and their dependents which are not initialized until failed
+	*				modules recover.
+	* @see		RetryModule
+	* @see		BringUpPendingModules
+	******************************************************************************************************/
+	std::map<int32_t, int32_t> m_pendingModules;
+
+	/**************************************************************************************************//**
+	* @brief		Module states.
+	* @details	States of modules set by transitions (module ID -> state). Waiters hold state and wait out of module
+	*				manager lock.
+	* @see		WaitForState
+	******************************************************************************************************/
+	std::unordered_map<int32_t, std::shared_ptr<MsvWaitableState>> m_moduleStates;
+
+	/**************************************************************************************************//**
+	* @brief		Readiness timeout.
+	* @details	How long module manager waits for dependencies of module to become ready.
+	* @see		SetReadinessTimeout
+	* @see		WaitForDependencies
+	******************************************************************************************************/
+	std::chrono::milliseconds m_readinessTimeout;
+
+	/**************************************************************************************************//**
+	* @brief		Waiting for dependencies flag.
+	* @details	Flag if any thread waits for dependencies out of lock (true) or not (false).
+	* @see		WaitForDependencies
+	* @see		WaitForLifecycle
+	******************************************************************************************************/
+	bool m_waitingForDependencies;
+
+	/**************************************************************************************************//**
+	* @brief		Stopping thread pool flag.
+	* @details	Flag if any thread stops thread pool out of lock (true) or not (false).
+	* @see		StopThreadPool
+	* @see		WaitForLifecycle
+	******************************************************************************************************/
+	bool m_stoppingThreadPool;
+
+	/**************************************************************************************************//**
+	* @brief		Lifecycle condition.
+	* @details	Notified when thread finishes waiting for dependencies or stopping thread pool.
+	* @see		WaitForLifecycle
+	******************************************************************************************************/
+	std::condition_variable_any m_lifecycleCondition;
+
+	/**************************************************************************************************//**
+	* @brief		Module arenas.
+	* @details	Arenas of initialized modules (module ID -> arena).
+	* @see		GetModuleMemoryUsage
+	******************************************************************************************************/
+	std::unordered_map<int32_t, std::shared_ptr<MsvArena>> m_moduleArenas;
+
+	/**************************************************************************************************//**
+	* @brief		Message bus.
+	* @details	Message queues of modules.
+	* @see		GetMessageBus
+	******************************************************************************************************/
+	std::shared_ptr<MsvMessageBus> m_spMessageBus;
+
+	/**************************************************************************************************//**
+	* @brief		Service registry.
+	* @details	Services published by modules.
+	* @see		GetServiceRegistry
+	******************************************************************************************************/
+	std::shared_ptr<MsvServiceRegistry> m_spServiceRegistry;
+
+	/**************************************************************************************************//**
+	* @brief		Module retry.
+	* @details	Retries failed non-critical modules (its thread is stopped at the beginning of destructor).
+	* @see		GetModuleRetry
+	******************************************************************************************************/
+	std::shared_ptr<MsvModuleRetry> m_spModuleRetry;
+
+	/**************************************************************************************************//**
+	* @brief		Restart mutex.
+	* @details	Locks restart requests (watchdog must not lock module manager).
+	******************************************************************************************************/
+	std::mutex m_restartLock;
+
+	/**************************************************************************************************//**
+	* @brief		Restart requests.
+	* @details	Stalled modules which are restarted by next retry.
+	* @see		RequestRestart
+	******************************************************************************************************/
+	std::set<int32_t> m_restartRequests;
+
+	/**************************************************************************************************//**
+	* @brief		Stalled stops.
+	* @details	Stop threads (and theirs results) of stalled modules which have not stopped in restart timeout
+	*				(module ID -> stop thread and result).
+	* @see		RestartModule
+	* @see		JoinStalledStop
+	******************************************************************************************************/
+	std::map<int32_t, std::pair<std::thread, std::future<MsvErrorCode>>> m_stalledStops;
+
+	/**************************************************************************************************//**
+	* @brief		Watchdog.
+	* @details	Detects hung transitions and stalled running modules (its thread is stopped at the beginning of
+	*				destructor).
+	* @see		GetWatchdog
+	******************************************************************************************************/
+	std::shared_ptr<MsvWatchdog> m_spWatchdog;
+
+	/**************************************************************************************************//**
+	* @brief		Lifecycle notifier.
+	* @details	Dispatches lifecycle events of modules to observers (it is destroyed first - events of module manager
+	*				destructor are dispatched before other members are destroyed).
+	* @see		GetLifecycleNotifier
+	******************************************************************************************************/
+	std::shared_ptr<MsvLifecycleNotifier> m_spLifecycleNotifier;
 };
 
 
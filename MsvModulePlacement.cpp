@@ -0,0 +1,471 @@
+/**************************************************************************************************//**
+* @addtogroup	MMODULE
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Module Placement
+* @details		Contains implementation of @ref MsvThreadPlacement, @ref MsvPlacementScope and
+*					@ref MsvThreadFactory.
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Module Library.
+
+MarsTech Dependency Injection is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "MsvModulePlacement.h"
+
+#include "merror/MsvErrorCodes.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <cstdlib>
+#include <string>
+#include <system_error>
+
+#if defined(_WIN32)
+#include <windows.h>
+#elif defined(__linux__)
+#include <fstream>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+MSV_ENABLE_WARNINGS
+
+
+#if defined(__linux__)
+namespace
+{
+
+//memory policy modes (numaif.h is part of libnuma, which is not required)
+const int MSV_MPOL_DEFAULT = 0;
+const int MSV_MPOL_PREFERRED = 1;
+
+//memory policy mode flags (they are returned together with mode)
+const int MSV_MPOL_MODE_FLAGS = (1 << 15) | (1 << 14) | (1 << 13);
+
+//maximal number of NUMA nodes in node mask
+const unsigned long MSV_NUMA_MAX_NODES = 1024;
+const size_t MSV_NUMA_MASK_WORDS = MSV_NUMA_MAX_NODES / (8 * sizeof(unsigned long));
+
+}
+#endif
+
+
+/********************************************************************************************************************************
+*															MsvThreadPlacement public methods
+********************************************************************************************************************************/
+
+
+MsvErrorCode MsvThreadPlacement::Apply(const MsvModulePlacement& placement)
+{
+	if (!placement.cpus.empty())
+	{
+		MSV_RETURN_FAILED(SetThreadCpus(placement.cpus));
+	}
+	else if (placement.numaNode != MSV_NUMA_NODE_ANY)
+	{
+		//run on CPUs of NUMA node
+		std::vector<uint32_t> cpus;
+		MSV_RETURN_FAILED(GetNumaNodeCpus(placement.numaNode, cpus));
+		MSV_RETURN_FAILED(SetThreadCpus(cpus));
+	}
+
+	return SetThreadNumaNode(placement.numaNode);
+}
+
+MsvErrorCode MsvThreadPlacement::GetThreadCpus(std::vector<uint32_t>& cpus)
+{
+	cpus.clear();
+
+#if defined(_WIN32)
+	//there is no get function -> set all CPUs of process and set back previous mask
+	DWORD_PTR processMask = 0;
+	DWORD_PTR systemMask = 0;
+	if (!GetProcessAffinityMask(GetCurrentProcess(), &processMask, &systemMask))
+	{
+		return MSV_INVALID_DATA_ERROR;
+	}
+
+	DWORD_PTR threadMask = SetThreadAffinityMask(GetCurrentThread(), processMask);
+	if (!threadMask)
+	{
+		return MSV_INVALID_DATA_ERROR;
+	}
+	SetThreadAffinityMask(GetCurrentThread(), threadMask);
+
+	for (uint32_t cpu = 0; cpu < 8 * sizeof(DWORD_PTR); ++cpu)
+	{
+		if (threadMask & (static_cast<DWORD_PTR>(1) << cpu))
+		{
+			cpus.push_back(cpu);
+		}
+	}
+#elif defined(__linux__)
+	cpu_set_t cpuSet;
+	CPU_ZERO(&cpuSet);
+	if (pthread_getaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet) != 0)
+	{
+		return MSV_INVALID_DATA_ERROR;
+	}
+
+	for (uint32_t cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+	{
+		if (CPU_ISSET(cpu, &cpuSet))
+		{
+			cpus.push_back(cpu);
+		}
+	}
+#endif
+
+	return MSV_SUCCESS;
+}
+
+MsvErrorCode MsvThreadPlacement::SetThreadCpus(const std::vector<uint32_t>& cpus)
+{
+	if (cpus.empty())
+	{
+		return MSV_INVALID_DATA_ERROR;
+	}
+
+#if defined(_WIN32)
+	DWORD_PTR threadMask = 0;
+	for (std::vector<uint32_t>::const_iterator it = cpus.begin(); it != cpus.end(); ++it)
+	{
+		if (*it >= 8 * sizeof(DWORD_PTR))
+		{
+			//only processor group 0 is supported
+			return MSV_INVALID_DATA_ERROR;
+		}
+
+		threadMask |= static_cast<DWORD_PTR>(1) << *it;
+	}
+
+	if (!SetThreadAffinityMask(GetCurrentThread(), threadMask))
+	{
+		return MSV_INVALID_DATA_ERROR;
+	}
+#elif defined(__linux__)
+	cpu_set_t cpuSet;
+	CPU_ZERO(&cpuSet);
+	for (std::vector<uint32_t>::const_iterator it = cpus.begin(); it != cpus.end(); ++it)
+	{
+		if (*it >= CPU_SETSIZE)
+		{
+			return MSV_INVALID_DATA_ERROR;
+		}
+
+		CPU_SET(*it, &cpuSet);
+	}
+
+	if (pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet) != 0)
+	{
+		return MSV_INVALID_DATA_ERROR;
+	}
+#endif
+
+	return MSV_SUCCESS;
+}
+
+MsvErrorCode MsvThreadPlacement::GetThreadNumaNode(int32_t& numaNode)
+{
+	numaNode = MSV_NUMA_NODE_ANY;
+
+#if defined(__linux__)
+	int mode = MSV_MPOL_DEFAULT;
+	unsigned long nodeMask[MSV_NUMA_MASK_WORDS] = {};
+	if (syscall(SYS_get_mempolicy, &mode, nodeMask, MSV_NUMA_MAX_NODES, nullptr, 0) != 0)
+	{
+		//NUMA is not supported by kernel -> there is only default policy
+		return MSV_SUCCESS;
+	}
+
+	if ((mode & ~MSV_MPOL_MODE_FLAGS) != MSV_MPOL_PREFERRED)
+	{
+		//other policies are not set by module placement
+		return MSV_SUCCESS;
+	}
+
+	for (size_t node = 0; node < MSV_NUMA_MAX_NODES; ++node)
+	{
+		if (nodeMask[node / (8 * sizeof(unsigned long))] & (1UL << (node % (8 * sizeof(unsigned long)))))
+		{
+			numaNode = static_cast<int32_t>(node);
+			break;
+		}
+	}
+#endif
+
+	return MSV_SUCCESS;
+}
+
+MsvErrorCode MsvThreadPlacement::SetThreadNumaNode(int32_t numaNode)
+{
+	if (numaNode < MSV_NUMA_NODE_ANY)
+	{
+		return MSV_INVALID_DATA_ERROR;
+	}
+
+#if defined(__linux__)
+	if (numaNode == MSV_NUMA_NODE_ANY)
+	{
+		//default policy is set when NUMA is not supported
+		syscall(SYS_set_mempolicy, MSV_MPOL_DEFAULT, nullptr, 0);
+		return MSV_SUCCESS;
+	}
+
+	if (static_cast<unsigned long>(numaNode) >= MSV_NUMA_MAX_NODES)
+	{
+		return MSV_INVALID_DATA_ERROR;
+	}
+
+	//preferred (not bound) node -> allocations do not fail when node is full
+	unsigned long nodeMask[MSV_NUMA_MASK_WORDS] = {};
+	nodeMask[numaNode / (8 * sizeof(unsigned long))] = 1UL << (numaNode % (8 * sizeof(unsigned long)));
+	if (syscall(SYS_set_mempolicy, MSV_MPOL_PREFERRED, nodeMask, MSV_NUMA_MAX_NODES) != 0)
+	{
+		return MSV_INVALID_DATA_ERROR;
+	}
+#endif
+
+	return MSV_SUCCESS;
+}
+
+MsvErrorCode MsvThreadPlacement::GetThreadMemoryPolicy(MsvThreadMemoryPolicy& memoryPolicy)
+{
+	memoryPolicy.mode = 0;
+	memoryPolicy.nodeMask.clear();
+
+#if defined(__linux__)
+	int mode = MSV_MPOL_DEFAULT;
+	std::vector<unsigned long> nodeMask(MSV_NUMA_MASK_WORDS, 0);
+	if (syscall(SYS_get_mempolicy, &mode, nodeMask.data(), MSV_NUMA_MAX_NODES, nullptr, 0) != 0)
+	{
+		//NUMA is not supported by kernel -> there is only default policy
+		return MSV_SUCCESS;
+	}
+
+	memoryPolicy.mode = mode;
+	memoryPolicy.nodeMask.swap(nodeMask);
+#endif
+
+	return MSV_SUCCESS;
+}
+
+MsvErrorCode MsvThreadPlacement::SetThreadMemoryPolicy(const MsvThreadMemoryPolicy& memoryPolicy)
+{
+#if defined(__linux__)
+	if (memoryPolicy.nodeMask.size() > MSV_NUMA_MASK_WORDS)
+	{
+		return MSV_INVALID_DATA_ERROR;
+	}
+
+	//default policy must not have nodes
+	std::vector<unsigned long> nodeMask(memoryPolicy.nodeMask);
+	nodeMask.resize(MSV_NUMA_MASK_WORDS, 0);
+	bool defaultPolicy = (memoryPolicy.mode & ~MSV_MPOL_MODE_FLAGS) == MSV_MPOL_DEFAULT;
+	if (syscall(SYS_set_mempolicy, memoryPolicy.mode, defaultPolicy ? nullptr : nodeMask.data(), defaultPolicy ? 0 : MSV_NUMA_MAX_NODES) != 0)
+	{
+		//default policy is set when NUMA is not supported
+		return defaultPolicy ? MSV_SUCCESS : MSV_INVALID_DATA_ERROR;
+	}
+#else
+	if (memoryPolicy.mode != 0)
+	{
+		return MSV_INVALID_DATA_ERROR;
+	}
+#endif
+
+	return MSV_SUCCESS;
+}
+
+MsvErrorCode MsvThreadPlacement::GetNumaNodeCpus(int32_t numaNode, std::vector<uint32_t>& cpus)
+{
+	cpus.clear();
+
+	if (numaNode < 0)
+	{
+		return MSV_NOT_FOUND_ERROR;
+	}
+
+#if defined(_WIN32)
+	ULONGLONG nodeMask = 0;
+	if (numaNode > 0xFF || !GetNumaNodeProcessorMask(static_cast<UCHAR>(numaNode), &nodeMask) || !nodeMask)
+	{
+		return MSV_NOT_FOUND_ERROR;
+	}
+
+	for (uint32_t cpu = 0; cpu < 8 * sizeof(ULONGLONG); ++cpu)
+	{
+		if (nodeMask & (static_cast<ULONGLONG>(1) << cpu))
+		{
+			cpus.push_back(cpu);
+		}
+	}
+#elif defined(__linux__)
+	//CPU list has format "0-3,8-11"
+	std::ifstream cpuListFile("/sys/devices/system/node/node" + std::to_string(numaNode) + "/cpulist");
+	std::string cpuList;
+	if (!std::getline(cpuListFile, cpuList))
+	{
+		return MSV_NOT_FOUND_ERROR;
+	}
+
+	size_t position = 0;
+	while (position < cpuList.size())
+	{
+		size_t end = cpuList.find(',', position);
+		if (end == std::string::npos)
+		{
+			end = cpuList.size();
+		}
+
+		std::string range = cpuList.substr(position, end - position);
+		size_t dash = range.find('-');
+		uint32_t first = static_cast<uint32_t>(std::strtoul(range.c_str(), nullptr, 10));
+		uint32_t last = (dash == std::string::npos) ? first : static_cast<uint32_t>(std::strtoul(range.c_str() + dash + 1, nullptr, 10));
+		for (uint32_t cpu = first; cpu <= last && !range.empty(); ++cpu)
+		{
+			cpus.push_back(cpu);
+		}
+
+		position = end + 1;
+	}
+#endif
+
+	return cpus.empty() ? MSV_NOT_FOUND_ERROR : MSV_SUCCESS;
+}
+
+
+/********************************************************************************************************************************
+*															MsvPlacementScope constructors and destructors
+********************************************************************************************************************************/
+
+
+MsvPlacementScope::MsvPlacementScope(const MsvModulePlacement* pPlacement):
+	m_applied(false),
+	m_errorCode(MSV_SUCCESS),
+	m_previousMemoryPolicy()
+{
+	if (!pPlacement)
+	{
+		return;
+	}
+
+	MsvThreadPlacement::GetThreadCpus(m_previousCpus);
+	MsvThreadPlacement::GetThreadMemoryPolicy(m_previousMemoryPolicy);
+
+	//placement can be partially applied even when apply failed -> always restore
+	m_applied = true;
+	m_errorCode = MsvThreadPlacement::Apply(*pPlacement);
+}
+
+MsvPlacementScope::~MsvPlacementScope()
+{
+	if (!m_applied)
+	{
+		return;
+	}
+
+	if (!m_previousCpus.empty())
+	{
+		MsvThreadPlacement::SetThreadCpus(m_previousCpus);
+	}
+	MsvThreadPlacement::SetThreadMemoryPolicy(m_previousMemoryPolicy);
+}
+
+
+/********************************************************************************************************************************
+*															MsvPlacementScope public methods
+********************************************************************************************************************************/
+
+
+MsvErrorCode MsvPlacementScope::GetErrorCode() const
+{
+	return m_errorCode;
+}
+
+
+/********************************************************************************************************************************
+*															MsvThreadFactory constructors and destructors
+********************************************************************************************************************************/
+
+
+MsvThreadFactory::MsvThreadFactory(const MsvModulePlacement& placement):
+	m_placement(placement)
+{
+
+}
+
+MsvThreadFactory::~MsvThreadFactory()
+{
+
+}
+
+
+/********************************************************************************************************************************
+*															IMsvThreadFactory public methods
+********************************************************************************************************************************/
+
+
+MsvErrorCode MsvThreadFactory::CreateThread(std::function<void()> function, std::thread& thread)
+{
+	if (!function || thread.joinable())
+	{
+		//empty function or thread has not been joined
+		return MSV_INVALID_DATA_ERROR;
+	}
+
+	try
+	{
+		MsvModulePlacement placement = m_placement;
+		thread = std::thread([placement, function]()
+		{
+			//placement is a hint -> run function even when it could not be applied
+			MsvThreadPlacement::Apply(placement);
+			function();
+		});
+	}
+	catch (const std::system_error&)
+	{
+		return MSV_ALLOCATION_ERROR;
+	}
+
+	return MSV_SUCCESS;
+}
+
+
+/********************************************************************************************************************************
+*															MsvThreadFactory public methods
+********************************************************************************************************************************/
+
+
+const MsvModulePlacement& MsvThreadFactory::GetPlacement() const
+{
+	return m_placement;
+}
+
+
+/** @} */	//End of group MMODULE.
@@ -0,0 +1,292 @@
+/**************************************************************************************************//**
+* @addtogroup	MMODULE
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Module Placement
+* @details		Contains definition of @ref MsvModulePlacement (CPU set and NUMA node of module),
+*					@ref MsvThreadPlacement (applies placement to thread), @ref MsvPlacementScope (applies placement
+*					for scope) and @ref MsvThreadFactory (creates threads with placement).
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Module Library.
+
+MarsTech Dependency Injection is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef MARSTECH_MODULEPLACEMENT_H
+#define MARSTECH_MODULEPLACEMENT_H
+
+
+#include "IMsvThreadFactory.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <cstdint>
+#include <vector>
+
+MSV_ENABLE_WARNINGS
+
+
+/**************************************************************************************************//**
+* @brief		Any NUMA node.
+* @details	Memory is allocated by default policy of operating system.
+******************************************************************************************************/
+static const int32_t MSV_NUMA_NODE_ANY = -1;
+
+
+/**************************************************************************************************//**
+* @brief		Module placement.
+* @details	CPUs and NUMA node of module threads. Threads run on CPUs from CPU set (CPUs of NUMA node when CPU set is
+*				empty) and memory they allocate is preferably placed on NUMA node.
+******************************************************************************************************/
+struct MsvModulePlacement
+{
+	/**************************************************************************************************//**
+	* @brief		Constructor.
+	* @details	Default placement (any CPU and any NUMA node).
+	******************************************************************************************************/
+	MsvModulePlacement():
+		numaNode(MSV_NUMA_NODE_ANY)
+	{
+
+	}
+
+	std::vector<uint32_t> cpus;						///< CPU set (empty = CPUs of NUMA node or any CPU).
+	int32_t numaNode;										///< NUMA node (MSV_NUMA_NODE_ANY = any node).
+};
+
+
+/**************************************************************************************************//**
+* @brief		Thread memory policy.
+* @details	Raw memory policy of thread (Linux mode and node mask) - it is used to save and restore any policy
+*				(e.g. interleave or bind set by application), not only preferred node set by module placement.
+******************************************************************************************************/
+struct MsvThreadMemoryPolicy
+{
+	/**************************************************************************************************//**
+	* @brief		Constructor.
+	* @details	Default memory policy.
+	******************************************************************************************************/
+	MsvThreadMemoryPolicy():
+		mode(0)
+	{
+
+	}
+
+	int32_t mode;											///< Memory policy mode including mode flags (0 = default policy).
+	std::vector<unsigned long> nodeMask;			///< Node mask of memory policy (empty = no node).
+};
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Thread Placement.
+* @details	Gets and sets CPU affinity and NUMA memory node of current thread. It is implemented on Linux (affinity and
+*				preferred memory node) and Windows (affinity of processor group 0 - memory follows CPUs), other
+*				platforms ignore placement.
+******************************************************************************************************/
+class MsvThreadPlacement
+{
+public:
+	/**************************************************************************************************//**
+	* @brief			Apply placement.
+	* @details		Sets CPU affinity and NUMA memory node of current thread.
+	* @param[in]	placement					Module placement.
+	* @retval		MSV_NOT_FOUND_ERROR		When NUMA node does not exist.
+	* @retval		MSV_INVALID_DATA_ERROR	When CPU set or NUMA node could not be set.
+	* @retval		MSV_SUCCESS					On success.
+	******************************************************************************************************/
+	static MsvErrorCode Apply(const MsvModulePlacement& placement);
+
+	/**************************************************************************************************//**
+	* @brief			Get thread CPUs.
+	* @details		Returns CPU affinity of current thread.
+	* @param[out]	cpus							CPU set.
+	* @retval		MSV_INVALID_DATA_ERROR	When CPU affinity could not be read.
+	* @retval		MSV_SUCCESS					On success.
+	******************************************************************************************************/
+	static MsvErrorCode GetThreadCpus(std::vector<uint32_t>& cpus);
+
+	/**************************************************************************************************//**
+	* @brief			Set thread CPUs.
+	* @details		Sets CPU affinity of current thread.
+	* @param[in]	cpus							CPU set (it must not be empty).
+	* @retval		MSV_INVALID_DATA_ERROR	When CPU set is empty, it contains not existing CPU or it could not be set.
+	* @retval		MSV_SUCCESS					On success.
+	******************************************************************************************************/
+	static MsvErrorCode SetThreadCpus(const std::vector<uint32_t>& cpus);
+
+	/**************************************************************************************************//**
+	* @brief			Get thread NUMA node.
+	* @details		Returns preferred memory node of current thread.
+	* @param[out]	numaNode						NUMA node (MSV_NUMA_NODE_ANY when memory policy is not preferred node).
+	* @note			Use @ref GetThreadMemoryPolicy to save other memory policies.
+	* @retval		MSV_INVALID_DATA_ERROR	When memory policy could not be read.
+	* @retval		MSV_SUCCESS					On success.
+	******************************************************************************************************/
+	static MsvErrorCode GetThreadNumaNode(int32_t& numaNode);
+
+	/**************************************************************************************************//**
+	* @brief			Set thread NUMA node.
+	* @details		Sets preferred memory node of current thread (memory is allocated from other nodes when node is
+	*					full).
+	* @param[in]	numaNode						NUMA node (MSV_NUMA_NODE_ANY sets default memory policy).
+	* @retval		MSV_INVALID_DATA_ERROR	When memory policy could not be set.
+	* @retval		MSV_SUCCESS					On success.
+	******************************************************************************************************/
+	static MsvErrorCode SetThreadNumaNode(int32_t numaNode);
+
+	/**************************************************************************************************//**
+	* @brief			Get thread memory policy.
+	* @details		Returns raw memory policy of current thread (default policy on platforms without memory policy).
+	* @param[out]	memoryPolicy				Memory policy.
+	* @retval		MSV_INVALID_DATA_ERROR	When memory policy could not be read.
+	* @retval		MSV_SUCCESS					On success.
+	******************************************************************************************************/
+	static MsvErrorCode GetThreadMemoryPolicy(MsvThreadMemoryPolicy& memoryPolicy);
+
+	/**************************************************************************************************//**
+	* @brief			Set thread memory policy.
+	* @details		Sets raw memory policy of current thread (returned by @ref GetThreadMemoryPolicy).
+	* @param[in]	memoryPolicy				Memory policy.
+	* @retval		MSV_INVALID_DATA_ERROR	When memory policy could not be set.
+	* @retval		MSV_SUCCESS					On success.
+	******************************************************************************************************/
+	static MsvErrorCode SetThreadMemoryPolicy(const MsvThreadMemoryPolicy& memoryPolicy);
+
+	/**************************************************************************************************//**
+	* @brief			Get NUMA node CPUs.
+	* @details		Returns CPUs of NUMA node.
+	* @param[in]	numaNode						NUMA node.
+	* @param[out]	cpus							CPUs of NUMA node.
+	* @retval		MSV_NOT_FOUND_ERROR		When NUMA node does not exist.
+	* @retval		MSV_SUCCESS					On success.
+	******************************************************************************************************/
+	static MsvErrorCode GetNumaNodeCpus(int32_t numaNode, std::vector<uint32_t>& cpus);
+};
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Placement Scope.
+* @details	Applies placement to current thread in constructor and restores previous CPU affinity and memory policy
+*				in destructor.
+******************************************************************************************************/
+class MsvPlacementScope
+{
+public:
+	/**************************************************************************************************//**
+	* @brief			Constructor.
+	* @param[in]	pPlacement			Module placement (nullptr = placement is not changed).
+	******************************************************************************************************/
+	MsvPlacementScope(const MsvModulePlacement* pPlacement);
+
+	/**************************************************************************************************//**
+	* @brief		Destructor.
+	* @details	Restores previous placement.
+	******************************************************************************************************/
+	~MsvPlacementScope();
+
+	MsvPlacementScope(const MsvPlacementScope&) = delete;
+	MsvPlacementScope& operator=(const MsvPlacementScope&) = delete;
+
+	/**************************************************************************************************//**
+	* @brief		Get error code.
+	* @details	Returns result of @ref MsvThreadPlacement::Apply (MSV_SUCCESS when placement is not set).
+	* @returns	MsvErrorCode
+	******************************************************************************************************/
+	MsvErrorCode GetErrorCode() const;
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Applied flag.
+	* @details	Flag if placement has been changed (true) or not (false).
+	******************************************************************************************************/
+	bool m_applied;
+
+	/**************************************************************************************************//**
+	* @brief		Result of apply.
+	******************************************************************************************************/
+	MsvErrorCode m_errorCode;
+
+	/**************************************************************************************************//**
+	* @brief		Previous CPU set (empty when it could not be read).
+	******************************************************************************************************/
+	std::vector<uint32_t> m_previousCpus;
+
+	/**************************************************************************************************//**
+	* @brief		Previous memory policy (restored verbatim).
+	******************************************************************************************************/
+	MsvThreadMemoryPolicy m_previousMemoryPolicy;
+};
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Thread Factory.
+* @details	Creates threads which apply module placement before they run thread function.
+******************************************************************************************************/
+class MsvThreadFactory:
+	public IMsvThreadFactory
+{
+public:
+	/**************************************************************************************************//**
+	* @brief			Constructor.
+	* @param[in]	placement			Module placement.
+	******************************************************************************************************/
+	MsvThreadFactory(const MsvModulePlacement& placement = MsvModulePlacement());
+
+	/**************************************************************************************************//**
+	* @brief		Virtual destructor.
+	******************************************************************************************************/
+	virtual ~MsvThreadFactory();
+
+	/*-----------------------------------------------------------------------------------------------------
+	**											IMsvThreadFactory public methods
+	**---------------------------------------------------------------------------------------------------*/
+public:
+	/**************************************************************************************************//**
+	* @copydoc IMsvThreadFactory::CreateThread(std::function<void()> function, std::thread& thread)
+	* @note		Thread runs function even when placement could not be applied (placement is a hint).
+	******************************************************************************************************/
+	virtual MsvErrorCode CreateThread(std::function<void()> function, std::thread& thread) override;
+
+	/*-----------------------------------------------------------------------------------------------------
+	**											MsvThreadFactory public methods
+	**---------------------------------------------------------------------------------------------------*/
+public:
+	/**************************************************************************************************//**
+	* @brief		Get placement.
+	* @returns	const MsvModulePlacement&
+	******************************************************************************************************/
+	virtual const MsvModulePlacement& GetPlacement() const;
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Module placement.
+	* @details	Placement of created threads (it is not changed after construction).
+	******************************************************************************************************/
+	MsvModulePlacement m_placement;
+};
+
+
+#endif // !MARSTECH_MODULEPLACEMENT_H
+
+/** @} */	//End of group MMODULE.
@@ -0,0 +1,308 @@
+/**************************************************************************************************//**
+* @addtogroup	MMODULE
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Module Retry
+* @details		Contains implementation of @ref MsvModuleRetry.
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Module Library.
+
+MarsTech Dependency Injection is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "MsvModuleRetry.h"
+
+#include "merror/MsvErrorCodes.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <algorithm>
+#include <system_error>
+
+MSV_ENABLE_WARNINGS
+
+
+/********************************************************************************************************************************
+*															Constructors and destructors
+********************************************************************************************************************************/
+
+
+MsvModuleRetry::MsvModuleRetry(MsvRetryFunction retry, std::shared_ptr<MsvLogger> spLogger):
+	m_retry(retry),
+	m_spLogger(spLogger),
+	m_policy(MSV_RETRY_DEFAULT_POLICY),
+	m_generation(0),
+	m_random(std::random_device()()),
+	m_stopping(false)
+{
+
+}
+
+MsvModuleRetry::~MsvModuleRetry()
+{
+	Stop();
+}
+
+
+/********************************************************************************************************************************
+*															MsvModuleRetry public methods
+********************************************************************************************************************************/
+
+
+MsvErrorCode MsvModuleRetry::SetPolicy(const MsvRetryPolicy& policy)
+{
+	if (policy.initialDelay <= std::chrono::milliseconds::zero() || policy.maxDelay < policy.initialDelay || policy.jitter < 0.0 || policy.jitter > 1.0)
+	{
+		return MSV_INVALID_DATA_ERROR;
+	}
+
+	if (policy.breakerThreshold != 0 && (policy.breakerWindow <= std::chrono::milliseconds::zero() || policy.breakerCooldown <= std::chrono::milliseconds::zero()))
+	{
+		return MSV_INVALID_DATA_ERROR;
+	}
+
+	std::lock_guard<std::mutex> lock(m_lock);
+
+	m_policy = policy;
+
+	return MSV_SUCCESS;
+}
+
+MsvErrorCode MsvModuleRetry::Schedule(int32_t moduleId)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+
+	if (m_entries.find(moduleId) != m_entries.end())
+	{
+		return MSV_ALREADY_EXISTS_ERROR;
+	}
+
+	if (!m_thread.joinable())
+	{
+		try
+		{
+			m_thread = std::thread(&MsvModuleRetry::Run, this);
+		}
+		catch (const std::system_error&)
+		{
+			return MSV_ALLOCATION_ERROR;
+		}
+	}
+
+	MsvRetryEntry& entry = m_entries[moduleId];
+	entry.generation = ++m_generation;
+	entry.failureCount = 0;
+	entry.breakerOpen = false;
+	entry.running = false;
+
+	std::map<int32_t, std::deque<std::chrono::steady_clock::time_point>>::iterator historyIt = m_failureHistory.find(moduleId);
+	if (historyIt != m_failureHistory.end())
+	{
+		entry.failures.swap(historyIt->second);
+		m_failureHistory.erase(historyIt);
+	}
+
+	RecordFailure(moduleId, entry);
+
+	m_condition.notify_all();
+
+	return MSV_SUCCESS;
+}
+
+void MsvModuleRetry::Cancel(int32_t moduleId)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+
+	m_entries.erase(moduleId);
+	m_failureHistory.erase(moduleId);
+}
+
+void MsvModuleRetry::CancelAll()
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+
+	m_entries.clear();
+	m_failureHistory.clear();
+}
+
+void MsvModuleRetry::Stop()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+
+		m_entries.clear();
+		m_failureHistory.clear();
+
+		if (!m_thread.joinable())
+		{
+			return;
+		}
+
+		m_stopping = true;
+		m_condition.notify_all();
+	}
+
+	m_thread.join();
+
+	//retry can be scheduled again (new retry thread is created)
+	std::lock_guard<std::mutex> lock(m_lock);
+	m_stopping = false;
+}
+
+MsvErrorCode MsvModuleRetry::GetRetryState(int32_t moduleId, MsvModuleRetryState& state) const
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+
+	std::map<int32_t, MsvRetryEntry>::const_iterator it = m_entries.find(moduleId);
+	if (it == m_entries.end())
+	{
+		return MSV_NOT_FOUND_ERROR;
+	}
+
+	state.failureCount = it->second.failureCount;
+	state.breakerOpen = it->second.breakerOpen;
+	state.nextRetry = it->second.nextRetry;
+
+	return MSV_SUCCESS;
+}
+
+std::chrono::milliseconds MsvModuleRetry::GetBackoffDelay(const MsvRetryPolicy& policy, uint32_t failureCount, double random)
+{
+	//delay is doubled by every failed retry (until it reaches max delay)
+	double delay = static_cast<double>(policy.initialDelay.count());
+	double maxDelay = static_cast<double>(policy.maxDelay.count());
+	for (uint32_t failure = 1; failure < failureCount && delay < maxDelay; ++failure)
+	{
+		delay *= 2.0;
+	}
+
+	delay = std::min(delay, maxDelay);
+
+	//randomized part spreads retries of modules which failed together
+	delay *= 1.0 - policy.jitter * random;
+
+	return std::chrono::milliseconds(static_cast<std::chrono::milliseconds::rep>(delay));
+}
+
+
+/********************************************************************************************************************************
+*															MsvModuleRetry protected methods
+********************************************************************************************************************************/
+
+
+void MsvModuleRetry::Run()
+{
+	std::unique_lock<std::mutex> lock(m_lock);
+
+	while (!m_stopping)
+	{
+		//find the earliest retry
+		std::map<int32_t, MsvRetryEntry>::iterator nextIt = m_entries.end();
+		for (std::map<int32_t, MsvRetryEntry>::iterator it = m_entries.begin(); it != m_entries.end(); ++it)
+		{
+			if (!it->second.running && (nextIt == m_entries.end() || it->second.nextRetry < nextIt->second.nextRetry))
+			{
+				nextIt = it;
+			}
+		}
+
+		if (nextIt == m_entries.end())
+		{
+			m_condition.wait(lock);
+			continue;
+		}
+
+		if (nextIt->second.nextRetry > std::chrono::steady_clock::now())
+		{
+			//entry can be canceled while waiting (wait must not refer to it)
+			std::chrono::steady_clock::time_point nextRetry = nextIt->second.nextRetry;
+			m_condition.wait_until(lock, nextRetry);
+			continue;
+		}
+
+		int32_t moduleId = nextIt->first;
+		uint64_t generation = nextIt->second.generation;
+		nextIt->second.running = true;
+
+		//retry out of lock (it can schedule and cancel retries)
+		lock.unlock();
+		MSV_LOG_INFO(m_spLogger, "Retrying module {}.", moduleId);
+		MsvErrorCode errorCode = m_retry(moduleId);
+		lock.lock();
+
+		std::map<int32_t, MsvRetryEntry>::iterator it = m_entries.find(moduleId);
+		if (it == m_entries.end() || it->second.generation != generation)
+		{
+			//retry has been canceled meanwhile
+			continue;
+		}
+
+		it->second.running = false;
+
+		if (!MSV_FAILED(errorCode))
+		{
+			MSV_LOG_INFO(m_spLogger, "Retry of module {} succeeded after {} failures.", moduleId, it->second.failureCount);
+			m_failureHistory[moduleId].swap(it->second.failures);
+			m_entries.erase(it);
+			continue;
+		}
+
+		MSV_LOG_ERROR(m_spLogger, "Retry of module {} failed with error: {0:x}", moduleId, errorCode);
+		RecordFailure(moduleId, it->second);
+	}
+}
+
+void MsvModuleRetry::RecordFailure(int32_t moduleId, MsvRetryEntry& entry)
+{
+	std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+
+	++entry.failureCount;
+	entry.failures.push_back(now);
+	while (!entry.failures.empty() && now - entry.failures.front() > m_policy.breakerWindow)
+	{
+		entry.failures.pop_front();
+	}
+
+	//failed retry of open breaker (after cooldown) opens it again
+	if (entry.breakerOpen || (m_policy.breakerThreshold != 0 && entry.failures.size() >= m_policy.breakerThreshold))
+	{
+		if (!entry.breakerOpen)
+		{
+			MSV_LOG_ERROR(m_spLogger, "Module {} failed {} times - circuit breaker is open for {} ms.", moduleId, entry.failures.size(), m_policy.breakerCooldown.count());
+		}
+
+		entry.breakerOpen = true;
+		entry.nextRetry = now + m_policy.breakerCooldown;
+		return;
+	}
+
+	std::uniform_real_distribution<double> distribution(0.0, 1.0);
+	std::chrono::milliseconds delay = GetBackoffDelay(m_policy, entry.failureCount, distribution(m_random));
+	entry.nextRetry = now + delay;
+
+	MSV_LOG_INFO(m_spLogger, "Module {} will be retried in {} ms.", moduleId, delay.count());
+}
+
+
+/** @} */	//End of group MMODULE.
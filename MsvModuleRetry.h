@@ -0,0 +1,288 @@
+/**************************************************************************************************//**
+* @addtogroup	MMODULE
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Module Retry
+* @details		Contains definition of @ref MsvModuleRetry (background retry of failed module initialization with
+*					exponential backoff, jitter and circuit breaker).
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Module Library.
+
+MarsTech Dependency Injection is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef MARSTECH_MODULERETRY_H
+#define MARSTECH_MODULERETRY_H
+
+
+#include "mlogging/mlogging.h"
+#include "merror/MsvError.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
+
+MSV_ENABLE_WARNINGS
+
+
+/**************************************************************************************************//**
+* @brief		Retry policy.
+* @details	Backoff of retries and circuit breaker of flapping modules.
+******************************************************************************************************/
+struct MsvRetryPolicy
+{
+	std::chrono::milliseconds initialDelay;	///< Delay of the first retry (it is doubled by every failed retry).
+	std::chrono::milliseconds maxDelay;			///< Maximal delay of retry.
+	double jitter;										///< Part of delay which is randomized (0 = no jitter, 1 = full jitter).
+	uint32_t breakerThreshold;						///< Number of failures in breaker window which opens circuit breaker (0 = no breaker).
+	std::chrono::milliseconds breakerWindow;	///< Window in which failures are counted.
+	std::chrono::milliseconds breakerCooldown;	///< How long circuit breaker stays open (then one retry is allowed).
+};
+
+/**************************************************************************************************//**
+* @brief		Default retry policy.
+* @details	Retries after 100 ms up to 30 s with half of delay randomized. Module which fails 5 times in a minute is
+*				not retried for 5 minutes.
+******************************************************************************************************/
+static const MsvRetryPolicy MSV_RETRY_DEFAULT_POLICY =
+{
+	std::chrono::milliseconds(100),
+	std::chrono::milliseconds(30000),
+	0.5,
+	5,
+	std::chrono::milliseconds(60000),
+	std::chrono::milliseconds(300000)
+};
+
+
+/**************************************************************************************************//**
+* @brief		Module retry state.
+* @details	State of retries of module (snapshot).
+******************************************************************************************************/
+struct MsvModuleRetryState
+{
+	uint32_t failureCount;										///< Number of failures (initial failure and failed retries).
+	bool breakerOpen;												///< Flag if circuit breaker is open (true) or closed (false).
+	std::chrono::steady_clock::time_point nextRetry;	///< Time of next retry.
+};
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Module Retry.
+* @details	Retries failed modules in background. Retries run one by one on retry thread (they never occupy worker
+*				threads of thread pool) with exponential backoff and jitter. Module which fails too often in breaker window
+*				opens circuit breaker - it is not retried until breaker cooldown expires, then it gets one retry (another
+*				failure opens breaker again). Retry thread is created by the first scheduled retry.
+******************************************************************************************************/
+class MsvModuleRetry
+{
+public:
+	/**************************************************************************************************//**
+	* @brief			Retry function.
+	* @details		Retries module (called on retry thread). Module is retried again when it returns error.
+	******************************************************************************************************/
+	typedef std::function<MsvErrorCode(int32_t moduleId)> MsvRetryFunction;
+
+	/**************************************************************************************************//**
+	* @brief			Constructor.
+	* @param[in]	retry					Retry function.
+	* @param[in]	spLogger				Shared pointer to logger for logging.
+	******************************************************************************************************/
+	MsvModuleRetry(MsvRetryFunction retry, std::shared_ptr<MsvLogger> spLogger);
+
+	/**************************************************************************************************//**
+	* @brief		Virtual destructor.
+	* @details	Stops retry thread.
+	******************************************************************************************************/
+	virtual ~MsvModuleRetry();
+
+	MsvModuleRetry(const MsvModuleRetry&) = delete;
+	MsvModuleRetry& operator=(const MsvModuleRetry&) = delete;
+
+	/**************************************************************************************************//**
+	* @brief			Set retry policy.
+	* @details		Policy is used since the next failure.
+	* @param[in]	policy								Retry policy.
+	* @retval		MSV_INVALID_DATA_ERROR			When delays are not positive or jitter is not in <0, 1>.
+	* @retval		MSV_SUCCESS							On success.
+	******************************************************************************************************/
+	virtual MsvErrorCode SetPolicy(const MsvRetryPolicy& policy);
+
+	/**************************************************************************************************//**
+	* @brief			Schedule retry.
+	* @details		Records failure of module and schedules its retry (it does nothing when module is already
+	*					scheduled). Retry thread is started when it is not running.
+	* @param[in]	moduleId								Module ID.
+	* @retval		MSV_ALREADY_EXISTS_ERROR		When module is already scheduled.
+	* @retval		MSV_ALLOCATION_ERROR				When retry thread can not be created.
+	* @retval		MSV_SUCCESS							On success.
+	******************************************************************************************************/
+	virtual MsvErrorCode Schedule(int32_t moduleId);
+
+	/**************************************************************************************************//**
+	* @brief			Cancel retry.
+	* @details		Module is not retried any more (retry which is running is not interrupted, but its result is ignored).
+	* @param[in]	moduleId								Module ID.
+	******************************************************************************************************/
+	virtual void Cancel(int32_t moduleId);
+
+	/**************************************************************************************************//**
+	* @brief		Cancel all retries.
+	******************************************************************************************************/
+	virtual void CancelAll();
+
+	/**************************************************************************************************//**
+	* @brief		Stop retry thread.
+	* @details	Cancels all retries and waits until retry which is running finishes. It must not be called from retry
+	*				function or with lock which retry function locks.
+	******************************************************************************************************/
+	virtual void Stop();
+
+	/**************************************************************************************************//**
+	* @brief			Get retry state.
+	* @param[in]	moduleId								Module ID.
+	* @param[out]	state									Retry state of module.
+	* @retval		MSV_NOT_FOUND_ERROR				When module is not scheduled.
+	* @retval		MSV_SUCCESS							On success.
+	******************************************************************************************************/
+	virtual MsvErrorCode GetRetryState(int32_t moduleId, MsvModuleRetryState& state) const;
+
+	/**************************************************************************************************//**
+	* @brief			Get backoff delay.
+	* @details		Returns exponential delay of retry (capped by max delay) with randomized part given by jitter.
+	* @param[in]	policy								Retry policy.
+	* @param[in]	failureCount						Number of failures (1 = first retry).
+	* @param[in]	random								Random number in <0, 1).
+	* @returns		std::chrono::milliseconds
+	******************************************************************************************************/
+	static std::chrono::milliseconds GetBackoffDelay(const MsvRetryPolicy& policy, uint32_t failureCount, double random);
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Scheduled module.
+	******************************************************************************************************/
+	struct MsvRetryEntry
+	{
+		uint64_t generation;												///< Generation (scheduled again module is new entry).
+		uint32_t failureCount;											///< Number of failures.
+		std::deque<std::chrono::steady_clock::time_point> failures;	///< Times of failures in breaker window.
+		bool breakerOpen;													///< Circuit breaker flag.
+		bool running;														///< Flag if retry is running.
+		std::chrono::steady_clock::time_point nextRetry;		///< Time of next retry.
+	};
+
+	/**************************************************************************************************//**
+	* @brief		Retry thread.
+	* @details	Runs due retries until retry is stopped.
+	******************************************************************************************************/
+	void Run();
+
+	/**************************************************************************************************//**
+	* @brief			Record failure.
+	* @details		Counts failure of module and plans its next retry (or opens circuit breaker). Retry must be locked.
+	* @param[in]	moduleId								Module ID.
+	* @param[in]	entry									Scheduled module.
+	******************************************************************************************************/
+	void RecordFailure(int32_t moduleId, MsvRetryEntry& entry);
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Retry mutex.
+	* @details	Locks scheduled modules, policy and retry thread (retry function is called out of lock).
+	******************************************************************************************************/
+	mutable std::mutex m_lock;
+
+	/**************************************************************************************************//**
+	* @brief		Retry condition variable.
+	* @details	Wakes retry thread.
+	******************************************************************************************************/
+	std::condition_variable m_condition;
+
+	/**************************************************************************************************//**
+	* @brief		Retry function.
+	******************************************************************************************************/
+	MsvRetryFunction m_retry;
+
+	/**************************************************************************************************//**
+	* @brief		Logger.
+	* @details	Shared pointer to logger for logging.
+	******************************************************************************************************/
+	std::shared_ptr<MsvLogger> m_spLogger;
+
+	/**************************************************************************************************//**
+	* @brief		Retry policy.
+	******************************************************************************************************/
+	MsvRetryPolicy m_policy;
+
+	/**************************************************************************************************//**
+	* @brief		Scheduled modules.
+	* @details	Retry entries by module ID.
+	******************************************************************************************************/
+	std::map<int32_t, MsvRetryEntry> m_entries;
+
+	/**************************************************************************************************//**
+	* @brief		Failure history.
+	* @details	Times of failures of modules which have been retried successfully. Module which is scheduled again (e.g.
+	*				restarted by watchdog) continues with them - circuit breaker also stops modules which flap between success
+	*				and failure.
+	******************************************************************************************************/
+	std::map<int32_t, std::deque<std::chrono::steady_clock::time_point>> m_failureHistory;
+
+	/**************************************************************************************************//**
+	* @brief		Generation.
+	* @details	Generation of the last scheduled entry.
+	******************************************************************************************************/
+	uint64_t m_generation;
+
+	/**************************************************************************************************//**
+	* @brief		Random generator.
+	* @details	Generates jitter of delays.
+	******************************************************************************************************/
+	std::mt19937 m_random;
+
+	/**************************************************************************************************//**
+	* @brief		Retry thread.
+	******************************************************************************************************/
+	std::thread m_thread;
+
+	/**************************************************************************************************//**
+	* @brief		Stopping flag.
+	* @details	Flag if retry thread should exit.
+	******************************************************************************************************/
+	bool m_stopping;
+};
+
+
+#endif // !MARSTECH_MODULERETRY_H
+
+/** @} */	//End of group MMODULE.
@@ -0,0 +1,167 @@
+/**************************************************************************************************//**
+* @addtogroup	MMODULE
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Module Timings
+* @details		Contains implementation of @ref MsvModuleTimings.
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Module Library.
+
+MarsTech Dependency Injection is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "MsvModuleTimings.h"
+
+#include "merror/MsvErrorCodes.h"
+
+
+/********************************************************************************************************************************
+*															Constructors and destructors
+********************************************************************************************************************************/
+
+
+MsvModuleTimings::MsvModuleTimings()
+{
+
+}
+
+
+MsvModuleTimings::~MsvModuleTimings()
+{
+
+}
+
+
+/********************************************************************************************************************************
+*															Public methods
+********************************************************************************************************************************/
+
+
+void MsvModuleTimings::Record(int32_t moduleId, MsvModuleTransition transition, std::chrono::nanoseconds duration, MsvErrorCode errorCode)
+{
+	size_t transitionIndex = static_cast<size_t>(transition);
+	if (transitionIndex >= static_cast<size_t>(MsvModuleTransition::MSV_MODULE_TRANSITION_COUNT))
+	{
+		return;
+	}
+
+	std::lock_guard<std::recursive_mutex> lock(m_lock);
+
+	std::unordered_map<int32_t, std::array<MsvModuleTransitionStatistics, static_cast<size_t>(MsvModuleTransition::MSV_MODULE_TRANSITION_COUNT)>>::iterator it = m_timings.find(moduleId);
+	if (it == m_timings.end())
+	{
+		//first transition of module -> zero all its statistics
+		std::array<MsvModuleTransitionStatistics, static_cast<size_t>(MsvModuleTransition::MSV_MODULE_TRANSITION_COUNT)> moduleTimings = {};
+		it = m_timings.emplace(moduleId, moduleTimings).first;
+	}
+
+	MsvModuleTransitionStatistics& statistics = it->second[transitionIndex];
+	if (statistics.count == 0 || duration < statistics.min)
+	{
+		statistics.min = duration;
+	}
+	if (duration > statistics.max)
+	{
+		statistics.max = duration;
+	}
+
+	++statistics.count;
+	if (MSV_FAILED(errorCode))
+	{
+		++statistics.failures;
+	}
+	statistics.lastErrorCode = errorCode;
+	statistics.last = duration;
+	statistics.total += duration;
+	++statistics.histogram[GetBucket(duration)];
+}
+
+MsvErrorCode MsvModuleTimings::GetStatistics(int32_t moduleId, MsvModuleTransition transition, MsvModuleTransitionStatistics& statistics) const
+{
+	size_t transitionIndex = static_cast<size_t>(transition);
+	if (transitionIndex >= static_cast<size_t>(MsvModuleTransition::MSV_MODULE_TRANSITION_COUNT))
+	{
+		return MSV_INVALID_DATA_ERROR;
+	}
+
+	std::lock_guard<std::recursive_mutex> lock(m_lock);
+
+	std::unordered_map<int32_t, std::array<MsvModuleTransitionStatistics, static_cast<size_t>(MsvModuleTransition::MSV_MODULE_TRANSITION_COUNT)>>::const_iterator it = m_timings.find(moduleId);
+	if (it == m_timings.end() || it->second[transitionIndex].count == 0)
+	{
+		return MSV_NOT_FOUND_ERROR;
+	}
+
+	statistics = it->second[transitionIndex];
+
+	return MSV_SUCCESS;
+}
+
+std::chrono::nanoseconds MsvModuleTimings::GetLastDuration(int32_t moduleId, MsvModuleTransition transition) const
+{
+	MsvModuleTransitionStatistics statistics;
+	if (MSV_FAILED(GetStatistics(moduleId, transition, statistics)))
+	{
+		return std::chrono::nanoseconds::zero();
+	}
+
+	return statistics.last;
+}
+
+void MsvModuleTimings::GetModuleIds(std::vector<int32_t>& moduleIds) const
+{
+	std::lock_guard<std::recursive_mutex> lock(m_lock);
+
+	moduleIds.clear();
+	moduleIds.reserve(m_timings.size());
+	for (std::unordered_map<int32_t, std::array<MsvModuleTransitionStatistics, static_cast<size_t>(MsvModuleTransition::MSV_MODULE_TRANSITION_COUNT)>>::const_iterator it = m_timings.begin(); it != m_timings.end(); ++it)
+	{
+		moduleIds.push_back(it->first);
+	}
+}
+
+void MsvModuleTimings::Reset()
+{
+	std::lock_guard<std::recursive_mutex> lock(m_lock);
+
+	m_timings.clear();
+}
+
+size_t MsvModuleTimings::GetBucket(std::chrono::nanoseconds duration)
+{
+	uint64_t microseconds = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(duration).count());
+
+	//index of highest set bit (0 for durations shorter than 2 us)
+	size_t bucket = 0;
+	while (microseconds > 1 && bucket < MSV_MODULE_TIMING_BUCKETS - 1)
+	{
+		microseconds >>= 1;
+		++bucket;
+	}
+
+	return bucket;
+}
+
+
+/** @} */	//End of group MMODULE.
@@ -0,0 +1,178 @@
+/**************************************************************************************************//**
+* @addtogroup	MMODULE
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Module Timings
+* @details		Contains definition of @ref MsvModuleTimings (lifecycle timing metrics of modules).
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Module Library.
+
+MarsTech Dependency Injection is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef MARSTECH_MODULETIMINGS_H
+#define MARSTECH_MODULETIMINGS_H
+
+
+#include "merror/MsvError.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+MSV_ENABLE_WARNINGS
+
+
+/**************************************************************************************************//**
+* @brief		Module transition.
+* @details	Lifecycle transitions of module done by module manager.
+******************************************************************************************************/
+enum class MsvModuleTransition: int32_t
+{
+	MSV_MODULE_TRANSITION_INITIALIZE = 0,		///< @ref IMsvModule::Initialize
+	MSV_MODULE_TRANSITION_START,					///< @ref IMsvModule::Start
+	MSV_MODULE_TRANSITION_STOP,					///< @ref IMsvModule::Stop
+	MSV_MODULE_TRANSITION_UNINITIALIZE,			///< @ref IMsvModule::Uninitialize
+	MSV_MODULE_TRANSITION_COUNT					///< Number of transitions (it is not transition).
+};
+
+
+/**************************************************************************************************//**
+* @brief		Number of histogram buckets.
+* @details	Bucket 0 counts durations shorter than 2 us, bucket i counts durations in [2^i, 2^(i+1)) us
+*				and the last bucket counts all longer durations (longer than ~16 s).
+******************************************************************************************************/
+static const size_t MSV_MODULE_TIMING_BUCKETS = 25;
+
+
+/**************************************************************************************************//**
+* @brief		Module transition statistics.
+* @details	Timing statistics of one transition of one module (across all its restarts).
+******************************************************************************************************/
+struct MsvModuleTransitionStatistics
+{
+	uint64_t count;															///< Number of transitions.
+	uint64_t failures;														///< Number of failed transitions.
+	MsvErrorCode lastErrorCode;											///< Error code of last transition.
+	std::chrono::nanoseconds last;										///< Duration of last transition.
+	std::chrono::nanoseconds min;											///< Minimal duration.
+	std::chrono::nanoseconds max;											///< Maximal duration.
+	std::chrono::nanoseconds total;										///< Sum of all durations.
+	std::array<uint64_t, MSV_MODULE_TIMING_BUCKETS> histogram;		///< Histogram of durations (see @ref MSV_MODULE_TIMING_BUCKETS).
+};
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Module Timings.
+* @details	Records monotonic durations of lifecycle transitions of modules by module ID. Recording is
+*				one hash probe and few additions (no allocations after first transition of module).
+******************************************************************************************************/
+class MsvModuleTimings
+{
+public:
+	/**************************************************************************************************//**
+	* @brief		Constructor.
+	******************************************************************************************************/
+	MsvModuleTimings();
+
+	/**************************************************************************************************//**
+	* @brief		Virtual destructor.
+	******************************************************************************************************/
+	virtual ~MsvModuleTimings();
+
+	/**************************************************************************************************//**
+	* @brief			Record transition.
+	* @details		Records duration and result of one module transition.
+	* @param[in]	moduleId				Module ID.
+	* @param[in]	transition			Module transition.
+	* @param[in]	duration				Duration of transition.
+	* @param[in]	errorCode			Error code returned by transition.
+	******************************************************************************************************/
+	virtual void Record(int32_t moduleId, MsvModuleTransition transition, std::chrono::nanoseconds duration, MsvErrorCode errorCode);
+
+	/**************************************************************************************************//**
+	* @brief			Get transition statistics.
+	* @details		Returns timing statistics of one transition of one module.
+	* @param[in]	moduleId						Module ID.
+	* @param[in]	transition					Module transition.
+	* @param[out]	statistics					Timing statistics.
+	* @retval		MSV_INVALID_DATA_ERROR	When transition is not valid.
+	* @retval		MSV_NOT_FOUND_ERROR		When module has not done this transition yet.
+	* @retval		MSV_SUCCESS					On success.
+	******************************************************************************************************/
+	virtual MsvErrorCode GetStatistics(int32_t moduleId, MsvModuleTransition transition, MsvModuleTransitionStatistics& statistics) const;
+
+	/**************************************************************************************************//**
+	* @brief			Get last duration.
+	* @details		Returns duration of last transition of module (zero when module has not done it yet).
+	* @param[in]	moduleId						Module ID.
+	* @param[in]	transition					Module transition.
+	* @returns		std::chrono::nanoseconds
+	******************************************************************************************************/
+	virtual std::chrono::nanoseconds GetLastDuration(int32_t moduleId, MsvModuleTransition transition) const;
+
+	/**************************************************************************************************//**
+	* @brief			Get module IDs.
+	* @details		Returns IDs of all modules with recorded transitions.
+	* @param[out]	moduleIds					Module IDs.
+	******************************************************************************************************/
+	virtual void GetModuleIds(std::vector<int32_t>& moduleIds) const;
+
+	/**************************************************************************************************//**
+	* @brief			Reset timings.
+	* @details		Removes all recorded timings.
+	******************************************************************************************************/
+	virtual void Reset();
+
+	/**************************************************************************************************//**
+	* @brief			Get histogram bucket.
+	* @details		Returns histogram bucket of duration.
+	* @param[in]	duration						Duration.
+	* @returns		size_t
+	******************************************************************************************************/
+	static size_t GetBucket(std::chrono::nanoseconds duration);
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Module timings mutex.
+	* @details	Locks this object for thread safety access (it is independent on module manager mutex).
+	******************************************************************************************************/
+	mutable std::recursive_mutex m_lock;
+
+	/**************************************************************************************************//**
+	* @brief		Timings.
+	* @details	Timing statistics of all transitions by module ID.
+	******************************************************************************************************/
+	std::unordered_map<int32_t, std::array<MsvModuleTransitionStatistics, static_cast<size_t>(MsvModuleTransition::MSV_MODULE_TRANSITION_COUNT)>> m_timings;
+};
+
+
+#endif // !MARSTECH_MODULETIMINGS_H
+
+/** @} */	//End of group MMODULE.
@@ -0,0 +1,282 @@
+/**************************************************************************************************//**
+* @addtogroup	MMODULE
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech POSIX DLL Factory
+* @details		Contains implementation of @ref MsvPosixDllFactory.
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Module Library.
+
+MarsTech Dependency Injection is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "MsvPosixDllFactory.h"
+
+#if !defined(_WIN32)
+
+#include "merror/MsvErrorCodes.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <dlfcn.h>
+
+MSV_ENABLE_WARNINGS
+
+
+/********************************************************************************************************************************
+*															Constructors and destructors
+********************************************************************************************************************************/
+
+
+MsvPosixDllFactory::MsvPosixDllFactory(std::shared_ptr<MsvLogger> spLogger, MsvDllBinding defaultBinding, bool localSymbols, const char* getDllObjectSymbol):
+	m_defaultBinding(defaultBinding),
+	m_localSymbols(localSymbols),
+	m_getDllObjectSymbol(getDllObjectSymbol ? getDllObjectSymbol : "GetDllObject"),
+	m_spLogger(spLogger)
+{
+
+}
+
+
+MsvPosixDllFactory::~MsvPosixDllFactory()
+{
+	std::lock_guard<std::recursive_mutex> lock(m_lock);
+
+	for (std::unordered_map<std::string, MsvPosixDll>::iterator it = m_dlls.begin(); it != m_dlls.end(); ++it)
+	{
+		if (it->second.handle)
+		{
+			dlclose(it->second.handle);
+			it->second.handle = nullptr;
+		}
+	}
+}
+
+
+/********************************************************************************************************************************
+*															IMsvDllFactory public methods
+********************************************************************************************************************************/
+
+
+MsvErrorCode MsvPosixDllFactory::GetDllObject(const char* dllObjectId, std::shared_ptr<IMsvDllObject>& spDllObject)
+{
+	if (!dllObjectId)
+	{
+		return MSV_INVALID_DATA_ERROR;
+	}
+
+	//shared library is loaded and its symbol is resolved under lock
+	std::string dllPath;
+	MsvPosixDll* pDll = nullptr;
+	MsvGetDllObjectFunction getDllObject = nullptr;
+	{
+		std::lock_guard<std::recursive_mutex> lock(m_lock);
+
+		std::unordered_map<std::string, std::string>::const_iterator objectIt = m_dllObjects.find(dllObjectId);
+		if (objectIt == m_dllObjects.end())
+		{
+			MSV_LOG_ERROR(m_spLogger, "DLL object {} is not registered - failed with error: {0:x}", dllObjectId, MSV_NOT_FOUND_ERROR);
+			return MSV_NOT_FOUND_ERROR;
+		}
+
+		dllPath = objectIt->second;
+		pDll = &m_dlls[dllPath];
+		MSV_RETURN_FAILED(LoadDll(dllPath, *pDll));
+		getDllObject = pDll->getDllObject;
+	}
+
+	//object is created out of lock (modules of other shared libraries are created concurrently) - shared library is
+	//unloaded only by destructor and its entry is never removed
+	std::chrono::steady_clock::time_point callStart = std::chrono::steady_clock::now();
+	MsvErrorCode errorCode = getDllObject(dllObjectId, spDllObject);
+	std::chrono::nanoseconds callDuration = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - callStart);
+
+	std::lock_guard<std::recursive_mutex> lock(m_lock);
+
+	if (pDll->statistics.objectCount == 0 && pDll->statistics.firstCallDuration == std::chrono::nanoseconds::zero())
+	{
+		//first call resolves lazy bound symbols of shared library
+		pDll->statistics.firstCallDuration = callDuration;
+	}
+
+	if (MSV_FAILED(errorCode))
+	{
+		MSV_LOG_ERROR(m_spLogger, "Get DLL object {} from {} failed with error: {0:x}", dllObjectId, dllPath, errorCode);
+		return errorCode;
+	}
+
+	++pDll->statistics.objectCount;
+
+	return errorCode;
+}
+
+
+/********************************************************************************************************************************
+*															MsvPosixDllFactory public methods
+********************************************************************************************************************************/
+
+
+MsvErrorCode MsvPosixDllFactory::AddDllObject(const char* dllObjectId, const char* dllPath)
+{
+	return AddDllObject(dllObjectId, dllPath, m_defaultBinding);
+}
+
+MsvErrorCode MsvPosixDllFactory::AddDllObject(const char* dllObjectId, const char* dllPath, MsvDllBinding binding)
+{
+	if (!dllObjectId || !dllPath || !*dllPath)
+	{
+		return MSV_INVALID_DATA_ERROR;
+	}
+
+	std::lock_guard<std::recursive_mutex> lock(m_lock);
+
+	if (m_dllObjects.find(dllObjectId) != m_dllObjects.end())
+	{
+		MSV_LOG_ERROR(m_spLogger, "DLL object {} already exists - failed with error: {0:x}", dllObjectId, MSV_ALREADY_EXISTS_ERROR);
+		return MSV_ALREADY_EXISTS_ERROR;
+	}
+
+	std::unordered_map<std::string, MsvPosixDll>::iterator dllIt = m_dlls.find(dllPath);
+	if (dllIt == m_dlls.end())
+	{
+		MsvPosixDll dll;
+		dll.handle = nullptr;
+		dll.getDllObject = nullptr;
+		dll.statistics.loaded = false;
+		dll.statistics.binding = binding;
+		dll.statistics.loadDuration = std::chrono::nanoseconds::zero();
+		dll.statistics.symbolDuration = std::chrono::nanoseconds::zero();
+		dll.statistics.firstCallDuration = std::chrono::nanoseconds::zero();
+		dll.statistics.objectCount = 0;
+		m_dlls[dllPath] = dll;
+	}
+	else if (dllIt->second.statistics.binding != binding)
+	{
+		//one shared library can be loaded only with one binding mode
+		MSV_LOG_ERROR(m_spLogger, "DLL {} has been already registered with another binding - failed with error: {0:x}", dllPath, MSV_INVALID_DATA_ERROR);
+		return MSV_INVALID_DATA_ERROR;
+	}
+
+	m_dllObjects[dllObjectId] = dllPath;
+
+	return MSV_SUCCESS;
+}
+
+MsvErrorCode MsvPosixDllFactory::GetDllPath(const char* dllObjectId, std::string& dllPath) const
+{
+	if (!dllObjectId)
+	{
+		return MSV_INVALID_DATA_ERROR;
+	}
+
+	std::lock_guard<std::recursive_mutex> lock(m_lock);
+
+	std::unordered_map<std::string, std::string>::const_iterator it = m_dllObjects.find(dllObjectId);
+	if (it == m_dllObjects.end())
+	{
+		return MSV_NOT_FOUND_ERROR;
+	}
+
+	dllPath = it->second;
+
+	return MSV_SUCCESS;
+}
+
+MsvErrorCode MsvPosixDllFactory::GetDllLoadStatistics(const char* dllPath, MsvDllLoadStatistics& statistics) const
+{
+	if (!dllPath)
+	{
+		return MSV_INVALID_DATA_ERROR;
+	}
+
+	std::lock_guard<std::recursive_mutex> lock(m_lock);
+
+	std::unordered_map<std::string, MsvPosixDll>::const_iterator it = m_dlls.find(dllPath);
+	if (it == m_dlls.end())
+	{
+		return MSV_NOT_FOUND_ERROR;
+	}
+
+	statistics = it->second.statistics;
+
+	return MSV_SUCCESS;
+}
+
+
+/********************************************************************************************************************************
+*															MsvPosixDllFactory protected methods
+********************************************************************************************************************************/
+
+
+MsvErrorCode MsvPosixDllFactory::LoadDll(const std::string& dllPath, MsvPosixDll& dll)
+{
+	if (dll.getDllObject)
+	{
+		//shared library is loaded and symbol is cached
+		return MSV_SUCCESS;
+	}
+
+	if (!dll.handle)
+	{
+		int flags = dll.statistics.binding == MsvDllBinding::MSV_DLL_BINDING_NOW ? RTLD_NOW : RTLD_LAZY;
+		flags |= m_localSymbols ? RTLD_LOCAL : RTLD_GLOBAL;
+
+		std::chrono::steady_clock::time_point loadStart = std::chrono::steady_clock::now();
+		dll.handle = dlopen(dllPath.c_str(), flags);
+		dll.statistics.loadDuration = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - loadStart);
+
+		if (!dll.handle)
+		{
+			const char* dlError = dlerror();
+			MSV_LOG_ERROR(m_spLogger, "Load DLL {} failed ({}) with error: {0:x}", dllPath, dlError ? dlError : "", MSV_NOT_FOUND_ERROR);
+			return MSV_NOT_FOUND_ERROR;
+		}
+
+		dll.statistics.loaded = true;
+		MSV_LOG_INFO(m_spLogger, "DLL {} loaded in {} ns.", dllPath, dll.statistics.loadDuration.count());
+	}
+
+	//clear old error (symbol value can be nullptr)
+	dlerror();
+
+	std::chrono::steady_clock::time_point symbolStart = std::chrono::steady_clock::now();
+	void* symbol = dlsym(dll.handle, m_getDllObjectSymbol.c_str());
+	dll.statistics.symbolDuration = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - symbolStart);
+
+	const char* dlError = dlerror();
+	if (dlError || !symbol)
+	{
+		MSV_LOG_ERROR(m_spLogger, "DLL {} does not export {} ({}) - failed with error: {0:x}", dllPath, m_getDllObjectSymbol, dlError ? dlError : "", MSV_NOT_FOUND_ERROR);
+		return MSV_NOT_FOUND_ERROR;
+	}
+
+	dll.getDllObject = reinterpret_cast<MsvGetDllObjectFunction>(symbol);
+
+	return MSV_SUCCESS;
+}
+
+
+#endif // !defined(_WIN32)
+
+/** @} */	//End of group MMODULE.
@@ -0,0 +1,256 @@
+/**************************************************************************************************//**
+* @addtogroup	MMODULE
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech POSIX DLL Factory
+* @details		Contains definition of @ref MsvPosixDllFactory (dlopen based @ref IMsvDllFactory).
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Module Library.
+
+MarsTech Dependency Injection is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef MARSTECH_POSIXDLLFACTORY_H
+#define MARSTECH_POSIXDLLFACTORY_H
+
+
+#if !defined(_WIN32)
+
+
+#include "mdllfactory/IMsvDllFactory.h"
+
+#include "mlogging/mlogging.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+MSV_ENABLE_WARNINGS
+
+
+/**************************************************************************************************//**
+* @brief		DLL binding mode.
+* @details	Symbol binding mode used when shared library is loaded.
+******************************************************************************************************/
+enum class MsvDllBinding: int32_t
+{
+	MSV_DLL_BINDING_LAZY = 0,			///< Resolve symbols on first call (RTLD_LAZY) - faster load, slower first call.
+	MSV_DLL_BINDING_NOW					///< Resolve all symbols at load (RTLD_NOW) - slower load, no first call penalty.
+};
+
+
+/**************************************************************************************************//**
+* @brief		DLL load statistics.
+* @details	Load statistics of one shared library.
+******************************************************************************************************/
+struct MsvDllLoadStatistics
+{
+	bool loaded;											///< Flag if shared library is loaded (true) or not (false).
+	MsvDllBinding binding;								///< Binding mode used to load shared library.
+	std::chrono::nanoseconds loadDuration;			///< Duration of dlopen.
+	std::chrono::nanoseconds symbolDuration;		///< Duration of dlsym of get DLL object function.
+	std::chrono::nanoseconds firstCallDuration;	///< Duration of the first get DLL object call (includes lazy binding of its symbols).
+	uint64_t objectCount;								///< Number of DLL objects got from shared library.
+};
+
+
+/**************************************************************************************************//**
+* @brief		Get DLL object function.
+* @details	Function exported by shared library which returns DLL object by its ID.
+******************************************************************************************************/
+typedef MsvErrorCode (*MsvGetDllObjectFunction)(const char* dllObjectId, std::shared_ptr<IMsvDllObject>& spDllObject);
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech POSIX DLL Factory.
+* @details	DLL factory which loads shared libraries by dlopen (native Linux backend for
+*				@ref MsvDllModuleAdapter). DLL object IDs are mapped to shared library paths by
+*				@ref AddDllObject. Each shared library is loaded only once (handles are cached by path)
+*				and its get DLL object function is resolved only once (symbols are cached too).
+*				Shared libraries are loaded with RTLD_LOCAL (isolated symbols) unless global symbols
+*				are requested, and with lazy or eager binding selected per shared library.
+* @note		Shared libraries are unloaded when factory is destroyed - all DLL objects must be released before.
+******************************************************************************************************/
+class MsvPosixDllFactory:
+	public IMsvDllFactory
+{
+public:
+	/**************************************************************************************************//**
+	* @brief			Constructor.
+	* @param[in]	spLogger					Shared pointer to logger for logging.
+	* @param[in]	defaultBinding			Binding mode used when it is not set by @ref AddDllObject.
+	* @param[in]	localSymbols			Flag if shared libraries symbols are isolated (RTLD_LOCAL) or global (RTLD_GLOBAL).
+	* @param[in]	getDllObjectSymbol	Name of get DLL object function exported by shared libraries.
+	******************************************************************************************************/
+	MsvPosixDllFactory(std::shared_ptr<MsvLogger> spLogger = nullptr, MsvDllBinding defaultBinding = MsvDllBinding::MSV_DLL_BINDING_LAZY, bool localSymbols = true, const char* getDllObjectSymbol = "GetDllObject");
+
+	/**************************************************************************************************//**
+	* @brief		Virtual destructor.
+	******************************************************************************************************/
+	virtual ~MsvPosixDllFactory();
+
+	/*-----------------------------------------------------------------------------------------------------
+	**											IMsvDllFactory public methods
+	**---------------------------------------------------------------------------------------------------*/
+public:
+	using IMsvDllFactory::GetDllObject;
+
+	/**************************************************************************************************//**
+	* @brief			Get DLL object.
+	* @details		Loads shared library (when it is not loaded yet) and gets DLL object from it. Shared library is loaded
+	*					under factory lock, get DLL object function is called out of it (objects are created concurrently).
+	* @param[in]	dllObjectId					DLL object ID.
+	* @param[out]	spDllObject					Shared pointer to DLL object.
+	* @retval		MSV_NOT_FOUND_ERROR		When DLL object ID is not registered, shared library can not be loaded
+	*													or it does not export get DLL object function.
+	* @retval		other_error_code			When failed (error code of get DLL object function).
+	* @retval		MSV_SUCCESS					On success.
+	******************************************************************************************************/
+	virtual MsvErrorCode GetDllObject(const char* dllObjectId, std::shared_ptr<IMsvDllObject>& spDllObject) override;
+
+	/*-----------------------------------------------------------------------------------------------------
+	**											MsvPosixDllFactory public methods
+	**---------------------------------------------------------------------------------------------------*/
+public:
+	/**************************************************************************************************//**
+	* @brief			Add DLL object.
+	* @details		Registers DLL object ID to shared library path. Shared library is loaded with default binding.
+	* @param[in]	dllObjectId						DLL object ID.
+	* @param[in]	dllPath							Shared library path.
+	* @retval		MSV_INVALID_DATA_ERROR		When DLL object ID or path is empty.
+	* @retval		MSV_ALREADY_EXISTS_ERROR	When DLL object ID has been already registered.
+	* @retval		MSV_SUCCESS						On success.
+	******************************************************************************************************/
+	virtual MsvErrorCode AddDllObject(const char* dllObjectId, const char* dllPath);
+
+	/**************************************************************************************************//**
+	* @brief			Add DLL object.
+	* @details		Registers DLL object ID to shared library path.
+	* @param[in]	dllObjectId						DLL object ID.
+	* @param[in]	dllPath							Shared library path.
+	* @param[in]	binding							Binding mode of shared library.
+	* @retval		MSV_INVALID_DATA_ERROR		When DLL object ID or path is empty or shared library has been
+	*														already registered with another binding mode.
+	* @retval		MSV_ALREADY_EXISTS_ERROR	When DLL object ID has been already registered.
+	* @retval		MSV_SUCCESS						On success.
+	******************************************************************************************************/
+	virtual MsvErrorCode AddDllObject(const char* dllObjectId, const char* dllPath, MsvDllBinding binding);
+
+	/**************************************************************************************************//**
+	* @brief			Get DLL path.
+	* @details		Returns shared library path of registered DLL object ID.
+	* @param[in]	dllObjectId					DLL object ID.
+	* @param[out]	dllPath						Shared library path.
+	* @retval		MSV_NOT_FOUND_ERROR		When DLL object ID is not registered.
+	* @retval		MSV_SUCCESS					On success.
+	******************************************************************************************************/
+	virtual MsvErrorCode GetDllPath(const char* dllObjectId, std::string& dllPath) const;
+
+	/**************************************************************************************************//**
+	* @brief			Get DLL load statistics.
+	* @details		Returns load statistics of shared library (to tune load latency versus first call latency).
+	*					First call duration is measured until get DLL object function returns the first DLL object.
+	* @param[in]	dllPath						Shared library path.
+	* @param[out]	statistics					Load statistics of shared library.
+	* @retval		MSV_NOT_FOUND_ERROR		When shared library is not registered.
+	* @retval		MSV_SUCCESS					On success.
+	******************************************************************************************************/
+	virtual MsvErrorCode GetDllLoadStatistics(const char* dllPath, MsvDllLoadStatistics& statistics) const;
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Loaded shared library.
+	* @details	Cached handle and get DLL object function of one shared library.
+	******************************************************************************************************/
+	struct MsvPosixDll
+	{
+		void* handle;											///< Handle returned by dlopen (nullptr when not loaded).
+		MsvGetDllObjectFunction getDllObject;			///< Cached get DLL object function.
+		MsvDllLoadStatistics statistics;					///< Load statistics.
+	};
+
+	/**************************************************************************************************//**
+	* @brief			Load shared library.
+	* @details		Loads shared library and resolves its get DLL object function (when not loaded yet).
+	* @param[in]	dllPath						Shared library path.
+	* @param[in]	dll							Shared library to load.
+	* @retval		MSV_NOT_FOUND_ERROR		When shared library can not be loaded or it does not export get DLL object function.
+	* @retval		MSV_SUCCESS					On success.
+	******************************************************************************************************/
+	virtual MsvErrorCode LoadDll(const std::string& dllPath, MsvPosixDll& dll);
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		DLL factory mutex.
+	* @details	Locks this object for thread safety access.
+	******************************************************************************************************/
+	mutable std::recursive_mutex m_lock;
+
+	/**************************************************************************************************//**
+	* @brief		Default binding.
+	* @details	Binding mode used when it is not set by @ref AddDllObject.
+	******************************************************************************************************/
+	MsvDllBinding m_defaultBinding;
+
+	/**************************************************************************************************//**
+	* @brief		Local symbols flag.
+	* @details	Flag if shared libraries symbols are isolated (RTLD_LOCAL) or global (RTLD_GLOBAL).
+	******************************************************************************************************/
+	bool m_localSymbols;
+
+	/**************************************************************************************************//**
+	* @brief		Get DLL object symbol.
+	* @details	Name of get DLL object function exported by shared libraries.
+	******************************************************************************************************/
+	std::string m_getDllObjectSymbol;
+
+	/**************************************************************************************************//**
+	* @brief		Registered DLL objects.
+	* @details	Shared library path by DLL object ID.
+	* @see		AddDllObject
+	******************************************************************************************************/
+	std::unordered_map<std::string, std::string> m_dllObjects;
+
+	/**************************************************************************************************//**
+	* @brief		Shared libraries.
+	* @details	Shared libraries (theirs handles and symbols) by path.
+	******************************************************************************************************/
+	std::unordered_map<std::string, MsvPosixDll> m_dlls;
+
+	/**************************************************************************************************//**
+	* @brief		Logger.
+	* @details	Shared pointer to logger for logging.
+	******************************************************************************************************/
+	std::shared_ptr<MsvLogger> m_spLogger;
+};
+
+
+#endif // !defined(_WIN32)
+
+#endif // !MARSTECH_POSIXDLLFACTORY_H
+
+/** @} */	//End of group MMODULE.
@@ -0,0 +1,452 @@
+/**************************************************************************************************//**
+* @addtogroup	MMODULE
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Ring Buffers
+* @details		Contains definition of @ref MsvSpscRingBuffer (bounded lock-free single producer single consumer
+*					ring buffer) and @ref MsvMpscRingBuffer (bounded lock-free multiple producers single consumer ring
+*					buffer).
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+* @note			This iplementation is in header file only -> it should be possible to include this header
+*					file to your project without linking this library.
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Module Library.
+
+MarsTech Dependency Injection is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef MARSTECH_RINGBUFFER_H
+#define MARSTECH_RINGBUFFER_H
+
+
+#include "merror/MsvError.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+MSV_ENABLE_WARNINGS
+
+
+/**************************************************************************************************//**
+* @brief		Cache line size.
+* @details	Indexes of producers and consumer are padded to separate cache lines (no false sharing).
+******************************************************************************************************/
+static const size_t MSV_CACHE_LINE_SIZE = 64;
+
+
+/**************************************************************************************************//**
+* @brief			Get ring buffer capacity.
+* @details		Rounds capacity up to power of two (at least 2).
+* @param[in]	capacity				Requested capacity.
+* @returns		size_t
+******************************************************************************************************/
+inline size_t MsvGetRingBufferCapacity(size_t capacity)
+{
+	size_t roundedCapacity = 2;
+	while (roundedCapacity < capacity && roundedCapacity <= SIZE_MAX / 2)
+	{
+		roundedCapacity *= 2;
+	}
+
+	return roundedCapacity;
+}
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech SPSC Ring Buffer.
+* @details	Bounded lock-free ring buffer for one producer thread and one consumer thread. Producer and consumer
+*				cache index of the other side, so they touch shared index only when cached one is exhausted.
+* @tparam		T				Item type (default constructible and move assignable).
+******************************************************************************************************/
+template<class T>
+class MsvSpscRingBuffer
+{
+public:
+	/**************************************************************************************************//**
+	* @brief			Constructor.
+	* @param[in]	capacity				Capacity (rounded up to power of two).
+	******************************************************************************************************/
+	MsvSpscRingBuffer(size_t capacity):
+		m_mask(MsvGetRingBufferCapacity(capacity) - 1),
+		m_items(new T[m_mask + 1]),
+		m_head(0),
+		m_cachedTail(0),
+		m_tail(0),
+		m_cachedHead(0)
+	{
+
+	}
+
+	MsvSpscRingBuffer(const MsvSpscRingBuffer&) = delete;
+	MsvSpscRingBuffer& operator=(const MsvSpscRingBuffer&) = delete;
+
+	/**************************************************************************************************//**
+	* @brief			Push item.
+	* @details		Called by producer only.
+	* @param[in]	item					Item.
+	* @retval		true					When item has been pushed.
+	* @retval		false					When ring buffer is full.
+	******************************************************************************************************/
+	bool Push(const T& item)
+	{
+		return PushBatch(&item, 1) == 1;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Push items.
+	* @details		Pushes as many items as fit (called by producer only). Items are published at once.
+	* @param[in]	pItems				Items.
+	* @param[in]	count					Number of items.
+	* @returns		size_t (number of pushed items)
+	******************************************************************************************************/
+	size_t PushBatch(const T* pItems, size_t count)
+	{
+		size_t tail = m_tail.load(std::memory_order_relaxed);
+		if (tail + count - m_cachedHead > m_mask + 1)
+		{
+			m_cachedHead = m_head.load(std::memory_order_acquire);
+		}
+
+		size_t freeCount = m_mask + 1 - (tail - m_cachedHead);
+		count = count < freeCount ? count : freeCount;
+		for (size_t i = 0; i < count; ++i)
+		{
+			m_items[(tail + i) & m_mask] = pItems[i];
+		}
+
+		m_tail.store(tail + count, std::memory_order_release);
+		return count;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Pop item.
+	* @details		Called by consumer only.
+	* @param[out]	item					Item.
+	* @retval		true					When item has been popped.
+	* @retval		false					When ring buffer is empty.
+	******************************************************************************************************/
+	bool Pop(T& item)
+	{
+		return PopBatch(&item, 1) == 1;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Pop items.
+	* @details		Pops up to maxCount items (called by consumer only). Slots are released at once.
+	* @param[out]	pItems				Items.
+	* @param[in]	maxCount				Maximal number of items.
+	* @returns		size_t (number of popped items)
+	******************************************************************************************************/
+	size_t PopBatch(T* pItems, size_t maxCount)
+	{
+		size_t head = m_head.load(std::memory_order_relaxed);
+		if (m_cachedTail - head < maxCount)
+		{
+			m_cachedTail = m_tail.load(std::memory_order_acquire);
+		}
+
+		size_t count = m_cachedTail - head;
+		count = count < maxCount ? count : maxCount;
+		for (size_t i = 0; i < count; ++i)
+		{
+			//moved out item is reset (e.g. shared payload is released now)
+			T& slot = m_items[(head + i) & m_mask];
+			pItems[i] = std::move(slot);
+			slot = T();
+		}
+
+		m_head.store(head + count, std::memory_order_release);
+		return count;
+	}
+
+	/**************************************************************************************************//**
+	* @brief		Get empty flag.
+	* @details	Result is exact only when it is called by consumer.
+	* @retval	true		When ring buffer is empty.
+	* @retval	false		When ring buffer is not empty.
+	******************************************************************************************************/
+	bool Empty() const
+	{
+		return m_tail.load(std::memory_order_acquire) == m_head.load(std::memory_order_acquire);
+	}
+
+	/**************************************************************************************************//**
+	* @brief		Get capacity.
+	* @returns	size_t
+	******************************************************************************************************/
+	size_t GetCapacity() const
+	{
+		return m_mask + 1;
+	}
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Index mask (capacity - 1).
+	******************************************************************************************************/
+	size_t m_mask;
+
+	/**************************************************************************************************//**
+	* @brief		Items.
+	******************************************************************************************************/
+	std::unique_ptr<T[]> m_items;
+
+	char m_padding0[MSV_CACHE_LINE_SIZE];			///< Padding (consumer data in separate cache line).
+
+	/**************************************************************************************************//**
+	* @brief		Head.
+	* @details	Index of next popped item (written by consumer).
+	******************************************************************************************************/
+	std::atomic<size_t> m_head;
+
+	/**************************************************************************************************//**
+	* @brief		Cached tail.
+	* @details	Consumer copy of @ref m_tail.
+	******************************************************************************************************/
+	size_t m_cachedTail;
+
+	char m_padding1[MSV_CACHE_LINE_SIZE];			///< Padding (producer data in separate cache line).
+
+	/**************************************************************************************************//**
+	* @brief		Tail.
+	* @details	Index of next pushed item (written by producer).
+	******************************************************************************************************/
+	std::atomic<size_t> m_tail;
+
+	/**************************************************************************************************//**
+	* @brief		Cached head.
+	* @details	Producer copy of @ref m_head.
+	******************************************************************************************************/
+	size_t m_cachedHead;
+
+	char m_padding2[MSV_CACHE_LINE_SIZE];			///< Padding (no sharing with following objects).
+};
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech MPSC Ring Buffer.
+* @details	Bounded lock-free ring buffer for more producer threads and one consumer thread. Every slot has sequence
+*				number which tells if slot is free for producer of given position or filled for consumer. Producers claim
+*				positions by compare and swap.
+* @tparam		T				Item type (default constructible and move assignable).
+******************************************************************************************************/
+template<class T>
+class MsvMpscRingBuffer
+{
+public:
+	/**************************************************************************************************//**
+	* @brief			Constructor.
+	* @param[in]	capacity				Capacity (rounded up to power of two).
+	******************************************************************************************************/
+	MsvMpscRingBuffer(size_t capacity):
+		m_mask(MsvGetRingBufferCapacity(capacity) - 1),
+		m_slots(new MsvSlot[m_mask + 1]),
+		m_head(0),
+		m_tail(0)
+	{
+		for (size_t i = 0; i <= m_mask; ++i)
+		{
+			m_slots[i].sequence.store(i, std::memory_order_relaxed);
+		}
+	}
+
+	MsvMpscRingBuffer(const MsvMpscRingBuffer&) = delete;
+	MsvMpscRingBuffer& operator=(const MsvMpscRingBuffer&) = delete;
+
+	/**************************************************************************************************//**
+	* @brief			Push item.
+	* @param[in]	item					Item.
+	* @retval		true					When item has been pushed.
+	* @retval		false					When ring buffer is full.
+	******************************************************************************************************/
+	bool Push(const T& item)
+	{
+		return PushBatch(&item, 1) == 1;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Push items.
+	* @details		Claims consecutive positions for as many items as fit by one compare and swap.
+	* @param[in]	pItems				Items.
+	* @param[in]	count					Number of items.
+	* @returns		size_t (number of pushed items)
+	******************************************************************************************************/
+	size_t PushBatch(const T* pItems, size_t count)
+	{
+		if (count == 0)
+		{
+			return 0;
+		}
+
+		size_t tail = m_tail.load(std::memory_order_relaxed);
+		size_t claimed = 0;
+		for (;;)
+		{
+			//slots are released in order -> when the last slot is free, all previous slots are free too
+			size_t usedCount = tail - m_head.load(std::memory_order_acquire);
+			size_t freeCount = usedCount > m_mask ? 0 : m_mask + 1 - usedCount;
+			claimed = count < freeCount ? count : freeCount;
+			if (claimed == 0)
+			{
+				return 0;
+			}
+
+			size_t last = tail + claimed - 1;
+			if (m_slots[last & m_mask].sequence.load(std::memory_order_acquire) != last)
+			{
+				//slot has not been released yet or other producer claimed it
+				size_t currentTail = m_tail.load(std::memory_order_relaxed);
+				if (currentTail == tail)
+				{
+					return 0;
+				}
+
+				tail = currentTail;
+				continue;
+			}
+
+			if (m_tail.compare_exchange_weak(tail, tail + claimed, std::memory_order_relaxed))
+			{
+				break;
+			}
+		}
+
+		for (size_t i = 0; i < claimed; ++i)
+		{
+			MsvSlot& slot = m_slots[(tail + i) & m_mask];
+			slot.item = pItems[i];
+			slot.sequence.store(tail + i + 1, std::memory_order_release);
+		}
+
+		return claimed;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Pop item.
+	* @details		Called by consumer only.
+	* @param[out]	item					Item.
+	* @retval		true					When item has been popped.
+	* @retval		false					When ring buffer is empty (or the next item has not been published yet).
+	******************************************************************************************************/
+	bool Pop(T& item)
+	{
+		return PopBatch(&item, 1) == 1;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Pop items.
+	* @details		Pops up to maxCount published items (called by consumer only).
+	* @param[out]	pItems				Items.
+	* @param[in]	maxCount				Maximal number of items.
+	* @returns		size_t (number of popped items)
+	******************************************************************************************************/
+	size_t PopBatch(T* pItems, size_t maxCount)
+	{
+		size_t head = m_head.load(std::memory_order_relaxed);
+		size_t count = 0;
+		for (; count < maxCount; ++count)
+		{
+			MsvSlot& slot = m_slots[(head + count) & m_mask];
+			if (slot.sequence.load(std::memory_order_acquire) != head + count + 1)
+			{
+				break;
+			}
+
+			//moved out item is reset (e.g. shared payload is released now)
+			pItems[count] = std::move(slot.item);
+			slot.item = T();
+			slot.sequence.store(head + count + m_mask + 1, std::memory_order_release);
+		}
+
+		m_head.store(head + count, std::memory_order_release);
+		return count;
+	}
+
+	/**************************************************************************************************//**
+	* @brief		Get empty flag.
+	* @details	Result is exact only when it is called by consumer.
+	* @retval	true		When ring buffer is empty.
+	* @retval	false		When ring buffer is not empty.
+	******************************************************************************************************/
+	bool Empty() const
+	{
+		size_t head = m_head.load(std::memory_order_acquire);
+		return m_slots[head & m_mask].sequence.load(std::memory_order_acquire) != head + 1;
+	}
+
+	/**************************************************************************************************//**
+	* @brief		Get capacity.
+	* @returns	size_t
+	******************************************************************************************************/
+	size_t GetCapacity() const
+	{
+		return m_mask + 1;
+	}
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Slot.
+	******************************************************************************************************/
+	struct MsvSlot
+	{
+		std::atomic<size_t> sequence;				///< Position + 1 when slot is filled, position when slot is free.
+		T item;											///< Item.
+	};
+
+	/**************************************************************************************************//**
+	* @brief		Index mask (capacity - 1).
+	******************************************************************************************************/
+	size_t m_mask;
+
+	/**************************************************************************************************//**
+	* @brief		Slots.
+	******************************************************************************************************/
+	std::unique_ptr<MsvSlot[]> m_slots;
+
+	char m_padding0[MSV_CACHE_LINE_SIZE];			///< Padding (consumer data in separate cache line).
+
+	/**************************************************************************************************//**
+	* @brief		Head.
+	* @details	Position of next popped item (written by consumer).
+	******************************************************************************************************/
+	std::atomic<size_t> m_head;
+
+	char m_padding1[MSV_CACHE_LINE_SIZE];			///< Padding (producer data in separate cache line).
+
+	/**************************************************************************************************//**
+	* @brief		Tail.
+	* @details	Position of next claimed slot (written by producers).
+	******************************************************************************************************/
+	std::atomic<size_t> m_tail;
+
+	char m_padding2[MSV_CACHE_LINE_SIZE];			///< Padding (no sharing with following objects).
+};
+
+
+#endif // !MARSTECH_RINGBUFFER_H
+
+/** @} */	//End of group MMODULE.
@@ -0,0 +1,198 @@
+/**************************************************************************************************//**
+* @addtogroup	MMODULE
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Service Registry
+* @details		Contains implementation of @ref MsvServiceRegistry.
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Module Library.
+
+MarsTech Dependency Injection is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "MsvServiceRegistry.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <new>
+#include <vector>
+
+MSV_ENABLE_WARNINGS
+
+
+/********************************************************************************************************************************
+*															Constructors and destructors
+********************************************************************************************************************************/
+
+
+MsvServiceRegistry::MsvServiceRegistry()
+{
+
+}
+
+MsvServiceRegistry::~MsvServiceRegistry()
+{
+
+}
+
+
+/********************************************************************************************************************************
+*															MsvServiceRegistry public methods
+********************************************************************************************************************************/
+
+
+MsvErrorCode MsvServiceRegistry::PublishService(int32_t providerId, const std::string& name, std::shared_ptr<void> spService, const std::type_info& type)
+{
+	if (!spService)
+	{
+		return MSV_INVALID_DATA_ERROR;
+	}
+
+	std::shared_ptr<MsvServiceSlot> spSlot;
+	MSV_RETURN_FAILED(GetSlot(name, spSlot));
+
+	//previous service of provider is released out of slot lock
+	std::shared_ptr<void> spPreviousService;
+
+	{
+		std::lock_guard<std::mutex> lock(spSlot->lock);
+
+		if (spSlot->spService && spSlot->providerId != providerId)
+		{
+			return MSV_ALREADY_EXISTS_ERROR;
+		}
+
+		spPreviousService = spSlot->spService;
+		spSlot->spService = spService;
+		spSlot->pType = &type;
+		spSlot->providerId = providerId;
+		spSlot->version.fetch_add(1, std::memory_order_release);
+	}
+
+	return MSV_SUCCESS;
+}
+
+MsvErrorCode MsvServiceRegistry::Retract(int32_t providerId, const std::string& name)
+{
+	std::shared_ptr<MsvServiceSlot> spSlot;
+
+	{
+		MsvSharedLockPolicy::ReadLock lock(m_lock);
+
+		std::unordered_map<std::string, std::shared_ptr<MsvServiceSlot>>::const_iterator it = m_slots.find(name);
+		if (it == m_slots.end())
+		{
+			return MSV_NOT_FOUND_ERROR;
+		}
+
+		spSlot = it->second;
+	}
+
+	//service is released out of slot lock
+	std::shared_ptr<void> spService;
+
+	{
+		std::lock_guard<std::mutex> lock(spSlot->lock);
+
+		if (!spSlot->spService || spSlot->providerId != providerId)
+		{
+			return MSV_NOT_FOUND_ERROR;
+		}
+
+		spService = RetractSlot(*spSlot);
+	}
+
+	return MSV_SUCCESS;
+}
+
+void MsvServiceRegistry::RetractAll(int32_t providerId)
+{
+	//services are released out of registry and slot locks (their destructors can use registry)
+	std::vector<std::shared_ptr<void>> services;
+
+	{
+		MsvSharedLockPolicy::ReadLock lock(m_lock);
+
+		for (std::unordered_map<std::string, std::shared_ptr<MsvServiceSlot>>::const_iterator it = m_slots.begin(); it != m_slots.end(); ++it)
+		{
+			std::lock_guard<std::mutex> slotLock(it->second->lock);
+
+			if (it->second->spService && it->second->providerId == providerId)
+			{
+				services.push_back(RetractSlot(*it->second));
+			}
+		}
+	}
+}
+
+
+/********************************************************************************************************************************
+*															MsvServiceRegistry protected methods
+********************************************************************************************************************************/
+
+
+MsvErrorCode MsvServiceRegistry::GetSlot(const std::string& name, std::shared_ptr<MsvServiceSlot>& spSlot)
+{
+	{
+		MsvSharedLockPolicy::ReadLock lock(m_lock);
+
+		std::unordered_map<std::string, std::shared_ptr<MsvServiceSlot>>::const_iterator it = m_slots.find(name);
+		if (it != m_slots.end())
+		{
+			spSlot = it->second;
+			return MSV_SUCCESS;
+		}
+	}
+
+	std::lock_guard<MsvSharedLockPolicy::Mutex> lock(m_lock);
+
+	//slot could be created by other thread meanwhile
+	std::shared_ptr<MsvServiceSlot>& spMapSlot = m_slots[name];
+	if (!spMapSlot)
+	{
+		spMapSlot.reset(new (std::nothrow) MsvServiceSlot());
+		if (!spMapSlot)
+		{
+			m_slots.erase(name);
+			return MSV_ALLOCATION_ERROR;
+		}
+	}
+
+	spSlot = spMapSlot;
+
+	return MSV_SUCCESS;
+}
+
+std::shared_ptr<void> MsvServiceRegistry::RetractSlot(MsvServiceSlot& slot)
+{
+	std::shared_ptr<void> spService;
+	spService.swap(slot.spService);
+	slot.pType = nullptr;
+	slot.version.fetch_add(1, std::memory_order_release);
+
+	return spService;
+}
+
+
+/** @} */	//End of group MMODULE.
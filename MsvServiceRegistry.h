@@ -0,0 +1,355 @@
+/**************************************************************************************************//**
+* @addtogroup	MMODULE
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Service Registry
+* @details		Contains definition of @ref MsvServiceRegistry (services published by modules) and
+*					@ref MsvServiceHandle (cached lock-free handle of service).
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Module Library.
+
+MarsTech Dependency Injection is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef MARSTECH_SERVICEREGISTRY_H
+#define MARSTECH_SERVICEREGISTRY_H
+
+
+#include "MsvLockPolicy.h"
+
+#include "merror/MsvErrorCodes.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <typeinfo>
+#include <unordered_map>
+
+MSV_ENABLE_WARNINGS
+
+
+/**************************************************************************************************//**
+* @brief		Service slot.
+* @details	Published service of one name. Slot lives as long as registry or any handle which uses it (it is not
+*				removed when service is retracted). Version is changed every time service is published or retracted.
+******************************************************************************************************/
+struct MsvServiceSlot
+{
+	/**************************************************************************************************//**
+	* @brief		Constructor.
+	******************************************************************************************************/
+	MsvServiceSlot():
+		version(0),
+		pType(nullptr),
+		providerId(0)
+	{
+
+	}
+
+	std::atomic<uint64_t> version;					///< Version (changed when service is published or retracted).
+	std::mutex lock;										///< Locks service, type and provider ID.
+	std::shared_ptr<void> spService;					///< Service (empty when service is not published).
+	const std::type_info* pType;						///< Type of service (interface it has been published as).
+	int32_t providerId;									///< Module ID of provider.
+};
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Service Handle.
+* @details	Cached handle of service. It keeps the last resolved service and resolves it again only when service has
+*				been published or retracted since then - lookup is one atomic load and weak pointer lock otherwise (no
+*				mutex, no map).
+* @tparam		T						Service interface.
+* @note		Handle is not thread safe - every thread should use its own copy (copies are cheap). Handle does not keep
+*				service alive - retracted service is released (e.g. before its DLL module is unloaded) even when handle
+*				has not seen it has been retracted yet.
+******************************************************************************************************/
+template<class T>
+class MsvServiceHandle
+{
+public:
+	/**************************************************************************************************//**
+	* @brief		Constructor.
+	* @details	Creates empty handle (use @ref MsvServiceRegistry::GetHandle).
+	******************************************************************************************************/
+	MsvServiceHandle():
+		m_version(0),
+		m_errorCode(MSV_NOT_INITIALIZED_ERROR)
+	{
+
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Constructor.
+	* @param[in]	spSlot				Service slot.
+	******************************************************************************************************/
+	MsvServiceHandle(std::shared_ptr<MsvServiceSlot> spSlot):
+		m_spSlot(std::move(spSlot)),
+		m_version(UINT64_MAX),
+		m_errorCode(MSV_NOT_FOUND_ERROR)
+	{
+
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Get service.
+	* @details		Returns cached service (it is resolved again when it has been published or retracted).
+	* @param[out]	spService							Shared pointer to service.
+	* @retval		MSV_NOT_INITIALIZED_ERROR		When handle is empty.
+	* @retval		MSV_NOT_FOUND_ERROR				When service is not published.
+	* @retval		MSV_INVALID_DATA_ERROR			When service has been published as other interface.
+	* @retval		MSV_SUCCESS							On success.
+	******************************************************************************************************/
+	MsvErrorCode Get(std::shared_ptr<T>& spService)
+	{
+		if (!m_spSlot)
+		{
+			return MSV_NOT_INITIALIZED_ERROR;
+		}
+
+		if (m_spSlot->version.load(std::memory_order_acquire) != m_version)
+		{
+			Refresh();
+		}
+
+		spService = m_wpService.lock();
+		if (!spService && !MSV_FAILED(m_errorCode))
+		{
+			//service has been retracted since the last resolve
+			Refresh();
+			spService = m_wpService.lock();
+		}
+
+		return spService || MSV_FAILED(m_errorCode) ? m_errorCode : MSV_NOT_FOUND_ERROR;
+	}
+
+	/**************************************************************************************************//**
+	* @brief		Get available flag.
+	* @retval	true		When service is published (as interface of handle).
+	* @retval	false		When service is not published or handle is empty.
+	******************************************************************************************************/
+	bool Available()
+	{
+		std::shared_ptr<T> spService;
+		return !MSV_FAILED(Get(spService));
+	}
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Refresh service.
+	* @details	Resolves service from slot (under slot lock) and remembers its version.
+	******************************************************************************************************/
+	void Refresh()
+	{
+		std::lock_guard<std::mutex> lock(m_spSlot->lock);
+
+		m_version = m_spSlot->version.load(std::memory_order_relaxed);
+		m_wpService.reset();
+
+		if (!m_spSlot->spService)
+		{
+			m_errorCode = MSV_NOT_FOUND_ERROR;
+		}
+		else if (*m_spSlot->pType != typeid(T))
+		{
+			m_errorCode = MSV_INVALID_DATA_ERROR;
+		}
+		else
+		{
+			m_wpService = std::static_pointer_cast<T>(m_spSlot->spService);
+			m_errorCode = MSV_SUCCESS;
+		}
+	}
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Service slot.
+	******************************************************************************************************/
+	std::shared_ptr<MsvServiceSlot> m_spSlot;
+
+	/**************************************************************************************************//**
+	* @brief		Cached service.
+	* @details	Weak pointer to service (registry owns published service).
+	******************************************************************************************************/
+	std::weak_ptr<T> m_wpService;
+
+	/**************************************************************************************************//**
+	* @brief		Cached version.
+	* @details	Version of slot cached service has been resolved from.
+	******************************************************************************************************/
+	uint64_t m_version;
+
+	/**************************************************************************************************//**
+	* @brief		Cached error code.
+	* @details	Result of the last resolve.
+	******************************************************************************************************/
+	MsvErrorCode m_errorCode;
+};
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Service Registry.
+* @details	Services (interfaces) published by modules and addressed by name. Modules publish services during initialize
+*				or start and module manager retracts them when module stops (or fails to initialize or start) and when it
+*				is uninitialized. Consumers get handle once (@ref GetHandle) and use it on hot paths - registry map is
+*				locked only when handle is created.
+******************************************************************************************************/
+class MsvServiceRegistry
+{
+public:
+	/**************************************************************************************************//**
+	* @brief		Constructor.
+	******************************************************************************************************/
+	MsvServiceRegistry();
+
+	/**************************************************************************************************//**
+	* @brief		Virtual destructor.
+	******************************************************************************************************/
+	virtual ~MsvServiceRegistry();
+
+	MsvServiceRegistry(const MsvServiceRegistry&) = delete;
+	MsvServiceRegistry& operator=(const MsvServiceRegistry&) = delete;
+
+	/**************************************************************************************************//**
+	* @brief			Publish service.
+	* @details		Publishes service as interface T (consumers must resolve it as the same interface).
+	* @param[in]	providerId							Module ID of provider.
+	* @param[in]	name									Service name.
+	* @param[in]	spService							Shared pointer to service.
+	* @retval		other_error_code					When @ref PublishService failed.
+	* @retval		MSV_SUCCESS							On success.
+	******************************************************************************************************/
+	template<class T>
+	MsvErrorCode Publish(int32_t providerId, const std::string& name, std::shared_ptr<T> spService)
+	{
+		return PublishService(providerId, name, std::static_pointer_cast<void>(spService), typeid(T));
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Get service handle.
+	* @details		Returns cached handle of service (handle can be created before service is published).
+	* @param[in]	name									Service name.
+	* @param[out]	handle								Service handle.
+	* @retval		other_error_code					When @ref GetSlot failed.
+	* @retval		MSV_SUCCESS							On success.
+	******************************************************************************************************/
+	template<class T>
+	MsvErrorCode GetHandle(const std::string& name, MsvServiceHandle<T>& handle)
+	{
+		std::shared_ptr<MsvServiceSlot> spSlot;
+		MSV_RETURN_FAILED(GetSlot(name, spSlot));
+
+		handle = MsvServiceHandle<T>(spSlot);
+
+		return MSV_SUCCESS;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Resolve service.
+	* @details		Returns service (one-shot lookup - use @ref GetHandle on hot paths).
+	* @param[in]	name									Service name.
+	* @param[out]	spService							Shared pointer to service.
+	* @retval		other_error_code					When @ref GetHandle or @ref MsvServiceHandle::Get failed.
+	* @retval		MSV_SUCCESS							On success.
+	******************************************************************************************************/
+	template<class T>
+	MsvErrorCode Resolve(const std::string& name, std::shared_ptr<T>& spService)
+	{
+		MsvServiceHandle<T> handle;
+		MSV_RETURN_FAILED(GetHandle(name, handle));
+
+		return handle.Get(spService);
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Publish service.
+	* @details		Publishes service of provider (provider can publish it again with other service).
+	* @param[in]	providerId							Module ID of provider.
+	* @param[in]	name									Service name.
+	* @param[in]	spService							Shared pointer to service.
+	* @param[in]	type									Type of service (interface it is published as).
+	* @retval		MSV_INVALID_DATA_ERROR			When service is empty.
+	* @retval		MSV_ALREADY_EXISTS_ERROR		When service has been published by other provider.
+	* @retval		MSV_SUCCESS							On success.
+	******************************************************************************************************/
+	virtual MsvErrorCode PublishService(int32_t providerId, const std::string& name, std::shared_ptr<void> spService, const std::type_info& type);
+
+	/**************************************************************************************************//**
+	* @brief			Retract service.
+	* @details		Retracts service of provider (handles see it on the next lookup).
+	* @param[in]	providerId							Module ID of provider.
+	* @param[in]	name									Service name.
+	* @retval		MSV_NOT_FOUND_ERROR				When service is not published by provider.
+	* @retval		MSV_SUCCESS							On success.
+	******************************************************************************************************/
+	virtual MsvErrorCode Retract(int32_t providerId, const std::string& name);
+
+	/**************************************************************************************************//**
+	* @brief			Retract all services.
+	* @details		Retracts all services published by provider.
+	* @param[in]	providerId							Module ID of provider.
+	******************************************************************************************************/
+	virtual void RetractAll(int32_t providerId);
+
+protected:
+	/**************************************************************************************************//**
+	* @brief			Get slot.
+	* @details		Returns slot of service (slot is created when it does not exist).
+	* @param[in]	name									Service name.
+	* @param[out]	spSlot								Shared pointer to slot.
+	* @retval		MSV_ALLOCATION_ERROR				When slot can not be created.
+	* @retval		MSV_SUCCESS							On success.
+	******************************************************************************************************/
+	virtual MsvErrorCode GetSlot(const std::string& name, std::shared_ptr<MsvServiceSlot>& spSlot);
+
+	/**************************************************************************************************//**
+	* @brief			Retract service.
+	* @details		Empties slot and changes its version (service is returned to be released out of slot lock).
+	* @param[in]	slot									Service slot (locked by caller).
+	* @returns		std::shared_ptr<void> (retracted service)
+	******************************************************************************************************/
+	std::shared_ptr<void> RetractSlot(MsvServiceSlot& slot);
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Service registry mutex.
+	* @details	Locks slot map (shared for lookups).
+	******************************************************************************************************/
+	mutable MsvSharedLockPolicy::Mutex m_lock;
+
+	/**************************************************************************************************//**
+	* @brief		Slots.
+	* @details	Service slots (service name -> slot).
+	******************************************************************************************************/
+	std::unordered_map<std::string, std::shared_ptr<MsvServiceSlot>> m_slots;
+};
+
+
+#endif // !MARSTECH_SERVICEREGISTRY_H
+
+/** @} */	//End of group MMODULE.
@@ -0,0 +1,89 @@
+/**************************************************************************************************//**
+* @addtogroup	MMODULE
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Start Result
+* @details		Contains definition of @ref MsvStartPolicy and @ref MsvModuleStartResult (per-module result of module
+*					manager start).
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Module Library.
+
+MarsTech Dependency Injection is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef MARSTECH_STARTRESULT_H
+#define MARSTECH_STARTRESULT_H
+
+
+#include "merror/MsvError.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <cstdint>
+
+MSV_ENABLE_WARNINGS
+
+
+/**************************************************************************************************//**
+* @brief		Start policy.
+* @details	What module manager does when start of module fails.
+******************************************************************************************************/
+enum class MsvStartPolicy
+{
+	MSV_START_POLICY_ALL_OR_NOTHING = 0,			///< Any failed module stops all started modules (start fails).
+	MSV_START_POLICY_DEGRADED							///< Only failed critical module stops all started modules. Failed non-critical
+															///< modules and their dependents are skipped (module manager runs degraded).
+};
+
+
+/**************************************************************************************************//**
+* @brief		Module start status.
+******************************************************************************************************/
+enum class MsvModuleStartStatus
+{
+	MSV_MODULE_START_STARTED = 0,					///< Module has been started.
+	MSV_MODULE_START_NOT_INITIALIZED,				///< Module has been skipped - it is not initialized (not installed, not enabled
+															///< or its initialize failed).
+	MSV_MODULE_START_FAILED,							///< Start of module failed.
+	MSV_MODULE_START_DEPENDENCY_FAILED				///< Module has been skipped - its dependency failed.
+};
+
+
+/**************************************************************************************************//**
+* @brief		Module start result.
+* @details	Result of module in the last start of module manager.
+******************************************************************************************************/
+struct MsvModuleStartResult
+{
+	int32_t moduleId;										///< Module ID.
+	MsvModuleStartStatus status;						///< Start status.
+	MsvErrorCode errorCode;								///< Error code of failed module (MSV_SUCCESS otherwise).
+	int32_t causeId;										///< ID of failed module which caused skip of dependent or which not initialized
+															///< module waits for (module ID otherwise).
+};
+
+
+#endif // !MARSTECH_STARTRESULT_H
+
+/** @} */	//End of group MMODULE.
@@ -0,0 +1,268 @@
+/**************************************************************************************************//**
+* @addtogroup	MMODULE
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Startup Plan
+* @details		Contains implementation of @ref MsvStartupPlan.
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Module Library.
+
+MarsTech Dependency Injection is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "MsvStartupPlan.h"
+
+#include "merror/MsvErrorCodes.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MSV_ENABLE_WARNINGS
+
+
+/********************************************************************************************************************************
+*															Constructors and destructors
+********************************************************************************************************************************/
+
+
+MsvStartupPlan::MsvStartupPlan():
+	m_pMapping(nullptr),
+	m_mappingSize(0)
+#if defined(_WIN32)
+	, m_hMapping(nullptr)
+#endif
+{
+
+}
+
+
+MsvStartupPlan::~MsvStartupPlan()
+{
+	Close();
+}
+
+
+/********************************************************************************************************************************
+*															Public methods
+********************************************************************************************************************************/
+
+
+MsvErrorCode MsvStartupPlan::Open(const char* path)
+{
+	Close();
+
+	if (!path)
+	{
+		return MSV_INVALID_DATA_ERROR;
+	}
+
+#if defined(_WIN32)
+	HANDLE hFile = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (hFile == INVALID_HANDLE_VALUE)
+	{
+		return MSV_NOT_FOUND_ERROR;
+	}
+
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(hFile, &fileSize) || fileSize.QuadPart < static_cast<LONGLONG>(sizeof(MsvStartupPlanHeader)))
+	{
+		CloseHandle(hFile);
+		return MSV_INVALID_DATA_ERROR;
+	}
+
+	m_hMapping = CreateFileMappingA(hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	CloseHandle(hFile);
+	if (!m_hMapping)
+	{
+		return MSV_NOT_FOUND_ERROR;
+	}
+
+	m_pMapping = MapViewOfFile(m_hMapping, FILE_MAP_READ, 0, 0, 0);
+	if (!m_pMapping)
+	{
+		CloseHandle(m_hMapping);
+		m_hMapping = nullptr;
+		return MSV_NOT_FOUND_ERROR;
+	}
+
+	m_mappingSize = static_cast<size_t>(fileSize.QuadPart);
+#else
+	int fd = open(path, O_RDONLY | O_CLOEXEC);
+	if (fd < 0)
+	{
+		return MSV_NOT_FOUND_ERROR;
+	}
+
+	struct stat fileStat;
+	if (fstat(fd, &fileStat) != 0 || fileStat.st_size < static_cast<off_t>(sizeof(MsvStartupPlanHeader)))
+	{
+		close(fd);
+		return MSV_INVALID_DATA_ERROR;
+	}
+
+	void* pMapping = mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (pMapping == MAP_FAILED)
+	{
+		return MSV_NOT_FOUND_ERROR;
+	}
+
+	m_pMapping = pMapping;
+	m_mappingSize = static_cast<size_t>(fileStat.st_size);
+#endif
+
+	//check header and size
+	const MsvStartupPlanHeader* pHeader = static_cast<const MsvStartupPlanHeader*>(m_pMapping);
+	if (pHeader->magic != MSV_STARTUP_PLAN_MAGIC || pHeader->version != MSV_STARTUP_PLAN_VERSION
+		|| m_mappingSize != sizeof(MsvStartupPlanHeader) + static_cast<size_t>(pHeader->moduleCount) * sizeof(MsvStartupPlanModule))
+	{
+		Close();
+		return MSV_INVALID_DATA_ERROR;
+	}
+
+	return MSV_SUCCESS;
+}
+
+void MsvStartupPlan::Close()
+{
+	if (!m_pMapping)
+	{
+		return;
+	}
+
+#if defined(_WIN32)
+	UnmapViewOfFile(m_pMapping);
+	CloseHandle(m_hMapping);
+	m_hMapping = nullptr;
+#else
+	munmap(const_cast<void*>(m_pMapping), m_mappingSize);
+#endif
+
+	m_pMapping = nullptr;
+	m_mappingSize = 0;
+}
+
+bool MsvStartupPlan::Matches(uint64_t configVersion, uint64_t moduleSetHash) const
+{
+	if (!m_pMapping)
+	{
+		return false;
+	}
+
+	const MsvStartupPlanHeader* pHeader = static_cast<const MsvStartupPlanHeader*>(m_pMapping);
+	return pHeader->configVersion == configVersion && pHeader->moduleSetHash == moduleSetHash;
+}
+
+const MsvStartupPlanModule* MsvStartupPlan::GetModules() const
+{
+	if (!m_pMapping)
+	{
+		return nullptr;
+	}
+
+	return reinterpret_cast<const MsvStartupPlanModule*>(static_cast<const MsvStartupPlanHeader*>(m_pMapping) + 1);
+}
+
+uint32_t MsvStartupPlan::GetModuleCount() const
+{
+	if (!m_pMapping)
+	{
+		return 0;
+	}
+
+	return static_cast<const MsvStartupPlanHeader*>(m_pMapping)->moduleCount;
+}
+
+MsvErrorCode MsvStartupPlan::Save(const char* path, uint64_t configVersion, uint64_t moduleSetHash, const std::vector<MsvStartupPlanModule>& modules)
+{
+	if (!path)
+	{
+		return MSV_INVALID_DATA_ERROR;
+	}
+
+	MsvStartupPlanHeader header;
+	header.magic = MSV_STARTUP_PLAN_MAGIC;
+	header.version = MSV_STARTUP_PLAN_VERSION;
+	header.configVersion = configVersion;
+	header.moduleSetHash = moduleSetHash;
+	header.moduleCount = static_cast<uint32_t>(modules.size());
+	header.reserved = 0;
+
+	//write temporary file and replace plan (plan is never read half written)
+	std::string tmpPath = std::string(path) + ".tmp";
+	{
+		std::ofstream file(tmpPath, std::ios::out | std::ios::binary | std::ios::trunc);
+		if (!file)
+		{
+			return MSV_NOT_FOUND_ERROR;
+		}
+
+		file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		if (!modules.empty())
+		{
+			file.write(reinterpret_cast<const char*>(modules.data()), modules.size() * sizeof(MsvStartupPlanModule));
+		}
+
+		if (!file)
+		{
+			return MSV_NOT_FOUND_ERROR;
+		}
+	}
+
+#if defined(_WIN32)
+	if (!MoveFileExA(tmpPath.c_str(), path, MOVEFILE_REPLACE_EXISTING))
+#else
+	if (std::rename(tmpPath.c_str(), path) != 0)
+#endif
+	{
+		std::remove(tmpPath.c_str());
+		return MSV_NOT_FOUND_ERROR;
+	}
+
+	return MSV_SUCCESS;
+}
+
+uint64_t MsvStartupPlan::GetModuleIdHash(int32_t moduleId)
+{
+	//splitmix64 finalizer
+	uint64_t hash = static_cast<uint64_t>(static_cast<uint32_t>(moduleId)) + 0x9E3779B97F4A7C15ull;
+	hash = (hash ^ (hash >> 30)) * 0xBF58476D1CE4E5B9ull;
+	hash = (hash ^ (hash >> 27)) * 0x94D049BB133111EBull;
+	return hash ^ (hash >> 31);
+}
+
+
+/** @} */	//End of group MMODULE.
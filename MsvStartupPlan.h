@@ -0,0 +1,197 @@
+/**************************************************************************************************//**
+* @addtogroup	MMODULE
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Startup Plan
+* @details		Contains definition of @ref MsvStartupPlan (persisted startup plan of module manager).
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Module Library.
+
+MarsTech Dependency Injection is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef MARSTECH_STARTUPPLAN_H
+#define MARSTECH_STARTUPPLAN_H
+
+
+#include "merror/MsvError.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+MSV_ENABLE_WARNINGS
+
+
+/**************************************************************************************************//**
+* @brief		Startup plan module.
+* @details	Resolved state of one module in startup plan. Modules are stored in startup order.
+* @note		It is stored in file as is (fixed size, no pointers).
+******************************************************************************************************/
+struct MsvStartupPlanModule
+{
+	int32_t moduleId;							///< Module ID.
+	uint8_t installed;						///< Flag if module is installed (1) or not (0).
+	uint8_t enabled;							///< Flag if module is enabled (1) or not (0).
+	uint16_t reserved;						///< Reserved (alignment).
+	uint64_t initializeDuration;			///< Duration of module initialize in previous run (nanoseconds).
+	uint64_t startDuration;					///< Duration of module start in previous run (nanoseconds).
+};
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Startup Plan.
+* @details	Startup plan file which is memory-mapped when opened. It contains header (config version and
+*				hash of module IDs to validate plan against current configuration) and array of
+*				@ref MsvStartupPlanModule in startup order.
+******************************************************************************************************/
+class MsvStartupPlan
+{
+public:
+	/**************************************************************************************************//**
+	* @brief		Constructor.
+	******************************************************************************************************/
+	MsvStartupPlan();
+
+	/**************************************************************************************************//**
+	* @brief		Virtual destructor.
+	* @details	Unmaps opened plan file.
+	******************************************************************************************************/
+	virtual ~MsvStartupPlan();
+
+	/**************************************************************************************************//**
+	* @brief			Open startup plan.
+	* @details		Maps startup plan file to memory and checks its header and size.
+	* @param[in]	path								Path of startup plan file.
+	* @retval		MSV_NOT_FOUND_ERROR			When file does not exist or can not be mapped.
+	* @retval		MSV_INVALID_DATA_ERROR		When file is not valid startup plan.
+	* @retval		MSV_SUCCESS						On success.
+	******************************************************************************************************/
+	virtual MsvErrorCode Open(const char* path);
+
+	/**************************************************************************************************//**
+	* @brief			Close startup plan.
+	* @details		Unmaps startup plan file.
+	******************************************************************************************************/
+	virtual void Close();
+
+	/**************************************************************************************************//**
+	* @brief			Check startup plan.
+	* @details		Checks if opened startup plan was created for the same configuration.
+	* @param[in]	configVersion					Version of current configuration.
+	* @param[in]	moduleSetHash					Hash of current module IDs (see @ref GetModuleIdHash).
+	* @retval		true								When plan is opened and matches.
+	* @retval		false								When plan is not opened or it does not match.
+	******************************************************************************************************/
+	virtual bool Matches(uint64_t configVersion, uint64_t moduleSetHash) const;
+
+	/**************************************************************************************************//**
+	* @brief			Get modules.
+	* @details		Returns pointer to modules in mapped file (valid until plan is closed).
+	* @returns		const MsvStartupPlanModule*
+	******************************************************************************************************/
+	virtual const MsvStartupPlanModule* GetModules() const;
+
+	/**************************************************************************************************//**
+	* @brief			Get module count.
+	* @details		Returns number of modules in opened plan (0 when not opened).
+	* @returns		uint32_t
+	******************************************************************************************************/
+	virtual uint32_t GetModuleCount() const;
+
+	/**************************************************************************************************//**
+	* @brief			Save startup plan.
+	* @details		Writes startup plan to file (file is replaced atomically).
+	* @param[in]	path								Path of startup plan file.
+	* @param[in]	configVersion					Version of configuration.
+	* @param[in]	moduleSetHash					Hash of module IDs (see @ref GetModuleIdHash).
+	* @param[in]	modules							Modules in startup order.
+	* @retval		MSV_NOT_FOUND_ERROR			When file can not be written.
+	* @retval		MSV_SUCCESS						On success.
+	******************************************************************************************************/
+	static MsvErrorCode Save(const char* path, uint64_t configVersion, uint64_t moduleSetHash, const std::vector<MsvStartupPlanModule>& modules);
+
+	/**************************************************************************************************//**
+	* @brief			Get module ID hash.
+	* @details		Returns hash of one module ID. Module set hash is sum of hashes of all module IDs
+	*					(it does not depend on order).
+	* @param[in]	moduleId							Module ID.
+	* @returns		uint64_t
+	******************************************************************************************************/
+	static uint64_t GetModuleIdHash(int32_t moduleId);
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Startup plan header.
+	* @details	Header of startup plan file.
+	******************************************************************************************************/
+	struct MsvStartupPlanHeader
+	{
+		uint32_t magic;						///< Magic number (@ref MSV_STARTUP_PLAN_MAGIC).
+		uint32_t version;						///< File format version (@ref MSV_STARTUP_PLAN_VERSION).
+		uint64_t configVersion;				///< Version of configuration.
+		uint64_t moduleSetHash;				///< Hash of module IDs.
+		uint32_t moduleCount;				///< Number of modules.
+		uint32_t reserved;					///< Reserved (alignment).
+	};
+
+	/**************************************************************************************************//**
+	* @brief		Magic number.
+	* @details	Magic number of startup plan file ("MSVP").
+	******************************************************************************************************/
+	static const uint32_t MSV_STARTUP_PLAN_MAGIC = 0x5056534D;
+
+	/**************************************************************************************************//**
+	* @brief		File format version.
+	* @details	Version of startup plan file format.
+	******************************************************************************************************/
+	static const uint32_t MSV_STARTUP_PLAN_VERSION = 1;
+
+	/**************************************************************************************************//**
+	* @brief		Mapped file.
+	* @details	Address of mapped startup plan file (nullptr when not opened).
+	******************************************************************************************************/
+	const void* m_pMapping;
+
+	/**************************************************************************************************//**
+	* @brief		Mapped size.
+	* @details	Size of mapped startup plan file.
+	******************************************************************************************************/
+	size_t m_mappingSize;
+
+#if defined(_WIN32)
+	/**************************************************************************************************//**
+	* @brief		Mapping handle.
+	* @details	Windows file mapping handle.
+	******************************************************************************************************/
+	void* m_hMapping;
+#endif
+};
+
+
+#endif // !MARSTECH_STARTUPPLAN_H
+
+/** @} */	//End of group MMODULE.
@@ -0,0 +1,543 @@
+/**************************************************************************************************//**
+* @addtogroup	MMODULE
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Static Module Registry
+* @details		Contains definition of @ref MsvStaticModule (compile-time module declaration),
+*					@ref MsvStaticModuleGraph (compile-time module order) and @ref MsvStaticModuleRegistry (module
+*					which manages fixed set of static modules).
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+* @note			This iplementation is in header file only -> it should be possible to include this header
+*					file to your project without linking this library.
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Module Library.
+
+MarsTech Dependency Injection is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef MARSTECH_STATICMODULEREGISTRY_H
+#define MARSTECH_STATICMODULEREGISTRY_H
+
+
+#include "MsvModuleLifecycle.h"
+#include "MsvModuleTimings.h"
+
+#include "merror/MsvErrorCodes.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <cstddef>
+#include <memory>
+#include <tuple>
+#include <utility>
+
+MSV_ENABLE_WARNINGS
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Static Module.
+* @details	Compile-time declaration of static module - its ID, type and IDs of modules it depends on.
+* @tparam		ModuleId				Module ID (unique in registry).
+* @tparam		Module				Module type (it must implement @ref IMsvModule, final type allows devirtualized calls).
+* @tparam		DependencyIds		IDs of modules this module depends on (they must be in the same registry).
+******************************************************************************************************/
+template<int32_t ModuleId, class Module, int32_t... DependencyIds>
+struct MsvStaticModule
+{
+	typedef Module ModuleType;												///< Module type.
+	static constexpr int32_t moduleId = ModuleId;						///< Module ID.
+	static constexpr size_t dependencyCount = sizeof...(DependencyIds);		///< Number of dependencies.
+
+	/**************************************************************************************************//**
+	* @brief			Depends on.
+	* @details		Checks if module depends on module with ID.
+	* @param[in]	id						Module ID.
+	* @returns		bool
+	******************************************************************************************************/
+	static constexpr bool DependsOn(int32_t id)
+	{
+		return Contains(id, DependencyIds...);
+	}
+
+protected:
+	static constexpr bool Contains(int32_t)
+	{
+		return false;
+	}
+
+	template<class... Ids>
+	static constexpr bool Contains(int32_t id, int32_t first, Ids... others)
+	{
+		return id == first || Contains(id, others...);
+	}
+};
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Static Module Graph.
+* @details	Compile-time dependency graph of static modules. Startup and shutdown orders are computed by Kahn's
+*				algorithm (lowest module ID first when more modules are ready - the same order as
+*				@ref MsvModuleManager uses) during compilation.
+* @tparam		Modules				Static modules (@ref MsvStaticModule).
+******************************************************************************************************/
+template<class... Modules>
+class MsvStaticModuleGraph
+{
+public:
+	static constexpr size_t moduleCount = sizeof...(Modules);								///< Number of modules.
+	static constexpr size_t arraySize = sizeof...(Modules) > 0 ? sizeof...(Modules) : 1;	///< Size of arrays (at least one item).
+
+	/**************************************************************************************************//**
+	* @brief		Module order.
+	* @details	Module indexes (order of declaration) in startup or shutdown order.
+	******************************************************************************************************/
+	struct Order
+	{
+		size_t indexes[arraySize];					///< Module indexes.
+		size_t count;									///< Number of ordered modules (lower than module count when there is cycle).
+	};
+
+	/**************************************************************************************************//**
+	* @brief			Get module ID.
+	* @param[in]	index					Module index (order of declaration).
+	* @returns		int32_t
+	******************************************************************************************************/
+	static constexpr int32_t GetModuleId(size_t index)
+	{
+		return GetModuleIds().values[index];
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Get module index.
+	* @param[in]	moduleId				Module ID.
+	* @returns		size_t (module count when module is not registered)
+	******************************************************************************************************/
+	static constexpr size_t GetModuleIndex(int32_t moduleId)
+	{
+		size_t index = 0;
+		while (index < moduleCount && GetModuleId(index) != moduleId)
+		{
+			++index;
+		}
+
+		return index;
+	}
+
+	/**************************************************************************************************//**
+	* @brief		Has unique IDs.
+	* @details	Checks that module IDs are unique.
+	* @returns	bool
+	******************************************************************************************************/
+	static constexpr bool HasUniqueIds()
+	{
+		for (size_t index = 0; index < moduleCount; ++index)
+		{
+			if (GetModuleIndex(GetModuleId(index)) != index)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	/**************************************************************************************************//**
+	* @brief		Has registered dependencies.
+	* @details	Checks that all dependencies are registered (and they are not duplicated).
+	* @returns	bool
+	******************************************************************************************************/
+	static constexpr bool HasRegisteredDependencies()
+	{
+		const Matrix matrix = GetDependencyMatrix();
+		const Values<size_t> dependencyCounts = { { Modules::dependencyCount... } };
+
+		for (size_t index = 0; index < moduleCount; ++index)
+		{
+			size_t registeredCount = 0;
+			for (size_t dependencyIndex = 0; dependencyIndex < moduleCount; ++dependencyIndex)
+			{
+				registeredCount += matrix.rows[index].values[dependencyIndex] ? 1 : 0;
+			}
+
+			if (registeredCount != dependencyCounts.values[index])
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Get order.
+	* @details		Orders modules by Kahn's algorithm.
+	* @param[in]	shutdown				Flag if it is shutdown order (dependents first) or startup order (dependencies first).
+	* @returns		Order
+	******************************************************************************************************/
+	static constexpr Order GetOrder(bool shutdown)
+	{
+		const Matrix matrix = GetDependencyMatrix();
+		Order order = {};
+		bool ordered[arraySize] = {};
+
+		while (order.count < moduleCount)
+		{
+			//ready module with lowest ID
+			size_t next = moduleCount;
+			for (size_t index = 0; index < moduleCount; ++index)
+			{
+				if (ordered[index] || (next < moduleCount && GetModuleId(next) < GetModuleId(index)))
+				{
+					continue;
+				}
+
+				bool ready = true;
+				for (size_t otherIndex = 0; otherIndex < moduleCount && ready; ++otherIndex)
+				{
+					bool edge = shutdown ? matrix.rows[otherIndex].values[index] : matrix.rows[index].values[otherIndex];
+					ready = !edge || ordered[otherIndex];
+				}
+
+				if (ready)
+				{
+					next = index;
+				}
+			}
+
+			if (next == moduleCount)
+			{
+				//no module is ready -> cycle
+				break;
+			}
+
+			ordered[next] = true;
+			order.indexes[order.count++] = next;
+		}
+
+		return order;
+	}
+
+protected:
+	template<class T>
+	struct Values
+	{
+		T values[arraySize];
+	};
+
+	struct Matrix
+	{
+		Values<bool> rows[arraySize];			///< rows[i].values[j] - module i depends on module j
+	};
+
+	static constexpr Values<int32_t> GetModuleIds()
+	{
+		return Values<int32_t>{ { Modules::moduleId... } };
+	}
+
+	template<class Module>
+	static constexpr Values<bool> GetDependencyRow()
+	{
+		return Values<bool>{ { Module::DependsOn(Modules::moduleId)... } };
+	}
+
+	static constexpr Matrix GetDependencyMatrix()
+	{
+		return Matrix{ { GetDependencyRow<Modules>()... } };
+	}
+};
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Static Module Registry.
+* @details	Module which manages fixed set of static modules declared at compile time. Module IDs are checked to
+*				be unique, dependencies to be registered and acyclic during compilation, and startup and shutdown
+*				orders are computed during compilation. Modules are stored in tuple (no allocations) and they are called
+*				through their own types in precomputed order (no map lookups, no sorting, devirtualized calls of final
+*				module types).
+*				Registry is one module for module manager - add it by @ref IMsvModuleManager::AddModule (with its own
+*				ID and configurator) together with dynamically added DLL modules. DLL modules can depend on registry by
+*				@ref MsvModuleManager::AddModuleDependency.
+*				Initialize initializes modules in startup order and uninitializes them in shutdown order when any of them
+*				failed. Start does the same with start and stop. Stop and Uninitialize process all modules in shutdown
+*				order and return error code of last failed module.
+* @tparam		Modules				Static modules (@ref MsvStaticModule).
+* @note		Static modules are always installed and enabled (installed and enabled flag of registry applies to all
+*				of them).
+*
+* @code
+* typedef MsvStaticModuleRegistry<
+*	MsvStaticModule<MY_STORAGE_MODULE_ID, MyStorageModule>,
+*	MsvStaticModule<MY_NETWORK_MODULE_ID, MyNetworkModule, MY_STORAGE_MODULE_ID>> MyStaticModules;
+*
+* std::shared_ptr<MyStaticModules> spStaticModules(new MyStaticModules(spLoggerProvider, spStorageModule, spNetworkModule));
+* moduleManager.AddModule(MY_STATIC_MODULES_ID, spStaticModules, spStaticModulesConfigurator);
+* @endcode
+******************************************************************************************************/
+template<class... Modules>
+class MsvStaticModuleRegistry:
+	public MsvModuleLifecycle<MsvStaticModuleRegistry<Modules...>, MsvModuleBase>
+{
+	friend class MsvModuleLifecycle<MsvStaticModuleRegistry<Modules...>, MsvModuleBase>;
+
+public:
+	typedef MsvStaticModuleGraph<Modules...> Graph;										///< Module graph.
+
+	/**************************************************************************************************//**
+	* @brief		Module type.
+	* @tparam	Index					Module index (order of declaration).
+	******************************************************************************************************/
+	template<size_t Index>
+	using ModuleType = typename std::tuple_element<Index, std::tuple<Modules...>>::type::ModuleType;
+
+	static_assert(Graph::moduleCount > 0, "Static module registry must contain at least one module.");
+	static_assert(Graph::HasUniqueIds(), "Static module IDs must be unique.");
+	static_assert(Graph::HasRegisteredDependencies(), "Static module dependencies must be registered in the same registry (and not duplicated).");
+	static_assert(Graph::GetOrder(false).count == Graph::moduleCount, "Static module dependencies must not contain cycle.");
+
+	/**************************************************************************************************//**
+	* @brief			Constructor.
+	* @param[in]	spLoggerProvider	Shared pointer to logger provider.
+	* @param[in]	spModules			Shared pointers to modules (in order of declaration).
+	******************************************************************************************************/
+	MsvStaticModuleRegistry(std::shared_ptr<IMsvLoggerProvider> spLoggerProvider, std::shared_ptr<typename Modules::ModuleType>... spModules):
+		MsvModuleLifecycle<MsvStaticModuleRegistry<Modules...>, MsvModuleBase>(spLoggerProvider, "MsvStaticModuleRegistry"),
+		m_modules(spModules...)
+	{
+
+	}
+
+	/**************************************************************************************************//**
+	* @brief		Virtual destructor.
+	******************************************************************************************************/
+	virtual ~MsvStaticModuleRegistry() {}
+
+	/*-----------------------------------------------------------------------------------------------------
+	**											MsvStaticModuleRegistry public methods
+	**---------------------------------------------------------------------------------------------------*/
+public:
+	/**************************************************************************************************//**
+	* @brief		Get module count.
+	* @returns	size_t
+	******************************************************************************************************/
+	static constexpr size_t GetModuleCount()
+	{
+		return Graph::moduleCount;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Get startup module ID.
+	* @param[in]	position				Position in startup order (dependencies first).
+	* @returns		int32_t
+	******************************************************************************************************/
+	static constexpr int32_t GetStartupModuleId(size_t position)
+	{
+		return Graph::GetModuleId(Graph::GetOrder(false).indexes[position]);
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Get shutdown module ID.
+	* @param[in]	position				Position in shutdown order (dependents first).
+	* @returns		int32_t
+	******************************************************************************************************/
+	static constexpr int32_t GetShutdownModuleId(size_t position)
+	{
+		return Graph::GetModuleId(Graph::GetOrder(true).indexes[position]);
+	}
+
+	/**************************************************************************************************//**
+	* @brief		Get module.
+	* @details	Returns module by its ID (checked at compile time).
+	* @tparam	ModuleId				Module ID.
+	* @returns	std::shared_ptr<ModuleType<Index>>
+	******************************************************************************************************/
+	template<int32_t ModuleId>
+	std::shared_ptr<ModuleType<Graph::GetModuleIndex(ModuleId)>> GetModule() const
+	{
+		return std::get<Graph::GetModuleIndex(ModuleId)>(m_modules);
+	}
+
+protected:
+	/**************************************************************************************************//**
+	* @brief			Initialize hook.
+	* @details		Initializes modules in startup order (uninitializes them when any of them failed).
+	* @retval		other_error_code		Error code of failed module.
+	* @retval		MSV_SUCCESS				On success.
+	******************************************************************************************************/
+	MsvErrorCode OnInitialize()
+	{
+		MsvErrorCode errorCode = ModulesTransition<false>(MsvModuleTransition::MSV_MODULE_TRANSITION_INITIALIZE, true, std::make_index_sequence<sizeof...(Modules)>());
+		if (MSV_FAILED(errorCode))
+		{
+			ModulesTransition<true>(MsvModuleTransition::MSV_MODULE_TRANSITION_UNINITIALIZE, false, std::make_index_sequence<sizeof...(Modules)>());
+		}
+
+		return errorCode;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Uninitialize hook.
+	* @details		Uninitializes modules in shutdown order.
+	* @retval		other_error_code		Error code of last failed module.
+	* @retval		MSV_SUCCESS				On success.
+	******************************************************************************************************/
+	MsvErrorCode OnUninitialize()
+	{
+		return ModulesTransition<true>(MsvModuleTransition::MSV_MODULE_TRANSITION_UNINITIALIZE, false, std::make_index_sequence<sizeof...(Modules)>());
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Start hook.
+	* @details		Starts modules in startup order (stops them when any of them failed).
+	* @retval		other_error_code		Error code of failed module.
+	* @retval		MSV_SUCCESS				On success.
+	******************************************************************************************************/
+	MsvErrorCode OnStart()
+	{
+		MsvErrorCode errorCode = ModulesTransition<false>(MsvModuleTransition::MSV_MODULE_TRANSITION_START, true, std::make_index_sequence<sizeof...(Modules)>());
+		if (MSV_FAILED(errorCode))
+		{
+			ModulesTransition<true>(MsvModuleTransition::MSV_MODULE_TRANSITION_STOP, false, std::make_index_sequence<sizeof...(Modules)>());
+		}
+
+		return errorCode;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Stop hook.
+	* @details		Stops modules in shutdown order.
+	* @retval		other_error_code		Error code of last failed module.
+	* @retval		MSV_SUCCESS				On success.
+	******************************************************************************************************/
+	MsvErrorCode OnStop()
+	{
+		return ModulesTransition<true>(MsvModuleTransition::MSV_MODULE_TRANSITION_STOP, false, std::make_index_sequence<sizeof...(Modules)>());
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Get ordered index.
+	* @param[in]	shutdown				Flag if it is shutdown order (true) or startup order (false).
+	* @param[in]	position				Position in order.
+	* @returns		size_t (module index)
+	******************************************************************************************************/
+	static constexpr size_t GetOrderedIndex(bool shutdown, size_t position)
+	{
+		return Graph::GetOrder(shutdown).indexes[position];
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Modules transition.
+	* @details		Calls transition of all modules in startup or shutdown order (order is expanded at compile time).
+	* @tparam		Shutdown				Flag if modules are processed in shutdown order (true) or startup order (false).
+	* @param[in]	transition			Module transition.
+	* @param[in]	stopOnFailure		Flag if remaining modules are skipped when module failed.
+	* @retval		other_error_code		Error code of (last) failed module.
+	* @retval		MSV_SUCCESS				On success.
+	******************************************************************************************************/
+	template<bool Shutdown, size_t... Positions>
+	MsvErrorCode ModulesTransition(MsvModuleTransition transition, bool stopOnFailure, std::index_sequence<Positions...>)
+	{
+		MsvErrorCode errorCode = MSV_SUCCESS;
+
+		//initializer list is evaluated from left to right
+		int expand[] = { 0, ((stopOnFailure && MSV_FAILED(errorCode)) ? 0 : UpdateErrorCode(errorCode, ModuleTransition<GetOrderedIndex(Shutdown, Positions)>(transition)))... };
+		(void)expand;
+
+		return errorCode;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Module transition.
+	* @details		Calls transition of module when module is not in target state.
+	* @tparam		Index					Module index (order of declaration).
+	* @param[in]	transition			Module transition.
+	* @retval		MSV_INVALID_DATA_ERROR		When module is empty.
+	* @retval		other_error_code				Error code returned by module.
+	* @retval		MSV_SUCCESS						On success (or when module is already in target state).
+	******************************************************************************************************/
+	template<size_t Index>
+	MsvErrorCode ModuleTransition(MsvModuleTransition transition)
+	{
+		const std::shared_ptr<ModuleType<Index>>& spModule = std::get<Index>(m_modules);
+		if (!spModule)
+		{
+			MSV_LOG_ERROR(this->m_spLogger, "Static module {} is empty - failed with error: {0:x}", Graph::GetModuleId(Index), MSV_INVALID_DATA_ERROR);
+			return MSV_INVALID_DATA_ERROR;
+		}
+
+		MsvErrorCode errorCode = MSV_SUCCESS;
+		switch (transition)
+		{
+		case MsvModuleTransition::MSV_MODULE_TRANSITION_INITIALIZE:
+			errorCode = spModule->Initialized() ? MSV_SUCCESS : spModule->Initialize();
+			break;
+		case MsvModuleTransition::MSV_MODULE_TRANSITION_START:
+			errorCode = (!spModule->Initialized() || spModule->Running()) ? MSV_SUCCESS : spModule->Start();
+			break;
+		case MsvModuleTransition::MSV_MODULE_TRANSITION_STOP:
+			errorCode = spModule->Running() ? spModule->Stop() : MSV_SUCCESS;
+			break;
+		case MsvModuleTransition::MSV_MODULE_TRANSITION_UNINITIALIZE:
+			errorCode = spModule->Initialized() ? spModule->Uninitialize() : MSV_SUCCESS;
+			break;
+		default:
+			errorCode = MSV_INVALID_DATA_ERROR;
+			break;
+		}
+
+		if (MSV_FAILED(errorCode))
+		{
+			MSV_LOG_ERROR(this->m_spLogger, "Transition {} of static module {} failed with error: {0:x}", static_cast<int32_t>(transition), Graph::GetModuleId(Index), errorCode);
+		}
+
+		return errorCode;
+	}
+
+	/**************************************************************************************************//**
+	* @brief				Update error code.
+	* @details			Keeps error code of module when it failed.
+	* @param[in,out]	errorCode			Error code of all modules.
+	* @param[in]		moduleErrorCode	Error code of module.
+	* @returns			int (always zero - it is used in pack expansion)
+	******************************************************************************************************/
+	static int UpdateErrorCode(MsvErrorCode& errorCode, MsvErrorCode moduleErrorCode)
+	{
+		if (MSV_FAILED(moduleErrorCode))
+		{
+			errorCode = moduleErrorCode;
+		}
+
+		return 0;
+	}
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Modules.
+	* @details	Shared pointers to modules (in order of declaration).
+	******************************************************************************************************/
+	std::tuple<std::shared_ptr<typename Modules::ModuleType>...> m_modules;
+};
+
+
+#endif // !MARSTECH_STATICMODULEREGISTRY_H
+
+/** @} */	//End of group MMODULE.
@@ -0,0 +1,354 @@
+/**************************************************************************************************//**
+* @addtogroup	MMODULE
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Thread Pool
+* @details		Contains implementation of @ref MsvThreadPool.
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Module Library.
+
+MarsTech Dependency Injection is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "MsvThreadPool.h"
+
+#include "merror/MsvErrorCodes.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <exception>
+#include <system_error>
+
+MSV_ENABLE_WARNINGS
+
+
+namespace
+{
+
+/**************************************************************************************************//**
+* @brief		Thread pool of current worker thread (nullptr when current thread is not worker).
+******************************************************************************************************/
+thread_local MsvThreadPool* t_pWorkerPool = nullptr;
+
+/**************************************************************************************************//**
+* @brief		Index of current worker thread.
+******************************************************************************************************/
+thread_local size_t t_workerIndex = 0;
+
+}
+
+
+/********************************************************************************************************************************
+*															Constructors and destructors
+********************************************************************************************************************************/
+
+
+MsvThreadPool::MsvThreadPool(size_t threadCount, std::shared_ptr<MsvLogger> spLogger):
+	m_running(false),
+	m_workersStarted(false),
+	m_stopping(false),
+	m_pendingCount(0),
+	m_nextQueue(0),
+	m_spLogger(spLogger)
+{
+	if (threadCount == 0)
+	{
+		threadCount = std::thread::hardware_concurrency();
+	}
+
+	if (threadCount == 0)
+	{
+		//hardware concurrency is not known
+		threadCount = 1;
+	}
+
+	for (size_t i = 0; i < threadCount; ++i)
+	{
+		m_queues.emplace_back(new MsvWorkerQueue());
+	}
+}
+
+MsvThreadPool::~MsvThreadPool()
+{
+	Stop();
+}
+
+
+/********************************************************************************************************************************
+*															IMsvThreadPool public methods
+********************************************************************************************************************************/
+
+
+MsvErrorCode MsvThreadPool::Submit(std::function<void()> task)
+{
+	if (!task)
+	{
+		return MSV_INVALID_DATA_ERROR;
+	}
+
+	//pending count is increased before running check -> workers do not exit before the task is queued
+	m_pendingCount.fetch_add(1);
+
+	if (!m_running.load() && t_pWorkerPool != this)
+	{
+		//tasks submitted by running tasks are accepted while thread pool is stopping (they are part of drained work)
+		m_pendingCount.fetch_sub(1);
+		return MSV_NOT_INITIALIZED_ERROR;
+	}
+
+	if (!m_workersStarted.load() && t_pWorkerPool != this)
+	{
+		//lazily started thread pool -> the first task starts workers (task submitted by worker is queued to its queue)
+		std::unique_lock<std::mutex> lock(m_lock);
+
+		MsvErrorCode errorCode = MSV_SUCCESS;
+		if (!m_running)
+		{
+			//thread pool has been stopped meanwhile
+			errorCode = MSV_NOT_INITIALIZED_ERROR;
+		}
+		else if (!m_workersStarted)
+		{
+			errorCode = StartWorkers(lock);
+		}
+
+		if (MSV_FAILED(errorCode))
+		{
+			m_pendingCount.fetch_sub(1);
+			return errorCode;
+		}
+	}
+
+	size_t index = (t_pWorkerPool == this) ? t_workerIndex : m_nextQueue.fetch_add(1, std::memory_order_relaxed) % m_queues.size();
+
+	{
+		std::lock_guard<std::mutex> queueLock(m_queues[index]->lock);
+		m_queues[index]->tasks.push_back(std::move(task));
+	}
+
+	{
+		//lock ensures waiting worker is not just between its check and wait
+		std::lock_guard<std::mutex> lock(m_lock);
+	}
+	m_condition.notify_one();
+
+	return MSV_SUCCESS;
+}
+
+size_t MsvThreadPool::GetThreadCount() const
+{
+	//queues are created in constructor (no need to lock thread pool)
+	return m_queues.size();
+}
+
+
+/********************************************************************************************************************************
+*															MsvThreadPool public methods
+********************************************************************************************************************************/
+
+
+MsvErrorCode MsvThreadPool::Start(bool lazy)
+{
+	std::unique_lock<std::mutex> lock(m_lock);
+
+	if (m_running)
+	{
+		return MSV_ALREADY_RUNNING_INFO;
+	}
+
+	m_stopping = false;
+
+	if (!lazy)
+	{
+		MSV_RETURN_FAILED(StartWorkers(lock));
+	}
+
+	m_running = true;
+
+	return MSV_SUCCESS;
+}
+
+MsvErrorCode MsvThreadPool::Stop()
+{
+	std::vector<std::thread> threads;
+
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+
+		if (!m_running)
+		{
+			return MSV_NOT_RUNNING_INFO;
+		}
+
+		m_running = false;
+		m_workersStarted = false;
+		m_stopping = true;
+		threads.swap(m_threads);
+	}
+
+	m_condition.notify_all();
+
+	//workers run all queued tasks before they exit
+	for (std::vector<std::thread>::iterator it = threads.begin(); it != threads.end(); ++it)
+	{
+		it->join();
+	}
+
+	return MSV_SUCCESS;
+}
+
+bool MsvThreadPool::Running() const
+{
+	return m_running.load();
+}
+
+bool MsvThreadPool::WorkersStarted() const
+{
+	return m_workersStarted.load();
+}
+
+
+/********************************************************************************************************************************
+*															MsvThreadPool protected methods
+********************************************************************************************************************************/
+
+
+void MsvThreadPool::Worker(size_t index)
+{
+	t_pWorkerPool = this;
+	t_workerIndex = index;
+
+	std::function<void()> task;
+
+	for (;;)
+	{
+		if (PopTask(index, task))
+		{
+			m_pendingCount.fetch_sub(1);
+			try
+			{
+				task();
+			}
+			catch (const std::exception& exception)
+			{
+				//worker must survive failed task (other tasks are still queued)
+				MSV_LOG_ERROR(m_spLogger, "Task of thread pool failed with exception: {}", exception.what());
+			}
+			catch (...)
+			{
+				MSV_LOG_ERROR(m_spLogger, "Task of thread pool failed with unknown exception.");
+			}
+			task = nullptr;
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(m_lock);
+
+		if (m_pendingCount.load() != 0)
+		{
+			//task is being queued right now
+			lock.unlock();
+			std::this_thread::yield();
+			continue;
+		}
+
+		if (m_stopping)
+		{
+			break;
+		}
+
+		m_condition.wait(lock, [this]() { return m_stopping || m_pendingCount.load() != 0; });
+	}
+
+	t_pWorkerPool = nullptr;
+}
+
+bool MsvThreadPool::PopTask(size_t index, std::function<void()>& task)
+{
+	{
+		//own queue - the last submitted task first (it is hot in cache)
+		MsvWorkerQueue& queue = *m_queues[index];
+		std::lock_guard<std::mutex> queueLock(queue.lock);
+
+		if (!queue.tasks.empty())
+		{
+			task = std::move(queue.tasks.back());
+			queue.tasks.pop_back();
+			return true;
+		}
+	}
+
+	for (size_t i = 1; i < m_queues.size(); ++i)
+	{
+		//steal the oldest task of other worker
+		MsvWorkerQueue& queue = *m_queues[(index + i) % m_queues.size()];
+		std::lock_guard<std::mutex> queueLock(queue.lock);
+
+		if (!queue.tasks.empty())
+		{
+			task = std::move(queue.tasks.front());
+			queue.tasks.pop_front();
+			return true;
+		}
+	}
+
+	return false;
+}
+
+MsvErrorCode MsvThreadPool::StartWorkers(std::unique_lock<std::mutex>& lock)
+{
+	try
+	{
+		for (size_t i = 0; i < m_queues.size(); ++i)
+		{
+			m_threads.emplace_back(&MsvThreadPool::Worker, this, i);
+		}
+	}
+	catch (const std::system_error&)
+	{
+		//stop already started workers (they need thread pool lock to exit)
+		std::vector<std::thread> threads;
+		m_stopping = true;
+		threads.swap(m_threads);
+		lock.unlock();
+
+		m_condition.notify_all();
+		for (std::vector<std::thread>::iterator it = threads.begin(); it != threads.end(); ++it)
+		{
+			it->join();
+		}
+
+		//thread pool can start workers again
+		lock.lock();
+		m_stopping = false;
+
+		return MSV_ALLOCATION_ERROR;
+	}
+
+	m_workersStarted = true;
+
+	return MSV_SUCCESS;
+}
+
+/** @} */	//End of group MMODULE.
@@ -0,0 +1,236 @@
+/**************************************************************************************************//**
+* @addtogroup	MMODULE
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Thread Pool
+* @details		Contains definition of @ref MsvThreadPool (work stealing implementation of @ref IMsvThreadPool).
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Module Library.
+
+MarsTech Dependency Injection is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef MARSTECH_THREADPOOL_H
+#define MARSTECH_THREADPOOL_H
+
+
+#include "IMsvThreadPool.h"
+
+#include "mlogging/mlogging.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+MSV_ENABLE_WARNINGS
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Thread Pool.
+* @details	Work stealing thread pool. Every worker has its own task queue - worker takes tasks from back of its
+*				queue (the last submitted first) and idle worker steals tasks from front of queues of other workers.
+*				Tasks submitted from worker thread are queued to its queue, other tasks are distributed round robin.
+*				Thread pool started lazily creates its worker threads when the first task is submitted.
+* @note		Tasks must not start or stop thread pool. Exceptions thrown by tasks are caught and logged.
+******************************************************************************************************/
+class MsvThreadPool:
+	public IMsvThreadPool
+{
+public:
+	/**************************************************************************************************//**
+	* @brief			Constructor.
+	* @param[in]	threadCount			Number of worker threads (0 - number of hardware threads).
+	* @param[in]	spLogger				Shared pointer to logger (exceptions thrown by tasks are logged).
+	******************************************************************************************************/
+	MsvThreadPool(size_t threadCount = 0, std::shared_ptr<MsvLogger> spLogger = nullptr);
+
+	/**************************************************************************************************//**
+	* @brief		Virtual destructor.
+	* @details	Stops thread pool.
+	******************************************************************************************************/
+	virtual ~MsvThreadPool();
+
+	MsvThreadPool(const MsvThreadPool&) = delete;
+	MsvThreadPool& operator=(const MsvThreadPool&) = delete;
+
+	/*-----------------------------------------------------------------------------------------------------
+	**											IMsvThreadPool public methods
+	**---------------------------------------------------------------------------------------------------*/
+public:
+	/**************************************************************************************************//**
+	* @copydoc IMsvThreadPool::Submit(std::function<void()> task)
+	******************************************************************************************************/
+	virtual MsvErrorCode Submit(std::function<void()> task) override;
+
+	/**************************************************************************************************//**
+	* @copydoc IMsvThreadPool::GetThreadCount() const
+	******************************************************************************************************/
+	virtual size_t GetThreadCount() const override;
+
+	/*-----------------------------------------------------------------------------------------------------
+	**											MsvThreadPool public methods
+	**---------------------------------------------------------------------------------------------------*/
+public:
+	/**************************************************************************************************//**
+	* @brief			Start thread pool.
+	* @details		Starts worker threads (lazily started thread pool accepts tasks and starts worker threads when
+	*					the first task is submitted - idle module manager does not cost any threads).
+	* @param[in]	lazy										Flag if worker threads are started by the first task (true) or now (false).
+	* @retval		MSV_ALREADY_RUNNING_INFO			When thread pool is already running.
+	* @retval		MSV_ALLOCATION_ERROR					When worker threads could not be started.
+	* @retval		MSV_SUCCESS								On success.
+	******************************************************************************************************/
+	virtual MsvErrorCode Start(bool lazy = false);
+
+	/**************************************************************************************************//**
+	* @brief			Stop thread pool.
+	* @details		Rejects new tasks (except tasks submitted by running tasks), runs all queued tasks and joins
+	*					worker threads.
+	* @retval		MSV_NOT_RUNNING_INFO					When thread pool is not running.
+	* @retval		MSV_SUCCESS								On success.
+	* @warning		It must not be called from worker thread.
+	******************************************************************************************************/
+	virtual MsvErrorCode Stop();
+
+	/**************************************************************************************************//**
+	* @brief		Get running flag.
+	* @retval	true		When thread pool is running.
+	* @retval	false		When thread pool is not running.
+	******************************************************************************************************/
+	virtual bool Running() const;
+
+	/**************************************************************************************************//**
+	* @brief		Get workers started flag.
+	* @retval	true		When worker threads are running.
+	* @retval	false		When worker threads are not running (thread pool is stopped or it waits for the first task).
+	******************************************************************************************************/
+	virtual bool WorkersStarted() const;
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Worker queue.
+	* @details	Task queue of one worker (locked by its own mutex - workers do not block each other).
+	******************************************************************************************************/
+	struct MsvWorkerQueue
+	{
+		std::mutex lock;										///< Queue mutex.
+		std::deque<std::function<void()>> tasks;		///< Queued tasks.
+	};
+
+	/**************************************************************************************************//**
+	* @brief			Worker thread.
+	* @details		Runs tasks until thread pool is stopped and all queues are empty.
+	* @param[in]	index					Worker index.
+	******************************************************************************************************/
+	virtual void Worker(size_t index);
+
+	/**************************************************************************************************//**
+	* @brief			Pop task.
+	* @details		Pops task from back of own queue or steals task from front of other queue.
+	* @param[in]	index					Worker index.
+	* @param[out]	task					Popped task.
+	* @retval		true					When task has been popped.
+	* @retval		false					When all queues are empty.
+	******************************************************************************************************/
+	virtual bool PopTask(size_t index, std::function<void()>& task);
+
+	/**************************************************************************************************//**
+	* @brief			Start workers.
+	* @details		Starts worker threads (already started workers are stopped when any worker can not be started).
+	* @param[in]	lock										Locked thread pool lock (it is unlocked while started workers are stopped).
+	* @retval		MSV_ALLOCATION_ERROR					When worker threads could not be started.
+	* @retval		MSV_SUCCESS								On success.
+	******************************************************************************************************/
+	virtual MsvErrorCode StartWorkers(std::unique_lock<std::mutex>& lock);
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Thread pool mutex.
+	* @details	Locks running flag, worker threads and idle waiting.
+	******************************************************************************************************/
+	mutable std::mutex m_lock;
+
+	/**************************************************************************************************//**
+	* @brief		Condition variable.
+	* @details	Idle workers wait for new tasks.
+	******************************************************************************************************/
+	std::condition_variable m_condition;
+
+	/**************************************************************************************************//**
+	* @brief		Running flag.
+	* @details	Flag if thread pool accepts tasks (true) or not (false).
+	******************************************************************************************************/
+	std::atomic<bool> m_running;
+
+	/**************************************************************************************************//**
+	* @brief		Workers started flag.
+	* @details	Flag if worker threads are running (lazily started thread pool starts them by the first task).
+	******************************************************************************************************/
+	std::atomic<bool> m_workersStarted;
+
+	/**************************************************************************************************//**
+	* @brief		Stopping flag.
+	* @details	Flag if workers should exit when queues are empty.
+	******************************************************************************************************/
+	bool m_stopping;
+
+	/**************************************************************************************************//**
+	* @brief		Pending task count.
+	* @details	Number of queued tasks (idle workers wait when it is zero).
+	******************************************************************************************************/
+	std::atomic<size_t> m_pendingCount;
+
+	/**************************************************************************************************//**
+	* @brief		Next queue.
+	* @details	Index of queue for next task submitted from other than worker thread.
+	******************************************************************************************************/
+	std::atomic<size_t> m_nextQueue;
+
+	/**************************************************************************************************//**
+	* @brief		Worker queues.
+	******************************************************************************************************/
+	std::vector<std::unique_ptr<MsvWorkerQueue>> m_queues;
+
+	/**************************************************************************************************//**
+	* @brief		Worker threads.
+	******************************************************************************************************/
+	std::vector<std::thread> m_threads;
+
+	/**************************************************************************************************//**
+	* @brief		Logger.
+	* @details	Shared pointer to logger for logging.
+	******************************************************************************************************/
+	std::shared_ptr<MsvLogger> m_spLogger;
+};
+
+
+#endif // !MARSTECH_THREADPOOL_H
+
+/** @} */	//End of group MMODULE.
@@ -0,0 +1,263 @@
+/**************************************************************************************************//**
+* @addtogroup	MMODULE
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Trace Recorder
+* @details		Contains implementation of @ref MsvTraceRecorder and @ref MsvTraceScope.
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Module Library.
+
+MarsTech Dependency Injection is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "MsvTraceRecorder.h"
+
+#include "merror/MsvErrorCodes.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <utility>
+
+#if defined(_WIN32)
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+MSV_ENABLE_WARNINGS
+
+
+/********************************************************************************************************************************
+*															Constructors and destructors
+********************************************************************************************************************************/
+
+
+MsvTraceRecorder::MsvTraceRecorder(size_t reservedEvents):
+	m_traceStart(std::chrono::steady_clock::now())
+{
+	m_events.reserve(reservedEvents);
+}
+
+
+MsvTraceRecorder::~MsvTraceRecorder()
+{
+
+}
+
+
+/********************************************************************************************************************************
+*															Public methods
+********************************************************************************************************************************/
+
+
+void MsvTraceRecorder::Begin(const std::string& name, const char* category)
+{
+	Record(name, category, 'B', MSV_SUCCESS);
+}
+
+void MsvTraceRecorder::End(const std::string& name, const char* category, MsvErrorCode errorCode)
+{
+	Record(name, category, 'E', errorCode);
+}
+
+void MsvTraceRecorder::GetEvents(std::vector<MsvTraceEvent>& events) const
+{
+	std::lock_guard<std::recursive_mutex> lock(m_lock);
+
+	events = m_events;
+}
+
+void MsvTraceRecorder::Clear()
+{
+	std::lock_guard<std::recursive_mutex> lock(m_lock);
+
+	m_events.clear();
+}
+
+void MsvTraceRecorder::Export(std::string& json) const
+{
+	std::lock_guard<std::recursive_mutex> lock(m_lock);
+
+#if defined(_WIN32)
+	int processId = _getpid();
+#else
+	int processId = static_cast<int>(getpid());
+#endif
+
+	json = "{\"traceEvents\":[";
+	for (std::vector<MsvTraceEvent>::const_iterator it = m_events.begin(); it != m_events.end(); ++it)
+	{
+		if (it != m_events.begin())
+		{
+			json += ",";
+		}
+
+		json += "\n{\"name\":\"";
+
+		//escape name (it is JSON string)
+		for (std::string::const_iterator nameIt = it->name.begin(); nameIt != it->name.end(); ++nameIt)
+		{
+			if (*nameIt == '"' || *nameIt == '\\')
+			{
+				json += '\\';
+				json += *nameIt;
+			}
+			else if (static_cast<unsigned char>(*nameIt) < 0x20)
+			{
+				char escaped[8];
+				std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned int>(static_cast<unsigned char>(*nameIt)));
+				json += escaped;
+			}
+			else
+			{
+				json += *nameIt;
+			}
+		}
+
+		//timestamp is in microseconds (fraction keeps nanoseconds)
+		char buffer[256];
+		std::snprintf(buffer, sizeof(buffer), "\",\"cat\":\"%s\",\"ph\":\"%c\",\"ts\":%lld.%03lld,\"pid\":%d,\"tid\":%u",
+			it->category ? it->category : "", it->phase, static_cast<long long>(it->timestamp.count() / 1000), static_cast<long long>(it->timestamp.count() % 1000),
+			processId, static_cast<unsigned int>(it->threadId));
+		json += buffer;
+
+		if (it->phase == 'E')
+		{
+			std::snprintf(buffer, sizeof(buffer), ",\"args\":{\"errorCode\":\"0x%x\"}", static_cast<unsigned int>(it->errorCode));
+			json += buffer;
+		}
+
+		json += "}";
+	}
+	json += "\n],\"displayTimeUnit\":\"ms\"}\n";
+}
+
+MsvErrorCode MsvTraceRecorder::Export(const char* path) const
+{
+	if (!path)
+	{
+		return MSV_INVALID_DATA_ERROR;
+	}
+
+	std::string json;
+	Export(json);
+
+	std::ofstream file(path, std::ios::out | std::ios::binary | std::ios::trunc);
+	if (!file)
+	{
+		return MSV_NOT_FOUND_ERROR;
+	}
+
+	file.write(json.data(), json.size());
+	if (!file)
+	{
+		return MSV_NOT_FOUND_ERROR;
+	}
+
+	return MSV_SUCCESS;
+}
+
+
+/********************************************************************************************************************************
+*															Protected methods
+********************************************************************************************************************************/
+
+
+void MsvTraceRecorder::Record(const std::string& name, const char* category, char phase, MsvErrorCode errorCode)
+{
+	//take timestamp before lock (waiting for lock is not part of traced operation)
+	std::chrono::nanoseconds timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_traceStart);
+
+	std::lock_guard<std::recursive_mutex> lock(m_lock);
+
+	std::unordered_map<std::thread::id, uint32_t>::iterator threadIt = m_threadIds.find(std::this_thread::get_id());
+	if (threadIt == m_threadIds.end())
+	{
+		threadIt = m_threadIds.emplace(std::this_thread::get_id(), static_cast<uint32_t>(m_threadIds.size() + 1)).first;
+	}
+
+	MsvTraceEvent traceEvent;
+	traceEvent.name = name;
+	traceEvent.category = category;
+	traceEvent.phase = phase;
+	traceEvent.timestamp = timestamp;
+	traceEvent.threadId = threadIt->second;
+	traceEvent.errorCode = errorCode;
+
+	m_events.push_back(traceEvent);
+}
+
+
+/********************************************************************************************************************************
+*															MsvTraceScope
+********************************************************************************************************************************/
+
+
+MsvTraceScope::MsvTraceScope(const std::shared_ptr<MsvTraceRecorder>& spTraceRecorder, const char* name, const char* category):
+	m_spTraceRecorder(spTraceRecorder),
+	m_category(category),
+	m_errorCode(MSV_SUCCESS)
+{
+	if (m_spTraceRecorder)
+	{
+		//name is not built (allocated) when tracing is off
+		m_name = name;
+		m_spTraceRecorder->Begin(m_name, m_category);
+	}
+}
+
+
+MsvTraceScope::MsvTraceScope(const std::shared_ptr<MsvTraceRecorder>& spTraceRecorder, const char* namePrefix, const std::string& nameId, const char* category):
+	m_spTraceRecorder(spTraceRecorder),
+	m_category(category),
+	m_errorCode(MSV_SUCCESS)
+{
+	if (m_spTraceRecorder)
+	{
+		m_name.reserve(strlen(namePrefix) + nameId.size());
+		m_name.append(namePrefix).append(nameId);
+		m_spTraceRecorder->Begin(m_name, m_category);
+	}
+}
+
+
+MsvTraceScope::~MsvTraceScope()
+{
+	if (m_spTraceRecorder)
+	{
+		m_spTraceRecorder->End(m_name, m_category, m_errorCode);
+	}
+}
+
+
+void MsvTraceScope::SetErrorCode(MsvErrorCode errorCode)
+{
+	m_errorCode = errorCode;
+}
+
+
+/** @} */	//End of group MMODULE.
@@ -0,0 +1,238 @@
+/**************************************************************************************************//**
+* @addtogroup	MMODULE
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Trace Recorder
+* @details		Contains definition of @ref MsvTraceRecorder (trace events in Chrome trace-event format) and
+*					@ref MsvTraceScope.
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Module Library.
+
+MarsTech Dependency Injection is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef MARSTECH_TRACERECORDER_H
+#define MARSTECH_TRACERECORDER_H
+
+
+#include "merror/MsvError.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+MSV_ENABLE_WARNINGS
+
+
+/**************************************************************************************************//**
+* @brief		Trace event.
+* @details	One begin ('B') or end ('E') event of trace.
+******************************************************************************************************/
+struct MsvTraceEvent
+{
+	std::string name;										///< Event name.
+	const char* category;								///< Event category (static string).
+	char phase;												///< Event phase ('B' = begin, 'E' = end).
+	std::chrono::nanoseconds timestamp;				///< Time since trace recorder has been created.
+	uint32_t threadId;									///< Sequential ID of thread which recorded event.
+	MsvErrorCode errorCode;								///< Result of traced operation (end events only).
+};
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Trace Recorder.
+* @details	Records begin and end events (with thread IDs) and exports them in Chrome trace-event JSON format
+*				(viewable in chrome://tracing or Perfetto). Events with the same thread ID nest.
+******************************************************************************************************/
+class MsvTraceRecorder
+{
+public:
+	/**************************************************************************************************//**
+	* @brief			Constructor.
+	* @param[in]	reservedEvents		Number of events to reserve memory for (no allocations until it is reached).
+	******************************************************************************************************/
+	MsvTraceRecorder(size_t reservedEvents = 1024);
+
+	/**************************************************************************************************//**
+	* @brief		Virtual destructor.
+	******************************************************************************************************/
+	virtual ~MsvTraceRecorder();
+
+	/**************************************************************************************************//**
+	* @brief			Begin event.
+	* @details		Records begin event in current thread.
+	* @param[in]	name					Event name.
+	* @param[in]	category				Event category (it must be static string).
+	******************************************************************************************************/
+	virtual void Begin(const std::string& name, const char* category);
+
+	/**************************************************************************************************//**
+	* @brief			End event.
+	* @details		Records end event in current thread (it ends last begun event of the thread).
+	* @param[in]	name					Event name.
+	* @param[in]	category				Event category (it must be static string).
+	* @param[in]	errorCode			Result of traced operation.
+	******************************************************************************************************/
+	virtual void End(const std::string& name, const char* category, MsvErrorCode errorCode);
+
+	/**************************************************************************************************//**
+	* @brief			Get events.
+	* @details		Returns copy of all recorded events.
+	* @param[out]	events				Recorded events.
+	******************************************************************************************************/
+	virtual void GetEvents(std::vector<MsvTraceEvent>& events) const;
+
+	/**************************************************************************************************//**
+	* @brief			Clear events.
+	* @details		Removes all recorded events.
+	******************************************************************************************************/
+	virtual void Clear();
+
+	/**************************************************************************************************//**
+	* @brief			Export events.
+	* @details		Exports all recorded events to string in Chrome trace-event JSON format.
+	* @param[out]	json					Exported events.
+	******************************************************************************************************/
+	virtual void Export(std::string& json) const;
+
+	/**************************************************************************************************//**
+	* @brief			Export events.
+	* @details		Exports all recorded events to file in Chrome trace-event JSON format.
+	* @param[in]	path								Path of JSON file.
+	* @retval		MSV_NOT_FOUND_ERROR			When file can not be written.
+	* @retval		MSV_SUCCESS						On success.
+	******************************************************************************************************/
+	virtual MsvErrorCode Export(const char* path) const;
+
+protected:
+	/**************************************************************************************************//**
+	* @brief			Record event.
+	* @details		Records event in current thread.
+	* @param[in]	name					Event name.
+	* @param[in]	category				Event category.
+	* @param[in]	phase					Event phase.
+	* @param[in]	errorCode			Result of traced operation.
+	******************************************************************************************************/
+	virtual void Record(const std::string& name, const char* category, char phase, MsvErrorCode errorCode);
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Trace recorder mutex.
+	* @details	Locks this object for thread safety access.
+	******************************************************************************************************/
+	mutable std::recursive_mutex m_lock;
+
+	/**************************************************************************************************//**
+	* @brief		Trace start.
+	* @details	Time when trace recorder has been created (timestamps are relative to it).
+	******************************************************************************************************/
+	std::chrono::steady_clock::time_point m_traceStart;
+
+	/**************************************************************************************************//**
+	* @brief		Events.
+	* @details	Recorded events in recording order.
+	******************************************************************************************************/
+	std::vector<MsvTraceEvent> m_events;
+
+	/**************************************************************************************************//**
+	* @brief		Thread IDs.
+	* @details	Sequential IDs of threads which recorded any event (short IDs are more readable in viewer).
+	******************************************************************************************************/
+	std::unordered_map<std::thread::id, uint32_t> m_threadIds;
+};
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Trace Scope.
+* @details	Records begin event in constructor and end event in destructor (nothing when recorder is empty).
+******************************************************************************************************/
+class MsvTraceScope
+{
+public:
+	/**************************************************************************************************//**
+	* @brief			Constructor.
+	* @param[in]	spTraceRecorder	Shared pointer to trace recorder (empty = no tracing).
+	* @param[in]	name					Event name.
+	* @param[in]	category				Event category (it must be static string).
+	******************************************************************************************************/
+	MsvTraceScope(const std::shared_ptr<MsvTraceRecorder>& spTraceRecorder, const char* name, const char* category);
+
+	/**************************************************************************************************//**
+	* @brief			Constructor.
+	* @details		Event name is prefix followed by ID (it is built only when trace recorder is set).
+	* @param[in]	spTraceRecorder	Shared pointer to trace recorder (empty = no tracing).
+	* @param[in]	namePrefix			Event name prefix.
+	* @param[in]	nameId				ID appended to event name prefix.
+	* @param[in]	category				Event category (it must be static string).
+	******************************************************************************************************/
+	MsvTraceScope(const std::shared_ptr<MsvTraceRecorder>& spTraceRecorder, const char* namePrefix, const std::string& nameId, const char* category);
+
+	/**************************************************************************************************//**
+	* @brief		Destructor.
+	* @details	Records end event.
+	******************************************************************************************************/
+	~MsvTraceScope();
+
+	/**************************************************************************************************//**
+	* @brief			Set error code.
+	* @details		Sets result of traced operation (it is written to end event).
+	* @param[in]	errorCode			Result of traced operation.
+	******************************************************************************************************/
+	void SetErrorCode(MsvErrorCode errorCode);
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Trace recorder.
+	* @details	Shared pointer to trace recorder (empty = no tracing).
+	******************************************************************************************************/
+	std::shared_ptr<MsvTraceRecorder> m_spTraceRecorder;
+
+	/**************************************************************************************************//**
+	* @brief		Event name (empty when trace recorder is empty).
+	******************************************************************************************************/
+	std::string m_name;
+
+	/**************************************************************************************************//**
+	* @brief		Event category.
+	******************************************************************************************************/
+	const char* m_category;
+
+	/**************************************************************************************************//**
+	* @brief		Error code.
+	* @details	Result of traced operation.
+	******************************************************************************************************/
+	MsvErrorCode m_errorCode;
+};
+
+
+#endif // !MARSTECH_TRACERECORDER_H
+
+/** @} */	//End of group MMODULE.
@@ -0,0 +1,268 @@
+/**************************************************************************************************//**
+* @addtogroup	MMODULE
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Waitable State
+* @details		Contains definition of @ref MsvWaitableState (atomic state threads can wait for without polling).
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Module Library.
+
+MarsTech Dependency Injection is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef MARSTECH_WAITABLESTATE_H
+#define MARSTECH_WAITABLESTATE_H
+
+
+#include "merror/MsvError.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+
+#if defined(_WIN32)
+//header is included by module bases -> do not define min and max macros for modules
+#if !defined(NOMINMAX)
+#define NOMINMAX
+#define MSV_WAITABLE_STATE_NOMINMAX
+#endif
+#include <windows.h>
+#if defined(MSV_WAITABLE_STATE_NOMINMAX)
+#undef NOMINMAX
+#undef MSV_WAITABLE_STATE_NOMINMAX
+#endif
+#pragma comment(lib, "Synchronization.lib")
+#elif defined(__linux__)
+#include <ctime>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#else
+#include <thread>
+#endif
+
+MSV_ENABLE_WARNINGS
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Waitable State.
+* @details	Atomic state threads can wait for. Waiters sleep in operating system on address of state (futex on Linux,
+*				WaitOnAddress on Windows) and they are woken exactly when state changes - idle waiters cost nothing.
+*				Store wakes waiters only when there is any (it is one atomic store and load otherwise).
+* @note		This iplementation is in header file only -> it should be possible to include this header
+*				file to your project without linking this library (it is used by module bases).
+******************************************************************************************************/
+class MsvWaitableState
+{
+public:
+	/**************************************************************************************************//**
+	* @brief			Constructor.
+	* @param[in]	state					Initial state.
+	******************************************************************************************************/
+	MsvWaitableState(int32_t state = 0):
+		m_state(state),
+		m_waiterCount(0)
+	{
+		//waiters sleep on address of atomic -> it must be plain 32-bit integer
+		static_assert(sizeof(std::atomic<int32_t>) == sizeof(int32_t), "std::atomic<int32_t> must have size of int32_t.");
+	}
+
+	/**************************************************************************************************//**
+	* @brief		Virtual destructor.
+	******************************************************************************************************/
+	virtual ~MsvWaitableState() {}
+
+	MsvWaitableState(const MsvWaitableState&) = delete;
+	MsvWaitableState& operator=(const MsvWaitableState&) = delete;
+
+	/**************************************************************************************************//**
+	* @brief		Load state.
+	* @returns	int32_t
+	******************************************************************************************************/
+	int32_t Load() const
+	{
+		return m_state.load(std::memory_order_acquire);
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Store state.
+	* @details		Stores state and wakes all waiters (when there is any).
+	* @param[in]	state					New state.
+	******************************************************************************************************/
+	void Store(int32_t state)
+	{
+		//pairs with waiter count increment (waiter is counted or it sees new state before it sleeps)
+		m_state.store(state, std::memory_order_seq_cst);
+		if (m_waiterCount.load(std::memory_order_seq_cst) != 0)
+		{
+			WakeAll();
+		}
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Compare and exchange state.
+	* @details		Stores desired state when state is equal to expected state and wakes all waiters (when there is any).
+	* @param[in]	expected				Expected state.
+	* @param[in]	desired				New state.
+	* @retval		true					When state has been stored.
+	* @retval		false					When state is not equal to expected state.
+	******************************************************************************************************/
+	bool CompareExchange(int32_t expected, int32_t desired)
+	{
+		if (!m_state.compare_exchange_strong(expected, desired, std::memory_order_seq_cst))
+		{
+			return false;
+		}
+
+		if (m_waiterCount.load(std::memory_order_seq_cst) != 0)
+		{
+			WakeAll();
+		}
+
+		return true;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Wait for state.
+	* @details		Blocks until state is equal to requested state or timeout expires.
+	* @param[in]	state					Requested state.
+	* @param[in]	timeout				Timeout (milliseconds::max() waits without timeout).
+	* @retval		true					When state is equal to requested state.
+	* @retval		false					When timeout expired.
+	******************************************************************************************************/
+	bool WaitFor(int32_t state, std::chrono::milliseconds timeout) const
+	{
+		return WaitFor(state, -1, timeout);
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Wait for masked state.
+	* @details		Blocks until masked bits of state are equal to requested state or timeout expires.
+	* @param[in]	state					Requested state (masked bits).
+	* @param[in]	mask					Mask of compared bits.
+	* @param[in]	timeout				Timeout (timeout which does not fit to steady clock, e.g. milliseconds::max(),
+	*											waits without timeout).
+	* @retval		true					When masked state is equal to requested state.
+	* @retval		false					When timeout expired.
+	******************************************************************************************************/
+	bool WaitFor(int32_t state, int32_t mask, std::chrono::milliseconds timeout) const
+	{
+		std::chrono::steady_clock::time_point deadline = GetDeadline(timeout);
+
+		for (;;)
+		{
+			int32_t current = m_state.load(std::memory_order_acquire);
+			if ((current & mask) == state)
+			{
+				return true;
+			}
+
+			std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+			if (now >= deadline)
+			{
+				return false;
+			}
+
+			m_waiterCount.fetch_add(1, std::memory_order_seq_cst);
+			WaitForChange(current, deadline - now);
+			m_waiterCount.fetch_sub(1, std::memory_order_relaxed);
+		}
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Get deadline.
+	* @details		Returns now + timeout. Timeout which does not fit to steady clock (e.g. milliseconds::max()) is
+	*					clamped to the farthest time point (now + timeout would overflow).
+	* @param[in]	timeout				Timeout.
+	* @returns		std::chrono::steady_clock::time_point
+	******************************************************************************************************/
+	static std::chrono::steady_clock::time_point GetDeadline(std::chrono::milliseconds timeout)
+	{
+		std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+		std::chrono::milliseconds maxTimeout = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::time_point::max() - now);
+
+		return timeout < maxTimeout ? now + timeout : std::chrono::steady_clock::time_point::max();
+	}
+
+protected:
+	/**************************************************************************************************//**
+	* @brief			Wait for change.
+	* @details		Blocks while state is equal to current state (it can wake up spuriously).
+	* @param[in]	current				Current state.
+	* @param[in]	timeout				Timeout.
+	******************************************************************************************************/
+	void WaitForChange(int32_t current, std::chrono::nanoseconds timeout) const
+	{
+		//state is not changed by waiting (operating system only compares it)
+		std::atomic<int32_t>* pState = const_cast<std::atomic<int32_t>*>(&m_state);
+
+#if defined(_WIN32)
+		long long milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(timeout).count() + 1;
+		WaitOnAddress(pState, &current, sizeof(current), milliseconds < INFINITE ? static_cast<DWORD>(milliseconds) : INFINITE - 1);
+#elif defined(__linux__)
+		struct timespec relativeTimeout;
+		relativeTimeout.tv_sec = static_cast<time_t>(timeout.count() / 1000000000);
+		relativeTimeout.tv_nsec = static_cast<long>(timeout.count() % 1000000000);
+		syscall(SYS_futex, reinterpret_cast<int32_t*>(pState), FUTEX_WAIT_PRIVATE, current, &relativeTimeout, nullptr, 0);
+#else
+		//no address wait -> short sleep
+		(void)pState;
+		(void)current;
+		std::this_thread::sleep_for(timeout < std::chrono::milliseconds(1) ? timeout : std::chrono::nanoseconds(std::chrono::milliseconds(1)));
+#endif
+	}
+
+	/**************************************************************************************************//**
+	* @brief		Wake all waiters.
+	******************************************************************************************************/
+	void WakeAll()
+	{
+#if defined(_WIN32)
+		WakeByAddressAll(&m_state);
+#elif defined(__linux__)
+		syscall(SYS_futex, reinterpret_cast<int32_t*>(&m_state), FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+#endif
+	}
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		State.
+	* @details	Waiters sleep on its address.
+	******************************************************************************************************/
+	std::atomic<int32_t> m_state;
+
+	/**************************************************************************************************//**
+	* @brief		Waiter count.
+	* @details	Number of threads which sleep (or are going to sleep) on state.
+	******************************************************************************************************/
+	mutable std::atomic<int32_t> m_waiterCount;
+};
+
+
+#endif // !MARSTECH_WAITABLESTATE_H
+
+/** @} */	//End of group MMODULE.
@@ -0,0 +1,526 @@
+/**************************************************************************************************//**
+* @addtogroup	MMODULE
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Watchdog
+* @details		Contains implementation of @ref MsvWatchdog.
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Module Library.
+
+MarsTech Dependency Injection is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "MsvWatchdog.h"
+
+#include "merror/MsvErrorCodes.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <algorithm>
+#include <system_error>
+
+#if defined(__linux__)
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <execinfo.h>
+#include <signal.h>
+#endif
+
+MSV_ENABLE_WARNINGS
+
+
+#if defined(__linux__)
+namespace
+{
+
+//maximal number of captured stack frames and how long capture waits for stalled thread
+const int MSV_WATCHDOG_STACK_DEPTH = 64;
+const std::chrono::milliseconds MSV_WATCHDOG_STACK_TIMEOUT(100);
+
+//stack frames captured by signal handler (shared by all watchdogs - captures are serialized by stack lock)
+void* g_stackFrames[MSV_WATCHDOG_STACK_DEPTH];
+std::atomic<int> g_stackFrameCount(0);
+std::mutex g_stackLock;
+
+//sequence number of current capture and of the last captured stack (late signal of timed out capture is ignored)
+std::atomic<unsigned int> g_stackRequest(0);
+std::atomic<unsigned int> g_stackCaptured(0);
+
+//signal handler state (0 = not installed, 1 = installed, 2 = signal is used by other handler)
+int g_stackHandlerState = 0;
+
+//real-time signal which is sent to stalled thread
+int GetStackSignal()
+{
+	return SIGRTMIN + 4;
+}
+
+//captures stack of thread which received signal (backtrace has been loaded before - it does not allocate here)
+void StackSignalHandler(int, siginfo_t* pInfo, void*)
+{
+	unsigned int request = static_cast<unsigned int>(pInfo->si_value.sival_int);
+	if (request != g_stackRequest.load(std::memory_order_acquire))
+	{
+		return;
+	}
+
+	g_stackFrameCount.store(backtrace(g_stackFrames, MSV_WATCHDOG_STACK_DEPTH), std::memory_order_relaxed);
+	g_stackCaptured.store(request, std::memory_order_release);
+}
+
+}
+#endif
+
+
+/********************************************************************************************************************************
+*															Constructors and destructors
+********************************************************************************************************************************/
+
+
+MsvWatchdog::MsvWatchdog(MsvRestartFunction restart, std::shared_ptr<MsvLogger> spLogger):
+	m_restart(restart),
+	m_spLogger(spLogger),
+	m_defaultOptions(MSV_WATCHDOG_DEFAULT_OPTIONS),
+	m_transitionGeneration(0),
+	m_spObservers(std::make_shared<const std::vector<std::shared_ptr<IMsvWatchdogObserver>>>()),
+	m_checkInterval(MSV_WATCHDOG_DEFAULT_CHECK_INTERVAL),
+	m_stopping(false)
+{
+
+}
+
+MsvWatchdog::~MsvWatchdog()
+{
+	Stop();
+}
+
+
+/********************************************************************************************************************************
+*															MsvWatchdog public methods
+********************************************************************************************************************************/
+
+
+MsvErrorCode MsvWatchdog::Start(std::chrono::milliseconds checkInterval)
+{
+	if (checkInterval <= std::chrono::milliseconds::zero())
+	{
+		return MSV_INVALID_DATA_ERROR;
+	}
+
+	std::lock_guard<std::mutex> lock(m_lock);
+
+	if (m_thread.joinable())
+	{
+		return MSV_ALREADY_RUNNING_INFO;
+	}
+
+	m_checkInterval = checkInterval;
+
+	try
+	{
+		m_thread = std::thread(&MsvWatchdog::Run, this);
+	}
+	catch (const std::system_error&)
+	{
+		return MSV_ALLOCATION_ERROR;
+	}
+
+	return MSV_SUCCESS;
+}
+
+void MsvWatchdog::Stop()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+
+		if (!m_thread.joinable())
+		{
+			return;
+		}
+
+		m_stopping = true;
+		m_condition.notify_all();
+	}
+
+	m_thread.join();
+
+	//watchdog can be started again
+	std::lock_guard<std::mutex> lock(m_lock);
+	m_stopping = false;
+}
+
+bool MsvWatchdog::Running() const
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+
+	return m_thread.joinable();
+}
+
+MsvErrorCode MsvWatchdog::SetDefaultOptions(const MsvWatchdogOptions& options)
+{
+	if (options.transitionTimeout < std::chrono::milliseconds::zero() || options.heartbeatTimeout < std::chrono::milliseconds::zero() || options.restartTimeout < std::chrono::milliseconds::zero())
+	{
+		return MSV_INVALID_DATA_ERROR;
+	}
+
+	std::lock_guard<std::mutex> lock(m_lock);
+
+	m_defaultOptions = options;
+
+	return MSV_SUCCESS;
+}
+
+MsvErrorCode MsvWatchdog::SetModuleOptions(int32_t moduleId, const MsvWatchdogOptions& options)
+{
+	if (options.transitionTimeout < std::chrono::milliseconds::zero() || options.heartbeatTimeout < std::chrono::milliseconds::zero() || options.restartTimeout < std::chrono::milliseconds::zero())
+	{
+		return MSV_INVALID_DATA_ERROR;
+	}
+
+	std::lock_guard<std::mutex> lock(m_lock);
+
+	m_moduleOptions[moduleId] = options;
+
+	return MSV_SUCCESS;
+}
+
+MsvWatchdogOptions MsvWatchdog::GetModuleOptions(int32_t moduleId) const
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+
+	return GetOptions(moduleId);
+}
+
+MsvErrorCode MsvWatchdog::Subscribe(std::shared_ptr<IMsvWatchdogObserver> spObserver)
+{
+	if (!spObserver)
+	{
+		return MSV_INVALID_DATA_ERROR;
+	}
+
+	std::lock_guard<std::mutex> lock(m_lock);
+
+	if (std::find(m_spObservers->begin(), m_spObservers->end(), spObserver) != m_spObservers->end())
+	{
+		return MSV_ALREADY_EXISTS_ERROR;
+	}
+
+	std::shared_ptr<std::vector<std::shared_ptr<IMsvWatchdogObserver>>> spObservers = std::make_shared<std::vector<std::shared_ptr<IMsvWatchdogObserver>>>(*m_spObservers);
+	spObservers->push_back(spObserver);
+	m_spObservers = spObservers;
+
+	return MSV_SUCCESS;
+}
+
+MsvErrorCode MsvWatchdog::Unsubscribe(std::shared_ptr<IMsvWatchdogObserver> spObserver)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+
+	std::vector<std::shared_ptr<IMsvWatchdogObserver>>::const_iterator it = std::find(m_spObservers->begin(), m_spObservers->end(), spObserver);
+	if (it == m_spObservers->end())
+	{
+		return MSV_NOT_FOUND_ERROR;
+	}
+
+	std::shared_ptr<std::vector<std::shared_ptr<IMsvWatchdogObserver>>> spObservers = std::make_shared<std::vector<std::shared_ptr<IMsvWatchdogObserver>>>(*m_spObservers);
+	spObservers->erase(spObservers->begin() + (it - m_spObservers->begin()));
+	m_spObservers = spObservers;
+
+	return MSV_SUCCESS;
+}
+
+void MsvWatchdog::BeginTransition(int32_t moduleId, MsvModuleTransition transition)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+
+	MsvWatchedTransition& watchedTransition = m_transitions[moduleId];
+	watchedTransition.transition = transition;
+	watchedTransition.begin = std::chrono::steady_clock::now();
+	watchedTransition.reported = false;
+	watchedTransition.generation = ++m_transitionGeneration;
+#if defined(__linux__)
+	watchedTransition.thread = pthread_self();
+#endif
+}
+
+void MsvWatchdog::EndTransition(int32_t moduleId)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+
+	m_transitions.erase(moduleId);
+}
+
+void MsvWatchdog::Watch(int32_t moduleId, std::shared_ptr<IMsvModuleHeartbeat> spHeartbeat)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+
+	MsvWatchedModule& watchedModule = m_modules[moduleId];
+	watchedModule.spHeartbeat = spHeartbeat;
+	watchedModule.heartbeat = spHeartbeat->GetHeartbeat();
+	watchedModule.changed = std::chrono::steady_clock::now();
+	watchedModule.reported = false;
+}
+
+void MsvWatchdog::Unwatch(int32_t moduleId)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+
+	m_modules.erase(moduleId);
+}
+
+
+/********************************************************************************************************************************
+*															MsvWatchdog protected methods
+********************************************************************************************************************************/
+
+
+void MsvWatchdog::Run()
+{
+	std::unique_lock<std::mutex> lock(m_lock);
+
+	while (!m_stopping)
+	{
+		m_condition.wait_for(lock, m_checkInterval);
+		if (m_stopping)
+		{
+			break;
+		}
+
+		std::vector<MsvWatchdogStall> stalls;
+		Check(stalls);
+		if (stalls.empty())
+		{
+			continue;
+		}
+
+		//actions run out of lock (observers and restart can call watchdog)
+		std::shared_ptr<const std::vector<std::shared_ptr<IMsvWatchdogObserver>>> spObservers = m_spObservers;
+		lock.unlock();
+
+		for (std::vector<MsvWatchdogStall>::iterator it = stalls.begin(); it != stalls.end(); ++it)
+		{
+			HandleStall(*it, *spObservers);
+		}
+
+		lock.lock();
+	}
+}
+
+void MsvWatchdog::Check(std::vector<MsvWatchdogStall>& stalls)
+{
+	std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+
+	for (std::unordered_map<int32_t, MsvWatchedTransition>::iterator it = m_transitions.begin(); it != m_transitions.end(); ++it)
+	{
+		const MsvWatchdogOptions& options = GetOptions(it->first);
+		if (it->second.reported || options.transitionTimeout == std::chrono::milliseconds::zero() || now - it->second.begin < options.transitionTimeout)
+		{
+			continue;
+		}
+
+		//stall is reported once per transition
+		it->second.reported = true;
+
+		MsvWatchdogStall stall;
+		stall.stall.moduleId = it->first;
+		stall.stall.type = MsvModuleStallType::MSV_MODULE_STALL_TRANSITION;
+		stall.stall.transition = it->second.transition;
+		stall.stall.duration = std::chrono::duration_cast<std::chrono::milliseconds>(now - it->second.begin);
+		stall.actions = options.actions;
+		stall.generation = it->second.generation;
+		stalls.push_back(stall);
+	}
+
+	for (std::unordered_map<int32_t, MsvWatchedModule>::iterator it = m_modules.begin(); it != m_modules.end(); ++it)
+	{
+		//heartbeat is lock free (it can be read even when module is deadlocked)
+		uint64_t heartbeat = it->second.spHeartbeat->GetHeartbeat();
+		if (heartbeat != it->second.heartbeat)
+		{
+			it->second.heartbeat = heartbeat;
+			it->second.changed = now;
+			it->second.reported = false;
+			continue;
+		}
+
+		const MsvWatchdogOptions& options = GetOptions(it->first);
+		if (it->second.reported || options.heartbeatTimeout == std::chrono::milliseconds::zero() || now - it->second.changed < options.heartbeatTimeout)
+		{
+			continue;
+		}
+
+		//stall is reported once until heartbeat changes
+		it->second.reported = true;
+
+		MsvWatchdogStall stall;
+		stall.stall.moduleId = it->first;
+		stall.stall.type = MsvModuleStallType::MSV_MODULE_STALL_HEARTBEAT;
+		stall.stall.transition = MsvModuleTransition::MSV_MODULE_TRANSITION_COUNT;
+		stall.stall.duration = std::chrono::duration_cast<std::chrono::milliseconds>(now - it->second.changed);
+		stall.actions = options.actions;
+		stall.generation = 0;
+		stalls.push_back(stall);
+	}
+}
+
+void MsvWatchdog::HandleStall(MsvWatchdogStall& stall, const std::vector<std::shared_ptr<IMsvWatchdogObserver>>& observers)
+{
+	static const char* const transitionNames[] = { "initialize", "start", "stop", "uninitialize" };
+
+	bool transitionStall = stall.stall.type == MsvModuleStallType::MSV_MODULE_STALL_TRANSITION;
+	if (transitionStall && (stall.actions & MSV_WATCHDOG_ACTION_STACK_SNAPSHOT))
+	{
+		CaptureStack(stall);
+	}
+
+	if (stall.actions & MSV_WATCHDOG_ACTION_LOG)
+	{
+		if (transitionStall)
+		{
+			MSV_LOG_ERROR(m_spLogger, "Module {} has been in {} transition for {} ms.", stall.stall.moduleId, transitionNames[static_cast<size_t>(stall.stall.transition)], stall.stall.duration.count());
+		}
+		else
+		{
+			MSV_LOG_ERROR(m_spLogger, "Module {} has not reported heartbeat for {} ms.", stall.stall.moduleId, stall.stall.duration.count());
+		}
+
+		for (std::vector<std::string>::const_iterator it = stall.stall.stack.begin(); it != stall.stall.stack.end(); ++it)
+		{
+			MSV_LOG_ERROR(m_spLogger, "    {}", *it);
+		}
+	}
+
+	if (stall.actions & MSV_WATCHDOG_ACTION_EVENT)
+	{
+		for (std::vector<std::shared_ptr<IMsvWatchdogObserver>>::const_iterator it = observers.begin(); it != observers.end(); ++it)
+		{
+			(*it)->OnModuleStalled(stall.stall);
+		}
+	}
+
+	//hung transition can not be restarted (it holds module manager) - only stalled running module is
+	if (!transitionStall && (stall.actions & MSV_WATCHDOG_ACTION_RESTART) && m_restart)
+	{
+		MSV_LOG_INFO(m_spLogger, "Requesting restart of stalled module {}.", stall.stall.moduleId);
+		m_restart(stall.stall.moduleId);
+	}
+}
+
+const MsvWatchdogOptions& MsvWatchdog::GetOptions(int32_t moduleId) const
+{
+	std::unordered_map<int32_t, MsvWatchdogOptions>::const_iterator it = m_moduleOptions.find(moduleId);
+
+	return it != m_moduleOptions.end() ? it->second : m_defaultOptions;
+}
+
+void MsvWatchdog::CaptureStack(MsvWatchdogStall& stall)
+{
+#if defined(__linux__)
+	std::lock_guard<std::mutex> stackLock(g_stackLock);
+
+	if (g_stackHandlerState == 0)
+	{
+		//signal must not be used by application (its handler is not replaced)
+		struct sigaction oldAction;
+		if (sigaction(GetStackSignal(), nullptr, &oldAction) != 0 || oldAction.sa_handler != SIG_DFL)
+		{
+			MSV_LOG_ERROR(m_spLogger, "Signal {} is used by other handler - stacks of stalled transitions are not captured.", GetStackSignal());
+			g_stackHandlerState = 2;
+			return;
+		}
+
+		//load backtrace before the first signal (the first call can allocate)
+		void* pFrame = nullptr;
+		backtrace(&pFrame, 1);
+
+		struct sigaction action;
+		memset(&action, 0, sizeof(action));
+		action.sa_sigaction = StackSignalHandler;
+		sigemptyset(&action.sa_mask);
+		action.sa_flags = SA_RESTART | SA_SIGINFO;
+		if (sigaction(GetStackSignal(), &action, nullptr) != 0)
+		{
+			return;
+		}
+
+		g_stackHandlerState = 1;
+	}
+
+	if (g_stackHandlerState != 1)
+	{
+		return;
+	}
+
+	unsigned int request = g_stackRequest.fetch_add(1) + 1;
+
+	{
+		//thread is signalled only while it runs the stalled transition (thread which finished it can exit)
+		std::lock_guard<std::mutex> lock(m_lock);
+
+		std::unordered_map<int32_t, MsvWatchedTransition>::const_iterator it = m_transitions.find(stall.stall.moduleId);
+		if (it == m_transitions.end() || it->second.generation != stall.generation)
+		{
+			return;
+		}
+
+		sigval value;
+		value.sival_int = static_cast<int>(request);
+		if (pthread_sigqueue(it->second.thread, GetStackSignal(), value) != 0)
+		{
+			return;
+		}
+	}
+
+	std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + MSV_WATCHDOG_STACK_TIMEOUT;
+	while (g_stackCaptured.load(std::memory_order_acquire) != request)
+	{
+		if (std::chrono::steady_clock::now() >= deadline)
+		{
+			return;
+		}
+
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+
+	int frameCount = g_stackFrameCount.load(std::memory_order_relaxed);
+	char** pSymbols = backtrace_symbols(g_stackFrames, frameCount);
+	if (!pSymbols)
+	{
+		return;
+	}
+
+	for (int frame = 0; frame < frameCount; ++frame)
+	{
+		stall.stall.stack.push_back(pSymbols[frame]);
+	}
+
+	free(pSymbols);
+#else
+	(void)stall;
+#endif
+}
+
+
+/** @} */	//End of group MMODULE.
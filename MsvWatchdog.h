@@ -0,0 +1,400 @@
+/**************************************************************************************************//**
+* @addtogroup	MMODULE
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Watchdog
+* @details		Contains definition of @ref MsvWatchdog (detects hung module transitions and stalled running modules).
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Module Library.
+
+MarsTech Dependency Injection is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef MARSTECH_WATCHDOG_H
+#define MARSTECH_WATCHDOG_H
+
+
+#include "IMsvModuleHeartbeat.h"
+#include "IMsvWatchdogObserver.h"
+
+#include "mlogging/mlogging.h"
+#include "merror/MsvError.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#endif
+
+MSV_ENABLE_WARNINGS
+
+
+/**************************************************************************************************//**
+* @brief		Watchdog action - log stall.
+******************************************************************************************************/
+static const uint32_t MSV_WATCHDOG_ACTION_LOG = 0x1;
+
+/**************************************************************************************************//**
+* @brief		Watchdog action - notify watchdog observers (@ref IMsvWatchdogObserver).
+******************************************************************************************************/
+static const uint32_t MSV_WATCHDOG_ACTION_EVENT = 0x2;
+
+/**************************************************************************************************//**
+* @brief		Watchdog action - restart module which stopped reporting heartbeat.
+******************************************************************************************************/
+static const uint32_t MSV_WATCHDOG_ACTION_RESTART = 0x4;
+
+/**************************************************************************************************//**
+* @brief		Watchdog action - capture stack of thread which runs stalled transition (Linux only).
+******************************************************************************************************/
+static const uint32_t MSV_WATCHDOG_ACTION_STACK_SNAPSHOT = 0x8;
+
+/**************************************************************************************************//**
+* @brief		Default watchdog check interval.
+******************************************************************************************************/
+static const std::chrono::milliseconds MSV_WATCHDOG_DEFAULT_CHECK_INTERVAL(1000);
+
+
+/**************************************************************************************************//**
+* @brief		Watchdog options.
+* @details	Supervision of module. Zero timeout disables its check.
+******************************************************************************************************/
+struct MsvWatchdogOptions
+{
+	std::chrono::milliseconds transitionTimeout;	///< Maximal duration of module transition.
+	std::chrono::milliseconds heartbeatTimeout;	///< Maximal time without heartbeat of running module.
+	std::chrono::milliseconds restartTimeout;		///< Maximal duration of stop of restarted module (module which does not
+																///< stop in time is not restarted).
+	uint32_t actions;										///< Actions on stall (MSV_WATCHDOG_ACTION_* flags).
+};
+
+/**************************************************************************************************//**
+* @brief		Default watchdog options.
+* @details	Transition which takes longer than a minute is logged and reported to observers. Heartbeats are not
+*				checked (module must be configured to report them). Restarted module must stop in 10 seconds.
+******************************************************************************************************/
+static const MsvWatchdogOptions MSV_WATCHDOG_DEFAULT_OPTIONS =
+{
+	std::chrono::milliseconds(60000),
+	std::chrono::milliseconds(0),
+	std::chrono::milliseconds(10000),
+	MSV_WATCHDOG_ACTION_LOG | MSV_WATCHDOG_ACTION_EVENT
+};
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Watchdog.
+* @details	Watchdog thread periodically checks module transitions which are running (hung transition) and heartbeats
+*				of running modules (stalled module) and reports every stall once. Watchdog never locks module manager -
+*				it detects modules which hold its lock forever too. Restart of stalled module is delegated to restart
+*				function.
+******************************************************************************************************/
+class MsvWatchdog
+{
+public:
+	/**************************************************************************************************//**
+	* @brief			Restart function.
+	* @details		Requests restart of stalled module (called on watchdog thread - it must not block).
+	******************************************************************************************************/
+	typedef std::function<void(int32_t moduleId)> MsvRestartFunction;
+
+	/**************************************************************************************************//**
+	* @brief			Constructor.
+	* @param[in]	restart				Restart function.
+	* @param[in]	spLogger				Shared pointer to logger for logging.
+	******************************************************************************************************/
+	MsvWatchdog(MsvRestartFunction restart, std::shared_ptr<MsvLogger> spLogger);
+
+	/**************************************************************************************************//**
+	* @brief		Virtual destructor.
+	* @details	Stops watchdog thread.
+	******************************************************************************************************/
+	virtual ~MsvWatchdog();
+
+	MsvWatchdog(const MsvWatchdog&) = delete;
+	MsvWatchdog& operator=(const MsvWatchdog&) = delete;
+
+	/**************************************************************************************************//**
+	* @brief			Start watchdog.
+	* @details		Starts watchdog thread which checks modules every check interval.
+	* @param[in]	checkInterval						Check interval (it limits precision of timeouts).
+	* @retval		MSV_INVALID_DATA_ERROR			When check interval is not positive.
+	* @retval		MSV_ALREADY_RUNNING_INFO		When watchdog is already running.
+	* @retval		MSV_ALLOCATION_ERROR				When watchdog thread can not be created.
+	* @retval		MSV_SUCCESS							On success.
+	******************************************************************************************************/
+	virtual MsvErrorCode Start(std::chrono::milliseconds checkInterval = MSV_WATCHDOG_DEFAULT_CHECK_INTERVAL);
+
+	/**************************************************************************************************//**
+	* @brief		Stop watchdog.
+	* @details	Waits until watchdog thread exits. It must not be called from watchdog observer or restart function.
+	******************************************************************************************************/
+	virtual void Stop();
+
+	/**************************************************************************************************//**
+	* @brief		Get running flag.
+	* @retval	true		When watchdog thread is running.
+	* @retval	false		When watchdog is stopped.
+	******************************************************************************************************/
+	virtual bool Running() const;
+
+	/**************************************************************************************************//**
+	* @brief			Set default options.
+	* @details		Options of modules which have no own options.
+	* @param[in]	options								Watchdog options.
+	* @retval		MSV_INVALID_DATA_ERROR			When timeout is negative.
+	* @retval		MSV_SUCCESS							On success.
+	******************************************************************************************************/
+	virtual MsvErrorCode SetDefaultOptions(const MsvWatchdogOptions& options);
+
+	/**************************************************************************************************//**
+	* @brief			Set module options.
+	* @details		Options of module (they override default options).
+	* @param[in]	moduleId								Module ID.
+	* @param[in]	options								Watchdog options.
+	* @retval		MSV_INVALID_DATA_ERROR			When timeout is negative.
+	* @retval		MSV_SUCCESS							On success.
+	******************************************************************************************************/
+	virtual MsvErrorCode SetModuleOptions(int32_t moduleId, const MsvWatchdogOptions& options);
+
+	/**************************************************************************************************//**
+	* @brief			Get module options.
+	* @details		Returns options of module (or default options when module has no own options).
+	* @param[in]	moduleId								Module ID.
+	* @returns		MsvWatchdogOptions
+	******************************************************************************************************/
+	virtual MsvWatchdogOptions GetModuleOptions(int32_t moduleId) const;
+
+	/**************************************************************************************************//**
+	* @brief			Subscribe observer.
+	* @param[in]	spObserver							Shared pointer to watchdog observer.
+	* @retval		MSV_INVALID_DATA_ERROR			When observer is null.
+	* @retval		MSV_ALREADY_EXISTS_ERROR		When observer is already subscribed.
+	* @retval		MSV_SUCCESS							On success.
+	******************************************************************************************************/
+	virtual MsvErrorCode Subscribe(std::shared_ptr<IMsvWatchdogObserver> spObserver);
+
+	/**************************************************************************************************//**
+	* @brief			Unsubscribe observer.
+	* @details		Observer is not notified since the next check (stall which is being reported can still reach it).
+	* @param[in]	spObserver							Shared pointer to watchdog observer.
+	* @retval		MSV_NOT_FOUND_ERROR				When observer is not subscribed.
+	* @retval		MSV_SUCCESS							On success.
+	******************************************************************************************************/
+	virtual MsvErrorCode Unsubscribe(std::shared_ptr<IMsvWatchdogObserver> spObserver);
+
+	/**************************************************************************************************//**
+	* @brief			Begin transition.
+	* @details		Records start of module transition. It must be called on thread which runs transition (its stack
+	*					is captured when transition stalls).
+	* @param[in]	moduleId								Module ID.
+	* @param[in]	transition							Module transition.
+	******************************************************************************************************/
+	virtual void BeginTransition(int32_t moduleId, MsvModuleTransition transition);
+
+	/**************************************************************************************************//**
+	* @brief			End transition.
+	* @param[in]	moduleId								Module ID.
+	******************************************************************************************************/
+	virtual void EndTransition(int32_t moduleId);
+
+	/**************************************************************************************************//**
+	* @brief			Watch module.
+	* @details		Starts checking heartbeat of running module (when it has heartbeat timeout).
+	* @param[in]	moduleId								Module ID.
+	* @param[in]	spHeartbeat							Shared pointer to module heartbeat.
+	******************************************************************************************************/
+	virtual void Watch(int32_t moduleId, std::shared_ptr<IMsvModuleHeartbeat> spHeartbeat);
+
+	/**************************************************************************************************//**
+	* @brief			Unwatch module.
+	* @details		Stops checking heartbeat of module.
+	* @param[in]	moduleId								Module ID.
+	******************************************************************************************************/
+	virtual void Unwatch(int32_t moduleId);
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Running transition.
+	******************************************************************************************************/
+	struct MsvWatchedTransition
+	{
+		MsvModuleTransition transition;								///< Module transition.
+		std::chrono::steady_clock::time_point begin;				///< Start of transition.
+		bool reported;														///< Flag if stall has been reported.
+		uint64_t generation;												///< Generation (the same module can run other transition later).
+#if defined(__linux__)
+		pthread_t thread;													///< Thread which runs transition.
+#endif
+	};
+
+	/**************************************************************************************************//**
+	* @brief		Watched module.
+	******************************************************************************************************/
+	struct MsvWatchedModule
+	{
+		std::shared_ptr<IMsvModuleHeartbeat> spHeartbeat;		///< Module heartbeat.
+		uint64_t heartbeat;												///< The last seen heartbeat.
+		std::chrono::steady_clock::time_point changed;			///< Time when heartbeat has been seen changed.
+		bool reported;														///< Flag if stall has been reported.
+	};
+
+	/**************************************************************************************************//**
+	* @brief		Detected stall.
+	******************************************************************************************************/
+	struct MsvWatchdogStall
+	{
+		MsvModuleStall stall;											///< Module stall.
+		uint32_t actions;													///< Actions on stall.
+		uint64_t generation;												///< Generation of stalled transition.
+	};
+
+	/**************************************************************************************************//**
+	* @brief		Watchdog thread.
+	* @details	Checks modules every check interval until watchdog is stopped.
+	******************************************************************************************************/
+	void Run();
+
+	/**************************************************************************************************//**
+	* @brief			Check modules.
+	* @details		Collects new stalls. Watchdog must be locked.
+	* @param[out]	stalls								Detected stalls.
+	******************************************************************************************************/
+	void Check(std::vector<MsvWatchdogStall>& stalls);
+
+	/**************************************************************************************************//**
+	* @brief			Handle stall.
+	* @details		Runs actions of stall (watchdog must not be locked).
+	* @param[in]	stall									Detected stall.
+	* @param[in]	observers							Watchdog observers.
+	******************************************************************************************************/
+	void HandleStall(MsvWatchdogStall& stall, const std::vector<std::shared_ptr<IMsvWatchdogObserver>>& observers);
+
+	/**************************************************************************************************//**
+	* @brief			Get options.
+	* @details		Returns options of module (or default options). Watchdog must be locked.
+	* @param[in]	moduleId								Module ID.
+	* @returns		const MsvWatchdogOptions&
+	******************************************************************************************************/
+	const MsvWatchdogOptions& GetOptions(int32_t moduleId) const;
+
+	/**************************************************************************************************//**
+	* @brief			Capture stack.
+	* @details		Captures stack of thread which runs stalled transition (Linux only - it does nothing on other
+	*					platforms). Thread is signalled only while the stalled transition is still running. Stack is
+	*					not captured when stack signal is used by other handler.
+	* @param[in]	stall									Detected stall.
+	******************************************************************************************************/
+	void CaptureStack(MsvWatchdogStall& stall);
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Watchdog mutex.
+	* @details	Locks watched transitions, modules, options and watchdog thread (actions run out of lock).
+	******************************************************************************************************/
+	mutable std::mutex m_lock;
+
+	/**************************************************************************************************//**
+	* @brief		Watchdog condition variable.
+	* @details	Wakes watchdog thread.
+	******************************************************************************************************/
+	std::condition_variable m_condition;
+
+	/**************************************************************************************************//**
+	* @brief		Restart function.
+	******************************************************************************************************/
+	MsvRestartFunction m_restart;
+
+	/**************************************************************************************************//**
+	* @brief		Logger.
+	* @details	Shared pointer to logger for logging.
+	******************************************************************************************************/
+	std::shared_ptr<MsvLogger> m_spLogger;
+
+	/**************************************************************************************************//**
+	* @brief		Default options.
+	******************************************************************************************************/
+	MsvWatchdogOptions m_defaultOptions;
+
+	/**************************************************************************************************//**
+	* @brief		Module options.
+	* @details	Watchdog options by module ID.
+	******************************************************************************************************/
+	std::unordered_map<int32_t, MsvWatchdogOptions> m_moduleOptions;
+
+	/**************************************************************************************************//**
+	* @brief		Running transitions.
+	* @details	Running transitions by module ID.
+	******************************************************************************************************/
+	std::unordered_map<int32_t, MsvWatchedTransition> m_transitions;
+
+	/**************************************************************************************************//**
+	* @brief		Transition generation.
+	* @details	Generation of the last begun transition.
+	******************************************************************************************************/
+	uint64_t m_transitionGeneration;
+
+	/**************************************************************************************************//**
+	* @brief		Watched modules.
+	* @details	Running modules which report heartbeat by module ID.
+	******************************************************************************************************/
+	std::unordered_map<int32_t, MsvWatchedModule> m_modules;
+
+	/**************************************************************************************************//**
+	* @brief		Watchdog observers.
+	* @details	Immutable list - it is replaced on subscribe/unsubscribe (watchdog thread takes snapshot).
+	******************************************************************************************************/
+	std::shared_ptr<const std::vector<std::shared_ptr<IMsvWatchdogObserver>>> m_spObservers;
+
+	/**************************************************************************************************//**
+	* @brief		Check interval.
+	******************************************************************************************************/
+	std::chrono::milliseconds m_checkInterval;
+
+	/**************************************************************************************************//**
+	* @brief		Watchdog thread.
+	******************************************************************************************************/
+	std::thread m_thread;
+
+	/**************************************************************************************************//**
+	* @brief		Stopping flag.
+	* @details	Flag if watchdog thread should exit.
+	******************************************************************************************************/
+	bool m_stopping;
+};
+
+
+#endif // !MARSTECH_WATCHDOG_H
+
+/** @} */	//End of group MMODULE.
@@ -0,0 +1,377 @@
+//
+// main.cpp
+// Concurrent lifecycle stress harness of module manager. Threads hammer AddModule, Start, Stop and state queries
+// of one module manager with synthetic modules (injected latency and failures) and throughput, latency percentiles
+// and final state invariants are reported. Build it with -fsanitize=thread (Linux) to check for data races and with
+// -DMSV_LOCK_INSTRUMENTATION=1 to report wait and hold times of module manager and DLL module adapter locks.
+//
+
+#include "../Benchmark/MsvSyntheticModule.h"
+
+#include "mmodule/MsvModuleManager.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+MSV_ENABLE_WARNINGS
+
+
+/*-----------------------------------------------------------------------------------------------------
+**											Helpers
+**---------------------------------------------------------------------------------------------------*/
+
+
+//maximal number of latency samples of one operation kept by one thread
+#define MSV_STRESS_MAX_SAMPLES 100000
+
+//stress harness options (set by command line arguments)
+struct MsvStressOptions
+{
+	uint32_t threads = 8;					///< Number of threads (roles: lifecycle, query, add, query, ...).
+	uint32_t duration = 5;					///< Stress duration [s].
+	uint32_t modules = 100;					///< Number of modules added before stress.
+	uint32_t maxModules = 200;				///< Maximal number of modules (next adds are rejected duplicates).
+	uint32_t latency = 10;					///< Average latency of module transitions [us] (jitter from 0 to twice of it).
+	uint32_t failurePermille = 1;			///< Probability of initialize and start failure of module [permille].
+};
+
+//stressed operations
+enum class MsvStressOperation: int32_t
+{
+	MSV_STRESS_OPERATION_ADD_MODULE = 0,
+	MSV_STRESS_OPERATION_ADD_EXISTING,
+	MSV_STRESS_OPERATION_START,
+	MSV_STRESS_OPERATION_STOP,
+	MSV_STRESS_OPERATION_RUNNING,
+	MSV_STRESS_OPERATION_INITIALIZED,
+	MSV_STRESS_OPERATION_COUNT
+};
+
+static const char* const g_operationNames[] = { "AddModule", "AddExisting", "Start", "Stop", "Running", "Initialized" };
+
+//role of stress thread
+enum class MsvStressRole: int32_t
+{
+	MSV_STRESS_ROLE_LIFECYCLE = 0,		///< Starts and stops module manager.
+	MSV_STRESS_ROLE_QUERY,					///< Queries state of module manager.
+	MSV_STRESS_ROLE_ADD						///< Adds new modules to module manager.
+};
+
+static MsvStressRole GetRole(uint32_t threadIndex)
+{
+	static const MsvStressRole roles[] = { MsvStressRole::MSV_STRESS_ROLE_LIFECYCLE, MsvStressRole::MSV_STRESS_ROLE_QUERY, MsvStressRole::MSV_STRESS_ROLE_ADD, MsvStressRole::MSV_STRESS_ROLE_QUERY };
+	return roles[threadIndex % (sizeof(roles) / sizeof(roles[0]))];
+}
+
+//latency samples of one operation in one thread (reservoir sampling keeps memory bounded)
+class MsvStressSamples
+{
+public:
+	MsvStressSamples():
+		m_count(0),
+		m_failures(0),
+		m_generator(std::random_device{}())
+	{
+
+	}
+
+	void Add(std::chrono::nanoseconds duration, MsvErrorCode errorCode)
+	{
+		++m_count;
+		if (MSV_FAILED(errorCode))
+		{
+			++m_failures;
+		}
+
+		if (m_samples.size() < MSV_STRESS_MAX_SAMPLES)
+		{
+			m_samples.push_back(duration);
+			return;
+		}
+
+		uint64_t index = m_generator() % m_count;
+		if (index < MSV_STRESS_MAX_SAMPLES)
+		{
+			m_samples[static_cast<size_t>(index)] = duration;
+		}
+	}
+
+	uint64_t m_count;
+	uint64_t m_failures;
+	std::vector<std::chrono::nanoseconds> m_samples;
+	std::mt19937_64 m_generator;
+};
+
+//results of one stress thread
+struct MsvStressThreadResult
+{
+	std::array<MsvStressSamples, static_cast<size_t>(MsvStressOperation::MSV_STRESS_OPERATION_COUNT)> operations;
+	std::vector<std::shared_ptr<MsvSyntheticModule>> modules;
+};
+
+//shared state of stress threads
+class MsvStressHarness
+{
+public:
+	MsvStressHarness(const MsvStressOptions& options):
+		m_options(options),
+		m_spLoggerProvider(new MsvNullLoggerProvider()),
+		m_nextModuleId(0),
+		m_started(false),
+		m_stopped(false)
+	{
+		m_spModuleManager.reset(new MsvModuleManager(m_spLoggerProvider->GetLogger()));
+	}
+
+	MsvErrorCode AddModule(int32_t moduleId, std::vector<std::shared_ptr<MsvSyntheticModule>>& modules)
+	{
+		std::shared_ptr<MsvSyntheticModule> spModule(new MsvSyntheticModule(m_spLoggerProvider, MsvSyntheticLatency::MSV_SYNTHETIC_LATENCY_JITTER,
+			std::chrono::microseconds(m_options.latency), m_options.failurePermille));
+		MsvErrorCode errorCode = m_spModuleManager->AddModule(moduleId, spModule, std::make_shared<MsvSyntheticModuleConfigurator>());
+		if (!MSV_FAILED(errorCode))
+		{
+			//added modules are checked after stress
+			modules.push_back(spModule);
+		}
+
+		return errorCode;
+	}
+
+	//measures duration of module manager operation
+	template<class Operation>
+	static void Measure(MsvStressSamples& samples, Operation operation)
+	{
+		std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+		MsvErrorCode errorCode = operation();
+		samples.Add(std::chrono::steady_clock::now() - begin, errorCode);
+	}
+
+	void Run(uint32_t threadIndex, MsvStressThreadResult& result)
+	{
+		MsvStressRole role = GetRole(threadIndex);
+		std::mt19937 generator(threadIndex);
+
+		while (!m_started.load(std::memory_order_acquire))
+		{
+			std::this_thread::yield();
+		}
+
+		while (!m_stopped.load(std::memory_order_acquire))
+		{
+			switch (role)
+			{
+			case MsvStressRole::MSV_STRESS_ROLE_LIFECYCLE:
+				Measure(result.operations[static_cast<size_t>(MsvStressOperation::MSV_STRESS_OPERATION_START)], [this]() { return m_spModuleManager->Start(); });
+				Measure(result.operations[static_cast<size_t>(MsvStressOperation::MSV_STRESS_OPERATION_STOP)], [this]() { return m_spModuleManager->Stop(); });
+				break;
+			case MsvStressRole::MSV_STRESS_ROLE_QUERY:
+				Measure(result.operations[static_cast<size_t>(MsvStressOperation::MSV_STRESS_OPERATION_RUNNING)], [this]() { return m_spModuleManager->Running() ? MSV_SUCCESS : MSV_NOT_RUNNING_INFO; });
+				Measure(result.operations[static_cast<size_t>(MsvStressOperation::MSV_STRESS_OPERATION_INITIALIZED)], [this]() { return m_spModuleManager->Initialized() ? MSV_SUCCESS : MSV_NOT_INITIALIZED_INFO; });
+				break;
+			case MsvStressRole::MSV_STRESS_ROLE_ADD:
+			{
+				//new module until maximum is reached, then duplicate of existing module (rejected)
+				MsvStressOperation operation = MsvStressOperation::MSV_STRESS_OPERATION_ADD_MODULE;
+				int32_t moduleId = m_nextModuleId.fetch_add(1);
+				if (moduleId >= static_cast<int32_t>(m_options.maxModules))
+				{
+					operation = MsvStressOperation::MSV_STRESS_OPERATION_ADD_EXISTING;
+					moduleId = static_cast<int32_t>(generator() % m_options.maxModules);
+				}
+				Measure(result.operations[static_cast<size_t>(operation)], [this, moduleId, &result]() { return AddModule(moduleId, result.modules); });
+				break;
+			}
+			default:
+				return;
+			}
+		}
+	}
+
+	MsvStressOptions m_options;
+	std::shared_ptr<IMsvLoggerProvider> m_spLoggerProvider;
+	std::shared_ptr<MsvModuleManager> m_spModuleManager;
+	std::atomic<int32_t> m_nextModuleId;
+	std::atomic<bool> m_started;
+	std::atomic<bool> m_stopped;
+};
+
+static double ToMicroseconds(std::chrono::nanoseconds duration)
+{
+	return static_cast<double>(duration.count()) / 1000.0;
+}
+
+static std::chrono::nanoseconds GetPercentile(const std::vector<std::chrono::nanoseconds>& sortedSamples, double percentile)
+{
+	if (sortedSamples.empty())
+	{
+		return std::chrono::nanoseconds::zero();
+	}
+
+	size_t index = static_cast<size_t>(percentile / 100.0 * static_cast<double>(sortedSamples.size() - 1) + 0.5);
+	return sortedSamples[std::min(index, sortedSamples.size() - 1)];
+}
+
+static bool ParseOption(const char* argument, const char* name, uint32_t& value)
+{
+	size_t nameLength = std::strlen(name);
+	if (std::strncmp(argument, name, nameLength) != 0 || argument[nameLength] != '=')
+	{
+		return false;
+	}
+
+	value = static_cast<uint32_t>(std::strtoul(argument + nameLength + 1, nullptr, 10));
+	return true;
+}
+
+
+/*-----------------------------------------------------------------------------------------------------
+**											Main
+**---------------------------------------------------------------------------------------------------*/
+
+
+int main(int argc, char** argv)
+{
+	MsvStressOptions options;
+	for (int i = 1; i < argc; ++i)
+	{
+		if (!ParseOption(argv[i], "--threads", options.threads) && !ParseOption(argv[i], "--duration", options.duration) && !ParseOption(argv[i], "--modules", options.modules)
+			&& !ParseOption(argv[i], "--max-modules", options.maxModules) && !ParseOption(argv[i], "--latency", options.latency) && !ParseOption(argv[i], "--failures", options.failurePermille))
+		{
+			std::printf("Usage: %s [--threads=N] [--duration=S] [--modules=N] [--max-modules=N] [--latency=US] [--failures=PERMILLE]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	options.threads = std::max<uint32_t>(options.threads, 1);
+	options.maxModules = std::max(options.maxModules, std::max<uint32_t>(options.modules, 1));
+	options.failurePermille = std::min<uint32_t>(options.failurePermille, 1000);
+
+	MsvStressHarness harness(options);
+
+	//initial modules (module manager is initialized, modules are added later in initialized or running state)
+	std::vector<MsvStressThreadResult> results(options.threads + 1);
+	for (uint32_t i = 0; i < options.modules; ++i)
+	{
+		harness.AddModule(harness.m_nextModuleId.fetch_add(1), results[options.threads].modules);
+	}
+
+	//initialize is rolled back on injected failure -> retry
+	MsvErrorCode errorCode = MSV_SUCCESS;
+	for (uint32_t attempt = 0; attempt < 1000 && MSV_FAILED(errorCode = harness.m_spModuleManager->Initialize()); ++attempt)
+	{
+	}
+	if (MSV_FAILED(errorCode))
+	{
+		std::printf("Initialize module manager failed with error: 0x%x\n", static_cast<unsigned int>(errorCode));
+		return 1;
+	}
+
+	std::vector<std::thread> threads;
+	threads.reserve(options.threads);
+	for (uint32_t i = 0; i < options.threads; ++i)
+	{
+		threads.emplace_back(&MsvStressHarness::Run, &harness, i, std::ref(results[i]));
+	}
+
+	std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+	harness.m_started.store(true, std::memory_order_release);
+	std::this_thread::sleep_for(std::chrono::seconds(options.duration));
+	harness.m_stopped.store(true, std::memory_order_release);
+
+	for (std::vector<std::thread>::iterator it = threads.begin(); it != threads.end(); ++it)
+	{
+		it->join();
+	}
+	double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+	//report
+	uint32_t roleCounts[3] = {};
+	for (uint32_t i = 0; i < options.threads; ++i)
+	{
+		++roleCounts[static_cast<size_t>(GetRole(i))];
+	}
+
+	std::printf("Threads: %u (lifecycle %u, query %u, add %u), duration %.2f s, modules %u..%u, latency %u us (jitter), failures %u permille\n",
+		options.threads, roleCounts[0], roleCounts[1], roleCounts[2], elapsed, options.modules, options.maxModules, options.latency, options.failurePermille);
+	std::printf("Start, Stop and AddModule hold module manager lock for whole call (their latency is upper bound of lock hold time),\n");
+	std::printf("Running and Initialized latency is mostly waiting for that lock (build with -DMSV_LOCK_INSTRUMENTATION=1 for exact lock statistics).\n\n");
+	std::printf("%-12s %12s %10s %14s %10s %10s %10s %10s %10s\n", "Operation", "Count", "Failures", "Throughput/s", "p50 [us]", "p90 [us]", "p99 [us]", "p99.9 [us]", "max [us]");
+
+	for (size_t operation = 0; operation < static_cast<size_t>(MsvStressOperation::MSV_STRESS_OPERATION_COUNT); ++operation)
+	{
+		uint64_t count = 0;
+		uint64_t failures = 0;
+		std::vector<std::chrono::nanoseconds> samples;
+		for (std::vector<MsvStressThreadResult>::const_iterator it = results.begin(); it != results.end(); ++it)
+		{
+			count += it->operations[operation].m_count;
+			failures += it->operations[operation].m_failures;
+			samples.insert(samples.end(), it->operations[operation].m_samples.begin(), it->operations[operation].m_samples.end());
+		}
+
+		if (!count)
+		{
+			continue;
+		}
+
+		std::sort(samples.begin(), samples.end());
+		std::printf("%-12s %12llu %10llu %14.0f %10.3f %10.3f %10.3f %10.3f %10.3f\n", g_operationNames[operation], static_cast<unsigned long long>(count),
+			static_cast<unsigned long long>(failures), static_cast<double>(count) / elapsed, ToMicroseconds(GetPercentile(samples, 50.0)), ToMicroseconds(GetPercentile(samples, 90.0)),
+			ToMicroseconds(GetPercentile(samples, 99.0)), ToMicroseconds(GetPercentile(samples, 99.9)), ToMicroseconds(samples.back()));
+	}
+
+#if MSV_LOCK_INSTRUMENTATION != 0
+	//lock statistics of module manager and DLL module adapters (by call site, longest total wait first)
+	std::vector<MsvLockSiteStatistics> lockStatistics;
+	MsvLockStatistics::GetStatistics(lockStatistics);
+
+	std::printf("\n%12s %12s %12s %14s %12s %14s %12s  %s\n", "Acquired", "Recursive", "Contended", "Wait sum [us]", "Wait max", "Hold sum [us]", "Hold max", "Call site");
+	for (std::vector<MsvLockSiteStatistics>::const_iterator it = lockStatistics.begin(); it != lockStatistics.end(); ++it)
+	{
+		std::printf("%12llu %12llu %12llu %14.0f %12.3f %14.0f %12.3f  %s\n", static_cast<unsigned long long>(it->acquisitions), static_cast<unsigned long long>(it->recursions),
+			static_cast<unsigned long long>(it->contentions), ToMicroseconds(it->totalWait), ToMicroseconds(it->maxWait), ToMicroseconds(it->totalHold), ToMicroseconds(it->maxHold), it->callSite);
+	}
+#endif
+
+	//final state invariants (failures are injected only to initialize and start, so stop and uninitialize must succeed)
+	int result = 0;
+	if (MSV_FAILED(errorCode = harness.m_spModuleManager->Stop()) || harness.m_spModuleManager->Running())
+	{
+		std::printf("Stop module manager failed with error: 0x%x\n", static_cast<unsigned int>(errorCode));
+		result = 1;
+	}
+
+	if (MSV_FAILED(errorCode = harness.m_spModuleManager->Uninitialize()) || harness.m_spModuleManager->Initialized())
+	{
+		std::printf("Uninitialize module manager failed with error: 0x%x\n", static_cast<unsigned int>(errorCode));
+		result = 1;
+	}
+
+	for (std::vector<MsvStressThreadResult>::const_iterator it = results.begin(); it != results.end(); ++it)
+	{
+		for (std::vector<std::shared_ptr<MsvSyntheticModule>>::const_iterator moduleIt = it->modules.begin(); moduleIt != it->modules.end(); ++moduleIt)
+		{
+			if ((*moduleIt)->Running() || (*moduleIt)->Initialized())
+			{
+				std::printf("Module is still initialized or running after module manager has been uninitialized.\n");
+				result = 1;
+				break;
+			}
+		}
+	}
+
+	std::printf("\nFinal state invariants: %s\n", result ? "FAILED" : "OK");
+
+	return result;
+}
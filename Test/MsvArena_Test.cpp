@@ -0,0 +1,354 @@
+
+
+#include "pch.h"
+
+#include "mmodule/MsvArena.h"
+#include "mmodule/MsvModuleLifecycle.h"
+#include "mmodule/MsvModuleManager.h"
+
+#include "mmodule/Mocks/MsvModule_Mock.h"
+#include "mmodule/Mocks/MsvModuleConfigurator_Mock.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <algorithm>
+#include <map>
+#include <thread>
+#include <vector>
+
+MSV_ENABLE_WARNINGS
+
+
+using namespace ::testing;
+
+
+//module which allocates its data from its own arena
+class MsvTestArenaModule:
+	public MsvModuleLifecycle<MsvTestArenaModule, MsvModuleBase>
+{
+public:
+	MsvTestArenaModule(std::shared_ptr<IMsvLoggerProvider> spLoggerProvider):
+		MsvModuleLifecycle(spLoggerProvider, "MsvArena_Test")
+	{
+
+	}
+
+	MsvErrorCode OnInitialize()
+	{
+		if (!m_spArena)
+		{
+			return MSV_NOT_INITIALIZED_ERROR;
+		}
+
+		m_spData.reset(new std::vector<int, MsvArenaAllocator<int>>(MsvArenaAllocator<int>(m_spArena)));
+		m_spData->resize(1000);
+
+		return MSV_SUCCESS;
+	}
+
+	MsvErrorCode OnUninitialize()
+	{
+		m_spData.reset();
+
+		return MSV_SUCCESS;
+	}
+
+	std::shared_ptr<MsvArena> GetArena() const
+	{
+		return m_spArena;
+	}
+
+	std::unique_ptr<std::vector<int, MsvArenaAllocator<int>>> m_spData;
+};
+
+
+class MsvArena_Test:
+	public MsvModule_TestBase
+{
+public:
+	virtual void SetUp()
+	{
+		InitializeLogging();
+
+		m_spArena.reset(new (std::nothrow) MsvArena(4096));
+		EXPECT_NE(m_spArena, nullptr);
+	}
+
+	virtual void TearDown()
+	{
+		m_spArena.reset();
+
+		UninitializeLogging();
+	}
+
+	//tested classes
+	std::shared_ptr<MsvArena> m_spArena;
+};
+
+
+/*-----------------------------------------------------------------------------------------------------
+**											Arena Tests
+**---------------------------------------------------------------------------------------------------*/
+
+
+TEST_F(MsvArena_Test, ItShouldCoLocateAllocations_WhenTheyFitToChunk)
+{
+	char* pFirst = static_cast<char*>(m_spArena->Allocate(16, 8));
+	char* pSecond = static_cast<char*>(m_spArena->Allocate(16, 8));
+
+	EXPECT_NE(pFirst, nullptr);
+	EXPECT_EQ(pSecond, pFirst + 16);
+	EXPECT_EQ(m_spArena->GetReservedSize(), 4096u);
+	EXPECT_EQ(m_spArena->GetLiveSize(), 32u);
+}
+
+TEST_F(MsvArena_Test, ItShouldAlignAllocation_WhenAlignmentIsRequested)
+{
+	m_spArena->Allocate(1, 1);
+	void* pMemory = m_spArena->Allocate(64, 64);
+
+	EXPECT_NE(pMemory, nullptr);
+	EXPECT_EQ(reinterpret_cast<uintptr_t>(pMemory) % 64, 0u);
+}
+
+TEST_F(MsvArena_Test, ItShouldReserveDedicatedChunk_WhenAllocationIsLarge)
+{
+	char* pSmall = static_cast<char*>(m_spArena->Allocate(16, 8));
+	void* pLarge = m_spArena->Allocate(10000, 8);
+	char* pNextSmall = static_cast<char*>(m_spArena->Allocate(16, 8));
+
+	EXPECT_NE(pLarge, nullptr);
+	EXPECT_GT(m_spArena->GetReservedSize(), 4096u + 10000u);
+
+	//current chunk is kept
+	EXPECT_EQ(pNextSmall, pSmall + 16);
+}
+
+TEST_F(MsvArena_Test, ItShouldFail_WhenAlignmentIsNotPowerOfTwo)
+{
+	EXPECT_EQ(m_spArena->Allocate(16, 3), nullptr);
+	EXPECT_EQ(m_spArena->GetLiveSize(), 0u);
+}
+
+TEST_F(MsvArena_Test, ItShouldDecreaseLiveSize_WhenMemoryIsDeallocated)
+{
+	void* pMemory = m_spArena->Allocate(100, 8);
+	m_spArena->Deallocate(pMemory, 100);
+
+	EXPECT_EQ(m_spArena->GetLiveSize(), 0u);
+	EXPECT_EQ(m_spArena->GetReservedSize(), 4096u);
+}
+
+TEST_F(MsvArena_Test, ItShouldKeepPeakSize_WhenMemoryIsDeallocated)
+{
+	void* pFirst = m_spArena->Allocate(100, 8);
+	void* pSecond = m_spArena->Allocate(200, 8);
+	m_spArena->Deallocate(pFirst, 100);
+	m_spArena->Deallocate(pSecond, 200);
+	m_spArena->Allocate(50, 8);
+
+	MsvArenaUsage usage;
+	m_spArena->GetUsage(usage);
+	EXPECT_EQ(usage.liveSize, 50u);
+	EXPECT_EQ(usage.peakSize, 300u);
+	EXPECT_EQ(usage.reservedSize, 4096u);
+}
+
+TEST_F(MsvArena_Test, ItShouldReuseMemory_WhenItIsDeallocated)
+{
+	void* pFirst = m_spArena->Allocate(100, 8);
+	m_spArena->Deallocate(pFirst, 100);
+
+	//allocation of the same size class gets deallocated memory
+	void* pSecond = m_spArena->Allocate(120, 8);
+	EXPECT_EQ(pSecond, pFirst);
+	EXPECT_EQ(reinterpret_cast<uintptr_t>(pSecond) % alignof(std::max_align_t), 0u);
+	m_spArena->Deallocate(pSecond, 120);
+
+	//allocation churn does not grow arena
+	for (int i = 0; i < 10000; ++i)
+	{
+		size_t size = 1 + static_cast<size_t>(i % 500);
+		void* pMemory = m_spArena->Allocate(size, 8);
+		EXPECT_NE(pMemory, nullptr);
+		m_spArena->Deallocate(pMemory, size);
+	}
+
+	EXPECT_EQ(m_spArena->GetLiveSize(), 0u);
+	EXPECT_EQ(m_spArena->GetReservedSize(), 4096u);
+}
+
+TEST_F(MsvArena_Test, ItShouldReleaseDedicatedChunk_WhenLargeAllocationIsDeallocated)
+{
+	m_spArena->Allocate(16, 8);
+	for (int i = 0; i < 100; ++i)
+	{
+		void* pLarge = m_spArena->Allocate(10000, 8);
+		EXPECT_NE(pLarge, nullptr);
+		EXPECT_GT(m_spArena->GetReservedSize(), 4096u + 10000u);
+
+		m_spArena->Deallocate(pLarge, 10000);
+		EXPECT_EQ(m_spArena->GetReservedSize(), 4096u);
+	}
+
+	EXPECT_EQ(m_spArena->GetLiveSize(), 16u);
+}
+
+TEST_F(MsvArena_Test, ItShouldUseHugePagesForLargeChunksOnly_WhenHugePagesAreRequested)
+{
+	MsvArena arena(4096, true);
+	char* pFirst = static_cast<char*>(arena.Allocate(16, 8));
+	char* pSecond = static_cast<char*>(arena.Allocate(16, 8));
+
+	EXPECT_TRUE(arena.HugePages());
+	EXPECT_NE(pFirst, nullptr);
+	EXPECT_EQ(pSecond, pFirst + 16);
+
+	//small chunk is not rounded up to huge page
+	EXPECT_EQ(arena.GetReservedSize(), 4096u);
+
+	//large chunk is rounded up to whole huge pages
+	char* pLarge = static_cast<char*>(arena.Allocate(MSV_ARENA_HUGE_PAGE_SIZE + 1, 8));
+	EXPECT_NE(pLarge, nullptr);
+	EXPECT_EQ(arena.GetReservedSize(), 4096u + 2 * MSV_ARENA_HUGE_PAGE_SIZE);
+
+	//memory is writable
+	pFirst[0] = 1;
+	pSecond[15] = 2;
+	pLarge[0] = 3;
+	pLarge[MSV_ARENA_HUGE_PAGE_SIZE] = 4;
+
+	arena.Deallocate(pLarge, MSV_ARENA_HUGE_PAGE_SIZE + 1);
+	EXPECT_EQ(arena.GetReservedSize(), 4096u);
+}
+
+TEST_F(MsvArena_Test, ItShouldReturnUniqueAddresses_WhenAllocatedFromMoreThreads)
+{
+	std::vector<std::vector<void*>> allocations(4);
+	std::vector<std::thread> threads;
+	for (size_t i = 0; i < allocations.size(); ++i)
+	{
+		threads.emplace_back([this, &allocations, i]()
+		{
+			for (int j = 0; j < 1000; ++j)
+			{
+				allocations[i].push_back(m_spArena->Allocate(24, 8));
+			}
+		});
+	}
+
+	for (std::vector<std::thread>::iterator it = threads.begin(); it != threads.end(); ++it)
+	{
+		it->join();
+	}
+
+	std::vector<void*> all;
+	for (std::vector<std::vector<void*>>::const_iterator it = allocations.begin(); it != allocations.end(); ++it)
+	{
+		all.insert(all.end(), it->begin(), it->end());
+	}
+	std::sort(all.begin(), all.end());
+
+	EXPECT_EQ(std::adjacent_find(all.begin(), all.end()), all.end());
+	EXPECT_EQ(std::count(all.begin(), all.end(), nullptr), 0);
+	EXPECT_EQ(m_spArena->GetLiveSize(), 4000u * 24u);
+}
+
+
+/*-----------------------------------------------------------------------------------------------------
+**											Arena Allocator Tests
+**---------------------------------------------------------------------------------------------------*/
+
+
+TEST_F(MsvArena_Test, ItShouldAllocateContainerFromArena_WhenArenaAllocatorIsUsed)
+{
+	{
+		MsvArenaAllocator<std::pair<const int32_t, int32_t>> allocator(m_spArena);
+		std::map<int32_t, int32_t, std::less<int32_t>, MsvArenaAllocator<std::pair<const int32_t, int32_t>>> values(allocator);
+		values[1] = 1;
+		values[2] = 2;
+
+		EXPECT_GT(m_spArena->GetLiveSize(), 0u);
+	}
+
+	EXPECT_EQ(m_spArena->GetLiveSize(), 0u);
+}
+
+TEST_F(MsvArena_Test, ItShouldKeepArena_WhenSharedObjectOutlivesOtherOwners)
+{
+	std::weak_ptr<MsvArena> wpArena = m_spArena;
+	std::shared_ptr<std::vector<int>> spObject = std::allocate_shared<std::vector<int>>(MsvArenaAllocator<std::vector<int>>(m_spArena), 10, 1);
+	m_spArena.reset();
+
+	//control block holds allocator (and arena)
+	EXPECT_FALSE(wpArena.expired());
+	EXPECT_EQ(spObject->size(), 10u);
+
+	spObject.reset();
+	EXPECT_TRUE(wpArena.expired());
+}
+
+
+/*-----------------------------------------------------------------------------------------------------
+**											Module Manager Arena Tests
+**---------------------------------------------------------------------------------------------------*/
+
+
+TEST_F(MsvArena_Test, ItShouldAllocateModulesFromManagerArena_WhenCreatedByModuleManager)
+{
+	MsvModuleManager moduleManager(m_spLogger);
+	std::shared_ptr<MsvArena> spManagerArena = moduleManager.GetArena();
+	size_t liveSize = spManagerArena->GetLiveSize();
+
+	std::shared_ptr<MsvModule_Mock> spModuleMock;
+	std::shared_ptr<MsvModuleConfigurator_Mock> spModuleConfiguratorMock;
+	EXPECT_EQ(moduleManager.CreateObject(spModuleMock), MSV_SUCCESS);
+	EXPECT_EQ(moduleManager.CreateObject(spModuleConfiguratorMock), MSV_SUCCESS);
+	EXPECT_GE(spManagerArena->GetLiveSize(), liveSize + sizeof(MsvModule_Mock) + sizeof(MsvModuleConfigurator_Mock));
+
+	EXPECT_CALL(*spModuleConfiguratorMock, IsInstalled(Matcher<bool&>(_)))
+		.WillOnce(DoAll(SetArgReferee<0>(false), Return(MSV_SUCCESS)));
+	EXPECT_CALL(*spModuleConfiguratorMock, IsEnabled(Matcher<bool&>(_)))
+		.WillOnce(DoAll(SetArgReferee<0>(false), Return(MSV_SUCCESS)));
+
+	//registry entry (map node) is allocated from the same arena
+	liveSize = spManagerArena->GetLiveSize();
+	EXPECT_EQ(moduleManager.AddModule(static_cast<int32_t>(ModuleId::MSV_TEST_STATIC_MODULE), spModuleMock, spModuleConfiguratorMock), MSV_SUCCESS);
+	EXPECT_GT(spManagerArena->GetLiveSize(), liveSize);
+}
+
+TEST_F(MsvArena_Test, ItShouldAccountModuleMemory_WhenModuleIsInitialized)
+{
+	MsvModuleManager moduleManager(m_spLogger);
+	std::shared_ptr<MsvTestArenaModule> spModule(new (std::nothrow) MsvTestArenaModule(m_spLoggerProvider));
+	EXPECT_NE(spModule, nullptr);
+	std::shared_ptr<MsvModuleConfigurator_Mock> spModuleConfiguratorMock(new (std::nothrow) MsvModuleConfigurator_Mock());
+	EXPECT_NE(spModuleConfiguratorMock, nullptr);
+
+	EXPECT_CALL(*spModuleConfiguratorMock, IsInstalled(Matcher<bool&>(_)))
+		.WillRepeatedly(DoAll(SetArgReferee<0>(true), Return(MSV_SUCCESS)));
+	EXPECT_CALL(*spModuleConfiguratorMock, IsEnabled(Matcher<bool&>(_)))
+		.WillRepeatedly(DoAll(SetArgReferee<0>(true), Return(MSV_SUCCESS)));
+
+	int32_t moduleId = static_cast<int32_t>(ModuleId::MSV_TEST_STATIC_MODULE);
+	EXPECT_EQ(moduleManager.SetModuleArenaOptions(moduleId, 0, false), MSV_INVALID_DATA_ERROR);
+	EXPECT_EQ(moduleManager.SetModuleArenaOptions(moduleId, 8192, false), MSV_SUCCESS);
+	EXPECT_EQ(moduleManager.AddModule(moduleId, spModule, spModuleConfiguratorMock), MSV_SUCCESS);
+
+	MsvArenaUsage usage;
+	EXPECT_EQ(moduleManager.GetModuleMemoryUsage(moduleId, usage), MSV_NOT_FOUND_ERROR);
+
+	//module allocates its data from its own arena
+	EXPECT_EQ(moduleManager.Initialize(), MSV_SUCCESS);
+	EXPECT_EQ(moduleManager.GetModuleMemoryUsage(moduleId, usage), MSV_SUCCESS);
+	EXPECT_EQ(usage.liveSize, 1000 * sizeof(int));
+	EXPECT_EQ(usage.peakSize, 1000 * sizeof(int));
+	EXPECT_GE(usage.reservedSize, usage.liveSize);
+
+	//arena is released after uninitialize
+	std::weak_ptr<MsvArena> wpArena = spModule->GetArena();
+	EXPECT_EQ(moduleManager.Uninitialize(), MSV_SUCCESS);
+	EXPECT_EQ(moduleManager.GetModuleMemoryUsage(moduleId, usage), MSV_NOT_FOUND_ERROR);
+	EXPECT_EQ(spModule->GetArena(), nullptr);
+	EXPECT_TRUE(wpArena.expired());
+}
@@ -0,0 +1,91 @@
+
+
+#include "pch.h"
+
+#include "mmodule/MsvCriticalPath.h"
+
+
+using namespace ::testing;
+
+
+class MsvCriticalPath_Test:
+	public MsvModule_TestBase
+{
+public:
+	virtual void SetUp()
+	{
+		//1 -> 3 -> 4 and 2 -> 4 (4 depends on 2 and 3, 3 depends on 1)
+		m_startupOrder = { 1, 2, 3, 4 };
+		m_dependencies[3] = { 1 };
+		m_dependencies[4] = { 2, 3 };
+
+		m_durations[1] = std::chrono::milliseconds(10);
+		m_durations[2] = std::chrono::milliseconds(5);
+		m_durations[3] = std::chrono::milliseconds(20);
+		m_durations[4] = std::chrono::milliseconds(1);
+	}
+
+	virtual void TearDown()
+	{
+
+	}
+
+	std::vector<int32_t> m_startupOrder;
+	std::map<int32_t, std::vector<int32_t>> m_dependencies;
+	std::unordered_map<int32_t, std::chrono::nanoseconds> m_durations;
+};
+
+
+/*-----------------------------------------------------------------------------------------------------
+**											Analyze Tests
+**---------------------------------------------------------------------------------------------------*/
+
+
+TEST_F(MsvCriticalPath_Test, ItShouldFindLongestChain_WhenModulesHaveDependencies)
+{
+	MsvCriticalPath criticalPath;
+	EXPECT_EQ(MsvCriticalPathAnalyzer::Analyze(m_startupOrder, m_dependencies, m_durations, criticalPath), MSV_SUCCESS);
+
+	EXPECT_EQ(criticalPath.path, std::vector<int32_t>({ 1, 3, 4 }));
+	EXPECT_EQ(criticalPath.totalDuration, std::chrono::milliseconds(31));
+	EXPECT_EQ(criticalPath.sequentialDuration, std::chrono::milliseconds(36));
+	EXPECT_EQ(criticalPath.modules.size(), 4u);
+}
+
+TEST_F(MsvCriticalPath_Test, ItShouldComputeSlack_WhenModuleIsNotCritical)
+{
+	MsvCriticalPath criticalPath;
+	EXPECT_EQ(MsvCriticalPathAnalyzer::Analyze(m_startupOrder, m_dependencies, m_durations, criticalPath), MSV_SUCCESS);
+
+	//module 2 can finish at 30 ms (module 4 starts at 30 ms) -> 25 ms slack
+	EXPECT_EQ(criticalPath.modules[1].moduleId, 2);
+	EXPECT_FALSE(criticalPath.modules[1].critical);
+	EXPECT_EQ(criticalPath.modules[1].earliestStart, std::chrono::milliseconds(0));
+	EXPECT_EQ(criticalPath.modules[1].latestFinish, std::chrono::milliseconds(30));
+	EXPECT_EQ(criticalPath.modules[1].slack, std::chrono::milliseconds(25));
+
+	EXPECT_TRUE(criticalPath.modules[2].critical);
+	EXPECT_EQ(criticalPath.modules[2].slack, std::chrono::milliseconds(0));
+}
+
+TEST_F(MsvCriticalPath_Test, ItShouldFail_WhenOrderIsNotTopological)
+{
+	MsvCriticalPath criticalPath;
+	EXPECT_EQ(MsvCriticalPathAnalyzer::Analyze({ 4, 3, 2, 1 }, m_dependencies, m_durations, criticalPath), MSV_INVALID_DATA_ERROR);
+}
+
+TEST_F(MsvCriticalPath_Test, ItShouldReturnEmptyPath_WhenNoModules)
+{
+	MsvCriticalPath criticalPath;
+	EXPECT_EQ(MsvCriticalPathAnalyzer::Analyze({}, m_dependencies, m_durations, criticalPath), MSV_SUCCESS);
+	EXPECT_TRUE(criticalPath.path.empty());
+	EXPECT_EQ(criticalPath.totalDuration, std::chrono::nanoseconds::zero());
+}
+
+TEST_F(MsvCriticalPath_Test, ItShouldListPathInSummary)
+{
+	MsvCriticalPath criticalPath;
+	EXPECT_EQ(MsvCriticalPathAnalyzer::Analyze(m_startupOrder, m_dependencies, m_durations, criticalPath), MSV_SUCCESS);
+
+	EXPECT_EQ(MsvCriticalPathAnalyzer::GetSummary(criticalPath), "critical path 31000 us (sequential 36000 us): 1 (10000 us) -> 3 (20000 us) -> 4 (1000 us)");
+}
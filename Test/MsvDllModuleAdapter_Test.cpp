@@ -373,3 +373,73 @@ TEST_F(MsvDllModuleAdapter_Test, ItShouldFailed_WhenDllModuleStopFailed)
 
 	EXPECT_EQ(m_spDllModuleAdapter->Stop(), MSV_ALLOCATION_ERROR);
 }
+
+
+/*-----------------------------------------------------------------------------------------------------
+**											DLL Path Tests
+**---------------------------------------------------------------------------------------------------*/
+
+
+TEST_F(MsvDllModuleAdapter_Test, ItShouldFailToGetDllPath_WhenNotSet)
+{
+	std::shared_ptr<MsvDllModuleAdapter> spDllModuleAdapter = std::dynamic_pointer_cast<MsvDllModuleAdapter>(m_spDllModuleAdapter);
+	EXPECT_NE(spDllModuleAdapter, nullptr);
+
+	std::string dllPath;
+	EXPECT_EQ(spDllModuleAdapter->GetDllPath(dllPath), MSV_NOT_FOUND_ERROR);
+	EXPECT_TRUE(dllPath.empty());
+}
+
+TEST_F(MsvDllModuleAdapter_Test, ItShouldReturnDllPath_WhenSet)
+{
+	std::shared_ptr<MsvDllModuleAdapter> spDllModuleAdapter = std::dynamic_pointer_cast<MsvDllModuleAdapter>(m_spDllModuleAdapter);
+	EXPECT_NE(spDllModuleAdapter, nullptr);
+
+	spDllModuleAdapter->SetDllPath("modules/MsvTestModule.dll");
+
+	std::string dllPath;
+	EXPECT_EQ(spDllModuleAdapter->GetDllPath(dllPath), MSV_SUCCESS);
+	EXPECT_EQ(dllPath, "modules/MsvTestModule.dll");
+}
+
+
+/*-----------------------------------------------------------------------------------------------------
+**											Trace Tests
+**---------------------------------------------------------------------------------------------------*/
+
+
+TEST_F(MsvDllModuleAdapter_Test, ItShouldRecordDllLoadEvents_WhenTraceRecorderIsSet)
+{
+	std::shared_ptr<MsvDllModuleAdapter> spDllModuleAdapter = std::dynamic_pointer_cast<MsvDllModuleAdapter>(m_spDllModuleAdapter);
+	EXPECT_NE(spDllModuleAdapter, nullptr);
+
+	std::shared_ptr<MsvTraceRecorder> spTraceRecorder(new (std::nothrow) MsvTraceRecorder());
+	EXPECT_NE(spTraceRecorder, nullptr);
+	spDllModuleAdapter->SetTraceRecorder(spTraceRecorder);
+
+	EXPECT_CALL(*m_spDllFactoryMock, GetDllObject(_, _))
+		.WillOnce(DoAll(SetArgReferee<1>(m_spDynamicModuleMock), Return(MSV_SUCCESS)));
+	EXPECT_CALL(*m_spDynamicModuleMock, SetDllFactory(Matcher<std::shared_ptr<IMsvDllFactory>>(m_spDllFactoryMock)));
+	EXPECT_CALL(*m_spDynamicModuleMock, Initialize())
+		.WillOnce(Return(MSV_SUCCESS));
+	EXPECT_CALL(*m_spDynamicModuleMock, Initialized())
+		.WillOnce(Return(true));
+
+	EXPECT_EQ(m_spDllModuleAdapter->Initialize(), MSV_SUCCESS);
+
+	//load and initialize events (begin and end of each)
+	std::vector<MsvTraceEvent> events;
+	spTraceRecorder->GetEvents(events);
+	EXPECT_EQ(events.size(), 4u);
+	EXPECT_EQ(events[0].name, std::string("Load DLL module ") + MSV_DYNAMIC_MODULE_ID);
+	EXPECT_EQ(events[0].phase, 'B');
+	EXPECT_EQ(events[1].phase, 'E');
+	EXPECT_EQ(events[2].name, std::string("Initialize DLL module ") + MSV_DYNAMIC_MODULE_ID);
+	EXPECT_LE(events[1].timestamp, events[2].timestamp);
+
+	//expectations hold mocks (factory returns module, module expects factory) -> verify and break cycle
+	spDllModuleAdapter.reset();
+	m_spDllModuleAdapter.reset();
+	Mock::VerifyAndClearExpectations(m_spDynamicModuleMock.get());
+	Mock::VerifyAndClearExpectations(m_spDllFactoryMock.get());
+}
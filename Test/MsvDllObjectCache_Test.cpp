@@ -0,0 +1,265 @@
+
+
+#include "pch.h"
+
+#include "mmodule/MsvDllObjectCache.h"
+#include "mmodule/MsvDllModuleAdapter.h"
+
+#include "mmodule/Mocks/MsvDllModule_Mock.h"
+#include "mdllfactory/Mocks/MsvDllFactory_Mock.h"
+
+
+using namespace ::testing;
+
+
+const char* const MSV_OTHER_DYNAMIC_MODULE_ID = "{5A1F0C0E-3B7D-4C52-9E0A-6F1B2D3C4E5F}";
+
+
+class MsvDllObjectCache_Test:
+	public MsvModule_TestBase
+{
+public:
+	virtual void SetUp()
+	{
+		InitializeLogging();
+
+		m_spDllFactoryMock.reset(new (std::nothrow) MsvDllFactory_Mock());
+		EXPECT_NE(m_spDllFactoryMock, nullptr);
+
+		m_spDynamicModuleMock.reset(new (std::nothrow) MsvDllModule_Mock());
+		EXPECT_NE(m_spDynamicModuleMock, nullptr);
+
+		m_spOtherDynamicModuleMock.reset(new (std::nothrow) MsvDllModule_Mock());
+		EXPECT_NE(m_spOtherDynamicModuleMock, nullptr);
+
+		m_spDllObjectCache.reset(new (std::nothrow) MsvDllObjectCache());
+		EXPECT_NE(m_spDllObjectCache, nullptr);
+	}
+
+	virtual void TearDown()
+	{
+		m_spDllObjectCache.reset();
+
+		//expectations hold mocks (factory returns modules, modules expect factory) -> verify and break cycles
+		Mock::VerifyAndClearExpectations(m_spOtherDynamicModuleMock.get());
+		Mock::VerifyAndClearExpectations(m_spDynamicModuleMock.get());
+		Mock::VerifyAndClearExpectations(m_spDllFactoryMock.get());
+
+		m_spOtherDynamicModuleMock.reset();
+		m_spDynamicModuleMock.reset();
+		m_spDllFactoryMock.reset();
+
+		UninitializeLogging();
+	}
+
+	//mocks
+	std::shared_ptr<MsvDllFactory_Mock> m_spDllFactoryMock;
+	std::shared_ptr<MsvDllModule_Mock> m_spDynamicModuleMock;
+	std::shared_ptr<MsvDllModule_Mock> m_spOtherDynamicModuleMock;
+
+	//tested classes
+	std::shared_ptr<MsvDllObjectCache> m_spDllObjectCache;
+};
+
+
+/*-----------------------------------------------------------------------------------------------------
+**											GetDllObject Tests
+**---------------------------------------------------------------------------------------------------*/
+
+
+TEST_F(MsvDllObjectCache_Test, ItShouldFail_WhenFactoryIsEmpty)
+{
+	std::shared_ptr<IMsvDllModule> spModule;
+	EXPECT_EQ(m_spDllObjectCache->GetDllObject<IMsvDllModule>(nullptr, MSV_DYNAMIC_MODULE_ID, this, spModule), MSV_INVALID_DATA_ERROR);
+	EXPECT_EQ(spModule, nullptr);
+}
+
+TEST_F(MsvDllObjectCache_Test, ItShouldLoadOnce_WhenSameObjectRequestedTwice)
+{
+	EXPECT_CALL(*m_spDllFactoryMock, GetDllObject(StrEq(MSV_DYNAMIC_MODULE_ID), _))
+		.WillOnce(DoAll(SetArgReferee<1>(m_spDynamicModuleMock), Return(MSV_SUCCESS)));
+
+	std::shared_ptr<IMsvDllModule> spModule;
+	EXPECT_EQ(m_spDllObjectCache->GetDllObject<IMsvDllModule>(m_spDllFactoryMock, MSV_DYNAMIC_MODULE_ID, this, spModule), MSV_SUCCESS);
+	EXPECT_EQ(spModule, m_spDynamicModuleMock);
+
+	spModule.reset();
+	EXPECT_EQ(m_spDllObjectCache->GetDllObject<IMsvDllModule>(m_spDllFactoryMock, MSV_DYNAMIC_MODULE_ID, this, spModule), MSV_SUCCESS);
+	EXPECT_EQ(spModule, m_spDynamicModuleMock);
+}
+
+TEST_F(MsvDllObjectCache_Test, ItShouldCacheEachObject_WhenDifferentObjectsRequested)
+{
+	EXPECT_CALL(*m_spDllFactoryMock, GetDllObject(StrEq(MSV_DYNAMIC_MODULE_ID), _))
+		.WillOnce(DoAll(SetArgReferee<1>(m_spDynamicModuleMock), Return(MSV_SUCCESS)));
+	EXPECT_CALL(*m_spDllFactoryMock, GetDllObject(StrEq(MSV_OTHER_DYNAMIC_MODULE_ID), _))
+		.WillOnce(DoAll(SetArgReferee<1>(m_spOtherDynamicModuleMock), Return(MSV_SUCCESS)));
+
+	std::shared_ptr<IMsvDllModule> spModule;
+	std::shared_ptr<IMsvDllModule> spOtherModule;
+	for (int i = 0; i < 2; ++i)
+	{
+		EXPECT_EQ(m_spDllObjectCache->GetDllObject<IMsvDllModule>(m_spDllFactoryMock, MSV_DYNAMIC_MODULE_ID, this, spModule), MSV_SUCCESS);
+		EXPECT_EQ(m_spDllObjectCache->GetDllObject<IMsvDllModule>(m_spDllFactoryMock, MSV_OTHER_DYNAMIC_MODULE_ID, this, spOtherModule), MSV_SUCCESS);
+	}
+
+	EXPECT_EQ(spModule, m_spDynamicModuleMock);
+	EXPECT_EQ(spOtherModule, m_spOtherDynamicModuleMock);
+}
+
+TEST_F(MsvDllObjectCache_Test, ItShouldNotCache_WhenFactoryFailed)
+{
+	EXPECT_CALL(*m_spDllFactoryMock, GetDllObject(StrEq(MSV_DYNAMIC_MODULE_ID), _))
+		.Times(2)
+		.WillOnce(DoAll(SetArgReferee<1>(nullptr), Return(MSV_ALLOCATION_ERROR)))
+		.WillOnce(DoAll(SetArgReferee<1>(m_spDynamicModuleMock), Return(MSV_SUCCESS)));
+
+	std::shared_ptr<IMsvDllModule> spModule;
+	EXPECT_EQ(m_spDllObjectCache->GetDllObject<IMsvDllModule>(m_spDllFactoryMock, MSV_DYNAMIC_MODULE_ID, this, spModule), MSV_ALLOCATION_ERROR);
+	EXPECT_EQ(m_spDllObjectCache->GetDllObject<IMsvDllModule>(m_spDllFactoryMock, MSV_DYNAMIC_MODULE_ID, this, spModule), MSV_SUCCESS);
+	EXPECT_EQ(spModule, m_spDynamicModuleMock);
+}
+
+TEST_F(MsvDllObjectCache_Test, ItShouldLoadAgain_WhenReleased)
+{
+	EXPECT_CALL(*m_spDllFactoryMock, GetDllObject(StrEq(MSV_DYNAMIC_MODULE_ID), _))
+		.Times(2)
+		.WillRepeatedly(DoAll(SetArgReferee<1>(m_spDynamicModuleMock), Return(MSV_SUCCESS)));
+
+	std::shared_ptr<IMsvDllModule> spModule;
+	EXPECT_EQ(m_spDllObjectCache->GetDllObject<IMsvDllModule>(m_spDllFactoryMock, MSV_DYNAMIC_MODULE_ID, this, spModule), MSV_SUCCESS);
+
+	m_spDllObjectCache->ReleaseDllObject(m_spDllFactoryMock, MSV_DYNAMIC_MODULE_ID, this);
+
+	EXPECT_EQ(m_spDllObjectCache->GetDllObject<IMsvDllModule>(m_spDllFactoryMock, MSV_DYNAMIC_MODULE_ID, this, spModule), MSV_SUCCESS);
+	EXPECT_EQ(spModule, m_spDynamicModuleMock);
+}
+
+TEST_F(MsvDllObjectCache_Test, ItShouldFail_WhenObjectIsOwnedByOtherOwner)
+{
+	int otherOwner = 0;
+
+	EXPECT_CALL(*m_spDllFactoryMock, GetDllObject(StrEq(MSV_DYNAMIC_MODULE_ID), _))
+		.WillOnce(DoAll(SetArgReferee<1>(m_spDynamicModuleMock), Return(MSV_SUCCESS)));
+
+	std::shared_ptr<IMsvDllModule> spModule;
+	EXPECT_EQ(m_spDllObjectCache->GetDllObject<IMsvDllModule>(m_spDllFactoryMock, MSV_DYNAMIC_MODULE_ID, this, spModule), MSV_SUCCESS);
+
+	std::shared_ptr<IMsvDllModule> spOtherModule;
+	EXPECT_EQ(m_spDllObjectCache->GetDllObject<IMsvDllModule>(m_spDllFactoryMock, MSV_DYNAMIC_MODULE_ID, &otherOwner, spOtherModule), MSV_ALREADY_EXISTS_ERROR);
+	EXPECT_EQ(spOtherModule, nullptr);
+
+	//other owner can not release object
+	m_spDllObjectCache->ReleaseDllObject(m_spDllFactoryMock, MSV_DYNAMIC_MODULE_ID, &otherOwner);
+	EXPECT_EQ(m_spDllObjectCache->GetDllObject<IMsvDllModule>(m_spDllFactoryMock, MSV_DYNAMIC_MODULE_ID, this, spModule), MSV_SUCCESS);
+	EXPECT_EQ(spModule, m_spDynamicModuleMock);
+}
+
+
+/*-----------------------------------------------------------------------------------------------------
+**											DLL Module Adapter Tests
+**---------------------------------------------------------------------------------------------------*/
+
+
+TEST_F(MsvDllObjectCache_Test, ItShouldLoadOnce_WhenAdapterInitializedTwice)
+{
+	std::shared_ptr<IMsvModule> spDllModuleAdapter(new (std::nothrow) MsvDllModuleAdapter(MSV_DYNAMIC_MODULE_ID, m_spDllFactoryMock, m_spLogger, m_spDllObjectCache));
+	EXPECT_NE(spDllModuleAdapter, nullptr);
+
+	//set dll factory (dynamic module will be loaded from it only once)
+	EXPECT_CALL(*m_spDllFactoryMock, GetDllObject(StrEq(MSV_DYNAMIC_MODULE_ID), _))
+		.WillOnce(DoAll(SetArgReferee<1>(m_spDynamicModuleMock), Return(MSV_SUCCESS)));
+
+	//set dynamic module (it is initialized and uninitialized twice)
+	EXPECT_CALL(*m_spDynamicModuleMock, SetDllFactory(Matcher<std::shared_ptr<IMsvDllFactory>>(m_spDllFactoryMock)))
+		.Times(2);
+	EXPECT_CALL(*m_spDynamicModuleMock, Initialize())
+		.Times(2)
+		.WillRepeatedly(Return(MSV_SUCCESS));
+	EXPECT_CALL(*m_spDynamicModuleMock, Initialized())
+		.WillRepeatedly(Return(true));
+	EXPECT_CALL(*m_spDynamicModuleMock, Running())
+		.WillRepeatedly(Return(false));
+	EXPECT_CALL(*m_spDynamicModuleMock, Uninitialize())
+		.Times(2)
+		.WillRepeatedly(Return(MSV_SUCCESS));
+
+	EXPECT_EQ(spDllModuleAdapter->Initialize(), MSV_SUCCESS);
+	EXPECT_EQ(spDllModuleAdapter->Uninitialize(), MSV_SUCCESS);
+	EXPECT_EQ(spDllModuleAdapter->Initialize(), MSV_SUCCESS);
+	EXPECT_EQ(spDllModuleAdapter->Uninitialize(), MSV_SUCCESS);
+}
+
+TEST_F(MsvDllObjectCache_Test, ItShouldLoadAgain_WhenAdapterInitializeFailed)
+{
+	std::shared_ptr<IMsvModule> spDllModuleAdapter(new (std::nothrow) MsvDllModuleAdapter(MSV_DYNAMIC_MODULE_ID, m_spDllFactoryMock, m_spLogger, m_spDllObjectCache));
+	EXPECT_NE(spDllModuleAdapter, nullptr);
+
+	//set dll factory (failed module is released from cache -> new module is loaded)
+	EXPECT_CALL(*m_spDllFactoryMock, GetDllObject(StrEq(MSV_DYNAMIC_MODULE_ID), _))
+		.WillOnce(DoAll(SetArgReferee<1>(m_spDynamicModuleMock), Return(MSV_SUCCESS)))
+		.WillOnce(DoAll(SetArgReferee<1>(m_spOtherDynamicModuleMock), Return(MSV_SUCCESS)));
+
+	//set dynamic module (its initialize fails)
+	EXPECT_CALL(*m_spDynamicModuleMock, SetDllFactory(Matcher<std::shared_ptr<IMsvDllFactory>>(m_spDllFactoryMock)));
+	EXPECT_CALL(*m_spDynamicModuleMock, Initialize())
+		.WillOnce(Return(MSV_NOT_INITIALIZED_ERROR));
+
+	//set other dynamic module (it is initialized and uninitialized)
+	EXPECT_CALL(*m_spOtherDynamicModuleMock, SetDllFactory(Matcher<std::shared_ptr<IMsvDllFactory>>(m_spDllFactoryMock)));
+	EXPECT_CALL(*m_spOtherDynamicModuleMock, Initialize())
+		.WillOnce(Return(MSV_SUCCESS));
+	EXPECT_CALL(*m_spOtherDynamicModuleMock, Initialized())
+		.WillRepeatedly(Return(true));
+	EXPECT_CALL(*m_spOtherDynamicModuleMock, Running())
+		.WillRepeatedly(Return(false));
+	EXPECT_CALL(*m_spOtherDynamicModuleMock, Uninitialize())
+		.WillOnce(Return(MSV_SUCCESS));
+
+	EXPECT_EQ(spDllModuleAdapter->Initialize(), MSV_NOT_INITIALIZED_ERROR);
+	EXPECT_EQ(spDllModuleAdapter->Initialize(), MSV_SUCCESS);
+	EXPECT_EQ(spDllModuleAdapter->Uninitialize(), MSV_SUCCESS);
+}
+
+TEST_F(MsvDllObjectCache_Test, ItShouldFailToInitialize_WhenOtherAdapterOwnsModule)
+{
+	std::shared_ptr<IMsvModule> spDllModuleAdapter(new (std::nothrow) MsvDllModuleAdapter(MSV_DYNAMIC_MODULE_ID, m_spDllFactoryMock, m_spLogger, m_spDllObjectCache));
+	EXPECT_NE(spDllModuleAdapter, nullptr);
+	std::shared_ptr<IMsvModule> spOtherDllModuleAdapter(new (std::nothrow) MsvDllModuleAdapter(MSV_DYNAMIC_MODULE_ID, m_spDllFactoryMock, m_spLogger, m_spDllObjectCache));
+	EXPECT_NE(spOtherDllModuleAdapter, nullptr);
+
+	//set dll factory (module of destroyed adapter is released -> new module is loaded for other adapter)
+	EXPECT_CALL(*m_spDllFactoryMock, GetDllObject(StrEq(MSV_DYNAMIC_MODULE_ID), _))
+		.WillOnce(DoAll(SetArgReferee<1>(m_spDynamicModuleMock), Return(MSV_SUCCESS)))
+		.WillOnce(DoAll(SetArgReferee<1>(m_spOtherDynamicModuleMock), Return(MSV_SUCCESS)));
+
+	//set dynamic module (it is initialized only by its adapter)
+	EXPECT_CALL(*m_spDynamicModuleMock, SetDllFactory(Matcher<std::shared_ptr<IMsvDllFactory>>(m_spDllFactoryMock)));
+	EXPECT_CALL(*m_spDynamicModuleMock, Initialize())
+		.WillOnce(Return(MSV_SUCCESS));
+	EXPECT_CALL(*m_spDynamicModuleMock, Initialized())
+		.WillRepeatedly(Return(true));
+	EXPECT_CALL(*m_spDynamicModuleMock, Running())
+		.WillRepeatedly(Return(false));
+	EXPECT_CALL(*m_spDynamicModuleMock, Uninitialize())
+		.WillOnce(Return(MSV_SUCCESS));
+
+	//set other dynamic module (it is initialized by other adapter)
+	EXPECT_CALL(*m_spOtherDynamicModuleMock, SetDllFactory(Matcher<std::shared_ptr<IMsvDllFactory>>(m_spDllFactoryMock)));
+	EXPECT_CALL(*m_spOtherDynamicModuleMock, Initialize())
+		.WillOnce(Return(MSV_SUCCESS));
+	EXPECT_CALL(*m_spOtherDynamicModuleMock, Initialized())
+		.WillRepeatedly(Return(true));
+	EXPECT_CALL(*m_spOtherDynamicModuleMock, Running())
+		.WillRepeatedly(Return(false));
+	EXPECT_CALL(*m_spOtherDynamicModuleMock, Uninitialize())
+		.WillOnce(Return(MSV_SUCCESS));
+
+	EXPECT_EQ(spDllModuleAdapter->Initialize(), MSV_SUCCESS);
+	EXPECT_EQ(spOtherDllModuleAdapter->Initialize(), MSV_ALREADY_EXISTS_ERROR);
+	EXPECT_FALSE(spOtherDllModuleAdapter->Initialized());
+
+	spDllModuleAdapter.reset();
+	EXPECT_EQ(spOtherDllModuleAdapter->Initialize(), MSV_SUCCESS);
+	EXPECT_EQ(spOtherDllModuleAdapter->Uninitialize(), MSV_SUCCESS);
+}
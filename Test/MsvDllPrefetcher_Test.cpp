@@ -0,0 +1,149 @@
+#include "pch.h"
+
+#include "mmodule/MsvDllModuleAdapter.h"
+#include "mmodule/MsvDllPrefetcher.h"
+#include "mmodule/MsvModuleManager.h"
+
+#include "mmodule/Mocks/MsvModuleConfigurator_Mock.h"
+#include "mdllfactory/Mocks/MsvDllFactory_Mock.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+MSV_ENABLE_WARNINGS
+
+
+using namespace ::testing;
+
+
+//prefetcher with access to its locked files
+class MsvDllPrefetcherTestWrapper:
+	public MsvDllPrefetcher
+{
+public:
+	MsvDllPrefetcherTestWrapper(MsvDllPrefetchMode mode, uint32_t maxThreads, std::shared_ptr<MsvLogger> spLogger):
+		MsvDllPrefetcher(mode, maxThreads, spLogger)
+	{
+
+	}
+
+	size_t GetLockedFileCount() const
+	{
+		std::lock_guard<std::recursive_mutex> lock(m_lock);
+
+		return m_lockedFiles.size();
+	}
+};
+
+
+//prefetcher which records prefetched files
+class MsvDllPrefetcher_Mock:
+	public MsvDllPrefetcher
+{
+public:
+	MOCK_METHOD1(Prefetch, MsvErrorCode(const std::vector<std::string>& dllPaths));
+};
+
+
+class MsvDllPrefetcher_Test:
+	public MsvModule_TestBase
+{
+public:
+	virtual void SetUp()
+	{
+		InitializeLogging();
+
+		//small file to prefetch (content does not matter)
+		m_filePath = "MsvDllPrefetcher_Test.bin";
+		std::ofstream file(m_filePath, std::ios::out | std::ios::binary | std::ios::trunc);
+		std::vector<char> content(16 * 1024, 'M');
+		file.write(content.data(), content.size());
+	}
+
+	virtual void TearDown()
+	{
+		std::remove(m_filePath.c_str());
+
+		UninitializeLogging();
+	}
+
+	std::string m_filePath;
+};
+
+
+TEST_F(MsvDllPrefetcher_Test, ItShouldSucceed_WhenNoFile)
+{
+	MsvDllPrefetcher prefetcher(MsvDllPrefetchMode::MSV_DLL_PREFETCH_READAHEAD, 0, m_spLogger);
+
+	EXPECT_EQ(prefetcher.Prefetch(std::vector<std::string>()), MSV_SUCCESS);
+}
+
+TEST_F(MsvDllPrefetcher_Test, ItShouldPrefetchFile_InAllModes)
+{
+	MsvDllPrefetchMode modes[] = { MsvDllPrefetchMode::MSV_DLL_PREFETCH_READAHEAD, MsvDllPrefetchMode::MSV_DLL_PREFETCH_PREFAULT, MsvDllPrefetchMode::MSV_DLL_PREFETCH_LOCK };
+	for (MsvDllPrefetchMode mode : modes)
+	{
+		MsvDllPrefetcher prefetcher(mode, 2, m_spLogger);
+		EXPECT_EQ(prefetcher.Prefetch(std::vector<std::string>{ m_filePath }), MSV_SUCCESS);
+	}
+}
+
+TEST_F(MsvDllPrefetcher_Test, ItShouldFail_WhenFileDoesNotExist)
+{
+	MsvDllPrefetcher prefetcher(MsvDllPrefetchMode::MSV_DLL_PREFETCH_PREFAULT, 2, m_spLogger);
+
+	//other files are prefetched anyway
+	EXPECT_EQ(prefetcher.Prefetch(std::vector<std::string>{ m_filePath, "MsvDllPrefetcher_Test.missing" }), MSV_NOT_FOUND_ERROR);
+}
+
+TEST_F(MsvDllPrefetcher_Test, ItShouldLockFileOnce_WhenPrefetchedRepeatedly)
+{
+	MsvDllPrefetcherTestWrapper prefetcher(MsvDllPrefetchMode::MSV_DLL_PREFETCH_LOCK, 1, m_spLogger);
+
+	//lock can fail (memlock limit, not supported on Windows) -> file is prefaulted only
+	EXPECT_EQ(prefetcher.Prefetch(std::vector<std::string>{ m_filePath }), MSV_SUCCESS);
+	size_t lockedFileCount = prefetcher.GetLockedFileCount();
+	EXPECT_LE(lockedFileCount, 1u);
+
+	EXPECT_EQ(prefetcher.Prefetch(std::vector<std::string>{ m_filePath }), MSV_SUCCESS);
+	EXPECT_EQ(prefetcher.GetLockedFileCount(), lockedFileCount);
+
+	prefetcher.Unlock();
+	EXPECT_EQ(prefetcher.GetLockedFileCount(), 0u);
+}
+
+TEST_F(MsvDllPrefetcher_Test, ItShouldPrefetchOnlyOnInitialize_WhenSetToModuleManager)
+{
+	MsvModuleManager moduleManager(m_spLogger);
+	std::shared_ptr<MsvDllFactory_Mock> spDllFactoryMock(new (std::nothrow) MsvDllFactory_Mock());
+	EXPECT_NE(spDllFactoryMock, nullptr);
+	std::shared_ptr<MsvDllModuleAdapter> spDllModuleAdapter(new (std::nothrow) MsvDllModuleAdapter(MSV_DYNAMIC_MODULE_ID, spDllFactoryMock, m_spLogger));
+	EXPECT_NE(spDllModuleAdapter, nullptr);
+	std::shared_ptr<MsvModuleConfigurator_Mock> spModuleConfiguratorMock(new (std::nothrow) MsvModuleConfigurator_Mock());
+	EXPECT_NE(spModuleConfiguratorMock, nullptr);
+	std::shared_ptr<MsvDllPrefetcher_Mock> spDllPrefetcherMock(new (std::nothrow) MsvDllPrefetcher_Mock());
+	EXPECT_NE(spDllPrefetcherMock, nullptr);
+
+	//module is not installed (it is not loaded) - its DLL is prefetched anyway
+	EXPECT_CALL(*spModuleConfiguratorMock, IsInstalled(Matcher<bool&>(_)))
+		.WillRepeatedly(DoAll(SetArgReferee<0>(false), Return(MSV_SUCCESS)));
+	EXPECT_CALL(*spModuleConfiguratorMock, IsEnabled(Matcher<bool&>(_)))
+		.WillRepeatedly(DoAll(SetArgReferee<0>(false), Return(MSV_SUCCESS)));
+
+	//DLL is prefetched once (uninitialize does not prefetch)
+	std::vector<std::string> dllPaths;
+	EXPECT_CALL(*spDllPrefetcherMock, Prefetch(_))
+		.WillOnce(DoAll(SaveArg<0>(&dllPaths), Return(MSV_SUCCESS)));
+
+	spDllModuleAdapter->SetDllPath(m_filePath.c_str());
+	moduleManager.SetDllPrefetcher(spDllPrefetcherMock);
+	EXPECT_EQ(moduleManager.AddModule(static_cast<int32_t>(ModuleId::MSV_TEST_DYNAMIC_MODULE), spDllModuleAdapter, spModuleConfiguratorMock), MSV_SUCCESS);
+
+	EXPECT_EQ(moduleManager.Initialize(), MSV_SUCCESS);
+	EXPECT_EQ(dllPaths, std::vector<std::string>{ m_filePath });
+	EXPECT_EQ(moduleManager.Uninitialize(), MSV_SUCCESS);
+}
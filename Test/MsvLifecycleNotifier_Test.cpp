@@ -0,0 +1,236 @@
+
+
+#include "pch.h"
+
+#include "mmodule/MsvLifecycleNotifier.h"
+#include "mmodule/MsvModuleLifecycle.h"
+#include "mmodule/MsvModuleManager.h"
+
+#include "mmodule/Mocks/MsvModuleConfigurator_Mock.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+MSV_ENABLE_WARNINGS
+
+
+using namespace ::testing;
+
+
+//observer which collects events (it can be blocked to simulate slow observer)
+class MsvTestLifecycleObserver:
+	public IMsvLifecycleObserver
+{
+public:
+	MsvTestLifecycleObserver():
+		m_blocked(false),
+		m_maxBatchSize(0)
+	{
+
+	}
+
+	virtual void OnLifecycleEvents(const MsvLifecycleEvent* pEvents, size_t count) override
+	{
+		std::unique_lock<std::mutex> lock(m_lock);
+
+		m_condition.wait(lock, [this]() { return !m_blocked; });
+
+		m_events.insert(m_events.end(), pEvents, pEvents + count);
+		m_maxBatchSize = std::max(m_maxBatchSize, count);
+		m_condition.notify_all();
+	}
+
+	bool WaitForEvents(size_t count)
+	{
+		std::unique_lock<std::mutex> lock(m_lock);
+		return m_condition.wait_for(lock, std::chrono::seconds(10), [this, count]() { return m_events.size() >= count; });
+	}
+
+	void Block(bool blocked)
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+		m_blocked = blocked;
+		m_condition.notify_all();
+	}
+
+	std::mutex m_lock;
+	std::condition_variable m_condition;
+	std::vector<MsvLifecycleEvent> m_events;
+	bool m_blocked;
+	size_t m_maxBatchSize;
+};
+
+
+class MsvTestLifecycleModule:
+	public MsvModuleLifecycle<MsvTestLifecycleModule, MsvModuleBase>
+{
+public:
+	MsvTestLifecycleModule(std::shared_ptr<IMsvLoggerProvider> spLoggerProvider):
+		MsvModuleLifecycle(spLoggerProvider, "MsvLifecycleNotifier_Test")
+	{
+
+	}
+};
+
+
+class MsvLifecycleNotifier_Test:
+	public MsvModule_TestBase
+{
+public:
+	virtual void SetUp()
+	{
+		InitializeLogging();
+
+		m_spObserver.reset(new (std::nothrow) MsvTestLifecycleObserver());
+		EXPECT_NE(m_spObserver, nullptr);
+	}
+
+	virtual void TearDown()
+	{
+		m_spObserver.reset();
+
+		UninitializeLogging();
+	}
+
+	MsvLifecycleEvent CreateEvent(int32_t moduleId)
+	{
+		MsvLifecycleEvent event;
+		event.moduleId = moduleId;
+		event.transition = MsvModuleTransition::MSV_MODULE_TRANSITION_START;
+		event.oldState = MsvModuleState::MSV_MODULE_STATE_INITIALIZED;
+		event.newState = MsvModuleState::MSV_MODULE_STATE_RUNNING;
+		event.errorCode = MSV_SUCCESS;
+		event.duration = std::chrono::nanoseconds(moduleId);
+
+		return event;
+	}
+
+	//tested classes
+	std::shared_ptr<MsvTestLifecycleObserver> m_spObserver;
+};
+
+
+/*-----------------------------------------------------------------------------------------------------
+**											Lifecycle Notifier Tests
+**---------------------------------------------------------------------------------------------------*/
+
+
+TEST_F(MsvLifecycleNotifier_Test, ItShouldFail_WhenObserverIsInvalid)
+{
+	MsvLifecycleNotifier notifier;
+
+	EXPECT_EQ(notifier.Subscribe(nullptr), MSV_INVALID_DATA_ERROR);
+	EXPECT_EQ(notifier.Unsubscribe(m_spObserver), MSV_NOT_FOUND_ERROR);
+	EXPECT_EQ(notifier.Subscribe(m_spObserver), MSV_SUCCESS);
+	EXPECT_EQ(notifier.Subscribe(m_spObserver), MSV_ALREADY_EXISTS_ERROR);
+	EXPECT_EQ(notifier.Unsubscribe(m_spObserver), MSV_SUCCESS);
+	EXPECT_EQ(notifier.Unsubscribe(m_spObserver), MSV_NOT_FOUND_ERROR);
+}
+
+TEST_F(MsvLifecycleNotifier_Test, ItShouldDeliverEventsInOrderAndInBatches_WhenObserverIsSubscribed)
+{
+	MsvLifecycleNotifier notifier;
+
+	//events without observer are not queued
+	notifier.Publish(CreateEvent(0));
+
+	EXPECT_EQ(notifier.Subscribe(m_spObserver), MSV_SUCCESS);
+	m_spObserver->Block(true);
+	for (int32_t i = 1; i <= 200; ++i)
+	{
+		notifier.Publish(CreateEvent(i));
+	}
+
+	m_spObserver->Block(false);
+	EXPECT_TRUE(m_spObserver->WaitForEvents(200));
+
+	std::lock_guard<std::mutex> lock(m_spObserver->m_lock);
+	EXPECT_EQ(m_spObserver->m_events.size(), 200u);
+	for (size_t i = 0; i < m_spObserver->m_events.size(); ++i)
+	{
+		EXPECT_EQ(m_spObserver->m_events[i].moduleId, static_cast<int32_t>(i + 1));
+	}
+
+	EXPECT_GT(m_spObserver->m_maxBatchSize, 1u);
+	EXPECT_LE(m_spObserver->m_maxBatchSize, MSV_LIFECYCLE_EVENT_BATCH_SIZE);
+	EXPECT_EQ(notifier.GetDroppedCount(), 0u);
+}
+
+TEST_F(MsvLifecycleNotifier_Test, ItShouldNotBlockPublisher_WhenObserverIsSlow)
+{
+	MsvLifecycleNotifier notifier(4);
+	EXPECT_EQ(notifier.Subscribe(m_spObserver), MSV_SUCCESS);
+
+	//notifier thread is blocked in observer with the first event
+	m_spObserver->Block(true);
+	notifier.Publish(CreateEvent(1));
+	std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+	for (int32_t i = 2; i <= 20; ++i)
+	{
+		notifier.Publish(CreateEvent(i));
+	}
+
+	EXPECT_GT(notifier.GetDroppedCount(), 0u);
+	m_spObserver->Block(false);
+}
+
+TEST_F(MsvLifecycleNotifier_Test, ItShouldDispatchQueuedEvents_WhenNotifierIsDestroyed)
+{
+	{
+		MsvLifecycleNotifier notifier;
+		EXPECT_EQ(notifier.Subscribe(m_spObserver), MSV_SUCCESS);
+
+		m_spObserver->Block(true);
+		notifier.Publish(CreateEvent(1));
+		notifier.Publish(CreateEvent(2));
+		m_spObserver->Block(false);
+	}
+
+	std::lock_guard<std::mutex> lock(m_spObserver->m_lock);
+	EXPECT_EQ(m_spObserver->m_events.size(), 2u);
+}
+
+TEST_F(MsvLifecycleNotifier_Test, ItShouldPublishTransitions_WhenModuleManagerChangesModuleState)
+{
+	MsvModuleManager moduleManager(m_spLogger);
+	EXPECT_EQ(moduleManager.GetLifecycleNotifier()->Subscribe(m_spObserver), MSV_SUCCESS);
+
+	std::shared_ptr<MsvTestLifecycleModule> spModule(new (std::nothrow) MsvTestLifecycleModule(m_spLoggerProvider));
+	EXPECT_NE(spModule, nullptr);
+	std::shared_ptr<MsvModuleConfigurator_Mock> spModuleConfiguratorMock(new (std::nothrow) MsvModuleConfigurator_Mock());
+	EXPECT_NE(spModuleConfiguratorMock, nullptr);
+
+	EXPECT_CALL(*spModuleConfiguratorMock, IsInstalled(Matcher<bool&>(_)))
+		.WillRepeatedly(DoAll(SetArgReferee<0>(true), Return(MSV_SUCCESS)));
+	EXPECT_CALL(*spModuleConfiguratorMock, IsEnabled(Matcher<bool&>(_)))
+		.WillRepeatedly(DoAll(SetArgReferee<0>(true), Return(MSV_SUCCESS)));
+
+	int32_t moduleId = static_cast<int32_t>(ModuleId::MSV_TEST_STATIC_MODULE);
+	EXPECT_EQ(moduleManager.AddModule(moduleId, spModule, spModuleConfiguratorMock), MSV_SUCCESS);
+	EXPECT_EQ(moduleManager.Initialize(), MSV_SUCCESS);
+	EXPECT_EQ(moduleManager.Start(), MSV_SUCCESS);
+	EXPECT_EQ(moduleManager.Stop(), MSV_SUCCESS);
+	EXPECT_EQ(moduleManager.Uninitialize(), MSV_SUCCESS);
+
+	EXPECT_TRUE(m_spObserver->WaitForEvents(4));
+
+	std::lock_guard<std::mutex> lock(m_spObserver->m_lock);
+	ASSERT_EQ(m_spObserver->m_events.size(), 4u);
+
+	const MsvModuleState states[] = { MsvModuleState::MSV_MODULE_STATE_UNINITIALIZED, MsvModuleState::MSV_MODULE_STATE_INITIALIZED, MsvModuleState::MSV_MODULE_STATE_RUNNING, MsvModuleState::MSV_MODULE_STATE_INITIALIZED, MsvModuleState::MSV_MODULE_STATE_UNINITIALIZED };
+	for (size_t i = 0; i < 4; ++i)
+	{
+		EXPECT_EQ(m_spObserver->m_events[i].moduleId, moduleId);
+		EXPECT_EQ(m_spObserver->m_events[i].transition, static_cast<MsvModuleTransition>(i));
+		EXPECT_EQ(m_spObserver->m_events[i].oldState, states[i]);
+		EXPECT_EQ(m_spObserver->m_events[i].newState, states[i + 1]);
+		EXPECT_EQ(m_spObserver->m_events[i].errorCode, MSV_SUCCESS);
+	}
+}
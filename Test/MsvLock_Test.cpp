@@ -0,0 +1,211 @@
+
+
+#include "pch.h"
+
+#include "mmodule/MsvLock.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <atomic>
+#include <cstring>
+#include <thread>
+
+MSV_ENABLE_WARNINGS
+
+
+using namespace ::testing;
+
+
+const char* const MSV_TEST_LOCK_OUTER_SITE = "MsvLock_Test::Outer";
+const char* const MSV_TEST_LOCK_INNER_SITE = "MsvLock_Test::Inner";
+
+
+class MsvLock_Test:
+	public MsvModule_TestBase
+{
+public:
+	virtual void SetUp()
+	{
+		MsvLockStatistics::Reset();
+	}
+
+	virtual void TearDown()
+	{
+		MsvLockStatistics::Reset();
+	}
+
+	//returns statistics of call site (zeroed when call site has not been recorded)
+	static MsvLockSiteStatistics GetSiteStatistics(const char* callSite)
+	{
+		std::vector<MsvLockSiteStatistics> statistics;
+		MsvLockStatistics::GetStatistics(statistics);
+
+		for (std::vector<MsvLockSiteStatistics>::const_iterator it = statistics.begin(); it != statistics.end(); ++it)
+		{
+			if (std::strcmp(it->callSite, callSite) == 0)
+			{
+				return *it;
+			}
+		}
+
+		MsvLockSiteStatistics site = {};
+		return site;
+	}
+
+	//tested classes
+	MsvInstrumentedRecursiveMutex m_mutex;
+};
+
+
+/*-----------------------------------------------------------------------------------------------------
+**											Instrumented Mutex Tests
+**---------------------------------------------------------------------------------------------------*/
+
+
+TEST_F(MsvLock_Test, ItShouldRecordHoldTime_WhenLockIsNotContended)
+{
+	m_mutex.lock(MSV_TEST_LOCK_OUTER_SITE);
+	std::this_thread::sleep_for(std::chrono::milliseconds(5));
+	m_mutex.unlock();
+
+	MsvLockSiteStatistics site = GetSiteStatistics(MSV_TEST_LOCK_OUTER_SITE);
+	EXPECT_EQ(site.acquisitions, 1u);
+	EXPECT_EQ(site.contentions, 0u);
+	EXPECT_EQ(site.recursions, 0u);
+	EXPECT_EQ(site.totalWait, std::chrono::nanoseconds::zero());
+	EXPECT_GE(site.totalHold, std::chrono::milliseconds(5));
+	EXPECT_EQ(site.maxHold, site.totalHold);
+}
+
+TEST_F(MsvLock_Test, ItShouldAttributeHoldTimeToOutermostSite_WhenLockIsRecursive)
+{
+	m_mutex.lock(MSV_TEST_LOCK_OUTER_SITE);
+	m_mutex.lock(MSV_TEST_LOCK_INNER_SITE);
+	m_mutex.unlock();
+	m_mutex.unlock();
+
+	MsvLockSiteStatistics outerSite = GetSiteStatistics(MSV_TEST_LOCK_OUTER_SITE);
+	EXPECT_EQ(outerSite.acquisitions, 1u);
+	EXPECT_EQ(outerSite.recursions, 0u);
+
+	MsvLockSiteStatistics innerSite = GetSiteStatistics(MSV_TEST_LOCK_INNER_SITE);
+	EXPECT_EQ(innerSite.acquisitions, 0u);
+	EXPECT_EQ(innerSite.recursions, 1u);
+	EXPECT_EQ(innerSite.totalHold, std::chrono::nanoseconds::zero());
+}
+
+TEST_F(MsvLock_Test, ItShouldRecordWaitTime_WhenLockIsOwnedByOtherThread)
+{
+	std::atomic<bool> locked(false);
+	std::thread owner([this, &locked]()
+	{
+		m_mutex.lock(MSV_TEST_LOCK_OUTER_SITE);
+		locked = true;
+		std::this_thread::sleep_for(std::chrono::milliseconds(20));
+		m_mutex.unlock();
+	});
+
+	while (!locked)
+	{
+		std::this_thread::yield();
+	}
+
+	m_mutex.lock(MSV_TEST_LOCK_INNER_SITE);
+	m_mutex.unlock();
+	owner.join();
+
+	MsvLockSiteStatistics site = GetSiteStatistics(MSV_TEST_LOCK_INNER_SITE);
+	EXPECT_EQ(site.acquisitions, 1u);
+	EXPECT_EQ(site.contentions, 1u);
+	EXPECT_GT(site.totalWait, std::chrono::nanoseconds::zero());
+	EXPECT_EQ(site.maxWait, site.totalWait);
+
+	//statistics of exited thread are kept
+	EXPECT_EQ(GetSiteStatistics(MSV_TEST_LOCK_OUTER_SITE).acquisitions, 1u);
+}
+
+TEST_F(MsvLock_Test, ItShouldNotLock_WhenTryLockAndLockIsOwnedByOtherThread)
+{
+	m_mutex.lock(MSV_TEST_LOCK_OUTER_SITE);
+
+	bool acquired = true;
+	std::thread other([this, &acquired]()
+	{
+		acquired = m_mutex.try_lock(MSV_TEST_LOCK_INNER_SITE);
+	});
+	other.join();
+
+	m_mutex.unlock();
+
+	EXPECT_FALSE(acquired);
+	EXPECT_EQ(GetSiteStatistics(MSV_TEST_LOCK_INNER_SITE).acquisitions, 0u);
+}
+
+TEST_F(MsvLock_Test, ItShouldAggregateThreads_WhenSameSiteIsLockedFromMoreThreads)
+{
+	std::vector<std::thread> threads;
+	for (int i = 0; i < 4; ++i)
+	{
+		threads.emplace_back([this]()
+		{
+			for (int j = 0; j < 100; ++j)
+			{
+				m_mutex.lock(MSV_TEST_LOCK_OUTER_SITE);
+				m_mutex.unlock();
+			}
+		});
+	}
+
+	for (std::vector<std::thread>::iterator it = threads.begin(); it != threads.end(); ++it)
+	{
+		it->join();
+	}
+
+	EXPECT_EQ(GetSiteStatistics(MSV_TEST_LOCK_OUTER_SITE).acquisitions, 400u);
+}
+
+TEST_F(MsvLock_Test, ItShouldBeEmpty_AfterReset)
+{
+	m_mutex.lock(MSV_TEST_LOCK_OUTER_SITE);
+	m_mutex.unlock();
+
+	MsvLockStatistics::Reset();
+
+	std::vector<MsvLockSiteStatistics> statistics;
+	MsvLockStatistics::GetStatistics(statistics);
+	EXPECT_TRUE(statistics.empty());
+}
+
+
+/*-----------------------------------------------------------------------------------------------------
+**											Lock Guard Tests
+**---------------------------------------------------------------------------------------------------*/
+
+
+TEST_F(MsvLock_Test, ItShouldUnlock_WhenLockGuardIsDestroyed)
+{
+	MsvRecursiveMutex mutex;
+	{
+		MsvLockGuard lock(mutex, MSV_LOCK_CALL_SITE);
+	}
+
+	//other thread can lock it
+	bool acquired = false;
+	std::thread other([&mutex, &acquired]()
+	{
+		acquired = mutex.try_lock();
+		if (acquired)
+		{
+			mutex.unlock();
+		}
+	});
+	other.join();
+
+	EXPECT_TRUE(acquired);
+#if MSV_LOCK_INSTRUMENTATION != 0
+	EXPECT_EQ(GetSiteStatistics(MSV_LOCK_CALL_SITE).acquisitions, 1u);
+#else
+	//not instrumented -> nothing is recorded
+	EXPECT_EQ(GetSiteStatistics(MSV_LOCK_CALL_SITE).acquisitions, 0u);
+#endif
+}
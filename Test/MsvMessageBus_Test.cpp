@@ -0,0 +1,349 @@
+
+
+#include "pch.h"
+
+#include "mmodule/MsvMessageBus.h"
+#include "mmodule/MsvModuleLifecycle.h"
+#include "mmodule/MsvModuleManager.h"
+#include "mmodule/MsvRingBuffer.h"
+
+#include "mmodule/Mocks/MsvModuleConfigurator_Mock.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+MSV_ENABLE_WARNINGS
+
+
+using namespace ::testing;
+
+
+//module which keeps message bus set by module manager
+class MsvTestMessageBusModule:
+	public MsvModuleLifecycle<MsvTestMessageBusModule, MsvModuleBase>
+{
+public:
+	MsvTestMessageBusModule(std::shared_ptr<IMsvLoggerProvider> spLoggerProvider):
+		MsvModuleLifecycle(spLoggerProvider, "MsvMessageBus_Test")
+	{
+
+	}
+
+	std::shared_ptr<MsvMessageBus> GetMessageBus() const
+	{
+		return m_spMessageBus;
+	}
+};
+
+
+class MsvMessageBus_Test:
+	public MsvModule_TestBase
+{
+public:
+	virtual void SetUp()
+	{
+		InitializeLogging();
+	}
+
+	virtual void TearDown()
+	{
+		UninitializeLogging();
+	}
+
+	//sends count messages from producerCount threads and checks every message is received exactly once (in order of producer)
+	void SendFromMoreThreads(MsvMessageQueue& queue, int32_t producerCount, int32_t count)
+	{
+		std::vector<std::thread> producers;
+		for (int32_t producer = 0; producer < producerCount; ++producer)
+		{
+			producers.push_back(std::thread([&queue, producer, count]()
+			{
+				for (int32_t i = 0; i < count; ++i)
+				{
+					while (queue.Send(MsvMessage(producer, i)) == MSV_ALLOCATION_ERROR)
+					{
+						std::this_thread::yield();
+					}
+				}
+			}));
+		}
+
+		std::vector<int32_t> nextTypes(producerCount, 0);
+		int32_t received = 0;
+		MsvMessage messages[16];
+		while (received < producerCount * count)
+		{
+			size_t receivedCount = queue.WaitReceive(messages, 16, std::chrono::milliseconds(100));
+			for (size_t i = 0; i < receivedCount; ++i)
+			{
+				EXPECT_EQ(messages[i].messageType, nextTypes[messages[i].senderId]++);
+			}
+
+			received += static_cast<int32_t>(receivedCount);
+		}
+
+		for (std::vector<std::thread>::iterator it = producers.begin(); it != producers.end(); ++it)
+		{
+			it->join();
+		}
+
+		EXPECT_EQ(queue.Receive(messages, 16), 0u);
+	}
+};
+
+
+/*-----------------------------------------------------------------------------------------------------
+**											Ring Buffer Tests
+**---------------------------------------------------------------------------------------------------*/
+
+
+TEST_F(MsvMessageBus_Test, ItShouldRoundCapacityToPowerOfTwo)
+{
+	EXPECT_EQ(MsvGetRingBufferCapacity(0), 2u);
+	EXPECT_EQ(MsvGetRingBufferCapacity(3), 4u);
+	EXPECT_EQ(MsvGetRingBufferCapacity(64), 64u);
+
+	MsvSpscRingBuffer<int> spscRingBuffer(100);
+	MsvMpscRingBuffer<int> mpscRingBuffer(100);
+	EXPECT_EQ(spscRingBuffer.GetCapacity(), 128u);
+	EXPECT_EQ(mpscRingBuffer.GetCapacity(), 128u);
+}
+
+TEST_F(MsvMessageBus_Test, ItShouldPushUntilFull_WhenSpscRingBufferIsUsed)
+{
+	MsvSpscRingBuffer<int> ringBuffer(4);
+	EXPECT_TRUE(ringBuffer.Empty());
+
+	int items[6] = { 1, 2, 3, 4, 5, 6 };
+	EXPECT_EQ(ringBuffer.PushBatch(items, 6), 4u);
+	EXPECT_FALSE(ringBuffer.Push(7));
+	EXPECT_FALSE(ringBuffer.Empty());
+
+	int item = 0;
+	EXPECT_TRUE(ringBuffer.Pop(item));
+	EXPECT_EQ(item, 1);
+	EXPECT_TRUE(ringBuffer.Push(5));
+
+	int poppedItems[8] = {};
+	EXPECT_EQ(ringBuffer.PopBatch(poppedItems, 8), 4u);
+	EXPECT_EQ(poppedItems[0], 2);
+	EXPECT_EQ(poppedItems[3], 5);
+	EXPECT_TRUE(ringBuffer.Empty());
+	EXPECT_FALSE(ringBuffer.Pop(item));
+}
+
+TEST_F(MsvMessageBus_Test, ItShouldPushUntilFull_WhenMpscRingBufferIsUsed)
+{
+	MsvMpscRingBuffer<int> ringBuffer(4);
+	EXPECT_TRUE(ringBuffer.Empty());
+
+	int items[6] = { 1, 2, 3, 4, 5, 6 };
+	EXPECT_EQ(ringBuffer.PushBatch(items, 3), 3u);
+	EXPECT_TRUE(ringBuffer.Push(4));
+	EXPECT_FALSE(ringBuffer.Push(5));
+	EXPECT_EQ(ringBuffer.PushBatch(items + 4, 2), 0u);
+
+	int poppedItems[8] = {};
+	EXPECT_EQ(ringBuffer.PopBatch(poppedItems, 2), 2u);
+	EXPECT_EQ(poppedItems[0], 1);
+	EXPECT_EQ(poppedItems[1], 2);
+	EXPECT_EQ(ringBuffer.PushBatch(items + 4, 2), 2u);
+
+	EXPECT_EQ(ringBuffer.PopBatch(poppedItems, 8), 4u);
+	EXPECT_EQ(poppedItems[0], 3);
+	EXPECT_EQ(poppedItems[3], 6);
+	EXPECT_TRUE(ringBuffer.Empty());
+}
+
+/*-----------------------------------------------------------------------------------------------------
+**											Message Queue Tests
+**---------------------------------------------------------------------------------------------------*/
+
+
+TEST_F(MsvMessageBus_Test, ItShouldReceiveAllMessages_WhenMoreProducersSend)
+{
+	MsvMessageQueue queue(64, false);
+	SendFromMoreThreads(queue, 4, 10000);
+}
+
+TEST_F(MsvMessageBus_Test, ItShouldReceiveAllMessages_WhenSingleProducerSends)
+{
+	MsvMessageQueue queue(64, true);
+	SendFromMoreThreads(queue, 1, 10000);
+}
+
+TEST_F(MsvMessageBus_Test, ItShouldSendPartOfBatch_WhenQueueIsFull)
+{
+	MsvMessageQueue queue(4, false);
+
+	MsvMessage messages[6];
+	size_t sentCount = 0;
+	EXPECT_EQ(queue.SendBatch(messages, 6, sentCount), MSV_SUCCESS);
+	EXPECT_EQ(sentCount, 4u);
+	EXPECT_EQ(queue.SendBatch(messages, 2, sentCount), MSV_ALLOCATION_ERROR);
+	EXPECT_EQ(sentCount, 0u);
+	EXPECT_EQ(queue.Send(MsvMessage(1, 1)), MSV_ALLOCATION_ERROR);
+
+	EXPECT_EQ(queue.Receive(messages, 6), 4u);
+	EXPECT_EQ(queue.SendBatch(messages, 2, sentCount), MSV_SUCCESS);
+	EXPECT_EQ(sentCount, 2u);
+}
+
+TEST_F(MsvMessageBus_Test, ItShouldWakeConsumer_WhenMessageIsSent)
+{
+	MsvMessageQueue queue(16, false);
+
+	std::thread producer([&queue]()
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(50));
+		EXPECT_EQ(queue.Send(MsvMessage(1, 2)), MSV_SUCCESS);
+	});
+
+	MsvMessage message;
+	EXPECT_EQ(queue.WaitReceive(&message, 1, std::chrono::seconds(10)), 1u);
+	EXPECT_EQ(message.senderId, 1);
+	EXPECT_EQ(message.messageType, 2);
+
+	producer.join();
+}
+
+TEST_F(MsvMessageBus_Test, ItShouldWaitWithoutTimeout_WhenTimeoutIsMax)
+{
+	MsvMessageQueue queue(16, false);
+
+	//deadline does not overflow (consumer would return immediately)
+	std::thread producer([&queue]()
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(50));
+		EXPECT_EQ(queue.Send(MsvMessage(1, 2)), MSV_SUCCESS);
+	});
+
+	MsvMessage message;
+	EXPECT_EQ(queue.WaitReceive(&message, 1, std::chrono::milliseconds::max()), 1u);
+	EXPECT_EQ(message.messageType, 2);
+
+	producer.join();
+}
+
+TEST_F(MsvMessageBus_Test, ItShouldTimeout_WhenNoMessageIsSent)
+{
+	MsvMessageQueue queue(16, false);
+
+	MsvMessage message;
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	EXPECT_EQ(queue.WaitReceive(&message, 1, std::chrono::milliseconds(50)), 0u);
+	EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(50));
+}
+
+TEST_F(MsvMessageBus_Test, ItShouldRejectMessagesAndReleasePayloads_WhenQueueIsClosed)
+{
+	MsvMessageQueue queue(16, false);
+
+	std::shared_ptr<int> spPayload(new (std::nothrow) int(5));
+	EXPECT_NE(spPayload, nullptr);
+	EXPECT_EQ(queue.Send(MsvMessage(1, 1, spPayload)), MSV_SUCCESS);
+	EXPECT_EQ(spPayload.use_count(), 2);
+
+	queue.Close();
+	EXPECT_TRUE(queue.Closed());
+	EXPECT_EQ(spPayload.use_count(), 1);
+	EXPECT_EQ(queue.Send(MsvMessage(1, 1)), MSV_NOT_INITIALIZED_ERROR);
+
+	MsvMessage message;
+	EXPECT_EQ(queue.WaitReceive(&message, 1, std::chrono::seconds(10)), 0u);
+}
+
+/*-----------------------------------------------------------------------------------------------------
+**											Message Bus Tests
+**---------------------------------------------------------------------------------------------------*/
+
+
+TEST_F(MsvMessageBus_Test, ItShouldAddressQueueByModuleId)
+{
+	MsvMessageBus messageBus;
+	int32_t moduleId = static_cast<int32_t>(ModuleId::MSV_TEST_STATIC_MODULE);
+
+	std::shared_ptr<MsvMessageQueue> spQueue;
+	EXPECT_EQ(messageBus.GetQueue(moduleId, spQueue), MSV_NOT_FOUND_ERROR);
+	EXPECT_EQ(messageBus.Send(moduleId, MsvMessage(1, 1)), MSV_NOT_FOUND_ERROR);
+
+	EXPECT_EQ(messageBus.SetQueueOptions(moduleId, 0, true), MSV_INVALID_DATA_ERROR);
+	EXPECT_EQ(messageBus.SetQueueOptions(moduleId, 8, true), MSV_SUCCESS);
+	EXPECT_EQ(messageBus.CreateQueue(moduleId), MSV_SUCCESS);
+	EXPECT_EQ(messageBus.CreateQueue(moduleId), MSV_ALREADY_EXISTS_ERROR);
+	EXPECT_EQ(messageBus.GetQueue(moduleId, spQueue), MSV_SUCCESS);
+	EXPECT_EQ(spQueue->GetCapacity(), 8u);
+
+	MsvMessage messages[2] = { MsvMessage(1, 1), MsvMessage(1, 2) };
+	size_t sentCount = 0;
+	EXPECT_EQ(messageBus.Send(moduleId, MsvMessage(1, 0)), MSV_SUCCESS);
+	EXPECT_EQ(messageBus.SendBatch(moduleId, messages, 2, sentCount), MSV_SUCCESS);
+	EXPECT_EQ(sentCount, 2u);
+	EXPECT_EQ(spQueue->Receive(messages, 2), 2u);
+	EXPECT_EQ(spQueue->Receive(messages, 2), 1u);
+	EXPECT_EQ(messages[0].messageType, 2);
+
+	//cached handle is closed and opened with queue
+	EXPECT_EQ(messageBus.CloseQueue(moduleId), MSV_SUCCESS);
+	EXPECT_TRUE(spQueue->Closed());
+	EXPECT_EQ(messageBus.Send(moduleId, MsvMessage(1, 1)), MSV_NOT_INITIALIZED_ERROR);
+	EXPECT_EQ(messageBus.OpenQueue(moduleId), MSV_SUCCESS);
+	EXPECT_FALSE(spQueue->Closed());
+	EXPECT_EQ(spQueue->Send(MsvMessage(1, 3)), MSV_SUCCESS);
+	EXPECT_EQ(spQueue->Receive(messages, 2), 1u);
+	EXPECT_EQ(messages[0].messageType, 3);
+
+	//cached handle is closed when queue is removed
+	EXPECT_EQ(messageBus.RemoveQueue(moduleId), MSV_SUCCESS);
+	EXPECT_EQ(messageBus.RemoveQueue(moduleId), MSV_NOT_FOUND_ERROR);
+	EXPECT_TRUE(spQueue->Closed());
+	EXPECT_EQ(spQueue->Send(MsvMessage(1, 1)), MSV_NOT_INITIALIZED_ERROR);
+	EXPECT_EQ(messageBus.CloseQueue(moduleId), MSV_NOT_FOUND_ERROR);
+	EXPECT_EQ(messageBus.OpenQueue(moduleId), MSV_NOT_FOUND_ERROR);
+}
+
+TEST_F(MsvMessageBus_Test, ItShouldCloseAndOpenQueue_WhenModuleIsManaged)
+{
+	MsvModuleManager moduleManager(m_spLogger);
+	std::shared_ptr<MsvMessageBus> spMessageBus = moduleManager.GetMessageBus();
+	EXPECT_NE(spMessageBus, nullptr);
+
+	std::shared_ptr<MsvTestMessageBusModule> spModule(new (std::nothrow) MsvTestMessageBusModule(m_spLoggerProvider));
+	EXPECT_NE(spModule, nullptr);
+	std::shared_ptr<MsvModuleConfigurator_Mock> spModuleConfiguratorMock(new (std::nothrow) MsvModuleConfigurator_Mock());
+	EXPECT_NE(spModuleConfiguratorMock, nullptr);
+
+	EXPECT_CALL(*spModuleConfiguratorMock, IsInstalled(Matcher<bool&>(_)))
+		.WillRepeatedly(DoAll(SetArgReferee<0>(true), Return(MSV_SUCCESS)));
+	EXPECT_CALL(*spModuleConfiguratorMock, IsEnabled(Matcher<bool&>(_)))
+		.WillRepeatedly(DoAll(SetArgReferee<0>(true), Return(MSV_SUCCESS)));
+
+	//queue is created when module is registered
+	int32_t moduleId = static_cast<int32_t>(ModuleId::MSV_TEST_STATIC_MODULE);
+	EXPECT_EQ(moduleManager.AddModule(moduleId, spModule, spModuleConfiguratorMock), MSV_SUCCESS);
+	std::shared_ptr<MsvMessageQueue> spQueue;
+	EXPECT_EQ(spMessageBus->GetQueue(moduleId, spQueue), MSV_SUCCESS);
+
+	EXPECT_EQ(moduleManager.Initialize(), MSV_SUCCESS);
+	EXPECT_EQ(spModule->GetMessageBus(), spMessageBus);
+	EXPECT_EQ(moduleManager.Start(), MSV_SUCCESS);
+	EXPECT_EQ(spMessageBus->Send(moduleId, MsvMessage(1, 1)), MSV_SUCCESS);
+
+	//queue is closed when module stops
+	EXPECT_EQ(moduleManager.Stop(), MSV_SUCCESS);
+	EXPECT_TRUE(spQueue->Closed());
+	EXPECT_EQ(spMessageBus->Send(moduleId, MsvMessage(1, 1)), MSV_NOT_INITIALIZED_ERROR);
+
+	//the same queue is opened when module starts again (cached queue can be used)
+	EXPECT_EQ(moduleManager.Start(), MSV_SUCCESS);
+	std::shared_ptr<MsvMessageQueue> spStartedQueue;
+	EXPECT_EQ(spMessageBus->GetQueue(moduleId, spStartedQueue), MSV_SUCCESS);
+	EXPECT_EQ(spStartedQueue, spQueue);
+	EXPECT_EQ(spQueue->Send(MsvMessage(1, 1)), MSV_SUCCESS);
+	EXPECT_EQ(spMessageBus->Send(moduleId, MsvMessage(1, 1)), MSV_SUCCESS);
+	EXPECT_EQ(moduleManager.Stop(), MSV_SUCCESS);
+	EXPECT_EQ(moduleManager.Uninitialize(), MSV_SUCCESS);
+}
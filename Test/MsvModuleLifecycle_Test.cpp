@@ -0,0 +1,263 @@
+
+
+#include "pch.h"
+
+#include "mmodule/MsvModuleLifecycle.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+MSV_ENABLE_WARNINGS
+
+
+using namespace ::testing;
+
+
+//module which counts hook calls and returns configured hook results
+template<class Base>
+class MsvTestLifecycleModule:
+	public MsvModuleLifecycle<MsvTestLifecycleModule<Base>, Base>
+{
+	friend class MsvModuleLifecycle<MsvTestLifecycleModule<Base>, Base>;
+
+public:
+	template<class... Args>
+	MsvTestLifecycleModule(Args&&... args):
+		MsvModuleLifecycle<MsvTestLifecycleModule<Base>, Base>(std::forward<Args>(args)...),
+		m_hookResult(MSV_SUCCESS),
+		m_initializeCalls(0),
+		m_uninitializeCalls(0),
+		m_startCalls(0),
+		m_stopCalls(0)
+	{
+
+	}
+
+	MsvErrorCode m_hookResult;
+	int m_initializeCalls;
+	int m_uninitializeCalls;
+	int m_startCalls;
+	int m_stopCalls;
+
+protected:
+	MsvErrorCode OnInitialize() { ++m_initializeCalls; return m_hookResult; }
+	MsvErrorCode OnUninitialize() { ++m_uninitializeCalls; return m_hookResult; }
+	MsvErrorCode OnStart() { ++m_startCalls; return m_hookResult; }
+	MsvErrorCode OnStop() { ++m_stopCalls; return m_hookResult; }
+};
+
+
+//creates tested module (module base needs logger provider, DLL module base does not)
+template<class LockPolicy>
+std::shared_ptr<MsvTestLifecycleModule<MsvModuleBaseT<LockPolicy>>> CreateLifecycleModule(std::shared_ptr<IMsvLoggerProvider> spLoggerProvider, MsvModuleBaseT<LockPolicy>*)
+{
+	return std::make_shared<MsvTestLifecycleModule<MsvModuleBaseT<LockPolicy>>>(spLoggerProvider, "MsvModuleLifecycle_Test");
+}
+
+template<class LockPolicy>
+std::shared_ptr<MsvTestLifecycleModule<MsvDllModuleBaseT<LockPolicy>>> CreateLifecycleModule(std::shared_ptr<IMsvLoggerProvider>, MsvDllModuleBaseT<LockPolicy>*)
+{
+	return std::make_shared<MsvTestLifecycleModule<MsvDllModuleBaseT<LockPolicy>>>();
+}
+
+
+template<class Base>
+class MsvModuleLifecycle_Test:
+	public MsvModule_TestBase
+{
+public:
+	virtual void SetUp()
+	{
+		InitializeLogging();
+
+		m_spModule = CreateLifecycleModule(m_spLoggerProvider, static_cast<Base*>(nullptr));
+		EXPECT_NE(m_spModule, nullptr);
+	}
+
+	virtual void TearDown()
+	{
+		m_spModule.reset();
+
+		UninitializeLogging();
+	}
+
+	//tested classes
+	std::shared_ptr<MsvTestLifecycleModule<Base>> m_spModule;
+};
+
+
+typedef Types<
+	MsvModuleBaseT<MsvNoLockPolicy>,
+	MsvModuleBaseT<MsvSpinLockPolicy>,
+	MsvModuleBaseT<MsvMutexLockPolicy>,
+	MsvModuleBaseT<MsvSharedLockPolicy>,
+	MsvModuleBaseT<MsvRecursiveLockPolicy>,
+	MsvDllModuleBaseT<MsvNoLockPolicy>,
+	MsvDllModuleBaseT<MsvSpinLockPolicy>,
+	MsvDllModuleBaseT<MsvMutexLockPolicy>,
+	MsvDllModuleBaseT<MsvSharedLockPolicy>,
+	MsvDllModuleBaseT<MsvRecursiveLockPolicy>> MsvModuleLifecycleBases;
+
+TYPED_TEST_CASE(MsvModuleLifecycle_Test, MsvModuleLifecycleBases);
+
+
+/*-----------------------------------------------------------------------------------------------------
+**											Initialize Tests
+**---------------------------------------------------------------------------------------------------*/
+
+
+TYPED_TEST(MsvModuleLifecycle_Test, ItShouldBeUninitializedAndStopped_AfterCreation)
+{
+	EXPECT_FALSE(this->m_spModule->Initialized());
+	EXPECT_FALSE(this->m_spModule->Running());
+}
+
+TYPED_TEST(MsvModuleLifecycle_Test, ItShouldInitialize_WhenOnInitializeSucceeded)
+{
+	EXPECT_EQ(this->m_spModule->Initialize(), MSV_SUCCESS);
+	EXPECT_TRUE(this->m_spModule->Initialized());
+	EXPECT_EQ(this->m_spModule->m_initializeCalls, 1);
+}
+
+TYPED_TEST(MsvModuleLifecycle_Test, ItShouldNotInitialize_WhenOnInitializeFailed)
+{
+	this->m_spModule->m_hookResult = MSV_INVALID_DATA_ERROR;
+
+	EXPECT_EQ(this->m_spModule->Initialize(), MSV_INVALID_DATA_ERROR);
+	EXPECT_FALSE(this->m_spModule->Initialized());
+}
+
+TYPED_TEST(MsvModuleLifecycle_Test, ItShouldReturnInfo_WhenInitializedTwice)
+{
+	EXPECT_EQ(this->m_spModule->Initialize(), MSV_SUCCESS);
+	EXPECT_EQ(this->m_spModule->Initialize(), MSV_ALREADY_INITIALIZED_INFO);
+	EXPECT_EQ(this->m_spModule->m_initializeCalls, 1);
+}
+
+
+/*-----------------------------------------------------------------------------------------------------
+**											Uninitialize Tests
+**---------------------------------------------------------------------------------------------------*/
+
+
+TYPED_TEST(MsvModuleLifecycle_Test, ItShouldReturnInfo_WhenUninitializedAndNotInitialized)
+{
+	EXPECT_EQ(this->m_spModule->Uninitialize(), MSV_NOT_INITIALIZED_INFO);
+	EXPECT_EQ(this->m_spModule->m_uninitializeCalls, 0);
+}
+
+TYPED_TEST(MsvModuleLifecycle_Test, ItShouldReturnError_WhenUninitializedAndRunning)
+{
+	EXPECT_EQ(this->m_spModule->Initialize(), MSV_SUCCESS);
+	EXPECT_EQ(this->m_spModule->Start(), MSV_SUCCESS);
+
+	EXPECT_EQ(this->m_spModule->Uninitialize(), MSV_STILL_RUNNING_ERROR);
+	EXPECT_TRUE(this->m_spModule->Initialized());
+}
+
+TYPED_TEST(MsvModuleLifecycle_Test, ItShouldUninitialize_WhenOnUninitializeFailed)
+{
+	EXPECT_EQ(this->m_spModule->Initialize(), MSV_SUCCESS);
+	this->m_spModule->m_hookResult = MSV_INVALID_DATA_ERROR;
+
+	EXPECT_EQ(this->m_spModule->Uninitialize(), MSV_INVALID_DATA_ERROR);
+	EXPECT_FALSE(this->m_spModule->Initialized());
+}
+
+
+/*-----------------------------------------------------------------------------------------------------
+**											Start Tests
+**---------------------------------------------------------------------------------------------------*/
+
+
+TYPED_TEST(MsvModuleLifecycle_Test, ItShouldReturnError_WhenStartedAndNotInitialized)
+{
+	EXPECT_EQ(this->m_spModule->Start(), MSV_NOT_INITIALIZED_ERROR);
+	EXPECT_FALSE(this->m_spModule->Running());
+	EXPECT_EQ(this->m_spModule->m_startCalls, 0);
+}
+
+TYPED_TEST(MsvModuleLifecycle_Test, ItShouldStart_WhenOnStartSucceeded)
+{
+	EXPECT_EQ(this->m_spModule->Initialize(), MSV_SUCCESS);
+
+	EXPECT_EQ(this->m_spModule->Start(), MSV_SUCCESS);
+	EXPECT_TRUE(this->m_spModule->Running());
+	EXPECT_EQ(this->m_spModule->Start(), MSV_ALREADY_RUNNING_INFO);
+	EXPECT_EQ(this->m_spModule->m_startCalls, 1);
+}
+
+TYPED_TEST(MsvModuleLifecycle_Test, ItShouldNotStart_WhenOnStartFailed)
+{
+	EXPECT_EQ(this->m_spModule->Initialize(), MSV_SUCCESS);
+	this->m_spModule->m_hookResult = MSV_INVALID_DATA_ERROR;
+
+	EXPECT_EQ(this->m_spModule->Start(), MSV_INVALID_DATA_ERROR);
+	EXPECT_FALSE(this->m_spModule->Running());
+}
+
+
+/*-----------------------------------------------------------------------------------------------------
+**											Stop Tests
+**---------------------------------------------------------------------------------------------------*/
+
+
+TYPED_TEST(MsvModuleLifecycle_Test, ItShouldReturnInfo_WhenStoppedAndNotRunning)
+{
+	EXPECT_EQ(this->m_spModule->Stop(), MSV_NOT_RUNNING_INFO);
+	EXPECT_EQ(this->m_spModule->m_stopCalls, 0);
+}
+
+TYPED_TEST(MsvModuleLifecycle_Test, ItShouldStop_WhenOnStopFailed)
+{
+	EXPECT_EQ(this->m_spModule->Initialize(), MSV_SUCCESS);
+	EXPECT_EQ(this->m_spModule->Start(), MSV_SUCCESS);
+	this->m_spModule->m_hookResult = MSV_INVALID_DATA_ERROR;
+
+	EXPECT_EQ(this->m_spModule->Stop(), MSV_INVALID_DATA_ERROR);
+	EXPECT_FALSE(this->m_spModule->Running());
+	EXPECT_TRUE(this->m_spModule->Initialized());
+}
+
+
+/*-----------------------------------------------------------------------------------------------------
+**											Concurrency Tests
+**---------------------------------------------------------------------------------------------------*/
+
+
+TYPED_TEST(MsvModuleLifecycle_Test, ItShouldCallHooksOnce_WhenStartedAndStoppedFromMoreThreads)
+{
+	if (std::is_same<typename TypeParam::LockPolicyType, MsvNoLockPolicy>::value)
+	{
+		//no lock policy is not thread safe
+		return;
+	}
+
+	EXPECT_EQ(this->m_spModule->Initialize(), MSV_SUCCESS);
+
+	std::vector<std::thread> threads;
+	for (int i = 0; i < 8; ++i)
+	{
+		threads.emplace_back([this]()
+		{
+			for (int j = 0; j < 1000; ++j)
+			{
+				this->m_spModule->Start();
+				this->m_spModule->Running();
+				this->m_spModule->Stop();
+			}
+		});
+	}
+
+	for (std::vector<std::thread>::iterator it = threads.begin(); it != threads.end(); ++it)
+	{
+		it->join();
+	}
+
+	//every successful start has its stop
+	EXPECT_FALSE(this->m_spModule->Running());
+	EXPECT_EQ(this->m_spModule->m_startCalls, this->m_spModule->m_stopCalls);
+}
@@ -21,10 +21,12 @@ public:
 
 	}
 
-	const std::map<int32_t, std::pair<std::shared_ptr<IMsvModuleConfigurator>, std::shared_ptr<IMsvModule>>>& GetModules() const
+	const MsvModuleMap& GetModules() const
 	{
 		return m_modules;
 	}
+
+	using MsvModuleManager::GetModuleSetHash;
 };
 
 class MsvModuleManager_Test:
@@ -216,7 +218,7 @@ public:
 		EXPECT_EQ(m_spModuleManager->AddModule(static_cast<int32_t>(ModuleId::MSV_TEST_OTHER_MODULE), spOtherModuleMock, spOtherModuleConfiguratorMock), resultErrorCode);
 
 		//check modules
-		const std::map<int32_t, std::pair<std::shared_ptr<IMsvModuleConfigurator>, std::shared_ptr<IMsvModule>>>& modules = std::static_pointer_cast<MsvModuleManagerTestWrapper>(m_spModuleManager)->GetModules();
+		const MsvModuleManager::MsvModuleMap& modules = std::static_pointer_cast<MsvModuleManagerTestWrapper>(m_spModuleManager)->GetModules();
 		EXPECT_EQ(modules.find(static_cast<int32_t>(ModuleId::MSV_TEST_OTHER_MODULE)) != modules.end(), moduleAdded);
 		if (moduleAdded)
 		{
@@ -551,4 +553,259 @@ TEST_F(MsvModuleManager_Test, AddModuleShouldFailed_WhenModuleStartFailed)
 						 1, false, false,
 						 MSV_CLOSE_ERROR,
 						 MSV_CLOSE_ERROR, false);
-}
\ No newline at end of file
+}
+
+
+/*-----------------------------------------------------------------------------------------------------
+**											Startup Plan Tests
+**---------------------------------------------------------------------------------------------------*/
+
+
+const char* const MSV_TEST_STARTUP_PLAN_FILE = "MsvModuleManager_Test_StartupPlan.bin";
+
+class MsvModuleManager_StartupPlanTest:
+	public MsvModuleManager_Test
+{
+public:
+	virtual void SetUp()
+	{
+		MsvModuleManager_Test::SetUp();
+
+		std::remove(MSV_TEST_STARTUP_PLAN_FILE);
+		std::static_pointer_cast<MsvModuleManager>(m_spModuleManager)->SetStartupPlanFile(MSV_TEST_STARTUP_PLAN_FILE, 1);
+	}
+
+	virtual void TearDown()
+	{
+		std::remove(MSV_TEST_STARTUP_PLAN_FILE);
+
+		MsvModuleManager_Test::TearDown();
+	}
+
+	//saves plan of previous run (modules are static and second module, start durations mark that plan has been used)
+	void SaveStartupPlan(int32_t secondModuleId, bool dynamicEnabled)
+	{
+		MsvStartupPlanModule staticModule = { static_cast<int32_t>(ModuleId::MSV_TEST_STATIC_MODULE), 1, 1, 0, 0, 1000 };
+		MsvStartupPlanModule secondModule = { secondModuleId, 1, static_cast<uint8_t>(dynamicEnabled ? 1 : 0), 0, 0, 2000 };
+		std::vector<MsvStartupPlanModule> modules{ staticModule, secondModule };
+
+		uint64_t moduleSetHash = std::static_pointer_cast<MsvModuleManagerTestWrapper>(m_spModuleManager)->GetModuleSetHash();
+		EXPECT_EQ(MsvStartupPlan::Save(MSV_TEST_STARTUP_PLAN_FILE, 1, moduleSetHash, modules), MSV_SUCCESS);
+	}
+
+	void GetStartupPlan(std::vector<MsvStartupPlanModule>& startupPlan)
+	{
+		std::static_pointer_cast<MsvModuleManager>(m_spModuleManager)->GetStartupPlan(startupPlan);
+		EXPECT_EQ(startupPlan.size(), 2u);
+	}
+};
+
+TEST_F(MsvModuleManager_StartupPlanTest, ItShouldUseStartupPlan_WhenItMatchesConfigurators)
+{
+	SaveStartupPlan(static_cast<int32_t>(ModuleId::MSV_TEST_DYNAMIC_MODULE), true);
+
+	//configurators are always read (plan gives order and durations)
+	InitializeModuleManager();
+
+	std::vector<MsvStartupPlanModule> startupPlan;
+	GetStartupPlan(startupPlan);
+	EXPECT_EQ(startupPlan[0].moduleId, static_cast<int32_t>(ModuleId::MSV_TEST_STATIC_MODULE));
+	EXPECT_EQ(startupPlan[0].startDuration, 1000u);
+	EXPECT_EQ(startupPlan[1].startDuration, 2000u);
+
+	EXPECT_EQ(m_spModuleManager->Uninitialize(), MSV_SUCCESS);
+}
+
+TEST_F(MsvModuleManager_StartupPlanTest, ItShouldNotUseStartupPlan_WhenFlagsChanged)
+{
+	SaveStartupPlan(static_cast<int32_t>(ModuleId::MSV_TEST_DYNAMIC_MODULE), true);
+
+	//dynamic module has been disabled without changing config version -> it is not initialized
+	SetInitializeExpectations(true, true, true, false, MSV_SUCCESS, MSV_SUCCESS);
+	EXPECT_EQ(m_spModuleManager->Initialize(), MSV_SUCCESS);
+
+	std::vector<MsvStartupPlanModule> startupPlan;
+	GetStartupPlan(startupPlan);
+	for (std::vector<MsvStartupPlanModule>::const_iterator it = startupPlan.begin(); it != startupPlan.end(); ++it)
+	{
+		EXPECT_EQ(it->startDuration, 0u);
+		EXPECT_EQ(it->enabled, it->moduleId == static_cast<int32_t>(ModuleId::MSV_TEST_DYNAMIC_MODULE) ? 0 : 1);
+	}
+
+	EXPECT_EQ(m_spModuleManager->Uninitialize(), MSV_SUCCESS);
+}
+
+TEST_F(MsvModuleManager_StartupPlanTest, ItShouldNotUseStartupPlan_WhenItContainsUnknownModule)
+{
+	//plan passes header check (the same hash) but it does not contain registered modules
+	SaveStartupPlan(static_cast<int32_t>(ModuleId::MSV_TEST_OTHER_MODULE), true);
+
+	InitializeModuleManager();
+
+	std::vector<MsvStartupPlanModule> startupPlan;
+	GetStartupPlan(startupPlan);
+	for (std::vector<MsvStartupPlanModule>::const_iterator it = startupPlan.begin(); it != startupPlan.end(); ++it)
+	{
+		EXPECT_NE(it->moduleId, static_cast<int32_t>(ModuleId::MSV_TEST_OTHER_MODULE));
+		EXPECT_EQ(it->startDuration, 0u);
+	}
+
+	EXPECT_EQ(m_spModuleManager->Uninitialize(), MSV_SUCCESS);
+}
+
+
+/*-----------------------------------------------------------------------------------------------------
+**											Module Timings Tests
+**---------------------------------------------------------------------------------------------------*/
+
+
+TEST_F(MsvModuleManager_Test, ItShouldRecordTimings_WhenModulesStartedAndStopped)
+{
+	StopModuleManager(MSV_SUCCESS);
+
+	std::shared_ptr<const MsvModuleTimings> spModuleTimings = std::static_pointer_cast<MsvModuleManager>(m_spModuleManager)->GetModuleTimings();
+	EXPECT_NE(spModuleTimings, nullptr);
+
+	MsvModuleTransitionStatistics statistics;
+	EXPECT_EQ(spModuleTimings->GetStatistics(static_cast<int32_t>(ModuleId::MSV_TEST_STATIC_MODULE), MsvModuleTransition::MSV_MODULE_TRANSITION_INITIALIZE, statistics), MSV_SUCCESS);
+	EXPECT_EQ(statistics.count, 1u);
+	EXPECT_EQ(statistics.failures, 0u);
+	EXPECT_LE(statistics.min, statistics.max);
+
+	EXPECT_EQ(spModuleTimings->GetStatistics(static_cast<int32_t>(ModuleId::MSV_TEST_DYNAMIC_MODULE), MsvModuleTransition::MSV_MODULE_TRANSITION_START, statistics), MSV_SUCCESS);
+	EXPECT_EQ(statistics.count, 1u);
+	EXPECT_EQ(statistics.lastErrorCode, MSV_SUCCESS);
+
+	EXPECT_EQ(spModuleTimings->GetStatistics(static_cast<int32_t>(ModuleId::MSV_TEST_DYNAMIC_MODULE), MsvModuleTransition::MSV_MODULE_TRANSITION_STOP, statistics), MSV_SUCCESS);
+	EXPECT_EQ(statistics.count, 1u);
+
+	//modules have not been uninitialized yet
+	EXPECT_EQ(spModuleTimings->GetStatistics(static_cast<int32_t>(ModuleId::MSV_TEST_DYNAMIC_MODULE), MsvModuleTransition::MSV_MODULE_TRANSITION_UNINITIALIZE, statistics), MSV_NOT_FOUND_ERROR);
+}
+
+TEST_F(MsvModuleManager_Test, ItShouldRecordFailure_WhenStartAnyModuleFailed)
+{
+	StartModuleManager(1, 1, MSV_NOT_INITIALIZED_ERROR, MSV_NOT_INITIALIZED_ERROR, MSV_SUCCESS);
+
+	MsvModuleTransitionStatistics statistics;
+	EXPECT_EQ(std::static_pointer_cast<MsvModuleManager>(m_spModuleManager)->GetModuleTimings()->GetStatistics(static_cast<int32_t>(ModuleId::MSV_TEST_DYNAMIC_MODULE), MsvModuleTransition::MSV_MODULE_TRANSITION_START, statistics), MSV_SUCCESS);
+	EXPECT_EQ(statistics.count, 1u);
+	EXPECT_EQ(statistics.failures, 1u);
+	EXPECT_EQ(statistics.lastErrorCode, MSV_NOT_INITIALIZED_ERROR);
+
+	//uninitialize after test
+	EXPECT_EQ(m_spModuleManager->Uninitialize(), MSV_SUCCESS);
+}
+
+
+/*-----------------------------------------------------------------------------------------------------
+**											Trace Tests
+**---------------------------------------------------------------------------------------------------*/
+
+
+TEST_F(MsvModuleManager_Test, ItShouldRecordTransitionEvents_WhenTraceRecorderIsSet)
+{
+	std::shared_ptr<MsvTraceRecorder> spTraceRecorder(new (std::nothrow) MsvTraceRecorder());
+	EXPECT_NE(spTraceRecorder, nullptr);
+	std::static_pointer_cast<MsvModuleManager>(m_spModuleManager)->SetTraceRecorder(spTraceRecorder);
+
+	InitializeModuleManager();
+
+	//manager initialize event contains initialize events of both modules
+	std::vector<MsvTraceEvent> events;
+	spTraceRecorder->GetEvents(events);
+	EXPECT_EQ(events.size(), 6u);
+	EXPECT_EQ(events.front().name, "Module manager initialize");
+	EXPECT_EQ(events.front().phase, 'B');
+	EXPECT_EQ(events[1].name, "Initialize module " + std::to_string(static_cast<int32_t>(ModuleId::MSV_TEST_STATIC_MODULE)));
+	EXPECT_EQ(events[1].category, std::string("module"));
+	EXPECT_EQ(events.back().name, "Module manager initialize");
+	EXPECT_EQ(events.back().phase, 'E');
+
+	//uninitialize after test
+	EXPECT_EQ(m_spModuleManager->Uninitialize(), MSV_SUCCESS);
+}
+
+
+/*-----------------------------------------------------------------------------------------------------
+**											Dependency Tests
+**---------------------------------------------------------------------------------------------------*/
+
+
+TEST_F(MsvModuleManager_Test, ItShouldUseModuleIdOrder_WhenNoDependencies)
+{
+	std::vector<int32_t> order;
+	std::static_pointer_cast<MsvModuleManager>(m_spModuleManager)->GetStartupOrder(order);
+	EXPECT_EQ(order, std::vector<int32_t>({ static_cast<int32_t>(ModuleId::MSV_TEST_STATIC_MODULE), static_cast<int32_t>(ModuleId::MSV_TEST_DYNAMIC_MODULE) }));
+
+	std::static_pointer_cast<MsvModuleManager>(m_spModuleManager)->GetShutdownOrder(order);
+	EXPECT_EQ(order, std::vector<int32_t>({ static_cast<int32_t>(ModuleId::MSV_TEST_STATIC_MODULE), static_cast<int32_t>(ModuleId::MSV_TEST_DYNAMIC_MODULE) }));
+}
+
+TEST_F(MsvModuleManager_Test, ItShouldStartDependencyFirst_WhenModuleDependsOnIt)
+{
+	std::shared_ptr<MsvModuleManager> spModuleManager = std::static_pointer_cast<MsvModuleManager>(m_spModuleManager);
+	EXPECT_EQ(spModuleManager->AddModuleDependency(static_cast<int32_t>(ModuleId::MSV_TEST_STATIC_MODULE), static_cast<int32_t>(ModuleId::MSV_TEST_DYNAMIC_MODULE)), MSV_SUCCESS);
+
+	std::vector<int32_t> order;
+	spModuleManager->GetStartupOrder(order);
+	EXPECT_EQ(order, std::vector<int32_t>({ static_cast<int32_t>(ModuleId::MSV_TEST_DYNAMIC_MODULE), static_cast<int32_t>(ModuleId::MSV_TEST_STATIC_MODULE) }));
+
+	spModuleManager->GetShutdownOrder(order);
+	EXPECT_EQ(order, std::vector<int32_t>({ static_cast<int32_t>(ModuleId::MSV_TEST_STATIC_MODULE), static_cast<int32_t>(ModuleId::MSV_TEST_DYNAMIC_MODULE) }));
+
+	//modules are initialized in startup order
+	{
+		InSequence sequence;
+		EXPECT_CALL(*m_spDynamicModuleConfiguratorMock, IsInstalled(Matcher<bool&>(_)))
+			.WillOnce(DoAll(SetArgReferee<0>(true), Return(MSV_SUCCESS)));
+		EXPECT_CALL(*m_spDynamicModuleConfiguratorMock, IsEnabled(Matcher<bool&>(_)))
+			.WillOnce(DoAll(SetArgReferee<0>(true), Return(MSV_SUCCESS)));
+		EXPECT_CALL(*m_spDynamicModuleMock, Initialize())
+			.WillOnce(Return(MSV_SUCCESS));
+		EXPECT_CALL(*m_spStaticModuleConfiguratorMock, IsInstalled(Matcher<bool&>(_)))
+			.WillOnce(DoAll(SetArgReferee<0>(true), Return(MSV_SUCCESS)));
+		EXPECT_CALL(*m_spStaticModuleConfiguratorMock, IsEnabled(Matcher<bool&>(_)))
+			.WillOnce(DoAll(SetArgReferee<0>(true), Return(MSV_SUCCESS)));
+		EXPECT_CALL(*m_spStaticModuleMock, Initialize())
+			.WillOnce(Return(MSV_SUCCESS));
+	}
+
+	EXPECT_EQ(spModuleManager->Initialize(), MSV_SUCCESS);
+
+	//uninitialize after test
+	EXPECT_EQ(spModuleManager->Uninitialize(), MSV_SUCCESS);
+}
+
+TEST_F(MsvModuleManager_Test, ItShouldFail_WhenDependencyCreatesCycle)
+{
+	std::shared_ptr<MsvModuleManager> spModuleManager = std::static_pointer_cast<MsvModuleManager>(m_spModuleManager);
+	EXPECT_EQ(spModuleManager->AddModuleDependency(static_cast<int32_t>(ModuleId::MSV_TEST_STATIC_MODULE), static_cast<int32_t>(ModuleId::MSV_TEST_STATIC_MODULE)), MSV_INVALID_DATA_ERROR);
+	EXPECT_EQ(spModuleManager->AddModuleDependency(static_cast<int32_t>(ModuleId::MSV_TEST_STATIC_MODULE), static_cast<int32_t>(ModuleId::MSV_TEST_DYNAMIC_MODULE)), MSV_SUCCESS);
+	EXPECT_EQ(spModuleManager->AddModuleDependency(static_cast<int32_t>(ModuleId::MSV_TEST_STATIC_MODULE), static_cast<int32_t>(ModuleId::MSV_TEST_DYNAMIC_MODULE)), MSV_ALREADY_EXISTS_ERROR);
+	EXPECT_EQ(spModuleManager->AddModuleDependency(static_cast<int32_t>(ModuleId::MSV_TEST_DYNAMIC_MODULE), static_cast<int32_t>(ModuleId::MSV_TEST_STATIC_MODULE)), MSV_INVALID_DATA_ERROR);
+}
+
+
+/*-----------------------------------------------------------------------------------------------------
+**											Critical Path Tests
+**---------------------------------------------------------------------------------------------------*/
+
+
+TEST_F(MsvModuleManager_Test, ItShouldReturnCriticalPath_WhenInitialized)
+{
+	std::shared_ptr<MsvModuleManager> spModuleManager = std::static_pointer_cast<MsvModuleManager>(m_spModuleManager);
+	EXPECT_EQ(spModuleManager->AddModuleDependency(static_cast<int32_t>(ModuleId::MSV_TEST_STATIC_MODULE), static_cast<int32_t>(ModuleId::MSV_TEST_DYNAMIC_MODULE)), MSV_SUCCESS);
+
+	InitializeModuleManager();
+
+	//static module depends on dynamic module -> both are on critical path
+	MsvCriticalPath criticalPath;
+	spModuleManager->GetCriticalPath(criticalPath);
+	EXPECT_EQ(criticalPath.modules.size(), 2u);
+	EXPECT_EQ(criticalPath.path, std::vector<int32_t>({ static_cast<int32_t>(ModuleId::MSV_TEST_DYNAMIC_MODULE), static_cast<int32_t>(ModuleId::MSV_TEST_STATIC_MODULE) }));
+	EXPECT_EQ(criticalPath.totalDuration, criticalPath.sequentialDuration);
+
+	//uninitialize after test
+	EXPECT_EQ(m_spModuleManager->Uninitialize(), MSV_SUCCESS);
+}
@@ -0,0 +1,294 @@
+
+
+#include "pch.h"
+
+#include "mmodule/MsvModuleLifecycle.h"
+#include "mmodule/MsvModuleManager.h"
+#include "mmodule/MsvModulePlacement.h"
+
+#include "mmodule/Mocks/MsvModuleConfigurator_Mock.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+MSV_ENABLE_WARNINGS
+
+
+using namespace ::testing;
+
+
+//module which remembers CPUs of its start thread and of thread created by thread factory
+class MsvTestPlacementModule:
+	public MsvModuleLifecycle<MsvTestPlacementModule, MsvModuleBase>
+{
+public:
+	MsvTestPlacementModule(std::shared_ptr<IMsvLoggerProvider> spLoggerProvider):
+		MsvModuleLifecycle(spLoggerProvider, "MsvModulePlacement_Test")
+	{
+
+	}
+
+	MsvErrorCode OnStart()
+	{
+		if (!m_spThreadFactory)
+		{
+			return MSV_NOT_INITIALIZED_ERROR;
+		}
+
+		MSV_RETURN_FAILED(MsvThreadPlacement::GetThreadCpus(m_startCpus));
+
+		std::thread thread;
+		MSV_RETURN_FAILED(m_spThreadFactory->CreateThread([this]() { MsvThreadPlacement::GetThreadCpus(m_threadCpus); }, thread));
+		thread.join();
+
+		return MSV_SUCCESS;
+	}
+
+	std::vector<uint32_t> m_startCpus;
+	std::vector<uint32_t> m_threadCpus;
+};
+
+
+class MsvModulePlacement_Test:
+	public MsvModule_TestBase
+{
+public:
+	virtual void SetUp()
+	{
+		InitializeLogging();
+
+		EXPECT_TRUE(MSV_SUCCEEDED(MsvThreadPlacement::GetThreadCpus(m_cpus)));
+	}
+
+	virtual void TearDown()
+	{
+		UninitializeLogging();
+	}
+
+	//CPUs of test thread
+	std::vector<uint32_t> m_cpus;
+};
+
+
+/*-----------------------------------------------------------------------------------------------------
+**											Thread Placement Tests
+**---------------------------------------------------------------------------------------------------*/
+
+
+TEST_F(MsvModulePlacement_Test, ItShouldRunOnPlacementCpus_WhenPlacementScopeIsActive)
+{
+	if (m_cpus.empty())
+	{
+		//CPU affinity is not supported on this platform
+		return;
+	}
+
+	MsvModulePlacement placement;
+	placement.cpus.push_back(m_cpus.back());
+
+	{
+		MsvPlacementScope placementScope(&placement);
+		EXPECT_EQ(placementScope.GetErrorCode(), MSV_SUCCESS);
+
+		std::vector<uint32_t> cpus;
+		EXPECT_EQ(MsvThreadPlacement::GetThreadCpus(cpus), MSV_SUCCESS);
+		EXPECT_EQ(cpus, placement.cpus);
+	}
+
+	//previous CPUs are restored
+	std::vector<uint32_t> cpus;
+	EXPECT_EQ(MsvThreadPlacement::GetThreadCpus(cpus), MSV_SUCCESS);
+	EXPECT_EQ(cpus, m_cpus);
+}
+
+TEST_F(MsvModulePlacement_Test, ItShouldNotChangePlacement_WhenPlacementIsNotSet)
+{
+	MsvPlacementScope placementScope(nullptr);
+	EXPECT_EQ(placementScope.GetErrorCode(), MSV_SUCCESS);
+
+	std::vector<uint32_t> cpus;
+	EXPECT_EQ(MsvThreadPlacement::GetThreadCpus(cpus), MSV_SUCCESS);
+	EXPECT_EQ(cpus, m_cpus);
+}
+
+TEST_F(MsvModulePlacement_Test, ItShouldFail_WhenCpuDoesNotExist)
+{
+	if (m_cpus.empty())
+	{
+		//CPU affinity is not supported on this platform
+		return;
+	}
+
+	MsvModulePlacement placement;
+	placement.cpus.push_back(1000000);
+
+	{
+		MsvPlacementScope placementScope(&placement);
+		EXPECT_EQ(placementScope.GetErrorCode(), MSV_INVALID_DATA_ERROR);
+	}
+
+	std::vector<uint32_t> cpus;
+	EXPECT_EQ(MsvThreadPlacement::GetThreadCpus(cpus), MSV_SUCCESS);
+	EXPECT_EQ(cpus, m_cpus);
+}
+
+TEST_F(MsvModulePlacement_Test, ItShouldFail_WhenNumaNodeDoesNotExist)
+{
+	std::vector<uint32_t> cpus;
+	EXPECT_EQ(MsvThreadPlacement::GetNumaNodeCpus(1000000, cpus), MSV_NOT_FOUND_ERROR);
+	EXPECT_TRUE(cpus.empty());
+}
+
+TEST_F(MsvModulePlacement_Test, ItShouldRunOnNumaNodeCpus_WhenOnlyNumaNodeIsSet)
+{
+	std::vector<uint32_t> nodeCpus;
+	if (m_cpus.empty() || MSV_FAILED(MsvThreadPlacement::GetNumaNodeCpus(0, nodeCpus)))
+	{
+		//NUMA is not supported on this host
+		return;
+	}
+
+	MsvModulePlacement placement;
+	placement.numaNode = 0;
+
+	MsvPlacementScope placementScope(&placement);
+	EXPECT_EQ(placementScope.GetErrorCode(), MSV_SUCCESS);
+
+	std::vector<uint32_t> cpus;
+	EXPECT_EQ(MsvThreadPlacement::GetThreadCpus(cpus), MSV_SUCCESS);
+	for (std::vector<uint32_t>::const_iterator it = cpus.begin(); it != cpus.end(); ++it)
+	{
+		EXPECT_NE(std::find(nodeCpus.begin(), nodeCpus.end(), *it), nodeCpus.end());
+	}
+}
+
+TEST_F(MsvModulePlacement_Test, ItShouldRestoreMemoryPolicy_WhenPlacementScopeEnds)
+{
+	//interleave policy (it is not set by module placement)
+	MsvThreadMemoryPolicy interleavePolicy;
+	interleavePolicy.mode = 3;
+	interleavePolicy.nodeMask.push_back(1);
+
+	std::vector<uint32_t> nodeCpus;
+	if (MSV_FAILED(MsvThreadPlacement::GetNumaNodeCpus(0, nodeCpus)) || MSV_FAILED(MsvThreadPlacement::SetThreadMemoryPolicy(interleavePolicy)))
+	{
+		//NUMA is not supported on this host
+		return;
+	}
+
+	MsvThreadMemoryPolicy previousPolicy;
+	EXPECT_EQ(MsvThreadPlacement::GetThreadMemoryPolicy(previousPolicy), MSV_SUCCESS);
+
+	MsvModulePlacement placement;
+	placement.numaNode = 0;
+
+	{
+		MsvPlacementScope placementScope(&placement);
+		EXPECT_EQ(placementScope.GetErrorCode(), MSV_SUCCESS);
+
+		int32_t numaNode = MSV_NUMA_NODE_ANY;
+		EXPECT_EQ(MsvThreadPlacement::GetThreadNumaNode(numaNode), MSV_SUCCESS);
+		EXPECT_EQ(numaNode, 0);
+	}
+
+	//interleave policy is restored (not default policy)
+	MsvThreadMemoryPolicy memoryPolicy;
+	EXPECT_EQ(MsvThreadPlacement::GetThreadMemoryPolicy(memoryPolicy), MSV_SUCCESS);
+	EXPECT_EQ(memoryPolicy.mode, previousPolicy.mode);
+	EXPECT_EQ(memoryPolicy.nodeMask, previousPolicy.nodeMask);
+
+	EXPECT_EQ(MsvThreadPlacement::SetThreadMemoryPolicy(MsvThreadMemoryPolicy()), MSV_SUCCESS);
+}
+
+
+/*-----------------------------------------------------------------------------------------------------
+**											Thread Factory Tests
+**---------------------------------------------------------------------------------------------------*/
+
+
+TEST_F(MsvModulePlacement_Test, ItShouldCreateThreadOnPlacementCpus_WhenThreadFactoryIsUsed)
+{
+	if (m_cpus.empty())
+	{
+		//CPU affinity is not supported on this platform
+		return;
+	}
+
+	MsvModulePlacement placement;
+	placement.cpus.push_back(m_cpus.front());
+	MsvThreadFactory threadFactory(placement);
+
+	std::vector<uint32_t> cpus;
+	std::thread thread;
+	EXPECT_EQ(threadFactory.CreateThread([&cpus]() { MsvThreadPlacement::GetThreadCpus(cpus); }, thread), MSV_SUCCESS);
+	thread.join();
+
+	EXPECT_EQ(cpus, placement.cpus);
+}
+
+TEST_F(MsvModulePlacement_Test, ItShouldFailToCreateThread_WhenFunctionIsEmpty)
+{
+	MsvThreadFactory threadFactory;
+	std::thread thread;
+
+	EXPECT_EQ(threadFactory.CreateThread(std::function<void()>(), thread), MSV_INVALID_DATA_ERROR);
+	EXPECT_FALSE(thread.joinable());
+}
+
+
+/*-----------------------------------------------------------------------------------------------------
+**											Module Manager Placement Tests
+**---------------------------------------------------------------------------------------------------*/
+
+
+TEST_F(MsvModulePlacement_Test, ItShouldFail_WhenModulePlacementIsInvalid)
+{
+	MsvModuleManager moduleManager(m_spLogger);
+	MsvModulePlacement placement;
+	placement.numaNode = -2;
+
+	EXPECT_EQ(moduleManager.SetModulePlacement(static_cast<int32_t>(ModuleId::MSV_TEST_STATIC_MODULE), placement), MSV_INVALID_DATA_ERROR);
+	EXPECT_EQ(moduleManager.GetModulePlacement(static_cast<int32_t>(ModuleId::MSV_TEST_STATIC_MODULE), placement), MSV_NOT_FOUND_ERROR);
+}
+
+TEST_F(MsvModulePlacement_Test, ItShouldApplyModulePlacement_WhenModuleIsStarted)
+{
+	if (m_cpus.empty())
+	{
+		//CPU affinity is not supported on this platform
+		return;
+	}
+
+	MsvModuleManager moduleManager(m_spLogger);
+	std::shared_ptr<MsvTestPlacementModule> spModule(new (std::nothrow) MsvTestPlacementModule(m_spLoggerProvider));
+	EXPECT_NE(spModule, nullptr);
+	std::shared_ptr<MsvModuleConfigurator_Mock> spModuleConfiguratorMock(new (std::nothrow) MsvModuleConfigurator_Mock());
+	EXPECT_NE(spModuleConfiguratorMock, nullptr);
+
+	EXPECT_CALL(*spModuleConfiguratorMock, IsInstalled(Matcher<bool&>(_)))
+		.WillRepeatedly(DoAll(SetArgReferee<0>(true), Return(MSV_SUCCESS)));
+	EXPECT_CALL(*spModuleConfiguratorMock, IsEnabled(Matcher<bool&>(_)))
+		.WillRepeatedly(DoAll(SetArgReferee<0>(true), Return(MSV_SUCCESS)));
+
+	MsvModulePlacement placement;
+	placement.cpus.push_back(m_cpus.back());
+	EXPECT_EQ(moduleManager.SetModulePlacement(static_cast<int32_t>(ModuleId::MSV_TEST_STATIC_MODULE), placement), MSV_SUCCESS);
+	EXPECT_EQ(moduleManager.AddModule(static_cast<int32_t>(ModuleId::MSV_TEST_STATIC_MODULE), spModule, spModuleConfiguratorMock), MSV_SUCCESS);
+
+	EXPECT_EQ(moduleManager.Initialize(), MSV_SUCCESS);
+	EXPECT_EQ(moduleManager.Start(), MSV_SUCCESS);
+
+	//start and module thread run on module CPUs, caller thread is restored
+	EXPECT_EQ(spModule->m_startCpus, placement.cpus);
+	EXPECT_EQ(spModule->m_threadCpus, placement.cpus);
+
+	std::vector<uint32_t> cpus;
+	EXPECT_EQ(MsvThreadPlacement::GetThreadCpus(cpus), MSV_SUCCESS);
+	EXPECT_EQ(cpus, m_cpus);
+
+	EXPECT_EQ(moduleManager.Stop(), MSV_SUCCESS);
+	EXPECT_EQ(moduleManager.Uninitialize(), MSV_SUCCESS);
+}
@@ -0,0 +1,365 @@
+
+
+#include "pch.h"
+
+#include "mmodule/MsvModuleLifecycle.h"
+#include "mmodule/MsvModuleManager.h"
+
+#include "mmodule/Mocks/MsvModuleConfigurator_Mock.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+MSV_ENABLE_WARNINGS
+
+
+using namespace ::testing;
+
+
+class MsvTestReadinessModule:
+	public MsvModuleLifecycle<MsvTestReadinessModule, MsvModuleBase>
+{
+public:
+	//warmUp < 0 -> module never becomes ready
+	MsvTestReadinessModule(std::shared_ptr<IMsvLoggerProvider> spLoggerProvider, bool asyncReadiness, std::chrono::milliseconds warmUp):
+		MsvModuleLifecycle(spLoggerProvider, "MsvModuleReadiness_Test"),
+		m_warmUp(warmUp),
+		m_pModuleManager(nullptr),
+		m_dependencyReadyOnStart(false),
+		m_managerServedOnWarmUp(false)
+	{
+		m_asyncReadiness = asyncReadiness;
+	}
+
+	MsvErrorCode OnStart()
+	{
+		if (m_spDependency)
+		{
+			m_dependencyReadyOnStart = m_spDependency->Ready();
+		}
+
+		if (m_asyncReadiness && m_warmUp >= std::chrono::milliseconds::zero())
+		{
+			m_warmUpThread = std::thread([this]()
+			{
+				std::this_thread::sleep_for(m_warmUp);
+				if (m_pModuleManager)
+				{
+					//module manager waits for readiness out of its lock
+					m_managerServedOnWarmUp = !m_pModuleManager->Running() && !m_pModuleManager->Ready();
+				}
+				SetReady();
+			});
+		}
+
+		return MSV_SUCCESS;
+	}
+
+	MsvErrorCode OnStop()
+	{
+		if (m_warmUpThread.joinable())
+		{
+			m_warmUpThread.join();
+		}
+
+		return MSV_SUCCESS;
+	}
+
+	std::chrono::milliseconds m_warmUp;
+	std::thread m_warmUpThread;
+	std::shared_ptr<IMsvModuleReadiness> m_spDependency;
+	MsvModuleManager* m_pModuleManager;
+	bool m_dependencyReadyOnStart;
+	std::atomic<bool> m_managerServedOnWarmUp;
+};
+
+
+//module which sets its flags itself (it does not notify state changes)
+class MsvTestPlainModule:
+	public MsvModuleBase
+{
+public:
+	MsvTestPlainModule(std::shared_ptr<IMsvLoggerProvider> spLoggerProvider):
+		MsvModuleBase(spLoggerProvider, "MsvModuleReadiness_Test")
+	{
+
+	}
+
+	virtual MsvErrorCode Initialize() override
+	{
+		std::lock_guard<std::recursive_mutex> lock(m_lock);
+		m_initialized = true;
+		return MSV_SUCCESS;
+	}
+
+	virtual MsvErrorCode Uninitialize() override
+	{
+		std::lock_guard<std::recursive_mutex> lock(m_lock);
+		m_initialized = false;
+		return MSV_SUCCESS;
+	}
+
+	virtual MsvErrorCode Start() override
+	{
+		std::lock_guard<std::recursive_mutex> lock(m_lock);
+		m_running = true;
+		return MSV_SUCCESS;
+	}
+
+	virtual MsvErrorCode Stop() override
+	{
+		std::lock_guard<std::recursive_mutex> lock(m_lock);
+		m_running = false;
+		return MSV_SUCCESS;
+	}
+};
+
+
+class MsvModuleReadiness_Test:
+	public MsvModule_TestBase
+{
+public:
+	virtual void SetUp()
+	{
+		InitializeLogging();
+
+		m_spModuleConfiguratorMock.reset(new (std::nothrow) MsvModuleConfigurator_Mock());
+		EXPECT_NE(m_spModuleConfiguratorMock, nullptr);
+
+		EXPECT_CALL(*m_spModuleConfiguratorMock, IsInstalled(Matcher<bool&>(_)))
+			.WillRepeatedly(DoAll(SetArgReferee<0>(true), Return(MSV_SUCCESS)));
+		EXPECT_CALL(*m_spModuleConfiguratorMock, IsEnabled(Matcher<bool&>(_)))
+			.WillRepeatedly(DoAll(SetArgReferee<0>(true), Return(MSV_SUCCESS)));
+	}
+
+	virtual void TearDown()
+	{
+		m_spModuleConfiguratorMock.reset();
+
+		UninitializeLogging();
+	}
+
+	//mocks
+	std::shared_ptr<MsvModuleConfigurator_Mock> m_spModuleConfiguratorMock;
+};
+
+
+/*-----------------------------------------------------------------------------------------------------
+**											Module Readiness Tests
+**---------------------------------------------------------------------------------------------------*/
+
+
+TEST_F(MsvModuleReadiness_Test, ItShouldBeReady_WhenSynchronousModuleIsRunning)
+{
+	MsvTestReadinessModule module(m_spLoggerProvider, false, std::chrono::milliseconds(0));
+
+	EXPECT_FALSE(module.Ready());
+	EXPECT_EQ(module.Initialize(), MSV_SUCCESS);
+	EXPECT_FALSE(module.Ready());
+	EXPECT_EQ(module.Start(), MSV_SUCCESS);
+	EXPECT_TRUE(module.Ready());
+	EXPECT_TRUE(module.WaitForReady(std::chrono::milliseconds(0)));
+	EXPECT_TRUE(module.WaitForState(MsvModuleState::MSV_MODULE_STATE_RUNNING, std::chrono::milliseconds(0)));
+
+	EXPECT_EQ(module.Stop(), MSV_SUCCESS);
+	EXPECT_FALSE(module.Ready());
+	EXPECT_EQ(module.Uninitialize(), MSV_SUCCESS);
+}
+
+TEST_F(MsvModuleReadiness_Test, ItShouldBecomeReady_WhenModuleWarmsUpAfterStart)
+{
+	MsvTestReadinessModule module(m_spLoggerProvider, true, std::chrono::milliseconds(50));
+
+	EXPECT_EQ(module.Initialize(), MSV_SUCCESS);
+	EXPECT_EQ(module.Start(), MSV_SUCCESS);
+
+	//start returned before module is warm
+	EXPECT_TRUE(module.WaitForState(MsvModuleState::MSV_MODULE_STATE_RUNNING, std::chrono::milliseconds(0)));
+	EXPECT_FALSE(module.Ready());
+	EXPECT_TRUE(module.WaitForReady(std::chrono::seconds(10)));
+	EXPECT_TRUE(module.Ready());
+
+	EXPECT_EQ(module.Stop(), MSV_SUCCESS);
+	EXPECT_FALSE(module.Ready());
+
+	//readiness is signalled again after restart
+	EXPECT_EQ(module.Start(), MSV_SUCCESS);
+	EXPECT_TRUE(module.WaitForReady(std::chrono::seconds(10)));
+	EXPECT_EQ(module.Stop(), MSV_SUCCESS);
+	EXPECT_EQ(module.Uninitialize(), MSV_SUCCESS);
+}
+
+TEST_F(MsvModuleReadiness_Test, ItShouldStartDependent_WhenDependencyIsReady)
+{
+	MsvModuleManager moduleManager(m_spLogger);
+	std::shared_ptr<MsvTestReadinessModule> spDependency(new (std::nothrow) MsvTestReadinessModule(m_spLoggerProvider, true, std::chrono::milliseconds(50)));
+	std::shared_ptr<MsvTestReadinessModule> spDependent(new (std::nothrow) MsvTestReadinessModule(m_spLoggerProvider, false, std::chrono::milliseconds(0)));
+	EXPECT_NE(spDependency, nullptr);
+	EXPECT_NE(spDependent, nullptr);
+	spDependent->m_spDependency = spDependency;
+
+	int32_t dependencyId = static_cast<int32_t>(ModuleId::MSV_TEST_STATIC_MODULE);
+	int32_t dependentId = static_cast<int32_t>(ModuleId::MSV_TEST_OTHER_MODULE);
+	EXPECT_EQ(moduleManager.AddModule(dependencyId, spDependency, m_spModuleConfiguratorMock), MSV_SUCCESS);
+	EXPECT_EQ(moduleManager.AddModule(dependentId, spDependent, m_spModuleConfiguratorMock), MSV_SUCCESS);
+	EXPECT_EQ(moduleManager.AddModuleDependency(dependentId, dependencyId), MSV_SUCCESS);
+
+	EXPECT_EQ(moduleManager.Initialize(), MSV_SUCCESS);
+	EXPECT_EQ(moduleManager.Start(), MSV_SUCCESS);
+	EXPECT_TRUE(spDependent->m_dependencyReadyOnStart);
+	EXPECT_TRUE(moduleManager.Ready());
+
+	EXPECT_EQ(moduleManager.Stop(), MSV_SUCCESS);
+	EXPECT_EQ(moduleManager.Uninitialize(), MSV_SUCCESS);
+}
+
+TEST_F(MsvModuleReadiness_Test, ItShouldStartDependent_WhenDependencyDoesNotNotifyState)
+{
+	MsvModuleManager moduleManager(m_spLogger);
+	std::shared_ptr<MsvTestPlainModule> spDependency(new (std::nothrow) MsvTestPlainModule(m_spLoggerProvider));
+	std::shared_ptr<MsvTestPlainModule> spDependent(new (std::nothrow) MsvTestPlainModule(m_spLoggerProvider));
+	EXPECT_NE(spDependency, nullptr);
+	EXPECT_NE(spDependent, nullptr);
+
+	int32_t dependencyId = static_cast<int32_t>(ModuleId::MSV_TEST_STATIC_MODULE);
+	int32_t dependentId = static_cast<int32_t>(ModuleId::MSV_TEST_OTHER_MODULE);
+	EXPECT_EQ(moduleManager.AddModule(dependencyId, spDependency, m_spModuleConfiguratorMock), MSV_SUCCESS);
+	EXPECT_EQ(moduleManager.AddModule(dependentId, spDependent, m_spModuleConfiguratorMock), MSV_SUCCESS);
+	EXPECT_EQ(moduleManager.AddModuleDependency(dependentId, dependencyId), MSV_SUCCESS);
+	moduleManager.SetReadinessTimeout(std::chrono::seconds(10));
+
+	//running module is ready (start does not wait for readiness timeout)
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	EXPECT_EQ(moduleManager.Initialize(), MSV_SUCCESS);
+	EXPECT_EQ(moduleManager.Start(), MSV_SUCCESS);
+	EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(5));
+	EXPECT_TRUE(spDependency->Ready());
+	EXPECT_TRUE(spDependency->WaitForReady(std::chrono::milliseconds(0)));
+	EXPECT_TRUE(moduleManager.Ready());
+
+	EXPECT_EQ(moduleManager.Stop(), MSV_SUCCESS);
+	EXPECT_FALSE(spDependency->Ready());
+	EXPECT_EQ(moduleManager.Uninitialize(), MSV_SUCCESS);
+}
+
+TEST_F(MsvModuleReadiness_Test, ItShouldFailStart_WhenDependencyIsNotReadyInTime)
+{
+	MsvModuleManager moduleManager(m_spLogger);
+	std::shared_ptr<MsvTestReadinessModule> spDependency(new (std::nothrow) MsvTestReadinessModule(m_spLoggerProvider, true, std::chrono::milliseconds(-1)));
+	std::shared_ptr<MsvTestReadinessModule> spDependent(new (std::nothrow) MsvTestReadinessModule(m_spLoggerProvider, false, std::chrono::milliseconds(0)));
+	EXPECT_NE(spDependency, nullptr);
+	EXPECT_NE(spDependent, nullptr);
+
+	int32_t dependencyId = static_cast<int32_t>(ModuleId::MSV_TEST_STATIC_MODULE);
+	int32_t dependentId = static_cast<int32_t>(ModuleId::MSV_TEST_OTHER_MODULE);
+	EXPECT_EQ(moduleManager.AddModule(dependencyId, spDependency, m_spModuleConfiguratorMock), MSV_SUCCESS);
+	EXPECT_EQ(moduleManager.AddModule(dependentId, spDependent, m_spModuleConfiguratorMock), MSV_SUCCESS);
+	EXPECT_EQ(moduleManager.AddModuleDependency(dependentId, dependencyId), MSV_SUCCESS);
+	moduleManager.SetReadinessTimeout(std::chrono::milliseconds(20));
+
+	EXPECT_EQ(moduleManager.Initialize(), MSV_SUCCESS);
+	EXPECT_EQ(moduleManager.Start(), MSV_NOT_INITIALIZED_ERROR);
+	EXPECT_FALSE(moduleManager.Running());
+	EXPECT_FALSE(moduleManager.Ready());
+	EXPECT_FALSE(spDependency->Running());
+	EXPECT_FALSE(spDependent->Running());
+
+	EXPECT_EQ(moduleManager.Uninitialize(), MSV_SUCCESS);
+}
+
+TEST_F(MsvModuleReadiness_Test, ItShouldReportServing_WhenAllModulesAreReady)
+{
+	MsvModuleManager moduleManager(m_spLogger);
+	std::shared_ptr<MsvTestReadinessModule> spModule(new (std::nothrow) MsvTestReadinessModule(m_spLoggerProvider, true, std::chrono::milliseconds(50)));
+	EXPECT_NE(spModule, nullptr);
+
+	EXPECT_EQ(moduleManager.AddModule(static_cast<int32_t>(ModuleId::MSV_TEST_STATIC_MODULE), spModule, m_spModuleConfiguratorMock), MSV_SUCCESS);
+	EXPECT_FALSE(moduleManager.Ready());
+	EXPECT_FALSE(moduleManager.WaitForReady(std::chrono::milliseconds(0)));
+
+	EXPECT_EQ(moduleManager.Initialize(), MSV_SUCCESS);
+	EXPECT_EQ(moduleManager.Start(), MSV_SUCCESS);
+	EXPECT_FALSE(moduleManager.Ready());
+	EXPECT_TRUE(moduleManager.WaitForReady(std::chrono::seconds(10)));
+	EXPECT_TRUE(moduleManager.Ready());
+
+	EXPECT_EQ(moduleManager.Stop(), MSV_SUCCESS);
+	EXPECT_FALSE(moduleManager.Ready());
+	EXPECT_EQ(moduleManager.Uninitialize(), MSV_SUCCESS);
+}
+
+TEST_F(MsvModuleReadiness_Test, ItShouldServeModuleManagerCalls_WhenItWaitsForDependency)
+{
+	MsvModuleManager moduleManager(m_spLogger);
+	std::shared_ptr<MsvTestReadinessModule> spDependency(new (std::nothrow) MsvTestReadinessModule(m_spLoggerProvider, true, std::chrono::milliseconds(50)));
+	std::shared_ptr<MsvTestReadinessModule> spDependent(new (std::nothrow) MsvTestReadinessModule(m_spLoggerProvider, false, std::chrono::milliseconds(0)));
+	EXPECT_NE(spDependency, nullptr);
+	EXPECT_NE(spDependent, nullptr);
+	spDependency->m_pModuleManager = &moduleManager;
+	spDependent->m_spDependency = spDependency;
+
+	int32_t dependencyId = static_cast<int32_t>(ModuleId::MSV_TEST_STATIC_MODULE);
+	int32_t dependentId = static_cast<int32_t>(ModuleId::MSV_TEST_OTHER_MODULE);
+	EXPECT_EQ(moduleManager.AddModule(dependencyId, spDependency, m_spModuleConfiguratorMock), MSV_SUCCESS);
+	EXPECT_EQ(moduleManager.AddModule(dependentId, spDependent, m_spModuleConfiguratorMock), MSV_SUCCESS);
+	EXPECT_EQ(moduleManager.AddModuleDependency(dependentId, dependencyId), MSV_SUCCESS);
+	moduleManager.SetReadinessTimeout(std::chrono::seconds(10));
+
+	//warm up of dependency calls module manager while start waits for it (it would wait for readiness timeout when locked)
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	EXPECT_EQ(moduleManager.Initialize(), MSV_SUCCESS);
+	EXPECT_EQ(moduleManager.Start(), MSV_SUCCESS);
+	EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(5));
+	EXPECT_TRUE(spDependency->m_managerServedOnWarmUp);
+	EXPECT_TRUE(spDependent->m_dependencyReadyOnStart);
+
+	EXPECT_EQ(moduleManager.Stop(), MSV_SUCCESS);
+	EXPECT_EQ(moduleManager.Uninitialize(), MSV_SUCCESS);
+}
+
+TEST_F(MsvModuleReadiness_Test, ItShouldWaitForDependency_WhenReadinessTimeoutIsMax)
+{
+	MsvModuleManager moduleManager(m_spLogger);
+	std::shared_ptr<MsvTestReadinessModule> spDependency(new (std::nothrow) MsvTestReadinessModule(m_spLoggerProvider, true, std::chrono::milliseconds(50)));
+	std::shared_ptr<MsvTestReadinessModule> spDependent(new (std::nothrow) MsvTestReadinessModule(m_spLoggerProvider, false, std::chrono::milliseconds(0)));
+	EXPECT_NE(spDependency, nullptr);
+	EXPECT_NE(spDependent, nullptr);
+	spDependent->m_spDependency = spDependency;
+
+	int32_t dependencyId = static_cast<int32_t>(ModuleId::MSV_TEST_STATIC_MODULE);
+	int32_t dependentId = static_cast<int32_t>(ModuleId::MSV_TEST_OTHER_MODULE);
+	EXPECT_EQ(moduleManager.AddModule(dependencyId, spDependency, m_spModuleConfiguratorMock), MSV_SUCCESS);
+	EXPECT_EQ(moduleManager.AddModule(dependentId, spDependent, m_spModuleConfiguratorMock), MSV_SUCCESS);
+	EXPECT_EQ(moduleManager.AddModuleDependency(dependentId, dependencyId), MSV_SUCCESS);
+
+	//deadline does not overflow (dependency would not be ready in time)
+	moduleManager.SetReadinessTimeout(std::chrono::milliseconds::max());
+
+	EXPECT_EQ(moduleManager.Initialize(), MSV_SUCCESS);
+	EXPECT_EQ(moduleManager.Start(), MSV_SUCCESS);
+	EXPECT_TRUE(spDependent->m_dependencyReadyOnStart);
+
+	EXPECT_EQ(moduleManager.Stop(), MSV_SUCCESS);
+	EXPECT_EQ(moduleManager.Uninitialize(), MSV_SUCCESS);
+}
+
+TEST_F(MsvModuleReadiness_Test, ItShouldWaitForServing_WhenTimeoutIsMax)
+{
+	MsvModuleManager moduleManager(m_spLogger);
+	std::shared_ptr<MsvTestReadinessModule> spModule(new (std::nothrow) MsvTestReadinessModule(m_spLoggerProvider, true, std::chrono::milliseconds(50)));
+	EXPECT_NE(spModule, nullptr);
+
+	EXPECT_EQ(moduleManager.AddModule(static_cast<int32_t>(ModuleId::MSV_TEST_STATIC_MODULE), spModule, m_spModuleConfiguratorMock), MSV_SUCCESS);
+	EXPECT_EQ(moduleManager.Initialize(), MSV_SUCCESS);
+	EXPECT_EQ(moduleManager.Start(), MSV_SUCCESS);
+
+	//deadline does not overflow (module manager would not be ready in time)
+	EXPECT_TRUE(moduleManager.WaitForReady(std::chrono::milliseconds::max()));
+
+	EXPECT_EQ(moduleManager.Stop(), MSV_SUCCESS);
+	EXPECT_EQ(moduleManager.Uninitialize(), MSV_SUCCESS);
+}
@@ -0,0 +1,334 @@
+
+
+#include "pch.h"
+
+#include "mmodule/MsvModuleLifecycle.h"
+#include "mmodule/MsvModuleManager.h"
+#include "mmodule/MsvModuleRetry.h"
+
+#include "mmodule/Mocks/MsvModuleConfigurator_Mock.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+MSV_ENABLE_WARNINGS
+
+
+using namespace ::testing;
+
+
+class MsvTestFlakyModule:
+	public MsvModuleLifecycle<MsvTestFlakyModule, MsvModuleBase>
+{
+public:
+	MsvTestFlakyModule(std::shared_ptr<IMsvLoggerProvider> spLoggerProvider, int32_t failureCount):
+		MsvModuleLifecycle(spLoggerProvider, "MsvModuleRetry_Test"),
+		m_failureCount(failureCount),
+		m_initializeCount(0)
+	{
+
+	}
+
+	MsvErrorCode OnInitialize()
+	{
+		return ++m_initializeCount > m_failureCount ? MSV_SUCCESS : MSV_NOT_INITIALIZED_ERROR;
+	}
+
+	int32_t m_failureCount;
+	std::atomic<int32_t> m_initializeCount;
+};
+
+
+//module which writes its transitions to shared log (the first initializes fail)
+class MsvTestOrderedModule:
+	public MsvModuleLifecycle<MsvTestOrderedModule, MsvModuleBase>
+{
+public:
+	MsvTestOrderedModule(std::shared_ptr<IMsvLoggerProvider> spLoggerProvider, int32_t moduleId, int32_t failureCount, std::mutex& logLock, std::vector<std::string>& transitions):
+		MsvModuleLifecycle(spLoggerProvider, "MsvModuleRetry_Test"),
+		m_moduleId(moduleId),
+		m_failureCount(failureCount),
+		m_logLock(logLock),
+		m_transitions(transitions)
+	{
+
+	}
+
+	MsvErrorCode OnInitialize()
+	{
+		if (m_failureCount > 0)
+		{
+			--m_failureCount;
+			return MSV_NOT_INITIALIZED_ERROR;
+		}
+
+		return Transition("Initialize");
+	}
+
+	MsvErrorCode OnStart() { return Transition("Start"); }
+
+	MsvErrorCode Transition(const char* transition)
+	{
+		std::lock_guard<std::mutex> lock(m_logLock);
+		m_transitions.push_back(std::string(transition) + " " + std::to_string(m_moduleId));
+		return MSV_SUCCESS;
+	}
+
+	int32_t m_moduleId;
+	int32_t m_failureCount;
+	std::mutex& m_logLock;
+	std::vector<std::string>& m_transitions;
+};
+
+
+class MsvModuleRetry_Test:
+	public MsvModule_TestBase
+{
+public:
+	virtual void SetUp()
+	{
+		InitializeLogging();
+
+		m_policy = MSV_RETRY_DEFAULT_POLICY;
+		m_policy.initialDelay = std::chrono::milliseconds(1);
+		m_policy.maxDelay = std::chrono::milliseconds(4);
+	}
+
+	virtual void TearDown()
+	{
+		UninitializeLogging();
+	}
+
+	//waits until retry of module is finished (or breaker is open)
+	bool WaitForRetry(const MsvModuleRetry& moduleRetry, int32_t moduleId, bool breakerOpen)
+	{
+		std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+		while (std::chrono::steady_clock::now() < deadline)
+		{
+			MsvModuleRetryState state;
+			MsvErrorCode errorCode = moduleRetry.GetRetryState(moduleId, state);
+			if (breakerOpen ? (MSV_SUCCEEDED(errorCode) && state.breakerOpen) : errorCode == MSV_NOT_FOUND_ERROR)
+			{
+				return true;
+			}
+
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+
+		return false;
+	}
+
+	MsvRetryPolicy m_policy;
+};
+
+
+/*-----------------------------------------------------------------------------------------------------
+**											Backoff Tests
+**---------------------------------------------------------------------------------------------------*/
+
+
+TEST_F(MsvModuleRetry_Test, ItShouldDoubleDelayUpToMaxDelay_WhenRetryFails)
+{
+	MsvRetryPolicy policy = MSV_RETRY_DEFAULT_POLICY;
+	policy.initialDelay = std::chrono::milliseconds(100);
+	policy.maxDelay = std::chrono::milliseconds(1000);
+	policy.jitter = 0.0;
+
+	EXPECT_EQ(MsvModuleRetry::GetBackoffDelay(policy, 1, 0.5), std::chrono::milliseconds(100));
+	EXPECT_EQ(MsvModuleRetry::GetBackoffDelay(policy, 2, 0.5), std::chrono::milliseconds(200));
+	EXPECT_EQ(MsvModuleRetry::GetBackoffDelay(policy, 4, 0.5), std::chrono::milliseconds(800));
+	EXPECT_EQ(MsvModuleRetry::GetBackoffDelay(policy, 5, 0.5), std::chrono::milliseconds(1000));
+	EXPECT_EQ(MsvModuleRetry::GetBackoffDelay(policy, 1000, 0.5), std::chrono::milliseconds(1000));
+}
+
+TEST_F(MsvModuleRetry_Test, ItShouldRandomizePartOfDelay_WhenJitterIsSet)
+{
+	MsvRetryPolicy policy = MSV_RETRY_DEFAULT_POLICY;
+	policy.initialDelay = std::chrono::milliseconds(100);
+	policy.maxDelay = std::chrono::milliseconds(1000);
+	policy.jitter = 0.5;
+
+	EXPECT_EQ(MsvModuleRetry::GetBackoffDelay(policy, 2, 0.0), std::chrono::milliseconds(200));
+	EXPECT_EQ(MsvModuleRetry::GetBackoffDelay(policy, 2, 0.5), std::chrono::milliseconds(150));
+	EXPECT_GT(MsvModuleRetry::GetBackoffDelay(policy, 2, 0.999), std::chrono::milliseconds(99));
+}
+
+TEST_F(MsvModuleRetry_Test, ItShouldFailSetPolicy_WhenPolicyIsInvalid)
+{
+	MsvModuleRetry moduleRetry([](int32_t) { return MSV_SUCCESS; }, m_spLogger);
+
+	MsvRetryPolicy policy = m_policy;
+	policy.initialDelay = std::chrono::milliseconds(0);
+	EXPECT_EQ(moduleRetry.SetPolicy(policy), MSV_INVALID_DATA_ERROR);
+
+	policy = m_policy;
+	policy.jitter = 1.5;
+	EXPECT_EQ(moduleRetry.SetPolicy(policy), MSV_INVALID_DATA_ERROR);
+
+	EXPECT_EQ(moduleRetry.SetPolicy(m_policy), MSV_SUCCESS);
+}
+
+
+/*-----------------------------------------------------------------------------------------------------
+**											Retry Tests
+**---------------------------------------------------------------------------------------------------*/
+
+
+TEST_F(MsvModuleRetry_Test, ItShouldRetryModule_UntilRetrySucceeds)
+{
+	std::atomic<int32_t> retryCount(0);
+	MsvModuleRetry moduleRetry([&retryCount](int32_t) { return ++retryCount < 3 ? MSV_NOT_INITIALIZED_ERROR : MSV_SUCCESS; }, m_spLogger);
+	EXPECT_EQ(moduleRetry.SetPolicy(m_policy), MSV_SUCCESS);
+
+	EXPECT_EQ(moduleRetry.Schedule(1), MSV_SUCCESS);
+	EXPECT_EQ(moduleRetry.Schedule(1), MSV_ALREADY_EXISTS_ERROR);
+	EXPECT_TRUE(WaitForRetry(moduleRetry, 1, false));
+	EXPECT_EQ(retryCount.load(), 3);
+}
+
+TEST_F(MsvModuleRetry_Test, ItShouldOpenCircuitBreaker_WhenModuleFlaps)
+{
+	std::atomic<int32_t> retryCount(0);
+	MsvModuleRetry moduleRetry([&retryCount](int32_t) { ++retryCount; return MSV_NOT_INITIALIZED_ERROR; }, m_spLogger);
+	m_policy.breakerThreshold = 3;
+	m_policy.breakerWindow = std::chrono::seconds(10);
+	m_policy.breakerCooldown = std::chrono::seconds(10);
+	EXPECT_EQ(moduleRetry.SetPolicy(m_policy), MSV_SUCCESS);
+
+	//initial failure and two failed retries open breaker
+	EXPECT_EQ(moduleRetry.Schedule(1), MSV_SUCCESS);
+	EXPECT_TRUE(WaitForRetry(moduleRetry, 1, true));
+
+	std::this_thread::sleep_for(std::chrono::milliseconds(50));
+	EXPECT_EQ(retryCount.load(), 2);
+
+	MsvModuleRetryState state;
+	EXPECT_EQ(moduleRetry.GetRetryState(1, state), MSV_SUCCESS);
+	EXPECT_EQ(state.failureCount, 3u);
+	EXPECT_GT(state.nextRetry, std::chrono::steady_clock::now() + std::chrono::seconds(5));
+
+	moduleRetry.Cancel(1);
+	EXPECT_EQ(moduleRetry.GetRetryState(1, state), MSV_NOT_FOUND_ERROR);
+}
+
+TEST_F(MsvModuleRetry_Test, ItShouldStartNonCriticalModule_WhenItRecoversInBackground)
+{
+	MsvModuleManager moduleManager(m_spLogger);
+	std::shared_ptr<MsvModuleConfigurator_Mock> spModuleConfiguratorMock(new (std::nothrow) MsvModuleConfigurator_Mock());
+	std::shared_ptr<MsvTestFlakyModule> spModule(new (std::nothrow) MsvTestFlakyModule(m_spLoggerProvider, 2));
+	EXPECT_NE(spModuleConfiguratorMock, nullptr);
+	EXPECT_NE(spModule, nullptr);
+
+	EXPECT_CALL(*spModuleConfiguratorMock, IsInstalled(Matcher<bool&>(_)))
+		.WillRepeatedly(DoAll(SetArgReferee<0>(true), Return(MSV_SUCCESS)));
+	EXPECT_CALL(*spModuleConfiguratorMock, IsEnabled(Matcher<bool&>(_)))
+		.WillRepeatedly(DoAll(SetArgReferee<0>(true), Return(MSV_SUCCESS)));
+
+	int32_t moduleId = static_cast<int32_t>(ModuleId::MSV_TEST_STATIC_MODULE);
+	EXPECT_EQ(moduleManager.AddModule(moduleId, spModule, spModuleConfiguratorMock), MSV_SUCCESS);
+	moduleManager.SetModuleCritical(moduleId, false);
+	EXPECT_EQ(moduleManager.GetModuleRetry()->SetPolicy(m_policy), MSV_SUCCESS);
+
+	//module manager is running while module is retried
+	EXPECT_EQ(moduleManager.Initialize(), MSV_SUCCESS);
+	EXPECT_EQ(moduleManager.Start(), MSV_SUCCESS);
+
+	EXPECT_TRUE(spModule->WaitForState(MsvModuleState::MSV_MODULE_STATE_RUNNING, std::chrono::seconds(10)));
+	EXPECT_EQ(spModule->m_initializeCount.load(), 3);
+
+	EXPECT_EQ(moduleManager.Stop(), MSV_SUCCESS);
+	EXPECT_EQ(moduleManager.Uninitialize(), MSV_SUCCESS);
+}
+
+TEST_F(MsvModuleRetry_Test, ItShouldFailInitialize_WhenCriticalModuleFails)
+{
+	MsvModuleManager moduleManager(m_spLogger);
+	std::shared_ptr<MsvModuleConfigurator_Mock> spModuleConfiguratorMock(new (std::nothrow) MsvModuleConfigurator_Mock());
+	std::shared_ptr<MsvTestFlakyModule> spModule(new (std::nothrow) MsvTestFlakyModule(m_spLoggerProvider, 1));
+	EXPECT_NE(spModuleConfiguratorMock, nullptr);
+	EXPECT_NE(spModule, nullptr);
+
+	EXPECT_CALL(*spModuleConfiguratorMock, IsInstalled(Matcher<bool&>(_)))
+		.WillRepeatedly(DoAll(SetArgReferee<0>(true), Return(MSV_SUCCESS)));
+	EXPECT_CALL(*spModuleConfiguratorMock, IsEnabled(Matcher<bool&>(_)))
+		.WillRepeatedly(DoAll(SetArgReferee<0>(true), Return(MSV_SUCCESS)));
+
+	int32_t moduleId = static_cast<int32_t>(ModuleId::MSV_TEST_STATIC_MODULE);
+	EXPECT_EQ(moduleManager.AddModule(moduleId, spModule, spModuleConfiguratorMock), MSV_SUCCESS);
+
+	MsvModuleRetryState state;
+	EXPECT_EQ(moduleManager.Initialize(), MSV_NOT_INITIALIZED_ERROR);
+	EXPECT_EQ(moduleManager.GetModuleRetry()->GetRetryState(moduleId, state), MSV_NOT_FOUND_ERROR);
+}
+
+TEST_F(MsvModuleRetry_Test, ItShouldBringUpDependentsInOrder_WhenRetriedModuleRecovers)
+{
+	MsvModuleManager moduleManager(m_spLogger);
+	std::shared_ptr<MsvModuleConfigurator_Mock> spModuleConfiguratorMock(new (std::nothrow) MsvModuleConfigurator_Mock());
+	EXPECT_NE(spModuleConfiguratorMock, nullptr);
+
+	EXPECT_CALL(*spModuleConfiguratorMock, IsInstalled(Matcher<bool&>(_)))
+		.WillRepeatedly(DoAll(SetArgReferee<0>(true), Return(MSV_SUCCESS)));
+	EXPECT_CALL(*spModuleConfiguratorMock, IsEnabled(Matcher<bool&>(_)))
+		.WillRepeatedly(DoAll(SetArgReferee<0>(true), Return(MSV_SUCCESS)));
+
+	//dependent -> middle -> failing
+	std::mutex logLock;
+	std::vector<std::string> transitions;
+	int32_t failingId = static_cast<int32_t>(ModuleId::MSV_TEST_STATIC_MODULE);
+	int32_t middleId = static_cast<int32_t>(ModuleId::MSV_TEST_DYNAMIC_MODULE);
+	int32_t dependentId = static_cast<int32_t>(ModuleId::MSV_TEST_OTHER_MODULE);
+	std::shared_ptr<MsvTestOrderedModule> spFailing(new (std::nothrow) MsvTestOrderedModule(m_spLoggerProvider, failingId, 1, logLock, transitions));
+	std::shared_ptr<MsvTestOrderedModule> spMiddle(new (std::nothrow) MsvTestOrderedModule(m_spLoggerProvider, middleId, 0, logLock, transitions));
+	std::shared_ptr<MsvTestOrderedModule> spDependent(new (std::nothrow) MsvTestOrderedModule(m_spLoggerProvider, dependentId, 0, logLock, transitions));
+	EXPECT_NE(spFailing, nullptr);
+	EXPECT_NE(spMiddle, nullptr);
+	EXPECT_NE(spDependent, nullptr);
+
+	EXPECT_EQ(moduleManager.AddModule(failingId, spFailing, spModuleConfiguratorMock), MSV_SUCCESS);
+	EXPECT_EQ(moduleManager.AddModule(middleId, spMiddle, spModuleConfiguratorMock), MSV_SUCCESS);
+	EXPECT_EQ(moduleManager.AddModule(dependentId, spDependent, spModuleConfiguratorMock), MSV_SUCCESS);
+	EXPECT_EQ(moduleManager.AddModuleDependency(middleId, failingId), MSV_SUCCESS);
+	EXPECT_EQ(moduleManager.AddModuleDependency(dependentId, middleId), MSV_SUCCESS);
+	moduleManager.SetModuleCritical(failingId, false);
+	moduleManager.SetModuleCritical(middleId, false);
+	moduleManager.SetModuleCritical(dependentId, false);
+
+	//retry is delayed (dependents are checked before failed module recovers)
+	m_policy.initialDelay = std::chrono::milliseconds(200);
+	m_policy.maxDelay = std::chrono::milliseconds(200);
+	m_policy.jitter = 0.0;
+	EXPECT_EQ(moduleManager.GetModuleRetry()->SetPolicy(m_policy), MSV_SUCCESS);
+
+	EXPECT_EQ(moduleManager.Initialize(), MSV_SUCCESS);
+	EXPECT_EQ(moduleManager.Start(), MSV_SUCCESS);
+	EXPECT_FALSE(spFailing->Initialized());
+	EXPECT_FALSE(spMiddle->Initialized());
+	EXPECT_FALSE(spDependent->Initialized());
+
+	std::vector<MsvModuleStartResult> startResults;
+	moduleManager.GetStartResults(startResults);
+	EXPECT_EQ(startResults.size(), 3u);
+	for (std::vector<MsvModuleStartResult>::const_iterator it = startResults.begin(); it != startResults.end(); ++it)
+	{
+		EXPECT_EQ(it->status, MsvModuleStartStatus::MSV_MODULE_START_NOT_INITIALIZED);
+		EXPECT_EQ(it->causeId, failingId);
+	}
+
+	//recovered module is started before its dependents are initialized
+	EXPECT_TRUE(spDependent->WaitForState(MsvModuleState::MSV_MODULE_STATE_RUNNING, std::chrono::seconds(10)));
+	{
+		std::lock_guard<std::mutex> lock(logLock);
+		std::vector<std::string> expectedTransitions = { "Initialize 0", "Start 0", "Initialize 1", "Start 1", "Initialize 2", "Start 2" };
+		EXPECT_EQ(transitions, expectedTransitions);
+	}
+
+	EXPECT_EQ(moduleManager.Stop(), MSV_SUCCESS);
+	EXPECT_EQ(moduleManager.Uninitialize(), MSV_SUCCESS);
+}
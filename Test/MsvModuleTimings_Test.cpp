@@ -0,0 +1,91 @@
+
+
+#include "pch.h"
+
+#include "mmodule/MsvModuleTimings.h"
+
+
+using namespace ::testing;
+
+
+class MsvModuleTimings_Test:
+	public MsvModule_TestBase
+{
+public:
+	virtual void SetUp()
+	{
+		m_spModuleTimings.reset(new (std::nothrow) MsvModuleTimings());
+		EXPECT_NE(m_spModuleTimings, nullptr);
+	}
+
+	virtual void TearDown()
+	{
+		m_spModuleTimings.reset();
+	}
+
+	//tested classes
+	std::shared_ptr<MsvModuleTimings> m_spModuleTimings;
+};
+
+
+/*-----------------------------------------------------------------------------------------------------
+**											Record Tests
+**---------------------------------------------------------------------------------------------------*/
+
+
+TEST_F(MsvModuleTimings_Test, ItShouldReturnNotFound_WhenNothingRecorded)
+{
+	MsvModuleTransitionStatistics statistics;
+	EXPECT_EQ(m_spModuleTimings->GetStatistics(1, MsvModuleTransition::MSV_MODULE_TRANSITION_START, statistics), MSV_NOT_FOUND_ERROR);
+	EXPECT_EQ(m_spModuleTimings->GetLastDuration(1, MsvModuleTransition::MSV_MODULE_TRANSITION_START), std::chrono::nanoseconds::zero());
+}
+
+TEST_F(MsvModuleTimings_Test, ItShouldFail_WhenTransitionIsInvalid)
+{
+	MsvModuleTransitionStatistics statistics;
+	EXPECT_EQ(m_spModuleTimings->GetStatistics(1, MsvModuleTransition::MSV_MODULE_TRANSITION_COUNT, statistics), MSV_INVALID_DATA_ERROR);
+}
+
+TEST_F(MsvModuleTimings_Test, ItShouldAggregate_WhenTransitionRecordedMoreTimes)
+{
+	m_spModuleTimings->Record(1, MsvModuleTransition::MSV_MODULE_TRANSITION_START, std::chrono::microseconds(10), MSV_SUCCESS);
+	m_spModuleTimings->Record(1, MsvModuleTransition::MSV_MODULE_TRANSITION_START, std::chrono::microseconds(1), MSV_SUCCESS);
+	m_spModuleTimings->Record(1, MsvModuleTransition::MSV_MODULE_TRANSITION_START, std::chrono::microseconds(100), MSV_NOT_INITIALIZED_ERROR);
+
+	MsvModuleTransitionStatistics statistics;
+	EXPECT_EQ(m_spModuleTimings->GetStatistics(1, MsvModuleTransition::MSV_MODULE_TRANSITION_START, statistics), MSV_SUCCESS);
+	EXPECT_EQ(statistics.count, 3u);
+	EXPECT_EQ(statistics.failures, 1u);
+	EXPECT_EQ(statistics.lastErrorCode, MSV_NOT_INITIALIZED_ERROR);
+	EXPECT_EQ(statistics.last, std::chrono::microseconds(100));
+	EXPECT_EQ(statistics.min, std::chrono::microseconds(1));
+	EXPECT_EQ(statistics.max, std::chrono::microseconds(100));
+	EXPECT_EQ(statistics.total, std::chrono::microseconds(111));
+	EXPECT_EQ(statistics.histogram[0], 1u);
+	EXPECT_EQ(statistics.histogram[3], 1u);
+	EXPECT_EQ(statistics.histogram[6], 1u);
+
+	//other transitions are not recorded
+	EXPECT_EQ(m_spModuleTimings->GetStatistics(1, MsvModuleTransition::MSV_MODULE_TRANSITION_STOP, statistics), MSV_NOT_FOUND_ERROR);
+}
+
+TEST_F(MsvModuleTimings_Test, ItShouldBeEmpty_AfterReset)
+{
+	m_spModuleTimings->Record(1, MsvModuleTransition::MSV_MODULE_TRANSITION_INITIALIZE, std::chrono::microseconds(10), MSV_SUCCESS);
+	m_spModuleTimings->Record(2, MsvModuleTransition::MSV_MODULE_TRANSITION_INITIALIZE, std::chrono::microseconds(10), MSV_SUCCESS);
+
+	std::vector<int32_t> moduleIds;
+	m_spModuleTimings->GetModuleIds(moduleIds);
+	EXPECT_EQ(moduleIds.size(), 2u);
+
+	m_spModuleTimings->Reset();
+	m_spModuleTimings->GetModuleIds(moduleIds);
+	EXPECT_TRUE(moduleIds.empty());
+}
+
+TEST_F(MsvModuleTimings_Test, ItShouldUseLastBucket_WhenDurationIsLong)
+{
+	EXPECT_EQ(MsvModuleTimings::GetBucket(std::chrono::nanoseconds(500)), 0u);
+	EXPECT_EQ(MsvModuleTimings::GetBucket(std::chrono::microseconds(2)), 1u);
+	EXPECT_EQ(MsvModuleTimings::GetBucket(std::chrono::hours(1)), MSV_MODULE_TIMING_BUCKETS - 1);
+}
@@ -0,0 +1,226 @@
+
+
+#include "pch.h"
+
+#if !defined(_WIN32)
+
+#include "mmodule/MsvPosixDllFactory.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <atomic>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+MSV_ENABLE_WARNINGS
+
+
+using namespace ::testing;
+
+
+//DLL object exported by test shared library (Test/TestDll/MsvTestDll.cpp)
+const char* const MSV_TEST_DLL_OBJECT_ID = "{0E4B4C5A-7E0C-4F6B-9D2A-3C1B5A6D7E8F}";
+const char* const MSV_OTHER_TEST_DLL_OBJECT_ID = "{6C2D8E1F-4A3B-4D5C-8E7F-9A0B1C2D3E4F}";
+
+
+class MsvPosixDllFactory_Test:
+	public MsvModule_TestBase
+{
+public:
+	virtual void SetUp()
+	{
+		InitializeLogging();
+
+		//test shared library is built next to tests (path can be overridden by environment)
+		const char* testDllPath = getenv("MSV_TEST_DLL_PATH");
+		m_testDllPath = testDllPath ? testDllPath : "./libMsvTestDll.so";
+	}
+
+	virtual void TearDown()
+	{
+		UninitializeLogging();
+	}
+
+	void LoadTestDll(MsvDllBinding binding)
+	{
+		MsvPosixDllFactory dllFactory(m_spLogger, binding);
+		EXPECT_EQ(dllFactory.AddDllObject(MSV_TEST_DLL_OBJECT_ID, m_testDllPath.c_str()), MSV_SUCCESS);
+
+		MsvDllLoadStatistics statistics;
+		EXPECT_EQ(dllFactory.GetDllLoadStatistics(m_testDllPath.c_str(), statistics), MSV_SUCCESS);
+		EXPECT_FALSE(statistics.loaded);
+		EXPECT_EQ(statistics.binding, binding);
+		EXPECT_EQ(statistics.firstCallDuration, std::chrono::nanoseconds::zero());
+		EXPECT_EQ(statistics.objectCount, 0u);
+
+		//each get creates new object (library and its function are loaded once)
+		std::shared_ptr<IMsvDllObject> spDllObject1;
+		std::shared_ptr<IMsvDllObject> spDllObject2;
+		EXPECT_EQ(dllFactory.GetDllObject(MSV_TEST_DLL_OBJECT_ID, spDllObject1), MSV_SUCCESS);
+		EXPECT_NE(spDllObject1, nullptr);
+
+		EXPECT_EQ(dllFactory.GetDllLoadStatistics(m_testDllPath.c_str(), statistics), MSV_SUCCESS);
+		std::chrono::nanoseconds firstCallDuration = statistics.firstCallDuration;
+		EXPECT_TRUE(statistics.loaded);
+		EXPECT_GT(statistics.loadDuration, std::chrono::nanoseconds::zero());
+		EXPECT_GT(firstCallDuration, std::chrono::nanoseconds::zero());
+		EXPECT_EQ(statistics.objectCount, 1u);
+
+		EXPECT_EQ(dllFactory.GetDllObject(MSV_TEST_DLL_OBJECT_ID, spDllObject2), MSV_SUCCESS);
+		EXPECT_NE(spDllObject2, nullptr);
+		EXPECT_NE(spDllObject1, spDllObject2);
+
+		EXPECT_EQ(dllFactory.GetDllLoadStatistics(m_testDllPath.c_str(), statistics), MSV_SUCCESS);
+		EXPECT_EQ(statistics.firstCallDuration, firstCallDuration);
+		EXPECT_EQ(statistics.objectCount, 2u);
+
+		//objects must be released before factory unloads shared library
+		spDllObject1.reset();
+		spDllObject2.reset();
+	}
+
+	std::string m_testDllPath;
+};
+
+
+/*-----------------------------------------------------------------------------------------------------
+**											AddDllObject Tests
+**---------------------------------------------------------------------------------------------------*/
+
+
+TEST_F(MsvPosixDllFactory_Test, ItShouldFail_WhenDllObjectIdOrPathIsEmpty)
+{
+	MsvPosixDllFactory dllFactory(m_spLogger);
+
+	EXPECT_EQ(dllFactory.AddDllObject(nullptr, m_testDllPath.c_str()), MSV_INVALID_DATA_ERROR);
+	EXPECT_EQ(dllFactory.AddDllObject(MSV_TEST_DLL_OBJECT_ID, nullptr), MSV_INVALID_DATA_ERROR);
+	EXPECT_EQ(dllFactory.AddDllObject(MSV_TEST_DLL_OBJECT_ID, ""), MSV_INVALID_DATA_ERROR);
+}
+
+TEST_F(MsvPosixDllFactory_Test, ItShouldFail_WhenDllObjectIdAlreadyExists)
+{
+	MsvPosixDllFactory dllFactory(m_spLogger);
+
+	EXPECT_EQ(dllFactory.AddDllObject(MSV_TEST_DLL_OBJECT_ID, m_testDllPath.c_str()), MSV_SUCCESS);
+	EXPECT_EQ(dllFactory.AddDllObject(MSV_TEST_DLL_OBJECT_ID, m_testDllPath.c_str()), MSV_ALREADY_EXISTS_ERROR);
+
+	std::string dllPath;
+	EXPECT_EQ(dllFactory.GetDllPath(MSV_TEST_DLL_OBJECT_ID, dllPath), MSV_SUCCESS);
+	EXPECT_EQ(dllPath, m_testDllPath);
+}
+
+TEST_F(MsvPosixDllFactory_Test, ItShouldFail_WhenDllRegisteredWithAnotherBinding)
+{
+	MsvPosixDllFactory dllFactory(m_spLogger, MsvDllBinding::MSV_DLL_BINDING_LAZY);
+
+	EXPECT_EQ(dllFactory.AddDllObject(MSV_TEST_DLL_OBJECT_ID, m_testDllPath.c_str()), MSV_SUCCESS);
+	EXPECT_EQ(dllFactory.AddDllObject(MSV_OTHER_TEST_DLL_OBJECT_ID, m_testDllPath.c_str(), MsvDllBinding::MSV_DLL_BINDING_NOW), MSV_INVALID_DATA_ERROR);
+	EXPECT_EQ(dllFactory.AddDllObject(MSV_OTHER_TEST_DLL_OBJECT_ID, m_testDllPath.c_str(), MsvDllBinding::MSV_DLL_BINDING_LAZY), MSV_SUCCESS);
+
+	//binding of registered shared library is not changed
+	MsvDllLoadStatistics statistics;
+	EXPECT_EQ(dllFactory.GetDllLoadStatistics(m_testDllPath.c_str(), statistics), MSV_SUCCESS);
+	EXPECT_EQ(statistics.binding, MsvDllBinding::MSV_DLL_BINDING_LAZY);
+}
+
+
+/*-----------------------------------------------------------------------------------------------------
+**											GetDllObject Tests
+**---------------------------------------------------------------------------------------------------*/
+
+
+TEST_F(MsvPosixDllFactory_Test, ItShouldFail_WhenDllObjectIsNotRegistered)
+{
+	MsvPosixDllFactory dllFactory(m_spLogger);
+
+	std::shared_ptr<IMsvDllObject> spDllObject;
+	EXPECT_EQ(dllFactory.GetDllObject(MSV_TEST_DLL_OBJECT_ID, spDllObject), MSV_NOT_FOUND_ERROR);
+	EXPECT_EQ(spDllObject, nullptr);
+}
+
+TEST_F(MsvPosixDllFactory_Test, ItShouldFail_WhenDllDoesNotExist)
+{
+	MsvPosixDllFactory dllFactory(m_spLogger);
+	EXPECT_EQ(dllFactory.AddDllObject(MSV_TEST_DLL_OBJECT_ID, "./libMsvMissingTestDll.so"), MSV_SUCCESS);
+
+	std::shared_ptr<IMsvDllObject> spDllObject;
+	EXPECT_EQ(dllFactory.GetDllObject(MSV_TEST_DLL_OBJECT_ID, spDllObject), MSV_NOT_FOUND_ERROR);
+
+	MsvDllLoadStatistics statistics;
+	EXPECT_EQ(dllFactory.GetDllLoadStatistics("./libMsvMissingTestDll.so", statistics), MSV_SUCCESS);
+	EXPECT_FALSE(statistics.loaded);
+}
+
+TEST_F(MsvPosixDllFactory_Test, ItShouldFail_WhenDllDoesNotExportFunction)
+{
+	MsvPosixDllFactory dllFactory(m_spLogger, MsvDllBinding::MSV_DLL_BINDING_LAZY, true, "MsvMissingGetDllObject");
+	EXPECT_EQ(dllFactory.AddDllObject(MSV_TEST_DLL_OBJECT_ID, m_testDllPath.c_str()), MSV_SUCCESS);
+
+	std::shared_ptr<IMsvDllObject> spDllObject;
+	EXPECT_EQ(dllFactory.GetDllObject(MSV_TEST_DLL_OBJECT_ID, spDllObject), MSV_NOT_FOUND_ERROR);
+
+	//shared library has been loaded
+	MsvDllLoadStatistics statistics;
+	EXPECT_EQ(dllFactory.GetDllLoadStatistics(m_testDllPath.c_str(), statistics), MSV_SUCCESS);
+	EXPECT_TRUE(statistics.loaded);
+	EXPECT_EQ(statistics.objectCount, 0u);
+}
+
+TEST_F(MsvPosixDllFactory_Test, ItShouldFail_WhenDllObjectIsNotInDll)
+{
+	MsvPosixDllFactory dllFactory(m_spLogger);
+	EXPECT_EQ(dllFactory.AddDllObject(MSV_OTHER_TEST_DLL_OBJECT_ID, m_testDllPath.c_str()), MSV_SUCCESS);
+
+	std::shared_ptr<IMsvDllObject> spDllObject;
+	EXPECT_EQ(dllFactory.GetDllObject(MSV_OTHER_TEST_DLL_OBJECT_ID, spDllObject), MSV_NOT_FOUND_ERROR);
+}
+
+TEST_F(MsvPosixDllFactory_Test, ItShouldLoadDll_WhenLazyBinding)
+{
+	LoadTestDll(MsvDllBinding::MSV_DLL_BINDING_LAZY);
+}
+
+TEST_F(MsvPosixDllFactory_Test, ItShouldLoadDll_WhenNowBinding)
+{
+	LoadTestDll(MsvDllBinding::MSV_DLL_BINDING_NOW);
+}
+
+TEST_F(MsvPosixDllFactory_Test, ItShouldGetDllObjects_WhenCalledFromMoreThreads)
+{
+	MsvPosixDllFactory dllFactory(m_spLogger);
+	EXPECT_EQ(dllFactory.AddDllObject(MSV_TEST_DLL_OBJECT_ID, m_testDllPath.c_str()), MSV_SUCCESS);
+
+	//objects are created out of factory lock (statistics are still consistent)
+	std::atomic<int> objectCount(0);
+	std::vector<std::thread> threads;
+	for (int i = 0; i < 4; ++i)
+	{
+		threads.emplace_back([&dllFactory, &objectCount]()
+		{
+			for (int j = 0; j < 50; ++j)
+			{
+				std::shared_ptr<IMsvDllObject> spDllObject;
+				if (dllFactory.GetDllObject(MSV_TEST_DLL_OBJECT_ID, spDllObject) == MSV_SUCCESS && spDllObject)
+				{
+					++objectCount;
+				}
+			}
+		});
+	}
+
+	for (std::vector<std::thread>::iterator it = threads.begin(); it != threads.end(); ++it)
+	{
+		it->join();
+	}
+
+	MsvDllLoadStatistics statistics;
+	EXPECT_EQ(dllFactory.GetDllLoadStatistics(m_testDllPath.c_str(), statistics), MSV_SUCCESS);
+	EXPECT_EQ(objectCount.load(), 200);
+	EXPECT_EQ(statistics.objectCount, 200u);
+	EXPECT_GT(statistics.firstCallDuration, std::chrono::nanoseconds::zero());
+}
+
+
+#endif // !defined(_WIN32)
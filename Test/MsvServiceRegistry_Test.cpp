@@ -0,0 +1,284 @@
+
+
+#include "pch.h"
+
+#include "mmodule/MsvModuleLifecycle.h"
+#include "mmodule/MsvModuleManager.h"
+#include "mmodule/MsvServiceRegistry.h"
+
+#include "mmodule/Mocks/MsvModuleConfigurator_Mock.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+MSV_ENABLE_WARNINGS
+
+
+using namespace ::testing;
+
+
+//service interfaces
+class IMsvTestCounterService
+{
+public:
+	virtual ~IMsvTestCounterService() {}
+
+	virtual int32_t GetValue() const = 0;
+};
+
+class IMsvTestOtherService
+{
+public:
+	virtual ~IMsvTestOtherService() {}
+};
+
+
+class MsvTestCounterService:
+	public IMsvTestCounterService
+{
+public:
+	MsvTestCounterService(int32_t value):
+		m_value(value)
+	{
+
+	}
+
+	virtual int32_t GetValue() const override
+	{
+		return m_value;
+	}
+
+	int32_t m_value;
+};
+
+
+//module which publishes its service when it starts
+class MsvTestServiceModule:
+	public MsvModuleLifecycle<MsvTestServiceModule, MsvModuleBase>
+{
+public:
+	MsvTestServiceModule(std::shared_ptr<IMsvLoggerProvider> spLoggerProvider):
+		MsvModuleLifecycle(spLoggerProvider, "MsvServiceRegistry_Test")
+	{
+
+	}
+
+	MsvErrorCode OnStart()
+	{
+		if (!m_spServiceRegistry)
+		{
+			return MSV_NOT_INITIALIZED_ERROR;
+		}
+
+		std::shared_ptr<IMsvTestCounterService> spService(new (std::nothrow) MsvTestCounterService(m_moduleId));
+		if (!spService)
+		{
+			return MSV_ALLOCATION_ERROR;
+		}
+
+		return m_spServiceRegistry->Publish(m_moduleId, "counter", spService);
+	}
+};
+
+
+class MsvServiceRegistry_Test:
+	public MsvModule_TestBase
+{
+public:
+	virtual void SetUp()
+	{
+		InitializeLogging();
+
+		m_spServiceRegistry.reset(new (std::nothrow) MsvServiceRegistry());
+		EXPECT_NE(m_spServiceRegistry, nullptr);
+	}
+
+	virtual void TearDown()
+	{
+		m_spServiceRegistry.reset();
+
+		UninitializeLogging();
+	}
+
+	//tested classes
+	std::shared_ptr<MsvServiceRegistry> m_spServiceRegistry;
+};
+
+
+/*-----------------------------------------------------------------------------------------------------
+**											Service Registry Tests
+**---------------------------------------------------------------------------------------------------*/
+
+
+TEST_F(MsvServiceRegistry_Test, ItShouldResolveService_WhenServiceIsPublished)
+{
+	std::shared_ptr<IMsvTestCounterService> spService;
+	EXPECT_EQ(m_spServiceRegistry->Resolve("counter", spService), MSV_NOT_FOUND_ERROR);
+	EXPECT_EQ(spService, nullptr);
+
+	std::shared_ptr<IMsvTestCounterService> spPublishedService(new (std::nothrow) MsvTestCounterService(5));
+	EXPECT_NE(spPublishedService, nullptr);
+	EXPECT_EQ(m_spServiceRegistry->Publish(1, "counter", spPublishedService), MSV_SUCCESS);
+
+	EXPECT_EQ(m_spServiceRegistry->Resolve("counter", spService), MSV_SUCCESS);
+	EXPECT_EQ(spService, spPublishedService);
+	EXPECT_EQ(spService->GetValue(), 5);
+}
+
+TEST_F(MsvServiceRegistry_Test, ItShouldFail_WhenServiceIsEmptyOrPublishedByOtherProvider)
+{
+	EXPECT_EQ(m_spServiceRegistry->Publish(1, "counter", std::shared_ptr<IMsvTestCounterService>()), MSV_INVALID_DATA_ERROR);
+
+	std::shared_ptr<IMsvTestCounterService> spService(new (std::nothrow) MsvTestCounterService(5));
+	EXPECT_NE(spService, nullptr);
+	EXPECT_EQ(m_spServiceRegistry->Publish(1, "counter", spService), MSV_SUCCESS);
+	EXPECT_EQ(m_spServiceRegistry->Publish(2, "counter", spService), MSV_ALREADY_EXISTS_ERROR);
+	EXPECT_EQ(m_spServiceRegistry->Retract(2, "counter"), MSV_NOT_FOUND_ERROR);
+	EXPECT_EQ(m_spServiceRegistry->Retract(1, "other"), MSV_NOT_FOUND_ERROR);
+
+	//provider can replace its service
+	EXPECT_EQ(m_spServiceRegistry->Publish(1, "counter", spService), MSV_SUCCESS);
+	EXPECT_EQ(m_spServiceRegistry->Retract(1, "counter"), MSV_SUCCESS);
+	EXPECT_EQ(m_spServiceRegistry->Retract(1, "counter"), MSV_NOT_FOUND_ERROR);
+	EXPECT_EQ(m_spServiceRegistry->Publish(2, "counter", spService), MSV_SUCCESS);
+}
+
+TEST_F(MsvServiceRegistry_Test, ItShouldFail_WhenServiceIsResolvedAsOtherInterface)
+{
+	std::shared_ptr<IMsvTestCounterService> spService(new (std::nothrow) MsvTestCounterService(5));
+	EXPECT_NE(spService, nullptr);
+	EXPECT_EQ(m_spServiceRegistry->Publish(1, "counter", spService), MSV_SUCCESS);
+
+	std::shared_ptr<IMsvTestOtherService> spOtherService;
+	EXPECT_EQ(m_spServiceRegistry->Resolve("counter", spOtherService), MSV_INVALID_DATA_ERROR);
+	EXPECT_EQ(spOtherService, nullptr);
+
+	std::shared_ptr<MsvTestCounterService> spImplementation;
+	EXPECT_EQ(m_spServiceRegistry->Resolve("counter", spImplementation), MSV_INVALID_DATA_ERROR);
+}
+
+TEST_F(MsvServiceRegistry_Test, ItShouldFollowPublishAndRetract_WhenHandleIsCached)
+{
+	MsvServiceHandle<IMsvTestCounterService> emptyHandle;
+	std::shared_ptr<IMsvTestCounterService> spService;
+	EXPECT_EQ(emptyHandle.Get(spService), MSV_NOT_INITIALIZED_ERROR);
+
+	//handle can be created before service is published
+	MsvServiceHandle<IMsvTestCounterService> handle;
+	EXPECT_EQ(m_spServiceRegistry->GetHandle("counter", handle), MSV_SUCCESS);
+	EXPECT_FALSE(handle.Available());
+
+	std::shared_ptr<IMsvTestCounterService> spPublishedService(new (std::nothrow) MsvTestCounterService(5));
+	EXPECT_NE(spPublishedService, nullptr);
+	EXPECT_EQ(m_spServiceRegistry->Publish(1, "counter", spPublishedService), MSV_SUCCESS);
+	EXPECT_TRUE(handle.Available());
+	EXPECT_EQ(handle.Get(spService), MSV_SUCCESS);
+	EXPECT_EQ(spService, spPublishedService);
+
+	//retracted service is released even before handle sees it has been retracted
+	std::weak_ptr<IMsvTestCounterService> wpService = spPublishedService;
+	spPublishedService.reset();
+	spService.reset();
+	m_spServiceRegistry->RetractAll(1);
+	EXPECT_TRUE(wpService.expired());
+	EXPECT_EQ(handle.Get(spService), MSV_NOT_FOUND_ERROR);
+	EXPECT_EQ(spService, nullptr);
+
+	//the same handle follows new service
+	spPublishedService.reset(new (std::nothrow) MsvTestCounterService(6));
+	EXPECT_NE(spPublishedService, nullptr);
+	EXPECT_EQ(m_spServiceRegistry->Publish(2, "counter", spPublishedService), MSV_SUCCESS);
+	EXPECT_EQ(handle.Get(spService), MSV_SUCCESS);
+	EXPECT_EQ(spService->GetValue(), 6);
+}
+
+TEST_F(MsvServiceRegistry_Test, ItShouldResolveConsistentService_WhenPublishedConcurrently)
+{
+	std::atomic<bool> stop(false);
+	std::atomic<int32_t> resolved(0);
+
+	std::vector<std::thread> consumers;
+	for (int32_t i = 0; i < 4; ++i)
+	{
+		consumers.push_back(std::thread([this, &stop, &resolved]()
+		{
+			MsvServiceHandle<IMsvTestCounterService> handle;
+			EXPECT_EQ(m_spServiceRegistry->GetHandle("counter", handle), MSV_SUCCESS);
+
+			std::shared_ptr<IMsvTestCounterService> spService;
+			while (!stop.load())
+			{
+				MsvErrorCode errorCode = handle.Get(spService);
+				if (MSV_SUCCEEDED(errorCode))
+				{
+					EXPECT_GE(spService->GetValue(), 0);
+					++resolved;
+				}
+				else
+				{
+					EXPECT_EQ(errorCode, MSV_NOT_FOUND_ERROR);
+				}
+			}
+		}));
+	}
+
+	for (int32_t i = 0; i < 1000; ++i)
+	{
+		std::shared_ptr<IMsvTestCounterService> spService(new (std::nothrow) MsvTestCounterService(i));
+		EXPECT_NE(spService, nullptr);
+		EXPECT_EQ(m_spServiceRegistry->Publish(1, "counter", spService), MSV_SUCCESS);
+		if (i % 2 == 0)
+		{
+			EXPECT_EQ(m_spServiceRegistry->Retract(1, "counter"), MSV_SUCCESS);
+		}
+	}
+
+	stop = true;
+	for (std::vector<std::thread>::iterator it = consumers.begin(); it != consumers.end(); ++it)
+	{
+		it->join();
+	}
+}
+
+TEST_F(MsvServiceRegistry_Test, ItShouldPublishAndRetractService_WhenModuleIsManaged)
+{
+	MsvModuleManager moduleManager(m_spLogger);
+	std::shared_ptr<MsvServiceRegistry> spServiceRegistry = moduleManager.GetServiceRegistry();
+	EXPECT_NE(spServiceRegistry, nullptr);
+
+	std::shared_ptr<MsvTestServiceModule> spModule(new (std::nothrow) MsvTestServiceModule(m_spLoggerProvider));
+	EXPECT_NE(spModule, nullptr);
+	std::shared_ptr<MsvModuleConfigurator_Mock> spModuleConfiguratorMock(new (std::nothrow) MsvModuleConfigurator_Mock());
+	EXPECT_NE(spModuleConfiguratorMock, nullptr);
+
+	EXPECT_CALL(*spModuleConfiguratorMock, IsInstalled(Matcher<bool&>(_)))
+		.WillRepeatedly(DoAll(SetArgReferee<0>(true), Return(MSV_SUCCESS)));
+	EXPECT_CALL(*spModuleConfiguratorMock, IsEnabled(Matcher<bool&>(_)))
+		.WillRepeatedly(DoAll(SetArgReferee<0>(true), Return(MSV_SUCCESS)));
+
+	int32_t moduleId = static_cast<int32_t>(ModuleId::MSV_TEST_STATIC_MODULE);
+	EXPECT_EQ(moduleManager.AddModule(moduleId, spModule, spModuleConfiguratorMock), MSV_SUCCESS);
+
+	MsvServiceHandle<IMsvTestCounterService> handle;
+	EXPECT_EQ(spServiceRegistry->GetHandle("counter", handle), MSV_SUCCESS);
+	EXPECT_FALSE(handle.Available());
+
+	//module publishes its service as its module ID
+	EXPECT_EQ(moduleManager.Initialize(), MSV_SUCCESS);
+	EXPECT_EQ(moduleManager.Start(), MSV_SUCCESS);
+	std::shared_ptr<IMsvTestCounterService> spService;
+	EXPECT_EQ(handle.Get(spService), MSV_SUCCESS);
+	EXPECT_EQ(spService->GetValue(), moduleId);
+
+	//service is retracted when module stops
+	EXPECT_EQ(moduleManager.Stop(), MSV_SUCCESS);
+	EXPECT_FALSE(handle.Available());
+
+	EXPECT_EQ(moduleManager.Start(), MSV_SUCCESS);
+	EXPECT_TRUE(handle.Available());
+	EXPECT_EQ(moduleManager.Stop(), MSV_SUCCESS);
+	EXPECT_EQ(moduleManager.Uninitialize(), MSV_SUCCESS);
+}
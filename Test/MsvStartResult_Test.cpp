@@ -0,0 +1,210 @@
+
+
+#include "pch.h"
+
+#include "mmodule/MsvModuleLifecycle.h"
+#include "mmodule/MsvModuleManager.h"
+
+#include "mmodule/Mocks/MsvModuleConfigurator_Mock.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <vector>
+
+MSV_ENABLE_WARNINGS
+
+
+using namespace ::testing;
+
+
+class MsvTestStartModule:
+	public MsvModuleLifecycle<MsvTestStartModule, MsvModuleBase>
+{
+public:
+	MsvTestStartModule(std::shared_ptr<IMsvLoggerProvider> spLoggerProvider, MsvErrorCode startErrorCode):
+		MsvModuleLifecycle(spLoggerProvider, "MsvStartResult_Test"),
+		m_startErrorCode(startErrorCode)
+	{
+
+	}
+
+	MsvErrorCode OnStart()
+	{
+		return m_startErrorCode;
+	}
+
+	MsvErrorCode m_startErrorCode;
+};
+
+
+class MsvStartResult_Test:
+	public MsvModule_TestBase
+{
+public:
+	MsvStartResult_Test():
+		m_coreId(static_cast<int32_t>(ModuleId::MSV_TEST_STATIC_MODULE)),
+		m_failingId(static_cast<int32_t>(ModuleId::MSV_TEST_DYNAMIC_MODULE)),
+		m_dependentId(static_cast<int32_t>(ModuleId::MSV_TEST_OTHER_MODULE))
+	{
+
+	}
+
+	virtual void SetUp()
+	{
+		InitializeLogging();
+
+		m_spModuleConfiguratorMock.reset(new (std::nothrow) MsvModuleConfigurator_Mock());
+		EXPECT_NE(m_spModuleConfiguratorMock, nullptr);
+
+		EXPECT_CALL(*m_spModuleConfiguratorMock, IsInstalled(Matcher<bool&>(_)))
+			.WillRepeatedly(DoAll(SetArgReferee<0>(true), Return(MSV_SUCCESS)));
+		EXPECT_CALL(*m_spModuleConfiguratorMock, IsEnabled(Matcher<bool&>(_)))
+			.WillRepeatedly(DoAll(SetArgReferee<0>(true), Return(MSV_SUCCESS)));
+
+		m_spModuleManager.reset(new (std::nothrow) MsvModuleManager(m_spLogger));
+		EXPECT_NE(m_spModuleManager, nullptr);
+
+		//core module, optional module which fails and optional module which depends on it
+		m_spCoreModule.reset(new (std::nothrow) MsvTestStartModule(m_spLoggerProvider, MSV_SUCCESS));
+		m_spFailingModule.reset(new (std::nothrow) MsvTestStartModule(m_spLoggerProvider, MSV_ALLOCATION_ERROR));
+		m_spDependentModule.reset(new (std::nothrow) MsvTestStartModule(m_spLoggerProvider, MSV_SUCCESS));
+
+		EXPECT_EQ(m_spModuleManager->AddModule(m_coreId, m_spCoreModule, m_spModuleConfiguratorMock), MSV_SUCCESS);
+		EXPECT_EQ(m_spModuleManager->AddModule(m_failingId, m_spFailingModule, m_spModuleConfiguratorMock), MSV_SUCCESS);
+		EXPECT_EQ(m_spModuleManager->AddModule(m_dependentId, m_spDependentModule, m_spModuleConfiguratorMock), MSV_SUCCESS);
+		EXPECT_EQ(m_spModuleManager->AddModuleDependency(m_dependentId, m_failingId), MSV_SUCCESS);
+		m_spModuleManager->SetModuleCritical(m_failingId, false);
+		m_spModuleManager->SetModuleCritical(m_dependentId, false);
+	}
+
+	virtual void TearDown()
+	{
+		m_spModuleManager.reset();
+		m_spCoreModule.reset();
+		m_spFailingModule.reset();
+		m_spDependentModule.reset();
+		m_spModuleConfiguratorMock.reset();
+
+		UninitializeLogging();
+	}
+
+	//module IDs (core module starts first)
+	int32_t m_coreId;
+	int32_t m_failingId;
+	int32_t m_dependentId;
+
+	//tested classes
+	std::shared_ptr<MsvModuleManager> m_spModuleManager;
+	std::shared_ptr<MsvTestStartModule> m_spCoreModule;
+	std::shared_ptr<MsvTestStartModule> m_spFailingModule;
+	std::shared_ptr<MsvTestStartModule> m_spDependentModule;
+
+	//mocks
+	std::shared_ptr<MsvModuleConfigurator_Mock> m_spModuleConfiguratorMock;
+};
+
+
+/*-----------------------------------------------------------------------------------------------------
+**											Start Policy Tests
+**---------------------------------------------------------------------------------------------------*/
+
+
+TEST_F(MsvStartResult_Test, ItShouldStopAllModules_WhenOptionalModuleFailsWithAllOrNothingPolicy)
+{
+	EXPECT_EQ(m_spModuleManager->Initialize(), MSV_SUCCESS);
+	EXPECT_EQ(m_spModuleManager->Start(), MSV_ALLOCATION_ERROR);
+	EXPECT_FALSE(m_spModuleManager->Running());
+	EXPECT_FALSE(m_spCoreModule->Running());
+
+	std::vector<MsvModuleStartResult> startResults;
+	m_spModuleManager->GetStartResults(startResults);
+	EXPECT_EQ(startResults.size(), 2u);
+	EXPECT_EQ(startResults[0].status, MsvModuleStartStatus::MSV_MODULE_START_STARTED);
+	EXPECT_EQ(startResults[1].moduleId, m_failingId);
+	EXPECT_EQ(startResults[1].status, MsvModuleStartStatus::MSV_MODULE_START_FAILED);
+	EXPECT_EQ(startResults[1].errorCode, MSV_ALLOCATION_ERROR);
+
+	EXPECT_EQ(m_spModuleManager->Uninitialize(), MSV_SUCCESS);
+}
+
+TEST_F(MsvStartResult_Test, ItShouldSkipDependents_WhenOptionalModuleFailsWithDegradedPolicy)
+{
+	m_spModuleManager->SetStartPolicy(MsvStartPolicy::MSV_START_POLICY_DEGRADED);
+
+	EXPECT_EQ(m_spModuleManager->Initialize(), MSV_SUCCESS);
+	EXPECT_EQ(m_spModuleManager->Start(), MSV_SUCCESS);
+	EXPECT_TRUE(m_spModuleManager->Running());
+	EXPECT_TRUE(m_spCoreModule->Running());
+	EXPECT_FALSE(m_spFailingModule->Running());
+	EXPECT_FALSE(m_spDependentModule->Running());
+	EXPECT_TRUE(m_spDependentModule->Initialized());
+
+	std::vector<MsvModuleStartResult> startResults;
+	m_spModuleManager->GetStartResults(startResults);
+	EXPECT_EQ(startResults.size(), 3u);
+	EXPECT_EQ(startResults[0].moduleId, m_coreId);
+	EXPECT_EQ(startResults[0].status, MsvModuleStartStatus::MSV_MODULE_START_STARTED);
+	EXPECT_EQ(startResults[1].moduleId, m_failingId);
+	EXPECT_EQ(startResults[1].status, MsvModuleStartStatus::MSV_MODULE_START_FAILED);
+	EXPECT_EQ(startResults[1].errorCode, MSV_ALLOCATION_ERROR);
+	EXPECT_EQ(startResults[2].moduleId, m_dependentId);
+	EXPECT_EQ(startResults[2].status, MsvModuleStartStatus::MSV_MODULE_START_DEPENDENCY_FAILED);
+	EXPECT_EQ(startResults[2].causeId, m_failingId);
+
+	EXPECT_EQ(m_spModuleManager->Stop(), MSV_SUCCESS);
+	EXPECT_FALSE(m_spCoreModule->Running());
+	EXPECT_EQ(m_spModuleManager->Uninitialize(), MSV_SUCCESS);
+}
+
+TEST_F(MsvStartResult_Test, ItShouldStopAllModules_WhenCriticalModuleDependsOnFailedModule)
+{
+	m_spModuleManager->SetStartPolicy(MsvStartPolicy::MSV_START_POLICY_DEGRADED);
+	m_spModuleManager->SetModuleCritical(m_dependentId, true);
+
+	EXPECT_EQ(m_spModuleManager->Initialize(), MSV_SUCCESS);
+	EXPECT_EQ(m_spModuleManager->Start(), MSV_NOT_INITIALIZED_ERROR);
+	EXPECT_FALSE(m_spModuleManager->Running());
+	EXPECT_FALSE(m_spCoreModule->Running());
+
+	std::vector<MsvModuleStartResult> startResults;
+	m_spModuleManager->GetStartResults(startResults);
+	EXPECT_EQ(startResults.size(), 3u);
+	EXPECT_EQ(startResults[2].status, MsvModuleStartStatus::MSV_MODULE_START_DEPENDENCY_FAILED);
+
+	EXPECT_EQ(m_spModuleManager->Uninitialize(), MSV_SUCCESS);
+}
+
+TEST_F(MsvStartResult_Test, ItShouldStopAllModules_WhenCriticalModuleFailsWithDegradedPolicy)
+{
+	m_spModuleManager->SetStartPolicy(MsvStartPolicy::MSV_START_POLICY_DEGRADED);
+	m_spModuleManager->SetModuleCritical(m_failingId, true);
+
+	EXPECT_EQ(m_spModuleManager->Initialize(), MSV_SUCCESS);
+	EXPECT_EQ(m_spModuleManager->Start(), MSV_ALLOCATION_ERROR);
+	EXPECT_FALSE(m_spModuleManager->Running());
+	EXPECT_FALSE(m_spCoreModule->Running());
+
+	EXPECT_EQ(m_spModuleManager->Uninitialize(), MSV_SUCCESS);
+}
+
+TEST_F(MsvStartResult_Test, ItShouldStartAllModules_WhenNoModuleFails)
+{
+	m_spModuleManager->SetStartPolicy(MsvStartPolicy::MSV_START_POLICY_DEGRADED);
+	m_spFailingModule->m_startErrorCode = MSV_SUCCESS;
+
+	EXPECT_EQ(m_spModuleManager->Initialize(), MSV_SUCCESS);
+	EXPECT_EQ(m_spModuleManager->Start(), MSV_SUCCESS);
+	EXPECT_TRUE(m_spDependentModule->Running());
+
+	std::vector<MsvModuleStartResult> startResults;
+	m_spModuleManager->GetStartResults(startResults);
+	EXPECT_EQ(startResults.size(), 3u);
+	for (std::vector<MsvModuleStartResult>::const_iterator it = startResults.begin(); it != startResults.end(); ++it)
+	{
+		EXPECT_EQ(it->status, MsvModuleStartStatus::MSV_MODULE_START_STARTED);
+		EXPECT_EQ(it->errorCode, MSV_SUCCESS);
+	}
+
+	EXPECT_EQ(m_spModuleManager->Stop(), MSV_SUCCESS);
+	EXPECT_EQ(m_spModuleManager->Uninitialize(), MSV_SUCCESS);
+}
@@ -0,0 +1,234 @@
+
+
+#include "pch.h"
+
+#include "mmodule/MsvStaticModuleRegistry.h"
+#include "mmodule/MsvModuleManager.h"
+
+#include "mmodule/Mocks/MsvModuleConfigurator_Mock.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <string>
+#include <vector>
+
+MSV_ENABLE_WARNINGS
+
+
+using namespace ::testing;
+
+
+const int32_t MSV_TEST_STORAGE_MODULE_ID = 1;
+const int32_t MSV_TEST_CONFIG_MODULE_ID = 2;
+const int32_t MSV_TEST_NETWORK_MODULE_ID = 3;
+const int32_t MSV_TEST_STATIC_MODULES_ID = 10;
+const int32_t MSV_TEST_DLL_MODULE_ID = 0;
+
+
+//module which writes its transitions to shared log (and fails configured transition)
+class MsvTestStaticModule final:
+	public MsvModuleLifecycle<MsvTestStaticModule, MsvModuleBase>
+{
+	friend class MsvModuleLifecycle<MsvTestStaticModule, MsvModuleBase>;
+
+public:
+	MsvTestStaticModule(std::shared_ptr<IMsvLoggerProvider> spLoggerProvider, int32_t moduleId, std::vector<std::string>& transitions):
+		MsvModuleLifecycle(spLoggerProvider, "MsvTestStaticModule"),
+		m_failedTransition(),
+		m_moduleId(moduleId),
+		m_transitions(transitions)
+	{
+
+	}
+
+	std::string m_failedTransition;
+
+protected:
+	MsvErrorCode OnInitialize() { return Transition("Initialize"); }
+	MsvErrorCode OnUninitialize() { return Transition("Uninitialize"); }
+	MsvErrorCode OnStart() { return Transition("Start"); }
+	MsvErrorCode OnStop() { return Transition("Stop"); }
+
+	MsvErrorCode Transition(const char* transition)
+	{
+		m_transitions.push_back(std::string(transition) + " " + std::to_string(m_moduleId));
+		return m_failedTransition == transition ? MSV_INVALID_DATA_ERROR : MSV_SUCCESS;
+	}
+
+	int32_t m_moduleId;
+	std::vector<std::string>& m_transitions;
+};
+
+
+//modules are declared in different order than they are started
+typedef MsvStaticModuleRegistry<
+	MsvStaticModule<MSV_TEST_NETWORK_MODULE_ID, MsvTestStaticModule, MSV_TEST_STORAGE_MODULE_ID, MSV_TEST_CONFIG_MODULE_ID>,
+	MsvStaticModule<MSV_TEST_CONFIG_MODULE_ID, MsvTestStaticModule, MSV_TEST_STORAGE_MODULE_ID>,
+	MsvStaticModule<MSV_TEST_STORAGE_MODULE_ID, MsvTestStaticModule>> MsvTestStaticModules;
+
+//orders are computed at compile time
+static_assert(MsvTestStaticModules::GetModuleCount() == 3, "Unexpected module count.");
+static_assert(MsvTestStaticModules::GetStartupModuleId(0) == MSV_TEST_STORAGE_MODULE_ID, "Unexpected startup order.");
+static_assert(MsvTestStaticModules::GetStartupModuleId(1) == MSV_TEST_CONFIG_MODULE_ID, "Unexpected startup order.");
+static_assert(MsvTestStaticModules::GetStartupModuleId(2) == MSV_TEST_NETWORK_MODULE_ID, "Unexpected startup order.");
+static_assert(MsvTestStaticModules::GetShutdownModuleId(0) == MSV_TEST_NETWORK_MODULE_ID, "Unexpected shutdown order.");
+static_assert(MsvTestStaticModules::GetShutdownModuleId(1) == MSV_TEST_CONFIG_MODULE_ID, "Unexpected shutdown order.");
+static_assert(MsvTestStaticModules::GetShutdownModuleId(2) == MSV_TEST_STORAGE_MODULE_ID, "Unexpected shutdown order.");
+
+//independent modules are ordered by module ID (the same as in module manager)
+typedef MsvStaticModuleGraph<
+	MsvStaticModule<3, MsvTestStaticModule>,
+	MsvStaticModule<1, MsvTestStaticModule>,
+	MsvStaticModule<2, MsvTestStaticModule>> MsvTestIndependentGraph;
+
+static_assert(MsvTestIndependentGraph::GetOrder(false).indexes[0] == 1 && MsvTestIndependentGraph::GetOrder(false).indexes[2] == 0, "Unexpected startup order.");
+static_assert(MsvTestIndependentGraph::GetOrder(true).indexes[0] == 1 && MsvTestIndependentGraph::GetOrder(true).indexes[2] == 0, "Unexpected shutdown order.");
+
+//invalid declarations are rejected at compile time
+static_assert(!MsvStaticModuleGraph<MsvStaticModule<1, MsvTestStaticModule>, MsvStaticModule<1, MsvTestStaticModule>>::HasUniqueIds(), "Duplicated ID is not detected.");
+static_assert(!MsvStaticModuleGraph<MsvStaticModule<1, MsvTestStaticModule, 2>>::HasRegisteredDependencies(), "Unknown dependency is not detected.");
+static_assert(MsvStaticModuleGraph<MsvStaticModule<1, MsvTestStaticModule, 2>, MsvStaticModule<2, MsvTestStaticModule, 1>>::GetOrder(false).count == 0, "Cycle is not detected.");
+static_assert(MsvStaticModuleGraph<MsvStaticModule<1, MsvTestStaticModule, 1>>::GetOrder(false).count == 0, "Self dependency is not detected.");
+
+
+class MsvStaticModuleRegistry_Test:
+	public MsvModule_TestBase
+{
+public:
+	virtual void SetUp()
+	{
+		InitializeLogging();
+
+		m_spStorageModule = std::make_shared<MsvTestStaticModule>(m_spLoggerProvider, MSV_TEST_STORAGE_MODULE_ID, m_transitions);
+		m_spConfigModule = std::make_shared<MsvTestStaticModule>(m_spLoggerProvider, MSV_TEST_CONFIG_MODULE_ID, m_transitions);
+		m_spNetworkModule = std::make_shared<MsvTestStaticModule>(m_spLoggerProvider, MSV_TEST_NETWORK_MODULE_ID, m_transitions);
+
+		m_spStaticModules.reset(new (std::nothrow) MsvTestStaticModules(m_spLoggerProvider, m_spNetworkModule, m_spConfigModule, m_spStorageModule));
+		EXPECT_NE(m_spStaticModules, nullptr);
+	}
+
+	virtual void TearDown()
+	{
+		m_spStaticModules.reset();
+
+		m_spStorageModule.reset();
+		m_spConfigModule.reset();
+		m_spNetworkModule.reset();
+
+		UninitializeLogging();
+	}
+
+	//transitions of modules
+	std::vector<std::string> m_transitions;
+
+	//modules
+	std::shared_ptr<MsvTestStaticModule> m_spStorageModule;
+	std::shared_ptr<MsvTestStaticModule> m_spConfigModule;
+	std::shared_ptr<MsvTestStaticModule> m_spNetworkModule;
+
+	//tested classes
+	std::shared_ptr<MsvTestStaticModules> m_spStaticModules;
+};
+
+
+TEST_F(MsvStaticModuleRegistry_Test, ItShouldReturnModule_WhenModuleIdIsRegistered)
+{
+	EXPECT_EQ(m_spStaticModules->GetModule<MSV_TEST_STORAGE_MODULE_ID>(), m_spStorageModule);
+	EXPECT_EQ(m_spStaticModules->GetModule<MSV_TEST_NETWORK_MODULE_ID>(), m_spNetworkModule);
+}
+
+TEST_F(MsvStaticModuleRegistry_Test, ItShouldProcessModulesInDependencyOrder_WhenLifecycleSucceeded)
+{
+	EXPECT_EQ(m_spStaticModules->Initialize(), MSV_SUCCESS);
+	EXPECT_EQ(m_spStaticModules->Start(), MSV_SUCCESS);
+	EXPECT_TRUE(m_spNetworkModule->Running());
+	EXPECT_EQ(m_spStaticModules->Stop(), MSV_SUCCESS);
+	EXPECT_EQ(m_spStaticModules->Uninitialize(), MSV_SUCCESS);
+	EXPECT_FALSE(m_spStorageModule->Initialized());
+
+	std::vector<std::string> expectedTransitions = {
+		"Initialize 1", "Initialize 2", "Initialize 3",
+		"Start 1", "Start 2", "Start 3",
+		"Stop 3", "Stop 2", "Stop 1",
+		"Uninitialize 3", "Uninitialize 2", "Uninitialize 1" };
+	EXPECT_EQ(m_transitions, expectedTransitions);
+}
+
+TEST_F(MsvStaticModuleRegistry_Test, ItShouldUninitializeInitializedModules_WhenModuleInitializeFailed)
+{
+	m_spConfigModule->m_failedTransition = "Initialize";
+
+	EXPECT_EQ(m_spStaticModules->Initialize(), MSV_INVALID_DATA_ERROR);
+	EXPECT_FALSE(m_spStaticModules->Initialized());
+	EXPECT_FALSE(m_spStorageModule->Initialized());
+
+	std::vector<std::string> expectedTransitions = { "Initialize 1", "Initialize 2", "Uninitialize 1" };
+	EXPECT_EQ(m_transitions, expectedTransitions);
+}
+
+TEST_F(MsvStaticModuleRegistry_Test, ItShouldStopStartedModules_WhenModuleStartFailed)
+{
+	m_spNetworkModule->m_failedTransition = "Start";
+	EXPECT_EQ(m_spStaticModules->Initialize(), MSV_SUCCESS);
+	m_transitions.clear();
+
+	EXPECT_EQ(m_spStaticModules->Start(), MSV_INVALID_DATA_ERROR);
+	EXPECT_FALSE(m_spStaticModules->Running());
+	EXPECT_TRUE(m_spStaticModules->Initialized());
+
+	std::vector<std::string> expectedTransitions = { "Start 1", "Start 2", "Start 3", "Stop 2", "Stop 1" };
+	EXPECT_EQ(m_transitions, expectedTransitions);
+}
+
+TEST_F(MsvStaticModuleRegistry_Test, ItShouldStopAllModules_WhenModuleStopFailed)
+{
+	m_spConfigModule->m_failedTransition = "Stop";
+	EXPECT_EQ(m_spStaticModules->Initialize(), MSV_SUCCESS);
+	EXPECT_EQ(m_spStaticModules->Start(), MSV_SUCCESS);
+	m_transitions.clear();
+
+	EXPECT_EQ(m_spStaticModules->Stop(), MSV_INVALID_DATA_ERROR);
+	EXPECT_FALSE(m_spStorageModule->Running());
+
+	std::vector<std::string> expectedTransitions = { "Stop 3", "Stop 2", "Stop 1" };
+	EXPECT_EQ(m_transitions, expectedTransitions);
+}
+
+TEST_F(MsvStaticModuleRegistry_Test, ItShouldFail_WhenModuleIsEmpty)
+{
+	MsvTestStaticModules staticModules(m_spLoggerProvider, m_spNetworkModule, nullptr, m_spStorageModule);
+
+	EXPECT_EQ(staticModules.Initialize(), MSV_INVALID_DATA_ERROR);
+	EXPECT_FALSE(m_spStorageModule->Initialized());
+	EXPECT_FALSE(m_spNetworkModule->Initialized());
+}
+
+TEST_F(MsvStaticModuleRegistry_Test, ItShouldBeManagedWithOtherModules_WhenAddedToModuleManager)
+{
+	std::shared_ptr<MsvTestStaticModule> spDllModule = std::make_shared<MsvTestStaticModule>(m_spLoggerProvider, MSV_TEST_DLL_MODULE_ID, m_transitions);
+
+	std::shared_ptr<MsvModuleConfigurator_Mock> spConfiguratorMock(new (std::nothrow) MsvModuleConfigurator_Mock());
+	EXPECT_NE(spConfiguratorMock, nullptr);
+	EXPECT_CALL(*spConfiguratorMock, IsInstalled(Matcher<bool&>(_)))
+		.WillRepeatedly(DoAll(SetArgReferee<0>(true), Return(MSV_SUCCESS)));
+	EXPECT_CALL(*spConfiguratorMock, IsEnabled(Matcher<bool&>(_)))
+		.WillRepeatedly(DoAll(SetArgReferee<0>(true), Return(MSV_SUCCESS)));
+
+	//DLL module has lower ID than static modules - it is started later only because of dependency
+	MsvModuleManager moduleManager(m_spLogger);
+	EXPECT_EQ(moduleManager.AddModule(MSV_TEST_DLL_MODULE_ID, spDllModule, spConfiguratorMock), MSV_SUCCESS);
+	EXPECT_EQ(moduleManager.AddModule(MSV_TEST_STATIC_MODULES_ID, m_spStaticModules, spConfiguratorMock), MSV_SUCCESS);
+	EXPECT_EQ(moduleManager.AddModuleDependency(MSV_TEST_DLL_MODULE_ID, MSV_TEST_STATIC_MODULES_ID), MSV_SUCCESS);
+
+	EXPECT_EQ(moduleManager.Initialize(), MSV_SUCCESS);
+	EXPECT_EQ(moduleManager.Start(), MSV_SUCCESS);
+	EXPECT_EQ(moduleManager.Stop(), MSV_SUCCESS);
+	EXPECT_EQ(moduleManager.Uninitialize(), MSV_SUCCESS);
+
+	std::vector<std::string> expectedTransitions = {
+		"Initialize 1", "Initialize 2", "Initialize 3", "Initialize 0",
+		"Start 1", "Start 2", "Start 3", "Start 0",
+		"Stop 0", "Stop 3", "Stop 2", "Stop 1",
+		"Uninitialize 0", "Uninitialize 3", "Uninitialize 2", "Uninitialize 1" };
+	EXPECT_EQ(m_transitions, expectedTransitions);
+}
@@ -0,0 +1,346 @@
+
+
+#include "pch.h"
+
+#include "mmodule/MsvModuleLifecycle.h"
+#include "mmodule/MsvModuleManager.h"
+#include "mmodule/MsvThreadPool.h"
+
+#include "mmodule/Mocks/MsvModuleConfigurator_Mock.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+
+MSV_ENABLE_WARNINGS
+
+
+using namespace ::testing;
+
+
+//module which submits tasks to thread pool of module manager when it is started
+class MsvTestThreadPoolModule:
+	public MsvModuleLifecycle<MsvTestThreadPoolModule, MsvModuleBase>
+{
+public:
+	MsvTestThreadPoolModule(std::shared_ptr<IMsvLoggerProvider> spLoggerProvider):
+		MsvModuleLifecycle(spLoggerProvider, "MsvThreadPool_Test"),
+		m_taskCount(0)
+	{
+
+	}
+
+	MsvErrorCode OnStart()
+	{
+		if (!m_spThreadPool)
+		{
+			return MSV_NOT_INITIALIZED_ERROR;
+		}
+
+		for (int i = 0; i < 100; ++i)
+		{
+			MSV_RETURN_FAILED(m_spThreadPool->Submit([this]() { ++m_taskCount; }));
+		}
+
+		return MSV_SUCCESS;
+	}
+
+	std::shared_ptr<IMsvThreadPool> GetThreadPool() const
+	{
+		return m_spThreadPool;
+	}
+
+	std::atomic<int> m_taskCount;
+};
+
+
+//module which submits task querying module manager while module manager stops
+class MsvTestManagerTaskModule:
+	public MsvModuleLifecycle<MsvTestManagerTaskModule, MsvModuleBase>
+{
+public:
+	MsvTestManagerTaskModule(std::shared_ptr<IMsvLoggerProvider> spLoggerProvider, MsvModuleManager& moduleManager):
+		MsvModuleLifecycle(spLoggerProvider, "MsvThreadPool_Test"),
+		m_moduleManager(moduleManager),
+		m_stopped(false),
+		m_managerRunning(true)
+	{
+
+	}
+
+	MsvErrorCode OnStart()
+	{
+		if (!m_spThreadPool)
+		{
+			return MSV_NOT_INITIALIZED_ERROR;
+		}
+
+		return m_spThreadPool->Submit([this]()
+		{
+			//module manager is locked while it stops modules -> task waits for it and stopping thread pool must unlock it
+			while (!m_stopped.load())
+			{
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			}
+
+			m_managerRunning = m_moduleManager.Running();
+		});
+	}
+
+	MsvErrorCode OnStop()
+	{
+		m_stopped = true;
+		return MSV_SUCCESS;
+	}
+
+	MsvModuleManager& m_moduleManager;
+	std::atomic<bool> m_stopped;
+	std::atomic<bool> m_managerRunning;
+};
+
+
+class MsvThreadPool_Test:
+	public MsvModule_TestBase
+{
+public:
+	virtual void SetUp()
+	{
+		InitializeLogging();
+
+		m_spThreadPool.reset(new (std::nothrow) MsvThreadPool(4));
+		EXPECT_NE(m_spThreadPool, nullptr);
+	}
+
+	virtual void TearDown()
+	{
+		m_spThreadPool.reset();
+
+		UninitializeLogging();
+	}
+
+	//tested classes
+	std::shared_ptr<MsvThreadPool> m_spThreadPool;
+};
+
+
+/*-----------------------------------------------------------------------------------------------------
+**											Thread Pool Tests
+**---------------------------------------------------------------------------------------------------*/
+
+
+TEST_F(MsvThreadPool_Test, ItShouldHaveHardwareThreadCount_WhenThreadCountIsNotSet)
+{
+	MsvThreadPool threadPool;
+
+	EXPECT_EQ(threadPool.GetThreadCount(), std::max<size_t>(std::thread::hardware_concurrency(), 1));
+	EXPECT_EQ(m_spThreadPool->GetThreadCount(), 4u);
+}
+
+TEST_F(MsvThreadPool_Test, ItShouldFailToSubmit_WhenNotRunning)
+{
+	EXPECT_FALSE(m_spThreadPool->Running());
+	EXPECT_EQ(m_spThreadPool->Submit([]() {}), MSV_NOT_INITIALIZED_ERROR);
+	EXPECT_EQ(m_spThreadPool->Stop(), MSV_NOT_RUNNING_INFO);
+}
+
+TEST_F(MsvThreadPool_Test, ItShouldFailToSubmit_WhenTaskIsEmpty)
+{
+	EXPECT_EQ(m_spThreadPool->Start(), MSV_SUCCESS);
+	EXPECT_EQ(m_spThreadPool->Submit(std::function<void()>()), MSV_INVALID_DATA_ERROR);
+}
+
+TEST_F(MsvThreadPool_Test, ItShouldReturnInfo_WhenAlreadyRunning)
+{
+	EXPECT_EQ(m_spThreadPool->Start(), MSV_SUCCESS);
+	EXPECT_EQ(m_spThreadPool->Start(), MSV_ALREADY_RUNNING_INFO);
+	EXPECT_TRUE(m_spThreadPool->Running());
+}
+
+TEST_F(MsvThreadPool_Test, ItShouldRunAllQueuedTasks_WhenStopped)
+{
+	std::atomic<int> taskCount(0);
+
+	EXPECT_EQ(m_spThreadPool->Start(), MSV_SUCCESS);
+	for (int i = 0; i < 1000; ++i)
+	{
+		EXPECT_EQ(m_spThreadPool->Submit([&taskCount]() { ++taskCount; }), MSV_SUCCESS);
+	}
+	EXPECT_EQ(m_spThreadPool->Stop(), MSV_SUCCESS);
+
+	EXPECT_EQ(taskCount.load(), 1000);
+	EXPECT_FALSE(m_spThreadPool->Running());
+}
+
+TEST_F(MsvThreadPool_Test, ItShouldStealTasks_WhenSubmittedFromWorker)
+{
+	std::mutex threadIdsLock;
+	std::set<std::thread::id> threadIds;
+	std::atomic<int> taskCount(0);
+	MsvThreadPool* pThreadPool = m_spThreadPool.get();
+
+	EXPECT_EQ(m_spThreadPool->Start(), MSV_SUCCESS);
+
+	//all nested tasks are queued to queue of one worker -> other workers must steal them
+	EXPECT_EQ(m_spThreadPool->Submit([&, pThreadPool]()
+	{
+		for (int i = 0; i < 64; ++i)
+		{
+			pThreadPool->Submit([&]()
+			{
+				std::this_thread::sleep_for(std::chrono::milliseconds(2));
+
+				std::lock_guard<std::mutex> lock(threadIdsLock);
+				threadIds.insert(std::this_thread::get_id());
+				++taskCount;
+			});
+		}
+	}), MSV_SUCCESS);
+
+	EXPECT_EQ(m_spThreadPool->Stop(), MSV_SUCCESS);
+
+	EXPECT_EQ(taskCount.load(), 64);
+	EXPECT_GT(threadIds.size(), 1u);
+}
+
+TEST_F(MsvThreadPool_Test, ItShouldRunTasks_WhenRestarted)
+{
+	std::atomic<int> taskCount(0);
+
+	EXPECT_EQ(m_spThreadPool->Start(), MSV_SUCCESS);
+	EXPECT_EQ(m_spThreadPool->Submit([&taskCount]() { ++taskCount; }), MSV_SUCCESS);
+	EXPECT_EQ(m_spThreadPool->Stop(), MSV_SUCCESS);
+
+	EXPECT_EQ(m_spThreadPool->Start(), MSV_SUCCESS);
+	EXPECT_EQ(m_spThreadPool->Submit([&taskCount]() { ++taskCount; }), MSV_SUCCESS);
+	EXPECT_EQ(m_spThreadPool->Stop(), MSV_SUCCESS);
+
+	EXPECT_EQ(taskCount.load(), 2);
+}
+
+TEST_F(MsvThreadPool_Test, ItShouldStartWorkers_WhenFirstTaskIsSubmitted)
+{
+	std::atomic<int> taskCount(0);
+
+	//lazily started thread pool accepts tasks without worker threads
+	EXPECT_EQ(m_spThreadPool->Start(true), MSV_SUCCESS);
+	EXPECT_TRUE(m_spThreadPool->Running());
+	EXPECT_FALSE(m_spThreadPool->WorkersStarted());
+
+	EXPECT_EQ(m_spThreadPool->Submit([&taskCount]() { ++taskCount; }), MSV_SUCCESS);
+	EXPECT_TRUE(m_spThreadPool->WorkersStarted());
+
+	EXPECT_EQ(m_spThreadPool->Stop(), MSV_SUCCESS);
+	EXPECT_EQ(taskCount.load(), 1);
+	EXPECT_FALSE(m_spThreadPool->WorkersStarted());
+
+	//thread pool without any task stops without workers
+	EXPECT_EQ(m_spThreadPool->Start(true), MSV_SUCCESS);
+	EXPECT_EQ(m_spThreadPool->Stop(), MSV_SUCCESS);
+	EXPECT_FALSE(m_spThreadPool->WorkersStarted());
+	EXPECT_EQ(m_spThreadPool->Submit([&taskCount]() { ++taskCount; }), MSV_NOT_INITIALIZED_ERROR);
+}
+
+TEST_F(MsvThreadPool_Test, ItShouldRunOtherTasks_WhenTaskThrows)
+{
+	std::atomic<int> taskCount(0);
+
+	EXPECT_EQ(m_spThreadPool->Start(), MSV_SUCCESS);
+	for (int i = 0; i < 100; ++i)
+	{
+		EXPECT_EQ(m_spThreadPool->Submit([&taskCount, i]()
+		{
+			if (i % 2 == 0)
+			{
+				throw std::runtime_error("task failed");
+			}
+
+			if (i % 3 == 0)
+			{
+				throw 1;
+			}
+
+			++taskCount;
+		}), MSV_SUCCESS);
+	}
+	EXPECT_EQ(m_spThreadPool->Stop(), MSV_SUCCESS);
+
+	EXPECT_EQ(taskCount.load(), 33);
+}
+
+
+/*-----------------------------------------------------------------------------------------------------
+**											Module Manager Thread Pool Tests
+**---------------------------------------------------------------------------------------------------*/
+
+
+TEST_F(MsvThreadPool_Test, ItShouldSetThreadPoolToModule_WhenModuleManagerIsInitialized)
+{
+	MsvModuleManager moduleManager(m_spLogger);
+	std::shared_ptr<MsvTestThreadPoolModule> spModule(new (std::nothrow) MsvTestThreadPoolModule(m_spLoggerProvider));
+	EXPECT_NE(spModule, nullptr);
+	std::shared_ptr<MsvModuleConfigurator_Mock> spModuleConfiguratorMock(new (std::nothrow) MsvModuleConfigurator_Mock());
+	EXPECT_NE(spModuleConfiguratorMock, nullptr);
+
+	EXPECT_CALL(*spModuleConfiguratorMock, IsInstalled(Matcher<bool&>(_)))
+		.WillRepeatedly(DoAll(SetArgReferee<0>(true), Return(MSV_SUCCESS)));
+	EXPECT_CALL(*spModuleConfiguratorMock, IsEnabled(Matcher<bool&>(_)))
+		.WillRepeatedly(DoAll(SetArgReferee<0>(true), Return(MSV_SUCCESS)));
+
+	EXPECT_EQ(moduleManager.AddModule(static_cast<int32_t>(ModuleId::MSV_TEST_STATIC_MODULE), spModule, spModuleConfiguratorMock), MSV_SUCCESS);
+	EXPECT_EQ(spModule->GetThreadPool(), nullptr);
+
+	EXPECT_EQ(moduleManager.Initialize(), MSV_SUCCESS);
+	EXPECT_EQ(spModule->GetThreadPool(), moduleManager.GetThreadPool());
+	EXPECT_TRUE(moduleManager.GetThreadPool()->Running());
+
+	//idle module manager does not start worker threads
+	EXPECT_FALSE(moduleManager.GetThreadPool()->WorkersStarted());
+
+	//module submits tasks when it is started
+	EXPECT_EQ(moduleManager.Start(), MSV_SUCCESS);
+	EXPECT_TRUE(moduleManager.GetThreadPool()->WorkersStarted());
+
+	//thread pool runs queued tasks and stops after the last module stopped
+	EXPECT_EQ(moduleManager.Stop(), MSV_SUCCESS);
+	EXPECT_EQ(spModule->m_taskCount.load(), 100);
+	EXPECT_FALSE(moduleManager.GetThreadPool()->Running());
+
+	//thread pool is started again with module manager
+	EXPECT_EQ(moduleManager.Start(), MSV_SUCCESS);
+	EXPECT_TRUE(moduleManager.GetThreadPool()->Running());
+	EXPECT_EQ(moduleManager.Stop(), MSV_SUCCESS);
+	EXPECT_EQ(spModule->m_taskCount.load(), 200);
+
+	EXPECT_EQ(moduleManager.Uninitialize(), MSV_SUCCESS);
+}
+
+TEST_F(MsvThreadPool_Test, ItShouldServeModuleManagerQuery_WhenItStopsThreadPool)
+{
+	MsvModuleManager moduleManager(m_spLogger);
+	std::shared_ptr<MsvTestManagerTaskModule> spModule(new (std::nothrow) MsvTestManagerTaskModule(m_spLoggerProvider, moduleManager));
+	EXPECT_NE(spModule, nullptr);
+	std::shared_ptr<MsvModuleConfigurator_Mock> spModuleConfiguratorMock(new (std::nothrow) MsvModuleConfigurator_Mock());
+	EXPECT_NE(spModuleConfiguratorMock, nullptr);
+
+	EXPECT_CALL(*spModuleConfiguratorMock, IsInstalled(Matcher<bool&>(_)))
+		.WillRepeatedly(DoAll(SetArgReferee<0>(true), Return(MSV_SUCCESS)));
+	EXPECT_CALL(*spModuleConfiguratorMock, IsEnabled(Matcher<bool&>(_)))
+		.WillRepeatedly(DoAll(SetArgReferee<0>(true), Return(MSV_SUCCESS)));
+
+	EXPECT_EQ(moduleManager.AddModule(static_cast<int32_t>(ModuleId::MSV_TEST_STATIC_MODULE), spModule, spModuleConfiguratorMock), MSV_SUCCESS);
+	EXPECT_EQ(moduleManager.Initialize(), MSV_SUCCESS);
+	EXPECT_EQ(moduleManager.Start(), MSV_SUCCESS);
+
+	//task queries module manager after module has been stopped -> it is served while thread pool stops
+	EXPECT_EQ(moduleManager.Stop(), MSV_SUCCESS);
+	EXPECT_TRUE(spModule->m_stopped.load());
+	EXPECT_FALSE(spModule->m_managerRunning.load());
+
+	EXPECT_EQ(moduleManager.Uninitialize(), MSV_SUCCESS);
+}
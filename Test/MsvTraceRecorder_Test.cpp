@@ -0,0 +1,122 @@
+
+
+#include "pch.h"
+
+#include "mmodule/MsvTraceRecorder.h"
+
+
+using namespace ::testing;
+
+
+class MsvTraceRecorder_Test:
+	public MsvModule_TestBase
+{
+public:
+	virtual void SetUp()
+	{
+		m_spTraceRecorder.reset(new (std::nothrow) MsvTraceRecorder());
+		EXPECT_NE(m_spTraceRecorder, nullptr);
+	}
+
+	virtual void TearDown()
+	{
+		m_spTraceRecorder.reset();
+	}
+
+	//tested classes
+	std::shared_ptr<MsvTraceRecorder> m_spTraceRecorder;
+};
+
+
+/*-----------------------------------------------------------------------------------------------------
+**											Record Tests
+**---------------------------------------------------------------------------------------------------*/
+
+
+TEST_F(MsvTraceRecorder_Test, ItShouldNestEvents_WhenScopesAreNested)
+{
+	{
+		MsvTraceScope outerScope(m_spTraceRecorder, "outer", "test");
+		MsvTraceScope innerScope(m_spTraceRecorder, "inner", "test");
+		innerScope.SetErrorCode(MSV_NOT_FOUND_ERROR);
+	}
+
+	std::vector<MsvTraceEvent> events;
+	m_spTraceRecorder->GetEvents(events);
+	EXPECT_EQ(events.size(), 4u);
+	EXPECT_EQ(events[0].name, "outer");
+	EXPECT_EQ(events[1].name, "inner");
+	EXPECT_EQ(events[2].name, "inner");
+	EXPECT_EQ(events[2].phase, 'E');
+	EXPECT_EQ(events[2].errorCode, MSV_NOT_FOUND_ERROR);
+	EXPECT_EQ(events[3].name, "outer");
+	EXPECT_EQ(events[0].threadId, events[3].threadId);
+	EXPECT_LE(events[0].timestamp, events[3].timestamp);
+}
+
+TEST_F(MsvTraceRecorder_Test, ItShouldRecordNothing_WhenRecorderIsEmpty)
+{
+	MsvTraceScope scope(nullptr, "event", "test");
+	scope.SetErrorCode(MSV_SUCCESS);
+}
+
+TEST_F(MsvTraceRecorder_Test, ItShouldAppendIdToName_WhenScopeHasNamePrefix)
+{
+	{
+		MsvTraceScope scope(m_spTraceRecorder, "Load DLL module ", std::string("module"), "test");
+		MsvTraceScope emptyScope(nullptr, "Load DLL module ", std::string("other"), "test");
+	}
+
+	std::vector<MsvTraceEvent> events;
+	m_spTraceRecorder->GetEvents(events);
+	EXPECT_EQ(events.size(), 2u);
+	EXPECT_EQ(events[0].name, "Load DLL module module");
+	EXPECT_EQ(events[1].name, "Load DLL module module");
+}
+
+TEST_F(MsvTraceRecorder_Test, ItShouldUseDifferentThreadIds_WhenRecordedInMoreThreads)
+{
+	m_spTraceRecorder->Begin("main", "test");
+	std::thread thread([this]()
+	{
+		MsvTraceScope scope(m_spTraceRecorder, "thread", "test");
+	});
+	thread.join();
+	m_spTraceRecorder->End("main", "test", MSV_SUCCESS);
+
+	std::vector<MsvTraceEvent> events;
+	m_spTraceRecorder->GetEvents(events);
+	EXPECT_EQ(events.size(), 4u);
+	EXPECT_NE(events[0].threadId, events[1].threadId);
+}
+
+
+/*-----------------------------------------------------------------------------------------------------
+**											Export Tests
+**---------------------------------------------------------------------------------------------------*/
+
+
+TEST_F(MsvTraceRecorder_Test, ItShouldExportTraceEventJson_WhenEventsRecorded)
+{
+	m_spTraceRecorder->Begin("Load \"module\"", "dll");
+	m_spTraceRecorder->End("Load \"module\"", "dll", MSV_SUCCESS);
+
+	std::string json;
+	m_spTraceRecorder->Export(json);
+
+	EXPECT_EQ(json.find("{\"traceEvents\":["), 0u);
+	EXPECT_NE(json.find("\"name\":\"Load \\\"module\\\"\""), std::string::npos);
+	EXPECT_NE(json.find("\"ph\":\"B\""), std::string::npos);
+	EXPECT_NE(json.find("\"ph\":\"E\""), std::string::npos);
+	EXPECT_NE(json.find("\"cat\":\"dll\""), std::string::npos);
+}
+
+TEST_F(MsvTraceRecorder_Test, ItShouldBeEmpty_AfterClear)
+{
+	m_spTraceRecorder->Begin("event", "test");
+	m_spTraceRecorder->Clear();
+
+	std::vector<MsvTraceEvent> events;
+	m_spTraceRecorder->GetEvents(events);
+	EXPECT_TRUE(events.empty());
+}
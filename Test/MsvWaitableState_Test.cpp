@@ -0,0 +1,190 @@
+
+
+#include "pch.h"
+
+#include "mmodule/MsvModuleLifecycle.h"
+#include "mmodule/MsvModuleManager.h"
+#include "mmodule/MsvWaitableState.h"
+
+#include "mmodule/Mocks/MsvModuleConfigurator_Mock.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+MSV_ENABLE_WARNINGS
+
+
+using namespace ::testing;
+
+
+class MsvTestWaitableModule:
+	public MsvModuleLifecycle<MsvTestWaitableModule, MsvModuleBase>
+{
+public:
+	MsvTestWaitableModule(std::shared_ptr<IMsvLoggerProvider> spLoggerProvider):
+		MsvModuleLifecycle(spLoggerProvider, "MsvWaitableState_Test")
+	{
+
+	}
+};
+
+
+class MsvWaitableState_Test:
+	public MsvModule_TestBase
+{
+public:
+	virtual void SetUp()
+	{
+		InitializeLogging();
+
+		m_spModule.reset(new (std::nothrow) MsvTestWaitableModule(m_spLoggerProvider));
+		EXPECT_NE(m_spModule, nullptr);
+	}
+
+	virtual void TearDown()
+	{
+		m_spModule.reset();
+
+		UninitializeLogging();
+	}
+
+	//tested classes
+	std::shared_ptr<MsvTestWaitableModule> m_spModule;
+};
+
+
+/*-----------------------------------------------------------------------------------------------------
+**											Waitable State Tests
+**---------------------------------------------------------------------------------------------------*/
+
+
+TEST_F(MsvWaitableState_Test, ItShouldReturnImmediately_WhenStateIsReached)
+{
+	MsvWaitableState state(5);
+
+	EXPECT_EQ(state.Load(), 5);
+	EXPECT_TRUE(state.WaitFor(5, std::chrono::milliseconds(0)));
+}
+
+TEST_F(MsvWaitableState_Test, ItShouldTimeout_WhenStateIsNotReached)
+{
+	MsvWaitableState state(0);
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	EXPECT_FALSE(state.WaitFor(1, std::chrono::milliseconds(50)));
+	EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(50));
+}
+
+TEST_F(MsvWaitableState_Test, ItShouldWaitWithoutTimeout_WhenTimeoutIsMax)
+{
+	MsvWaitableState state(0);
+
+	//deadline does not overflow (waiter would return immediately)
+	std::thread storer([&state]()
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(20));
+		state.Store(1);
+	});
+
+	EXPECT_TRUE(state.WaitFor(1, std::chrono::milliseconds::max()));
+	storer.join();
+}
+
+TEST_F(MsvWaitableState_Test, ItShouldWakeAllWaiters_WhenStateIsStored)
+{
+	MsvWaitableState state(0);
+	std::atomic<int32_t> woken(0);
+
+	std::vector<std::thread> waiters;
+	for (int32_t i = 0; i < 32; ++i)
+	{
+		waiters.push_back(std::thread([&state, &woken]()
+		{
+			if (state.WaitFor(2, std::chrono::seconds(10)))
+			{
+				++woken;
+			}
+		}));
+	}
+
+	//intermediate state does not satisfy waiters
+	std::this_thread::sleep_for(std::chrono::milliseconds(20));
+	state.Store(1);
+	std::this_thread::sleep_for(std::chrono::milliseconds(20));
+	EXPECT_EQ(woken.load(), 0);
+
+	state.Store(2);
+	for (std::vector<std::thread>::iterator it = waiters.begin(); it != waiters.end(); ++it)
+	{
+		it->join();
+	}
+
+	EXPECT_EQ(woken.load(), 32);
+}
+
+/*-----------------------------------------------------------------------------------------------------
+**											Module State Tests
+**---------------------------------------------------------------------------------------------------*/
+
+
+TEST_F(MsvWaitableState_Test, ItShouldWaitForModuleState_WhenModuleChangesState)
+{
+	EXPECT_TRUE(m_spModule->WaitForState(MsvModuleState::MSV_MODULE_STATE_UNINITIALIZED, std::chrono::milliseconds(0)));
+	EXPECT_FALSE(m_spModule->WaitForState(MsvModuleState::MSV_MODULE_STATE_RUNNING, std::chrono::milliseconds(10)));
+
+	std::thread starter([this]()
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(20));
+		EXPECT_EQ(m_spModule->Initialize(), MSV_SUCCESS);
+		EXPECT_EQ(m_spModule->Start(), MSV_SUCCESS);
+	});
+
+	EXPECT_TRUE(m_spModule->WaitForState(MsvModuleState::MSV_MODULE_STATE_RUNNING, std::chrono::seconds(10)));
+	EXPECT_TRUE(m_spModule->Running());
+	starter.join();
+
+	EXPECT_EQ(m_spModule->Stop(), MSV_SUCCESS);
+	EXPECT_TRUE(m_spModule->WaitForState(MsvModuleState::MSV_MODULE_STATE_INITIALIZED, std::chrono::milliseconds(0)));
+	EXPECT_EQ(m_spModule->Uninitialize(), MSV_SUCCESS);
+	EXPECT_TRUE(m_spModule->WaitForState(MsvModuleState::MSV_MODULE_STATE_UNINITIALIZED, std::chrono::milliseconds(0)));
+}
+
+TEST_F(MsvWaitableState_Test, ItShouldWaitForModuleState_WhenModuleManagerStartsModule)
+{
+	MsvModuleManager moduleManager(m_spLogger);
+	std::shared_ptr<MsvModuleConfigurator_Mock> spModuleConfiguratorMock(new (std::nothrow) MsvModuleConfigurator_Mock());
+	EXPECT_NE(spModuleConfiguratorMock, nullptr);
+
+	EXPECT_CALL(*spModuleConfiguratorMock, IsInstalled(Matcher<bool&>(_)))
+		.WillRepeatedly(DoAll(SetArgReferee<0>(true), Return(MSV_SUCCESS)));
+	EXPECT_CALL(*spModuleConfiguratorMock, IsEnabled(Matcher<bool&>(_)))
+		.WillRepeatedly(DoAll(SetArgReferee<0>(true), Return(MSV_SUCCESS)));
+
+	int32_t moduleId = static_cast<int32_t>(ModuleId::MSV_TEST_STATIC_MODULE);
+	bool reached = false;
+	EXPECT_EQ(moduleManager.WaitForState(moduleId, MsvModuleState::MSV_MODULE_STATE_RUNNING, std::chrono::milliseconds(0), reached), MSV_NOT_FOUND_ERROR);
+
+	EXPECT_EQ(moduleManager.AddModule(moduleId, m_spModule, spModuleConfiguratorMock), MSV_SUCCESS);
+	EXPECT_EQ(moduleManager.WaitForState(moduleId, MsvModuleState::MSV_MODULE_STATE_RUNNING, std::chrono::milliseconds(10), reached), MSV_SUCCESS);
+	EXPECT_FALSE(reached);
+
+	std::thread starter([&moduleManager]()
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(20));
+		EXPECT_EQ(moduleManager.Initialize(), MSV_SUCCESS);
+		EXPECT_EQ(moduleManager.Start(), MSV_SUCCESS);
+	});
+
+	EXPECT_EQ(moduleManager.WaitForState(moduleId, MsvModuleState::MSV_MODULE_STATE_RUNNING, std::chrono::seconds(10), reached), MSV_SUCCESS);
+	EXPECT_TRUE(reached);
+	starter.join();
+
+	EXPECT_EQ(moduleManager.Stop(), MSV_SUCCESS);
+	EXPECT_EQ(moduleManager.WaitForState(moduleId, MsvModuleState::MSV_MODULE_STATE_INITIALIZED, std::chrono::milliseconds(0), reached), MSV_SUCCESS);
+	EXPECT_TRUE(reached);
+	EXPECT_EQ(moduleManager.Uninitialize(), MSV_SUCCESS);
+}
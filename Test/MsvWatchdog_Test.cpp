@@ -0,0 +1,435 @@
+
+
+#include "pch.h"
+
+#include "mmodule/MsvModuleLifecycle.h"
+#include "mmodule/MsvModuleManager.h"
+#include "mmodule/MsvWatchdog.h"
+
+#include "mmodule/Mocks/MsvModuleConfigurator_Mock.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+MSV_ENABLE_WARNINGS
+
+
+using namespace ::testing;
+
+
+class MsvTestHeartbeat:
+	public IMsvModuleHeartbeat
+{
+public:
+	MsvTestHeartbeat():
+		m_heartbeat(0)
+	{
+
+	}
+
+	virtual uint64_t GetHeartbeat() const override
+	{
+		return m_heartbeat.load();
+	}
+
+	std::atomic<uint64_t> m_heartbeat;
+};
+
+
+class MsvTestWatchdogObserver:
+	public IMsvWatchdogObserver
+{
+public:
+	virtual void OnModuleStalled(const MsvModuleStall& stall) override
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+		m_stalls.push_back(stall);
+	}
+
+	size_t GetStallCount()
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+		return m_stalls.size();
+	}
+
+	MsvModuleStall GetStall(size_t index)
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+		return m_stalls[index];
+	}
+
+	//waits until watchdog reports stall
+	bool WaitForStall()
+	{
+		std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+		while (std::chrono::steady_clock::now() < deadline)
+		{
+			if (GetStallCount() != 0)
+			{
+				return true;
+			}
+
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+
+		return false;
+	}
+
+	std::mutex m_lock;
+	std::vector<MsvModuleStall> m_stalls;
+};
+
+
+class MsvTestStallingModule:
+	public MsvModuleLifecycle<MsvTestStallingModule, MsvModuleBase>
+{
+public:
+	MsvTestStallingModule(std::shared_ptr<IMsvLoggerProvider> spLoggerProvider, std::chrono::milliseconds startDuration):
+		MsvModuleLifecycle(spLoggerProvider, "MsvWatchdog_Test"),
+		m_startDuration(startDuration),
+		m_startCount(0),
+		m_stopBlocked(false),
+		m_stopEntered(false)
+	{
+
+	}
+
+	MsvErrorCode OnStart()
+	{
+		std::this_thread::sleep_for(m_startDuration);
+		++m_startCount;
+		return MSV_SUCCESS;
+	}
+
+	//blocked stop simulates deadlocked module
+	MsvErrorCode OnStop()
+	{
+		m_stopEntered = true;
+		while (m_stopBlocked.load())
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+
+		return MSV_SUCCESS;
+	}
+
+	std::chrono::milliseconds m_startDuration;
+	std::atomic<int32_t> m_startCount;
+	std::atomic<bool> m_stopBlocked;
+	std::atomic<bool> m_stopEntered;
+};
+
+
+class MsvWatchdog_Test:
+	public MsvModule_TestBase
+{
+public:
+	virtual void SetUp()
+	{
+		InitializeLogging();
+
+		m_options = MSV_WATCHDOG_DEFAULT_OPTIONS;
+		m_options.heartbeatTimeout = std::chrono::milliseconds(20);
+	}
+
+	virtual void TearDown()
+	{
+		UninitializeLogging();
+	}
+
+	//adds module to module manager (it is installed and enabled)
+	void AddModule(MsvModuleManager& moduleManager, int32_t moduleId, std::shared_ptr<IMsvModule> spModule)
+	{
+		std::shared_ptr<MsvModuleConfigurator_Mock> spModuleConfiguratorMock(new (std::nothrow) MsvModuleConfigurator_Mock());
+		EXPECT_NE(spModuleConfiguratorMock, nullptr);
+
+		EXPECT_CALL(*spModuleConfiguratorMock, IsInstalled(Matcher<bool&>(_)))
+			.WillRepeatedly(DoAll(SetArgReferee<0>(true), Return(MSV_SUCCESS)));
+		EXPECT_CALL(*spModuleConfiguratorMock, IsEnabled(Matcher<bool&>(_)))
+			.WillRepeatedly(DoAll(SetArgReferee<0>(true), Return(MSV_SUCCESS)));
+
+		EXPECT_EQ(moduleManager.AddModule(moduleId, spModule, spModuleConfiguratorMock), MSV_SUCCESS);
+	}
+
+	MsvWatchdogOptions m_options;
+};
+
+
+/*-----------------------------------------------------------------------------------------------------
+**											Heartbeat Tests
+**---------------------------------------------------------------------------------------------------*/
+
+
+TEST_F(MsvWatchdog_Test, ItShouldFailStart_WhenCheckIntervalIsInvalid)
+{
+	MsvWatchdog watchdog(nullptr, m_spLogger);
+
+	m_options.heartbeatTimeout = std::chrono::milliseconds(-1);
+	EXPECT_EQ(watchdog.SetDefaultOptions(m_options), MSV_INVALID_DATA_ERROR);
+	EXPECT_EQ(watchdog.Start(std::chrono::milliseconds(0)), MSV_INVALID_DATA_ERROR);
+	EXPECT_FALSE(watchdog.Running());
+
+	EXPECT_EQ(watchdog.Start(std::chrono::milliseconds(5)), MSV_SUCCESS);
+	EXPECT_EQ(watchdog.Start(std::chrono::milliseconds(5)), MSV_ALREADY_RUNNING_INFO);
+	EXPECT_TRUE(watchdog.Running());
+
+	watchdog.Stop();
+	EXPECT_FALSE(watchdog.Running());
+}
+
+TEST_F(MsvWatchdog_Test, ItShouldReportStallOnce_WhenHeartbeatStops)
+{
+	MsvWatchdog watchdog(nullptr, m_spLogger);
+	std::shared_ptr<MsvTestWatchdogObserver> spObserver(new (std::nothrow) MsvTestWatchdogObserver());
+	std::shared_ptr<MsvTestHeartbeat> spHeartbeat(new (std::nothrow) MsvTestHeartbeat());
+	EXPECT_NE(spObserver, nullptr);
+	EXPECT_NE(spHeartbeat, nullptr);
+
+	EXPECT_EQ(watchdog.SetModuleOptions(1, m_options), MSV_SUCCESS);
+	EXPECT_EQ(watchdog.Subscribe(spObserver), MSV_SUCCESS);
+	EXPECT_EQ(watchdog.Subscribe(spObserver), MSV_ALREADY_EXISTS_ERROR);
+	watchdog.Watch(1, spHeartbeat);
+	EXPECT_EQ(watchdog.Start(std::chrono::milliseconds(5)), MSV_SUCCESS);
+
+	EXPECT_TRUE(spObserver->WaitForStall());
+	MsvModuleStall stall = spObserver->GetStall(0);
+	EXPECT_EQ(stall.moduleId, 1);
+	EXPECT_EQ(stall.type, MsvModuleStallType::MSV_MODULE_STALL_HEARTBEAT);
+	EXPECT_GE(stall.duration, std::chrono::milliseconds(20));
+
+	//stall is reported once until heartbeat changes
+	std::this_thread::sleep_for(std::chrono::milliseconds(100));
+	EXPECT_EQ(spObserver->GetStallCount(), 1u);
+
+	watchdog.Stop();
+	EXPECT_EQ(watchdog.Unsubscribe(spObserver), MSV_SUCCESS);
+	EXPECT_EQ(watchdog.Unsubscribe(spObserver), MSV_NOT_FOUND_ERROR);
+}
+
+TEST_F(MsvWatchdog_Test, ItShouldNotReportStall_WhenHeartbeatAdvances)
+{
+	MsvWatchdog watchdog(nullptr, m_spLogger);
+	std::shared_ptr<MsvTestWatchdogObserver> spObserver(new (std::nothrow) MsvTestWatchdogObserver());
+	std::shared_ptr<MsvTestHeartbeat> spHeartbeat(new (std::nothrow) MsvTestHeartbeat());
+	EXPECT_NE(spObserver, nullptr);
+	EXPECT_NE(spHeartbeat, nullptr);
+
+	m_options.heartbeatTimeout = std::chrono::milliseconds(200);
+	EXPECT_EQ(watchdog.SetDefaultOptions(m_options), MSV_SUCCESS);
+	EXPECT_EQ(watchdog.Subscribe(spObserver), MSV_SUCCESS);
+	watchdog.Watch(1, spHeartbeat);
+	EXPECT_EQ(watchdog.Start(std::chrono::milliseconds(5)), MSV_SUCCESS);
+
+	for (int32_t i = 0; i < 100; ++i)
+	{
+		++spHeartbeat->m_heartbeat;
+		std::this_thread::sleep_for(std::chrono::milliseconds(5));
+	}
+
+	//unwatched module is not checked
+	watchdog.Unwatch(1);
+	std::this_thread::sleep_for(std::chrono::milliseconds(300));
+
+	watchdog.Stop();
+	EXPECT_EQ(spObserver->GetStallCount(), 0u);
+}
+
+
+/*-----------------------------------------------------------------------------------------------------
+**											Module Manager Tests
+**---------------------------------------------------------------------------------------------------*/
+
+
+TEST_F(MsvWatchdog_Test, ItShouldReportTransitionStall_WhenModuleStartHangs)
+{
+	MsvModuleManager moduleManager(m_spLogger);
+	std::shared_ptr<MsvTestWatchdogObserver> spObserver(new (std::nothrow) MsvTestWatchdogObserver());
+	std::shared_ptr<MsvTestStallingModule> spModule(new (std::nothrow) MsvTestStallingModule(m_spLoggerProvider, std::chrono::milliseconds(300)));
+	EXPECT_NE(spObserver, nullptr);
+	EXPECT_NE(spModule, nullptr);
+
+	int32_t moduleId = static_cast<int32_t>(ModuleId::MSV_TEST_STATIC_MODULE);
+	AddModule(moduleManager, moduleId, spModule);
+
+	std::shared_ptr<MsvWatchdog> spWatchdog = moduleManager.GetWatchdog();
+	m_options.transitionTimeout = std::chrono::milliseconds(20);
+	m_options.heartbeatTimeout = std::chrono::milliseconds(0);
+	m_options.actions = MSV_WATCHDOG_ACTION_LOG | MSV_WATCHDOG_ACTION_EVENT | MSV_WATCHDOG_ACTION_STACK_SNAPSHOT;
+	EXPECT_EQ(spWatchdog->SetModuleOptions(moduleId, m_options), MSV_SUCCESS);
+	EXPECT_EQ(spWatchdog->Subscribe(spObserver), MSV_SUCCESS);
+	EXPECT_EQ(spWatchdog->Start(std::chrono::milliseconds(5)), MSV_SUCCESS);
+
+	EXPECT_EQ(moduleManager.Initialize(), MSV_SUCCESS);
+	EXPECT_EQ(moduleManager.Start(), MSV_SUCCESS);
+
+	//stall has been reported while start was running
+	EXPECT_TRUE(spObserver->WaitForStall());
+	MsvModuleStall stall = spObserver->GetStall(0);
+	EXPECT_EQ(stall.moduleId, moduleId);
+	EXPECT_EQ(stall.type, MsvModuleStallType::MSV_MODULE_STALL_TRANSITION);
+	EXPECT_EQ(stall.transition, MsvModuleTransition::MSV_MODULE_TRANSITION_START);
+#if defined(__linux__)
+	EXPECT_FALSE(stall.stack.empty());
+#endif
+
+	spWatchdog->Stop();
+	EXPECT_EQ(spObserver->GetStallCount(), 1u);
+	EXPECT_EQ(moduleManager.Stop(), MSV_SUCCESS);
+	EXPECT_EQ(moduleManager.Uninitialize(), MSV_SUCCESS);
+}
+
+TEST_F(MsvWatchdog_Test, ItShouldRestartModule_WhenHeartbeatStalls)
+{
+	MsvModuleManager moduleManager(m_spLogger);
+	std::shared_ptr<MsvTestStallingModule> spModule(new (std::nothrow) MsvTestStallingModule(m_spLoggerProvider, std::chrono::milliseconds(0)));
+	EXPECT_NE(spModule, nullptr);
+
+	int32_t moduleId = static_cast<int32_t>(ModuleId::MSV_TEST_STATIC_MODULE);
+	AddModule(moduleManager, moduleId, spModule);
+
+	MsvRetryPolicy policy = MSV_RETRY_DEFAULT_POLICY;
+	policy.initialDelay = std::chrono::milliseconds(1);
+	policy.maxDelay = std::chrono::milliseconds(4);
+	EXPECT_EQ(moduleManager.GetModuleRetry()->SetPolicy(policy), MSV_SUCCESS);
+
+	std::shared_ptr<MsvWatchdog> spWatchdog = moduleManager.GetWatchdog();
+	m_options.actions = MSV_WATCHDOG_ACTION_LOG | MSV_WATCHDOG_ACTION_RESTART;
+	EXPECT_EQ(spWatchdog->SetModuleOptions(moduleId, m_options), MSV_SUCCESS);
+	EXPECT_EQ(spWatchdog->Start(std::chrono::milliseconds(5)), MSV_SUCCESS);
+
+	EXPECT_EQ(moduleManager.Initialize(), MSV_SUCCESS);
+	EXPECT_EQ(moduleManager.Start(), MSV_SUCCESS);
+
+	//module never reports heartbeat -> it is stopped and started again
+	std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+	while (spModule->m_startCount.load() < 2 && std::chrono::steady_clock::now() < deadline)
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+
+	EXPECT_GE(spModule->m_startCount.load(), 2);
+
+	spWatchdog->Stop();
+	EXPECT_EQ(moduleManager.Stop(), MSV_SUCCESS);
+	EXPECT_EQ(moduleManager.Uninitialize(), MSV_SUCCESS);
+}
+
+TEST_F(MsvWatchdog_Test, ItShouldNotBlockModuleManager_WhenStalledModuleDoesNotStop)
+{
+	MsvModuleManager moduleManager(m_spLogger);
+	std::shared_ptr<MsvTestStallingModule> spModule(new (std::nothrow) MsvTestStallingModule(m_spLoggerProvider, std::chrono::milliseconds(0)));
+	EXPECT_NE(spModule, nullptr);
+
+	int32_t moduleId = static_cast<int32_t>(ModuleId::MSV_TEST_STATIC_MODULE);
+	AddModule(moduleManager, moduleId, spModule);
+
+	MsvRetryPolicy policy = MSV_RETRY_DEFAULT_POLICY;
+	policy.initialDelay = std::chrono::milliseconds(1);
+	policy.maxDelay = std::chrono::milliseconds(4);
+	EXPECT_EQ(moduleManager.GetModuleRetry()->SetPolicy(policy), MSV_SUCCESS);
+
+	std::shared_ptr<MsvWatchdog> spWatchdog = moduleManager.GetWatchdog();
+	m_options.restartTimeout = std::chrono::milliseconds(50);
+	m_options.actions = MSV_WATCHDOG_ACTION_LOG | MSV_WATCHDOG_ACTION_RESTART;
+	EXPECT_EQ(spWatchdog->SetModuleOptions(moduleId, m_options), MSV_SUCCESS);
+
+	EXPECT_EQ(moduleManager.Initialize(), MSV_SUCCESS);
+	EXPECT_EQ(moduleManager.Start(), MSV_SUCCESS);
+
+	//module does not stop -> restart gives up and module manager is not locked meanwhile
+	spModule->m_stopBlocked = true;
+	EXPECT_EQ(spWatchdog->Start(std::chrono::milliseconds(5)), MSV_SUCCESS);
+
+	std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+	while (!spModule->m_stopEntered.load() && std::chrono::steady_clock::now() < deadline)
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+
+	EXPECT_TRUE(spModule->m_stopEntered.load());
+	EXPECT_TRUE(moduleManager.Running());
+
+	//restart is not retried
+	MsvModuleRetryState state;
+	deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+	while (moduleManager.GetModuleRetry()->GetRetryState(moduleId, state) != MSV_NOT_FOUND_ERROR && std::chrono::steady_clock::now() < deadline)
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+
+	EXPECT_EQ(moduleManager.GetModuleRetry()->GetRetryState(moduleId, state), MSV_NOT_FOUND_ERROR);
+	EXPECT_EQ(spModule->m_startCount.load(), 1);
+
+	spWatchdog->Stop();
+	spModule->m_stopBlocked = false;
+	EXPECT_TRUE(spModule->WaitForState(MsvModuleState::MSV_MODULE_STATE_INITIALIZED, std::chrono::seconds(10)));
+	EXPECT_EQ(moduleManager.Stop(), MSV_SUCCESS);
+
+	//module can not be uninitialized until its stop thread finishes (it returns just after module state is set)
+	MsvErrorCode errorCode = moduleManager.Uninitialize();
+	deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+	while (errorCode == MSV_STILL_RUNNING_ERROR && std::chrono::steady_clock::now() < deadline)
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		errorCode = moduleManager.Uninitialize();
+	}
+
+	EXPECT_EQ(errorCode, MSV_SUCCESS);
+	EXPECT_FALSE(spModule->Initialized());
+}
+
+TEST_F(MsvWatchdog_Test, ItShouldWaitForStalledStop_WhenModuleManagerIsDestroyed)
+{
+	std::shared_ptr<MsvTestStallingModule> spModule(new (std::nothrow) MsvTestStallingModule(m_spLoggerProvider, std::chrono::milliseconds(0)));
+	EXPECT_NE(spModule, nullptr);
+	int32_t moduleId = static_cast<int32_t>(ModuleId::MSV_TEST_STATIC_MODULE);
+	std::thread unblockThread;
+
+	{
+		MsvModuleManager moduleManager(m_spLogger);
+		AddModule(moduleManager, moduleId, spModule);
+
+		MsvRetryPolicy policy = MSV_RETRY_DEFAULT_POLICY;
+		policy.initialDelay = std::chrono::milliseconds(1);
+		policy.maxDelay = std::chrono::milliseconds(4);
+		EXPECT_EQ(moduleManager.GetModuleRetry()->SetPolicy(policy), MSV_SUCCESS);
+
+		std::shared_ptr<MsvWatchdog> spWatchdog = moduleManager.GetWatchdog();
+		m_options.restartTimeout = std::chrono::milliseconds(20);
+		m_options.actions = MSV_WATCHDOG_ACTION_LOG | MSV_WATCHDOG_ACTION_RESTART;
+		EXPECT_EQ(spWatchdog->SetModuleOptions(moduleId, m_options), MSV_SUCCESS);
+
+		EXPECT_EQ(moduleManager.Initialize(), MSV_SUCCESS);
+		EXPECT_EQ(moduleManager.Start(), MSV_SUCCESS);
+
+		//module does not stop -> restart gives up
+		spModule->m_stopBlocked = true;
+		EXPECT_EQ(spWatchdog->Start(std::chrono::milliseconds(5)), MSV_SUCCESS);
+
+		MsvModuleRetryState state;
+		std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+		while ((!spModule->m_stopEntered.load() || moduleManager.GetModuleRetry()->GetRetryState(moduleId, state) != MSV_NOT_FOUND_ERROR) && std::chrono::steady_clock::now() < deadline)
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+
+		EXPECT_TRUE(spModule->m_stopEntered.load());
+		spWatchdog->Stop();
+
+		//module stops later -> destructor waits for its stop thread and then uninitializes it
+		unblockThread = std::thread([spModule]()
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(50));
+			spModule->m_stopBlocked = false;
+		});
+	}
+
+	unblockThread.join();
+	EXPECT_FALSE(spModule->m_stopBlocked.load());
+	EXPECT_FALSE(spModule->Initialized());
+}
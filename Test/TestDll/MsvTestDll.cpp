@@ -0,0 +1,36 @@
+//shared library loaded by MsvPosixDllFactory_Test (build: g++ -shared -fPIC MsvTestDll.cpp -o libMsvTestDll.so)
+
+
+#include "mdllfactory/IMsvDllFactory.h"
+#include "merror/MsvErrorCodes.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <cstring>
+#include <memory>
+#include <new>
+
+MSV_ENABLE_WARNINGS
+
+
+const char* const MSV_TEST_DLL_OBJECT_ID = "{0E4B4C5A-7E0C-4F6B-9D2A-3C1B5A6D7E8F}";
+
+
+class MsvTestDllObject:
+	public IMsvDllObject
+{
+
+};
+
+
+extern "C" MsvErrorCode GetDllObject(const char* dllObjectId, std::shared_ptr<IMsvDllObject>& spDllObject)
+{
+	if (!dllObjectId || strcmp(dllObjectId, MSV_TEST_DLL_OBJECT_ID) != 0)
+	{
+		return MSV_NOT_FOUND_ERROR;
+	}
+
+	//new object for each call
+	spDllObject.reset(new (std::nothrow) MsvTestDllObject());
+	return spDllObject ? MSV_SUCCESS : MSV_ALLOCATION_ERROR;
+}